@@ -3,6 +3,17 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  #define WIN32_LEAN_AND_MEAN
+  #include <Windows.h>
+  // timeBeginPeriod, timeEndPeriod
+  #pragma comment (lib, "winmm.lib")
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  // clock_gettime, nanosleep
+  #include <time.h>
+#else
+  #error("operating system not (yet) supported")
+#endif
 #include "idlib/file_system.h"
 #include "Zeitgeist/Rendition.h"
 
@@ -91,6 +102,141 @@ onListRenditions
   }
 }
 
+// The time, in seconds, before the end of a frame from which on the frame limiter spins instead of sleeping.
+// Sleeping is only accurate to about a millisecond under Linux and about two milliseconds under Windows (with a timer resolution of one millisecond).
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  #define FrameLimiterSpinSeconds (0.002)
+#else
+  #define FrameLimiterSpinSeconds (0.001)
+#endif
+
+// Limits the number of frames per second by waiting after each frame until the frame period has passed.
+typedef struct FrameLimiter {
+  // The frame period in seconds. 0 if the number of frames per second is not limited.
+  double period;
+  // The time, in seconds, at which the current frame ends. 0 if no frame has begun yet.
+  double deadline;
+} FrameLimiter;
+
+// Get the time, in seconds, of a monotonic clock.
+static double
+getSeconds
+  (
+  )
+{
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  LARGE_INTEGER frequency, counter;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+  return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + (double)now.tv_nsec / 1000000000.0;
+#endif
+}
+
+static void
+sleepSeconds
+  (
+    double seconds
+  )
+{
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  // The resolution of Sleep was increased to one millisecond by FrameLimiter_initialize.
+  Sleep((DWORD)(seconds * 1000.0));
+#else
+  struct timespec duration;
+  duration.tv_sec = (time_t)seconds;
+  duration.tv_nsec = (long)((seconds - (double)duration.tv_sec) * 1000000000.0);
+  nanosleep(&duration, NULL);
+#endif
+}
+
+// Get the maximal number of frames per second from the environment variable "ZEITGEIST_MAX_FPS".
+// Return 0 if the number of frames per second is not limited.
+static double
+getMaximalFramesPerSecond
+  (
+    Shizu_State2* state
+  )
+{
+  char const* maximalFramesPerSecond = getenv("ZEITGEIST_MAX_FPS");
+  if (!maximalFramesPerSecond || !strcmp(maximalFramesPerSecond, "")) {
+    return 0.;
+  }
+  char* end = NULL;
+  double v = strtod(maximalFramesPerSecond, &end);
+  if (end == maximalFramesPerSecond || *end != '\0' || !(v >= 0.)) {
+    fprintf(stderr, "error: maximal number of frames per second `%s` invalid\n", maximalFramesPerSecond);
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  return v;
+}
+
+static void
+FrameLimiter_initialize
+  (
+    FrameLimiter* self,
+    double maximalFramesPerSecond
+  )
+{
+  self->period = maximalFramesPerSecond > 0. ? 1. / maximalFramesPerSecond : 0.;
+  self->deadline = 0.;
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  // Increase the resolution of Sleep to one millisecond while the frame limiter is in use.
+  // The resolution is a system-wide setting, hence it is changed once and not per sleep.
+  if (self->period) {
+    timeBeginPeriod(1);
+  }
+#endif
+}
+
+static void
+FrameLimiter_uninitialize
+  (
+    FrameLimiter* self
+  )
+{
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  if (self->period) {
+    timeEndPeriod(1);
+  }
+#endif
+  self->period = 0.;
+}
+
+// Wait until the frame period since the end of the previous frame has passed.
+// Sleep for most of the time and spin for the remaining time for precision.
+static void
+FrameLimiter_wait
+  (
+    FrameLimiter* self
+  )
+{
+  if (!self->period) {
+    return;
+  }
+  double now = getSeconds();
+  if (!self->deadline) {
+    self->deadline = now;
+  }
+  self->deadline += self->period;
+  if (self->deadline <= now) {
+    // The frame took longer than the frame period. Do not try to catch up with shorter frames.
+    self->deadline = now;
+    return;
+  }
+  double remaining = self->deadline - now;
+  if (remaining > FrameLimiterSpinSeconds) {
+    sleepSeconds(remaining - FrameLimiterSpinSeconds);
+  }
+  while (getSeconds() < self->deadline) {
+    /*Intentionally empty.*/
+  }
+}
+
 static void
 onRendition1
   (
@@ -114,6 +260,8 @@ onRendition1
     fprintf(stderr, "unable to acquire update function of rendition `%.*s`\n", (int)Shizu_String_getNumberOfBytes(state, renditionName), Shizu_String_getBytes(state, renditionName));
     Shizu_State2_jump(state);
   }
+  double maximalFramesPerSecond = getMaximalFramesPerSecond(state);
+  FrameLimiter frameLimiter;
   Shizu_Value returnValue;
   Shizu_Value argumentValues[] = { Shizu_Value_InitializerVoid(Shizu_Void_Void) };
   (*loadFunction)(state, &returnValue, 0, &argumentValues[0]);
@@ -121,17 +269,21 @@ onRendition1
   Shizu_State2_pushJumpTarget(state, &jumpTarget1);
   if (!setjmp(jumpTarget1.environment)) {
     Shizu_Stack_pushObject(Shizu_State2_getState1(state), Shizu_State2_getStack(state), (Shizu_Object*)rendition);
+    FrameLimiter_initialize(&frameLimiter, maximalFramesPerSecond);
     Shizu_JumpTarget jumpTarget2;
     Shizu_State2_pushJumpTarget(state, &jumpTarget2);
     if (!setjmp(jumpTarget1.environment)) {
       while (!Shizu_State2_getProcessExitRequested(state)) {
         (*updateFunction)(state, &returnValue, 0, &argumentValues[0]);
         Shizu_Gc_run(state, Shizu_State2_getGc(state), NULL);
+        FrameLimiter_wait(&frameLimiter);
       }
       Shizu_State2_popJumpTarget(state);
+      FrameLimiter_uninitialize(&frameLimiter);
       (*unloadFunction)(state, &returnValue, 0, &argumentValues[0]);
     } else {
       Shizu_State2_popJumpTarget(state);
+      FrameLimiter_uninitialize(&frameLimiter);
       (*unloadFunction)(state, &returnValue, 0, &argumentValues[0]);
       Shizu_State2_jump(state);
     }
@@ -169,16 +321,89 @@ onRendition
   }
 }
 
+// Options of the form "--<name>=<value>".
+// The options are forwarded to the renditions in environment variables as the renditions are loaded as plugins.
+typedef struct Option {
+  char const* prefix;
+  char const* environmentVariableName;
+} Option;
+
+static Option const g_options[] = {
+  { "--visuals-backend=", "ZEITGEIST_VISUALS_BACKEND" },
+  { "--visuals-renderer=", "ZEITGEIST_VISUALS_RENDERER" },
+  { "--visuals-frames=", "ZEITGEIST_VISUALS_FRAMES" },
+  { "--visuals-frames-in-flight=", "ZEITGEIST_VISUALS_FRAMES_IN_FLIGHT" },
+  { "--visuals-trace=", "ZEITGEIST_VISUALS_TRACE" },
+  { "--visuals-benchmark=", "ZEITGEIST_VISUALS_BENCHMARK" },
+  { "--visuals-program-cache=", "ZEITGEIST_VISUALS_PROGRAM_CACHE" },
+  { "--visuals-dynamic-resolution=", "ZEITGEIST_VISUALS_DYNAMIC_RESOLUTION" },
+  { "--visuals-upscale=", "ZEITGEIST_VISUALS_UPSCALE" },
+  { "--visuals-canvas-size=", "ZEITGEIST_VISUALS_CANVAS_SIZE" },
+  { "--vsync=", "ZEITGEIST_VISUALS_VSYNC" },
+  { "--max-fps=", "ZEITGEIST_MAX_FPS" },
+};
+
+// Apply and remove the options from the arguments.
+static void
+onOptions
+  (
+    Shizu_State2* state,
+    int* argc,
+    char** argv
+  )
+{
+  int n = 1;
+  for (int argi = 1; argi < *argc; ++argi) {
+    bool isOption = false;
+    for (size_t i = 0, m = sizeof(g_options) / sizeof(Option); i < m; ++i) {
+      size_t prefixLength = strlen(g_options[i].prefix);
+      if (!strncmp(argv[argi], g_options[i].prefix, prefixLength)) {
+        char const* value = argv[argi] + prefixLength;
+      #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+        if (_putenv_s(g_options[i].environmentVariableName, value)) {
+      #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+        if (setenv(g_options[i].environmentVariableName, value, 1)) {
+      #else
+        #error("operating system not (yet) supported")
+      #endif
+          fprintf(stderr, "error: unable to apply option `%s`\n", argv[argi]);
+          Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+          Shizu_State2_jump(state);
+        }
+        isOption = true;
+        break;
+      }
+    }
+    if (!isOption) {
+      argv[n++] = argv[argi];
+    }
+  }
+  *argc = n;
+}
+
 static void
 onHelp
   (
     Shizu_State2* state
   )
 {
-  fprintf(stdout, "usage: zeitgeist-interpreter [--rendition <name> ] [--list-renditions] [--help]\n");
+  fprintf(stdout, "usage: zeitgeist-interpreter [--rendition <name> ] [--list-renditions] [--help] [options]\n");
   fprintf(stdout, "--rendition <name> Execute rendition by its name\n");
   fprintf(stdout, "--list-renditions List names of all available renditions\n");
   fprintf(stdout, "--help Show this help\n");
+  fprintf(stdout, "options:\n");
+  fprintf(stdout, "--visuals-backend=<name> Select the visuals backend: `default`, `glx`, `wgl`, or `egl-headless`\n");
+  fprintf(stdout, "--visuals-renderer=<name> Select the visuals renderer: `gl` or `software`\n");
+  fprintf(stdout, "--visuals-frames=<number> Request to quit after the specified number of frames\n");
+  fprintf(stdout, "--visuals-frames-in-flight=<number> Select the number of frames the CPU may record ahead of the GPU, from 1 to 4 (default 2)\n");
+  fprintf(stdout, "--visuals-trace=<categories> Write traces of the comma-separated categories to the standard output: `gpu`\n");
+  fprintf(stdout, "--visuals-benchmark=<number> Write the frame statistics averaged over the specified number of frames to the standard output\n");
+  fprintf(stdout, "--visuals-program-cache=<directory> Select the directory of the program binary cache or disable the cache by `off`\n");
+  fprintf(stdout, "--visuals-dynamic-resolution=<fps>[,<min>[,<max>]] Scale the resolution between <min> and <max> (default 0.5 and 1) to hold the target frame rate\n");
+  fprintf(stdout, "--visuals-upscale=<filter> Select the filter scaling images rendered at a lower resolution: `nearest`, `linear`, or `sharpen`\n");
+  fprintf(stdout, "--visuals-canvas-size=<width>x<height> Select the size of the canvas of the `egl-headless` backend (default 640x480)\n");
+  fprintf(stdout, "--vsync=<mode> Select the synchronization of the buffer swaps with the vertical blank: `default`, `off`, `on`, or `adaptive`\n");
+  fprintf(stdout, "--max-fps=<number> Limit the number of frames per second, `0` does not limit the number of frames per second\n");
 }
 
 static void
@@ -192,6 +417,7 @@ main1
   Shizu_Value listRenditions = Shizu_Value_InitializerObject(Shizu_String_create(state, "--list-renditions", strlen("--list-renditions")));
   Shizu_Value rendition = Shizu_Value_InitializerObject(Shizu_String_create(state, "--rendition", strlen("--rendition")));
   Shizu_Value help = Shizu_Value_InitializerObject(Shizu_String_create(state, "--help", strlen("--help")));
+  onOptions(state, &argc, argv);
   if (argc < 2) {
     fprintf(stderr, "error: no command specified\n");
     Shizu_State2_jump(state);
@@ -8,12 +8,12 @@
 
 #include "Zeitgeist/UpstreamRequests.h"
 #include "Visuals/Service.h"
+#include "Visuals/Context.h"
 
 #include "Visuals/DefaultPrograms.h"
 #include "Visuals/Program.h"
 #include "Visuals/RenderBuffer.h"
 #include "Visuals/VertexBuffer.h"
-#include "Visuals/Gl/Context.h"
 
 #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
   #define Shizu_Rendition_Export _declspec(dllexport)
@@ -68,7 +68,7 @@ Zeitgeist_Rendition_update
     Zeitgeist_sendUpstreamRequest(state, request);
   }
 
-  Visuals_Context* visualsContext = (Visuals_Context*)Visuals_Gl_Context_create(state);
+  Visuals_Context* visualsContext = Visuals_Service_createContext(state);
 
   Shizu_Integer32 canvasWidth, canvasHeight;
   Visuals_Service_getClientSize(state, &canvasWidth, &canvasHeight);
@@ -103,7 +103,7 @@ Zeitgeist_Rendition_load
 
   Shizu_State2_pushJumpTarget(state, &jumpTarget);
   if (!setjmp(jumpTarget.environment)) {
-    Visuals_Context* visualsContext = (Visuals_Context*)Visuals_Gl_Context_create(state);
+    Visuals_Context* visualsContext = Visuals_Service_createContext(state);
     Visuals_Service_setTitle(state, Shizu_String_create(state, "Hello World (OpenGL)", strlen("Hello World (OpenGL)")));
     Visuals_Program* program = Visuals_getProgram(state, "simple");
     Visuals_Object_materialize(state, (Visuals_Object*)program);
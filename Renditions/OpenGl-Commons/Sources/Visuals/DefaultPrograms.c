@@ -22,7 +22,16 @@
 #include "Visuals/DefaultPrograms.h"
 
 #include "Visuals/Gl/Program.h"
-// strlen
+#include "Visuals/Gl/ServiceGl.h"
+#include "Visuals/LightClusters.h"
+#include "Visuals/LightSet.h"
+#include "Visuals/Software/Program.h"
+#include "Visuals/VertexBuffer.h"
+// snprintf
+#include <stdio.h>
+// malloc, realloc, free
+#include <stdlib.h>
+// strlen, strcmp, strchr, memcpy
 #include <string.h>
 
 #define VertexPositionName "vertexPosition"
@@ -31,6 +40,15 @@
 #define VertexDiffuseName "vertexDiffuse"
 #define VertexSpecularName "vertexSpecular"
 #define VertexShininessName "vertexShininess"
+#define InstanceTransformRow0Name "instanceTransformRow0"
+#define InstanceTransformRow1Name "instanceTransformRow1"
+#define InstanceTransformRow2Name "instanceTransformRow2"
+#define InstanceMaterialIndexName "instanceMaterialIndex"
+#define VertexTextureUvName "vertexTextureUv"
+#define VertexMaterialIndexName "vertexMaterialIndex"
+
+#define Stringify(x) Stringify0(x)
+#define Stringify0(x) #x
 
 #define MatrixInfoType \
   /* Information on matrices. */ \
@@ -47,6 +65,15 @@
   "  vec3 position;\n" \
   "};\n"
 
+#define ClusterInfoType \
+  /* Information on the clustered lights. */ \
+  "struct ClusterInfo {\n" \
+  /* The scale from pixels to clusters along the x-axis and the y-axis, the depth scale, and the depth bias. */ \
+  "  vec4 parameters;\n" \
+  /* The number of clustered lights. If zero, the uniform blocks of the clustered lights are not accessed. */ \
+  "  int numberOfLights;\n" \
+  "};\n"
+
 #define PhongInfoType \
   /* Information on the ambient, diffuse, specular, and emissive properties of a fragment. */ \
   "struct PhongInfo {\n" \
@@ -73,6 +100,14 @@
   "  float shininess;\n" \
   "};\n"
 
+#define FrameBlock \
+  /* The values which change once per frame. See Visuals_FrameBlock for the layout. */ \
+  "layout(std140, row_major) uniform Frame {\n" \
+  "  MatrixInfo matrices;\n" \
+  "  ViewerInfo viewer;\n" \
+  "  ClusterInfo clusters;\n" \
+  "};\n"
+
 // Blinn-Phong variables.
 // Vertex shader.
 // constant inputs:
@@ -86,6 +121,8 @@
 //  vertexAmbientColor vec4: The vertex ambient color in RGBF32.
 static const GLchar* Programs_Pbr1_vertexProgram =
   "#version 330 core\n"
+  // selects the kernel of the software renderer
+  "#pragma zeitgeist_program(pbr1)\n"
   // vertex variables
   "layout(location = 0) in vec3 " VertexPositionName ";\n"
   "layout(location = 1) in vec3 " VertexNormalName ";\n"
@@ -96,7 +133,40 @@ static const GLchar* Programs_Pbr1_vertexProgram =
   "#define VertexSemantics_PositionXyz (1)\n"
   "#define VertexSemantics_PositionXyz_NormalXyz_AmbientRgb (2)\n"
   "#define VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess (4)\n"
+  "layout(location = 10) in vec2 " VertexTextureUvName ";\n"
+  "layout(location = 11) in uint " VertexMaterialIndexName ";\n"
+  "#define VertexSemantics_PositionXyz_NormalXyz_MaterialIndex (256)\n"
+  "#define VertexSemantics_PositionXyz_NormalXyz_TextureUv_MaterialIndex (512)\n"
+  // The vertex format is fixed by the VERTEX_FORMAT define of a permutation or selected by the vertexDescriptor uniform.
+  "#if defined(VERTEX_FORMAT)\n"
+  "#define isVertexFormat(x) (VERTEX_FORMAT == (x))\n"
+  "#else\n"
   "uniform int vertexDescriptor;\n"
+  "#define isVertexFormat(x) (vertexDescriptor == (x))\n"
+  "#endif\n"
+  // instance variables
+  "layout(location = 6) in vec4 " InstanceTransformRow0Name ";\n"
+  "layout(location = 7) in vec4 " InstanceTransformRow1Name ";\n"
+  "layout(location = 8) in vec4 " InstanceTransformRow2Name ";\n"
+  "layout(location = 9) in uint " InstanceMaterialIndexName ";\n"
+  "#define InstanceSemantics_Transform3x4_MaterialIndex (64)\n"
+  "uniform int instanceDescriptor;\n"
+
+  /* Type of light model "Phong". */
+  "#define LightModel_Phong (1)\n"
+  /* Type of light model "Blinn-Phong". */
+  "#define LightModel_BlinnPhong (2)\n"
+  // A permutation for a light model only provides the material of that light model.
+  "#if !defined(LIGHT_MODEL)\n"
+  "#define withPhongMaterial 1\n"
+  "#define withBlinnPhongMaterial 1\n"
+  "#elif LIGHT_MODEL == LightModel_Phong\n"
+  "#define withPhongMaterial 1\n"
+  "#define withBlinnPhongMaterial 0\n"
+  "#else\n"
+  "#define withPhongMaterial 0\n"
+  "#define withBlinnPhongMaterial 1\n"
+  "#endif\n"
 
   "struct FragmentInfo {\n"
   "  vec3 position;\n"
@@ -107,11 +177,23 @@ static const GLchar* Programs_Pbr1_vertexProgram =
 
   MatrixInfoType
   ViewerInfoType
+  ClusterInfoType
   PhongInfoType
   BlinnPhongInfoType
 
+  // The materials indexed by the material index of a vertex or an instance.
+  "struct MaterialInfo {\n"
+  "  PhongInfo phong;\n"
+  "  BlinnPhongInfo blinnPhong;\n"
+  "};\n"
+  "#define maximumNumberOfMaterials 128\n"
+  "layout(std140) uniform Materials {\n"
+  "  MaterialInfo materials[maximumNumberOfMaterials];\n"
+  "};\n"
+
   "out FRAGMENT {\n"
   "  vec3 worldPosition;\n"
+  "  float viewDepth;\n"
   "  vec3 color;\n"
   "  vec3 normal;\n"
   "  PhongInfo phong;\n"
@@ -122,32 +204,45 @@ static const GLchar* Programs_Pbr1_vertexProgram =
   "  vec3 position;\n"
   "} _viewer;\n"
 
+  "#if withPhongMaterial\n"
   "uniform PhongInfo phongMaterial;\n"
+  "#endif\n"
+  "#if withBlinnPhongMaterial\n"
   "uniform BlinnPhongInfo blinnPhongMaterial;\n"
-  "uniform MatrixInfo matrices;\n"
-  "uniform ViewerInfo viewer;\n"
+  "#endif\n"
+  FrameBlock
   "void main() {\n"
-  "  mat4 modelToProjectionMatrix = matrices.projection * matrices.view * matrices.world;\n"
-  "  mat3 normalMatrix = mat3(transpose(inverse(matrices.world)));"
+  "  mat4 worldMatrix = matrices.world;\n"
+  // Apply the per-instance transform (if any).
+  "  if (instanceDescriptor == InstanceSemantics_Transform3x4_MaterialIndex) {\n"
+  "    worldMatrix = worldMatrix * transpose(mat4(" InstanceTransformRow0Name ", " InstanceTransformRow1Name ", " InstanceTransformRow2Name ", vec4(0., 0., 0., 1.)));\n"
+  "  }\n"
+  "  mat4 modelToProjectionMatrix = matrices.projection * matrices.view * worldMatrix;\n"
+  "  mat3 normalMatrix = mat3(transpose(inverse(worldMatrix)));"
   "  gl_Position = modelToProjectionMatrix * vec4(vertexPosition, 1.);\n"
-  "  _fragment.worldPosition = (matrices.world * vec4(vertexPosition, 1.)).xyz;\n"
+  "  _fragment.worldPosition = (worldMatrix * vec4(vertexPosition, 1.)).xyz;\n"
+  "  _fragment.viewDepth = -(matrices.view * vec4(_fragment.worldPosition, 1.)).z;\n"
   "  _fragment.normal = normalMatrix * vertexNormal;\n"
   "  _viewer.position = viewer.position;\n"
   // Use the per-mesh Phong/Blinn-Phong information.
+  "#if withPhongMaterial\n"
   "  _fragment.phong.ambient = phongMaterial.ambient;\n"
   "  _fragment.phong.diffuse = phongMaterial.diffuse;\n"
   "  _fragment.phong.specular = phongMaterial.specular;\n"
   "  _fragment.phong.shininess = phongMaterial.shininess;\n"
+  "#endif\n"
+  "#if withBlinnPhongMaterial\n"
   "  _fragment.blinnPhong.ambient = blinnPhongMaterial.ambient;\n"
   "  _fragment.blinnPhong.diffuse = blinnPhongMaterial.diffuse;\n"
   "  _fragment.blinnPhong.specular = blinnPhongMaterial.specular;\n"
   "  _fragment.blinnPhong.shininess = blinnPhongMaterial.shininess;\n"
+  "#endif\n"
   // Use the per-vertex Phong/Blinn-Phong information.
-  "  if (vertexDescriptor == VertexSemantics_PositionXyz_NormalXyz_AmbientRgb) {\n"
+  "  if (isVertexFormat(VertexSemantics_PositionXyz_NormalXyz_AmbientRgb)) {\n"
   "    _fragment.phong.ambient = vertexAmbient;\n"
   "    _fragment.blinnPhong.ambient = vertexAmbient;\n"
   "  }\n"
-  "  if (vertexDescriptor == VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess) {\n"
+  "  if (isVertexFormat(VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess)) {\n"
   "    _fragment.phong.ambient = vertexAmbient;\n"
   "    _fragment.phong.diffuse = vertexDiffuse;\n"
   "    _fragment.phong.specular = vertexSpecular;\n"
@@ -157,6 +252,17 @@ static const GLchar* Programs_Pbr1_vertexProgram =
   "    _fragment.blinnPhong.specular = vertexSpecular;\n"
   "    _fragment.blinnPhong.shininess = vertexShininess;\n"
   "  }\n"
+  // Use the Phong/Blinn-Phong information of the indexed material.
+  "  if (isVertexFormat(VertexSemantics_PositionXyz_NormalXyz_MaterialIndex) ||\n"
+  "      isVertexFormat(VertexSemantics_PositionXyz_NormalXyz_TextureUv_MaterialIndex)) {\n"
+  "    uint materialIndex = " VertexMaterialIndexName ";\n"
+  "    if (instanceDescriptor == InstanceSemantics_Transform3x4_MaterialIndex) {\n"
+  "      materialIndex = " InstanceMaterialIndexName ";\n"
+  "    }\n"
+  "    materialIndex = min(materialIndex, uint(maximumNumberOfMaterials - 1));\n"
+  "    _fragment.phong = materials[materialIndex].phong;\n"
+  "    _fragment.blinnPhong = materials[materialIndex].blinnPhong;\n"
+  "  }\n"
   "}\n"
   ;
 
@@ -174,11 +280,13 @@ static const GLchar* Programs_Pbr1_fragmentProgram =
 
   MatrixInfoType
   ViewerInfoType
+  ClusterInfoType
   PhongInfoType
   BlinnPhongInfoType
 
   "in FRAGMENT {\n"
   "  vec3 worldPosition;\n"
+  "  float viewDepth;\n"
   "  vec3 color;\n"
   "  vec3 normal;\n"
   "  PhongInfo phong;\n"
@@ -191,12 +299,12 @@ static const GLchar* Programs_Pbr1_fragmentProgram =
 
   "#define LightType_Ambient (4)\n"
   "#define LightType_DirectionalDiffuse (8)\n"
-  // @todo Add support.
-  //"#define LightType_PointDiffuse (16)\n"
+  "#define LightType_Point (16)\n"
   // @todo Add support.
   //"#define LightType_DirectionalSpecular (32)\n"
   "#define LightType_PointSpecularPhong (64)\n"
   "#define LightType_PointSpecularBlinnPhong (128)\n"
+  "#define LightType_Spot (256)\n"
 
   /* Type of light model "Phong". */
   "#define LightModel_Phong (1)\n"
@@ -204,9 +312,13 @@ static const GLchar* Programs_Pbr1_fragmentProgram =
   "#define LightModel_BlinnPhong (2)\n"
 
   /// The maximum number of lights.
-  "#define maximumNumberOfLights 32\n"
-  /// The current number of lights.
-  "uniform int currentNumberOfLights;\n"
+  "#define maximumNumberOfLights " Stringify(Visuals_LightSet_MaximumNumberOfLights) "\n"
+  /// A permutation for a light count bucket only evaluates the lights of that bucket.
+  "#if defined(NUMBER_OF_LIGHTS)\n"
+  "#define evaluatedNumberOfLights NUMBER_OF_LIGHTS\n"
+  "#else\n"
+  "#define evaluatedNumberOfLights maximumNumberOfLights\n"
+  "#endif\n"
 
   "struct Light {\n"
   "  int type;\n"
@@ -214,8 +326,46 @@ static const GLchar* Programs_Pbr1_fragmentProgram =
   "  vec3 position;\n"
   "  vec3 direction;\n"
   "};\n"
-  
-  "uniform Light g_lights[maximumNumberOfLights];\n"
+
+  // The lights of a light set. See Visuals_LightSet for the layout of the uniform block.
+  "struct LightInfo {\n"
+  "  int type;\n"
+  "  float radius;\n"
+  "  float cosInnerAngle;\n"
+  "  float cosOuterAngle;\n"
+  "  vec4 color;\n"
+  "  vec4 position;\n"
+  "  vec4 direction;\n"
+  "};\n"
+
+  "layout(std140) uniform Lights {\n"
+  "  int currentNumberOfLights;\n"
+  "  LightInfo lights[maximumNumberOfLights];\n"
+  "};\n"
+
+  // The clustered point lights. See Visuals_LightClusters for the layout of the uniform blocks.
+  "#define maximumNumberOfClusteredLights " Stringify(Visuals_LightClusters_MaximumNumberOfLights) "\n"
+  "#define maximumNumberOfClusterIndices " Stringify(Visuals_LightClusters_MaximumNumberOfIndices) "\n"
+  "#define ClusterGridWidth " Stringify(Visuals_LightClusters_GridWidth) "\n"
+  "#define ClusterGridHeight " Stringify(Visuals_LightClusters_GridHeight) "\n"
+  "#define ClusterGridDepth " Stringify(Visuals_LightClusters_GridDepth) "\n"
+
+  "struct ClusteredLight {\n"
+  "  vec4 positionRadius;\n"
+  "  vec4 color;\n"
+  "};\n"
+
+  "layout(std140) uniform ClusteredLights {\n"
+  "  ClusteredLight clusteredLights[maximumNumberOfClusteredLights];\n"
+  "};\n"
+  "layout(std140) uniform ClusterGrid {\n"
+  "  uvec4 clusterGrid[ClusterGridWidth * ClusterGridHeight * ClusterGridDepth / 4];\n"
+  "};\n"
+  "layout(std140) uniform ClusterIndices {\n"
+  "  uvec4 clusterIndices[maximumNumberOfClusterIndices / 8];\n"
+  "};\n"
+
+  FrameBlock
 
   "struct FragmentInfo {\n"
   "  vec3 worldPosition;\n"
@@ -236,33 +386,68 @@ static const GLchar* Programs_Pbr1_fragmentProgram =
   "  return intensity * fragment.phong.diffuse * light.color; \n"
   "}\n"
 
-  "vec3 onPointSpecular2(in FragmentInfo fragment, in ViewerInfo viewer, in Light light) {\n"
+  "vec3 onPointSpecularPhong2(in FragmentInfo fragment, in ViewerInfo viewer, in Light light) {\n"
   "  vec3 fragmentToViewerDirection = normalize(viewer.position - fragment.worldPosition);\n"
   "  vec3 fragmentToLightDirection = normalize(light.position - fragment.worldPosition);\n"
-  "  switch (light.type) {\n"
-  "    case LightType_PointSpecularPhong: {\n"
-  "     vec3 reflectionDirection = normalize(reflect(-fragmentToLightDirection, fragment.normal)); \n"
-  "     float term = dot(fragmentToViewerDirection, reflectionDirection);\n"
-  "     float intensity;\n"
-  "     intensity = pow(max(term, 0.0), fragment.phong.shininess);"
-  "     intensity = pow(smoothstep(0.0, 1.0, term), fragment.phong.shininess);\n"
-  "     return intensity * fragment.phong.specular * light.color;\n"
-  "    } break;\n"
-  "    case LightType_PointSpecularBlinnPhong: {\n"
-  "      vec3 halfWay = normalize(fragmentToViewerDirection + fragmentToLightDirection);\n"
-  "      float term =  dot(fragment.normal, halfWay);\n"
-  "      float intensity;\n"
-  "      intensity = pow(max(term, 0.0), fragment.phong.shininess);"
-  "      intensity = pow(smoothstep(0.0, 1.0, term), fragment.blinnPhong.shininess);\n"
-  "      return intensity * fragment.blinnPhong.specular * light.color;\n"
-  "    } break;\n"
-  "    default: {\n"
-  "      return vec3(0);\n"
-  "    } break;\n"
-  "  };\n"
+  "  vec3 reflectionDirection = normalize(reflect(-fragmentToLightDirection, fragment.normal)); \n"
+  "  float term = dot(fragmentToViewerDirection, reflectionDirection);\n"
+  "  float intensity = pow(smoothstep(0.0, 1.0, term), fragment.phong.shininess);\n"
+  "  return intensity * fragment.phong.specular * light.color;\n"
+  "}\n"
+
+  "vec3 onPointSpecularBlinnPhong2(in FragmentInfo fragment, in ViewerInfo viewer, in Light light) {\n"
+  "  vec3 fragmentToViewerDirection = normalize(viewer.position - fragment.worldPosition);\n"
+  "  vec3 fragmentToLightDirection = normalize(light.position - fragment.worldPosition);\n"
+  "  vec3 halfWay = normalize(fragmentToViewerDirection + fragmentToLightDirection);\n"
+  "  float term =  dot(fragment.normal, halfWay);\n"
+  "  float intensity = pow(smoothstep(0.0, 1.0, term), fragment.blinnPhong.shininess);\n"
+  "  return intensity * fragment.blinnPhong.specular * light.color;\n"
+  "}\n"
+
+  // A permutation for a light model evaluates every point specular light with that light model.
+  "vec3 onPointSpecular2(in FragmentInfo fragment, in ViewerInfo viewer, in Light light) {\n"
+  "#if !defined(LIGHT_MODEL)\n"
+  "  if (light.type == LightType_PointSpecularPhong) {\n"
+  "    return onPointSpecularPhong2(fragment, viewer, light);\n"
+  "  } else {\n"
+  "    return onPointSpecularBlinnPhong2(fragment, viewer, light);\n"
+  "  }\n"
+  "#elif LIGHT_MODEL == LightModel_Phong\n"
+  "  return onPointSpecularPhong2(fragment, viewer, light);\n"
+  "#else\n"
+  "  return onPointSpecularBlinnPhong2(fragment, viewer, light);\n"
+  "#endif\n"
   "}\n"
    
-  "void onLight2(in FragmentInfo fragment, in ViewerInfo viewer, in Light light, inout vec3 ambient, inout vec3 diffuse, inout vec3 specular) {\n"
+  // A point light or a spot light. It fades smoothly to zero at its radius if its radius is positive.
+  "void onLocalLight2(in FragmentInfo fragment, in ViewerInfo viewer, in LightInfo info, inout vec3 diffuse, inout vec3 specular) {\n"
+  "  vec3 lightToFragment = fragment.worldPosition - info.position.xyz;\n"
+  "  float attenuation = 1.;\n"
+  "  if (info.radius > 0.) {\n"
+  "    float x = length(lightToFragment) / info.radius;\n"
+  "    if (x >= 1.) return;\n"
+  "    attenuation = 1. - x * x * x * x;\n"
+  "    attenuation *= attenuation;\n"
+  "  }\n"
+  "  if (info.type == LightType_Spot) {\n"
+  "    float cosAngle = dot(normalize(lightToFragment), info.direction.xyz);\n"
+  "    attenuation *= smoothstep(info.cosOuterAngle, max(info.cosInnerAngle, info.cosOuterAngle + 1e-4), cosAngle);\n"
+  "  }\n"
+  "  Light light;\n"
+  "  light.type = LightType_PointSpecularPhong;\n"
+  "  light.color = info.color.rgb * attenuation;\n"
+  "  light.position = info.position.xyz;\n"
+  "  light.direction = lightToFragment;\n"
+  "  diffuse += onDiffuse2(fragment, light);\n"
+  "  specular += onPointSpecular2(fragment, viewer, light);\n"
+  "}\n"
+
+  "void onLight2(in FragmentInfo fragment, in ViewerInfo viewer, in LightInfo info, inout vec3 ambient, inout vec3 diffuse, inout vec3 specular) {\n"
+  "  Light light;\n"
+  "  light.type = info.type;\n"
+  "  light.color = info.color.rgb;\n"
+  "  light.position = info.position.xyz;\n"
+  "  light.direction = info.direction.xyz;\n"
   "  switch(light.type) {\n"
   "    case LightType_DirectionalDiffuse: {\n"
   "      diffuse += onDiffuse2(fragment, light);\n"
@@ -274,9 +459,28 @@ static const GLchar* Programs_Pbr1_fragmentProgram =
   "    case LightType_PointSpecularBlinnPhong: {\n"
   "      specular += onPointSpecular2(fragment, viewer, light);\n"
   "    } break;"
+  "    case LightType_Point:\n"
+  "    case LightType_Spot: {\n"
+  "      onLocalLight2(fragment, viewer, info, diffuse, specular);\n"
+  "    } break;"
   "  };\n"
   "}\n"
 
+  "void onClusteredLight2(in FragmentInfo fragment, in ViewerInfo viewer, in ClusteredLight clusteredLight, inout vec3 diffuse, inout vec3 specular) {\n"
+  "  vec3 fragmentToLight = clusteredLight.positionRadius.xyz - fragment.worldPosition;\n"
+  "  float x = length(fragmentToLight) / clusteredLight.positionRadius.w;\n"
+  "  if (x >= 1.) return;\n"
+  // The light fades smoothly to zero at the radius.
+  "  float attenuation = 1. - x * x * x * x;\n"
+  "  Light light;\n"
+  "  light.type = LightType_PointSpecularPhong;\n"
+  "  light.color = clusteredLight.color.rgb * attenuation * attenuation;\n"
+  "  light.position = clusteredLight.positionRadius.xyz;\n"
+  "  light.direction = -fragmentToLight;\n"
+  "  diffuse += onDiffuse2(fragment, light);\n"
+  "  specular += onPointSpecular2(fragment, viewer, light);\n"
+  "}\n"
+
   "void main() {\n"
   "  FragmentInfo fragmentInfo;\n"
   "  fragmentInfo.worldPosition = _fragment.worldPosition;\n"
@@ -289,8 +493,24 @@ static const GLchar* Programs_Pbr1_fragmentProgram =
   "  viewerInfo.position = _viewer.position;\n"
   "\n"
   "  vec3 ambient = vec3(0), diffuse = vec3(0), specular = vec3(0);\n"
-  "  for (int i = 0, n = currentNumberOfLights; i < n; ++i) {\n"
-  "    onLight2(fragmentInfo, viewerInfo, g_lights[i], ambient, diffuse, specular);"
+  // The loop has a constant trip count such that the compiler can unroll it.
+  "  for (int i = 0; i < evaluatedNumberOfLights; ++i) {\n"
+  "    if (i >= currentNumberOfLights) break;\n"
+  "    onLight2(fragmentInfo, viewerInfo, lights[i], ambient, diffuse, specular);"
+  "  }\n"
+  // Only evaluate the clustered lights of the cluster of the fragment.
+  "  if (clusters.numberOfLights > 0) {\n"
+  "    ivec3 cluster;\n"
+  "    cluster.xy = min(ivec2(gl_FragCoord.xy * clusters.parameters.xy), ivec2(ClusterGridWidth - 1, ClusterGridHeight - 1));\n"
+  "    cluster.z = clamp(int(log(max(_fragment.viewDepth, 1e-4)) * clusters.parameters.z + clusters.parameters.w), 0, ClusterGridDepth - 1);\n"
+  "    int c = (cluster.z * ClusterGridHeight + cluster.y) * ClusterGridWidth + cluster.x;\n"
+  "    uint record = clusterGrid[c >> 2][c & 3];\n"
+  "    uint first = record >> 16u, last = first + (record & 0xFFFFu);\n"
+  "    for (uint k = first; k < last; ++k) {\n"
+  "      uint word = clusterIndices[k >> 3u][(k >> 1u) & 3u];\n"
+  "      uint index = (word >> ((k & 1u) * 16u)) & 0xFFFFu;\n"
+  "      onClusteredLight2(fragmentInfo, viewerInfo, clusteredLights[index], diffuse, specular);\n"
+  "    }\n"
   "  }\n"
   "\n"
   "  if (diffuse.x <= 0.f) specular.x = 0.f;\n"
@@ -304,6 +524,8 @@ static const GLchar* Programs_Pbr1_fragmentProgram =
 // Vertex shader.
 static const GLchar* Programs_Simple_vertexProgram =
   "#version 330 core\n"
+  // selects the kernel of the software renderer
+  "#pragma zeitgeist_program(simple)\n"
   "layout(location = 0) in vec3 " VertexPositionName ";\n"
   "uniform mat4 scale = mat4(1);\n"
   "void main() {\n"
@@ -323,23 +545,247 @@ static const GLchar* Programs_Simple_fragmentProgram =
   "}\n"
   ;
 
+// A uniform block of a program and the binding point it is assigned to.
+typedef struct UniformBlock {
+  char const* name;
+  Shizu_Integer32 binding;
+} UniformBlock;
+
+static UniformBlock const Programs_Pbr1_uniformBlocks[] = {
+  { "Materials", Visuals_UniformBlockBinding_Materials },
+  { "ClusteredLights", Visuals_UniformBlockBinding_ClusteredLights },
+  { "ClusterGrid", Visuals_UniformBlockBinding_ClusterGrid },
+  { "ClusterIndices", Visuals_UniformBlockBinding_ClusterIndices },
+  { "Lights", Visuals_UniformBlockBinding_Lights },
+  { "Frame", Visuals_UniformBlockBinding_Frame },
+};
+
+typedef struct ProgramSources {
+  char const* name;
+  GLchar const* const* vertexProgram;
+  GLchar const* const* fragmentProgram;
+  /// The uniform blocks assigned to their binding points when a program is created.
+  UniformBlock const* uniformBlocks;
+  size_t numberOfUniformBlocks;
+} ProgramSources;
+
+static ProgramSources const PROGRAMS[] = {
+  { "simple", &Programs_Simple_vertexProgram, &Programs_Simple_fragmentProgram, NULL, 0 },
+  { "pbr1", &Programs_Pbr1_vertexProgram, &Programs_Pbr1_fragmentProgram,
+    Programs_Pbr1_uniformBlocks, sizeof(Programs_Pbr1_uniformBlocks) / sizeof(Programs_Pbr1_uniformBlocks[0]) },
+};
+
+// Get the sources of the program of the specified name.
+// Return the null pointer if there is no such program.
+static ProgramSources const*
+getSources
+  (
+    char const* name
+  )
+{
+  for (size_t i = 0; i < sizeof(PROGRAMS) / sizeof(PROGRAMS[0]); ++i) {
+    if (!strcmp(name, PROGRAMS[i].name)) {
+      return &PROGRAMS[i];
+    }
+  }
+  return NULL;
+}
+
+// Create a program for the renderer selected at startup.
+// Its uniform blocks are assigned to their binding points once such that they need not be assigned per draw call.
+static Visuals_Program*
+createProgram
+  (
+    Shizu_State2* state,
+    ProgramSources const* sources,
+    Shizu_String* vertexProgram,
+    Shizu_String* fragmentProgram
+  )
+{
+  Visuals_Program* program = NULL;
+  if (Visuals_Gl_Service_isSoftwareRenderer(state)) {
+    program = (Visuals_Program*)Visuals_Software_Program_create(state, vertexProgram, fragmentProgram);
+  } else {
+    program = (Visuals_Program*)Visuals_Gl_Program_create(state, vertexProgram, fragmentProgram);
+  }
+  for (size_t i = 0; i < sources->numberOfUniformBlocks; ++i) {
+    Visuals_Program_bindUniformBlock(state, program, sources->uniformBlocks[i].name, sources->uniformBlocks[i].binding);
+  }
+  return program;
+}
+
 /**
  * @since 1.0
  * Get the program of the specified name.
  * There are two programs currently:
  * "simple" and "pbr1".
+ * The program is created for the renderer selected at startup.
  */
 Visuals_Program* Visuals_getProgram(Shizu_State2* state, char const* name) {
-  if (!strcmp(name, "simple")) {
-    return (Visuals_Program*)
-           Visuals_Gl_Program_create(state, Shizu_String_create(state, Programs_Simple_vertexProgram, strlen(Programs_Simple_vertexProgram)),
-                                            Shizu_String_create(state, Programs_Simple_fragmentProgram, strlen(Programs_Simple_fragmentProgram)));
-  } else if (!strcmp(name, "pbr1")) {
-    return (Visuals_Program*)
-           Visuals_Gl_Program_create(state, Shizu_String_create(state, Programs_Pbr1_vertexProgram, strlen(Programs_Pbr1_vertexProgram)),
-                                            Shizu_String_create(state, Programs_Pbr1_fragmentProgram, strlen(Programs_Pbr1_fragmentProgram)));
-  } else {
+  ProgramSources const* sources = getSources(name);
+  if (!sources) {
     Shizu_State2_setStatus(state, 1);
     Shizu_State2_jump(state);
   }
-}
\ No newline at end of file
+  return createProgram(state, sources, Shizu_String_create(state, *sources->vertexProgram, strlen(*sources->vertexProgram)),
+                              Shizu_String_create(state, *sources->fragmentProgram, strlen(*sources->fragmentProgram)));
+}
+
+typedef struct Permutation {
+  /// @brief The sources of the program.
+  ProgramSources const* sources;
+  uint32_t vertexSemantics;
+  Shizu_Integer32 lightModel;
+  /// @brief The light count bucket.
+  size_t numberOfLights;
+  /// @brief The program. Locked by the cache.
+  Visuals_Program* program;
+} Permutation;
+
+static struct {
+  Permutation* elements;
+  size_t size;
+  size_t capacity;
+} g_permutations = {
+  .elements = NULL,
+  .size = 0,
+  .capacity = 0,
+};
+
+// Get the light count bucket of a number of lights: The smallest power of two greater than or equal to that number.
+static size_t
+getLightCountBucket
+  (
+    size_t numberOfLights
+  )
+{
+  size_t bucket = 1;
+  while (bucket < numberOfLights) {
+    bucket *= 2;
+  }
+  return bucket;
+}
+
+// Create the source of a permutation.
+// The defines are inserted after the first line of the source which is the "#version" directive.
+static Shizu_String*
+createPermutationSource
+  (
+    Shizu_State2* state,
+    char const* source,
+    char const* defines
+  )
+{
+  char const* p = strchr(source, '\n');
+  size_t n = p ? (size_t)(p - source) + 1 : 0;
+  size_t numberOfSourceBytes = strlen(source), numberOfDefinesBytes = strlen(defines);
+  char* bytes = malloc(numberOfSourceBytes + numberOfDefinesBytes);
+  if (!bytes) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  memcpy(bytes, source, n);
+  memcpy(bytes + n, defines, numberOfDefinesBytes);
+  memcpy(bytes + n + numberOfDefinesBytes, source + n, numberOfSourceBytes - n);
+  Shizu_String* string = NULL;
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    string = Shizu_String_create(state, bytes, numberOfSourceBytes + numberOfDefinesBytes);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    free(bytes);
+    Shizu_State2_jump(state);
+  }
+  free(bytes);
+  return string;
+}
+
+Visuals_Program*
+Visuals_getProgramPermutation
+  (
+    Shizu_State2* state,
+    char const* name,
+    uint32_t vertexSemantics,
+    Shizu_Integer32 lightModel,
+    size_t numberOfLights
+  )
+{
+  switch (vertexSemantics) {
+    case Visuals_VertexSemantics_PositionXyz:
+    case Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb:
+    case Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess:
+    case Visuals_VertexSemantics_PositionXyz_NormalXyz_MaterialIndex:
+    case Visuals_VertexSemantics_PositionXyz_NormalXyz_TextureUv_MaterialIndex: {
+      /* Intentionally empty. */
+    } break;
+    default: {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    } break;
+  };
+  if (Visuals_LightModel_Phong != lightModel && Visuals_LightModel_BlinnPhong != lightModel) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  if (numberOfLights > Visuals_MaximumNumberOfLights) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  ProgramSources const* sources = getSources(name);
+  if (!sources) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  size_t bucket = getLightCountBucket(numberOfLights);
+  for (size_t i = 0; i < g_permutations.size; ++i) {
+    Permutation* permutation = &g_permutations.elements[i];
+    if (permutation->sources == sources && permutation->vertexSemantics == vertexSemantics &&
+        permutation->lightModel == lightModel && permutation->numberOfLights == bucket) {
+      return permutation->program;
+    }
+  }
+  if (g_permutations.size == g_permutations.capacity) {
+    size_t newCapacity = g_permutations.capacity ? g_permutations.capacity * 2 : 8;
+    Permutation* newElements = realloc(g_permutations.elements, newCapacity * sizeof(Permutation));
+    if (!newElements) {
+      Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State2_jump(state);
+    }
+    g_permutations.elements = newElements;
+    g_permutations.capacity = newCapacity;
+  }
+  char defines[128];
+  snprintf(defines, sizeof(defines), "#define VERTEX_FORMAT (%u)\n#define LIGHT_MODEL (%d)\n#define NUMBER_OF_LIGHTS (%zu)\n",
+           (unsigned int)vertexSemantics, (int)lightModel, bucket);
+  Visuals_Program* program = createProgram(state, sources, createPermutationSource(state, *sources->vertexProgram, defines),
+                                                  createPermutationSource(state, *sources->fragmentProgram, defines));
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)program);
+  Permutation* permutation = &g_permutations.elements[g_permutations.size++];
+  permutation->sources = sources;
+  permutation->vertexSemantics = vertexSemantics;
+  permutation->lightModel = lightModel;
+  permutation->numberOfLights = bucket;
+  permutation->program = program;
+  // The program is compiled while the frames are rendered with the permutations which are ready.
+  Visuals_Program_materializeAsync(state, program);
+  return program;
+}
+
+void
+Visuals_releaseProgramPermutations
+  (
+    Shizu_State2* state
+  )
+{
+  for (size_t i = 0; i < g_permutations.size; ++i) {
+    Visuals_Program* program = g_permutations.elements[i].program;
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)program);
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)program);
+  }
+  free(g_permutations.elements);
+  g_permutations.elements = NULL;
+  g_permutations.size = 0;
+  g_permutations.capacity = 0;
+}
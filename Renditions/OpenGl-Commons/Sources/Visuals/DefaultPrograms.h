@@ -22,6 +22,7 @@
 #if !defined(VISUALS_DEFAULTPROGRAMS_H_INCLUDED)
 #define VISUALS_DEFAULTPROGRAMS_H_INCLUDED
 
+#include "Visuals/LightSet.h"
 #include "Visuals/Program.h"
 
 /**
@@ -29,7 +30,97 @@
  * Get the program of the specified name.
  * There are two programs currently:
  * "simple" and "pbr1". 
+ * The uniform blocks of the "pbr1" program are assigned to the binding points Visuals_UniformBlockBinding_*.
  */
 Visuals_Program* Visuals_getProgram(Shizu_State2* state, char const* name);
 
+/// @since 1.0
+/// The light model "Phong" of a program permutation.
+#define Visuals_LightModel_Phong (1)
+
+/// @since 1.0
+/// The light model "Blinn-Phong" of a program permutation.
+#define Visuals_LightModel_BlinnPhong (2)
+
+/// @since 1.0
+/// The maximum number of lights of a program permutation.
+/// The lights of a light set (see Visuals_LightSet).
+#define Visuals_MaximumNumberOfLights (Visuals_LightSet_MaximumNumberOfLights)
+
+/// @since 1.0
+/// The uniform buffer binding point of the "Materials" uniform block of the "pbr1" program.
+#define Visuals_UniformBlockBinding_Materials (0)
+
+/// @since 1.0
+/// The uniform buffer binding points of the "ClusteredLights", "ClusterGrid", and "ClusterIndices" uniform blocks of the "pbr1" program.
+/// See Visuals_LightClusters_upload.
+#define Visuals_UniformBlockBinding_ClusteredLights (1)
+#define Visuals_UniformBlockBinding_ClusterGrid (2)
+#define Visuals_UniformBlockBinding_ClusterIndices (3)
+
+/// @since 1.0
+/// The uniform buffer binding point of the "Lights" uniform block of the "pbr1" program.
+/// See Visuals_LightSet_upload.
+#define Visuals_UniformBlockBinding_Lights (4)
+
+/// @since 1.0
+/// The uniform buffer binding point of the "Frame" uniform block of the "pbr1" program.
+#define Visuals_UniformBlockBinding_Frame (5)
+
+/// @since 1.0
+/// @brief The std140 layout of the "Frame" uniform block of the "pbr1" program.
+/// The block is declared row_major: The matrices are stored row by row like the data of an idlib_matrix_4x4_f32 value.
+typedef struct Visuals_FrameBlock {
+  /// @brief The projection matrix, the view matrix, and the world matrix.
+  Shizu_Float32 projection[4][4], view[4][4], world[4][4];
+  /// @brief The position of the viewer in world coordinates. The fourth component is zero.
+  Shizu_Float32 viewerPosition[4];
+  /// @brief The parameters of the light clusters (see Visuals_LightClusters_getParameters).
+  Shizu_Float32 clusterParameters[4];
+  /// @brief The number of clustered lights. If zero, the uniform blocks of the clustered lights are not accessed.
+  Shizu_Integer32 numberOfClusteredLights;
+  Shizu_Integer32 padding[3];
+} Visuals_FrameBlock;
+
+/**
+ * @since 1.0
+ * Get the permutation of the program of the specified name.
+ * A permutation is generated from the source of the program with the defines
+ * VERTEX_FORMAT, LIGHT_MODEL, and NUMBER_OF_LIGHTS inserted after the "#version" directive.
+ * The branches on the vertex format and the light model are resolved by the compiler and
+ * only the uniforms of the vertex format and the light model are active.
+ * @param name The name of the program.
+ * @param vertexSemantics The vertex semantics (e.g., Visuals_VertexSemantics_PositionXyz_NormalXyz_MaterialIndex).
+ * @param lightModel Visuals_LightModel_Phong or Visuals_LightModel_BlinnPhong.
+ * @param numberOfLights The number of lights. The permutation is created for the light count bucket of that number,
+ * the smallest power of two greater than or equal to that number.
+ * @return The program.
+ * @remarks
+ * Permutations are cached by their key and are owned by the cache.
+ * The compilation of a permutation is started when it is created.
+ * Use Visuals_Program_isPending to check if a permutation is ready.
+ * @error Shizu_Status_ArgumentValueInvalid @a name, @a vertexSemantics, or @a lightModel is invalid.
+ * @error Shizu_Status_ArgumentOutOfRange @a numberOfLights is greater than Visuals_MaximumNumberOfLights.
+ */
+Visuals_Program*
+Visuals_getProgramPermutation
+  (
+    Shizu_State2* state,
+    char const* name,
+    uint32_t vertexSemantics,
+    Shizu_Integer32 lightModel,
+    size_t numberOfLights
+  );
+
+/**
+ * @since 1.0
+ * Unmaterialize and release the cached program permutations.
+ * Invoked by the service when it shuts down.
+ */
+void
+Visuals_releaseProgramPermutations
+  (
+    Shizu_State2* state
+  );
+
 #endif // VISUALS_DEFAULTPROGRAMS_H_INCLUDED
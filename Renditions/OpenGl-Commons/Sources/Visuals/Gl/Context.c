@@ -1,10 +1,51 @@
 #include "Visuals/Gl/Context.h"
 
+#include "Visuals/Gl/IndexBuffer.h"
 #include "Visuals/Gl/Program.h"
 #include "Visuals/Gl/RenderBuffer.h"
+#include "Visuals/Gl/Sharpen.h"
+#include "Visuals/Gl/Texture.h"
+#include "Visuals/Gl/UniformBuffer.h"
 #include "Visuals/Gl/VertexBuffer.h"
 #include "Visuals/Service.package.h"
 
+/// @brief The frame buffer bound by the last call to Visuals_Context_setRenderBuffer.
+/// The frame buffer binding is GL state shared by all contexts.
+/// Viewports are relative to the size of this frame buffer.
+static struct {
+  /// @brief The render buffer or null if the default frame buffer is bound.
+  /// This is a weak reference: it is only used for comparison.
+  Visuals_Gl_RenderBuffer* renderBuffer;
+  /// @brief The ID of the frame buffer.
+  GLuint frameBufferId;
+  /// @brief The width, in pixels, of the frame buffer if a render buffer is bound.
+  Shizu_Integer32 width;
+  /// @brief The height, in pixels, of the frame buffer if a render buffer is bound.
+  Shizu_Integer32 height;
+} g_target = {
+  .renderBuffer = NULL,
+  .frameBufferId = 0,
+  .width = 0,
+  .height = 0,
+};
+
+// Get the size, in pixels, of the bound frame buffer.
+static void
+getTargetSize
+  (
+    Shizu_State2* state,
+    Shizu_Integer32* width,
+    Shizu_Integer32* height
+  )
+{
+  if (g_target.renderBuffer) {
+    *width = g_target.width;
+    *height = g_target.height;
+  } else {
+    Visuals_Gl_Service_getClientSize(state, width, height);
+  }
+}
+
 static void
 Visuals_Gl_Context_finalize
   (
@@ -42,6 +83,27 @@ Visuals_Gl_Context_createVertexBufferImpl
     Visuals_Gl_Context* self
   );
 
+static Visuals_IndexBuffer*
+Visuals_Gl_Context_createIndexBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Context* self
+  );
+
+static Visuals_UniformBuffer*
+Visuals_Gl_Context_createUniformBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Context* self
+  );
+
+static Visuals_Texture*
+Visuals_Gl_Context_createTextureImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Context* self
+  );
+
 static void
 Visuals_Gl_Context_setClearColorImpl
   (
@@ -114,6 +176,26 @@ Visuals_Gl_Context_setRenderBufferImpl
     Visuals_Gl_RenderBuffer* renderBuffer
   );
 
+static inline void
+Visuals_Gl_Context_setUniformBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Context* self,
+    Shizu_Integer32 index,
+    Visuals_Gl_UniformBuffer* uniformBuffer
+  );
+
+static void
+Visuals_Gl_Context_blitRenderBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Context* self,
+    Visuals_Gl_RenderBuffer* renderBuffer,
+    Shizu_Float32 width,
+    Shizu_Float32 height,
+    Visuals_BlitFilter filter
+  );
+
 static inline void
 Visuals_Gl_Context_renderImpl
   (
@@ -123,6 +205,66 @@ Visuals_Gl_Context_renderImpl
     Visuals_Gl_Program* program
   );
 
+// Get the OpenGL mode of a primitive type.
+static inline GLenum
+toPrimitiveMode
+  (
+    Shizu_State2* state,
+    Visuals_PrimitiveType primitiveType
+  )
+{
+  switch (primitiveType) {
+    case Visuals_PrimitiveType_Triangles: {
+      return GL_TRIANGLES;
+    } break;
+    case Visuals_PrimitiveType_TriangleStrip: {
+      return GL_TRIANGLE_STRIP;
+    } break;
+    case Visuals_PrimitiveType_Lines: {
+      return GL_LINES;
+    } break;
+    default: {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+      Shizu_State2_jump(state);
+    } break;
+  };
+}
+
+static inline void
+Visuals_Gl_Context_renderRangesImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Context* self,
+    Visuals_Gl_VertexBuffer* vertexBuffer,
+    Shizu_Integer32 const* firsts,
+    Shizu_Integer32 const* counts,
+    size_t numberOfRanges,
+    Visuals_Gl_Program* program
+  );
+
+static inline void
+Visuals_Gl_Context_renderIndexedImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Context* self,
+    Visuals_Gl_VertexBuffer* vertexBuffer,
+    Visuals_Gl_IndexBuffer* indexBuffer,
+    Visuals_PrimitiveType primitiveType,
+    Visuals_Gl_Program* program
+  );
+
+static inline void
+Visuals_Gl_Context_renderInstancedImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Context* self,
+    Visuals_Gl_VertexBuffer* vertexBuffer,
+    Visuals_Gl_VertexBuffer* instanceBuffer,
+    size_t numberOfInstances,
+    Visuals_PrimitiveType primitiveType,
+    Visuals_Gl_Program* program
+  );
+
 static void
 Visuals_Gl_Context_constructImpl
   (
@@ -153,7 +295,7 @@ Visuals_Gl_Context_finalize
     Shizu_State2* state,
     Visuals_Gl_Context* self
   )
-{/*Intentionally empty.*/}
+{ Visuals_Gl_Service_statistics.numberOfLiveContexts--; }
 
 static void
 Visuals_Gl_Context_dispatchInitialize
@@ -165,6 +307,9 @@ Visuals_Gl_Context_dispatchInitialize
   ((Visuals_Context_Dispatch*)self)->createProgram = (Visuals_Program*(*)(Shizu_State2*,Visuals_Context*,Shizu_String*,Shizu_String*)) & Visuals_Gl_Context_createProgramImpl;
   ((Visuals_Context_Dispatch*)self)->createRenderBuffer = (Visuals_RenderBuffer * (*)(Shizu_State2*, Visuals_Context*)) &Visuals_Gl_Context_createRenderBufferImpl;
   ((Visuals_Context_Dispatch*)self)->createVertexBuffer = (Visuals_VertexBuffer * (*)(Shizu_State2*, Visuals_Context*)) &Visuals_Gl_Context_createVertexBufferImpl;
+  ((Visuals_Context_Dispatch*)self)->createIndexBuffer = (Visuals_IndexBuffer * (*)(Shizu_State2*, Visuals_Context*)) &Visuals_Gl_Context_createIndexBufferImpl;
+  ((Visuals_Context_Dispatch*)self)->createUniformBuffer = (Visuals_UniformBuffer * (*)(Shizu_State2*, Visuals_Context*)) &Visuals_Gl_Context_createUniformBufferImpl;
+  ((Visuals_Context_Dispatch*)self)->createTexture = (Visuals_Texture * (*)(Shizu_State2*, Visuals_Context*)) &Visuals_Gl_Context_createTextureImpl;
   ((Visuals_Context_Dispatch*)self)->setClearColor = (void (*)(Shizu_State2*, Visuals_Context*, Shizu_Float32 r, Shizu_Float32 g, Shizu_Float32 b, Shizu_Float32 a)) & Visuals_Gl_Context_setClearColorImpl;
   ((Visuals_Context_Dispatch*)self)->setClearDepth = (void (*)(Shizu_State2*, Visuals_Context*, Shizu_Float32 z)) & Visuals_Gl_Context_setClearDepthImpl;
   ((Visuals_Context_Dispatch*)self)->setBlendFactors = (void (*)(Shizu_State2*, Visuals_Context*, Visuals_BlendFactor, Visuals_BlendFactor)) & Visuals_Gl_Context_setBlendFactorsImpl;
@@ -173,7 +318,12 @@ Visuals_Gl_Context_dispatchInitialize
   ((Visuals_Context_Dispatch*)self)->setViewport = (void (*)(Shizu_State2*, Visuals_Context*, Shizu_Float32, Shizu_Float32, Shizu_Float32, Shizu_Float32)) & Visuals_Gl_Context_setViewportImpl;
   ((Visuals_Context_Dispatch*)self)->clear = (void (*)(Shizu_State2*, Visuals_Context*, bool, bool)) & Visuals_Gl_Context_clearImpl;
   ((Visuals_Context_Dispatch*)self)->setRenderBuffer = (void (*)(Shizu_State2*, Visuals_Context*, Visuals_RenderBuffer*)) & Visuals_Gl_Context_setRenderBufferImpl;
+  ((Visuals_Context_Dispatch*)self)->setUniformBuffer = (void (*)(Shizu_State2*, Visuals_Context*, Shizu_Integer32, Visuals_UniformBuffer*)) & Visuals_Gl_Context_setUniformBufferImpl;
   ((Visuals_Context_Dispatch*)self)->render = (void (*)(Shizu_State2*, Visuals_Context*, Visuals_VertexBuffer*, Visuals_Program*)) & Visuals_Gl_Context_renderImpl;
+  ((Visuals_Context_Dispatch*)self)->renderRanges = (void (*)(Shizu_State2*, Visuals_Context*, Visuals_VertexBuffer*, Shizu_Integer32 const*, Shizu_Integer32 const*, size_t, Visuals_Program*)) & Visuals_Gl_Context_renderRangesImpl;
+  ((Visuals_Context_Dispatch*)self)->renderIndexed = (void (*)(Shizu_State2*, Visuals_Context*, Visuals_VertexBuffer*, Visuals_IndexBuffer*, Visuals_PrimitiveType, Visuals_Program*)) & Visuals_Gl_Context_renderIndexedImpl;
+  ((Visuals_Context_Dispatch*)self)->renderInstanced = (void (*)(Shizu_State2*, Visuals_Context*, Visuals_VertexBuffer*, Visuals_VertexBuffer*, size_t, Visuals_PrimitiveType, Visuals_Program*)) & Visuals_Gl_Context_renderInstancedImpl;
+  ((Visuals_Context_Dispatch*)self)->blitRenderBuffer = (void (*)(Shizu_State2*, Visuals_Context*, Visuals_RenderBuffer*, Shizu_Float32, Shizu_Float32, Visuals_BlitFilter)) & Visuals_Gl_Context_blitRenderBufferImpl;
 }
 
 static Visuals_Program*
@@ -241,6 +391,69 @@ Visuals_Gl_Context_createVertexBufferImpl
   return p;
 }
 
+static Visuals_IndexBuffer*
+Visuals_Gl_Context_createIndexBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Context* self
+  )
+{
+  Visuals_IndexBuffer* p = (Visuals_IndexBuffer*)Visuals_Gl_IndexBuffer_create(state);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Visuals_Service_registerVisualsObject(state, (Visuals_Object*)p);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)p);
+    Shizu_State2_jump(state);
+  }
+  return p;
+}
+
+static Visuals_UniformBuffer*
+Visuals_Gl_Context_createUniformBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Context* self
+  )
+{
+  Visuals_UniformBuffer* p = (Visuals_UniformBuffer*)Visuals_Gl_UniformBuffer_create(state);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Visuals_Service_registerVisualsObject(state, (Visuals_Object*)p);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)p);
+    Shizu_State2_jump(state);
+  }
+  return p;
+}
+
+static Visuals_Texture*
+Visuals_Gl_Context_createTextureImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Context* self
+  )
+{
+  Visuals_Texture* p = (Visuals_Texture*)Visuals_Gl_Texture_create(state);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Visuals_Service_registerVisualsObject(state, (Visuals_Object*)p);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)p);
+    Shizu_State2_jump(state);
+  }
+  return p;
+}
+
 static void
 Visuals_Gl_Context_setClearColorImpl
   (
@@ -393,15 +606,15 @@ Visuals_Gl_Context_setViewportImpl
     Shizu_Float32 height
   )
 {
-  Shizu_Integer32 clientWidth, clientHeight;
-  Visuals_Gl_Service_getClientSize(state, &clientWidth, &clientHeight);
+  Shizu_Integer32 targetWidth, targetHeight;
+  getTargetSize(state, &targetWidth, &targetHeight);
   self->viewport.left = left;
   self->viewport.bottom = bottom;
   self->viewport.width = width;
   self->viewport.height = height;
-  glViewport(left * clientWidth, bottom * clientHeight, width * clientWidth, height * clientHeight);
+  glViewport(left * targetWidth, bottom * targetHeight, width * targetWidth, height * targetHeight);
   glEnable(GL_SCISSOR_TEST);
-  glScissor(self->viewport.left * clientWidth, self->viewport.bottom * clientHeight, self->viewport.width * clientWidth, self->viewport.height * clientHeight);
+  glScissor(self->viewport.left * targetWidth, self->viewport.bottom * targetHeight, self->viewport.width * targetWidth, self->viewport.height * targetHeight);
 }
 
 static void
@@ -420,13 +633,13 @@ Visuals_Gl_Context_clearImpl
   if (depthBuffer) {
     mask |= GL_DEPTH_BUFFER_BIT;
   }
-  Shizu_Integer32 clientWidth, clientHeight;
-  Visuals_Gl_Service_getClientSize(state, &clientWidth, &clientHeight);
+  Shizu_Integer32 targetWidth, targetHeight;
+  getTargetSize(state, &targetWidth, &targetHeight);
   
-  glViewport(self->viewport.left * clientWidth, self->viewport.bottom * clientHeight, self->viewport.width * clientWidth, self->viewport.height * clientHeight);
+  glViewport(self->viewport.left * targetWidth, self->viewport.bottom * targetHeight, self->viewport.width * targetWidth, self->viewport.height * targetHeight);
 
   glEnable(GL_SCISSOR_TEST);
-  glScissor(self->viewport.left * clientWidth, self->viewport.bottom * clientHeight, self->viewport.width * clientWidth, self->viewport.height * clientHeight);
+  glScissor(self->viewport.left * targetWidth, self->viewport.bottom * targetHeight, self->viewport.width * targetWidth, self->viewport.height * targetHeight);
   
   glClear(mask);
 }
@@ -440,16 +653,135 @@ Visuals_Gl_Context_setRenderBufferImpl
   )
 {
   if (!renderBuffer) {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    g_target.renderBuffer = NULL;
+    g_target.frameBufferId = Visuals_Gl_Service_getDefaultFrameBufferId(state);
+    g_target.width = 0;
+    g_target.height = 0;
   } else {
     if (!renderBuffer->frameBufferId) {
       Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
       Shizu_State2_jump(state);
     }
-    glBindFramebuffer(GL_FRAMEBUFFER, renderBuffer->frameBufferId);
+    g_target.renderBuffer = renderBuffer;
+    g_target.frameBufferId = renderBuffer->frameBufferId;
+    g_target.width = renderBuffer->width;
+    g_target.height = renderBuffer->height;
+  }
+  glBindFramebuffer(GL_FRAMEBUFFER, g_target.frameBufferId);
+  Visuals_Gl_Service_statistics.numberOfFrameBufferBinds++;
+}
+
+static void
+Visuals_Gl_Context_blitRenderBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Context* self,
+    Visuals_Gl_RenderBuffer* renderBuffer,
+    Shizu_Float32 width,
+    Shizu_Float32 height,
+    Visuals_BlitFilter filter
+  )
+{
+  if (!renderBuffer) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  if (!(width > 0.f && width <= 1.f) || !(height > 0.f && height <= 1.f)) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  if (renderBuffer == g_target.renderBuffer) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  if (!renderBuffer->frameBufferId) {
+    Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Integer32 targetWidth, targetHeight;
+  getTargetSize(state, &targetWidth, &targetHeight);
+  GLint source[4] = {
+    0,
+    0,
+    (GLint)(width * renderBuffer->width + 0.5f),
+    (GLint)(height * renderBuffer->height + 0.5f),
+  };
+  GLint target[4] = {
+    (GLint)(self->viewport.left * targetWidth),
+    (GLint)(self->viewport.bottom * targetHeight),
+    (GLint)(self->viewport.width * targetWidth),
+    (GLint)(self->viewport.height * targetHeight),
+  };
+  if (source[2] < 1) source[2] = 1;
+  if (source[3] < 1) source[3] = 1;
+  switch (filter) {
+    case Visuals_BlitFilter_Nearest:
+    case Visuals_BlitFilter_Linear: {
+      glBindFramebuffer(GL_READ_FRAMEBUFFER, renderBuffer->frameBufferId);
+      glBindFramebuffer(GL_DRAW_FRAMEBUFFER, g_target.frameBufferId);
+      Visuals_Gl_Service_statistics.numberOfFrameBufferBinds += 2;
+      // The scissor test applies to glBlitFramebuffer.
+      glDisable(GL_SCISSOR_TEST);
+      glBlitFramebuffer(source[0], source[1], source[0] + source[2], source[1] + source[3],
+                        target[0], target[1], target[0] + target[2], target[1] + target[3],
+                        GL_COLOR_BUFFER_BIT, Visuals_BlitFilter_Nearest == filter ? GL_NEAREST : GL_LINEAR);
+      glBindFramebuffer(GL_FRAMEBUFFER, g_target.frameBufferId);
+      Visuals_Gl_Service_statistics.numberOfFrameBufferBinds++;
+    } break;
+    case Visuals_BlitFilter_Sharpen: {
+      Visuals_Gl_Sharpen_draw(state, renderBuffer->colorTextureId, renderBuffer->width, renderBuffer->height, source, target);
+    } break;
+    default: {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+      Shizu_State2_jump(state);
+    } break;
+  };
+  // Restore the viewport and the scissor rectangle of this context.
+  Visuals_Gl_Context_setViewportImpl(state, self, self->viewport.left, self->viewport.bottom, self->viewport.width, self->viewport.height);
+}
+
+static inline void
+Visuals_Gl_Context_setUniformBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Context* self,
+    Shizu_Integer32 index,
+    Visuals_Gl_UniformBuffer* uniformBuffer
+  )
+{
+  if (index < 0) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  if (!uniformBuffer) {
+    glBindBufferBase(GL_UNIFORM_BUFFER, (GLuint)index, 0);
+  } else {
+    // Bind the copy of the uniform data of the frame in progress.
+    GLuint bufferId = Visuals_Gl_UniformBuffer_getCurrentBufferId(state, uniformBuffer);
+    if (!bufferId) {
+      Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+      Shizu_State2_jump(state);
+    }
+    glBindBufferBase(GL_UNIFORM_BUFFER, (GLuint)index, bufferId);
   }
 }
 
+// Count a draw call which binds a program and a vertex array.
+static inline void
+countDraw
+  (
+    size_t numberOfVertices,
+    size_t numberOfInstances
+  )
+{
+  Visuals_FrameStatistics* s = &Visuals_Gl_Service_statistics;
+  s->numberOfDrawCalls++;
+  s->numberOfVertices += numberOfVertices;
+  s->numberOfInstances += numberOfInstances;
+  s->numberOfProgramBinds++;
+  s->numberOfVertexArrayBinds++;
+}
+
 static inline void
 Visuals_Gl_Context_renderImpl
   (
@@ -459,9 +791,127 @@ Visuals_Gl_Context_renderImpl
     Visuals_Gl_Program* program
   )
 {
+  Visuals_Gl_Program_ensureUsable(state, program);
   glUseProgram(program->programId);
   glBindVertexArray(vertexBuffer->vertexArrayId);
   glDrawArrays(GL_TRIANGLE_STRIP, 0, ((Visuals_VertexBuffer*)vertexBuffer)->numberOfVertices);
+  countDraw(((Visuals_VertexBuffer*)vertexBuffer)->numberOfVertices, 1);
+}
+
+static inline void
+Visuals_Gl_Context_renderRangesImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Context* self,
+    Visuals_Gl_VertexBuffer* vertexBuffer,
+    Shizu_Integer32 const* firsts,
+    Shizu_Integer32 const* counts,
+    size_t numberOfRanges,
+    Visuals_Gl_Program* program
+  )
+{
+  if (!numberOfRanges) {
+    return;
+  }
+  size_t numberOfVertices = ((Visuals_VertexBuffer*)vertexBuffer)->numberOfVertices;
+  for (size_t i = 0; i < numberOfRanges; ++i) {
+    if (firsts[i] < 0 || counts[i] < 0 || (size_t)firsts[i] + (size_t)counts[i] > numberOfVertices) {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+      Shizu_State2_jump(state);
+    }
+  }
+  Visuals_Gl_Program_ensureUsable(state, program);
+  glUseProgram(program->programId);
+  glBindVertexArray(vertexBuffer->vertexArrayId);
+  // Shizu_Integer32 is GLint and GLsizei.
+  glMultiDrawArrays(GL_TRIANGLE_STRIP, (GLint const*)firsts, (GLsizei const*)counts, (GLsizei)numberOfRanges);
+  size_t numberOfSubmittedVertices = 0;
+  for (size_t i = 0; i < numberOfRanges; ++i) {
+    numberOfSubmittedVertices += (size_t)counts[i];
+  }
+  // A multi-draw is counted as one draw call.
+  countDraw(numberOfSubmittedVertices, 1);
+}
+
+static inline void
+Visuals_Gl_Context_renderIndexedImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Context* self,
+    Visuals_Gl_VertexBuffer* vertexBuffer,
+    Visuals_Gl_IndexBuffer* indexBuffer,
+    Visuals_PrimitiveType primitiveType,
+    Visuals_Gl_Program* program
+  )
+{
+  GLenum mode = toPrimitiveMode(state, primitiveType);
+  Visuals_IndexBuffer* indices = (Visuals_IndexBuffer*)indexBuffer;
+  // Primitive restart is enabled for triangle strips only.
+  // For other primitive types, a primitive restart index is an ordinary index and must be in bounds.
+  Shizu_Boolean primitiveRestart = Visuals_PrimitiveType_TriangleStrip == primitiveType;
+  uint32_t minimumIndex, maximumIndex;
+  if (!Visuals_IndexBuffer_getIndexRange(indices, primitiveRestart, &minimumIndex, &maximumIndex)) {
+    return;
+  }
+  if (maximumIndex >= ((Visuals_VertexBuffer*)vertexBuffer)->numberOfVertices) {
+    fprintf(stderr, "%s:%d: maximum index %zu is out of bounds\n", __FILE__, __LINE__, (size_t)maximumIndex);
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  GLenum type = Visuals_IndexSyntactics_UInt16 == indices->flags ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+  Visuals_Gl_Program_ensureUsable(state, program);
+  glUseProgram(program->programId);
+  glBindVertexArray(vertexBuffer->vertexArrayId);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer->bufferId);
+  if (primitiveRestart) {
+    glEnable(GL_PRIMITIVE_RESTART);
+    glPrimitiveRestartIndex(Visuals_IndexBuffer_getRestartIndex(indices->flags));
+  }
+  if (0 == minimumIndex && ((Visuals_VertexBuffer*)vertexBuffer)->numberOfVertices - 1 == maximumIndex) {
+    // The indices reference all vertices, the range does not provide additional information.
+    glDrawElements(mode, indices->numberOfIndices, type, (void*)0);
+  } else {
+    glDrawRangeElements(mode, minimumIndex, maximumIndex, indices->numberOfIndices, type, (void*)0);
+  }
+  if (primitiveRestart) {
+    glDisable(GL_PRIMITIVE_RESTART);
+  }
+  glBindVertexArray(0);
+  countDraw(indices->numberOfIndices, 1);
+}
+
+static inline void
+Visuals_Gl_Context_renderInstancedImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Context* self,
+    Visuals_Gl_VertexBuffer* vertexBuffer,
+    Visuals_Gl_VertexBuffer* instanceBuffer,
+    size_t numberOfInstances,
+    Visuals_PrimitiveType primitiveType,
+    Visuals_Gl_Program* program
+  )
+{
+  GLenum mode = toPrimitiveMode(state, primitiveType);
+  if (numberOfInstances > ((Visuals_VertexBuffer*)instanceBuffer)->numberOfVertices) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  if (!numberOfInstances) {
+    return;
+  }
+  Visuals_Gl_Program_ensureUsable(state, program);
+  glUseProgram(program->programId);
+  glBindVertexArray(vertexBuffer->vertexArrayId);
+  Visuals_Gl_VertexBuffer_bindInstanceAttributes(state, instanceBuffer);
+  // The format of the instance buffer was validated when its attributes were bound.
+  Visuals_Gl_Program_setInstanceDescriptor(state, program, Visuals_VertexSemantics_Transform3x4_MaterialIndex);
+  glDrawArraysInstanced(mode, 0, ((Visuals_VertexBuffer*)vertexBuffer)->numberOfVertices, numberOfInstances);
+  // Subsequent draw calls which are not instanced must not read the instance attributes.
+  Visuals_Gl_Program_setInstanceDescriptor(state, program, 0);
+  Visuals_Gl_VertexBuffer_unbindInstanceAttributes(state);
+  glBindVertexArray(0);
+  countDraw(((Visuals_VertexBuffer*)vertexBuffer)->numberOfVertices * numberOfInstances, numberOfInstances);
 }
 
 static void
@@ -490,6 +940,7 @@ Visuals_Gl_Context_constructImpl
   SELF->viewport.width = 1.f;
   SELF->viewport.height = 1.f;
   ((Shizu_Object*)SELF)->type = TYPE;
+  Visuals_Gl_Service_statistics.numberOfLiveContexts++;
 }
 
 Visuals_Gl_Context*
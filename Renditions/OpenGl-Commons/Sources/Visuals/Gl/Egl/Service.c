@@ -0,0 +1,456 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Visuals/Gl/Egl/Service.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+// glGenFramebuffers, glBindFramebuffer, ...
+#include "Visuals/Gl/ServiceGl.h"
+
+static EGLDisplay g_display = EGL_NO_DISPLAY;
+static EGLConfig g_config = NULL;
+static EGLContext g_context = EGL_NO_CONTEXT;
+
+static GLuint g_frameBufferId = 0;
+static GLuint g_colorTextureId = 0;
+static GLuint g_depthStencilTextureId = 0;
+static Shizu_Integer32 g_frameBufferWidth = 0;
+static Shizu_Integer32 g_frameBufferHeight = 0;
+
+static bool
+isExtensionSupported
+  (
+    const char *extensions,
+    const char *extension
+  );
+
+static EGLDisplay
+getDisplay
+  (
+    Shizu_State2* state
+  );
+
+static void
+startupDisplay
+  (
+    Shizu_State2* state
+  );
+
+static void
+shutdownDisplay
+  (
+    Shizu_State2* state
+  );
+
+static void
+startupContext
+  (
+    Shizu_State2* state
+  );
+
+static void
+shutdownContext
+  (
+    Shizu_State2* state
+  );
+
+static bool
+isExtensionSupported
+  (
+    const char *extensions,
+    const char *extension
+  )
+{
+  const char *start;
+  const char *where, *terminator;
+
+  if (!extensions) {
+    return false;
+  }
+  /* Extension names should not have spaces. */
+  where = strchr(extension, ' ');
+  if (where || *extension == '\0')
+    return false;
+
+  for (start = extensions;;) {
+    where = strstr(start, extension);
+
+    if (!where)
+      break;
+
+    terminator = where + strlen(extension);
+
+    if ( where == start || *(where - 1) == ' ' )
+      if ( *terminator == ' ' || *terminator == '\0' )
+        return true;
+
+    start = terminator;
+  }
+
+  return false;
+}
+
+static EGLDisplay
+getDisplay
+  (
+    Shizu_State2* state
+  )
+{
+  // The client extensions are queried using EGL_NO_DISPLAY.
+  // If client extensions are not supported, then the null pointer is returned.
+  char const* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+  PFNEGLGETPLATFORMDISPLAYEXTPROC eglGetPlatformDisplayEXT = NULL;
+  if (isExtensionSupported(clientExtensions, "EGL_EXT_platform_base")) {
+    eglGetPlatformDisplayEXT = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+  }
+  if (eglGetPlatformDisplayEXT) {
+    // (1) The surfaceless platform of Mesa. Works with llvmpipe and does not require a GPU.
+    if (isExtensionSupported(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+      EGLDisplay display = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+      if (EGL_NO_DISPLAY != display) {
+        return display;
+      }
+    }
+    // (2) The first EGL device.
+    if (isExtensionSupported(clientExtensions, "EGL_EXT_platform_device")) {
+      PFNEGLQUERYDEVICESEXTPROC eglQueryDevicesEXT = (PFNEGLQUERYDEVICESEXTPROC)eglGetProcAddress("eglQueryDevicesEXT");
+      EGLDeviceEXT device;
+      EGLint numberOfDevices = 0;
+      if (eglQueryDevicesEXT && eglQueryDevicesEXT(1, &device, &numberOfDevices) && numberOfDevices > 0) {
+        EGLDisplay display = eglGetPlatformDisplayEXT(EGL_PLATFORM_DEVICE_EXT, device, NULL);
+        if (EGL_NO_DISPLAY != display) {
+          return display;
+        }
+      }
+    }
+  }
+  // (3) The default display.
+  EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+  if (EGL_NO_DISPLAY == display) {
+    fprintf(stderr, "%s:%d: unable to get EGL display\n", __FILE__, __LINE__);
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+  return display;
+}
+
+static void
+startupDisplay
+  (
+    Shizu_State2* state
+  )
+{
+  g_display = getDisplay(state);
+  EGLint major, minor;
+  if (!eglInitialize(g_display, &major, &minor)) {
+    fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, "eglInitialize");
+    g_display = EGL_NO_DISPLAY;
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+  if (!isExtensionSupported(eglQueryString(g_display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context")) {
+    fprintf(stderr, "%s:%d: unable to get %s extension\n", __FILE__, __LINE__, "EGL_KHR_surfaceless_context");
+    eglTerminate(g_display);
+    g_display = EGL_NO_DISPLAY;
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+  if (!eglBindAPI(EGL_OPENGL_API)) {
+    fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, "eglBindAPI");
+    eglTerminate(g_display);
+    g_display = EGL_NO_DISPLAY;
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+}
+
+static void
+shutdownDisplay
+  (
+    Shizu_State2* state
+  )
+{
+  eglTerminate(g_display);
+  g_display = EGL_NO_DISPLAY;
+}
+
+static void
+startupContext
+  (
+    Shizu_State2* state
+  )
+{
+  // No surface is created, hence the surface type is not relevant.
+  // Rendering is into the offscreen frame buffer.
+  EGLint const configAttribs[] = {
+    EGL_SURFACE_TYPE, EGL_DONT_CARE,
+    EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+    EGL_RED_SIZE, 8,
+    EGL_GREEN_SIZE, 8,
+    EGL_BLUE_SIZE, 8,
+    EGL_NONE
+  };
+  EGLint numberOfConfigs = 0;
+  if (!eglChooseConfig(g_display, configAttribs, &g_config, 1, &numberOfConfigs) || numberOfConfigs < 1) {
+    fprintf(stderr, "%s:%d: unable to choose EGL config\n", __FILE__, __LINE__);
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+
+  // OpenGL 3.3 core is the minimum version (see ServiceGl_Functions.i).
+  EGLint const contextAttribs[] = {
+    EGL_CONTEXT_MAJOR_VERSION, 3,
+    EGL_CONTEXT_MINOR_VERSION, 3,
+    EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+    EGL_NONE
+  };
+  g_context = eglCreateContext(g_display, g_config, EGL_NO_CONTEXT, contextAttribs);
+  if (EGL_NO_CONTEXT == g_context) {
+    fprintf(stderr, "%s:%d: unable to create context\n", __FILE__, __LINE__);
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+
+  if (!eglMakeCurrent(g_display, EGL_NO_SURFACE, EGL_NO_SURFACE, g_context)) {
+    fprintf(stderr, "%s:%d: unable to make context current\n", __FILE__, __LINE__);
+    eglDestroyContext(g_display, g_context);
+    g_context = EGL_NO_CONTEXT;
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+}
+
+static void
+shutdownContext
+  (
+    Shizu_State2* state
+  )
+{
+  eglMakeCurrent(g_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+  eglDestroyContext(g_display, g_context);
+  g_context = EGL_NO_CONTEXT;
+}
+
+void
+Visuals_Gl_Egl_Service_startup
+  (
+    Shizu_State2* state
+  )
+{
+  startupDisplay(state);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    startupContext(state);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    shutdownDisplay(state);
+    Shizu_State2_jump(state);
+  }
+}
+
+void
+Visuals_Gl_Egl_Service_shutdown
+  (
+    Shizu_State2* state
+  )
+{
+  shutdownContext(state);
+  shutdownDisplay(state);
+}
+
+void
+Visuals_Gl_Egl_Service_startupFrameBuffer
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  )
+{
+  g_frameBufferWidth = width;
+  g_frameBufferHeight = height;
+  // Create the color attachment texture.
+  glGenTextures(1, &g_colorTextureId);
+  glBindTexture(GL_TEXTURE_2D, g_colorTextureId);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, g_frameBufferWidth, g_frameBufferHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  // Create the depth and stencil attachment texture.
+  glGenTextures(1, &g_depthStencilTextureId);
+  glBindTexture(GL_TEXTURE_2D, g_depthStencilTextureId);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, g_frameBufferWidth, g_frameBufferHeight, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, NULL);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  // Create the framebuffer.
+  glGenFramebuffers(1, &g_frameBufferId);
+  glBindFramebuffer(GL_FRAMEBUFFER, g_frameBufferId);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, g_colorTextureId, 0);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, g_depthStencilTextureId, 0);
+  if (glGetError() || GL_FRAMEBUFFER_COMPLETE != glCheckFramebufferStatus(GL_FRAMEBUFFER)) {
+    fprintf(stderr, "%s:%d: unable to create offscreen frame buffer\n", __FILE__, __LINE__);
+    Visuals_Gl_Egl_Service_shutdownFrameBuffer(state);
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+  // The offscreen frame buffer remains bound as it replaces the default frame buffer.
+  glViewport(0, 0, g_frameBufferWidth, g_frameBufferHeight);
+}
+
+void
+Visuals_Gl_Egl_Service_resizeFrameBuffer
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  )
+{
+  if (width == g_frameBufferWidth && height == g_frameBufferHeight) {
+    return;
+  }
+  // Re-allocating the storage of the attachments keeps the frame buffer complete.
+  glBindTexture(GL_TEXTURE_2D, g_colorTextureId);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+  glBindTexture(GL_TEXTURE_2D, g_depthStencilTextureId);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, width, height, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, NULL);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  if (glGetError()) {
+    fprintf(stderr, "%s:%d: unable to resize offscreen frame buffer\n", __FILE__, __LINE__);
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+  g_frameBufferWidth = width;
+  g_frameBufferHeight = height;
+  glViewport(0, 0, g_frameBufferWidth, g_frameBufferHeight);
+}
+
+void
+Visuals_Gl_Egl_Service_shutdownFrameBuffer
+  (
+    Shizu_State2* state
+  )
+{
+  if (g_frameBufferId) {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &g_frameBufferId);
+    g_frameBufferId = 0;
+  }
+  if (g_depthStencilTextureId) {
+    glDeleteTextures(1, &g_depthStencilTextureId);
+    g_depthStencilTextureId = 0;
+  }
+  if (g_colorTextureId) {
+    glDeleteTextures(1, &g_colorTextureId);
+    g_colorTextureId = 0;
+  }
+  g_frameBufferWidth = 0;
+  g_frameBufferHeight = 0;
+}
+
+GLuint
+Visuals_Gl_Egl_Service_getFrameBufferId
+  (
+    Shizu_State2* state
+  )
+{ return g_frameBufferId; }
+
+void
+Visuals_Gl_Egl_Service_setTitle
+  (
+    Shizu_State2* state,
+    Shizu_String* title
+  )
+{/*Intentionally empty.*/}
+
+void
+Visuals_Gl_Egl_Service_update
+  (
+    Shizu_State2* state
+  )
+{/*Intentionally empty.*/}
+
+Shizu_Boolean
+Visuals_Gl_Egl_Service_quitRequested
+  (
+    Shizu_State2* state
+  )
+{ return Shizu_Boolean_False; }
+
+void
+Visuals_Gl_Egl_Service_getClientSize
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 *width,
+    Shizu_Integer32 *height
+  )
+{
+  *width = g_frameBufferWidth;
+  *height = g_frameBufferHeight;
+}
+
+void*
+Visuals_Gl_Egl_Service_link
+  (
+    Shizu_State2* state,
+    char const* functionName,
+    char const* extensionName
+  )
+{
+  if (extensionName) {
+    if (!isExtensionSupported(eglQueryString(g_display, EGL_EXTENSIONS), extensionName)) {
+      if (!isExtensionSupported((char const*)glGetString(GL_EXTENSIONS), extensionName)) {
+        Shizu_State2_setStatus(state, 1);
+        Shizu_State2_jump(state);
+      }
+    }
+  }
+  void* p = (void*)eglGetProcAddress(functionName);
+  if (!p) {
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+  return p;
+}
+
+void
+Visuals_Gl_Egl_Service_beginFrame
+  (
+    Shizu_State2* state
+  )
+{/*Intentionally empty.*/}
+
+void
+Visuals_Gl_Egl_Service_endFrame
+  (
+    Shizu_State2* state
+  )
+{
+  // There is no surface to swap.
+  // Wait for the frame to complete such that frame times reflect the rendering work.
+  glFinish();
+}
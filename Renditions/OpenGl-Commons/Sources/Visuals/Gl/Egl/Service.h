@@ -0,0 +1,171 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(VISUALS_GL_EGL_SERVICE_H_INCLUDED)
+#define VISUALS_GL_EGL_SERVICE_H_INCLUDED
+
+#include "Zeitgeist.h"
+
+#include <GL/gl.h>
+
+/// @since 0.1
+/// @brief Startup the headless EGL service.
+/// @param state A pointer to the Shizu_State2 value.
+/// @remarks
+/// The service neither requires a display server nor a window.
+/// It acquires an EGL display from the first of the following sources which is available:
+/// - the surfaceless platform (EGL_MESA_platform_surfaceless),
+/// - the first EGL device (EGL_EXT_platform_device),
+/// - the default display.
+/// The context is made current without a surface (EGL_KHR_surfaceless_context).
+void
+Visuals_Gl_Egl_Service_startup
+  (
+    Shizu_State2* state
+  );
+
+/// @since 0.1
+/// @brief Shutdown the headless EGL service.
+/// @param state A pointer to the Shizu_State2 value.
+void
+Visuals_Gl_Egl_Service_shutdown
+  (
+    Shizu_State2* state
+  );
+
+/// @since 0.1
+/// @brief Create the offscreen frame buffer.
+/// @param state A pointer to the Shizu_State2 value.
+/// @param width, height The size, in pixels, of the offscreen frame buffer. Must be positive.
+/// @remarks Must be invoked after the OpenGL functions were linked.
+void
+Visuals_Gl_Egl_Service_startupFrameBuffer
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  );
+
+/// @since 0.1
+/// @brief Resize the offscreen frame buffer.
+/// @param state A pointer to the Shizu_State2 value.
+/// @param width, height The size, in pixels, of the offscreen frame buffer. Must be positive.
+/// @remarks
+/// The attachments are re-allocated if the size changed, their contents are undefined afterwards.
+/// The viewport is set to the size of the offscreen frame buffer.
+void
+Visuals_Gl_Egl_Service_resizeFrameBuffer
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  );
+
+/// @since 0.1
+/// @brief Destroy the offscreen frame buffer.
+/// @param state A pointer to the Shizu_State2 value.
+void
+Visuals_Gl_Egl_Service_shutdownFrameBuffer
+  (
+    Shizu_State2* state
+  );
+
+/// @since 0.1
+/// @brief Get the ID of the offscreen frame buffer.
+/// @param state A pointer to the Shizu_State2 value.
+/// @return The ID of the offscreen frame buffer.
+/// This frame buffer replaces the default frame buffer of the window system.
+GLuint
+Visuals_Gl_Egl_Service_getFrameBufferId
+  (
+    Shizu_State2* state
+  );
+
+/// @since 0.1
+/// @brief Set the window title.
+/// @param state A pointer to the Shizu_State2 value.
+/// @param title A pointer to the title.
+/// @remarks This function does nothing as there is no window.
+void
+Visuals_Gl_Egl_Service_setTitle
+  (
+    Shizu_State2* state,
+    Shizu_String* title
+  );
+
+void
+Visuals_Gl_Egl_Service_update
+  (
+    Shizu_State2* state
+  );
+
+Shizu_Boolean
+Visuals_Gl_Egl_Service_quitRequested
+  (
+    Shizu_State2* state
+  );
+
+/**
+ * @since 0.1
+ * @brief Get the size, in pixels, of the offscreen frame buffer.
+ * @param state A pointer to the Shizu_State2 value.
+ * @param width A pointer to a Shizu_Integer32 variable.
+ * If this function succeeds, this variable is assigned the frame buffer width.
+ * @param height A pointer to a Shizu_Integer32 variable.
+ * If this function succeeds, this variable is assigned the frame buffer height.
+ */
+void
+Visuals_Gl_Egl_Service_getClientSize
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 *width,
+    Shizu_Integer32 *height
+  );
+
+/**
+ * @since 0.1
+ * @brief Try to link the an OpenGL function.
+ * @param state A pointer to the Shizu_State2 value.
+ * @param functionName A pointer to the function name.
+ * @param extensionName A pointer to the extension name or the null pointer.
+ * @return A poiner to the function on success.
+ */
+void*
+Visuals_Gl_Egl_Service_link
+  (
+    Shizu_State2* state,
+    char const* functionName,
+    char const* extensionName
+  );
+
+void
+Visuals_Gl_Egl_Service_beginFrame
+  (
+    Shizu_State2* state
+  );
+
+void
+Visuals_Gl_Egl_Service_endFrame
+  (
+    Shizu_State2* state
+  );
+
+#endif // VISUALS_GL_EGL_SERVICE_H_INCLUDED
@@ -0,0 +1,150 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "Visuals/Gl/FramesInFlight.h"
+
+// fprintf, stderr
+#include <stdio.h>
+
+// timespec_get
+#include <time.h>
+
+static struct {
+  bool initialized;
+  /// @brief The number of frames in flight.
+  size_t numberOfFrames;
+  /// @brief The fences signaled when the GPU has finished the frames which used the resource sets.
+  /// An element is @a 0 if the resource set is not in use by the GPU.
+  GLsync fences[Visuals_Gl_FramesInFlight_MaximalNumberOfFrames];
+  /// @brief The index of the resource set of the frame in progress.
+  size_t current;
+} g_frames = {
+  .initialized = false,
+  .numberOfFrames = 1,
+  .current = 0,
+};
+
+void
+Visuals_Gl_FramesInFlight_startup
+  (
+    Shizu_State2* state,
+    size_t numberOfFrames
+  )
+{
+  if (numberOfFrames < 1 || numberOfFrames > Visuals_Gl_FramesInFlight_MaximalNumberOfFrames) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  for (size_t i = 0; i < Visuals_Gl_FramesInFlight_MaximalNumberOfFrames; ++i) {
+    g_frames.fences[i] = 0;
+  }
+  g_frames.numberOfFrames = numberOfFrames;
+  g_frames.current = 0;
+  g_frames.initialized = true;
+}
+
+void
+Visuals_Gl_FramesInFlight_shutdown
+  (
+    Shizu_State2* state
+  )
+{
+  if (!g_frames.initialized) {
+    return;
+  }
+  for (size_t i = 0; i < Visuals_Gl_FramesInFlight_MaximalNumberOfFrames; ++i) {
+    if (g_frames.fences[i]) {
+      glDeleteSync(g_frames.fences[i]);
+      g_frames.fences[i] = 0;
+    }
+  }
+  g_frames.numberOfFrames = 1;
+  g_frames.current = 0;
+  g_frames.initialized = false;
+}
+
+Shizu_Float32
+Visuals_Gl_FramesInFlight_beginFrame
+  (
+    Shizu_State2* state
+  )
+{
+  if (!g_frames.initialized) {
+    return 0.f;
+  }
+  GLsync fence = g_frames.fences[g_frames.current];
+  if (!fence) {
+    return 0.f;
+  }
+  struct timespec begin, end;
+  timespec_get(&begin, TIME_UTC);
+  GLenum result;
+  do {
+    result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_C(1000000));
+  } while (GL_TIMEOUT_EXPIRED == result);
+  timespec_get(&end, TIME_UTC);
+  glDeleteSync(fence);
+  g_frames.fences[g_frames.current] = 0;
+  if (GL_WAIT_FAILED == result) {
+    fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, "glClientWaitSync");
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+  return (Shizu_Float32)((double)(end.tv_sec - begin.tv_sec) * 1000.0 + (double)(end.tv_nsec - begin.tv_nsec) / 1000000.0);
+}
+
+void
+Visuals_Gl_FramesInFlight_endFrame
+  (
+    Shizu_State2* state
+  )
+{
+  if (!g_frames.initialized) {
+    return;
+  }
+  // The fences are signaled in the order of their creation.
+  // Hence the new fence also guards the frames guarded by an old fence of the resource set.
+  if (g_frames.fences[g_frames.current]) {
+    glDeleteSync(g_frames.fences[g_frames.current]);
+  }
+  g_frames.fences[g_frames.current] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  if (!g_frames.fences[g_frames.current]) {
+    // Without a fence, wait until the GPU is idle such that the resource set can be reused.
+    fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, "glFenceSync");
+    glFinish();
+  }
+  g_frames.current = (g_frames.current + 1) % g_frames.numberOfFrames;
+}
+
+size_t
+Visuals_Gl_FramesInFlight_getNumberOfFrames
+  (
+    Shizu_State2* state
+  )
+{ return g_frames.numberOfFrames; }
+
+size_t
+Visuals_Gl_FramesInFlight_getFrameIndex
+  (
+    Shizu_State2* state
+  )
+{ return g_frames.current; }
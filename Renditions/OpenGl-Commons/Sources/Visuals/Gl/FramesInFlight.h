@@ -0,0 +1,100 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(VISUALS_GL_FRAMESINFLIGHT_H_INCLUDED)
+#define VISUALS_GL_FRAMESINFLIGHT_H_INCLUDED
+
+#include "Visuals/Gl/ServiceGl.h"
+
+/// @brief The maximal number of frames in flight.
+#define Visuals_Gl_FramesInFlight_MaximalNumberOfFrames (4)
+
+/// @brief The default number of frames in flight.
+#define Visuals_Gl_FramesInFlight_DefaultNumberOfFrames (2)
+
+/// @brief Start guarding the resource sets of the frames in flight by fences.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param numberOfFrames The number of frames in flight.
+/// Must be within [1, Visuals_Gl_FramesInFlight_MaximalNumberOfFrames].
+/// @remarks
+/// The CPU records at most @a numberOfFrames frames the GPU has not finished yet.
+/// Each frame in flight is assigned a resource set, identified by Visuals_Gl_FramesInFlight_getFrameIndex.
+/// A resource set is reused after the GPU has finished the frame which used it last.
+/// Per-frame resources e.g., the copies of uniform buffers, rotate through these sets.
+/// @remarks
+/// If this function was not invoked, there is one frame in flight and the resource sets are not guarded.
+/// @error Shizu_Status_ArgumentValueInvalid @a numberOfFrames is not within the bounds.
+void
+Visuals_Gl_FramesInFlight_startup
+  (
+    Shizu_State2* state,
+    size_t numberOfFrames
+  );
+
+/// @brief Stop guarding the resource sets of the frames in flight.
+/// The fences of the frames in flight are deleted without waiting for them.
+/// @param state A pointer to a Shizu_State2 value.
+void
+Visuals_Gl_FramesInFlight_shutdown
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Wait until the GPU has finished the frame which used the resource set of the frame to begin.
+/// @param state A pointer to a Shizu_State2 value.
+/// @return The time, in milliseconds, waited.
+/// @error Shizu_Status_EnvironmentFailed waiting for the fence failed.
+Shizu_Float32
+Visuals_Gl_FramesInFlight_beginFrame
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Guard the resource set of the frame in progress by a fence and advance to the resource set of the next frame.
+/// @param state A pointer to a Shizu_State2 value.
+/// @remarks Must be invoked after all commands of the frame were issued.
+void
+Visuals_Gl_FramesInFlight_endFrame
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Get the number of frames in flight.
+/// @param state A pointer to a Shizu_State2 value.
+/// @return The number of frames in flight. At least @a 1.
+size_t
+Visuals_Gl_FramesInFlight_getNumberOfFrames
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Get the index of the resource set of the frame in progress.
+/// @param state A pointer to a Shizu_State2 value.
+/// @return The index. Within [0, Visuals_Gl_FramesInFlight_getNumberOfFrames).
+/// @remarks The resources of the set can be overwritten without waiting for the GPU.
+size_t
+Visuals_Gl_FramesInFlight_getFrameIndex
+  (
+    Shizu_State2* state
+  );
+
+#endif // VISUALS_GL_FRAMESINFLIGHT_H_INCLUDED
@@ -40,6 +40,8 @@
 #include "KeyboardKeyMessage.h"
 
 typedef GLXContext (*glXCreateContextAttribsARBProc)(Display*, GLXFBConfig, GLXContext, Bool, const int*);
+typedef void (*glXSwapIntervalEXTProc)(Display*, GLXDrawable, int);
+typedef int (*glXSwapIntervalMESAProc)(unsigned int);
 
 static int (*g_oldErrorHandler)(Display*, XErrorEvent*) = NULL;
 static bool g_error = false;
@@ -210,9 +212,11 @@ startupContext
     Shizu_State2_jump(state);
   }
   
+  // OpenGL 3.3 core is the minimum version (see ServiceGl_Functions.i).
   int contextAttribs[] = {
     GLX_CONTEXT_MAJOR_VERSION_ARB, 3,
-    GLX_CONTEXT_MINOR_VERSION_ARB, 0,
+    GLX_CONTEXT_MINOR_VERSION_ARB, 3,
+    GLX_CONTEXT_PROFILE_MASK_ARB, GLX_CONTEXT_CORE_PROFILE_BIT_ARB,
     //GLX_CONTEXT_FLAGS_ARB, GLX_CONTEXT_FORWARD_COMPATIBLE_BIT_ARB,
     None
   };
@@ -634,6 +638,45 @@ Visuals_Gl_Glx_Service_link
   return p;
 }
 
+Shizu_Boolean
+Visuals_Gl_Glx_Service_setSwapInterval
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 interval
+  )
+{
+  char const* extensions = glXQueryExtensionsString(g_display, DefaultScreen(g_display));
+  if (!extensions) {
+    return Shizu_Boolean_False;
+  }
+  // Without GLX_EXT_swap_control_tear, late swaps are synchronized.
+  if (interval < 0 && !isExtensionSupported(extensions, "GLX_EXT_swap_control_tear")) {
+    interval = -interval;
+  }
+  if (isExtensionSupported(extensions, "GLX_EXT_swap_control")) {
+    glXSwapIntervalEXTProc glXSwapIntervalEXT = (glXSwapIntervalEXTProc)glXGetProcAddressARB((GLubyte const*)"glXSwapIntervalEXT");
+    if (glXSwapIntervalEXT) {
+      // glXSwapIntervalEXT reports errors by X errors.
+      g_error = false;
+      g_oldErrorHandler = XSetErrorHandler(&errorHandler);
+      glXSwapIntervalEXT(g_display, g_window, interval);
+      XSync(g_display, False);
+      XSetErrorHandler(g_oldErrorHandler);
+      if (!g_error) {
+        return Shizu_Boolean_True;
+      }
+    }
+  }
+  // GLX_MESA_swap_control does not support late swap tearing.
+  if (isExtensionSupported(extensions, "GLX_MESA_swap_control")) {
+    glXSwapIntervalMESAProc glXSwapIntervalMESA = (glXSwapIntervalMESAProc)glXGetProcAddressARB((GLubyte const*)"glXSwapIntervalMESA");
+    if (glXSwapIntervalMESA && !glXSwapIntervalMESA((unsigned int)(interval < 0 ? -interval : interval))) {
+      return Shizu_Boolean_True;
+    }
+  }
+  return Shizu_Boolean_False;
+}
+
 void
 Visuals_Gl_Glx_Service_beginFrame
   (
@@ -98,6 +98,22 @@ Visuals_Gl_Glx_Service_link
     char const* extensionName
   );
 
+/**
+ * @brief Set the number of vertical blanks to wait for before a swap of the buffers.
+ * @param state A pointer to the Shizu_State2 value.
+ * @param interval The number of vertical blanks.
+ * @a 0 does not wait.
+ * A negative value waits for -@a interval vertical blanks unless the swap is late which swaps immediately (adaptive synchronization).
+ * @return @a true if the swap interval was set, @a false if the GLX_EXT_swap_control and GLX_MESA_swap_control extensions are not available.
+ * @remarks If GLX_EXT_swap_control_tear is not available, a negative value waits for -@a interval vertical blanks.
+ */
+Shizu_Boolean
+Visuals_Gl_Glx_Service_setSwapInterval
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 interval
+  );
+
 void
 Visuals_Gl_Glx_Service_beginFrame
   (
@@ -0,0 +1,284 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "Visuals/Gl/GpuTimings.h"
+
+// fprintf, stdout
+#include <stdio.h>
+
+/// @brief The number of frames of which the queries are in flight.
+/// The timings of a frame are available after at most this number of frames.
+/// If the queries of a frame have not completed when its slot is reused, the timings of that frame are discarded.
+#define NumberOfFrames (3)
+
+/// @brief The maximal number of timing scopes per frame.
+/// Further scopes are not timed.
+#define MaximalNumberOfScopes (64)
+
+/// @brief The maximal nesting depth of timing scopes.
+/// Deeper scopes are not timed.
+#define MaximalDepth (16)
+
+typedef struct Scope {
+  char const* name;
+  Shizu_Integer32 depth;
+} Scope;
+
+typedef struct Frame {
+  /// @brief @a true if the queries of this frame were issued and their results were not collected yet.
+  bool pending;
+  /// @brief The number of the frame.
+  Shizu_Integer64 number;
+  /// @brief The GL_TIME_ELAPSED query of the whole frame.
+  GLuint elapsedQueryId;
+  /// @brief The pairs of GL_TIMESTAMP queries of the scopes.
+  GLuint timestampQueryIds[2 * MaximalNumberOfScopes];
+  Scope scopes[MaximalNumberOfScopes];
+  size_t numberOfScopes;
+} Frame;
+
+static struct {
+  bool initialized;
+  bool trace;
+  /// @brief @a true between Visuals_Gl_GpuTimings_beginFrame and Visuals_Gl_GpuTimings_endFrame.
+  bool inFrame;
+  Frame frames[NumberOfFrames];
+  /// @brief The index of the frame timed currently.
+  size_t current;
+  /// @brief The number of the next frame.
+  Shizu_Integer64 nextFrameNumber;
+  /// @brief The indices of the open scopes.
+  /// An element is MaximalNumberOfScopes if the scope is not timed.
+  size_t openScopes[MaximalDepth];
+  /// @brief The number of open scopes.
+  Shizu_Integer32 depth;
+  /// @brief The timings of the most recent frame of which the queries have completed.
+  Visuals_GpuTiming timings[1 + MaximalNumberOfScopes];
+  size_t numberOfTimings;
+} g_timings = {
+  .initialized = false,
+  .trace = false,
+  .inFrame = false,
+  .current = 0,
+  .nextFrameNumber = 0,
+  .depth = 0,
+  .numberOfTimings = 0,
+};
+
+static void
+collect
+  (
+    Frame* frame
+  )
+{
+  GLuint64 elapsed = 0;
+  glGetQueryObjectui64v(frame->elapsedQueryId, GL_QUERY_RESULT, &elapsed);
+  g_timings.timings[0].name = "frame";
+  g_timings.timings[0].depth = 0;
+  g_timings.timings[0].milliseconds = (Shizu_Float32)((double)elapsed / 1000000.0);
+  for (size_t i = 0; i < frame->numberOfScopes; ++i) {
+    GLuint64 begin = 0, end = 0;
+    glGetQueryObjectui64v(frame->timestampQueryIds[2 * i + 0], GL_QUERY_RESULT, &begin);
+    glGetQueryObjectui64v(frame->timestampQueryIds[2 * i + 1], GL_QUERY_RESULT, &end);
+    g_timings.timings[1 + i].name = frame->scopes[i].name;
+    g_timings.timings[1 + i].depth = frame->scopes[i].depth;
+    g_timings.timings[1 + i].milliseconds = end > begin ? (Shizu_Float32)((double)(end - begin) / 1000000.0) : 0.f;
+  }
+  g_timings.numberOfTimings = 1 + frame->numberOfScopes;
+  frame->pending = false;
+  if (g_timings.trace) {
+    fprintf(stdout, "[gpu] frame %lld:", (long long)frame->number);
+    for (size_t i = 0; i < g_timings.numberOfTimings; ++i) {
+      fprintf(stdout, " %*s%s %.3f ms", (int)(2 * g_timings.timings[i].depth), "", g_timings.timings[i].name, (double)g_timings.timings[i].milliseconds);
+    }
+    fprintf(stdout, "\n");
+  }
+}
+
+void
+Visuals_Gl_GpuTimings_startup
+  (
+    Shizu_State2* state,
+    Shizu_Boolean trace
+  )
+{
+  for (size_t i = 0; i < NumberOfFrames; ++i) {
+    Frame* frame = &g_timings.frames[i];
+    glGenQueries(1, &frame->elapsedQueryId);
+    glGenQueries(2 * MaximalNumberOfScopes, frame->timestampQueryIds);
+    frame->pending = false;
+    frame->numberOfScopes = 0;
+  }
+  if (glGetError()) {
+    for (size_t i = 0; i < NumberOfFrames; ++i) {
+      Frame* frame = &g_timings.frames[i];
+      glDeleteQueries(1, &frame->elapsedQueryId);
+      glDeleteQueries(2 * MaximalNumberOfScopes, frame->timestampQueryIds);
+    }
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+  g_timings.trace = trace;
+  g_timings.inFrame = false;
+  g_timings.current = 0;
+  g_timings.nextFrameNumber = 0;
+  g_timings.depth = 0;
+  g_timings.numberOfTimings = 0;
+  g_timings.initialized = true;
+}
+
+void
+Visuals_Gl_GpuTimings_shutdown
+  (
+    Shizu_State2* state
+  )
+{
+  if (!g_timings.initialized) {
+    return;
+  }
+  if (g_timings.inFrame) {
+    glEndQuery(GL_TIME_ELAPSED);
+    g_timings.inFrame = false;
+  }
+  for (size_t i = 0; i < NumberOfFrames; ++i) {
+    Frame* frame = &g_timings.frames[i];
+    glDeleteQueries(1, &frame->elapsedQueryId);
+    glDeleteQueries(2 * MaximalNumberOfScopes, frame->timestampQueryIds);
+    frame->pending = false;
+  }
+  g_timings.initialized = false;
+}
+
+void
+Visuals_Gl_GpuTimings_beginFrame
+  (
+    Shizu_State2* state
+  )
+{
+  if (!g_timings.initialized || g_timings.inFrame) {
+    return;
+  }
+  // Collect the timings of the frames in the order of their numbers.
+  // Stop at the first frame of which the queries have not completed: Querying its results would stall.
+  for (size_t i = 0; i < NumberOfFrames; ++i) {
+    Frame* frame = &g_timings.frames[(g_timings.current + i) % NumberOfFrames];
+    if (!frame->pending) {
+      continue;
+    }
+    // The GL_TIME_ELAPSED query is the last query of a frame.
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(frame->elapsedQueryId, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+      break;
+    }
+    collect(frame);
+  }
+  Frame* frame = &g_timings.frames[g_timings.current];
+  // The queries of this frame are reused. Its timings are discarded.
+  frame->pending = false;
+  frame->number = g_timings.nextFrameNumber++;
+  frame->numberOfScopes = 0;
+  g_timings.depth = 0;
+  glBeginQuery(GL_TIME_ELAPSED, frame->elapsedQueryId);
+  g_timings.inFrame = true;
+}
+
+void
+Visuals_Gl_GpuTimings_endFrame
+  (
+    Shizu_State2* state
+  )
+{
+  if (!g_timings.inFrame) {
+    return;
+  }
+  Frame* frame = &g_timings.frames[g_timings.current];
+  // Close the scopes which were not ended.
+  while (g_timings.depth > 0) {
+    Visuals_Gl_GpuTimings_endScope(state);
+  }
+  glEndQuery(GL_TIME_ELAPSED);
+  frame->pending = true;
+  g_timings.inFrame = false;
+  g_timings.current = (g_timings.current + 1) % NumberOfFrames;
+}
+
+void
+Visuals_Gl_GpuTimings_beginScope
+  (
+    Shizu_State2* state,
+    char const* name
+  )
+{
+  if (!g_timings.inFrame) {
+    return;
+  }
+  Frame* frame = &g_timings.frames[g_timings.current];
+  size_t index = MaximalNumberOfScopes;
+  if (g_timings.depth < MaximalDepth && frame->numberOfScopes < MaximalNumberOfScopes) {
+    index = frame->numberOfScopes++;
+    frame->scopes[index].name = name;
+    frame->scopes[index].depth = g_timings.depth + 1;
+    glQueryCounter(frame->timestampQueryIds[2 * index + 0], GL_TIMESTAMP);
+  }
+  if (g_timings.depth < MaximalDepth) {
+    g_timings.openScopes[g_timings.depth] = index;
+  }
+  g_timings.depth++;
+}
+
+void
+Visuals_Gl_GpuTimings_endScope
+  (
+    Shizu_State2* state
+  )
+{
+  if (!g_timings.inFrame) {
+    return;
+  }
+  if (0 == g_timings.depth) {
+    Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+    Shizu_State2_jump(state);
+  }
+  g_timings.depth--;
+  if (g_timings.depth < MaximalDepth) {
+    size_t index = g_timings.openScopes[g_timings.depth];
+    if (index < MaximalNumberOfScopes) {
+      Frame* frame = &g_timings.frames[g_timings.current];
+      glQueryCounter(frame->timestampQueryIds[2 * index + 1], GL_TIMESTAMP);
+    }
+  }
+}
+
+size_t
+Visuals_Gl_GpuTimings_get
+  (
+    Shizu_State2* state,
+    Visuals_GpuTiming* timings,
+    size_t maximalNumberOfTimings
+  )
+{
+  for (size_t i = 0; i < g_timings.numberOfTimings && i < maximalNumberOfTimings; ++i) {
+    timings[i] = g_timings.timings[i];
+  }
+  return g_timings.numberOfTimings;
+}
@@ -0,0 +1,93 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(VISUALS_GL_GPUTIMINGS_H_INCLUDED)
+#define VISUALS_GL_GPUTIMINGS_H_INCLUDED
+
+#include "Visuals/Gl/ServiceGl.h"
+#include "Visuals/Service.h"
+
+/// @brief Create the query objects.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param trace If @a true, the timings of each frame are written to the standard output when they become available.
+void
+Visuals_Gl_GpuTimings_startup
+  (
+    Shizu_State2* state,
+    Shizu_Boolean trace
+  );
+
+/// @brief Destroy the query objects.
+/// The timings of the frames in flight are discarded.
+/// @param state A pointer to a Shizu_State2 value.
+void
+Visuals_Gl_GpuTimings_shutdown
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Collect the timings of the frames of which the queries have completed and begin timing a frame.
+/// @param state A pointer to a Shizu_State2 value.
+void
+Visuals_Gl_GpuTimings_beginFrame
+  (
+    Shizu_State2* state
+  );
+
+/// @brief End timing a frame.
+/// @param state A pointer to a Shizu_State2 value.
+void
+Visuals_Gl_GpuTimings_endFrame
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Begin a named timing scope.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param name A pointer to the name. The name must live as long as the service e.g., a string literal.
+void
+Visuals_Gl_GpuTimings_beginScope
+  (
+    Shizu_State2* state,
+    char const* name
+  );
+
+/// @brief End the innermost timing scope.
+/// @param state A pointer to a Shizu_State2 value.
+/// @error Shizu_Status_OperationInvalid there is no scope to end.
+void
+Visuals_Gl_GpuTimings_endScope
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Get the timings of the most recent frame of which the queries have completed.
+/// @see Visuals_Service_getGpuTimings
+size_t
+Visuals_Gl_GpuTimings_get
+  (
+    Shizu_State2* state,
+    Visuals_GpuTiming* timings,
+    size_t maximalNumberOfTimings
+  );
+
+#endif // VISUALS_GL_GPUTIMINGS_H_INCLUDED
@@ -0,0 +1,206 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "Visuals/Gl/IndexBuffer.h"
+
+static void
+Visuals_Gl_IndexBuffer_finalize
+  (
+    Shizu_State2* state,
+    Visuals_Gl_IndexBuffer* self
+  );
+
+static void
+Visuals_Gl_IndexBuffer_materializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_IndexBuffer* self
+  );
+
+static void
+Visuals_Gl_IndexBuffer_unmaterializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_IndexBuffer* self
+  );
+
+static void
+Visuals_Gl_IndexBuffer_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_IndexBuffer* self,
+    uint8_t flags,
+    void const* bytes,
+    size_t numberOfBytes
+  );
+
+static void
+Visuals_Gl_IndexBuffer_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_Gl_IndexBuffer_Dispatch* self
+  );
+
+static void
+Visuals_Gl_IndexBuffer_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  );
+
+static Shizu_ObjectTypeDescriptor const Visuals_Gl_IndexBuffer_Type = {
+  .postCreateType = NULL,
+  .preDestroyType = NULL,
+  .visitType = NULL,
+  .size = sizeof(Visuals_Gl_IndexBuffer),
+  .construct = &Visuals_Gl_IndexBuffer_constructImpl,
+  .finalize = (Shizu_OnFinalizeCallback*)&Visuals_Gl_IndexBuffer_finalize,
+  .visit = NULL,
+  .dispatchSize = sizeof(Visuals_Gl_IndexBuffer_Dispatch),
+  .dispatchInitialize = (Shizu_OnDispatchInitializeCallback*) & Visuals_Gl_IndexBuffer_dispatchInitialize,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Zeitgeist.Visuals.Gl.IndexBuffer", Visuals_Gl_IndexBuffer, Visuals_IndexBuffer);
+
+static void
+Visuals_Gl_IndexBuffer_finalize
+  (
+    Shizu_State2* state,
+    Visuals_Gl_IndexBuffer* self
+  )
+{
+  Visuals_Gl_Service_statistics.numberOfLiveIndexBuffers--;
+  if (self->bufferId) {
+    glDeleteBuffers(1, &self->bufferId);
+    self->bufferId = 0;
+  }
+}
+
+static void
+Visuals_Gl_IndexBuffer_materializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_IndexBuffer* self
+  )
+{
+  if (!self->bufferId) {
+    while (glGetError()) { }
+    glGenBuffers(1, &self->bufferId);
+    if (glGetError()) {
+      fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, "glGenBuffers");
+      Shizu_State2_setStatus(state, 1);
+      Shizu_State2_jump(state);
+    }
+  }
+}
+
+static void
+Visuals_Gl_IndexBuffer_unmaterializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_IndexBuffer* self
+  )
+{
+  if (self->bufferId) {
+    glDeleteBuffers(1, &self->bufferId);
+    self->bufferId = 0;
+  }
+}
+
+static void
+Visuals_Gl_IndexBuffer_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_IndexBuffer* self,
+    uint8_t flags,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{
+  Shizu_Type* parentType = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), ((Shizu_Object*)self)->type);
+  Visuals_IndexBuffer_Dispatch* parentDispatch = (Visuals_IndexBuffer_Dispatch*)Shizu_Types_getDispatch(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), parentType);
+  parentDispatch->setData(state, (Visuals_IndexBuffer*)self, flags, bytes, numberOfBytes);
+
+  Visuals_Object_materialize(state, (Visuals_Object*)self);
+
+  // Store the data in the buffer.
+  // The GL_ELEMENT_ARRAY_BUFFER binding is part of the vertex array state,
+  // hence the data is uploaded via the GL_ARRAY_BUFFER binding point.
+  // The buffer is bound to GL_ELEMENT_ARRAY_BUFFER when rendering.
+  glBindBuffer(GL_ARRAY_BUFFER, self->bufferId);
+  glBufferData(GL_ARRAY_BUFFER, numberOfBytes, bytes, GL_STATIC_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  Visuals_Gl_Service_statistics.numberOfBufferBytesUploaded += numberOfBytes;
+}
+
+static void
+Visuals_Gl_IndexBuffer_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_Gl_IndexBuffer_Dispatch* self
+  )
+{
+  ((Visuals_Object_Dispatch*)self)->materialize = (void(*)(Shizu_State2*,Visuals_Object*)) & Visuals_Gl_IndexBuffer_materializeImpl;
+  ((Visuals_Object_Dispatch*)self)->unmaterialize = (void(*)(Shizu_State2*,Visuals_Object*)) & Visuals_Gl_IndexBuffer_unmaterializeImpl;
+  ((Visuals_IndexBuffer_Dispatch*)self)->setData = (void(*)(Shizu_State2*, Visuals_IndexBuffer*, uint8_t,void const*,size_t)) & Visuals_Gl_IndexBuffer_setDataImpl;
+}
+
+static void
+Visuals_Gl_IndexBuffer_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{
+  if (1 != numberOfArgumentValues) {
+    Shizu_State2_setStatus(state, Shizu_Status_NumberOfArgumentsInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Type* TYPE = Visuals_Gl_IndexBuffer_getType(state);
+  Visuals_Gl_IndexBuffer* SELF = (Visuals_Gl_IndexBuffer*)Shizu_Value_getObject(&argumentValues[0]);
+  {
+    Shizu_Type* PARENTTYPE = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), TYPE);
+    Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value argumentValues[] = { Shizu_Value_InitializerObject(SELF) };
+    Shizu_Type_getObjectTypeDescriptor(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), PARENTTYPE)->construct(state, &returnValue, 1, &argumentValues[0]);
+  }
+  SELF->bufferId = 0;
+  ((Shizu_Object*)SELF)->type = TYPE;
+  Visuals_Gl_Service_statistics.numberOfLiveIndexBuffers++;
+}
+
+Visuals_Gl_IndexBuffer*
+Visuals_Gl_IndexBuffer_create
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+  Shizu_Value argumentValues[] = { Shizu_Value_InitializerType(Visuals_Gl_IndexBuffer_getType(state)) };
+  Shizu_Operations_create(state, &returnValue, 1, &argumentValues[0]);
+  return (Visuals_Gl_IndexBuffer*)Shizu_Value_getObject(&returnValue);
+}
@@ -0,0 +1,59 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(VISUALS_GL_INDEXBUFFER_H_INCLUDED)
+#define VISUALS_GL_INDEXBUFFER_H_INCLUDED
+
+#include "Visuals/IndexBuffer.h"
+#include "Visuals/Gl/ServiceGl.h"
+
+/// @brief
+/// The implementation of Visuals.IndexBuffer for OpenGL.
+/// @details
+/// bufferId is the OpenGL representation of the indices.
+/// The type is
+/// @code
+/// class Visuals.Gl.IndexBuffer
+/// @endcode
+/// Its constructor is
+/// @code
+/// Visuals.Gl.IndexBuffer.construct()
+/// @endcode
+Shizu_declareObjectType(Visuals_Gl_IndexBuffer);
+
+struct Visuals_Gl_IndexBuffer_Dispatch {
+  Visuals_IndexBuffer_Dispatch _parent;
+};
+
+struct Visuals_Gl_IndexBuffer {
+  Visuals_IndexBuffer parent;
+  /// @brief The OpenGL ID of the index buffer.
+  GLuint bufferId;
+};
+
+Visuals_Gl_IndexBuffer*
+Visuals_Gl_IndexBuffer_create
+  (
+    Shizu_State2* state
+  );
+
+#endif // VISUALS_GL_INDEXBUFFER_H_INCLUDED
@@ -21,6 +21,14 @@
 
 #include "Visuals/Gl/Program.h"
 
+#include "Visuals/Gl/ProgramCache.h"
+
+// realloc, free
+#include <stdlib.h>
+
+// memcmp, memcpy, strcmp, strcpy, strlen
+#include <string.h>
+
 static void
 Visuals_Gl_Program_finalize
   (
@@ -49,6 +57,20 @@ Visuals_Gl_Program_unmaterializeImpl
     Visuals_Gl_Program* self
   );
 
+static void
+Visuals_Gl_Program_materializeAsyncImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Program* self
+  );
+
+static Shizu_Boolean
+Visuals_Gl_Program_isPendingImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Program* self
+  );
+
 static void
 Visuals_Gl_Program_bindMatrix4R32Impl
   (
@@ -103,6 +125,15 @@ Visuals_Gl_Program_bindFloat32Impl
     Shizu_Float32 value
   );
 
+static void
+Visuals_Gl_Program_bindUniformBlockImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Program* self,
+    char const* name,
+    Shizu_Integer32 index
+  );
+
 static Shizu_ObjectTypeDescriptor const Visuals_Gl_Program_Type = {
   .preDestroyType = NULL,
   .postCreateType = NULL,
@@ -117,6 +148,58 @@ static Shizu_ObjectTypeDescriptor const Visuals_Gl_Program_Type = {
 
 Shizu_defineObjectType("Zeitgeist.Visuals.Gl.Program", Visuals_Gl_Program, Visuals_Program);
 
+/// The programs of which the compilation and the linking are in progress in the order in which they were issued.
+/// A program is locked while it is in this list.
+static struct {
+  Visuals_Gl_Program** elements;
+  size_t size;
+  size_t capacity;
+} g_pendingPrograms = {
+  .elements = NULL,
+  .size = 0,
+  .capacity = 0,
+};
+
+static void
+addPendingProgram
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Program* program
+  )
+{
+  if (g_pendingPrograms.size == g_pendingPrograms.capacity) {
+    size_t newCapacity = g_pendingPrograms.capacity ? g_pendingPrograms.capacity * 2 : 8;
+    Visuals_Gl_Program** newElements = realloc(g_pendingPrograms.elements, newCapacity * sizeof(Visuals_Gl_Program*));
+    if (!newElements) {
+      Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State2_jump(state);
+    }
+    g_pendingPrograms.elements = newElements;
+    g_pendingPrograms.capacity = newCapacity;
+  }
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)program);
+  g_pendingPrograms.elements[g_pendingPrograms.size++] = program;
+  program->pending = Shizu_Boolean_True;
+}
+
+static void
+removePendingProgram
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Program* program
+  )
+{
+  for (size_t i = 0; i < g_pendingPrograms.size; ++i) {
+    if (g_pendingPrograms.elements[i] == program) {
+      memmove(&g_pendingPrograms.elements[i], &g_pendingPrograms.elements[i + 1], (g_pendingPrograms.size - i - 1) * sizeof(Visuals_Gl_Program*));
+      g_pendingPrograms.size--;
+      program->pending = Shizu_Boolean_False;
+      Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)program);
+      return;
+    }
+  }
+}
+
 static void
 Visuals_Gl_Program_finalize
   (
@@ -136,26 +219,180 @@ Visuals_Gl_Program_finalize
     glDeleteProgram(self->programId);
     self->programId = 0;
   }
+  if (self->uniformValues) {
+    free(self->uniformValues);
+    self->uniformValues = NULL;
+  }
+  if (self->uniformBlockBindings) {
+    free(self->uniformBlockBindings);
+    self->uniformBlockBindings = NULL;
+  }
+  Visuals_Gl_Service_statistics.numberOfLivePrograms--;
 }
 
+// Get the zero-terminated sources of the vertex program and the fragment program.
 static void
-Visuals_Gl_Program_materializeImpl
+Visuals_Gl_Program_getSources
   (
     Shizu_State2* state,
-    Visuals_Gl_Program* self
+    Visuals_Gl_Program* self,
+    char const** vertexSource,
+    char const** fragmentSource
   )
 {
   Shizu_String* temporary = NULL;
 
   temporary = Shizu_String_concatenate(state, ((Visuals_Program*)self)->vertexProgramSource, Shizu_String_create(state, "", 1));
-  self->vertexProgramId = Visuals_Gl_Service_compileShader(state, GL_VERTEX_SHADER, Shizu_String_getBytes(state, temporary));
+  *vertexSource = Shizu_String_getBytes(state, temporary);
 
   temporary = Shizu_String_concatenate(state, ((Visuals_Program*)self)->fragmentProgramSource, Shizu_String_create(state, "", 1));
-  self->fragmentProgramId = Visuals_Gl_Service_compileShader(state, GL_FRAGMENT_SHADER, Shizu_String_getBytes(state, temporary));
+  *fragmentSource = Shizu_String_getBytes(state, temporary);
+}
 
-  self->programId = Visuals_Gl_Service_linkProgram(state, self->vertexProgramId, self->fragmentProgramId);
+// Assign the uniform blocks of the linked program to their binding points.
+// The linking and the loading of a program binary reset the binding points.
+static void
+Visuals_Gl_Program_applyUniformBlockBindings
+  (
+    Visuals_Gl_Program* self
+  )
+{
+  for (size_t i = 0; i < self->numberOfUniformBlockBindings; ++i) {
+    Visuals_Gl_UniformBlockBinding const* binding = &self->uniformBlockBindings[i];
+    GLuint blockIndex = glGetUniformBlockIndex(self->programId, binding->name);
+    if (GL_INVALID_INDEX == blockIndex) {
+      fprintf(stderr, "%s:%d: unable to get uniform block index of uniform block `%s`\n", __FILE__, __LINE__, binding->name);
+    } else {
+      glUniformBlockBinding(self->programId, blockIndex, binding->index);
+    }
+  }
 }
 
+// Load the program from the program cache or issue the compilation of its shaders and the linking of the program.
+// The compilation and the linking are not waited for. If they were issued, the program is added to the pending programs.
+static void
+Visuals_Gl_Program_issue
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Program* self
+  )
+{
+  char const* vertexSource, * fragmentSource;
+  Visuals_Gl_Program_getSources(state, self, &vertexSource, &fragmentSource);
+
+  // If a binary of the program is cached, then the shaders are neither compiled nor linked.
+  self->programId = Visuals_Gl_ProgramCache_load(state, vertexSource, fragmentSource);
+  if (self->programId) {
+    Visuals_Gl_Program_applyUniformBlockBindings(self);
+    return;
+  }
+
+  self->vertexProgramId = glCreateShader(GL_VERTEX_SHADER);
+  glShaderSource(self->vertexProgramId, 1, &vertexSource, NULL);
+  glCompileShader(self->vertexProgramId);
+
+  self->fragmentProgramId = glCreateShader(GL_FRAGMENT_SHADER);
+  glShaderSource(self->fragmentProgramId, 1, &fragmentSource, NULL);
+  glCompileShader(self->fragmentProgramId);
+
+  self->programId = glCreateProgram();
+  if (glProgramParameteri) {
+    // Hint that the binary is retrieved for the program cache.
+    glProgramParameteri(self->programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+  glAttachShader(self->programId, self->vertexProgramId);
+  glAttachShader(self->programId, self->fragmentProgramId);
+  glLinkProgram(self->programId);
+
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    addPendingProgram(state, self);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Visuals_Gl_Program_unmaterializeImpl(state, self);
+    Shizu_State2_jump(state);
+  }
+}
+
+// Wait for the compilation and the linking of a pending program to complete and check their results.
+// If they failed, the logs are printed, the program is unmaterialized and marked as failed.
+// Otherwise the binary of the program is stored in the program cache.
+static void
+Visuals_Gl_Program_complete
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Program* self
+  )
+{
+  removePendingProgram(state, self);
+  GLuint shaderIds[] = { self->vertexProgramId, self->fragmentProgramId };
+  for (size_t i = 0; i < 2; ++i) {
+    GLint param;
+    glGetShaderiv(shaderIds[i], GL_COMPILE_STATUS, &param);
+    if (!param) {
+      GLchar log[4096];
+      glGetShaderInfoLog(shaderIds[i], sizeof(log), NULL, log);
+      fprintf(stderr, "error: %s: %s\n", shaderIds[i] == self->fragmentProgramId ? "frag" : "vert", (char*)log);
+      Visuals_Gl_Program_unmaterializeImpl(state, self);
+      self->failed = Shizu_Boolean_True;
+      return;
+    }
+  }
+  GLint param;
+  glGetProgramiv(self->programId, GL_LINK_STATUS, &param);
+  if (!param) {
+    GLchar log[4096];
+    glGetProgramInfoLog(self->programId, sizeof(log), NULL, log);
+    fprintf(stderr, "error: link: %s\n", (char*)log);
+    Visuals_Gl_Program_unmaterializeImpl(state, self);
+    self->failed = Shizu_Boolean_True;
+    return;
+  }
+  Visuals_Gl_Program_applyUniformBlockBindings(self);
+  char const* vertexSource, * fragmentSource;
+  Visuals_Gl_Program_getSources(state, self, &vertexSource, &fragmentSource);
+  Visuals_Gl_ProgramCache_store(state, vertexSource, fragmentSource, self->programId);
+}
+
+static void
+Visuals_Gl_Program_materializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Program* self
+  )
+{
+  if (!self->programId && !self->failed) {
+    Visuals_Gl_Program_issue(state, self);
+  }
+  if (self->pending) {
+    Visuals_Gl_Program_complete(state, self);
+  }
+  Visuals_Gl_Program_ensureUsable(state, self);
+}
+
+static void
+Visuals_Gl_Program_materializeAsyncImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Program* self
+  )
+{
+  // A program of which the compilation or the linking failed is not issued again.
+  if (!self->programId && !self->failed) {
+    Visuals_Gl_Program_issue(state, self);
+  }
+}
+
+static Shizu_Boolean
+Visuals_Gl_Program_isPendingImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Program* self
+  )
+{ return self->pending; }
+
 static void
 Visuals_Gl_Program_unmaterializeImpl
   (
@@ -163,6 +400,9 @@ Visuals_Gl_Program_unmaterializeImpl
     Visuals_Gl_Program* self
   )
 {
+  if (self->pending) {
+    removePendingProgram(state, self);
+  }
   if (self->vertexProgramId) {
     glDeleteShader(self->vertexProgramId);
     self->vertexProgramId = 0;
@@ -175,6 +415,53 @@ Visuals_Gl_Program_unmaterializeImpl
     glDeleteProgram(self->programId);
     self->programId = 0;
   }
+  // The values of the uniforms are lost with the program.
+  self->numberOfUniformValues = 0;
+}
+
+// Get if the uniform at the specified location must be updated to the specified value.
+// If the uniform already has the value, the update is counted as deduplicated and false is returned.
+// Otherwise the value is stored, the update is counted, and true is returned.
+static Shizu_Boolean
+Visuals_Gl_Program_updateUniformValue
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Program* self,
+    GLint location,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{
+  Visuals_Gl_UniformValue* value = NULL;
+  for (size_t i = 0; i < self->numberOfUniformValues; ++i) {
+    if (self->uniformValues[i].location == location) {
+      value = &self->uniformValues[i];
+      break;
+    }
+  }
+  if (value) {
+    if (value->numberOfBytes == numberOfBytes && !memcmp(value->bytes, bytes, numberOfBytes)) {
+      Visuals_Gl_Service_statistics.numberOfDeduplicatedUniformUpdates++;
+      return Shizu_Boolean_False;
+    }
+  } else {
+    if (self->numberOfUniformValues == self->uniformValuesCapacity) {
+      size_t newCapacity = self->uniformValuesCapacity ? self->uniformValuesCapacity * 2 : 8;
+      Visuals_Gl_UniformValue* newUniformValues = realloc(self->uniformValues, newCapacity * sizeof(Visuals_Gl_UniformValue));
+      if (!newUniformValues) {
+        Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+        Shizu_State2_jump(state);
+      }
+      self->uniformValues = newUniformValues;
+      self->uniformValuesCapacity = newCapacity;
+    }
+    value = &self->uniformValues[self->numberOfUniformValues++];
+    value->location = location;
+  }
+  value->numberOfBytes = numberOfBytes;
+  memcpy(value->bytes, bytes, numberOfBytes);
+  Visuals_Gl_Service_statistics.numberOfUniformUpdates++;
+  return Shizu_Boolean_True;
 }
 
 static void
@@ -186,11 +473,13 @@ Visuals_Gl_Program_bindMatrix4R32Impl
     Matrix4F32* value
   )
 {
+  Visuals_Gl_Program_ensureUsable(state, self);
   GLint location = glGetUniformLocation(self->programId, name);
   if (-1 == location) {
     fprintf(stderr, "%s:%d: unable to get uniform location of uniform `%s`\n", __FILE__, __LINE__, name);
-  } else {
+  } else if (Visuals_Gl_Program_updateUniformValue(state, self, location, idlib_matrix_4x4_f32_get_data(&value->m), sizeof(Shizu_Float32) * 16)) {
     glUseProgram(self->programId);
+    Visuals_Gl_Service_statistics.numberOfProgramBinds++;
     glUniformMatrix4fv(location, 1, GL_TRUE, idlib_matrix_4x4_f32_get_data(&value->m));
   }
 }
@@ -204,11 +493,13 @@ Visuals_Gl_Program_bindVector3R32Impl
     Vector3F32* value
   )
 {
+  Visuals_Gl_Program_ensureUsable(state, self);
   GLint location = glGetUniformLocation(self->programId, name);
   if (-1 == location) {
     fprintf(stderr, "%s:%d: unable to get uniform location of uniform `%s`\n", __FILE__, __LINE__, name);
-  } else {
+  } else if (Visuals_Gl_Program_updateUniformValue(state, self, location, &value->v.e[0], sizeof(Shizu_Float32) * 3)) {
     glUseProgram(self->programId);
+    Visuals_Gl_Service_statistics.numberOfProgramBinds++;
     glUniform3fv(location, 1, &value->v.e[0]);
   }
 }
@@ -222,11 +513,13 @@ Visuals_Gl_Program_bindVector4R32Impl
     Vector4F32* value
   )
 {
+  Visuals_Gl_Program_ensureUsable(state, self);
   GLint location = glGetUniformLocation(self->programId, name);
   if (-1 == location) {
     fprintf(stderr, "%s:%d: unable to get uniform location of uniform `%s`\n", __FILE__, __LINE__, name);
-  } else {
+  } else if (Visuals_Gl_Program_updateUniformValue(state, self, location, &value->v.e[0], sizeof(Shizu_Float32) * 4)) {
     glUseProgram(self->programId);
+    Visuals_Gl_Service_statistics.numberOfProgramBinds++;
     glUniform4fv(location, 1, &value->v.e[0]);
   }
 }
@@ -240,15 +533,68 @@ Visuals_Gl_Program_bindInteger32Impl
     Shizu_Integer32 value
   )
 {
+  Visuals_Gl_Program_ensureUsable(state, self);
   GLint location = glGetUniformLocation(self->programId, name);
   if (-1 == location) {
     fprintf(stderr, "%s:%d: unable to get uniform location of uniform `%s`\n", __FILE__, __LINE__, name);
-  } else {
+  } else if (Visuals_Gl_Program_updateUniformValue(state, self, location, &value, sizeof(value))) {
     glUseProgram(self->programId);
+    Visuals_Gl_Service_statistics.numberOfProgramBinds++;
     glUniform1i(location, value);
   }
 }
 
+static void
+Visuals_Gl_Program_bindUniformBlockImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Program* self,
+    char const* name,
+    Shizu_Integer32 index
+  )
+{
+  if (index < 0) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  if (strlen(name) >= sizeof(((Visuals_Gl_UniformBlockBinding*)NULL)->name)) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  Visuals_Gl_Program_ensureUsable(state, self);
+  Visuals_Gl_UniformBlockBinding* binding = NULL;
+  for (size_t i = 0; i < self->numberOfUniformBlockBindings; ++i) {
+    if (!strcmp(self->uniformBlockBindings[i].name, name)) {
+      binding = &self->uniformBlockBindings[i];
+      break;
+    }
+  }
+  if (!binding) {
+    if (self->numberOfUniformBlockBindings == self->uniformBlockBindingsCapacity) {
+      size_t newCapacity = self->uniformBlockBindingsCapacity ? self->uniformBlockBindingsCapacity * 2 : 8;
+      Visuals_Gl_UniformBlockBinding* newUniformBlockBindings = realloc(self->uniformBlockBindings, newCapacity * sizeof(Visuals_Gl_UniformBlockBinding));
+      if (!newUniformBlockBindings) {
+        Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+        Shizu_State2_jump(state);
+      }
+      self->uniformBlockBindings = newUniformBlockBindings;
+      self->uniformBlockBindingsCapacity = newCapacity;
+    }
+    binding = &self->uniformBlockBindings[self->numberOfUniformBlockBindings++];
+    strcpy(binding->name, name);
+  }
+  binding->index = (GLuint)index;
+  // If the program is not linked yet, the binding point is assigned when it is linked.
+  if (self->programId && !self->pending) {
+    GLuint blockIndex = glGetUniformBlockIndex(self->programId, name);
+    if (GL_INVALID_INDEX == blockIndex) {
+      fprintf(stderr, "%s:%d: unable to get uniform block index of uniform block `%s`\n", __FILE__, __LINE__, name);
+    } else {
+      glUniformBlockBinding(self->programId, blockIndex, binding->index);
+    }
+  }
+}
+
 static void
 Visuals_Gl_Program_bindBooleanImpl
   (
@@ -258,12 +604,15 @@ Visuals_Gl_Program_bindBooleanImpl
     Shizu_Boolean value
   )
 {
+  Visuals_Gl_Program_ensureUsable(state, self);
   GLint location = glGetUniformLocation(self->programId, name);
+  GLint v = value ? 1 : 0;
   if (-1 == location) {
     fprintf(stderr, "%s:%d: unable to get uniform location of uniform `%s`\n", __FILE__, __LINE__, name);
-  } else {
+  } else if (Visuals_Gl_Program_updateUniformValue(state, self, location, &v, sizeof(v))) {
     glUseProgram(self->programId);
-    glUniform1i(location, value ? 1 : 0);
+    Visuals_Gl_Service_statistics.numberOfProgramBinds++;
+    glUniform1i(location, v);
   }
 }
 
@@ -276,11 +625,13 @@ Visuals_Gl_Program_bindFloat32Impl
     Shizu_Float32 value
   )
 {
+  Visuals_Gl_Program_ensureUsable(state, self);
   GLint location = glGetUniformLocation(self->programId, name);
   if (-1 == location) {
     fprintf(stderr, "%s:%d: unable to get uniform location of uniform `%s`\n", __FILE__, __LINE__, name);
-  } else {
+  } else if (Visuals_Gl_Program_updateUniformValue(state, self, location, &value, sizeof(value))) {
     glUseProgram(self->programId);
+    Visuals_Gl_Service_statistics.numberOfProgramBinds++;
     glUniform1f(location, value);
   }
 }
@@ -296,10 +647,13 @@ Visuals_Gl_Program_dispatchInitialize
   ((Visuals_Object_Dispatch*)self)->unmaterialize = (void(*)(Shizu_State2*, Visuals_Object*)) & Visuals_Gl_Program_unmaterializeImpl;
   ((Visuals_Program_Dispatch*)self)->bindBoolean = (void(*)(Shizu_State2*, Visuals_Program*, char const*, Shizu_Boolean)) &Visuals_Gl_Program_bindBooleanImpl;
   ((Visuals_Program_Dispatch*)self)->bindFloat32 = (void(*)(Shizu_State2*, Visuals_Program*, char const*, Shizu_Float32)) & Visuals_Gl_Program_bindFloat32Impl;
+  ((Visuals_Program_Dispatch*)self)->bindUniformBlock = (void(*)(Shizu_State2*, Visuals_Program*, char const*, Shizu_Integer32)) & Visuals_Gl_Program_bindUniformBlockImpl;
   ((Visuals_Program_Dispatch*)self)->bindInteger32 = (void(*)(Shizu_State2*, Visuals_Program*, char const*, Shizu_Integer32)) & Visuals_Gl_Program_bindInteger32Impl;
   ((Visuals_Program_Dispatch*)self)->bindMatrix4F32 = (void(*)(Shizu_State2*, Visuals_Program*, char const*, Matrix4F32*)) & Visuals_Gl_Program_bindMatrix4R32Impl;
   ((Visuals_Program_Dispatch*)self)->bindVector3F32 = (void(*)(Shizu_State2*, Visuals_Program*, char const*, Vector3F32*)) & Visuals_Gl_Program_bindVector3R32Impl;
   ((Visuals_Program_Dispatch*)self)->bindVector4F32 = (void(*)(Shizu_State2*, Visuals_Program*, char const*, Vector4F32*)) & Visuals_Gl_Program_bindVector4R32Impl;
+  ((Visuals_Program_Dispatch*)self)->materializeAsync = (void(*)(Shizu_State2*, Visuals_Program*)) & Visuals_Gl_Program_materializeAsyncImpl;
+  ((Visuals_Program_Dispatch*)self)->isPending = (Shizu_Boolean(*)(Shizu_State2*, Visuals_Program*)) & Visuals_Gl_Program_isPendingImpl;
 }
 
 void
@@ -316,7 +670,16 @@ Visuals_Gl_Program_construct
   self->vertexProgramId = 0;
   self->fragmentProgramId = 0;
   self->programId = 0;
+  self->uniformValues = NULL;
+  self->numberOfUniformValues = 0;
+  self->uniformValuesCapacity = 0;
+  self->uniformBlockBindings = NULL;
+  self->numberOfUniformBlockBindings = 0;
+  self->uniformBlockBindingsCapacity = 0;
+  self->pending = Shizu_Boolean_False;
+  self->failed = Shizu_Boolean_False;
   ((Shizu_Object*)self)->type = TYPE;
+  Visuals_Gl_Service_statistics.numberOfLivePrograms++;
 }
 
 Visuals_Gl_Program*
@@ -331,3 +694,81 @@ Visuals_Gl_Program_create
   Visuals_Gl_Program_construct(state, self, vertexProgramSource, fragmentProgramSource);
   return self;
 }
+
+void
+Visuals_Gl_Program_ensureUsable
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Program* self
+  )
+{
+  if (self->failed) {
+    fprintf(stderr, "%s:%d: the compilation or the linking of the program failed\n", __FILE__, __LINE__);
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+}
+
+void
+Visuals_Gl_Program_setInstanceDescriptor
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Program* self,
+    Shizu_Integer32 instanceDescriptor
+  )
+{
+  GLint location = glGetUniformLocation(self->programId, "instanceDescriptor");
+  if (-1 == location) {
+    return;
+  }
+  if (Visuals_Gl_Program_updateUniformValue(state, self, location, &instanceDescriptor, sizeof(instanceDescriptor))) {
+    glUseProgram(self->programId);
+    Visuals_Gl_Service_statistics.numberOfProgramBinds++;
+    glUniform1i(location, instanceDescriptor);
+  }
+}
+
+void
+Visuals_Gl_Program_updatePending
+  (
+    Shizu_State2* state
+  )
+{
+  if (!g_pendingPrograms.size) {
+    return;
+  }
+  if (!glMaxShaderCompilerThreadsKHR && !glMaxShaderCompilerThreadsARB) {
+    // The completion can not be polled: Complete one program per update such that the frames continue.
+    Visuals_Gl_Program_complete(state, g_pendingPrograms.elements[0]);
+    return;
+  }
+  // GL_COMPLETION_STATUS_KHR and GL_COMPLETION_STATUS_ARB have the same value.
+  size_t i = 0;
+  while (i < g_pendingPrograms.size) {
+    Visuals_Gl_Program* program = g_pendingPrograms.elements[i];
+    GLint completed = GL_FALSE;
+    glGetProgramiv(program->programId, GL_COMPLETION_STATUS_KHR, &completed);
+    if (completed) {
+      // Removes the program from the pending programs.
+      Visuals_Gl_Program_complete(state, program);
+    } else {
+      i++;
+    }
+  }
+}
+
+void
+Visuals_Gl_Program_shutdownPending
+  (
+    Shizu_State2* state
+  )
+{
+  while (g_pendingPrograms.size) {
+    removePendingProgram(state, g_pendingPrograms.elements[g_pendingPrograms.size - 1]);
+  }
+  if (g_pendingPrograms.elements) {
+    free(g_pendingPrograms.elements);
+    g_pendingPrograms.elements = NULL;
+  }
+  g_pendingPrograms.capacity = 0;
+}
@@ -31,11 +31,44 @@ struct Visuals_Gl_Program_Dispatch {
   Visuals_Program_Dispatch _parent;
 };
 
+/// @brief The value last stored in a uniform of a program.
+typedef struct Visuals_Gl_UniformValue {
+  /// The location of the uniform.
+  GLint location;
+  /// The size, in Bytes, of the value.
+  size_t numberOfBytes;
+  /// The Bytes of the value. Large enough for a 4x4 matrix of Shizu_Float32 values.
+  uint8_t bytes[64];
+} Visuals_Gl_UniformValue;
+
+/// @brief The binding point assigned to a uniform block of a program.
+typedef struct Visuals_Gl_UniformBlockBinding {
+  /// The zero-terminated name of the uniform block.
+  char name[64];
+  /// The index of the uniform buffer binding point.
+  GLuint index;
+} Visuals_Gl_UniformBlockBinding;
+
 struct Visuals_Gl_Program {
   Visuals_Program _parent;
   GLuint vertexProgramId;
   GLuint fragmentProgramId;
   GLuint programId;
+  /// The values last stored in the uniforms of the program.
+  /// Used to skip the updates of uniforms which already have the value.
+  Visuals_Gl_UniformValue* uniformValues;
+  size_t numberOfUniformValues;
+  size_t uniformValuesCapacity;
+  /// The binding points assigned to the uniform blocks of the program.
+  /// Applied when the program is linked or loaded from the program cache such that they can be assigned once while the program is pending.
+  Visuals_Gl_UniformBlockBinding* uniformBlockBindings;
+  size_t numberOfUniformBlockBindings;
+  size_t uniformBlockBindingsCapacity;
+  /// Whether the compilation and the linking of the program are in progress.
+  Shizu_Boolean pending;
+  /// Whether the compilation or the linking of the program failed.
+  /// The failure is reported when the program is next bound or used (see Visuals_Gl_Program_ensureUsable).
+  Shizu_Boolean failed;
 };
 
 void
@@ -55,4 +88,49 @@ Visuals_Gl_Program_create
     Shizu_String* fragmentSource
   );
 
+/// @brief Set the "instanceDescriptor" uniform of a program.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this program. The program must be in use.
+/// @param instanceDescriptor The semantics of the instance buffer of the draw call or @a 0 if the draw call is not instanced.
+/// @remarks Invoked by Visuals_Context_renderInstanced. Programs without the uniform are not modified.
+void
+Visuals_Gl_Program_setInstanceDescriptor
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Program* self,
+    Shizu_Integer32 instanceDescriptor
+  );
+
+/// @brief Raise an error if the compilation or the linking of a program failed.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this program.
+/// @error The compilation or the linking of the program failed.
+/// @remarks Invoked when the program is bound or used by a draw call.
+void
+Visuals_Gl_Program_ensureUsable
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Program* self
+  );
+
+/// @brief Complete the programs of which the compilation and the linking completed.
+/// @param state A pointer to a Shizu_State2 value.
+/// @remarks If the driver supports GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile, the completion is polled without waiting.
+/// Otherwise, the oldest pending program is completed, waiting for its compilation and linking.
+/// If the compilation or the linking of a program failed, the program is unmaterialized and marked as failed.
+/// The failure is not raised here but when the program is next bound or used.
+void
+Visuals_Gl_Program_updatePending
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Stop tracking the pending programs.
+/// @param state A pointer to a Shizu_State2 value.
+void
+Visuals_Gl_Program_shutdownPending
+  (
+    Shizu_State2* state
+  );
+
 #endif // VISUALS_GL_PROGRAM_H_INCLUDED
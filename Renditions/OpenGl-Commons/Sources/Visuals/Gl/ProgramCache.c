@@ -0,0 +1,367 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "Visuals/Gl/ProgramCache.h"
+
+// fopen, fread, fwrite, fclose, remove, rename, fprintf, stderr
+#include <stdio.h>
+
+// malloc, free, getenv
+#include <stdlib.h>
+
+// strlen, memcpy
+#include <string.h>
+
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  // _mkdir
+  #include <direct.h>
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  // mkdir
+  #include <sys/stat.h>
+#else
+  #error("operating system not (yet) supported")
+#endif
+
+// errno, EEXIST
+#include <errno.h>
+
+/// @brief The magic number of a cache file, "ZGPB" in little endian.
+#define Magic (UINT32_C(0x4250475A))
+
+/// @brief The version of the format of a cache file.
+#define Version (UINT32_C(1))
+
+/// @brief The header of a cache file. The header is followed by the binary.
+typedef struct Header {
+  uint32_t magic;
+  uint32_t version;
+  /// @brief The key of the program.
+  /// Stored to detect hash collisions of the file names.
+  uint64_t key;
+  /// @brief The format of the binary as returned by glGetProgramBinary.
+  uint32_t binaryFormat;
+  /// @brief The size, in Bytes, of the binary.
+  uint32_t binaryLength;
+} Header;
+
+static struct {
+  /// @brief The path of the cache directory. A null pointer if the cache is disabled.
+  char* directory;
+  /// @brief The hash of the vendor, renderer, and version strings of the driver.
+  uint64_t driverHash;
+} g_cache = {
+  .directory = NULL,
+  .driverHash = 0,
+};
+
+#define HashInitializer (UINT64_C(14695981039346656037))
+
+// FNV-1a.
+static uint64_t
+hash
+  (
+    uint64_t h,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{
+  for (size_t i = 0; i < numberOfBytes; ++i) {
+    h ^= ((uint8_t const*)bytes)[i];
+    h *= UINT64_C(1099511628211);
+  }
+  return h;
+}
+
+// Hash a zero-terminated string including its zero terminator such that the boundaries of consecutive strings are part of the hash.
+static uint64_t
+hashString
+  (
+    uint64_t h,
+    char const* string
+  )
+{ return hash(h, string, strlen(string) + 1); }
+
+static uint64_t
+getKey
+  (
+    char const* vertexSource,
+    char const* fragmentSource
+  )
+{
+  uint64_t h = g_cache.driverHash;
+  h = hashString(h, vertexSource);
+  h = hashString(h, fragmentSource);
+  return h;
+}
+
+// Concatenate strings. Returns a null pointer if the allocation failed.
+static char*
+concatenate
+  (
+    char const* a,
+    char const* b,
+    char const* c
+  )
+{
+  size_t na = strlen(a), nb = strlen(b), nc = strlen(c);
+  char* p = malloc(na + nb + nc + 1);
+  if (!p) {
+    return NULL;
+  }
+  memcpy(p, a, na);
+  memcpy(p + na, b, nb);
+  memcpy(p + na + nb, c, nc + 1);
+  return p;
+}
+
+// Create a directory. Returns true if the directory was created or already existed.
+static bool
+createDirectory
+  (
+    char const* path
+  )
+{
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  return !_mkdir(path) || EEXIST == errno;
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  return !mkdir(path, 0755) || EEXIST == errno;
+#endif
+}
+
+// Create a directory and its missing parent directories.
+static bool
+createDirectories
+  (
+    char* path
+  )
+{
+  for (char* p = path + 1; *p; ++p) {
+    if ('/' == *p || '\\' == *p) {
+      char separator = *p;
+      *p = '\0';
+      bool result = (p > path && ':' == p[-1]) || createDirectory(path);
+      *p = separator;
+      if (!result) {
+        return false;
+      }
+    }
+  }
+  return createDirectory(path);
+}
+
+// Get the path of the default cache directory. Returns a null pointer if the path can not be determined.
+static char*
+getDefaultDirectory
+  (
+    void
+  )
+{
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  char const* localAppData = getenv("LOCALAPPDATA");
+  if (localAppData && strcmp(localAppData, "")) {
+    return concatenate(localAppData, "\\zeitgeist\\programs", "");
+  }
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  char const* cacheHome = getenv("XDG_CACHE_HOME");
+  if (cacheHome && strcmp(cacheHome, "")) {
+    return concatenate(cacheHome, "/zeitgeist/programs", "");
+  }
+  char const* home = getenv("HOME");
+  if (home && strcmp(home, "")) {
+    return concatenate(home, "/.cache/zeitgeist/programs", "");
+  }
+#endif
+  return NULL;
+}
+
+// Get the path of the cache file of a key. Returns a null pointer if the allocation failed.
+static char*
+getPath
+  (
+    uint64_t key,
+    char const* suffix
+  )
+{
+  char name[32];
+  snprintf(name, sizeof(name), "/%016llx", (unsigned long long)key);
+  char* p = concatenate(g_cache.directory, name, suffix);
+  return p;
+}
+
+void
+Visuals_Gl_ProgramCache_startup
+  (
+    Shizu_State2* state,
+    char const* directory
+  )
+{
+  if (!directory || !glGetProgramBinary || !glProgramBinary || !glProgramParameteri) {
+    return;
+  }
+  GLint numberOfFormats = 0;
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numberOfFormats);
+  if (numberOfFormats <= 0) {
+    return;
+  }
+  char* path = strcmp(directory, "") ? concatenate(directory, "", "") : getDefaultDirectory();
+  if (!path) {
+    return;
+  }
+  if (!createDirectories(path)) {
+    fprintf(stderr, "%s:%d: unable to create program cache directory `%s`, program cache disabled\n", __FILE__, __LINE__, path);
+    free(path);
+    return;
+  }
+  uint64_t h = HashInitializer;
+  h = hashString(h, (char const*)glGetString(GL_VENDOR));
+  h = hashString(h, (char const*)glGetString(GL_RENDERER));
+  h = hashString(h, (char const*)glGetString(GL_VERSION));
+  g_cache.driverHash = h;
+  g_cache.directory = path;
+}
+
+void
+Visuals_Gl_ProgramCache_shutdown
+  (
+    Shizu_State2* state
+  )
+{
+  if (g_cache.directory) {
+    free(g_cache.directory);
+    g_cache.directory = NULL;
+  }
+}
+
+GLuint
+Visuals_Gl_ProgramCache_load
+  (
+    Shizu_State2* state,
+    char const* vertexSource,
+    char const* fragmentSource
+  )
+{
+  if (!g_cache.directory) {
+    return 0;
+  }
+  uint64_t key = getKey(vertexSource, fragmentSource);
+  char* path = getPath(key, ".bin");
+  if (!path) {
+    return 0;
+  }
+  FILE* file = fopen(path, "rb");
+  free(path);
+  if (!file) {
+    return 0;
+  }
+  Header header;
+  if (1 != fread(&header, sizeof(Header), 1, file) || Magic != header.magic || Version != header.version || key != header.key || !header.binaryLength) {
+    fclose(file);
+    return 0;
+  }
+  void* binary = malloc(header.binaryLength);
+  if (!binary) {
+    fclose(file);
+    return 0;
+  }
+  if (1 != fread(binary, header.binaryLength, 1, file)) {
+    free(binary);
+    fclose(file);
+    return 0;
+  }
+  fclose(file);
+  while (glGetError()) { }
+  GLuint programId = glCreateProgram();
+  glProgramBinary(programId, (GLenum)header.binaryFormat, binary, (GLsizei)header.binaryLength);
+  free(binary);
+  // The driver rejects binaries it can not load e.g., after a driver update which did not change the version string.
+  GLint linked = GL_FALSE;
+  glGetProgramiv(programId, GL_LINK_STATUS, &linked);
+  if (glGetError() || !linked) {
+    glDeleteProgram(programId);
+    return 0;
+  }
+  return programId;
+}
+
+void
+Visuals_Gl_ProgramCache_store
+  (
+    Shizu_State2* state,
+    char const* vertexSource,
+    char const* fragmentSource,
+    GLuint programId
+  )
+{
+  if (!g_cache.directory) {
+    return;
+  }
+  GLint length = 0;
+  glGetProgramiv(programId, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+  void* binary = malloc((size_t)length);
+  if (!binary) {
+    return;
+  }
+  Header header;
+  header.magic = Magic;
+  header.version = Version;
+  header.key = getKey(vertexSource, fragmentSource);
+  GLsizei binaryLength = 0;
+  GLenum binaryFormat = 0;
+  while (glGetError()) { }
+  glGetProgramBinary(programId, length, &binaryLength, &binaryFormat, binary);
+  if (glGetError() || binaryLength <= 0) {
+    free(binary);
+    return;
+  }
+  header.binaryFormat = (uint32_t)binaryFormat;
+  header.binaryLength = (uint32_t)binaryLength;
+  // Write to a temporary file and rename it such that concurrent processes never read a partially written file.
+  char* temporaryPath = getPath(header.key, ".tmp");
+  char* path = getPath(header.key, ".bin");
+  if (!temporaryPath || !path) {
+    free(path);
+    free(temporaryPath);
+    free(binary);
+    return;
+  }
+  FILE* file = fopen(temporaryPath, "wb");
+  bool written = file
+              && 1 == fwrite(&header, sizeof(Header), 1, file)
+              && 1 == fwrite(binary, (size_t)binaryLength, 1, file);
+  if (file && fclose(file)) {
+    written = false;
+  }
+  free(binary);
+  if (written) {
+    // rename does not replace existing files under Windows.
+    remove(path);
+    written = !rename(temporaryPath, path);
+  }
+  if (!written) {
+    remove(temporaryPath);
+  }
+  free(path);
+  free(temporaryPath);
+}
@@ -0,0 +1,76 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(VISUALS_GL_PROGRAMCACHE_H_INCLUDED)
+#define VISUALS_GL_PROGRAMCACHE_H_INCLUDED
+
+#include "Visuals/Gl/ServiceGl.h"
+
+/// @brief Start the program binary cache.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param directory A pointer to the path of the cache directory, the empty string to select the default cache directory, or a null pointer to disable the cache.
+/// @remarks The default cache directory is "zeitgeist/programs" in the user's cache directory
+/// i.e., "$XDG_CACHE_HOME" or "$HOME/.cache" under Linux and "%LOCALAPPDATA%" under Windows.
+/// The cache is disabled if the driver does not support program binaries or if the cache directory can not be created.
+/// The cache files are keyed by a hash of the program sources and of the vendor, renderer, and version strings of the driver.
+void
+Visuals_Gl_ProgramCache_startup
+  (
+    Shizu_State2* state,
+    char const* directory
+  );
+
+/// @brief Shut down the program binary cache.
+/// @param state A pointer to a Shizu_State2 value.
+void
+Visuals_Gl_ProgramCache_shutdown
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Create a program from the binary cached for the specified sources.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param vertexSource, fragmentSource Pointers to the zero-terminated sources of the vertex and the fragment program.
+/// @return The ID of the linked program. @a 0 if no binary is cached for the sources or if the driver rejected the binary.
+GLuint
+Visuals_Gl_ProgramCache_load
+  (
+    Shizu_State2* state,
+    char const* vertexSource,
+    char const* fragmentSource
+  );
+
+/// @brief Store the binary of a program linked from the specified sources in the cache.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param vertexSource, fragmentSource Pointers to the zero-terminated sources of the vertex and the fragment program.
+/// @param programId The ID of the linked program.
+/// @remarks Failures to store the binary are not errors. The program is compiled again at the next start.
+void
+Visuals_Gl_ProgramCache_store
+  (
+    Shizu_State2* state,
+    char const* vertexSource,
+    char const* fragmentSource,
+    GLuint programId
+  );
+
+#endif // VISUALS_GL_PROGRAMCACHE_H_INCLUDED
@@ -21,6 +21,52 @@
 
 #include "Visuals/Gl/RenderBuffer.h"
 
+#include "Visuals/Gl/FramesInFlight.h"
+
+// realloc, free
+#include <malloc.h>
+
+// memmove
+#include <string.h>
+
+/// @brief A readback in flight.
+typedef struct PendingReadback {
+  /// @brief The ticket. Locked while the readback is in flight.
+  Visuals_ReadbackTicket* ticket;
+  /// @brief The pixel pack buffer the pixels are copied to.
+  GLuint pixelBufferId;
+  /// @brief The size, in Bytes, of the pixel pack buffer.
+  GLsizeiptr pixelBufferSize;
+  /// @brief The fence signaled when the copy to the pixel pack buffer has completed.
+  GLsync fence;
+} PendingReadback;
+
+/// @brief A pixel pack buffer not in use.
+typedef struct FreePixelBuffer {
+  GLuint id;
+  GLsizeiptr size;
+} FreePixelBuffer;
+
+/// @brief The maximal number of unused pixel pack buffers kept for reuse.
+/// The readbacks requested in a frame are completed when the resource set of that frame is reused.
+/// Hence one pixel pack buffer per frame in flight suffices for one readback per frame.
+#define MaximalNumberOfFreePixelBuffers (Visuals_Gl_FramesInFlight_MaximalNumberOfFrames)
+
+static struct {
+  /// @brief The readbacks in flight in the order of their requests.
+  PendingReadback* elements;
+  size_t size;
+  size_t capacity;
+  /// @brief The unused pixel pack buffers.
+  FreePixelBuffer freePixelBuffers[MaximalNumberOfFreePixelBuffers];
+  size_t numberOfFreePixelBuffers;
+} g_readbacks = {
+  .elements = NULL,
+  .size = 0,
+  .capacity = 0,
+  .numberOfFreePixelBuffers = 0,
+};
+
 static void
 Visuals_Gl_RenderBuffer_dispatchInitialize
   (
@@ -58,6 +104,14 @@ Visuals_Gl_RenderBuffer_resizeImpl
     Shizu_Integer32 height
   );
 
+static void
+Visuals_Gl_RenderBuffer_requestReadbackImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_RenderBuffer* self,
+    Visuals_ReadbackTicket* ticket
+  );
+
 static void
 Visuals_Gl_RenderBuffer_constructImpl
   (
@@ -92,6 +146,7 @@ Visuals_Gl_RenderBuffer_dispatchInitialize
   ((Visuals_Object_Dispatch*)self)->materialize = (void(*)(Shizu_State2*,Visuals_Object*)) & Visuals_Gl_RenderBuffer_materializeImpl;
   ((Visuals_Object_Dispatch*)self)->unmaterialize = (void(*)(Shizu_State2*,Visuals_Object*)) & Visuals_Gl_RenderBuffer_unmaterializeImpl;
   ((Visuals_RenderBuffer_Dispatch*)self)->resize = (void(*)(Shizu_State2*,Visuals_RenderBuffer*,Shizu_Integer32,Shizu_Integer32)) & Visuals_Gl_RenderBuffer_resizeImpl;
+  ((Visuals_RenderBuffer_Dispatch*)self)->requestReadback = (void(*)(Shizu_State2*,Visuals_RenderBuffer*,Visuals_ReadbackTicket*)) & Visuals_Gl_RenderBuffer_requestReadbackImpl;
 }
 
 static void
@@ -101,9 +156,11 @@ Visuals_Gl_RenderBuffer_finalize
     Visuals_Gl_RenderBuffer* self
   )
 {
+  Visuals_Gl_Service_statistics.numberOfLiveRenderBuffers--;
   // Destroy the framebuffer.
   if (self->frameBufferId) {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, Visuals_Gl_Service_getDefaultFrameBufferId(state));
+    Visuals_Gl_Service_statistics.numberOfFrameBufferBinds++;
     glDeleteFramebuffers(1, &self->frameBufferId);
     self->frameBufferId = 0;
   }
@@ -176,9 +233,11 @@ Visuals_Gl_RenderBuffer_materializeImpl
       Shizu_State2_jump(state);
     }
     glBindFramebuffer(GL_FRAMEBUFFER, self->frameBufferId);
+    Visuals_Gl_Service_statistics.numberOfFrameBufferBinds++;
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, self->colorTextureId, 0);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, self->depthStencilTextureId, 0);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, Visuals_Gl_Service_getDefaultFrameBufferId(state));
+    Visuals_Gl_Service_statistics.numberOfFrameBufferBinds++;
     if (glGetError()) {
       glDeleteFramebuffers(1, &self->frameBufferId);
       self->frameBufferId = 0;
@@ -197,7 +256,8 @@ Visuals_Gl_RenderBuffer_unmaterializeImpl
 {
   // Destroy the framebuffer.
   if (self->frameBufferId) {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, Visuals_Gl_Service_getDefaultFrameBufferId(state));
+    Visuals_Gl_Service_statistics.numberOfFrameBufferBinds++;
     glDeleteFramebuffers(1, &self->frameBufferId);
     self->frameBufferId = 0;
   }
@@ -230,6 +290,192 @@ Visuals_Gl_RenderBuffer_resizeImpl
   }
 }
 
+// Get a pixel pack buffer of at least the specified size.
+// The buffer is bound to GL_PIXEL_PACK_BUFFER.
+static GLuint
+acquirePixelBuffer
+  (
+    Shizu_State2* state,
+    GLsizeiptr size,
+    GLsizeiptr* actualSize
+  )
+{
+  for (size_t i = 0; i < g_readbacks.numberOfFreePixelBuffers; ++i) {
+    if (g_readbacks.freePixelBuffers[i].size >= size) {
+      FreePixelBuffer freePixelBuffer = g_readbacks.freePixelBuffers[i];
+      g_readbacks.freePixelBuffers[i] = g_readbacks.freePixelBuffers[--g_readbacks.numberOfFreePixelBuffers];
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, freePixelBuffer.id);
+      *actualSize = freePixelBuffer.size;
+      return freePixelBuffer.id;
+    }
+  }
+  GLuint id = 0;
+  glGenBuffers(1, &id);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, id);
+  glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+  if (glGetError()) {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glDeleteBuffers(1, &id);
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+  *actualSize = size;
+  return id;
+}
+
+// Keep a pixel pack buffer for reuse or delete it.
+static void
+releasePixelBuffer
+  (
+    GLuint id,
+    GLsizeiptr size
+  )
+{
+  if (g_readbacks.numberOfFreePixelBuffers < MaximalNumberOfFreePixelBuffers) {
+    g_readbacks.freePixelBuffers[g_readbacks.numberOfFreePixelBuffers].id = id;
+    g_readbacks.freePixelBuffers[g_readbacks.numberOfFreePixelBuffers].size = size;
+    g_readbacks.numberOfFreePixelBuffers++;
+  } else {
+    glDeleteBuffers(1, &id);
+  }
+}
+
+static void
+Visuals_Gl_RenderBuffer_requestReadbackImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_RenderBuffer* self,
+    Visuals_ReadbackTicket* ticket
+  )
+{
+  Visuals_ReadbackTicket_begin(state, ticket, self->width, self->height);
+  if (!self->frameBufferId) {
+    Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+    Shizu_State2_jump(state);
+  }
+  if (g_readbacks.size == g_readbacks.capacity) {
+    size_t newCapacity = g_readbacks.capacity ? 2 * g_readbacks.capacity : 4;
+    PendingReadback* newElements = realloc(g_readbacks.elements, newCapacity * sizeof(PendingReadback));
+    if (!newElements) {
+      Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State2_jump(state);
+    }
+    g_readbacks.elements = newElements;
+    g_readbacks.capacity = newCapacity;
+  }
+  GLsizeiptr size = (GLsizeiptr)self->width * (GLsizeiptr)self->height * 4;
+  GLsizeiptr pixelBufferSize;
+  GLuint pixelBufferId = acquirePixelBuffer(state, size > 0 ? size : 4, &pixelBufferSize);
+  // The pixels are copied into the pixel pack buffer by the GPU.
+  // glReadPixels returns without waiting for the rendering to finish.
+  GLint readFrameBufferId = 0;
+  glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFrameBufferId);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, self->frameBufferId);
+  Visuals_Gl_Service_statistics.numberOfFrameBufferBinds++;
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, 0, self->width, self->height, GL_RGBA, GL_UNSIGNED_BYTE, (void*)0);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)readFrameBufferId);
+  Visuals_Gl_Service_statistics.numberOfFrameBufferBinds++;
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  if (glGetError() || !fence) {
+    if (fence) {
+      glDeleteSync(fence);
+    }
+    releasePixelBuffer(pixelBufferId, pixelBufferSize);
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)ticket);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    glDeleteSync(fence);
+    releasePixelBuffer(pixelBufferId, pixelBufferSize);
+    Shizu_State2_jump(state);
+  }
+  PendingReadback* pendingReadback = &g_readbacks.elements[g_readbacks.size++];
+  pendingReadback->ticket = ticket;
+  pendingReadback->pixelBufferId = pixelBufferId;
+  pendingReadback->pixelBufferSize = pixelBufferSize;
+  pendingReadback->fence = fence;
+}
+
+void
+Visuals_Gl_RenderBuffer_updateReadbacks
+  (
+    Shizu_State2* state,
+    Shizu_Boolean wait
+  )
+{
+  // The fences are signaled in the order of their creation.
+  // Hence the readbacks are completed in the order of their requests.
+  while (g_readbacks.size) {
+    PendingReadback pendingReadback = g_readbacks.elements[0];
+    GLenum result = glClientWaitSync(pendingReadback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? GL_TIMEOUT_IGNORED : 0);
+    if (GL_TIMEOUT_EXPIRED == result) {
+      break;
+    }
+    // Remove the readback before the callback of the ticket is invoked.
+    memmove(g_readbacks.elements, g_readbacks.elements + 1, (g_readbacks.size - 1) * sizeof(PendingReadback));
+    g_readbacks.size--;
+    glDeleteSync(pendingReadback.fence);
+    Visuals_ReadbackTicket* ticket = pendingReadback.ticket;
+    void const* pixels = NULL;
+    if (GL_WAIT_FAILED != result) {
+      GLsizeiptr size = (GLsizeiptr)ticket->width * (GLsizeiptr)ticket->height * 4;
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, pendingReadback.pixelBufferId);
+      pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size > 0 ? size : 4, GL_MAP_READ_BIT);
+    }
+    Shizu_JumpTarget jumpTarget;
+    Shizu_State2_pushJumpTarget(state, &jumpTarget);
+    if (!setjmp(jumpTarget.environment)) {
+      if (pixels) {
+        Visuals_ReadbackTicket_fulfill(state, ticket, pixels);
+      } else {
+        Visuals_ReadbackTicket_fail(state, ticket);
+      }
+      Shizu_State2_popJumpTarget(state);
+    } else {
+      Shizu_State2_popJumpTarget(state);
+      if (pixels) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pendingReadback.pixelBufferId);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+      }
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+      releasePixelBuffer(pendingReadback.pixelBufferId, pendingReadback.pixelBufferSize);
+      Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)ticket);
+      Shizu_State2_jump(state);
+    }
+    if (pixels) {
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, pendingReadback.pixelBufferId);
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    releasePixelBuffer(pendingReadback.pixelBufferId, pendingReadback.pixelBufferSize);
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)ticket);
+  }
+}
+
+void
+Visuals_Gl_RenderBuffer_shutdownReadbacks
+  (
+    Shizu_State2* state
+  )
+{
+  Visuals_Gl_RenderBuffer_updateReadbacks(state, Shizu_Boolean_True);
+  for (size_t i = 0; i < g_readbacks.numberOfFreePixelBuffers; ++i) {
+    glDeleteBuffers(1, &g_readbacks.freePixelBuffers[i].id);
+  }
+  g_readbacks.numberOfFreePixelBuffers = 0;
+  free(g_readbacks.elements);
+  g_readbacks.elements = NULL;
+  g_readbacks.capacity = 0;
+}
+
 static void
 Visuals_Gl_RenderBuffer_constructImpl
   (
@@ -257,6 +503,7 @@ Visuals_Gl_RenderBuffer_constructImpl
   SELF->colorTextureId = 0;
   SELF->depthStencilTextureId = 0;
   ((Shizu_Object*)SELF)->type = TYPE;
+  Visuals_Gl_Service_statistics.numberOfLiveRenderBuffers++;
 }
 
 Visuals_Gl_RenderBuffer*
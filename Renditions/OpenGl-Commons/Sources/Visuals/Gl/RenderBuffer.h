@@ -57,4 +57,24 @@ Visuals_Gl_RenderBuffer_create
     Shizu_State2* state
   );
 
+/// @brief Fulfill the pending readback tickets of which the pixels are available.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param wait If @a true, wait for the pixels of all pending tickets.
+/// @remarks Invoked by the GL service once per frame.
+void
+Visuals_Gl_RenderBuffer_updateReadbacks
+  (
+    Shizu_State2* state,
+    Shizu_Boolean wait
+  );
+
+/// @brief Fulfill all pending readback tickets and release the pixel pack buffers.
+/// @param state A pointer to a Shizu_State2 value.
+/// @remarks Invoked by the GL service on shutdown.
+void
+Visuals_Gl_RenderBuffer_shutdownReadbacks
+  (
+    Shizu_State2* state
+  );
+
 #endif // VISUALS_GL_RENDERBUFFER_H_INCLUDED
@@ -22,6 +22,18 @@
 
 #include "ServiceGl.h"
 
+#include "Visuals/DefaultPrograms.h"
+#include "Visuals/DynamicResolution.h"
+#include "Visuals/VertexBuffer.h"
+#include "Visuals/Gl/FramesInFlight.h"
+#include "Visuals/Gl/GpuTimings.h"
+#include "Visuals/Gl/Program.h"
+#include "Visuals/Gl/ProgramCache.h"
+#include "Visuals/Gl/Sharpen.h"
+#include "Visuals/Gl/Texture.h"
+#include "Visuals/Gl/RenderBuffer.h"
+#include "Visuals/Software/Context.h"
+
 // malloc, free
 #include <malloc.h>
 
@@ -34,6 +46,9 @@
 // strlen
 #include <string.h>
 
+// timespec_get
+#include <time.h>
+
 #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
   #include "Visuals/Gl/Wgl/Service.h"
   #define WIN32_LEAN_AND_MEAN
@@ -41,6 +56,9 @@
   #include <GL/gl.h>
 #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
   #include "Visuals/Gl/Glx/Service.h"
+  #if defined(Visuals_Gl_WithEgl)
+    #include "Visuals/Gl/Egl/Service.h"
+  #endif
   #include <GL/gl.h>
 #else
   #error("operating system not (yet) supported")
@@ -50,12 +68,89 @@
 
 #define Define(Type, Name) \
   Type Name = NULL;
+#define DefineOptional(Type, Name, Extension) \
+  Type Name = NULL;
 #include "ServiceGl_Functions.i"
+#undef DefineOptional
 #undef Define
 
+Visuals_FrameStatistics Visuals_Gl_Service_statistics = { 0 };
+
+/// The backends.
+typedef enum Visuals_Gl_Backend {
+  /// WGL under Windows, GLX under Linux.
+  Visuals_Gl_Backend_Default,
+  /// Headless EGL rendering into an offscreen frame buffer.
+  Visuals_Gl_Backend_EglHeadless,
+} Visuals_Gl_Backend;
+
+/// The synchronizations of the buffer swaps with the vertical blank.
+typedef enum Visuals_Gl_VerticalSync {
+  /// The swap interval is not changed.
+  Visuals_Gl_VerticalSync_Default,
+  /// Swap immediately.
+  Visuals_Gl_VerticalSync_Off,
+  /// Swap at the next vertical blank.
+  Visuals_Gl_VerticalSync_On,
+  /// Swap at the next vertical blank unless the frame is late, swap immediately otherwise.
+  Visuals_Gl_VerticalSync_Adaptive,
+} Visuals_Gl_VerticalSync;
+
+/// The renderers.
+typedef enum Visuals_Gl_Renderer {
+  /// Rendering by OpenGL.
+  Visuals_Gl_Renderer_Gl,
+  /// Rendering by the software rasterizer. OpenGL is only used to present the frames.
+  Visuals_Gl_Renderer_Software,
+} Visuals_Gl_Renderer;
+
 typedef struct Visuals_Gl_Service {
   /// The reference count.
   Shizu_Integer32 referenceCount;
+  /// The backend selected at startup.
+  Visuals_Gl_Backend backend;
+  /// The renderer selected at startup.
+  Visuals_Gl_Renderer renderer;
+  /// The vertical synchronization selected at startup.
+  Visuals_Gl_VerticalSync verticalSync;
+  /// The texture the default frame buffer of the software renderer is uploaded to for presentation.
+  /// @a 0 if not created yet.
+  GLuint presentTextureId;
+  /// The frame buffer the present texture is attached to.
+  /// @a 0 if not created yet.
+  GLuint presentFrameBufferId;
+  /// The width and the height of the present texture.
+  Shizu_Integer32 presentWidth, presentHeight;
+  /// Whether the GPU timings are written to the standard output.
+  Shizu_Boolean traceGpu;
+  /// The directory of the program binary cache.
+  /// The empty string selects the default directory, a null pointer disables the cache.
+  char const* programCacheDirectory;
+  /// The statistics of the most recently ended frame.
+  Visuals_FrameStatistics frameStatistics;
+  /// The number of frames over which the frame statistics are averaged before they are written to the standard output.
+  /// @a 0 if the frame statistics are not written to the standard output.
+  Shizu_Integer64 benchmarkFrames;
+  /// The sums of the per-frame counters of the frames since the frame statistics were written to the standard output.
+  Visuals_FrameStatistics benchmarkTotals;
+  /// The number of frames ended since startup.
+  Shizu_Integer64 numberOfFrames;
+  /// The number of frames after which a quit is requested.
+  /// @a 0 if no quit is requested.
+  Shizu_Integer64 maximalNumberOfFrames;
+  /// The number of frames the CPU may record ahead of the GPU.
+  size_t numberOfFramesInFlight;
+  /// Whether dynamic resolution is enabled.
+  Shizu_Boolean dynamicResolutionEnabled;
+  /// The dynamic resolution controller. Initialized if dynamic resolution is enabled.
+  Visuals_DynamicResolution dynamicResolution;
+  /// The filter with which the images rendered at a lower resolution are scaled to the client area.
+  Visuals_BlitFilter upscaleFilter;
+  /// The size, in pixels, of the canvas of the headless backend.
+  /// The offscreen frame buffer is resized to this size when a frame begins.
+  Shizu_Integer32 canvasWidth, canvasHeight;
+  /// The time at which the frame in progress began.
+  struct timespec frameBegin;
   /// List of weak references to Visuals.Object values.
   /// Used to notify the Visuals.Object values to release their resources before this service shuts down.
   Shizu_List* objects;
@@ -63,9 +158,390 @@ typedef struct Visuals_Gl_Service {
 
 static Visuals_Gl_Service g_service = {
     .referenceCount = 0,
+    .backend = Visuals_Gl_Backend_Default,
+    .renderer = Visuals_Gl_Renderer_Gl,
+    .verticalSync = Visuals_Gl_VerticalSync_Default,
+    .presentTextureId = 0,
+    .presentFrameBufferId = 0,
+    .presentWidth = 0,
+    .presentHeight = 0,
+    .traceGpu = Shizu_Boolean_False,
+    .programCacheDirectory = "",
+    .frameStatistics = { 0 },
+    .benchmarkFrames = 0,
+    .benchmarkTotals = { 0 },
+    .numberOfFrames = 0,
+    .maximalNumberOfFrames = 0,
+    .numberOfFramesInFlight = Visuals_Gl_FramesInFlight_DefaultNumberOfFrames,
+    .dynamicResolutionEnabled = Shizu_Boolean_False,
+    .upscaleFilter = Visuals_BlitFilter_Linear,
+    .canvasWidth = Visuals_Gl_Service_DefaultCanvasWidth,
+    .canvasHeight = Visuals_Gl_Service_DefaultCanvasHeight,
     .objects = NULL,
   };
 
+// Select the backend, the renderer, the vertical synchronization, the frame limit, the number of frames in flight, the trace output, the benchmark output, the program cache directory, the dynamic resolution, the upscale filter, and the canvas size.
+// The interpreter forwards "--visuals-backend=<name>", "--visuals-renderer=<name>", "--vsync=<mode>", "--visuals-frames=<number>", "--visuals-frames-in-flight=<number>", "--visuals-trace=<categories>", "--visuals-benchmark=<number>",
+// "--visuals-program-cache=<directory>", "--visuals-dynamic-resolution=<fps>[,<min>[,<max>]]", "--visuals-upscale=<filter>", and "--visuals-canvas-size=<width>x<height>"
+// in the environment variables "ZEITGEIST_VISUALS_BACKEND", "ZEITGEIST_VISUALS_RENDERER", "ZEITGEIST_VISUALS_VSYNC", "ZEITGEIST_VISUALS_FRAMES", "ZEITGEIST_VISUALS_FRAMES_IN_FLIGHT", "ZEITGEIST_VISUALS_TRACE", "ZEITGEIST_VISUALS_BENCHMARK",
+// "ZEITGEIST_VISUALS_PROGRAM_CACHE", "ZEITGEIST_VISUALS_DYNAMIC_RESOLUTION", "ZEITGEIST_VISUALS_UPSCALE", and "ZEITGEIST_VISUALS_CANVAS_SIZE", respectively.
+static void
+configure
+  (
+    Shizu_State2* state
+  )
+{
+  char const* backend = getenv("ZEITGEIST_VISUALS_BACKEND");
+  if (!backend || !strcmp(backend, "") || !strcmp(backend, "default")) {
+    g_service.backend = Visuals_Gl_Backend_Default;
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  } else if (!strcmp(backend, "wgl")) {
+    g_service.backend = Visuals_Gl_Backend_Default;
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  } else if (!strcmp(backend, "glx")) {
+    g_service.backend = Visuals_Gl_Backend_Default;
+  #if defined(Visuals_Gl_WithEgl)
+  } else if (!strcmp(backend, "egl-headless")) {
+    g_service.backend = Visuals_Gl_Backend_EglHeadless;
+  #endif
+#endif
+  } else {
+    fprintf(stderr, "%s:%d: visuals backend `%s` not supported\n", __FILE__, __LINE__, backend);
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  char const* renderer = getenv("ZEITGEIST_VISUALS_RENDERER");
+  if (!renderer || !strcmp(renderer, "") || !strcmp(renderer, "gl")) {
+    g_service.renderer = Visuals_Gl_Renderer_Gl;
+  } else if (!strcmp(renderer, "software")) {
+    g_service.renderer = Visuals_Gl_Renderer_Software;
+  } else {
+    fprintf(stderr, "%s:%d: visuals renderer `%s` not supported\n", __FILE__, __LINE__, renderer);
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  char const* verticalSync = getenv("ZEITGEIST_VISUALS_VSYNC");
+  if (!verticalSync || !strcmp(verticalSync, "") || !strcmp(verticalSync, "default")) {
+    g_service.verticalSync = Visuals_Gl_VerticalSync_Default;
+  } else if (!strcmp(verticalSync, "off")) {
+    g_service.verticalSync = Visuals_Gl_VerticalSync_Off;
+  } else if (!strcmp(verticalSync, "on")) {
+    g_service.verticalSync = Visuals_Gl_VerticalSync_On;
+  } else if (!strcmp(verticalSync, "adaptive")) {
+    g_service.verticalSync = Visuals_Gl_VerticalSync_Adaptive;
+  } else {
+    fprintf(stderr, "%s:%d: vertical synchronization `%s` not supported\n", __FILE__, __LINE__, verticalSync);
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  char const* frames = getenv("ZEITGEIST_VISUALS_FRAMES");
+  g_service.maximalNumberOfFrames = 0;
+  if (frames && strcmp(frames, "")) {
+    char* end = NULL;
+    long long v = strtoll(frames, &end, 10);
+    if (*end != '\0' || v < 0) {
+      fprintf(stderr, "%s:%d: number of frames `%s` invalid\n", __FILE__, __LINE__, frames);
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    }
+    g_service.maximalNumberOfFrames = v;
+  }
+  char const* framesInFlight = getenv("ZEITGEIST_VISUALS_FRAMES_IN_FLIGHT");
+  g_service.numberOfFramesInFlight = Visuals_Gl_FramesInFlight_DefaultNumberOfFrames;
+  if (framesInFlight && strcmp(framesInFlight, "")) {
+    char* end = NULL;
+    long long v = strtoll(framesInFlight, &end, 10);
+    if (*end != '\0' || v < 1 || v > Visuals_Gl_FramesInFlight_MaximalNumberOfFrames) {
+      fprintf(stderr, "%s:%d: number of frames in flight `%s` invalid\n", __FILE__, __LINE__, framesInFlight);
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    }
+    g_service.numberOfFramesInFlight = (size_t)v;
+  }
+  // A comma-separated list of categories. The only category currently is "gpu".
+  char const* trace = getenv("ZEITGEIST_VISUALS_TRACE");
+  g_service.traceGpu = Shizu_Boolean_False;
+  if (trace && strcmp(trace, "")) {
+    char const* p = trace;
+    while (true) {
+      char const* q = strchr(p, ',');
+      size_t n = q ? (size_t)(q - p) : strlen(p);
+      if (n == strlen("gpu") && !strncmp(p, "gpu", n)) {
+        g_service.traceGpu = Shizu_Boolean_True;
+      } else {
+        fprintf(stderr, "%s:%d: trace category `%.*s` not supported\n", __FILE__, __LINE__, (int)n, p);
+        Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+        Shizu_State2_jump(state);
+      }
+      if (!q) {
+        break;
+      }
+      p = q + 1;
+    }
+  }
+  char const* benchmark = getenv("ZEITGEIST_VISUALS_BENCHMARK");
+  g_service.benchmarkFrames = 0;
+  if (benchmark && strcmp(benchmark, "")) {
+    char* end = NULL;
+    long long v = strtoll(benchmark, &end, 10);
+    if (*end != '\0' || v < 0) {
+      fprintf(stderr, "%s:%d: number of benchmark frames `%s` invalid\n", __FILE__, __LINE__, benchmark);
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    }
+    g_service.benchmarkFrames = v;
+  }
+  // "off" disables the program cache.
+  char const* programCache = getenv("ZEITGEIST_VISUALS_PROGRAM_CACHE");
+  if (!programCache) {
+    g_service.programCacheDirectory = "";
+  } else if (!strcmp(programCache, "off")) {
+    g_service.programCacheDirectory = NULL;
+  } else {
+    g_service.programCacheDirectory = programCache;
+  }
+  // "<target frames per second>[,<minimal scale>[,<maximal scale>]]" enables dynamic resolution.
+  char const* dynamicResolution = getenv("ZEITGEIST_VISUALS_DYNAMIC_RESOLUTION");
+  g_service.dynamicResolutionEnabled = Shizu_Boolean_False;
+  if (dynamicResolution && strcmp(dynamicResolution, "")) {
+    Shizu_Float32 values[3] = { 0.f, 0.5f, 1.f };
+    size_t numberOfValues = 0;
+    char const* p = dynamicResolution;
+    while (true) {
+      char* end = NULL;
+      Shizu_Float32 v = numberOfValues < 3 ? strtof(p, &end) : 0.f;
+      if (numberOfValues == 3 || end == p || (*end != ',' && *end != '\0')) {
+        fprintf(stderr, "%s:%d: dynamic resolution `%s` invalid\n", __FILE__, __LINE__, dynamicResolution);
+        Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+        Shizu_State2_jump(state);
+      }
+      values[numberOfValues++] = v;
+      if (*end == '\0') {
+        break;
+      }
+      p = end + 1;
+    }
+    if (!(values[0] > 0.f) || !(values[1] > 0.f) || !(values[1] <= values[2])) {
+      fprintf(stderr, "%s:%d: dynamic resolution `%s` invalid\n", __FILE__, __LINE__, dynamicResolution);
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    }
+    Visuals_DynamicResolution_initialize(state, &g_service.dynamicResolution, values[0], values[1], values[2]);
+    g_service.dynamicResolutionEnabled = Shizu_Boolean_True;
+  }
+  char const* upscale = getenv("ZEITGEIST_VISUALS_UPSCALE");
+  g_service.upscaleFilter = Visuals_BlitFilter_Linear;
+  if (upscale && strcmp(upscale, "")) {
+    if (!strcmp(upscale, "nearest")) {
+      g_service.upscaleFilter = Visuals_BlitFilter_Nearest;
+    } else if (!strcmp(upscale, "linear")) {
+      g_service.upscaleFilter = Visuals_BlitFilter_Linear;
+    } else if (!strcmp(upscale, "sharpen")) {
+      g_service.upscaleFilter = Visuals_BlitFilter_Sharpen;
+    } else {
+      fprintf(stderr, "%s:%d: upscale filter `%s` not supported\n", __FILE__, __LINE__, upscale);
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    }
+  }
+  // "<width>x<height>" selects the size of the canvas of the headless backend.
+  char const* canvasSize = getenv("ZEITGEIST_VISUALS_CANVAS_SIZE");
+  g_service.canvasWidth = Visuals_Gl_Service_DefaultCanvasWidth;
+  g_service.canvasHeight = Visuals_Gl_Service_DefaultCanvasHeight;
+  if (canvasSize && strcmp(canvasSize, "")) {
+    char* end = NULL;
+    long width = strtol(canvasSize, &end, 10);
+    long height = 0;
+    if (*end == 'x') {
+      char const* p = end + 1;
+      height = strtol(p, &end, 10);
+      if (end == p) {
+        height = 0;
+      }
+    }
+    if (*end != '\0' || width < 1 || height < 1 || width > Visuals_Gl_Service_MaximalCanvasSize || height > Visuals_Gl_Service_MaximalCanvasSize) {
+      fprintf(stderr, "%s:%d: canvas size `%s` invalid\n", __FILE__, __LINE__, canvasSize);
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    }
+    g_service.canvasWidth = (Shizu_Integer32)width;
+    g_service.canvasHeight = (Shizu_Integer32)height;
+  }
+  Visuals_FrameStatistics zero = { 0 };
+  g_service.benchmarkTotals = zero;
+  g_service.frameStatistics = zero;
+  g_service.numberOfFrames = 0;
+}
+
+// Set the swap interval of the window according to the vertical synchronization.
+// The headless backend does not swap buffers.
+static void
+applyVerticalSync
+  (
+    Shizu_State2* state
+  )
+{
+  if (Visuals_Gl_VerticalSync_Default == g_service.verticalSync || Visuals_Gl_Backend_Default != g_service.backend) {
+    return;
+  }
+  Shizu_Integer32 interval = 0;
+  switch (g_service.verticalSync) {
+    case Visuals_Gl_VerticalSync_Off: {
+      interval = 0;
+    } break;
+    case Visuals_Gl_VerticalSync_On: {
+      interval = 1;
+    } break;
+    case Visuals_Gl_VerticalSync_Adaptive: {
+      interval = -1;
+    } break;
+    default: {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    } break;
+  };
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  Shizu_Boolean result = Visuals_Gl_Wgl_Service_setSwapInterval(state, interval);
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  Shizu_Boolean result = Visuals_Gl_Glx_Service_setSwapInterval(state, interval);
+#else
+  #error("operating system not (yet) supported")
+#endif
+  // Not an error: the frame limiter of the interpreter can still pace the frames.
+  if (!result) {
+    fprintf(stderr, "%s:%d: unable to set the swap interval\n", __FILE__, __LINE__);
+  }
+}
+
+// Adjust the resolution scale to the time spent on the frame which ends.
+static void
+updateResolutionScale
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Float32 scale = g_service.dynamicResolutionEnabled ? g_service.dynamicResolution.scale : 1.f;
+  Visuals_Gl_Service_statistics.resolutionScale = scale;
+  if (!g_service.dynamicResolutionEnabled) {
+    return;
+  }
+  // Prefer the GPU time of the whole frame. It lags behind by a few frames.
+  Shizu_Float32 milliseconds = 0.f;
+  Visuals_GpuTiming timing;
+  if (Visuals_Gl_Renderer_Gl == g_service.renderer && Visuals_Gl_GpuTimings_get(state, &timing, 1) > 0) {
+    milliseconds = timing.milliseconds;
+  } else {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    milliseconds = (Shizu_Float32)((double)(now.tv_sec - g_service.frameBegin.tv_sec) * 1000.0 +
+                                   (double)(now.tv_nsec - g_service.frameBegin.tv_nsec) / 1000000.0);
+  }
+  Visuals_DynamicResolution_update(state, &g_service.dynamicResolution, milliseconds);
+}
+
+// Take the statistics of the frame that ended and reset the per-frame counters.
+// If the benchmark output is enabled, the statistics are accumulated and their averages are written to the standard output every g_service.benchmarkFrames frames.
+static void
+updateFrameStatistics
+  (
+    Shizu_State2* state
+  )
+{
+  Visuals_FrameStatistics* s = &Visuals_Gl_Service_statistics;
+  s->numberOfRetainedVertexBytes = Visuals_VertexBuffer_getNumberOfRetainedBytes(state);
+  g_service.frameStatistics = *s;
+  s->numberOfDrawCalls = 0;
+  s->numberOfVertices = 0;
+  s->numberOfInstances = 0;
+  s->numberOfProgramBinds = 0;
+  s->numberOfVertexArrayBinds = 0;
+  s->numberOfUniformUpdates = 0;
+  s->numberOfDeduplicatedUniformUpdates = 0;
+  s->numberOfBufferBytesUploaded = 0;
+  s->numberOfTextureBytesUploaded = 0;
+  s->numberOfFrameBufferBinds = 0;
+  s->numberOfVisibleObjects = 0;
+  s->numberOfCulledObjects = 0;
+  s->frameFenceWaitMilliseconds = 0.f;
+  if (!g_service.benchmarkFrames) {
+    return;
+  }
+  Visuals_FrameStatistics* f = &g_service.frameStatistics;
+  Visuals_FrameStatistics* t = &g_service.benchmarkTotals;
+  t->numberOfDrawCalls += f->numberOfDrawCalls;
+  t->numberOfVertices += f->numberOfVertices;
+  t->numberOfInstances += f->numberOfInstances;
+  t->numberOfProgramBinds += f->numberOfProgramBinds;
+  t->numberOfVertexArrayBinds += f->numberOfVertexArrayBinds;
+  t->numberOfUniformUpdates += f->numberOfUniformUpdates;
+  t->numberOfDeduplicatedUniformUpdates += f->numberOfDeduplicatedUniformUpdates;
+  t->numberOfBufferBytesUploaded += f->numberOfBufferBytesUploaded;
+  t->numberOfTextureBytesUploaded += f->numberOfTextureBytesUploaded;
+  t->numberOfFrameBufferBinds += f->numberOfFrameBufferBinds;
+  t->numberOfVisibleObjects += f->numberOfVisibleObjects;
+  t->numberOfCulledObjects += f->numberOfCulledObjects;
+  t->resolutionScale += f->resolutionScale;
+  t->frameFenceWaitMilliseconds += f->frameFenceWaitMilliseconds;
+  if (g_service.numberOfFrames % g_service.benchmarkFrames) {
+    return;
+  }
+  double n = (double)g_service.benchmarkFrames;
+  fprintf(stdout, "[benchmark] frames %lld-%lld, per frame: draw calls %.1f, vertices %.1f, instances %.1f, program binds %.1f, vertex array binds %.1f, uniform updates %.1f (deduplicated %.1f), buffer bytes %.1f, texture bytes %.1f, frame buffer binds %.1f, visible objects %.1f, culled objects %.1f, resolution scale %.2f, frame fence wait %.3f ms\n",
+          (long long)(g_service.numberOfFrames - g_service.benchmarkFrames + 1), (long long)g_service.numberOfFrames,
+          t->numberOfDrawCalls / n, t->numberOfVertices / n, t->numberOfInstances / n,
+          t->numberOfProgramBinds / n, t->numberOfVertexArrayBinds / n,
+          t->numberOfUniformUpdates / n, t->numberOfDeduplicatedUniformUpdates / n,
+          t->numberOfBufferBytesUploaded / n, t->numberOfTextureBytesUploaded / n,
+          t->numberOfFrameBufferBinds / n, t->numberOfVisibleObjects / n, t->numberOfCulledObjects / n, t->resolutionScale / n, t->frameFenceWaitMilliseconds / n);
+  fprintf(stdout, "[benchmark] live objects: contexts %zu, programs %zu, vertex buffers %zu, index buffers %zu, uniform buffers %zu, textures %zu, render buffers %zu, retained vertex bytes %zu\n",
+          f->numberOfLiveContexts, f->numberOfLivePrograms, f->numberOfLiveVertexBuffers, f->numberOfLiveIndexBuffers,
+          f->numberOfLiveUniformBuffers, f->numberOfLiveTextures, f->numberOfLiveRenderBuffers, f->numberOfRetainedVertexBytes);
+  Visuals_FrameStatistics zero = { 0 };
+  *t = zero;
+}
+
+// Copy the default frame buffer of the software renderer to the default frame buffer.
+static void
+present
+  (
+    Shizu_State2* state
+  )
+{
+  Visuals_Software_FrameBuffer* frameBuffer = Visuals_Software_Context_getDefaultFrameBuffer(state);
+  if (!frameBuffer->colors) {
+    return;
+  }
+  if (!g_service.presentTextureId) {
+    glGenTextures(1, &g_service.presentTextureId);
+    glBindTexture(GL_TEXTURE_2D, g_service.presentTextureId);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    g_service.presentWidth = 0;
+    g_service.presentHeight = 0;
+  }
+  if (!g_service.presentFrameBufferId) {
+    glGenFramebuffers(1, &g_service.presentFrameBufferId);
+  }
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glBindTexture(GL_TEXTURE_2D, g_service.presentTextureId);
+  if (g_service.presentWidth != frameBuffer->width || g_service.presentHeight != frameBuffer->height) {
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, frameBuffer->width, frameBuffer->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, frameBuffer->colors);
+    g_service.presentWidth = frameBuffer->width;
+    g_service.presentHeight = frameBuffer->height;
+    glBindFramebuffer(GL_FRAMEBUFFER, g_service.presentFrameBufferId);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, g_service.presentTextureId, 0);
+  } else {
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, frameBuffer->width, frameBuffer->height, GL_RGBA, GL_UNSIGNED_BYTE, frameBuffer->colors);
+  }
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, g_service.presentFrameBufferId);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, Visuals_Gl_Service_getDefaultFrameBufferId(state));
+  glDisable(GL_SCISSOR_TEST);
+  glBlitFramebuffer(0, 0, frameBuffer->width, frameBuffer->height, 0, 0, frameBuffer->width, frameBuffer->height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+  glBindFramebuffer(GL_FRAMEBUFFER, Visuals_Gl_Service_getDefaultFrameBufferId(state));
+}
+
 static void*
 link
   (
@@ -77,30 +553,158 @@ link
 #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
   return Visuals_Gl_Wgl_Service_link(state, functionName, extensionName);
 #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  #if defined(Visuals_Gl_WithEgl)
+  if (Visuals_Gl_Backend_EglHeadless == g_service.backend) {
+    return Visuals_Gl_Egl_Service_link(state, functionName, extensionName);
+  }
+  #endif
   return Visuals_Gl_Glx_Service_link(state, functionName, extensionName);
 #else
   #error("operating system not (yet) supported")
 #endif
 }
 
-void
-Visuals_Gl_Service_startup
+// Start up the window system backend selected at startup.
+static void
+startupBackend
   (
     Shizu_State2* state
   )
 {
-  if (g_service.referenceCount == 0) {
-  #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
-    Visuals_Gl_Wgl_Service_startup(state);
-  #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  Visuals_Gl_Wgl_Service_startup(state);
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  #if defined(Visuals_Gl_WithEgl)
+  if (Visuals_Gl_Backend_EglHeadless == g_service.backend) {
+    Visuals_Gl_Egl_Service_startup(state);
+  } else {
     Visuals_Gl_Glx_Service_startup(state);
+  }
   #else
-    #error("operating system not (yet) supported")
+  Visuals_Gl_Glx_Service_startup(state);
   #endif
-  #define Define(Type, Name) \
-    Name = (Type)link(state, #Name, NULL);
-  #include "ServiceGl_Functions.i"
-  #undef Define
+#else
+  #error("operating system not (yet) supported")
+#endif
+}
+
+// Shut down the window system backend selected at startup.
+// The offscreen frame buffer of the headless backend is destroyed if it was created.
+static void
+shutdownBackend
+  (
+    Shizu_State2* state
+  )
+{
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  Visuals_Gl_Wgl_Service_shutdown(state);
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  #if defined(Visuals_Gl_WithEgl)
+  if (Visuals_Gl_Backend_EglHeadless == g_service.backend) {
+    Visuals_Gl_Egl_Service_shutdownFrameBuffer(state);
+    Visuals_Gl_Egl_Service_shutdown(state);
+  } else {
+    Visuals_Gl_Glx_Service_shutdown(state);
+  }
+  #else
+  Visuals_Gl_Glx_Service_shutdown(state);
+  #endif
+#else
+  #error("operating system not (yet) supported")
+#endif
+}
+
+// Start up the frames in flight, the GPU timings, and the program binary cache of the OpenGL renderer.
+// If a step fails, the steps before are undone.
+static void
+startupRenderer
+  (
+    Shizu_State2* state
+  )
+{
+  Visuals_Gl_FramesInFlight_startup(state, g_service.numberOfFramesInFlight);
+  Shizu_JumpTarget jumpTarget1;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget1);
+  if (!setjmp(jumpTarget1.environment)) {
+    Visuals_Gl_GpuTimings_startup(state, g_service.traceGpu);
+    Shizu_JumpTarget jumpTarget2;
+    Shizu_State2_pushJumpTarget(state, &jumpTarget2);
+    if (!setjmp(jumpTarget2.environment)) {
+      Visuals_Gl_ProgramCache_startup(state, g_service.programCacheDirectory);
+      Shizu_State2_popJumpTarget(state);
+    } else {
+      Shizu_State2_popJumpTarget(state);
+      Visuals_Gl_GpuTimings_shutdown(state);
+      Shizu_State2_jump(state);
+    }
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Visuals_Gl_FramesInFlight_shutdown(state);
+    Shizu_State2_jump(state);
+  }
+  // Let the driver select the number of threads compiling shaders in parallel.
+  if (glMaxShaderCompilerThreadsKHR) {
+    glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+  } else if (glMaxShaderCompilerThreadsARB) {
+    glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+  }
+}
+
+// Shut down the frames in flight, the GPU timings, and the program binary cache of the OpenGL renderer.
+static void
+shutdownRenderer
+  (
+    Shizu_State2* state
+  )
+{
+  Visuals_Gl_GpuTimings_shutdown(state);
+  Visuals_Gl_FramesInFlight_shutdown(state);
+  Visuals_Gl_ProgramCache_shutdown(state);
+}
+
+void
+Visuals_Gl_Service_startup
+  (
+    Shizu_State2* state
+  )
+{
+  if (g_service.referenceCount == 0) {
+    configure(state);
+    startupBackend(state);
+    Shizu_JumpTarget jumpTarget;
+    Shizu_State2_pushJumpTarget(state, &jumpTarget);
+    if (!setjmp(jumpTarget.environment)) {
+    #define Define(Type, Name) \
+      Name = (Type)link(state, #Name, NULL);
+    #define DefineOptional(Type, Name, Extension)
+    #include "ServiceGl_Functions.i"
+    #undef DefineOptional
+    #undef Define
+      // The optional functions are linked after glGetStringi was linked.
+    #define Define(Type, Name)
+    #define DefineOptional(Type, Name, Extension) \
+      Name = Visuals_Gl_Service_isExtensionSupported(state, Extension) ? (Type)link(state, #Name, NULL) : NULL;
+    #include "ServiceGl_Functions.i"
+    #undef DefineOptional
+    #undef Define
+    #if Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem && defined(Visuals_Gl_WithEgl)
+      // The offscreen frame buffer is created after the functions were linked.
+      if (Visuals_Gl_Backend_EglHeadless == g_service.backend) {
+        Visuals_Gl_Egl_Service_startupFrameBuffer(state, g_service.canvasWidth, g_service.canvasHeight);
+      }
+    #endif
+      applyVerticalSync(state);
+      // GPU timings and program binaries are not available for the software renderer.
+      if (Visuals_Gl_Renderer_Gl == g_service.renderer) {
+        startupRenderer(state);
+      }
+      Shizu_State2_popJumpTarget(state);
+    } else {
+      Shizu_State2_popJumpTarget(state);
+      shutdownBackend(state);
+      Shizu_State2_jump(state);
+    }
   }
   g_service.referenceCount++;
 }
@@ -112,17 +716,31 @@ Visuals_Gl_Service_shutdown
   )
 {
   if (0 == --g_service.referenceCount) {
+    // The tasks must be joined before the visuals service shuts down the thread pool.
+    Visuals_Gl_Texture_shutdownPending(state);
+    Visuals_Gl_RenderBuffer_shutdownReadbacks(state);
+    Visuals_releaseProgramPermutations(state);
+    Visuals_Gl_Program_shutdownPending(state);
+    if (Visuals_Gl_Renderer_Gl == g_service.renderer) {
+      shutdownRenderer(state);
+    }
+    Visuals_Gl_Sharpen_shutdown(state);
+    if (Visuals_Gl_Renderer_Software == g_service.renderer) {
+      Visuals_Software_Context_shutdown(state);
+    }
+    if (g_service.presentFrameBufferId) {
+      glDeleteFramebuffers(1, &g_service.presentFrameBufferId);
+      g_service.presentFrameBufferId = 0;
+    }
+    if (g_service.presentTextureId) {
+      glDeleteTextures(1, &g_service.presentTextureId);
+      g_service.presentTextureId = 0;
+    }
     if (g_service.objects) {
       Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_service.objects);
       g_service.objects = NULL;
     }
-  #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
-    Visuals_Gl_Wgl_Service_shutdown(state);
-  #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
-    Visuals_Gl_Glx_Service_shutdown(state);
-  #else
-    #error("operating system not (yet) supported")
-  #endif
+    shutdownBackend(state);
   }
 }
 
@@ -136,6 +754,12 @@ Visuals_Gl_Service_setTitle
 #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
   Visuals_Gl_Wgl_Service_setTitle(state, title);
 #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  #if defined(Visuals_Gl_WithEgl)
+  if (Visuals_Gl_Backend_EglHeadless == g_service.backend) {
+    Visuals_Gl_Egl_Service_setTitle(state, title);
+    return;
+  }
+  #endif
   Visuals_Gl_Glx_Service_setTitle(state, title);
 #else
   #error("operating system not (yet) supported")
@@ -153,21 +777,67 @@ Visuals_Gl_Service_getClientSize
 #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
   Visuals_Gl_Wgl_Service_getClientSize(state, width, height);
 #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  #if defined(Visuals_Gl_WithEgl)
+  if (Visuals_Gl_Backend_EglHeadless == g_service.backend) {
+    Visuals_Gl_Egl_Service_getClientSize(state, width, height);
+    return;
+  }
+  #endif
   Visuals_Gl_Glx_Service_getClientSize(state, width, height);
 #else
   #error("operating system not (yet) supported")
 #endif
 }
 
+void
+Visuals_Gl_Service_setCanvasSize
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  )
+{
+  if (width < 1 || height < 1 || width > Visuals_Gl_Service_MaximalCanvasSize || height > Visuals_Gl_Service_MaximalCanvasSize) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  g_service.canvasWidth = width;
+  g_service.canvasHeight = height;
+}
+
 void
 Visuals_Gl_Service_beginFrame
   (
     Shizu_State2* state
   )
 {
+  // Wait until the resource set of this frame is not in use by the GPU.
+  // The readbacks requested in the frame which used that resource set last are completed hence.
+  Visuals_Gl_Service_statistics.frameFenceWaitMilliseconds = Visuals_Gl_FramesInFlight_beginFrame(state);
+  Visuals_Gl_RenderBuffer_updateReadbacks(state, Shizu_Boolean_False);
+#if Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem && defined(Visuals_Gl_WithEgl)
+  // The offscreen frame buffer follows the canvas size.
+  // The render buffers sized from the client size (and the resolution scale) follow in turn.
+  if (Visuals_Gl_Backend_EglHeadless == g_service.backend) {
+    Visuals_Gl_Egl_Service_resizeFrameBuffer(state, g_service.canvasWidth, g_service.canvasHeight);
+  }
+#endif
+  if (Visuals_Gl_Renderer_Software == g_service.renderer) {
+    Shizu_Integer32 width, height;
+    Visuals_Gl_Service_getClientSize(state, &width, &height);
+    Visuals_Software_Context_resizeDefaultFrameBuffer(state, width, height);
+  }
+  Visuals_Gl_GpuTimings_beginFrame(state);
+  timespec_get(&g_service.frameBegin, TIME_UTC);
 #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
   Visuals_Gl_Wgl_Service_beginFrame(state);
 #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  #if defined(Visuals_Gl_WithEgl)
+  if (Visuals_Gl_Backend_EglHeadless == g_service.backend) {
+    Visuals_Gl_Egl_Service_beginFrame(state);
+    return;
+  }
+  #endif
   Visuals_Gl_Glx_Service_beginFrame(state);
 #else
   #error("operating system not (yet) supported")
@@ -180,9 +850,23 @@ Visuals_Gl_Service_endFrame
     Shizu_State2* state
   )
 {
+  g_service.numberOfFrames++;
+  if (Visuals_Gl_Renderer_Software == g_service.renderer) {
+    present(state);
+  }
+  Visuals_Gl_GpuTimings_endFrame(state);
+  Visuals_Gl_FramesInFlight_endFrame(state);
+  updateResolutionScale(state);
+  updateFrameStatistics(state);
 #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
   Visuals_Gl_Wgl_Service_endFrame(state);
 #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  #if defined(Visuals_Gl_WithEgl)
+  if (Visuals_Gl_Backend_EglHeadless == g_service.backend) {
+    Visuals_Gl_Egl_Service_endFrame(state);
+    return;
+  }
+  #endif
   Visuals_Gl_Glx_Service_endFrame(state);
 #else
   #error("operating system not (yet) supported")
@@ -195,9 +879,17 @@ Visuals_Gl_Service_update
     Shizu_State2* state
   )
 {
+  Visuals_Gl_Program_updatePending(state);
+  Visuals_Gl_Texture_updatePending(state);
 #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
   Visuals_Gl_Wgl_Service_update(state);
 #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  #if defined(Visuals_Gl_WithEgl)
+  if (Visuals_Gl_Backend_EglHeadless == g_service.backend) {
+    Visuals_Gl_Egl_Service_update(state);
+    return;
+  }
+  #endif
   Visuals_Gl_Glx_Service_update(state);
 #else
   #error("operating system not (yet) supported")
@@ -210,9 +902,17 @@ Visuals_Gl_Service_quitRequested
     Shizu_State2* state
   )
 {
+  if (g_service.maximalNumberOfFrames > 0 && g_service.numberOfFrames >= g_service.maximalNumberOfFrames) {
+    return Shizu_Boolean_True;
+  }
 #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
   return Visuals_Gl_Wgl_Service_quitRequested(state);
 #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  #if defined(Visuals_Gl_WithEgl)
+  if (Visuals_Gl_Backend_EglHeadless == g_service.backend) {
+    return Visuals_Gl_Egl_Service_quitRequested(state);
+  }
+  #endif
   return Visuals_Gl_Glx_Service_quitRequested(state);
 #else
   #error("operating system not (yet) supported")
@@ -252,6 +952,10 @@ Visuals_Gl_Service_linkProgram
   )
 {
   GLuint program = glCreateProgram();
+  if (glProgramParameteri) {
+    // Hint that the binary is retrieved for the program cache.
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
   glAttachShader(program, vert);
   glAttachShader(program, frag);
   glLinkProgram(program);
@@ -341,4 +1045,107 @@ Visuals_Gl_Service_getBackendMinorVersion
     Shizu_State2_jump(state);
   }
   return v;
-}
\ No newline at end of file
+}
+
+GLuint
+Visuals_Gl_Service_getDefaultFrameBufferId
+  (
+    Shizu_State2* state
+  )
+{
+#if Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem && defined(Visuals_Gl_WithEgl)
+  if (Visuals_Gl_Backend_EglHeadless == g_service.backend) {
+    return Visuals_Gl_Egl_Service_getFrameBufferId(state);
+  }
+#endif
+  return 0;
+}
+
+void
+Visuals_Gl_Service_beginGpuTiming
+  (
+    Shizu_State2* state,
+    char const* name
+  )
+{ Visuals_Gl_GpuTimings_beginScope(state, name); }
+
+void
+Visuals_Gl_Service_endGpuTiming
+  (
+    Shizu_State2* state
+  )
+{ Visuals_Gl_GpuTimings_endScope(state); }
+
+size_t
+Visuals_Gl_Service_getGpuTimings
+  (
+    Shizu_State2* state,
+    Visuals_GpuTiming* timings,
+    size_t maximalNumberOfTimings
+  )
+{ return Visuals_Gl_GpuTimings_get(state, timings, maximalNumberOfTimings); }
+
+void
+Visuals_Gl_Service_getFrameStatistics
+  (
+    Shizu_State2* state,
+    Visuals_FrameStatistics* statistics
+  )
+{ *statistics = g_service.frameStatistics; }
+
+void
+Visuals_Gl_Service_addCullingStatistics
+  (
+    Shizu_State2* state,
+    size_t numberOfVisibleObjects,
+    size_t numberOfCulledObjects
+  )
+{
+  Visuals_Gl_Service_statistics.numberOfVisibleObjects += numberOfVisibleObjects;
+  Visuals_Gl_Service_statistics.numberOfCulledObjects += numberOfCulledObjects;
+}
+
+Shizu_Boolean
+Visuals_Gl_Service_getResolutionScale
+  (
+    Shizu_State2* state,
+    Shizu_Float32* scale,
+    Shizu_Float32* maximumScale,
+    Visuals_BlitFilter* filter
+  )
+{
+  *filter = g_service.upscaleFilter;
+  if (!g_service.dynamicResolutionEnabled) {
+    *scale = 1.f;
+    *maximumScale = 1.f;
+    return Shizu_Boolean_False;
+  }
+  *scale = g_service.dynamicResolution.scale;
+  *maximumScale = g_service.dynamicResolution.maximumScale;
+  return Shizu_Boolean_True;
+}
+
+Shizu_Boolean
+Visuals_Gl_Service_isSoftwareRenderer
+  (
+    Shizu_State2* state
+  )
+{ return Visuals_Gl_Renderer_Software == g_service.renderer; }
+
+Shizu_Boolean
+Visuals_Gl_Service_isExtensionSupported
+  (
+    Shizu_State2* state,
+    char const* extensionName
+  )
+{
+  GLint numberOfExtensions = 0;
+  glGetIntegerv(GL_NUM_EXTENSIONS, &numberOfExtensions);
+  for (GLint i = 0; i < numberOfExtensions; ++i) {
+    GLubyte const* p = glGetStringi(GL_EXTENSIONS, (GLuint)i);
+    if (p && !strcmp((char const*)p, extensionName)) {
+      return true;
+    }
+  }
+  return false;
+}
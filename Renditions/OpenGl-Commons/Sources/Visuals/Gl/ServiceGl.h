@@ -25,6 +25,9 @@
 
 #include "Zeitgeist.h"
 
+// Visuals_FrameStatistics
+#include "Visuals/Service.h"
+
 /* Forward declaration. */
 typedef struct KeyboardKeyMessage KeyboardKeyMessage;
 
@@ -43,9 +46,26 @@ typedef struct Visuals_Object Visuals_Object;
 
 #define Define(Type, Name) \
   extern Type Name;
+#define DefineOptional(Type, Name, Extension) \
+  extern Type Name;
 #include "ServiceGl_Functions.i"
+#undef DefineOptional
 #undef Define
 
+/// @since 0.1
+/// @brief The default width, in pixels, of the canvas of the headless backend.
+/// Matches the initial width of the GLX and WGL windows.
+#define Visuals_Gl_Service_DefaultCanvasWidth (640)
+
+/// @since 0.1
+/// @brief The default height, in pixels, of the canvas of the headless backend.
+/// Matches the initial height of the GLX and WGL windows.
+#define Visuals_Gl_Service_DefaultCanvasHeight (480)
+
+/// @since 0.1
+/// @brief The maximal width and the maximal height, in pixels, of the canvas of the headless backend.
+#define Visuals_Gl_Service_MaximalCanvasSize (16384)
+
 /// @since 0.1
 /// @brief Initialize the GL service.
 /// @remarks The GL service is shared between renditions.
@@ -83,6 +103,21 @@ Visuals_Gl_Service_getClientSize
     Shizu_Integer32* height
   );
 
+/// @since 0.1
+/// @brief Set the size of the canvas of the headless backend.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param width, height The size, in pixels. Must be within [1, Visuals_Gl_Service_MaximalCanvasSize].
+/// @remarks
+/// The offscreen frame buffer is resized when the next frame begins.
+/// The size of the canvas of the windowed backends is the client size of the window and this function does not affect it.
+void
+Visuals_Gl_Service_setCanvasSize
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  );
+
 void
 Visuals_Gl_Service_beginFrame
   (
@@ -154,4 +189,83 @@ Visuals_Gl_Service_getBackendMinorVersion
     Shizu_State2* state
   );
 
+/// @brief Get the ID of the default frame buffer.
+/// @return The ID of the offscreen frame buffer if the headless backend is selected, @a 0 otherwise.
+/// @remarks Use this function instead of @a 0 when binding the default frame buffer.
+GLuint
+Visuals_Gl_Service_getDefaultFrameBufferId
+  (
+    Shizu_State2* state
+  );
+
+void
+Visuals_Gl_Service_beginGpuTiming
+  (
+    Shizu_State2* state,
+    char const* name
+  );
+
+void
+Visuals_Gl_Service_endGpuTiming
+  (
+    Shizu_State2* state
+  );
+
+size_t
+Visuals_Gl_Service_getGpuTimings
+  (
+    Shizu_State2* state,
+    Visuals_GpuTiming* timings,
+    size_t maximalNumberOfTimings
+  );
+
+void
+Visuals_Gl_Service_getFrameStatistics
+  (
+    Shizu_State2* state,
+    Visuals_FrameStatistics* statistics
+  );
+
+void
+Visuals_Gl_Service_addCullingStatistics
+  (
+    Shizu_State2* state,
+    size_t numberOfVisibleObjects,
+    size_t numberOfCulledObjects
+  );
+
+Shizu_Boolean
+Visuals_Gl_Service_getResolutionScale
+  (
+    Shizu_State2* state,
+    Shizu_Float32* scale,
+    Shizu_Float32* maximumScale,
+    Visuals_BlitFilter* filter
+  );
+
+/// @brief The counters of the frame in progress and the live object counters.
+/// @remarks The renderers increment the counters where they issue the work.
+/// The per-frame counters are reset when a frame ends.
+extern Visuals_FrameStatistics Visuals_Gl_Service_statistics;
+
+/// @brief Get if the software renderer is selected.
+/// @return @a true if the software renderer is selected, @a false if the OpenGL renderer is selected.
+/// @remarks The software renderer renders into the default frame buffer of the software context.
+/// That frame buffer is presented by copying it to the default frame buffer when the frame ends.
+Shizu_Boolean
+Visuals_Gl_Service_isSoftwareRenderer
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Get if an OpenGL extension is supported.
+/// @param extensionName The name of the extension e.g., "GL_ARB_buffer_storage".
+/// @return @a true if the extension is supported, @a false otherwise.
+Shizu_Boolean
+Visuals_Gl_Service_isExtensionSupported
+  (
+    Shizu_State2* state,
+    char const* extensionName
+  );
+
 #endif // SERVICEGL_H_INCLUDED
@@ -1,3 +1,6 @@
+// The minimum version is OpenGL 3.3 core: Define(Type, Name) is used for functions of OpenGL 3.3 core only.
+// Functions of later versions are linked by DefineOptional(Type, Name, Extension).
+
 // blending
 Define(PFNGLBLENDEQUATIONSEPARATEPROC, glBlendEquationSeparate)
 
@@ -31,6 +34,56 @@ Define(PFNGLGENBUFFERSPROC, glGenBuffers)
 Define(PFNGLBINDBUFFERPROC, glBindBuffer)
 Define(PFNGLBUFFERDATAPROC, glBufferData)
 Define(PFNGLDELETEBUFFERSPROC, glDeleteBuffers)
+Define(PFNGLBINDBUFFERBASEPROC, glBindBufferBase)
+Define(PFNGLBUFFERSUBDATAPROC, glBufferSubData)
+Define(PFNGLMAPBUFFERRANGEPROC, glMapBufferRange)
+Define(PFNGLUNMAPBUFFERPROC, glUnmapBuffer)
+
+// buffer storage
+// DefineOptional(Type, Name, Extension) links the function only if the extension is supported.
+// Otherwise the function pointer is null.
+DefineOptional(PFNGLBUFFERSTORAGEPROC, glBufferStorage, "GL_ARB_buffer_storage")
+
+// program binaries
+DefineOptional(PFNGLGETPROGRAMBINARYPROC, glGetProgramBinary, "GL_ARB_get_program_binary")
+DefineOptional(PFNGLPROGRAMBINARYPROC, glProgramBinary, "GL_ARB_get_program_binary")
+DefineOptional(PFNGLPROGRAMPARAMETERIPROC, glProgramParameteri, "GL_ARB_get_program_binary")
+
+// parallel shader compilation
+DefineOptional(PFNGLMAXSHADERCOMPILERTHREADSKHRPROC, glMaxShaderCompilerThreadsKHR, "GL_KHR_parallel_shader_compile")
+DefineOptional(PFNGLMAXSHADERCOMPILERTHREADSARBPROC, glMaxShaderCompilerThreadsARB, "GL_ARB_parallel_shader_compile")
+
+// sync objects
+Define(PFNGLFENCESYNCPROC, glFenceSync)
+Define(PFNGLCLIENTWAITSYNCPROC, glClientWaitSync)
+Define(PFNGLDELETESYNCPROC, glDeleteSync)
+
+// queries
+Define(PFNGLGENQUERIESPROC, glGenQueries)
+Define(PFNGLDELETEQUERIESPROC, glDeleteQueries)
+Define(PFNGLBEGINQUERYPROC, glBeginQuery)
+Define(PFNGLENDQUERYPROC, glEndQuery)
+Define(PFNGLQUERYCOUNTERPROC, glQueryCounter)
+Define(PFNGLGETQUERYOBJECTIVPROC, glGetQueryObjectiv)
+Define(PFNGLGETQUERYOBJECTUI64VPROC, glGetQueryObjectui64v)
+
+// extensions
+Define(PFNGLGETSTRINGIPROC, glGetStringi)
+
+// uniform blocks
+Define(PFNGLGETUNIFORMBLOCKINDEXPROC, glGetUniformBlockIndex)
+Define(PFNGLUNIFORMBLOCKBINDINGPROC, glUniformBlockBinding)
+
+// multi draw
+Define(PFNGLMULTIDRAWARRAYSPROC, glMultiDrawArrays)
+
+// primitive restart
+Define(PFNGLPRIMITIVERESTARTINDEXPROC, glPrimitiveRestartIndex)
+
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+// OpenGL 1.2+ functions. <GL/gl.h> declares these under Linux.
+Define(PFNGLDRAWRANGEELEMENTSPROC, glDrawRangeElements)
+#endif
 
 // framebuffers
 Define(PFNGLGENFRAMEBUFFERSPROC, glGenFramebuffers)
@@ -38,6 +91,7 @@ Define(PFNGLDELETEFRAMEBUFFERSPROC, glDeleteFramebuffers)
 Define(PFNGLBINDFRAMEBUFFERPROC, glBindFramebuffer)
 Define(PFNGLFRAMEBUFFERTEXTURE2DPROC, glFramebufferTexture2D)
 Define(PFNGLCHECKFRAMEBUFFERSTATUSPROC, glCheckFramebufferStatus)
+Define(PFNGLBLITFRAMEBUFFERPROC, glBlitFramebuffer)
 
 // vertex arrays
 Define(PFNGLGENVERTEXARRAYSPROC, glGenVertexArrays)
@@ -45,9 +99,16 @@ Define(PFNGLBINDVERTEXARRAYPROC, glBindVertexArray)
 Define(PFNGLDELETEVERTEXARRAYSPROC, glDeleteVertexArrays)
 Define(PFNGLVERTEXATTRIBPOINTERPROC, glVertexAttribPointer)
 Define(PFNGLENABLEVERTEXATTRIBARRAYPROC, glEnableVertexAttribArray)
+Define(PFNGLDISABLEVERTEXATTRIBARRAYPROC, glDisableVertexAttribArray)
+Define(PFNGLVERTEXATTRIBIPOINTERPROC, glVertexAttribIPointer)
+
+// instancing
+Define(PFNGLVERTEXATTRIBDIVISORPROC, glVertexAttribDivisor)
+Define(PFNGLDRAWARRAYSINSTANCEDPROC, glDrawArraysInstanced)
 
 // new vertex arrays
-Define(PFNGLVERTEXATTRIBFORMATPROC, glVertexAttribFormat)
-Define(PFNGLVERTEXATTRIBBINDINGPROC, glVertexAttribBinding)
-Define(PFNGLVERTEXBINDINGDIVISORPROC, glVertexBindingDivisor)
-Define(PFNGLBINDVERTEXBUFFERPROC, glBindVertexBuffer)
\ No newline at end of file
+// Core in OpenGL 4.3, hence optional.
+DefineOptional(PFNGLVERTEXATTRIBFORMATPROC, glVertexAttribFormat, "GL_ARB_vertex_attrib_binding")
+DefineOptional(PFNGLVERTEXATTRIBBINDINGPROC, glVertexAttribBinding, "GL_ARB_vertex_attrib_binding")
+DefineOptional(PFNGLVERTEXBINDINGDIVISORPROC, glVertexBindingDivisor, "GL_ARB_vertex_attrib_binding")
+DefineOptional(PFNGLBINDVERTEXBUFFERPROC, glBindVertexBuffer, "GL_ARB_vertex_attrib_binding")
\ No newline at end of file
@@ -0,0 +1,182 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "Visuals/Gl/Sharpen.h"
+
+/// @brief The weight of the difference between a pixel and its neighbours added to the pixel.
+#define Sharpness (0.5f)
+
+static char const* const g_vertexShader =
+  "#version 330 core\n"
+  // The part of the texture in texture coordinates: minimal u, minimal v, maximal u, maximal v.
+  "uniform vec4 sourceRectangle;\n"
+  "out vec2 textureCoordinate;\n"
+  "void main() {\n"
+  // A triangle covering the viewport. Its corners are (0,0), (2,0), and (0,2) in units of the viewport.
+  "  vec2 p = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));\n"
+  "  textureCoordinate = mix(sourceRectangle.xy, sourceRectangle.zw, p);\n"
+  "  gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);\n"
+  "}\n"
+  ;
+
+static char const* const g_fragmentShader =
+  "#version 330 core\n"
+  "uniform sampler2D source;\n"
+  "uniform vec4 sourceRectangle;\n"
+  // The width and the height of a texel in texture coordinates and the sharpness.
+  "uniform vec4 texelSizeAndSharpness;\n"
+  "in vec2 textureCoordinate;\n"
+  "out vec4 outputColor;\n"
+  // Do not sample the texels outside of the part.
+  "vec3 fetch(vec2 p) {\n"
+  "  vec2 h = 0.5 * texelSizeAndSharpness.xy;\n"
+  "  return texture(source, clamp(p, sourceRectangle.xy + h, sourceRectangle.zw - h)).rgb;\n"
+  "}\n"
+  "void main() {\n"
+  "  vec2 dx = vec2(texelSizeAndSharpness.x, 0.0), dy = vec2(0.0, texelSizeAndSharpness.y);\n"
+  "  vec3 c = fetch(textureCoordinate);\n"
+  "  vec3 w = fetch(textureCoordinate - dx), e = fetch(textureCoordinate + dx);\n"
+  "  vec3 s = fetch(textureCoordinate - dy), n = fetch(textureCoordinate + dy);\n"
+  // Unsharp masking. The result is limited to the range of the neighbourhood to avoid halos at edges.
+  "  vec3 sharpened = c + texelSizeAndSharpness.z * (4.0 * c - w - e - s - n);\n"
+  "  vec3 minimum = min(c, min(min(w, e), min(s, n)));\n"
+  "  vec3 maximum = max(c, max(max(w, e), max(s, n)));\n"
+  "  outputColor = vec4(clamp(sharpened, minimum, maximum), 1.0);\n"
+  "}\n"
+  ;
+
+static struct {
+  GLuint programId;
+  /// @brief An empty vertex array. The vertices are computed from their indices.
+  GLuint vertexArrayId;
+  GLint sourceRectangleLocation;
+  GLint texelSizeAndSharpnessLocation;
+  GLint sourceLocation;
+} g_sharpen = {
+  .programId = 0,
+  .vertexArrayId = 0,
+  .sourceRectangleLocation = -1,
+  .texelSizeAndSharpnessLocation = -1,
+  .sourceLocation = -1,
+};
+
+static void
+startup
+  (
+    Shizu_State2* state
+  )
+{
+  GLuint vertexShaderId = 0, fragmentShaderId = 0;
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    vertexShaderId = Visuals_Gl_Service_compileShader(state, GL_VERTEX_SHADER, g_vertexShader);
+    fragmentShaderId = Visuals_Gl_Service_compileShader(state, GL_FRAGMENT_SHADER, g_fragmentShader);
+    g_sharpen.programId = Visuals_Gl_Service_linkProgram(state, vertexShaderId, fragmentShaderId);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    if (fragmentShaderId) {
+      glDeleteShader(fragmentShaderId);
+    }
+    if (vertexShaderId) {
+      glDeleteShader(vertexShaderId);
+    }
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+  glDeleteShader(fragmentShaderId);
+  glDeleteShader(vertexShaderId);
+  g_sharpen.sourceRectangleLocation = glGetUniformLocation(g_sharpen.programId, "sourceRectangle");
+  g_sharpen.texelSizeAndSharpnessLocation = glGetUniformLocation(g_sharpen.programId, "texelSizeAndSharpness");
+  g_sharpen.sourceLocation = glGetUniformLocation(g_sharpen.programId, "source");
+  glGenVertexArrays(1, &g_sharpen.vertexArrayId);
+  if (glGetError()) {
+    Visuals_Gl_Sharpen_shutdown(state);
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+}
+
+void
+Visuals_Gl_Sharpen_draw
+  (
+    Shizu_State2* state,
+    GLuint textureId,
+    Shizu_Integer32 textureWidth,
+    Shizu_Integer32 textureHeight,
+    GLint const source[4],
+    GLint const target[4]
+  )
+{
+  if (!g_sharpen.programId) {
+    startup(state);
+  }
+  GLfloat sourceRectangle[4] = {
+    (GLfloat)source[0] / (GLfloat)textureWidth,
+    (GLfloat)source[1] / (GLfloat)textureHeight,
+    (GLfloat)(source[0] + source[2]) / (GLfloat)textureWidth,
+    (GLfloat)(source[1] + source[3]) / (GLfloat)textureHeight,
+  };
+  GLfloat texelSizeAndSharpness[4] = {
+    1.f / (GLfloat)textureWidth,
+    1.f / (GLfloat)textureHeight,
+    Sharpness,
+    0.f,
+  };
+  glViewport(target[0], target[1], target[2], target[3]);
+  glEnable(GL_SCISSOR_TEST);
+  glScissor(target[0], target[1], target[2], target[3]);
+  glDisable(GL_DEPTH_TEST);
+  glDisable(GL_BLEND);
+  glDisable(GL_CULL_FACE);
+  glUseProgram(g_sharpen.programId);
+  Visuals_Gl_Service_statistics.numberOfProgramBinds++;
+  glUniform4fv(g_sharpen.sourceRectangleLocation, 1, sourceRectangle);
+  glUniform4fv(g_sharpen.texelSizeAndSharpnessLocation, 1, texelSizeAndSharpness);
+  glUniform1i(g_sharpen.sourceLocation, 0);
+  glBindTexture(GL_TEXTURE_2D, textureId);
+  glBindVertexArray(g_sharpen.vertexArrayId);
+  Visuals_Gl_Service_statistics.numberOfVertexArrayBinds++;
+  glDrawArrays(GL_TRIANGLES, 0, 3);
+  Visuals_Gl_Service_statistics.numberOfDrawCalls++;
+  Visuals_Gl_Service_statistics.numberOfVertices += 3;
+  Visuals_Gl_Service_statistics.numberOfInstances++;
+  glBindVertexArray(0);
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void
+Visuals_Gl_Sharpen_shutdown
+  (
+    Shizu_State2* state
+  )
+{
+  if (g_sharpen.vertexArrayId) {
+    glDeleteVertexArrays(1, &g_sharpen.vertexArrayId);
+    g_sharpen.vertexArrayId = 0;
+  }
+  if (g_sharpen.programId) {
+    glDeleteProgram(g_sharpen.programId);
+    g_sharpen.programId = 0;
+  }
+}
@@ -0,0 +1,57 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(VISUALS_GL_SHARPEN_H_INCLUDED)
+#define VISUALS_GL_SHARPEN_H_INCLUDED
+
+#include "Visuals/Gl/ServiceGl.h"
+
+/// @brief Draw a part of a texture into a rectangle of the frame buffer bound to GL_DRAW_FRAMEBUFFER.
+/// The texture is sampled bilinearly and sharpened.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param textureId The ID of the texture. Its minification and magnification filters must be GL_LINEAR.
+/// @param textureWidth, textureHeight The width and the height, in pixels, of the texture.
+/// @param source The x, y, width, and height, in pixels, of the part of the texture.
+/// @param target The x, y, width, and height, in pixels, of the rectangle of the frame buffer.
+/// @remarks The program is created on first use.
+/// @error Shizu_Status_EnvironmentFailed the program could not be created.
+void
+Visuals_Gl_Sharpen_draw
+  (
+    Shizu_State2* state,
+    GLuint textureId,
+    Shizu_Integer32 textureWidth,
+    Shizu_Integer32 textureHeight,
+    GLint const source[4],
+    GLint const target[4]
+  );
+
+/// @brief Destroy the program.
+/// @param state A pointer to a Shizu_State2 value.
+/// @remarks Invoked by the GL service on shutdown.
+void
+Visuals_Gl_Sharpen_shutdown
+  (
+    Shizu_State2* state
+  );
+
+#endif // VISUALS_GL_SHARPEN_H_INCLUDED
@@ -1,6 +1,14 @@
 
 #include "Visuals/Gl/Texture.h"
 
+#include "Visuals/Parallel.h"
+
+// malloc, free
+#include <stdlib.h>
+
+// memcpy
+#include <string.h>
+
 static void
 Visuals_Gl_Texture_finalize
   (
@@ -22,6 +30,38 @@ Visuals_Gl_Texture_unmaterializeImpl
     Visuals_Gl_Texture* self
   );
 
+static void
+Visuals_Gl_Texture_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Texture* self,
+    Visuals_PixelFormat pixelFormat,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    Shizu_ByteArray* pixels
+  );
+
+static void
+Visuals_Gl_Texture_setSubDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Texture* self,
+    Shizu_Integer32 x,
+    Shizu_Integer32 y,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    Shizu_ByteArray* pixels
+  );
+
+static void
+Visuals_Gl_Texture_setLevelDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Texture* self,
+    Shizu_Integer32 level,
+    Shizu_ByteArray* pixels
+  );
+
 static void
 Visuals_Gl_Texture_dispatchInitialize
   (
@@ -53,6 +93,181 @@ static Shizu_ObjectTypeDescriptor const Visuals_Gl_Texture_Type = {
 
 Shizu_defineObjectType("Zeitgeist.Visuals.Gl.Texture", Visuals_Gl_Texture, Visuals_Texture);
 
+/// @brief The levels of a texture converted and generated by a task of the thread pool.
+/// The task does not access Shizu objects: It reads the raw Bytes of the pixels and writes the levels into a plain C array.
+struct Visuals_Gl_Texture_Levels {
+  /// @brief The task converting and generating the levels.
+  Visuals_Parallel_Task* task;
+  /// @brief The pixels passed to Visuals_Texture_setData. Locked until the task was joined.
+  Shizu_ByteArray* source;
+  /// @brief A pointer to the raw Bytes of the pixels passed to Visuals_Texture_setData.
+  void const* sourcePixels;
+  /// @brief The pixel format of the pixels passed to Visuals_Texture_setData.
+  Visuals_PixelFormat sourcePixelFormat;
+  /// @brief The number of Bytes per pixel of the pixels passed to Visuals_Texture_setData.
+  size_t sourceBytesPerPixel;
+  /// @brief The pixel format of the levels.
+  Visuals_PixelFormat pixelFormat;
+  /// @brief The number of Bytes per pixel of the levels.
+  size_t bytesPerPixel;
+  /// @brief The filter generating the levels from level 0.
+  Visuals_MipmapFilter mipmapFilter;
+  /// @brief If the color components are sRGB encoded.
+  bool sRGB;
+  /// @brief The size, in pixels, of level 0.
+  size_t width, height;
+  /// @brief The number of levels including level 0.
+  size_t numberOfLevels;
+  /// @brief The levels one after another, starting with level 0.
+  uint8_t* pixels;
+  /// @brief If the levels were converted and generated. Written by the task.
+  bool succeeded;
+};
+
+/// The textures of which the levels are converted and generated by a task in the order in which the tasks were started.
+/// A texture is locked while it is in this list.
+static struct {
+  Visuals_Gl_Texture** elements;
+  size_t size;
+  size_t capacity;
+} g_pendingTextures = {
+  .elements = NULL,
+  .size = 0,
+  .capacity = 0,
+};
+
+static void
+addPendingTexture
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Texture* texture,
+    Visuals_Gl_Texture_Levels* levels
+  )
+{
+  if (g_pendingTextures.size == g_pendingTextures.capacity) {
+    size_t newCapacity = g_pendingTextures.capacity ? g_pendingTextures.capacity * 2 : 8;
+    Visuals_Gl_Texture** newElements = realloc(g_pendingTextures.elements, newCapacity * sizeof(Visuals_Gl_Texture*));
+    if (!newElements) {
+      Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State2_jump(state);
+    }
+    g_pendingTextures.elements = newElements;
+    g_pendingTextures.capacity = newCapacity;
+  }
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)texture);
+  g_pendingTextures.elements[g_pendingTextures.size++] = texture;
+  texture->levels = levels;
+}
+
+// Remove a texture from the pending textures.
+// Return the levels of the texture. The task of the levels is not joined.
+static Visuals_Gl_Texture_Levels*
+removePendingTexture
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Texture* texture
+  )
+{
+  Visuals_Gl_Texture_Levels* levels = texture->levels;
+  for (size_t i = 0; i < g_pendingTextures.size; ++i) {
+    if (g_pendingTextures.elements[i] == texture) {
+      memmove(&g_pendingTextures.elements[i], &g_pendingTextures.elements[i + 1], (g_pendingTextures.size - i - 1) * sizeof(Visuals_Gl_Texture*));
+      g_pendingTextures.size--;
+      texture->levels = NULL;
+      Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)texture);
+      break;
+    }
+  }
+  return levels;
+}
+
+static void
+Visuals_Gl_Texture_Levels_run
+  (
+    Visuals_Gl_Texture_Levels* self,
+    size_t index
+  )
+{
+  size_t w = self->width, h = self->height;
+  uint8_t* target = self->pixels;
+  if (!Visuals_PixelFormat_tryConvert(self->pixelFormat, target, w * self->bytesPerPixel,
+                                      self->sourcePixelFormat, self->sourcePixels, w * self->sourceBytesPerPixel, w, h)) {
+    return;
+  }
+  for (size_t level = 1; level < self->numberOfLevels; ++level) {
+    uint8_t const* source = target;
+    target += w * h * self->bytesPerPixel;
+    if (!Visuals_Mipmap_tryGenerateLevel(self->mipmapFilter, self->sRGB, self->pixelFormat, w, h, source, target)) {
+      return;
+    }
+    w = w > 1 ? w / 2 : 1;
+    h = h > 1 ? h / 2 : 1;
+  }
+  self->succeeded = true;
+}
+
+// Join the task of levels, unlock the pixels read by the task, and destroy the levels.
+static void
+Visuals_Gl_Texture_Levels_destroy
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Texture_Levels* self
+  )
+{
+  if (self->task) {
+    Visuals_Parallel_joinTask(self->task);
+    self->task = NULL;
+  }
+  if (self->source) {
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)self->source);
+    self->source = NULL;
+  }
+  free(self->pixels);
+  free(self);
+}
+
+// Get the pixel format in which the levels of a texture of a pixel format are uploaded.
+// Pixels of three Bytes are expanded to four Bytes such that the driver does not need to repack the rows.
+static Visuals_PixelFormat
+Visuals_Gl_Texture_getUploadPixelFormat
+  (
+    Visuals_PixelFormat pixelFormat
+  )
+{
+  switch (pixelFormat) {
+    case Visuals_PixelFormat_BGR_U8: {
+      return Visuals_PixelFormat_BGRA_U8;
+    } break;
+    case Visuals_PixelFormat_RGB_U8: {
+      return Visuals_PixelFormat_RGBA_U8;
+    } break;
+    default: {
+      return pixelFormat;
+    } break;
+  };
+}
+
+// Delete the pixel buffers and their fences.
+static void
+Visuals_Gl_Texture_deletePixelBuffers
+  (
+    Visuals_Gl_Texture* self
+  )
+{
+  for (size_t i = 0; i < Visuals_Gl_Texture_NumberOfPixelBuffers; ++i) {
+    if (self->fences[i]) {
+      glDeleteSync(self->fences[i]);
+      self->fences[i] = 0;
+    }
+    if (self->pixelBufferIds[i]) {
+      glDeleteBuffers(1, &self->pixelBufferIds[i]);
+      self->pixelBufferIds[i] = 0;
+    }
+    self->pixelBufferCapacities[i] = 0;
+  }
+  self->pixelBufferIndex = 0;
+}
+
 static void
 Visuals_Gl_Texture_finalize
   (
@@ -60,6 +275,9 @@ Visuals_Gl_Texture_finalize
     Visuals_Gl_Texture* self
   )
 {
+  // A pending texture is locked, hence it has no levels here.
+  Visuals_Gl_Service_statistics.numberOfLiveTextures--;
+  Visuals_Gl_Texture_deletePixelBuffers(self);
   if (self->textureId) {
     glDeleteTextures(1, &self->textureId);
     self->textureId = 0;
@@ -81,6 +299,17 @@ Visuals_Gl_Texture_materializeImpl
       Shizu_State2_setStatus(state, 1);
       Shizu_State2_jump(state);
     }
+    glGenBuffers(Visuals_Gl_Texture_NumberOfPixelBuffers, &self->pixelBufferIds[0]);
+    if (glGetError()) {
+      for (size_t i = 0; i < Visuals_Gl_Texture_NumberOfPixelBuffers; ++i) {
+        self->pixelBufferIds[i] = 0;
+      }
+      glDeleteTextures(1, &self->textureId);
+      self->textureId = 0;
+      fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, "glGenBuffers");
+      Shizu_State2_setStatus(state, 1);
+      Shizu_State2_jump(state);
+    }
   }
 }
 
@@ -91,12 +320,359 @@ Visuals_Gl_Texture_unmaterializeImpl
     Visuals_Gl_Texture* self
   )
 {
+  if (self->levels) {
+    Visuals_Gl_Texture_Levels_destroy(state, removePendingTexture(state, self));
+  }
+  Visuals_Gl_Texture_deletePixelBuffers(self);
   if (self->textureId) {
     glDeleteTextures(1, &self->textureId);
     self->textureId = 0;
   }
 }
 
+// Map a pixel format to an OpenGL internal format, format, and type.
+// The packed types assume a little endian host.
+static void
+Visuals_Gl_Texture_getFormat
+  (
+    Shizu_State2* state,
+    Visuals_PixelFormat pixelFormat,
+    GLint* internalFormat,
+    GLenum* format,
+    GLenum* type
+  )
+{
+  switch (pixelFormat) {
+    case Visuals_PixelFormat_ABGR_U8: {
+      *internalFormat = GL_RGBA8;
+      *format = GL_RGBA;
+      *type = GL_UNSIGNED_INT_8_8_8_8;
+    } break;
+    case Visuals_PixelFormat_ARGB_U8: {
+      *internalFormat = GL_RGBA8;
+      *format = GL_BGRA;
+      *type = GL_UNSIGNED_INT_8_8_8_8;
+    } break;
+    case Visuals_PixelFormat_BGRA_U8: {
+      *internalFormat = GL_RGBA8;
+      *format = GL_BGRA;
+      *type = GL_UNSIGNED_BYTE;
+    } break;
+    case Visuals_PixelFormat_BGR_U8: {
+      *internalFormat = GL_RGB8;
+      *format = GL_BGR;
+      *type = GL_UNSIGNED_BYTE;
+    } break;
+    case Visuals_PixelFormat_RGBA_U8: {
+      *internalFormat = GL_RGBA8;
+      *format = GL_RGBA;
+      *type = GL_UNSIGNED_BYTE;
+    } break;
+    case Visuals_PixelFormat_RGB_U8: {
+      *internalFormat = GL_RGB8;
+      *format = GL_RGB;
+      *type = GL_UNSIGNED_BYTE;
+    } break;
+    default: {
+      fprintf(stderr, "%s:%d: unreachable code reached\n", __FILE__, __LINE__);
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    } break;
+  };
+}
+
+// Upload the pixels of a region of a level of the texture through the next pixel buffer.
+// The pixels are in the specified pixel format which may differ from the pixel format of the texture.
+static void
+Visuals_Gl_Texture_upload
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Texture* self,
+    Visuals_PixelFormat pixelFormat,
+    GLint level,
+    Shizu_Integer32 x,
+    Shizu_Integer32 y,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{
+  if (!numberOfBytes) {
+    return;
+  }
+  GLint internalFormat;
+  GLenum format, type;
+  Visuals_Gl_Texture_getFormat(state, pixelFormat, &internalFormat, &format, &type);
+  // Advance to the next pixel buffer and wait until the GPU finished reading from it.
+  self->pixelBufferIndex = (self->pixelBufferIndex + 1) % Visuals_Gl_Texture_NumberOfPixelBuffers;
+  size_t i = self->pixelBufferIndex;
+  if (self->fences[i]) {
+    GLenum result;
+    do {
+      result = glClientWaitSync(self->fences[i], GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_C(1000000));
+    } while (GL_TIMEOUT_EXPIRED == result);
+    glDeleteSync(self->fences[i]);
+    self->fences[i] = 0;
+    if (GL_WAIT_FAILED == result) {
+      fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, "glClientWaitSync");
+      Shizu_State2_setStatus(state, 1);
+      Shizu_State2_jump(state);
+    }
+  }
+  while (glGetError()) { }
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, self->pixelBufferIds[i]);
+  if (self->pixelBufferCapacities[i] < numberOfBytes) {
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, numberOfBytes, NULL, GL_STREAM_DRAW);
+    self->pixelBufferCapacities[i] = numberOfBytes;
+  }
+  // The GPU finished reading from the pixel buffer: No synchronization is required.
+  void* p = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, numberOfBytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+  if (!p) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, "glMapBufferRange");
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+  memcpy(p, bytes, numberOfBytes);
+  glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+  Visuals_Gl_Service_statistics.numberOfTextureBytesUploaded += numberOfBytes;
+  // Source the pixels from the pixel buffer.
+  glBindTexture(GL_TEXTURE_2D, self->textureId);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height, format, type, (void const*)0);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  self->fences[i] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  if (glGetError()) {
+    fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, "glTexSubImage2D");
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+}
+
+// Restrict sampling to the levels 0 to numberOfLevels - 1.
+static void
+Visuals_Gl_Texture_setNumberOfLevels
+  (
+    Visuals_Gl_Texture* self,
+    Shizu_Integer32 numberOfLevels
+  )
+{
+  glBindTexture(GL_TEXTURE_2D, self->textureId);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, numberOfLevels - 1);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, numberOfLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// (Re)allocate the storage of the levels 0 to numberOfLevels - 1 of the texture.
+static void
+Visuals_Gl_Texture_allocate
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Texture* self,
+    Shizu_Integer32 numberOfLevels
+  )
+{
+  Visuals_Texture* texture = (Visuals_Texture*)self;
+  GLint internalFormat;
+  GLenum format, type;
+  Visuals_Gl_Texture_getFormat(state, texture->pixelFormat, &internalFormat, &format, &type);
+  glBindTexture(GL_TEXTURE_2D, self->textureId);
+  for (Shizu_Integer32 level = 0; level < numberOfLevels; ++level) {
+    GLsizei w = texture->width >> level > 0 ? texture->width >> level : 1, h = texture->height >> level > 0 ? texture->height >> level : 1;
+    glTexImage2D(GL_TEXTURE_2D, level, internalFormat, w, h, 0, format, type, NULL);
+  }
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// Join the task of a pending texture, (re)allocate the storage of the texture, and upload the levels.
+static void
+Visuals_Gl_Texture_complete
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Texture* self
+  )
+{
+  Visuals_Gl_Texture_Levels* levels = removePendingTexture(state, self);
+  Visuals_Parallel_joinTask(levels->task);
+  levels->task = NULL;
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    // The arguments were validated by Visuals_Gl_Texture_setDataImpl, hence the task only fails if an allocation failed.
+    if (!levels->succeeded) {
+      Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State2_jump(state);
+    }
+    Visuals_Texture* texture = (Visuals_Texture*)self;
+    Visuals_Gl_Texture_allocate(state, self, (Shizu_Integer32)levels->numberOfLevels);
+    uint8_t const* source = levels->pixels;
+    Shizu_Integer32 w = texture->width, h = texture->height;
+    for (Shizu_Integer32 level = 0; level < (Shizu_Integer32)levels->numberOfLevels; ++level) {
+      size_t numberOfBytes = (size_t)w * (size_t)h * levels->bytesPerPixel;
+      Visuals_Gl_Texture_upload(state, self, levels->pixelFormat, level, 0, 0, w, h, source, numberOfBytes);
+      source += numberOfBytes;
+      w = w > 1 ? w / 2 : 1;
+      h = h > 1 ? h / 2 : 1;
+    }
+    texture->numberOfLevels = (Shizu_Integer32)levels->numberOfLevels;
+    Visuals_Gl_Texture_setNumberOfLevels(self, texture->numberOfLevels);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Visuals_Gl_Texture_Levels_destroy(state, levels);
+    Shizu_State2_jump(state);
+  }
+  Visuals_Gl_Texture_Levels_destroy(state, levels);
+}
+
+static void
+Visuals_Gl_Texture_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Texture* self,
+    Visuals_PixelFormat pixelFormat,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    Shizu_ByteArray* pixels
+  )
+{
+  Shizu_Type* parentType = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), ((Shizu_Object*)self)->type);
+  Visuals_Texture_Dispatch* parentDispatch = (Visuals_Texture_Dispatch*)Shizu_Types_getDispatch(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), parentType);
+  parentDispatch->setData(state, (Visuals_Texture*)self, pixelFormat, width, height, pixels);
+
+  Visuals_Object_materialize(state, (Visuals_Object*)self);
+
+  // The levels of previous pixels are discarded.
+  if (self->levels) {
+    Visuals_Gl_Texture_Levels_destroy(state, removePendingTexture(state, self));
+  }
+
+  Visuals_Texture* texture = (Visuals_Texture*)self;
+  Shizu_Integer32 numberOfLevels = 1;
+  if (Visuals_MipmapFilter_None != texture->mipmapFilter) {
+    numberOfLevels = Visuals_Mipmap_getNumberOfLevels(state, width, height);
+  }
+  Visuals_PixelFormat uploadPixelFormat = Visuals_Gl_Texture_getUploadPixelFormat(pixelFormat);
+
+  if (1 == numberOfLevels && uploadPixelFormat == pixelFormat) {
+    // No pixels are converted or generated: Upload level 0 as is.
+    Visuals_Gl_Texture_allocate(state, self, 1);
+    Visuals_Gl_Texture_setNumberOfLevels(self, 1);
+    Visuals_Gl_Texture_upload(state, self, pixelFormat, 0, 0, 0, width, height, Shizu_ByteArray_getRawBytes(state, pixels), Shizu_ByteArray_getNumberOfRawBytes(state, pixels));
+    return;
+  }
+
+  // Convert level 0 and generate the other levels on the thread pool.
+  // The texture keeps its previous storage and levels until Visuals_Gl_Texture_updatePending uploads the levels.
+  Visuals_Gl_Texture_Levels* levels = malloc(sizeof(Visuals_Gl_Texture_Levels));
+  if (!levels) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  levels->task = NULL;
+  levels->source = NULL;
+  levels->sourcePixels = Shizu_ByteArray_getRawBytes(state, pixels);
+  levels->sourcePixelFormat = pixelFormat;
+  levels->sourceBytesPerPixel = (size_t)Visuals_PixelFormat_getBytesPerPixel(state, pixelFormat);
+  levels->pixelFormat = uploadPixelFormat;
+  levels->bytesPerPixel = (size_t)Visuals_PixelFormat_getBytesPerPixel(state, uploadPixelFormat);
+  levels->mipmapFilter = texture->mipmapFilter;
+  levels->sRGB = texture->sRGB;
+  levels->width = (size_t)width;
+  levels->height = (size_t)height;
+  levels->numberOfLevels = (size_t)numberOfLevels;
+  levels->succeeded = false;
+  size_t numberOfBytes = 0;
+  for (size_t level = 0, w = levels->width, h = levels->height; level < levels->numberOfLevels; ++level) {
+    numberOfBytes += w * h * levels->bytesPerPixel;
+    w = w > 1 ? w / 2 : 1;
+    h = h > 1 ? h / 2 : 1;
+  }
+  levels->pixels = malloc(numberOfBytes > 0 ? numberOfBytes : 1);
+  if (!levels->pixels) {
+    free(levels);
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    addPendingTexture(state, self, levels);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Visuals_Gl_Texture_Levels_destroy(state, levels);
+    Shizu_State2_jump(state);
+  }
+  // The task reads the raw Bytes of the pixels: They are locked until the task was joined.
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)pixels);
+  levels->source = pixels;
+  levels->task = Visuals_Parallel_startTask((Visuals_Parallel_Callback*)&Visuals_Gl_Texture_Levels_run, levels);
+}
+
+static void
+Visuals_Gl_Texture_setSubDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Texture* self,
+    Shizu_Integer32 x,
+    Shizu_Integer32 y,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    Shizu_ByteArray* pixels
+  )
+{
+  Shizu_Type* parentType = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), ((Shizu_Object*)self)->type);
+  Visuals_Texture_Dispatch* parentDispatch = (Visuals_Texture_Dispatch*)Shizu_Types_getDispatch(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), parentType);
+  parentDispatch->setSubData(state, (Visuals_Texture*)self, x, y, width, height, pixels);
+
+  Visuals_Object_materialize(state, (Visuals_Object*)self);
+
+  // The region is uploaded after level 0.
+  if (self->levels) {
+    Visuals_Gl_Texture_complete(state, self);
+  }
+
+  Visuals_Gl_Texture_upload(state, self, ((Visuals_Texture*)self)->pixelFormat, 0, x, y, width, height, Shizu_ByteArray_getRawBytes(state, pixels), Shizu_ByteArray_getNumberOfRawBytes(state, pixels));
+}
+
+static void
+Visuals_Gl_Texture_setLevelDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_Texture* self,
+    Shizu_Integer32 level,
+    Shizu_ByteArray* pixels
+  )
+{
+  Shizu_Type* parentType = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), ((Shizu_Object*)self)->type);
+  Visuals_Texture_Dispatch* parentDispatch = (Visuals_Texture_Dispatch*)Shizu_Types_getDispatch(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), parentType);
+  parentDispatch->setLevelData(state, (Visuals_Texture*)self, level, pixels);
+
+  Visuals_Object_materialize(state, (Visuals_Object*)self);
+
+  // The level is uploaded after level 0.
+  if (self->levels) {
+    Visuals_Gl_Texture_complete(state, self);
+  }
+
+  Visuals_Texture* texture = (Visuals_Texture*)self;
+  GLint internalFormat;
+  GLenum format, type;
+  Visuals_Gl_Texture_getFormat(state, texture->pixelFormat, &internalFormat, &format, &type);
+  GLsizei w = texture->width >> level > 0 ? texture->width >> level : 1, h = texture->height >> level > 0 ? texture->height >> level : 1;
+  glBindTexture(GL_TEXTURE_2D, self->textureId);
+  glTexImage2D(GL_TEXTURE_2D, level, internalFormat, w, h, 0, format, type, NULL);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  Visuals_Gl_Texture_upload(state, self, texture->pixelFormat, level, 0, 0, w, h, Shizu_ByteArray_getRawBytes(state, pixels), Shizu_ByteArray_getNumberOfRawBytes(state, pixels));
+  Visuals_Gl_Texture_setNumberOfLevels(self, texture->numberOfLevels);
+}
+
 static void
 Visuals_Gl_Texture_dispatchInitialize
   (
@@ -106,6 +682,9 @@ Visuals_Gl_Texture_dispatchInitialize
 {
   ((Visuals_Object_Dispatch*)self)->materialize = (void(*)(Shizu_State2*, Visuals_Object*)) & Visuals_Gl_Texture_materializeImpl;
   ((Visuals_Object_Dispatch*)self)->unmaterialize = (void(*)(Shizu_State2*, Visuals_Object*)) & Visuals_Gl_Texture_unmaterializeImpl;
+  ((Visuals_Texture_Dispatch*)self)->setData = (void(*)(Shizu_State2*, Visuals_Texture*, Visuals_PixelFormat, Shizu_Integer32, Shizu_Integer32, Shizu_ByteArray*)) & Visuals_Gl_Texture_setDataImpl;
+  ((Visuals_Texture_Dispatch*)self)->setSubData = (void(*)(Shizu_State2*, Visuals_Texture*, Shizu_Integer32, Shizu_Integer32, Shizu_Integer32, Shizu_Integer32, Shizu_ByteArray*)) & Visuals_Gl_Texture_setSubDataImpl;
+  ((Visuals_Texture_Dispatch*)self)->setLevelData = (void(*)(Shizu_State2*, Visuals_Texture*, Shizu_Integer32, Shizu_ByteArray*)) & Visuals_Gl_Texture_setLevelDataImpl;
 }
 
 static void
@@ -130,7 +709,15 @@ Visuals_Gl_Texture_constructImpl
     Shizu_Type_getObjectTypeDescriptor(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), PARENTTYPE)->construct(state, &returnValue, 1, &argumentValues[0]);
   }
   SELF->textureId = 0;
+  for (size_t i = 0; i < Visuals_Gl_Texture_NumberOfPixelBuffers; ++i) {
+    SELF->pixelBufferIds[i] = 0;
+    SELF->pixelBufferCapacities[i] = 0;
+    SELF->fences[i] = 0;
+  }
+  SELF->pixelBufferIndex = 0;
+  SELF->levels = NULL;
   ((Shizu_Object*)SELF)->type = TYPE;
+  Visuals_Gl_Service_statistics.numberOfLiveTextures++;
 }
 
 Visuals_Gl_Texture*
@@ -144,3 +731,37 @@ Visuals_Gl_Texture_create
   Shizu_Operations_create(state, &returnValue, 1, &argumentValues[0]);
   return (Visuals_Gl_Texture*)Shizu_Value_getObject(&returnValue);
 }
+
+void
+Visuals_Gl_Texture_updatePending
+  (
+    Shizu_State2* state
+  )
+{
+  size_t i = 0;
+  while (i < g_pendingTextures.size) {
+    Visuals_Gl_Texture* texture = g_pendingTextures.elements[i];
+    if (Visuals_Parallel_isTaskDone(texture->levels->task)) {
+      // Removes the texture from the pending textures.
+      Visuals_Gl_Texture_complete(state, texture);
+    } else {
+      i++;
+    }
+  }
+}
+
+void
+Visuals_Gl_Texture_shutdownPending
+  (
+    Shizu_State2* state
+  )
+{
+  while (g_pendingTextures.size) {
+    Visuals_Gl_Texture_Levels_destroy(state, removePendingTexture(state, g_pendingTextures.elements[g_pendingTextures.size - 1]));
+  }
+  if (g_pendingTextures.elements) {
+    free(g_pendingTextures.elements);
+    g_pendingTextures.elements = NULL;
+  }
+  g_pendingTextures.capacity = 0;
+}
@@ -5,10 +5,23 @@
 #include "Visuals/Texture.h"
 #include "Visuals/Gl/ServiceGl.h"
 
+/// @brief The number of pixel buffers a texture uploads its pixels through.
+#define Visuals_Gl_Texture_NumberOfPixelBuffers (3)
+
 /// @brief
 /// The implementation of Visuals.Texture for OpenGL.
 /// @details
 /// textureId is the OpenGL representation of the texture.
+/// @details
+/// Pixels are uploaded through a ring of Visuals_Gl_Texture_NumberOfPixelBuffers pixel buffers.
+/// The pixels are copied into the next pixel buffer and glTexSubImage2D is sourced from that pixel buffer,
+/// hence the copy from the pixel buffer to the texture is performed by the GPU asynchronously.
+/// A pixel buffer is guarded by a fence and is only overwritten after the GPU finished reading from it.
+/// @details
+/// If the texture has a mipmap filter or its pixels have three Bytes per pixel, Visuals_Texture_setData does not wait for the levels:
+/// A task of the thread pool converts level 0 into a pixel format of four Bytes per pixel and generates the other levels by Visuals_Mipmap_tryGenerateLevel.
+/// The levels are uploaded through the pixel buffers by Visuals_Gl_Texture_updatePending once the task is done.
+/// Until then, the texture keeps its previous levels.
 /// The type is
 /// @code
 /// class Visuals.Gl.Texture
@@ -19,6 +32,9 @@
 /// @endcode
 Shizu_declareObjectType(Visuals_Gl_Texture);
 
+/// @brief The levels of a texture converted and generated by a task of the thread pool.
+typedef struct Visuals_Gl_Texture_Levels Visuals_Gl_Texture_Levels;
+
 struct Visuals_Gl_Texture_Dispatch {
   Visuals_Texture_Dispatch _parent;
 };
@@ -27,6 +43,17 @@ struct Visuals_Gl_Texture {
   Visuals_Texture parent;
   /// @brief The OpenGL ID of the texture.
   GLuint textureId;
+  /// @brief The OpenGL IDs of the pixel buffers.
+  GLuint pixelBufferIds[Visuals_Gl_Texture_NumberOfPixelBuffers];
+  /// @brief The capacities, in Bytes, of the pixel buffers.
+  size_t pixelBufferCapacities[Visuals_Gl_Texture_NumberOfPixelBuffers];
+  /// @brief The fences guarding the pixel buffers.
+  GLsync fences[Visuals_Gl_Texture_NumberOfPixelBuffers];
+  /// @brief The index of the pixel buffer used by the last upload.
+  size_t pixelBufferIndex;
+  /// @brief A pointer to the levels converted and generated by a task or the null pointer.
+  /// If not the null pointer, the texture is pending.
+  Visuals_Gl_Texture_Levels* levels;
 };
 
 Visuals_Gl_Texture*
@@ -35,4 +62,21 @@ Visuals_Gl_Texture_create
     Shizu_State2* state
   );
 
+/// @brief Upload the levels of the pending textures of which the tasks are done.
+/// @param state A pointer to a Shizu_State2 value.
+/// @remarks The tasks are not waited for.
+void
+Visuals_Gl_Texture_updatePending
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Join the tasks of the pending textures and discard their levels.
+/// @param state A pointer to a Shizu_State2 value.
+void
+Visuals_Gl_Texture_shutdownPending
+  (
+    Shizu_State2* state
+  );
+
 #endif // VISUALS_GL_TEXTURE_H_INCLUDED
@@ -0,0 +1,321 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "Visuals/Gl/UniformBuffer.h"
+
+// SIZE_MAX
+#include <stdint.h>
+
+static void
+Visuals_Gl_UniformBuffer_finalize
+  (
+    Shizu_State2* state,
+    Visuals_Gl_UniformBuffer* self
+  );
+
+static void
+Visuals_Gl_UniformBuffer_materializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_UniformBuffer* self
+  );
+
+static void
+Visuals_Gl_UniformBuffer_unmaterializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_UniformBuffer* self
+  );
+
+static void
+Visuals_Gl_UniformBuffer_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_UniformBuffer* self,
+    void const* bytes,
+    size_t numberOfBytes
+  );
+
+static void
+Visuals_Gl_UniformBuffer_setSubDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_UniformBuffer* self,
+    size_t offset,
+    void const* bytes,
+    size_t numberOfBytes
+  );
+
+static void
+Visuals_Gl_UniformBuffer_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_Gl_UniformBuffer_Dispatch* self
+  );
+
+static void
+Visuals_Gl_UniformBuffer_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  );
+
+static Shizu_ObjectTypeDescriptor const Visuals_Gl_UniformBuffer_Type = {
+  .postCreateType = NULL,
+  .preDestroyType = NULL,
+  .visitType = NULL,
+  .size = sizeof(Visuals_Gl_UniformBuffer),
+  .construct = &Visuals_Gl_UniformBuffer_constructImpl,
+  .finalize = (Shizu_OnFinalizeCallback*)&Visuals_Gl_UniformBuffer_finalize,
+  .visit = NULL,
+  .dispatchSize = sizeof(Visuals_Gl_UniformBuffer_Dispatch),
+  .dispatchInitialize = (Shizu_OnDispatchInitializeCallback*) & Visuals_Gl_UniformBuffer_dispatchInitialize,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Zeitgeist.Visuals.Gl.UniformBuffer", Visuals_Gl_UniformBuffer, Visuals_UniformBuffer);
+
+// Delete the copies of the uniform data.
+static void
+Visuals_Gl_UniformBuffer_deleteCopies
+  (
+    Visuals_Gl_UniformBuffer* self
+  )
+{
+  if (self->numberOfCopies) {
+    glDeleteBuffers((GLsizei)self->numberOfCopies, self->bufferIds);
+    for (size_t i = 0; i < self->numberOfCopies; ++i) {
+      self->bufferIds[i] = 0;
+    }
+    self->numberOfCopies = 0;
+  }
+}
+
+// Write the data not written to a copy yet to that copy.
+// The buffer storage of the copy is (re)created if it does not exist or if the size of the data changed.
+static void
+Visuals_Gl_UniformBuffer_writeCopy
+  (
+    Shizu_State2* state,
+    Visuals_Gl_UniformBuffer* self,
+    size_t index
+  )
+{
+  Visuals_UniformBuffer* parent = (Visuals_UniformBuffer*)self;
+  if (self->sizes[index] != parent->numberOfBytes) {
+    glBindBuffer(GL_UNIFORM_BUFFER, self->bufferIds[index]);
+    glBufferData(GL_UNIFORM_BUFFER, parent->numberOfBytes, parent->bytes, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    Visuals_Gl_Service_statistics.numberOfBufferBytesUploaded += parent->numberOfBytes;
+    self->sizes[index] = parent->numberOfBytes;
+  } else if (self->dirtyBegins[index] < self->dirtyEnds[index]) {
+    size_t offset = self->dirtyBegins[index], numberOfBytes = self->dirtyEnds[index] - self->dirtyBegins[index];
+    glBindBuffer(GL_UNIFORM_BUFFER, self->bufferIds[index]);
+    glBufferSubData(GL_UNIFORM_BUFFER, offset, numberOfBytes, (char const*)parent->bytes + offset);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    Visuals_Gl_Service_statistics.numberOfBufferBytesUploaded += numberOfBytes;
+  }
+  self->dirtyBegins[index] = 0;
+  self->dirtyEnds[index] = 0;
+}
+
+// Add a range to the ranges of the data not written to the copies yet.
+static void
+Visuals_Gl_UniformBuffer_addDirtyRange
+  (
+    Visuals_Gl_UniformBuffer* self,
+    size_t begin,
+    size_t end
+  )
+{
+  for (size_t i = 0; i < self->numberOfCopies; ++i) {
+    if (self->dirtyBegins[i] >= self->dirtyEnds[i]) {
+      self->dirtyBegins[i] = begin;
+      self->dirtyEnds[i] = end;
+    } else {
+      self->dirtyBegins[i] = begin < self->dirtyBegins[i] ? begin : self->dirtyBegins[i];
+      self->dirtyEnds[i] = end > self->dirtyEnds[i] ? end : self->dirtyEnds[i];
+    }
+  }
+}
+
+static void
+Visuals_Gl_UniformBuffer_finalize
+  (
+    Shizu_State2* state,
+    Visuals_Gl_UniformBuffer* self
+  )
+{
+  Visuals_Gl_Service_statistics.numberOfLiveUniformBuffers--;
+  Visuals_Gl_UniformBuffer_deleteCopies(self);
+}
+
+static void
+Visuals_Gl_UniformBuffer_materializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_UniformBuffer* self
+  )
+{
+  if (!self->numberOfCopies) {
+    size_t numberOfCopies = Visuals_Gl_FramesInFlight_getNumberOfFrames(state);
+    while (glGetError()) { }
+    glGenBuffers((GLsizei)numberOfCopies, self->bufferIds);
+    if (glGetError()) {
+      fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, "glGenBuffers");
+      Shizu_State2_setStatus(state, 1);
+      Shizu_State2_jump(state);
+    }
+    // The data is written to the copies when they are used.
+    for (size_t i = 0; i < numberOfCopies; ++i) {
+      self->sizes[i] = SIZE_MAX;
+      self->dirtyBegins[i] = 0;
+      self->dirtyEnds[i] = 0;
+    }
+    self->numberOfCopies = numberOfCopies;
+  }
+}
+
+static void
+Visuals_Gl_UniformBuffer_unmaterializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_UniformBuffer* self
+  )
+{
+  Visuals_Gl_UniformBuffer_deleteCopies(self);
+}
+
+static void
+Visuals_Gl_UniformBuffer_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_UniformBuffer* self,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{
+  Shizu_Type* parentType = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), ((Shizu_Object*)self)->type);
+  Visuals_UniformBuffer_Dispatch* parentDispatch = (Visuals_UniformBuffer_Dispatch*)Shizu_Types_getDispatch(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), parentType);
+  parentDispatch->setData(state, (Visuals_UniformBuffer*)self, bytes, numberOfBytes);
+
+  Visuals_Object_materialize(state, (Visuals_Object*)self);
+
+  // Store the data in the copy of the frame in progress.
+  Visuals_Gl_UniformBuffer_addDirtyRange(self, 0, numberOfBytes);
+  Visuals_Gl_UniformBuffer_writeCopy(state, self, Visuals_Gl_FramesInFlight_getFrameIndex(state) % self->numberOfCopies);
+}
+
+static void
+Visuals_Gl_UniformBuffer_setSubDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_UniformBuffer* self,
+    size_t offset,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{
+  Shizu_Type* parentType = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), ((Shizu_Object*)self)->type);
+  Visuals_UniformBuffer_Dispatch* parentDispatch = (Visuals_UniformBuffer_Dispatch*)Shizu_Types_getDispatch(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), parentType);
+  parentDispatch->setSubData(state, (Visuals_UniformBuffer*)self, offset, bytes, numberOfBytes);
+  // If the buffer was unmaterialized, all the data is stored in the new copies.
+  Visuals_Object_materialize(state, (Visuals_Object*)self);
+  // Store the range in the copy of the frame in progress.
+  // The other copies receive the range when their frames are in progress.
+  Visuals_Gl_UniformBuffer_addDirtyRange(self, offset, offset + numberOfBytes);
+  Visuals_Gl_UniformBuffer_writeCopy(state, self, Visuals_Gl_FramesInFlight_getFrameIndex(state) % self->numberOfCopies);
+}
+
+static void
+Visuals_Gl_UniformBuffer_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_Gl_UniformBuffer_Dispatch* self
+  )
+{
+  ((Visuals_Object_Dispatch*)self)->materialize = (void(*)(Shizu_State2*,Visuals_Object*)) & Visuals_Gl_UniformBuffer_materializeImpl;
+  ((Visuals_Object_Dispatch*)self)->unmaterialize = (void(*)(Shizu_State2*,Visuals_Object*)) & Visuals_Gl_UniformBuffer_unmaterializeImpl;
+  ((Visuals_UniformBuffer_Dispatch*)self)->setData = (void(*)(Shizu_State2*, Visuals_UniformBuffer*, void const*, size_t)) & Visuals_Gl_UniformBuffer_setDataImpl;
+  ((Visuals_UniformBuffer_Dispatch*)self)->setSubData = (void(*)(Shizu_State2*, Visuals_UniformBuffer*, size_t, void const*, size_t)) & Visuals_Gl_UniformBuffer_setSubDataImpl;
+}
+
+static void
+Visuals_Gl_UniformBuffer_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{
+  if (1 != numberOfArgumentValues) {
+    Shizu_State2_setStatus(state, Shizu_Status_NumberOfArgumentsInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Type* TYPE = Visuals_Gl_UniformBuffer_getType(state);
+  Visuals_Gl_UniformBuffer* SELF = (Visuals_Gl_UniformBuffer*)Shizu_Value_getObject(&argumentValues[0]);
+  {
+    Shizu_Type* PARENTTYPE = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), TYPE);
+    Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value argumentValues[] = { Shizu_Value_InitializerObject(SELF) };
+    Shizu_Type_getObjectTypeDescriptor(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), PARENTTYPE)->construct(state, &returnValue, 1, &argumentValues[0]);
+  }
+  for (size_t i = 0; i < Visuals_Gl_FramesInFlight_MaximalNumberOfFrames; ++i) {
+    SELF->bufferIds[i] = 0;
+    SELF->sizes[i] = SIZE_MAX;
+    SELF->dirtyBegins[i] = 0;
+    SELF->dirtyEnds[i] = 0;
+  }
+  SELF->numberOfCopies = 0;
+  ((Shizu_Object*)SELF)->type = TYPE;
+  Visuals_Gl_Service_statistics.numberOfLiveUniformBuffers++;
+}
+
+Visuals_Gl_UniformBuffer*
+Visuals_Gl_UniformBuffer_create
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+  Shizu_Value argumentValues[] = { Shizu_Value_InitializerType(Visuals_Gl_UniformBuffer_getType(state)) };
+  Shizu_Operations_create(state, &returnValue, 1, &argumentValues[0]);
+  return (Visuals_Gl_UniformBuffer*)Shizu_Value_getObject(&returnValue);
+}
+
+GLuint
+Visuals_Gl_UniformBuffer_getCurrentBufferId
+  (
+    Shizu_State2* state,
+    Visuals_Gl_UniformBuffer* self
+  )
+{
+  if (!self->numberOfCopies) {
+    return 0;
+  }
+  size_t index = Visuals_Gl_FramesInFlight_getFrameIndex(state) % self->numberOfCopies;
+  Visuals_Gl_UniformBuffer_writeCopy(state, self, index);
+  return self->bufferIds[index];
+}
@@ -0,0 +1,88 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(VISUALS_GL_UNIFORMBUFFER_H_INCLUDED)
+#define VISUALS_GL_UNIFORMBUFFER_H_INCLUDED
+
+#include "Visuals/UniformBuffer.h"
+#include "Visuals/Gl/FramesInFlight.h"
+#include "Visuals/Gl/ServiceGl.h"
+
+/// @brief
+/// The implementation of Visuals.UniformBuffer for OpenGL.
+/// @details
+/// bufferIds are the OpenGL representation of the uniform data.
+/// There is one copy of the uniform data per frame in flight.
+/// The data is written to the copy of the frame in progress, which is not in use by the GPU.
+/// The other copies receive the modified ranges when their frames are in progress.
+/// Visuals_Context_setUniformBuffer binds the copy of the frame in progress.
+/// Hence a uniform buffer must be bound in each frame it is used in.
+/// @details
+/// The type is
+/// @code
+/// class Visuals.Gl.UniformBuffer
+/// @endcode
+/// Its constructor is
+/// @code
+/// Visuals.Gl.UniformBuffer.construct()
+/// @endcode
+Shizu_declareObjectType(Visuals_Gl_UniformBuffer);
+
+struct Visuals_Gl_UniformBuffer_Dispatch {
+  Visuals_UniformBuffer_Dispatch _parent;
+};
+
+struct Visuals_Gl_UniformBuffer {
+  Visuals_UniformBuffer parent;
+  /// @brief The OpenGL IDs of the copies of the uniform buffer.
+  /// The first @a numberOfCopies elements are valid if the uniform buffer is materialized.
+  GLuint bufferIds[Visuals_Gl_FramesInFlight_MaximalNumberOfFrames];
+  /// @brief The number of copies. @a 0 if the uniform buffer is not materialized.
+  size_t numberOfCopies;
+  /// @brief The sizes, in Bytes, the buffer storages of the copies were created with.
+  /// @a SIZE_MAX if the buffer storage of a copy was not created yet.
+  size_t sizes[Visuals_Gl_FramesInFlight_MaximalNumberOfFrames];
+  /// @brief The ranges [begin, end) of the data not written to the copies yet.
+  /// A range is empty if begin is greater than or equal to end.
+  size_t dirtyBegins[Visuals_Gl_FramesInFlight_MaximalNumberOfFrames];
+  size_t dirtyEnds[Visuals_Gl_FramesInFlight_MaximalNumberOfFrames];
+};
+
+Visuals_Gl_UniformBuffer*
+Visuals_Gl_UniformBuffer_create
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Get the copy of the uniform data of the frame in progress.
+/// The copy is updated if the data was modified since the copy was written.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this uniform buffer.
+/// @return The OpenGL ID of the copy. @a 0 if this uniform buffer is not materialized.
+GLuint
+Visuals_Gl_UniformBuffer_getCurrentBufferId
+  (
+    Shizu_State2* state,
+    Visuals_Gl_UniformBuffer* self
+  );
+
+#endif // VISUALS_GL_UNIFORMBUFFER_H_INCLUDED
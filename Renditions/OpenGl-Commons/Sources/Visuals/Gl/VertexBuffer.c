@@ -21,6 +21,9 @@
 
 #include "Visuals/Gl/VertexBuffer.h"
 
+// memcpy
+#include <string.h>
+
 static void
 Visuals_Gl_VertexBuffer_finalize
   (
@@ -47,7 +50,26 @@ Visuals_Gl_VertexBuffer_setDataImpl
   (
     Shizu_State2* state,
     Visuals_Gl_VertexBuffer* self,
-    uint8_t flags,
+    uint16_t flags,
+    void const* bytes,
+    size_t numberOfBytes
+  );
+
+static void
+Visuals_Gl_VertexBuffer_adoptDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_VertexBuffer* self,
+    uint16_t flags,
+    void* bytes,
+    size_t numberOfBytes
+  );
+
+static void
+Visuals_Gl_VertexBuffer_upload
+  (
+    Shizu_State2* state,
+    Visuals_Gl_VertexBuffer* self,
     void const* bytes,
     size_t numberOfBytes
   );
@@ -83,6 +105,21 @@ static Shizu_ObjectTypeDescriptor const Visuals_Gl_VertexBuffer_Type = {
 
 Shizu_defineObjectType("Zeitgeist.Visuals.Gl.VertexBuffer", Visuals_Gl_VertexBuffer, Visuals_VertexBuffer);
 
+// Delete the fences guarding the segments of the persistently mapped buffer storage.
+static void
+Visuals_Gl_VertexBuffer_deleteFences
+  (
+    Visuals_Gl_VertexBuffer* self
+  )
+{
+  for (size_t i = 0; i < Visuals_Gl_VertexBuffer_MaximalNumberOfSegments; ++i) {
+    if (self->fences[i]) {
+      glDeleteSync(self->fences[i]);
+      self->fences[i] = 0;
+    }
+  }
+}
+
 static void
 Visuals_Gl_VertexBuffer_finalize
   (
@@ -90,6 +127,10 @@ Visuals_Gl_VertexBuffer_finalize
     Visuals_Gl_VertexBuffer* self
   )
 {
+  Visuals_Gl_Service_statistics.numberOfLiveVertexBuffers--;
+  Visuals_Gl_VertexBuffer_deleteFences(self);
+  // Deleting the buffer unmaps the buffer storage.
+  self->mappedBytes = NULL;
   if (self->vertexArrayId) {
     glDeleteVertexArrays(1, &self->vertexArrayId);
     self->vertexArrayId = 0;
@@ -123,6 +164,15 @@ Visuals_Gl_VertexBuffer_materializeImpl
       Shizu_State2_setStatus(state, 1);
       Shizu_State2_jump(state);
     }
+    // Restore the vertex data if the vertex buffer is materialized again.
+    Visuals_VertexBuffer* parent = (Visuals_VertexBuffer*)self;
+    if (parent->numberOfBytes > 0) {
+      if (parent->bytes) {
+        Visuals_Gl_VertexBuffer_upload(state, self, parent->bytes, parent->numberOfBytes);
+      } else if (Visuals_VertexBufferRetention_Refetch == parent->retention && parent->fetchCallback) {
+        parent->fetchCallback(state, parent, parent->fetchContext);
+      }
+    }
   }
 }
 
@@ -133,6 +183,16 @@ Visuals_Gl_VertexBuffer_unmaterializeImpl
     Visuals_Gl_VertexBuffer* self
   )
 {
+  Visuals_Gl_VertexBuffer_deleteFences(self);
+  // Deleting the buffer unmaps the buffer storage.
+  self->mappedBytes = NULL;
+  self->segmentCapacity = 0;
+  self->numberOfSegments = 0;
+  self->segmentIndex = 0;
+  self->storageUsage = 0;
+  self->bufferOffset = 0;
+  self->attributeFlags = 0;
+  self->attributeOffset = 0;
   if (self->vertexArrayId) {
     glDeleteVertexArrays(1, &self->vertexArrayId);
     self->vertexArrayId = 0;
@@ -143,6 +203,103 @@ Visuals_Gl_VertexBuffer_unmaterializeImpl
   }
 }
 
+// Replace the buffer by a new buffer.
+// Required if the usage changes as a buffer storage created by glBufferStorage is immutable.
+static void
+Visuals_Gl_VertexBuffer_recreateStorage
+  (
+    Shizu_State2* state,
+    Visuals_Gl_VertexBuffer* self
+  )
+{
+  Visuals_Gl_VertexBuffer_deleteFences(self);
+  // Deleting the buffer unmaps the buffer storage.
+  self->mappedBytes = NULL;
+  self->segmentCapacity = 0;
+  self->numberOfSegments = 0;
+  self->segmentIndex = 0;
+  self->storageUsage = 0;
+  self->bufferOffset = 0;
+  GLuint bufferId = 0;
+  while (glGetError()) { }
+  glGenBuffers(1, &bufferId);
+  if (glGetError()) {
+    fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, "glGenBuffers");
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+  glDeleteBuffers(1, &self->bufferId);
+  self->bufferId = bufferId;
+  // The vertex array refers to the old buffer.
+  self->attributeFlags = 0;
+  self->attributeOffset = 0;
+}
+
+// Write the vertex data to the next segment of the persistently mapped buffer storage.
+// The buffer storage is (re)created if it does not exist or if the vertex data does not fit into a segment.
+static void
+Visuals_Gl_VertexBuffer_writeRing
+  (
+    Shizu_State2* state,
+    Visuals_Gl_VertexBuffer* self,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{
+  uint8_t usage = ((Visuals_VertexBuffer*)self)->usage;
+  if (self->storageUsage != usage || !self->mappedBytes || self->segmentCapacity < numberOfBytes) {
+    // Segments are aligned to 256 Bytes and grow by a factor of 2.
+    size_t segmentCapacity = self->segmentCapacity > 0 ? self->segmentCapacity : 256;
+    while (segmentCapacity < numberOfBytes) {
+      segmentCapacity *= 2;
+    }
+    if (self->storageUsage) {
+      Visuals_Gl_VertexBuffer_recreateStorage(state, self);
+    }
+    size_t numberOfSegments = Visuals_Gl_FramesInFlight_getNumberOfFrames(state) + 1;
+    GLbitfield const flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    while (glGetError()) { }
+    glBindBuffer(GL_ARRAY_BUFFER, self->bufferId);
+    glBufferStorage(GL_ARRAY_BUFFER, segmentCapacity * numberOfSegments, NULL, flags);
+    self->mappedBytes = glMapBufferRange(GL_ARRAY_BUFFER, 0, segmentCapacity * numberOfSegments, flags);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (glGetError() || !self->mappedBytes) {
+      fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, "glBufferStorage/glMapBufferRange");
+      self->mappedBytes = NULL;
+      Shizu_State2_setStatus(state, 1);
+      Shizu_State2_jump(state);
+    }
+    self->storageUsage = usage;
+    self->segmentCapacity = segmentCapacity;
+    self->numberOfSegments = numberOfSegments;
+    // The first write goes to segment 0.
+    self->segmentIndex = numberOfSegments - 1;
+  }
+  // All draws reading from the current segment were issued: Guard the current segment by a fence.
+  if (self->fences[self->segmentIndex]) {
+    glDeleteSync(self->fences[self->segmentIndex]);
+  }
+  self->fences[self->segmentIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  // Advance to the next segment and wait until the GPU finished reading from it.
+  self->segmentIndex = (self->segmentIndex + 1) % self->numberOfSegments;
+  GLsync fence = self->fences[self->segmentIndex];
+  if (fence) {
+    GLenum result;
+    do {
+      result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_C(1000000));
+    } while (GL_TIMEOUT_EXPIRED == result);
+    glDeleteSync(fence);
+    self->fences[self->segmentIndex] = 0;
+    if (GL_WAIT_FAILED == result) {
+      fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, "glClientWaitSync");
+      Shizu_State2_setStatus(state, 1);
+      Shizu_State2_jump(state);
+    }
+  }
+  self->bufferOffset = self->segmentIndex * self->segmentCapacity;
+  memcpy((char*)self->mappedBytes + self->bufferOffset, bytes, numberOfBytes);
+}
+
 #define VertexElementSyntax_Float32_1 (1)
 #define VertexElementSyntax_Float32_3 (2)
 #define VertexElementSemantics_Position (4)
@@ -153,55 +310,26 @@ Visuals_Gl_VertexBuffer_unmaterializeImpl
 #define VertexElementSemantics_Shininess (128)
 
 static void
-Visuals_Gl_VertexBuffer_setDataImpl
+Visuals_Gl_VertexBuffer_specifyAttributes
   (
     Shizu_State2* state,
     Visuals_Gl_VertexBuffer* self,
-    uint8_t flags,
-    void const* bytes,
-    size_t numberOfBytes
+    uint16_t flags,
+    size_t vertexSize,
+    size_t baseOffset
   )
 {
-  Shizu_Type* parentType = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), ((Shizu_Object*)self)->type);
-  Visuals_VertexBuffer_Dispatch* parentDispatch = (Visuals_VertexBuffer_Dispatch*)Shizu_Types_getDispatch(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), parentType);
-  parentDispatch->setData(state, (Visuals_VertexBuffer*)self, flags, bytes, numberOfBytes);
-
   static const GLint POSITION_INDEX = 0;
   static const GLint NORMAL_INDEX = 1;
   static const GLint AMBIENT_COLOR_INDEX = 2;
   static const GLint DIFFUSE_COLOR_INDEX = 3;
   static const GLint SPECULAR_COLOR_INDEX = 4;
   static const GLint SHININESSS_INDEX = 5;
-
-  size_t vertexSize = 0;
-  switch (((Visuals_VertexBuffer*)self)->flags) {
-    case (Visuals_VertexSemantics_PositionXyz | Visuals_VertexSyntactics_Float3): {
-      vertexSize = sizeof(float) * 3;
-    } break;
-    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb | Visuals_VertexSyntactics_Float3_Float3_Float3): {
-      vertexSize = sizeof(float) * 9;
-    } break;
-    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess | Visuals_VertexSyntactics_Float3_Float3_Float3_Float3_Float3_Float): {
-      vertexSize = sizeof(float) * 3 + sizeof(float) * 3 + sizeof(float) * 3 + sizeof(float) * 3 + sizeof(float) * 3 + sizeof(float);
-    } break;
-    default: {
-      fprintf(stderr, "%s:%d: unreachable code reached\n", __FILE__, __LINE__);
-      Shizu_State2_setStatus(state, 1);
-      Shizu_State2_jump(state);
-    } break;
-  };
-
-  // Compute number of vertices.
-  size_t numberOfVertices = ((Visuals_VertexBuffer*)self)->numberOfVertices;
-
-  Visuals_Object_materialize(state, (Visuals_Object*)self);
-
-  // Store the data in the buffer.
-  glBindBuffer(GL_ARRAY_BUFFER, self->bufferId);
-  glBufferData(GL_ARRAY_BUFFER, numberOfBytes, bytes, GL_STATIC_DRAW);
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  static const GLint TEXTURE_COORDINATE_INDEX = 10;
+  static const GLint MATERIAL_INDEX_INDEX = 11;
 
   glBindVertexArray(self->vertexArrayId);
+  Visuals_Gl_Service_statistics.numberOfVertexArrayBinds++;
   glBindBuffer(GL_ARRAY_BUFFER, self->bufferId);
 
   typedef struct VertexElementDesc {
@@ -221,7 +349,7 @@ Visuals_Gl_VertexBuffer_setDataImpl
         },
       };
 
-      size_t offset = 0;
+      size_t offset = baseOffset;
 
       glEnableVertexAttribArray(POSITION_INDEX);
       glVertexAttribPointer(POSITION_INDEX,
@@ -252,7 +380,7 @@ Visuals_Gl_VertexBuffer_setDataImpl
         },
       };
 
-      size_t offset = 0;
+      size_t offset = baseOffset;
 
       glEnableVertexAttribArray(POSITION_INDEX);
       glVertexAttribPointer(POSITION_INDEX,
@@ -316,7 +444,7 @@ Visuals_Gl_VertexBuffer_setDataImpl
         },
       };
 
-      size_t offset = 0;
+      size_t offset = baseOffset;
 
       glEnableVertexAttribArray(POSITION_INDEX);
       glVertexAttribPointer(POSITION_INDEX,
@@ -372,6 +500,51 @@ Visuals_Gl_VertexBuffer_setDataImpl
                             (void*)(uintptr_t)offset);
       offset += sizeof(float) * 1;
     } break;
+    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_MaterialIndex | Visuals_VertexSyntactics_Float3_Int2101010_UInt16):
+    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_TextureUv_MaterialIndex | Visuals_VertexSyntactics_Float3_Int2101010_Half2_UInt16): {
+      size_t offset = baseOffset;
+
+      glEnableVertexAttribArray(POSITION_INDEX);
+      glVertexAttribPointer(POSITION_INDEX,
+                            3,
+                            GL_FLOAT,
+                            GL_FALSE,
+                            vertexSize,
+                            (void*)(uintptr_t)offset);
+      offset += sizeof(float) * 3;
+
+      glEnableVertexAttribArray(NORMAL_INDEX);
+      glVertexAttribPointer(NORMAL_INDEX,
+                            4,
+                            GL_INT_2_10_10_10_REV,
+                            GL_TRUE,
+                            vertexSize,
+                            (void*)(uintptr_t)offset);
+      offset += sizeof(uint32_t);
+
+      if (flags == (Visuals_VertexSemantics_PositionXyz_NormalXyz_TextureUv_MaterialIndex | Visuals_VertexSyntactics_Float3_Int2101010_Half2_UInt16)) {
+        glEnableVertexAttribArray(TEXTURE_COORDINATE_INDEX);
+        glVertexAttribPointer(TEXTURE_COORDINATE_INDEX,
+                              2,
+                              GL_HALF_FLOAT,
+                              GL_FALSE,
+                              vertexSize,
+                              (void*)(uintptr_t)offset);
+        offset += sizeof(uint16_t) * 2;
+      }
+
+      glEnableVertexAttribArray(MATERIAL_INDEX_INDEX);
+      glVertexAttribIPointer(MATERIAL_INDEX_INDEX,
+                             1,
+                             GL_UNSIGNED_SHORT,
+                             vertexSize,
+                             (void*)(uintptr_t)offset);
+      offset += sizeof(uint16_t) * 2;
+    } break;
+    case (Visuals_VertexSemantics_Transform3x4_MaterialIndex | Visuals_VertexSyntactics_Float4_Float4_Float4_UInt32): {
+      // Instance data is bound to the vertex array of the instanced vertex buffer when rendering.
+      // See Visuals_Gl_VertexBuffer_bindInstanceAttributes.
+    } break;
     default: {
       fprintf(stderr, "%s:%d: unreachable code reached\n", __FILE__, __LINE__);
       Shizu_State2_setStatus(state, 1);
@@ -381,6 +554,189 @@ Visuals_Gl_VertexBuffer_setDataImpl
 
   glBindBuffer(GL_ARRAY_BUFFER, 0);
   glBindVertexArray(0);
+
+  self->attributeFlags = flags;
+  self->attributeOffset = baseOffset;
+}
+
+static void
+Visuals_Gl_VertexBuffer_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_VertexBuffer* self,
+    uint16_t flags,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{
+  Shizu_Type* parentType = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), ((Shizu_Object*)self)->type);
+  Visuals_VertexBuffer_Dispatch* parentDispatch = (Visuals_VertexBuffer_Dispatch*)Shizu_Types_getDispatch(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), parentType);
+  parentDispatch->setData(state, (Visuals_VertexBuffer*)self, flags, bytes, numberOfBytes);
+  Visuals_Gl_VertexBuffer_upload(state, self, bytes, numberOfBytes);
+}
+
+static void
+Visuals_Gl_VertexBuffer_adoptDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Gl_VertexBuffer* self,
+    uint16_t flags,
+    void* bytes,
+    size_t numberOfBytes
+  )
+{
+  Shizu_Type* parentType = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), ((Shizu_Object*)self)->type);
+  Visuals_VertexBuffer_Dispatch* parentDispatch = (Visuals_VertexBuffer_Dispatch*)Shizu_Types_getDispatch(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), parentType);
+  parentDispatch->adoptData(state, (Visuals_VertexBuffer*)self, flags, bytes, numberOfBytes);
+  Visuals_Gl_VertexBuffer_upload(state, self, ((Visuals_VertexBuffer*)self)->bytes, numberOfBytes);
+  Visuals_VertexBuffer_applyRetention(state, (Visuals_VertexBuffer*)self);
+}
+
+// Upload the vertex data to the buffer and specify the attributes of the vertex array.
+// The format of the vertex data is the format of this vertex buffer.
+static void
+Visuals_Gl_VertexBuffer_upload
+  (
+    Shizu_State2* state,
+    Visuals_Gl_VertexBuffer* self,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{
+  uint16_t flags = ((Visuals_VertexBuffer*)self)->flags;
+  size_t vertexSize = 0;
+  switch (flags) {
+    case (Visuals_VertexSemantics_PositionXyz | Visuals_VertexSyntactics_Float3): {
+      vertexSize = sizeof(float) * 3;
+    } break;
+    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb | Visuals_VertexSyntactics_Float3_Float3_Float3): {
+      vertexSize = sizeof(float) * 9;
+    } break;
+    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess | Visuals_VertexSyntactics_Float3_Float3_Float3_Float3_Float3_Float): {
+      vertexSize = sizeof(float) * 3 + sizeof(float) * 3 + sizeof(float) * 3 + sizeof(float) * 3 + sizeof(float) * 3 + sizeof(float);
+    } break;
+    case (Visuals_VertexSemantics_Transform3x4_MaterialIndex | Visuals_VertexSyntactics_Float4_Float4_Float4_UInt32): {
+      vertexSize = sizeof(float) * 4 + sizeof(float) * 4 + sizeof(float) * 4 + sizeof(uint32_t);
+    } break;
+    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_MaterialIndex | Visuals_VertexSyntactics_Float3_Int2101010_UInt16): {
+      vertexSize = sizeof(float) * 3 + sizeof(uint32_t) + sizeof(uint16_t) * 2;
+    } break;
+    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_TextureUv_MaterialIndex | Visuals_VertexSyntactics_Float3_Int2101010_Half2_UInt16): {
+      vertexSize = sizeof(float) * 3 + sizeof(uint32_t) + sizeof(uint16_t) * 2 + sizeof(uint16_t) * 2;
+    } break;
+    default: {
+      fprintf(stderr, "%s:%d: unreachable code reached\n", __FILE__, __LINE__);
+      Shizu_State2_setStatus(state, 1);
+      Shizu_State2_jump(state);
+    } break;
+  };
+
+  Visuals_Object_materialize(state, (Visuals_Object*)self);
+
+  // Store the data in the buffer.
+  uint8_t usage = ((Visuals_VertexBuffer*)self)->usage;
+  if (Visuals_VertexBufferUsage_Static == usage) {
+    if (self->storageUsage && self->storageUsage != usage) {
+      Visuals_Gl_VertexBuffer_recreateStorage(state, self);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, self->bufferId);
+    glBufferData(GL_ARRAY_BUFFER, numberOfBytes, bytes, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    self->storageUsage = usage;
+    self->bufferOffset = 0;
+  } else if (glBufferStorage) {
+    Visuals_Gl_VertexBuffer_writeRing(state, self, bytes, numberOfBytes);
+  } else {
+    if (self->storageUsage && self->storageUsage != usage) {
+      Visuals_Gl_VertexBuffer_recreateStorage(state, self);
+    }
+    // Orphan the buffer storage such that the driver does not need to wait for pending draws.
+    glBindBuffer(GL_ARRAY_BUFFER, self->bufferId);
+    glBufferData(GL_ARRAY_BUFFER, numberOfBytes, NULL, Visuals_VertexBufferUsage_Dynamic == usage ? GL_DYNAMIC_DRAW : GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, numberOfBytes, bytes);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    self->storageUsage = usage;
+    self->bufferOffset = 0;
+  }
+  Visuals_Gl_Service_statistics.numberOfBufferBytesUploaded += numberOfBytes;
+
+  // Only specify the attributes if the vertex format or the offset of the vertex data changed.
+  if (self->attributeFlags != flags || self->attributeOffset != self->bufferOffset) {
+    Visuals_Gl_VertexBuffer_specifyAttributes(state, self, flags, vertexSize, self->bufferOffset);
+  }
+}
+
+#define INSTANCE_TRANSFORM_ROW0_INDEX (6)
+#define INSTANCE_TRANSFORM_ROW1_INDEX (7)
+#define INSTANCE_TRANSFORM_ROW2_INDEX (8)
+#define INSTANCE_MATERIAL_INDEX_INDEX (9)
+
+void
+Visuals_Gl_VertexBuffer_bindInstanceAttributes
+  (
+    Shizu_State2* state,
+    Visuals_Gl_VertexBuffer* self
+  )
+{
+  if (((Visuals_VertexBuffer*)self)->flags != (Visuals_VertexSemantics_Transform3x4_MaterialIndex | Visuals_VertexSyntactics_Float4_Float4_Float4_UInt32)) {
+    fprintf(stderr, "%s:%d: vertex buffer is not an instance buffer\n", __FILE__, __LINE__);
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  if (!self->bufferId) {
+    Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+    Shizu_State2_jump(state);
+  }
+  size_t const instanceSize = sizeof(float) * 4 + sizeof(float) * 4 + sizeof(float) * 4 + sizeof(uint32_t);
+  static const GLuint TRANSFORM_INDICES[] = {
+    INSTANCE_TRANSFORM_ROW0_INDEX,
+    INSTANCE_TRANSFORM_ROW1_INDEX,
+    INSTANCE_TRANSFORM_ROW2_INDEX,
+  };
+
+  glBindBuffer(GL_ARRAY_BUFFER, self->bufferId);
+
+  size_t offset = self->bufferOffset;
+  for (size_t i = 0; i < 3; ++i) {
+    glEnableVertexAttribArray(TRANSFORM_INDICES[i]);
+    glVertexAttribPointer(TRANSFORM_INDICES[i],
+                          4,
+                          GL_FLOAT,
+                          GL_FALSE,
+                          instanceSize,
+                          (void*)(uintptr_t)offset);
+    glVertexAttribDivisor(TRANSFORM_INDICES[i], 1);
+    offset += sizeof(float) * 4;
+  }
+
+  glEnableVertexAttribArray(INSTANCE_MATERIAL_INDEX_INDEX);
+  glVertexAttribIPointer(INSTANCE_MATERIAL_INDEX_INDEX,
+                         1,
+                         GL_UNSIGNED_INT,
+                         instanceSize,
+                         (void*)(uintptr_t)offset);
+  glVertexAttribDivisor(INSTANCE_MATERIAL_INDEX_INDEX, 1);
+  offset += sizeof(uint32_t);
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void
+Visuals_Gl_VertexBuffer_unbindInstanceAttributes
+  (
+    Shizu_State2* state
+  )
+{
+  static const GLuint INDICES[] = {
+    INSTANCE_TRANSFORM_ROW0_INDEX,
+    INSTANCE_TRANSFORM_ROW1_INDEX,
+    INSTANCE_TRANSFORM_ROW2_INDEX,
+    INSTANCE_MATERIAL_INDEX_INDEX,
+  };
+  for (size_t i = 0; i < 4; ++i) {
+    glVertexAttribDivisor(INDICES[i], 0);
+    glDisableVertexAttribArray(INDICES[i]);
+  }
 }
 
 static void
@@ -392,7 +748,8 @@ Visuals_Gl_VertexBuffer_dispatchInitialize
 {
   ((Visuals_Object_Dispatch*)self)->materialize = (void(*)(Shizu_State2*,Visuals_Object*)) & Visuals_Gl_VertexBuffer_materializeImpl;
   ((Visuals_Object_Dispatch*)self)->unmaterialize = (void(*)(Shizu_State2*,Visuals_Object*)) & Visuals_Gl_VertexBuffer_unmaterializeImpl;
-  ((Visuals_VertexBuffer_Dispatch*)self)->setData = (void(*)(Shizu_State2*, Visuals_VertexBuffer*, uint8_t,void const*,size_t)) & Visuals_Gl_VertexBuffer_setDataImpl;
+  ((Visuals_VertexBuffer_Dispatch*)self)->setData = (void(*)(Shizu_State2*, Visuals_VertexBuffer*, uint16_t,void const*,size_t)) & Visuals_Gl_VertexBuffer_setDataImpl;
+  ((Visuals_VertexBuffer_Dispatch*)self)->adoptData = (void(*)(Shizu_State2*, Visuals_VertexBuffer*, uint16_t,void*,size_t)) & Visuals_Gl_VertexBuffer_adoptDataImpl;
 }
 
 static void
@@ -418,7 +775,19 @@ Visuals_Gl_VertexBuffer_constructImpl
   }
   SELF->bufferId = 0;
   SELF->vertexArrayId = 0;
+  SELF->storageUsage = 0;
+  SELF->mappedBytes = NULL;
+  SELF->segmentCapacity = 0;
+  SELF->numberOfSegments = 0;
+  SELF->segmentIndex = 0;
+  for (size_t i = 0; i < Visuals_Gl_VertexBuffer_MaximalNumberOfSegments; ++i) {
+    SELF->fences[i] = 0;
+  }
+  SELF->bufferOffset = 0;
+  SELF->attributeFlags = 0;
+  SELF->attributeOffset = 0;
   ((Shizu_Object*)SELF)->type = TYPE;
+  Visuals_Gl_Service_statistics.numberOfLiveVertexBuffers++;
 }
 
 Visuals_Gl_VertexBuffer*
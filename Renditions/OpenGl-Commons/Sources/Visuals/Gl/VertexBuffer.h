@@ -23,12 +23,27 @@
 #define VISUALS_GL_VERTEXBUFFER_H_INCLUDED
 
 #include "Visuals/VertexBuffer.h"
+#include "Visuals/Gl/FramesInFlight.h"
 #include "Visuals/Gl/ServiceGl.h"
 
+/// @brief The maximal number of segments of the buffer storage of dynamic and stream vertex buffers.
+/// Each time the vertex data is specified, it is written to the next segment.
+/// @remarks
+/// The buffer storage has one segment more than there are frames in flight.
+/// The segment read by a frame is guarded by a fence created when the next segment is written i.e., in the next frame at the earliest.
+/// With one segment per frame in flight, that fence would not be signaled when the CPU waited for the frame which read the segment.
+#define Visuals_Gl_VertexBuffer_MaximalNumberOfSegments (Visuals_Gl_FramesInFlight_MaximalNumberOfFrames + 1)
+
 /// @brief
 /// The implementation of Visuals.VertexBuffer for OpenGL.
 /// @details
 /// bufferId and vertexArrayId are the OpenGL representation of the vertices.
+/// @details
+/// Static vertex data is stored by glBufferData with GL_STATIC_DRAW.
+/// Dynamic and stream vertex data is written to a persistently mapped ring of
+/// segments, one more than there are frames in flight, if GL_ARB_buffer_storage is supported.
+/// A segment is guarded by a fence and is only overwritten after the GPU finished rendering from it.
+/// Otherwise, the buffer storage is orphaned each time the vertex data is specified.
 /// The type is
 /// @code
 /// class Visuals.Gl.VertexBuffer
@@ -49,6 +64,26 @@ struct Visuals_Gl_VertexBuffer {
   GLuint bufferId;
   /// @brief The OpenGL ID of the vertex array.
   GLuint vertexArrayId;
+  /// @brief The usage the buffer storage was created for.
+  /// @a 0 if the buffer storage was not created yet.
+  uint8_t storageUsage;
+  /// @brief A pointer to the persistently mapped buffer storage or the null pointer.
+  void* mappedBytes;
+  /// @brief The capacity, in Bytes, of a segment of the persistently mapped buffer storage.
+  size_t segmentCapacity;
+  /// @brief The number of segments of the persistently mapped buffer storage.
+  size_t numberOfSegments;
+  /// @brief The index of the segment of the persistently mapped buffer storage containing the current vertex data.
+  size_t segmentIndex;
+  /// @brief The fences guarding the segments of the persistently mapped buffer storage.
+  GLsync fences[Visuals_Gl_VertexBuffer_MaximalNumberOfSegments];
+  /// @brief The offset, in Bytes, of the current vertex data in the buffer storage.
+  size_t bufferOffset;
+  /// @brief The vertex format the attributes of the vertex array were specified for.
+  /// @a 0 if the attributes were not specified yet.
+  uint16_t attributeFlags;
+  /// @brief The offset, in Bytes, the attributes of the vertex array were specified for.
+  size_t attributeOffset;
 };
 
 Visuals_Gl_VertexBuffer*
@@ -57,4 +92,26 @@ Visuals_Gl_VertexBuffer_create
     Shizu_State2* state
   );
 
+/// @brief Bind the per-instance attributes of this vertex buffer to the currently bound vertex array.
+/// @details
+/// The vertex buffer must be of the format
+/// Visuals_VertexSemantics_Transform3x4_MaterialIndex | Visuals_VertexSyntactics_Float4_Float4_Float4_UInt32.
+/// The rows of the transform are bound to the attribute locations 6, 7, and 8,
+/// the material index is bound to the attribute location 9.
+/// The divisor of these attributes is set to @a 1.
+void
+Visuals_Gl_VertexBuffer_bindInstanceAttributes
+  (
+    Shizu_State2* state,
+    Visuals_Gl_VertexBuffer* self
+  );
+
+/// @brief Disable the per-instance attributes in the currently bound vertex array.
+/// @details Resets the divisor of these attributes to @a 0.
+void
+Visuals_Gl_VertexBuffer_unbindInstanceAttributes
+  (
+    Shizu_State2* state
+  );
+
 #endif // VISUALS_GL_VERTEXBUFFER_H_INCLUDED
@@ -1311,9 +1311,10 @@ startup
 	//
 	ShowWindow(g_hWnd, SW_SHOW);
 	//
+	// OpenGL 3.3 core is the minimum version (see ServiceGl_Functions.i).
 	const int contextAttribs[] = {
-		WGL_CONTEXT_MAJOR_VERSION_ARB, 4,
-		WGL_CONTEXT_MINOR_VERSION_ARB, 1,
+		WGL_CONTEXT_MAJOR_VERSION_ARB, 3,
+		WGL_CONTEXT_MINOR_VERSION_ARB, 3,
 		WGL_CONTEXT_FLAGS_ARB, WGL_CONTEXT_FORWARD_COMPATIBLE_BIT_ARB,
 		WGL_CONTEXT_PROFILE_MASK_ARB, WGL_CONTEXT_CORE_PROFILE_BIT_ARB,
 		0
@@ -1494,6 +1495,28 @@ Visuals_Gl_Wgl_Service_beginFrame
 	)
 {/*Intentionally empty.*/}
 
+Shizu_Boolean
+Visuals_Gl_Wgl_Service_setSwapInterval
+	(
+		Shizu_State2* state,
+		Shizu_Integer32 interval
+	)
+{
+	char const* extensionNames = wglGetExtensionsStringARB(g_hDc);
+	if (!extensionNames || !isExtensionSupported(extensionNames, "WGL_EXT_swap_control")) {
+		return Shizu_Boolean_False;
+	}
+	// Without WGL_EXT_swap_control_tear, late swaps are synchronized.
+	if (interval < 0 && !isExtensionSupported(extensionNames, "WGL_EXT_swap_control_tear")) {
+		interval = -interval;
+	}
+	PFNWGLSWAPINTERVALEXTPROC wglSwapIntervalEXT = (PFNWGLSWAPINTERVALEXTPROC)wglGetProcAddress("wglSwapIntervalEXT");
+	if (!wglSwapIntervalEXT || !wglSwapIntervalEXT(interval)) {
+		return Shizu_Boolean_False;
+	}
+	return Shizu_Boolean_True;
+}
+
 void
 Visuals_Gl_Wgl_Service_endFrame
 	(
@@ -109,6 +109,20 @@ Visuals_Gl_Wgl_Service_beginFrame
 		Shizu_State2* state
 	);
 
+/// @brief Set the number of vertical blanks to wait for before a swap of the buffers.
+/// @param state A pointer to the Shizu_State2 value.
+/// @param interval The number of vertical blanks.
+/// @a 0 does not wait.
+/// A negative value waits for -@a interval vertical blanks unless the swap is late which swaps immediately (adaptive synchronization).
+/// @return @a true if the swap interval was set, @a false if the WGL_EXT_swap_control extension is not available.
+/// @remarks If WGL_EXT_swap_control_tear is not available, a negative value waits for -@a interval vertical blanks.
+Shizu_Boolean
+Visuals_Gl_Wgl_Service_setSwapInterval
+	(
+		Shizu_State2* state,
+		Shizu_Integer32 interval
+	);
+
 void
 Visuals_Gl_Wgl_Service_endFrame
 	(
@@ -28,6 +28,13 @@ Visuals_Program_visit
     Visuals_Program* self
   );
 
+static void
+Visuals_Program_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_Program_Dispatch* self
+  );
+
 static Shizu_ObjectTypeDescriptor const Visuals_Program_Type = {
   .postCreateType = NULL,
   .preDestroyType = NULL,
@@ -36,7 +43,7 @@ static Shizu_ObjectTypeDescriptor const Visuals_Program_Type = {
   .finalize = NULL,
   .visit = (Shizu_OnVisitCallback*)&Visuals_Program_visit,
   .dispatchSize = sizeof(Visuals_Program_Dispatch),
-  .dispatchInitialize = NULL,
+  .dispatchInitialize = (Shizu_OnDispatchInitializeCallback*)&Visuals_Program_dispatchInitialize,
   .dispatchUninitialize = NULL,
 };
 
@@ -57,6 +64,33 @@ Visuals_Program_visit
   }
 }
 
+static void
+Visuals_Program_materializeAsyncImpl
+  (
+    Shizu_State2* state,
+    Visuals_Program* self
+  )
+{ Visuals_Object_materialize(state, (Visuals_Object*)self); }
+
+static Shizu_Boolean
+Visuals_Program_isPendingImpl
+  (
+    Shizu_State2* state,
+    Visuals_Program* self
+  )
+{ return Shizu_Boolean_False; }
+
+static void
+Visuals_Program_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_Program_Dispatch* self
+  )
+{
+  self->materializeAsync = &Visuals_Program_materializeAsyncImpl;
+  self->isPending = &Visuals_Program_isPendingImpl;
+}
+
 void
 Visuals_Program_construct
   (
@@ -41,6 +41,9 @@ struct Visuals_Program_Dispatch {
   void (*bindInteger32)(Shizu_State2* state, Visuals_Program* self, char const* name, Shizu_Integer32 value);
   void (*bindFloat32)(Shizu_State2* state, Visuals_Program* self, char const* name, Shizu_Float32 value);
   void (*bindBoolean)(Shizu_State2* state, Visuals_Program* self, char const* name, Shizu_Boolean value);
+  void (*bindUniformBlock)(Shizu_State2* state, Visuals_Program* self, char const* name, Shizu_Integer32 index);
+  void (*materializeAsync)(Shizu_State2* state, Visuals_Program* self);
+  Shizu_Boolean (*isPending)(Shizu_State2* state, Visuals_Program* self);
 };
 
 struct Visuals_Program {
@@ -118,4 +121,46 @@ Visuals_Program_bindBoolean
   )
 { Shizu_VirtualCall(Visuals_Program, bindBoolean, self, name, value); }
 
+/// @brief Assign a uniform block of this program to a uniform buffer binding point.
+/// @param name The name of the uniform block.
+/// @param index The index of the uniform buffer binding point. Must be non-negative.
+/// @remarks
+/// The assignment is retained by the program and survives the linking of the program.
+/// Hence it is usually made once when the program is created, even if the program is pending.
+static inline void
+Visuals_Program_bindUniformBlock
+  (
+    Shizu_State2* state,
+    Visuals_Program* self,
+    char const* name,
+    Shizu_Integer32 index
+  )
+{ Shizu_VirtualCall(Visuals_Program, bindUniformBlock, self, name, index); }
+
+/// @since 1.0
+/// @brief Begin to materialize this program without waiting for its shaders to be compiled and linked.
+/// @remarks The compilation and the linking continue in the background and are polled by Visuals_Service_update.
+/// While Visuals_Program_isPending returns @a true, using this program waits for the compilation and the linking to complete.
+/// Visuals_Object_materialize waits for the compilation and the linking to complete.
+/// The default implementation calls Visuals_Object_materialize.
+static inline void
+Visuals_Program_materializeAsync
+  (
+    Shizu_State2* state,
+    Visuals_Program* self
+  )
+{ Shizu_VirtualCall(Visuals_Program, materializeAsync, self); }
+
+/// @since 1.0
+/// @brief Get if the compilation and the linking of this program begun by Visuals_Program_materializeAsync are still in progress.
+/// @return @a true if the compilation and the linking are in progress, @a false otherwise.
+/// The default implementation returns @a false.
+static inline Shizu_Boolean
+Visuals_Program_isPending
+  (
+    Shizu_State2* state,
+    Visuals_Program* self
+  )
+{ Shizu_VirtualCallWithReturn(Visuals_Program, isPending, self); }
+
 #endif // VISUALS_PROGRAM_H_INCLUDED
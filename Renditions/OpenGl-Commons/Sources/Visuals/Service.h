@@ -23,6 +23,7 @@
 #define VISUALS_SERVICE_H_INCLUDED
 
 #include "Zeitgeist.h"
+#include "Visuals/Context.h"
 // Forward declaration.
 typedef struct KeyboardKeyMessage KeyboardKeyMessage;
 // Forward declaration.
@@ -80,6 +81,19 @@ Visuals_Service_getClientSize
     Shizu_Integer32* height
   );
 
+/// @since 1.0
+/// @brief Set the size of the canvas of the headless backend.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param width, height The size, in pixels.
+/// @remarks The windowed backends ignore this size as their canvas is the client area of the window.
+void
+Visuals_Service_setCanvasSize
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  );
+
 /// @brief Must be invoked to begin rendering a frame.
 /// @param state A pointer to a Shizu_State2 value.
 void
@@ -98,6 +112,7 @@ Visuals_Service_endFrame
 
 /// @brief Must be invoked in intervals.
 /// @param state A pointer to a Shizu_State2 value.
+/// @remarks Completes the programs of which the compilation and the linking begun by Visuals_Program_materializeAsync completed.
 void
 Visuals_Service_update
   (
@@ -225,4 +240,169 @@ Visuals_Service_getBackendMinorVersion
     Shizu_State2* state
   );
 
+/// @since 1.0
+/// @brief The GPU time spent in a timing scope.
+typedef struct Visuals_GpuTiming {
+  /// @brief The name of the scope. "frame" for the whole frame.
+  char const* name;
+  /// @brief The nesting depth of the scope. @a 0 for the whole frame, @a 1 for the outermost scopes.
+  Shizu_Integer32 depth;
+  /// @brief The GPU time, in milliseconds, spent in the scope.
+  Shizu_Float32 milliseconds;
+} Visuals_GpuTiming;
+
+/// @since 1.0
+/// @brief Begin a named GPU timing scope.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param name A pointer to the name of the scope. The name must live as long as the service e.g., a string literal.
+/// @remarks Scopes can be nested and must be ended before the frame ends.
+/// Scopes outside of Visuals_Service_beginFrame and Visuals_Service_endFrame are not timed.
+void
+Visuals_Service_beginGpuTiming
+  (
+    Shizu_State2* state,
+    char const* name
+  );
+
+/// @since 1.0
+/// @brief End the innermost GPU timing scope.
+/// @param state A pointer to a Shizu_State2 value.
+void
+Visuals_Service_endGpuTiming
+  (
+    Shizu_State2* state
+  );
+
+/// @since 1.0
+/// @brief Get the GPU timings of the most recent frame of which the timings are available.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param timings A pointer to an array of @a maximalNumberOfTimings elements.
+/// @param maximalNumberOfTimings The number of elements of the array.
+/// @return The number of timings. If greater than @a maximalNumberOfTimings, only the first @a maximalNumberOfTimings timings were stored.
+/// @remarks The first timing is the timing of the whole frame followed by the timings of the scopes in the order in which they began.
+/// The timings are read back without stalling and hence lag behind by a few frames.
+/// If the software renderer is selected, no timings are available.
+size_t
+Visuals_Service_getGpuTimings
+  (
+    Shizu_State2* state,
+    Visuals_GpuTiming* timings,
+    size_t maximalNumberOfTimings
+  );
+
+/// @since 1.0
+/// @brief The statistics of a frame.
+/// @remarks The per-frame counters count the work issued from the end of the preceding frame to the end of the frame.
+typedef struct Visuals_FrameStatistics {
+  /// @brief The number of draw calls.
+  size_t numberOfDrawCalls;
+  /// @brief The number of vertices submitted. An indexed draw call submits one vertex per index.
+  size_t numberOfVertices;
+  /// @brief The number of instances submitted. A draw call which is not instanced submits one instance.
+  size_t numberOfInstances;
+  /// @brief The number of program binds.
+  size_t numberOfProgramBinds;
+  /// @brief The number of vertex array binds.
+  size_t numberOfVertexArrayBinds;
+  /// @brief The number of uniform updates issued to the backend.
+  size_t numberOfUniformUpdates;
+  /// @brief The number of uniform updates not issued to the backend as the uniform already had the value.
+  size_t numberOfDeduplicatedUniformUpdates;
+  /// @brief The number of Bytes uploaded to buffers.
+  size_t numberOfBufferBytesUploaded;
+  /// @brief The number of Bytes uploaded to textures.
+  size_t numberOfTextureBytesUploaded;
+  /// @brief The number of frame buffer binds.
+  size_t numberOfFrameBufferBinds;
+  /// @brief The number of objects found to be visible by culling. See Visuals_Service_addCullingStatistics.
+  size_t numberOfVisibleObjects;
+  /// @brief The number of objects rejected by culling. See Visuals_Service_addCullingStatistics.
+  size_t numberOfCulledObjects;
+  /// @brief The resolution scale of the frame. See Visuals_Service_getResolutionScale.
+  Shizu_Float32 resolutionScale;
+  /// @brief The time, in milliseconds, the CPU waited at the beginning of the frame for the GPU to finish an earlier frame.
+  /// The CPU waits if it is the number of frames in flight ahead of the GPU.
+  Shizu_Float32 frameFenceWaitMilliseconds;
+  /// @brief The number of live Visuals_Context objects.
+  size_t numberOfLiveContexts;
+  /// @brief The number of live Visuals_Program objects.
+  size_t numberOfLivePrograms;
+  /// @brief The number of live Visuals_VertexBuffer objects.
+  size_t numberOfLiveVertexBuffers;
+  /// @brief The number of live Visuals_IndexBuffer objects.
+  size_t numberOfLiveIndexBuffers;
+  /// @brief The number of live Visuals_UniformBuffer objects.
+  size_t numberOfLiveUniformBuffers;
+  /// @brief The number of live Visuals_Texture objects.
+  size_t numberOfLiveTextures;
+  /// @brief The number of live Visuals_RenderBuffer objects.
+  size_t numberOfLiveRenderBuffers;
+  /// @brief The number of Bytes of vertex data retained on the CPU by Visuals_VertexBuffer objects.
+  /// See Visuals_VertexBuffer_getNumberOfRetainedBytes.
+  size_t numberOfRetainedVertexBytes;
+} Visuals_FrameStatistics;
+
+/// @since 1.0
+/// @brief Get the statistics of the most recently ended frame.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param statistics A pointer to a Visuals_FrameStatistics value receiving the statistics.
+/// @remarks The counters are maintained by the OpenGL renderer.
+/// If the software renderer is selected, the counters remain zero.
+void
+Visuals_Service_getFrameStatistics
+  (
+    Shizu_State2* state,
+    Visuals_FrameStatistics* statistics
+  );
+
+/// @since 1.0
+/// @brief Add the results of culling to the statistics of the frame in progress.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param numberOfVisibleObjects The number of objects found to be visible.
+/// @param numberOfCulledObjects The number of objects rejected.
+/// @remarks Culling is done by the renditions. Unlike the other counters, these counters are maintained for both renderers.
+void
+Visuals_Service_addCullingStatistics
+  (
+    Shizu_State2* state,
+    size_t numberOfVisibleObjects,
+    size_t numberOfCulledObjects
+  );
+
+/// @since 1.0
+/// @brief Get the resolution at which the next frame is to be rendered.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param scale A pointer to a Shizu_Float32 variable receiving the scale.
+/// The scale is the ratio of the width (and the height) of the image to render to the width (and the height) of the client area.
+/// @param maximumScale A pointer to a Shizu_Float32 variable receiving the maximal scale.
+/// @param filter A pointer to a Visuals_BlitFilter variable receiving the filter with which the image is to be scaled to the client area.
+/// @return @a true if dynamic resolution is enabled, @a false otherwise.
+/// If dynamic resolution is disabled, the scale and the maximal scale are @a 1.
+/// @remarks Dynamic resolution is enabled by the environment variable "ZEITGEIST_VISUALS_DYNAMIC_RESOLUTION" of the form
+/// "<target frames per second>[,<minimal scale>[,<maximal scale>]]". The minimal scale and the maximal scale default to 0.5 and 1.
+/// When a frame ends, the scale is adjusted to the GPU time of the frame or, if GPU timings are not available,
+/// to the time spent between Visuals_Service_beginFrame and Visuals_Service_endFrame.
+/// The filter is selected by the environment variable "ZEITGEIST_VISUALS_UPSCALE": "nearest", "linear" (the default), or "sharpen".
+Shizu_Boolean
+Visuals_Service_getResolutionScale
+  (
+    Shizu_State2* state,
+    Shizu_Float32* scale,
+    Shizu_Float32* maximumScale,
+    Visuals_BlitFilter* filter
+  );
+
+/// @since 1.0
+/// @brief Create a context of the renderer selected at startup.
+/// @param state A pointer to a Shizu_State2 value.
+/// @return A pointer to the Visuals_Context object.
+/// @remarks The renderer is selected by the environment variable "ZEITGEIST_VISUALS_RENDERER".
+/// - "gl" or the empty string selects the OpenGL renderer.
+/// - "software" selects the software renderer.
+Visuals_Context*
+Visuals_Service_createContext
+  (
+    Shizu_State2* state
+  );
+
 #endif // VISUALS_SERVICE_H_INCLUDED
@@ -21,7 +21,10 @@
 
 #include "Visuals/Service.package.h"
 
+#include "Visuals/Parallel.h"
 #include "Visuals/Gl/ServiceGl.h"
+#include "Visuals/Gl/Context.h"
+#include "Visuals/Software/Context.h"
 
 /// @brief The reference count of the "Visuals" service.
 static Shizu_Integer32 g_referenceCount = 0;
@@ -38,7 +41,21 @@ doStartup
   (
     Shizu_State2* state
   )
-{ Visuals_Gl_Service_startup(state); }
+{
+  // The threads of the pool are reused by all parallel work until this service shuts down.
+  // The thread pool does not depend on the backend.
+  Visuals_Parallel_startup();
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Visuals_Gl_Service_startup(state);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Visuals_Parallel_shutdown();
+    Shizu_State2_jump(state);
+  }
+}
 
 static void
 doShutdown
@@ -46,7 +63,9 @@ doShutdown
     Shizu_State2* state
   )
 {
+  // The backend joins its tasks before it shuts down.
   Visuals_Gl_Service_shutdown(state);
+  Visuals_Parallel_shutdown();
   if (g_mousePointerListeners) {
     Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_mousePointerListeners);
     g_mousePointerListeners = NULL;
@@ -110,6 +129,15 @@ Visuals_Service_getClientSize
   )
 { Visuals_Gl_Service_getClientSize(state, width, height); }
 
+void
+Visuals_Service_setCanvasSize
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  )
+{ Visuals_Gl_Service_setCanvasSize(state, width, height); }
+
 void
 Visuals_Service_beginFrame
   (
@@ -347,3 +375,67 @@ Visuals_Service_getBackendMinorVersion
   Shizu_State2* state
 )   {
  return Visuals_Gl_Service_getBackendMinorVersion(state); }
+
+void
+Visuals_Service_beginGpuTiming
+  (
+    Shizu_State2* state,
+    char const* name
+  )
+{ Visuals_Gl_Service_beginGpuTiming(state, name); }
+
+void
+Visuals_Service_endGpuTiming
+  (
+    Shizu_State2* state
+  )
+{ Visuals_Gl_Service_endGpuTiming(state); }
+
+size_t
+Visuals_Service_getGpuTimings
+  (
+    Shizu_State2* state,
+    Visuals_GpuTiming* timings,
+    size_t maximalNumberOfTimings
+  )
+{ return Visuals_Gl_Service_getGpuTimings(state, timings, maximalNumberOfTimings); }
+
+void
+Visuals_Service_getFrameStatistics
+  (
+    Shizu_State2* state,
+    Visuals_FrameStatistics* statistics
+  )
+{ Visuals_Gl_Service_getFrameStatistics(state, statistics); }
+
+void
+Visuals_Service_addCullingStatistics
+  (
+    Shizu_State2* state,
+    size_t numberOfVisibleObjects,
+    size_t numberOfCulledObjects
+  )
+{ Visuals_Gl_Service_addCullingStatistics(state, numberOfVisibleObjects, numberOfCulledObjects); }
+
+Shizu_Boolean
+Visuals_Service_getResolutionScale
+  (
+    Shizu_State2* state,
+    Shizu_Float32* scale,
+    Shizu_Float32* maximumScale,
+    Visuals_BlitFilter* filter
+  )
+{ return Visuals_Gl_Service_getResolutionScale(state, scale, maximumScale, filter); }
+
+Visuals_Context*
+Visuals_Service_createContext
+  (
+    Shizu_State2* state
+  )
+{
+  if (Visuals_Gl_Service_isSoftwareRenderer(state)) {
+    return (Visuals_Context*)Visuals_Software_Context_create(state);
+  } else {
+    return (Visuals_Context*)Visuals_Gl_Context_create(state);
+  }
+}
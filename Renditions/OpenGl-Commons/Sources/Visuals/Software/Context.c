@@ -0,0 +1,1115 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Visuals/Software/Context.h"
+
+#include "Visuals/Parallel.h"
+#include "Visuals/Software/IndexBuffer.h"
+#include "Visuals/Software/Program.h"
+#include "Visuals/Software/RenderBuffer.h"
+#include "Visuals/Software/Texture.h"
+#include "Visuals/Software/UniformBuffer.h"
+#include "Visuals/Software/VertexBuffer.h"
+#include "Visuals/Service.package.h"
+
+// fprintf, stderr
+#include <stdio.h>
+// realloc, free
+#include <malloc.h>
+// memcpy
+#include <string.h>
+
+/// @brief The number of vertices shaded by one invocation of the vertex shading callback.
+#define NumberOfVerticesPerBand (256)
+
+/// @brief The state shared by all software contexts.
+static struct {
+  Visuals_Software_PipelineState pipelineState;
+  float clearColor[4];
+  float clearDepth;
+  /// @brief The uniform buffers bound to the uniform buffer binding points. Locked while bound.
+  Visuals_UniformBuffer* uniformBuffers[Visuals_Software_Context_NumberOfUniformBufferBindings];
+  /// @brief The render buffer rendered to or the null pointer if the default frame buffer is rendered to. Locked while bound.
+  Visuals_Software_RenderBuffer* renderBuffer;
+  Visuals_Software_FrameBuffer defaultFrameBuffer;
+  /// @brief The vertices after the vertex stage.
+  Visuals_Software_Vertex* vertices;
+  size_t vertexCapacity;
+  /// @brief The indices of the triangles after the primitive assembly.
+  uint32_t* indices;
+  size_t indexCapacity;
+} g_device = {
+  .pipelineState = {
+    .cullMode = Visuals_CullMode_None,
+    .depthTest = false,
+    .depthFunction = Visuals_DepthFunction_LessThan,
+    .blend = false,
+    .sourceFactor = Visuals_BlendFactor_SourceAlpha,
+    .targetFactor = Visuals_BlendFactor_OneMinusSourceAlpha,
+    .viewport = { 0, 0, 0, 0 },
+  },
+  .clearColor = { 0.f, 0.f, 0.f, 0.f },
+  .clearDepth = 1.f,
+  .renderBuffer = NULL,
+  .defaultFrameBuffer = { 0, 0, NULL, NULL },
+  .vertices = NULL,
+  .vertexCapacity = 0,
+  .indices = NULL,
+  .indexCapacity = 0,
+};
+
+static void
+Visuals_Software_Context_finalize
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self
+  );
+
+static void
+Visuals_Software_Context_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_Software_Context_Dispatch* self
+  );
+
+static Visuals_Program*
+Visuals_Software_Context_createProgramImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Shizu_String* vertexSource,
+    Shizu_String* fragmentSource
+  );
+
+static Visuals_RenderBuffer*
+Visuals_Software_Context_createRenderBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self
+  );
+
+static Visuals_VertexBuffer*
+Visuals_Software_Context_createVertexBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self
+  );
+
+static Visuals_IndexBuffer*
+Visuals_Software_Context_createIndexBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self
+  );
+
+static Visuals_UniformBuffer*
+Visuals_Software_Context_createUniformBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self
+  );
+
+static Visuals_Texture*
+Visuals_Software_Context_createTextureImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self
+  );
+
+static void
+Visuals_Software_Context_setClearColorImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Shizu_Float32 r,
+    Shizu_Float32 g,
+    Shizu_Float32 b,
+    Shizu_Float32 a
+  );
+
+static void
+Visuals_Software_Context_setClearDepthImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Shizu_Float32 z
+  );
+
+static void
+Visuals_Software_Context_setBlendFactorsImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_BlendFactor source,
+    Visuals_BlendFactor target
+  );
+
+static void
+Visuals_Software_Context_setCullModeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_CullMode cullMode
+  );
+
+static void
+Visuals_Software_Context_setDepthFunctionImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_DepthFunction depthFunction
+  );
+
+static void
+Visuals_Software_Context_setViewportImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Shizu_Float32 left,
+    Shizu_Float32 bottom,
+    Shizu_Float32 width,
+    Shizu_Float32 height
+  );
+
+static void
+Visuals_Software_Context_clearImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Shizu_Boolean colorBuffer,
+    Shizu_Boolean depthBuffer
+  );
+
+static void
+Visuals_Software_Context_setRenderBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_Software_RenderBuffer* renderBuffer
+  );
+
+static void
+Visuals_Software_Context_setUniformBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Shizu_Integer32 index,
+    Visuals_UniformBuffer* uniformBuffer
+  );
+
+static void
+Visuals_Software_Context_renderImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_Software_VertexBuffer* vertexBuffer,
+    Visuals_Software_Program* program
+  );
+
+static void
+Visuals_Software_Context_renderRangesImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_Software_VertexBuffer* vertexBuffer,
+    Shizu_Integer32 const* firsts,
+    Shizu_Integer32 const* counts,
+    size_t numberOfRanges,
+    Visuals_Software_Program* program
+  );
+
+static void
+Visuals_Software_Context_renderIndexedImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_Software_VertexBuffer* vertexBuffer,
+    Visuals_IndexBuffer* indexBuffer,
+    Visuals_PrimitiveType primitiveType,
+    Visuals_Software_Program* program
+  );
+
+static void
+Visuals_Software_Context_renderInstancedImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_Software_VertexBuffer* vertexBuffer,
+    Visuals_Software_VertexBuffer* instanceBuffer,
+    size_t numberOfInstances,
+    Visuals_PrimitiveType primitiveType,
+    Visuals_Software_Program* program
+  );
+
+static void
+Visuals_Software_Context_blitRenderBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_Software_RenderBuffer* renderBuffer,
+    Shizu_Float32 width,
+    Shizu_Float32 height,
+    Visuals_BlitFilter filter
+  );
+
+static void
+Visuals_Software_Context_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  );
+
+static Shizu_ObjectTypeDescriptor const Visuals_Software_Context_Type = {
+  .postCreateType = NULL,
+  .preDestroyType = NULL,
+  .visitType = NULL,
+  .size = sizeof(Visuals_Software_Context),
+  .construct = &Visuals_Software_Context_constructImpl,
+  .finalize = (Shizu_OnFinalizeCallback*)&Visuals_Software_Context_finalize,
+  .visit = NULL,
+  .dispatchSize = sizeof(Visuals_Software_Context_Dispatch),
+  .dispatchInitialize = (Shizu_OnDispatchInitializeCallback*)&Visuals_Software_Context_dispatchInitialize,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Zeitgeist.Visuals.Software.Context", Visuals_Software_Context, Visuals_Context);
+
+static void
+Visuals_Software_Context_finalize
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self
+  )
+{/*Intentionally empty.*/}
+
+static void
+Visuals_Software_Context_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_Software_Context_Dispatch* self
+  )
+{
+  ((Visuals_Context_Dispatch*)self)->createProgram = (Visuals_Program*(*)(Shizu_State2*,Visuals_Context*,Shizu_String*,Shizu_String*)) & Visuals_Software_Context_createProgramImpl;
+  ((Visuals_Context_Dispatch*)self)->createRenderBuffer = (Visuals_RenderBuffer * (*)(Shizu_State2*, Visuals_Context*)) &Visuals_Software_Context_createRenderBufferImpl;
+  ((Visuals_Context_Dispatch*)self)->createVertexBuffer = (Visuals_VertexBuffer * (*)(Shizu_State2*, Visuals_Context*)) &Visuals_Software_Context_createVertexBufferImpl;
+  ((Visuals_Context_Dispatch*)self)->createIndexBuffer = (Visuals_IndexBuffer * (*)(Shizu_State2*, Visuals_Context*)) &Visuals_Software_Context_createIndexBufferImpl;
+  ((Visuals_Context_Dispatch*)self)->createUniformBuffer = (Visuals_UniformBuffer * (*)(Shizu_State2*, Visuals_Context*)) &Visuals_Software_Context_createUniformBufferImpl;
+  ((Visuals_Context_Dispatch*)self)->createTexture = (Visuals_Texture * (*)(Shizu_State2*, Visuals_Context*)) &Visuals_Software_Context_createTextureImpl;
+  ((Visuals_Context_Dispatch*)self)->setClearColor = (void (*)(Shizu_State2*, Visuals_Context*, Shizu_Float32 r, Shizu_Float32 g, Shizu_Float32 b, Shizu_Float32 a)) & Visuals_Software_Context_setClearColorImpl;
+  ((Visuals_Context_Dispatch*)self)->setClearDepth = (void (*)(Shizu_State2*, Visuals_Context*, Shizu_Float32 z)) & Visuals_Software_Context_setClearDepthImpl;
+  ((Visuals_Context_Dispatch*)self)->setBlendFactors = (void (*)(Shizu_State2*, Visuals_Context*, Visuals_BlendFactor, Visuals_BlendFactor)) & Visuals_Software_Context_setBlendFactorsImpl;
+  ((Visuals_Context_Dispatch*)self)->setCullMode = (void (*)(Shizu_State2*, Visuals_Context*, Visuals_CullMode)) & Visuals_Software_Context_setCullModeImpl;
+  ((Visuals_Context_Dispatch*)self)->setDepthFunction = (void (*)(Shizu_State2*, Visuals_Context*, Visuals_DepthFunction)) & Visuals_Software_Context_setDepthFunctionImpl;
+  ((Visuals_Context_Dispatch*)self)->setViewport = (void (*)(Shizu_State2*, Visuals_Context*, Shizu_Float32, Shizu_Float32, Shizu_Float32, Shizu_Float32)) & Visuals_Software_Context_setViewportImpl;
+  ((Visuals_Context_Dispatch*)self)->clear = (void (*)(Shizu_State2*, Visuals_Context*, bool, bool)) & Visuals_Software_Context_clearImpl;
+  ((Visuals_Context_Dispatch*)self)->setRenderBuffer = (void (*)(Shizu_State2*, Visuals_Context*, Visuals_RenderBuffer*)) & Visuals_Software_Context_setRenderBufferImpl;
+  ((Visuals_Context_Dispatch*)self)->setUniformBuffer = (void (*)(Shizu_State2*, Visuals_Context*, Shizu_Integer32, Visuals_UniformBuffer*)) & Visuals_Software_Context_setUniformBufferImpl;
+  ((Visuals_Context_Dispatch*)self)->render = (void (*)(Shizu_State2*, Visuals_Context*, Visuals_VertexBuffer*, Visuals_Program*)) & Visuals_Software_Context_renderImpl;
+  ((Visuals_Context_Dispatch*)self)->renderRanges = (void (*)(Shizu_State2*, Visuals_Context*, Visuals_VertexBuffer*, Shizu_Integer32 const*, Shizu_Integer32 const*, size_t, Visuals_Program*)) & Visuals_Software_Context_renderRangesImpl;
+  ((Visuals_Context_Dispatch*)self)->renderIndexed = (void (*)(Shizu_State2*, Visuals_Context*, Visuals_VertexBuffer*, Visuals_IndexBuffer*, Visuals_PrimitiveType, Visuals_Program*)) & Visuals_Software_Context_renderIndexedImpl;
+  ((Visuals_Context_Dispatch*)self)->renderInstanced = (void (*)(Shizu_State2*, Visuals_Context*, Visuals_VertexBuffer*, Visuals_VertexBuffer*, size_t, Visuals_PrimitiveType, Visuals_Program*)) & Visuals_Software_Context_renderInstancedImpl;
+  ((Visuals_Context_Dispatch*)self)->blitRenderBuffer = (void (*)(Shizu_State2*, Visuals_Context*, Visuals_RenderBuffer*, Shizu_Float32, Shizu_Float32, Visuals_BlitFilter)) & Visuals_Software_Context_blitRenderBufferImpl;
+}
+
+static Visuals_Program*
+Visuals_Software_Context_createProgramImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Shizu_String* vertexSource,
+    Shizu_String* fragmentSource
+  )
+{
+  Visuals_Program* p = (Visuals_Program*)Visuals_Software_Program_create(state, vertexSource, fragmentSource);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Visuals_Service_registerVisualsObject(state, (Visuals_Object*)p);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)p);
+    Shizu_State2_jump(state);
+  }
+  return p;
+}
+
+static Visuals_RenderBuffer*
+Visuals_Software_Context_createRenderBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self
+  )
+{
+  Visuals_RenderBuffer* p = (Visuals_RenderBuffer*)Visuals_Software_RenderBuffer_create(state);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Visuals_Service_registerVisualsObject(state, (Visuals_Object*)p);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)p);
+    Shizu_State2_jump(state);
+  }
+  return p;
+}
+
+static Visuals_VertexBuffer*
+Visuals_Software_Context_createVertexBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self
+  )
+{
+  Visuals_VertexBuffer* p = (Visuals_VertexBuffer*)Visuals_Software_VertexBuffer_create(state);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Visuals_Service_registerVisualsObject(state, (Visuals_Object*)p);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)p);
+    Shizu_State2_jump(state);
+  }
+  return p;
+}
+
+static Visuals_IndexBuffer*
+Visuals_Software_Context_createIndexBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self
+  )
+{
+  Visuals_IndexBuffer* p = (Visuals_IndexBuffer*)Visuals_Software_IndexBuffer_create(state);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Visuals_Service_registerVisualsObject(state, (Visuals_Object*)p);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)p);
+    Shizu_State2_jump(state);
+  }
+  return p;
+}
+
+static Visuals_UniformBuffer*
+Visuals_Software_Context_createUniformBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self
+  )
+{
+  Visuals_UniformBuffer* p = (Visuals_UniformBuffer*)Visuals_Software_UniformBuffer_create(state);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Visuals_Service_registerVisualsObject(state, (Visuals_Object*)p);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)p);
+    Shizu_State2_jump(state);
+  }
+  return p;
+}
+
+static Visuals_Texture*
+Visuals_Software_Context_createTextureImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self
+  )
+{
+  Visuals_Texture* p = (Visuals_Texture*)Visuals_Software_Texture_create(state);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Visuals_Service_registerVisualsObject(state, (Visuals_Object*)p);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)p);
+    Shizu_State2_jump(state);
+  }
+  return p;
+}
+
+static void
+Visuals_Software_Context_setClearColorImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Shizu_Float32 r,
+    Shizu_Float32 g,
+    Shizu_Float32 b,
+    Shizu_Float32 a
+  )
+{
+  g_device.clearColor[0] = r;
+  g_device.clearColor[1] = g;
+  g_device.clearColor[2] = b;
+  g_device.clearColor[3] = a;
+}
+
+static void
+Visuals_Software_Context_setClearDepthImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Shizu_Float32 z
+  )
+{ g_device.clearDepth = z < 0.f ? 0.f : (z > 1.f ? 1.f : z); }
+
+static void
+Visuals_Software_Context_setBlendFactorsImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_BlendFactor source,
+    Visuals_BlendFactor target
+  )
+{
+  switch (source) {
+    case Visuals_BlendFactor_SourceAlpha:
+    case Visuals_BlendFactor_OneMinusSourceAlpha: {
+    } break;
+    default: {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+      Shizu_State2_jump(state);
+    } break;
+  };
+  switch (target) {
+    case Visuals_BlendFactor_SourceAlpha:
+    case Visuals_BlendFactor_OneMinusSourceAlpha: {
+    } break;
+    default: {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+      Shizu_State2_jump(state);
+    } break;
+  };
+  g_device.pipelineState.blend = true;
+  g_device.pipelineState.sourceFactor = source;
+  g_device.pipelineState.targetFactor = target;
+}
+
+static void
+Visuals_Software_Context_setCullModeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_CullMode cullMode
+  )
+{
+  switch (cullMode) {
+    case Visuals_CullMode_Back:
+    case Visuals_CullMode_Front:
+    case Visuals_CullMode_FrontAndBack:
+    case Visuals_CullMode_None: {
+      g_device.pipelineState.cullMode = cullMode;
+    } break;
+    default: {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+      Shizu_State2_jump(state);
+    } break;
+  };
+}
+
+static void
+Visuals_Software_Context_setDepthFunctionImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_DepthFunction depthFunction
+  )
+{
+  switch (depthFunction) {
+    case Visuals_DepthFunction_LessThan:
+    case Visuals_DepthFunction_LessThanOrEqualTo:
+    case Visuals_DepthFunction_GreaterThan:
+    case Visuals_DepthFunction_GreaterThanOrEqualTo:
+    case Visuals_DepthFunction_NotEqualTo:
+    case Visuals_DepthFunction_EqualTo:
+    case Visuals_DepthFunction_Always:
+    case Visuals_DepthFunction_Never: {
+      g_device.pipelineState.depthTest = true;
+      g_device.pipelineState.depthFunction = depthFunction;
+    } break;
+    default: {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+      Shizu_State2_jump(state);
+    } break;
+  };
+}
+
+static void
+Visuals_Software_Context_setViewportImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Shizu_Float32 left,
+    Shizu_Float32 bottom,
+    Shizu_Float32 width,
+    Shizu_Float32 height
+  )
+{
+  self->viewport.left = left;
+  self->viewport.bottom = bottom;
+  self->viewport.width = width;
+  self->viewport.height = height;
+}
+
+// Get the frame buffer rendered to and compute the viewport in pixels.
+// Return the null pointer if the frame buffer has no pixels.
+static Visuals_Software_FrameBuffer*
+getTarget
+  (
+    Visuals_Software_Context* self,
+    Shizu_Integer32* viewport
+  )
+{
+  Visuals_Software_FrameBuffer* target = g_device.renderBuffer ? &g_device.renderBuffer->frameBuffer : &g_device.defaultFrameBuffer;
+  if (!target->colors) {
+    return NULL;
+  }
+  viewport[0] = (Shizu_Integer32)(self->viewport.left * target->width);
+  viewport[1] = (Shizu_Integer32)(self->viewport.bottom * target->height);
+  viewport[2] = (Shizu_Integer32)(self->viewport.width * target->width);
+  viewport[3] = (Shizu_Integer32)(self->viewport.height * target->height);
+  return target;
+}
+
+static void
+Visuals_Software_Context_clearImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Shizu_Boolean colorBuffer,
+    Shizu_Boolean depthBuffer
+  )
+{
+  Shizu_Integer32 viewport[4];
+  Visuals_Software_FrameBuffer* target = getTarget(self, viewport);
+  if (!target) {
+    return;
+  }
+  Visuals_Software_Rasterizer_clear(state, target, viewport, colorBuffer, g_device.clearColor, depthBuffer, g_device.clearDepth);
+}
+
+static void
+Visuals_Software_Context_setRenderBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_Software_RenderBuffer* renderBuffer
+  )
+{
+  if (renderBuffer && renderBuffer->width > 0 && renderBuffer->height > 0 && !renderBuffer->frameBuffer.colors) {
+    Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+    Shizu_State2_jump(state);
+  }
+  if (renderBuffer) {
+    Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)renderBuffer);
+  }
+  if (g_device.renderBuffer) {
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_device.renderBuffer);
+  }
+  g_device.renderBuffer = renderBuffer;
+}
+
+static void
+Visuals_Software_Context_setUniformBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Shizu_Integer32 index,
+    Visuals_UniformBuffer* uniformBuffer
+  )
+{
+  if (index < 0 || index >= Visuals_Software_Context_NumberOfUniformBufferBindings) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  if (uniformBuffer) {
+    Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)uniformBuffer);
+  }
+  if (g_device.uniformBuffers[index]) {
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_device.uniformBuffers[index]);
+  }
+  g_device.uniformBuffers[index] = uniformBuffer;
+}
+
+static void
+reserve
+  (
+    Shizu_State2* state,
+    void** elements,
+    size_t* capacity,
+    size_t requiredCapacity,
+    size_t elementSize
+  )
+{
+  if (*capacity >= requiredCapacity) {
+    return;
+  }
+  size_t newCapacity = *capacity ? *capacity : 256;
+  while (newCapacity < requiredCapacity) {
+    newCapacity *= 2;
+  }
+  if (newCapacity > SIZE_MAX / elementSize) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  void* newElements = realloc(*elements, newCapacity * elementSize);
+  if (!newElements) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  *elements = newElements;
+  *capacity = newCapacity;
+}
+
+// Append a triangle to the indices.
+// The capacity must have been reserved.
+static inline void
+appendTriangle
+  (
+    size_t* numberOfTriangles,
+    uint32_t a,
+    uint32_t b,
+    uint32_t c
+  )
+{
+  uint32_t* p = g_device.indices + 3 * (*numberOfTriangles)++;
+  p[0] = a;
+  p[1] = b;
+  p[2] = c;
+}
+
+// Append the triangles of a triangle strip to the indices.
+// The winding of every second triangle is reversed such that all triangles have the winding of the first triangle.
+static void
+appendStrip
+  (
+    Shizu_State2* state,
+    size_t* numberOfTriangles,
+    uint32_t first,
+    uint32_t count
+  )
+{
+  if (count < 3) {
+    return;
+  }
+  reserve(state, (void**)&g_device.indices, &g_device.indexCapacity, 3 * (*numberOfTriangles + count - 2), sizeof(uint32_t));
+  for (uint32_t i = 0; i < count - 2; ++i) {
+    if (i & 1) {
+      appendTriangle(numberOfTriangles, first + i + 1, first + i, first + i + 2);
+    } else {
+      appendTriangle(numberOfTriangles, first + i, first + i + 1, first + i + 2);
+    }
+  }
+}
+
+typedef struct ShadeVerticesContext {
+  Visuals_Software_Program* program;
+  Visuals_Software_VertexBuffer* vertexBuffer;
+  size_t numberOfVertices;
+} ShadeVerticesContext;
+
+static void
+shadeVertices
+  (
+    void* context,
+    size_t band
+  )
+{
+  ShadeVerticesContext const* c = (ShadeVerticesContext const*)context;
+  size_t begin = band * NumberOfVerticesPerBand;
+  size_t end = begin + NumberOfVerticesPerBand < c->numberOfVertices ? begin + NumberOfVerticesPerBand : c->numberOfVertices;
+  for (size_t i = begin; i < end; ++i) {
+    Visuals_Software_VertexAttributes attributes;
+    Visuals_Software_VertexBuffer_getVertexAttributes(c->vertexBuffer, i, &attributes);
+    Visuals_Software_Program_shadeVertex(c->program, &attributes, &g_device.vertices[i]);
+  }
+}
+
+// Shade the vertices of a vertex buffer and rasterize the triangles of the first numberOfTriangles triangles of the indices.
+// If an instance buffer is specified, the vertices are shaded and the triangles are rasterized once per instance.
+static void
+draw
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_Software_VertexBuffer* vertexBuffer,
+    Visuals_Software_VertexBuffer* instanceBuffer,
+    size_t numberOfInstances,
+    size_t numberOfTriangles,
+    Visuals_Software_Program* program
+  )
+{
+  Visuals_Software_PipelineState pipelineState = g_device.pipelineState;
+  Visuals_Software_FrameBuffer* target = getTarget(self, pipelineState.viewport);
+  size_t numberOfVertices = ((Visuals_VertexBuffer*)vertexBuffer)->numberOfVertices;
+  if (!target || !numberOfTriangles || !numberOfVertices) {
+    return;
+  }
+  reserve(state, (void**)&g_device.vertices, &g_device.vertexCapacity, numberOfVertices, sizeof(Visuals_Software_Vertex));
+  Visuals_Software_Program_prepare(state, program, g_device.uniformBuffers, Visuals_Software_Context_NumberOfUniformBufferBindings);
+
+  Visuals_Software_DrawCall drawCall;
+  drawCall.pipelineState = &pipelineState;
+  Visuals_Software_Program_getFragmentStage(program, &drawCall.fragmentStage, &drawCall.uniforms, &drawCall.numberOfVaryings);
+  drawCall.vertices = g_device.vertices;
+  drawCall.numberOfVertices = numberOfVertices;
+  drawCall.indices = g_device.indices;
+  drawCall.numberOfTriangles = numberOfTriangles;
+
+  ShadeVerticesContext context = { .program = program, .vertexBuffer = vertexBuffer, .numberOfVertices = numberOfVertices };
+  for (size_t i = 0; i < (instanceBuffer ? numberOfInstances : 1); ++i) {
+    if (instanceBuffer) {
+      Visuals_Software_InstanceAttributes instance;
+      Visuals_Software_VertexBuffer_getInstanceAttributes(instanceBuffer, i, &instance);
+      Visuals_Software_Program_setInstance(program, &instance);
+    }
+    Visuals_Parallel_run(&shadeVertices, &context, (numberOfVertices + NumberOfVerticesPerBand - 1) / NumberOfVerticesPerBand);
+    Visuals_Software_Rasterizer_draw(state, target, &drawCall);
+  }
+}
+
+static void
+Visuals_Software_Context_renderImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_Software_VertexBuffer* vertexBuffer,
+    Visuals_Software_Program* program
+  )
+{
+  size_t numberOfTriangles = 0;
+  appendStrip(state, &numberOfTriangles, 0, (uint32_t)((Visuals_VertexBuffer*)vertexBuffer)->numberOfVertices);
+  draw(state, self, vertexBuffer, NULL, 0, numberOfTriangles, program);
+}
+
+static void
+Visuals_Software_Context_renderRangesImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_Software_VertexBuffer* vertexBuffer,
+    Shizu_Integer32 const* firsts,
+    Shizu_Integer32 const* counts,
+    size_t numberOfRanges,
+    Visuals_Software_Program* program
+  )
+{
+  if (!numberOfRanges) {
+    return;
+  }
+  size_t numberOfVertices = ((Visuals_VertexBuffer*)vertexBuffer)->numberOfVertices;
+  for (size_t i = 0; i < numberOfRanges; ++i) {
+    if (firsts[i] < 0 || counts[i] < 0 || (size_t)firsts[i] + (size_t)counts[i] > numberOfVertices) {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+      Shizu_State2_jump(state);
+    }
+  }
+  size_t numberOfTriangles = 0;
+  for (size_t i = 0; i < numberOfRanges; ++i) {
+    appendStrip(state, &numberOfTriangles, (uint32_t)firsts[i], (uint32_t)counts[i]);
+  }
+  draw(state, self, vertexBuffer, NULL, 0, numberOfTriangles, program);
+}
+
+static inline uint32_t
+getIndex
+  (
+    Visuals_IndexBuffer* indexBuffer,
+    size_t i
+  )
+{
+  if (Visuals_IndexSyntactics_UInt16 == indexBuffer->flags) {
+    return ((uint16_t const*)indexBuffer->bytes)[i];
+  } else {
+    return ((uint32_t const*)indexBuffer->bytes)[i];
+  }
+}
+
+static void
+Visuals_Software_Context_renderIndexedImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_Software_VertexBuffer* vertexBuffer,
+    Visuals_IndexBuffer* indexBuffer,
+    Visuals_PrimitiveType primitiveType,
+    Visuals_Software_Program* program
+  )
+{
+  switch (primitiveType) {
+    case Visuals_PrimitiveType_Triangles:
+    case Visuals_PrimitiveType_TriangleStrip: {
+    } break;
+    case Visuals_PrimitiveType_Lines: {
+      fprintf(stderr, "%s:%d: lines are not supported by the software renderer\n", __FILE__, __LINE__);
+      Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+      Shizu_State2_jump(state);
+    } break;
+    default: {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+      Shizu_State2_jump(state);
+    } break;
+  };
+  // As in the OpenGL backend, primitive restart is enabled for triangle strips only.
+  uint32_t minimumIndex, maximumIndex;
+  if (!Visuals_IndexBuffer_getIndexRange(indexBuffer, Visuals_PrimitiveType_TriangleStrip == primitiveType, &minimumIndex, &maximumIndex)) {
+    return;
+  }
+  if (maximumIndex >= ((Visuals_VertexBuffer*)vertexBuffer)->numberOfVertices) {
+    fprintf(stderr, "%s:%d: maximum index %zu is out of bounds\n", __FILE__, __LINE__, (size_t)maximumIndex);
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  size_t numberOfIndices = indexBuffer->numberOfIndices;
+  size_t numberOfTriangles = 0;
+  if (Visuals_PrimitiveType_Triangles == primitiveType) {
+    reserve(state, (void**)&g_device.indices, &g_device.indexCapacity, numberOfIndices, sizeof(uint32_t));
+    for (size_t i = 0; i + 2 < numberOfIndices; i += 3) {
+      appendTriangle(&numberOfTriangles, getIndex(indexBuffer, i + 0), getIndex(indexBuffer, i + 1), getIndex(indexBuffer, i + 2));
+    }
+  } else {
+    // A strip of n indices has at most n - 2 triangles.
+    reserve(state, (void**)&g_device.indices, &g_device.indexCapacity, 3 * numberOfIndices, sizeof(uint32_t));
+    uint32_t const restartIndex = Visuals_IndexBuffer_getRestartIndex(indexBuffer->flags);
+    // The number of indices of the current strip.
+    size_t count = 0;
+    uint32_t a = 0, b = 0;
+    for (size_t i = 0; i < numberOfIndices; ++i) {
+      uint32_t c = getIndex(indexBuffer, i);
+      if (restartIndex == c) {
+        count = 0;
+        continue;
+      }
+      if (count >= 2) {
+        if (count & 1) {
+          appendTriangle(&numberOfTriangles, b, a, c);
+        } else {
+          appendTriangle(&numberOfTriangles, a, b, c);
+        }
+      }
+      a = b;
+      b = c;
+      count++;
+    }
+  }
+  draw(state, self, vertexBuffer, NULL, 0, numberOfTriangles, program);
+}
+
+static void
+Visuals_Software_Context_renderInstancedImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_Software_VertexBuffer* vertexBuffer,
+    Visuals_Software_VertexBuffer* instanceBuffer,
+    size_t numberOfInstances,
+    Visuals_PrimitiveType primitiveType,
+    Visuals_Software_Program* program
+  )
+{
+  switch (primitiveType) {
+    case Visuals_PrimitiveType_Triangles:
+    case Visuals_PrimitiveType_TriangleStrip: {
+    } break;
+    case Visuals_PrimitiveType_Lines: {
+      fprintf(stderr, "%s:%d: lines are not supported by the software renderer\n", __FILE__, __LINE__);
+      Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+      Shizu_State2_jump(state);
+    } break;
+    default: {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+      Shizu_State2_jump(state);
+    } break;
+  };
+  if (numberOfInstances > ((Visuals_VertexBuffer*)instanceBuffer)->numberOfVertices) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  if (((Visuals_VertexBuffer*)instanceBuffer)->flags != (Visuals_VertexSemantics_Transform3x4_MaterialIndex | Visuals_VertexSyntactics_Float4_Float4_Float4_UInt32)) {
+    fprintf(stderr, "%s:%d: vertex buffer is not an instance buffer\n", __FILE__, __LINE__);
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  if (!numberOfInstances) {
+    return;
+  }
+  uint32_t numberOfVertices = (uint32_t)((Visuals_VertexBuffer*)vertexBuffer)->numberOfVertices;
+  size_t numberOfTriangles = 0;
+  if (Visuals_PrimitiveType_Triangles == primitiveType) {
+    reserve(state, (void**)&g_device.indices, &g_device.indexCapacity, numberOfVertices, sizeof(uint32_t));
+    for (uint32_t i = 0; i + 2 < numberOfVertices; i += 3) {
+      appendTriangle(&numberOfTriangles, i + 0, i + 1, i + 2);
+    }
+  } else {
+    appendStrip(state, &numberOfTriangles, 0, numberOfVertices);
+  }
+  draw(state, self, vertexBuffer, instanceBuffer, numberOfInstances, numberOfTriangles, program);
+}
+
+static void
+Visuals_Software_Context_blitRenderBufferImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Context* self,
+    Visuals_Software_RenderBuffer* renderBuffer,
+    Shizu_Float32 width,
+    Shizu_Float32 height,
+    Visuals_BlitFilter filter
+  )
+{
+  if (!renderBuffer) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  if (!(width > 0.f && width <= 1.f) || !(height > 0.f && height <= 1.f)) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  if (filter != Visuals_BlitFilter_Nearest && filter != Visuals_BlitFilter_Linear && filter != Visuals_BlitFilter_Sharpen) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  if (renderBuffer == g_device.renderBuffer) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  if (renderBuffer->width > 0 && renderBuffer->height > 0 && !renderBuffer->frameBuffer.colors) {
+    Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Integer32 viewport[4];
+  Visuals_Software_FrameBuffer* target = getTarget(self, viewport);
+  if (!target || !renderBuffer->frameBuffer.colors) {
+    return;
+  }
+  Shizu_Integer32 sourceRectangle[4] = {
+    0,
+    0,
+    (Shizu_Integer32)(width * renderBuffer->frameBuffer.width + 0.5f),
+    (Shizu_Integer32)(height * renderBuffer->frameBuffer.height + 0.5f),
+  };
+  if (sourceRectangle[2] < 1) sourceRectangle[2] = 1;
+  if (sourceRectangle[3] < 1) sourceRectangle[3] = 1;
+  Visuals_Software_Rasterizer_blit(state, target, viewport, &renderBuffer->frameBuffer, sourceRectangle, filter);
+}
+
+static void
+Visuals_Software_Context_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{
+  if (1 != numberOfArgumentValues) {
+    Shizu_State2_setStatus(state, Shizu_Status_NumberOfArgumentsInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Type* TYPE = Visuals_Software_Context_getType(state);
+  Visuals_Software_Context* SELF = (Visuals_Software_Context*)Shizu_Value_getObject(&argumentValues[0]);
+  {
+    Shizu_Type* PARENTTYPE = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), TYPE);
+    Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value argumentValues[] = { Shizu_Value_InitializerObject(SELF) };
+    Shizu_Type_getObjectTypeDescriptor(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), PARENTTYPE)->construct(state, &returnValue, 1, &argumentValues[0]);
+  }
+  SELF->viewport.left = 0.f;
+  SELF->viewport.bottom = 0.f;
+  SELF->viewport.width = 1.f;
+  SELF->viewport.height = 1.f;
+  ((Shizu_Object*)SELF)->type = TYPE;
+}
+
+Visuals_Software_Context*
+Visuals_Software_Context_create
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+  Shizu_Value argumentValues[] = { Shizu_Value_InitializerType(Visuals_Software_Context_getType(state)) };
+  Shizu_Operations_create(state, &returnValue, 1, &argumentValues[0]);
+  return (Visuals_Software_Context*)Shizu_Value_getObject(&returnValue);
+}
+
+void
+Visuals_Software_Context_resizeDefaultFrameBuffer
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  )
+{
+  width = width < Visuals_Software_MaximalFrameBufferSize ? width : Visuals_Software_MaximalFrameBufferSize;
+  height = height < Visuals_Software_MaximalFrameBufferSize ? height : Visuals_Software_MaximalFrameBufferSize;
+  if (g_device.defaultFrameBuffer.width != width || g_device.defaultFrameBuffer.height != height) {
+    Visuals_Software_FrameBuffer_resize(state, &g_device.defaultFrameBuffer, width, height);
+  }
+}
+
+Visuals_Software_FrameBuffer*
+Visuals_Software_Context_getDefaultFrameBuffer
+  (
+    Shizu_State2* state
+  )
+{ return &g_device.defaultFrameBuffer; }
+
+void
+Visuals_Software_Context_shutdown
+  (
+    Shizu_State2* state
+  )
+{
+  if (g_device.renderBuffer) {
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_device.renderBuffer);
+    g_device.renderBuffer = NULL;
+  }
+  for (size_t i = 0; i < Visuals_Software_Context_NumberOfUniformBufferBindings; ++i) {
+    if (g_device.uniformBuffers[i]) {
+      Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_device.uniformBuffers[i]);
+      g_device.uniformBuffers[i] = NULL;
+    }
+  }
+  Visuals_Software_FrameBuffer_uninitialize(&g_device.defaultFrameBuffer);
+  Visuals_Software_FrameBuffer_initialize(&g_device.defaultFrameBuffer);
+  free(g_device.indices);
+  g_device.indices = NULL;
+  g_device.indexCapacity = 0;
+  free(g_device.vertices);
+  g_device.vertices = NULL;
+  g_device.vertexCapacity = 0;
+  Visuals_Software_Rasterizer_releaseScratch(state);
+}
@@ -0,0 +1,94 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(VISUALS_SOFTWARE_CONTEXT_H_INCLUDED)
+#define VISUALS_SOFTWARE_CONTEXT_H_INCLUDED
+
+#include "Visuals/Context.h"
+#include "Visuals/Software/Rasterizer.h"
+
+/// @brief The number of uniform buffer binding points of the software renderer.
+#define Visuals_Software_Context_NumberOfUniformBufferBindings (16)
+
+/// @brief
+/// The implementation of Visuals.Context for the software renderer.
+/// @details
+/// Like the state of an OpenGL context, the fixed function state, the uniform buffer bindings,
+/// and the render buffer binding are shared by all software contexts.
+/// The viewport is the state of a context.
+/// Lines are not supported.
+/// @details
+/// The type is
+/// @code
+/// class Visuals.Software.Context
+/// @endcode
+/// Its constructor is
+/// @code
+/// Visuals.Software.Context.construct()
+/// @endcode
+Shizu_declareObjectType(Visuals_Software_Context);
+
+struct Visuals_Software_Context_Dispatch {
+  Visuals_Context_Dispatch _parent;
+};
+
+struct Visuals_Software_Context {
+  Visuals_Context _parent;
+  struct {
+    Shizu_Float32 left;
+    Shizu_Float32 bottom;
+    Shizu_Float32 width;
+    Shizu_Float32 height;
+  } viewport;
+};
+
+Visuals_Software_Context*
+Visuals_Software_Context_create
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Resize the default frame buffer of the software renderer.
+/// @param width, height The width and the height. Usually the size of the client area of the window.
+void
+Visuals_Software_Context_resizeDefaultFrameBuffer
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  );
+
+/// @brief Get the default frame buffer of the software renderer.
+/// @return A pointer to the default frame buffer.
+Visuals_Software_FrameBuffer*
+Visuals_Software_Context_getDefaultFrameBuffer
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Release the bindings, the default frame buffer, and the scratch memory of the software renderer.
+void
+Visuals_Software_Context_shutdown
+  (
+    Shizu_State2* state
+  );
+
+#endif // VISUALS_SOFTWARE_CONTEXT_H_INCLUDED
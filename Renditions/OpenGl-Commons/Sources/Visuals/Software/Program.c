@@ -0,0 +1,1114 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Visuals/Software/Program.h"
+
+#include "Visuals/DefaultPrograms.h"
+#include "Visuals/LightSet.h"
+// fprintf, stderr, snprintf
+#include <stdio.h>
+// malloc, realloc, free
+#include <malloc.h>
+// memcpy, memset, strcmp, strlen
+#include <string.h>
+// strtol
+#include <stdlib.h>
+// powf, sqrtf
+#include <math.h>
+
+#define UniformKind_Matrix4F32 (1)
+#define UniformKind_Vector3F32 (2)
+#define UniformKind_Vector4F32 (3)
+#define UniformKind_Integer32 (4)
+#define UniformKind_Float32 (5)
+#define UniformKind_UniformBlock (6)
+
+struct Visuals_Software_Uniform {
+  /// @brief The name of the uniform. Allocated by malloc.
+  char* name;
+  /// @brief The kind of the value.
+  uint8_t kind;
+  /// @brief The value. A matrix is stored row by row.
+  union {
+    float f[16];
+    Shizu_Integer32 i;
+  } value;
+};
+
+// The values of the vertexDescriptor and instanceDescriptor uniforms of the "pbr1" program.
+#define VertexSemantics_PositionXyz_NormalXyz_AmbientRgb (2)
+#define VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess (4)
+#define VertexSemantics_PositionXyz_NormalXyz_MaterialIndex (256)
+#define VertexSemantics_PositionXyz_NormalXyz_TextureUv_MaterialIndex (512)
+#define InstanceSemantics_Transform3x4_MaterialIndex (64)
+
+// The light types of the "pbr1" program.
+#define LightType_Ambient (4)
+#define LightType_DirectionalDiffuse (8)
+#define LightType_Point (16)
+#define LightType_PointSpecularPhong (64)
+#define LightType_PointSpecularBlinnPhong (128)
+#define LightType_Spot (256)
+
+// The light models of the "pbr1" program.
+#define LightModel_Phong (1)
+#define LightModel_BlinnPhong (2)
+
+#define MaximumNumberOfLights (Visuals_LightSet_MaximumNumberOfLights)
+#define MaximumNumberOfMaterials (128)
+// The size, in Bytes, of an element of the "Materials" uniform block in the std140 layout.
+#define MaterialInfoSize (96)
+
+// The varyings of the "pbr1" program.
+// The material varyings are last: They are usually constant for a triangle and the rasterizer does not interpolate them.
+#define Pbr1_WorldPosition (0)
+#define Pbr1_Normal (3)
+#define Pbr1_PhongAmbient (6)
+#define Pbr1_PhongDiffuse (9)
+#define Pbr1_PhongSpecular (12)
+#define Pbr1_PhongShininess (15)
+#define Pbr1_BlinnPhongSpecular (16)
+#define Pbr1_BlinnPhongShininess (19)
+#define Pbr1_NumberOfVaryings (20)
+
+typedef struct SimpleUniforms {
+  float scale[4][4];
+  float color[4];
+} SimpleUniforms;
+
+typedef struct Pbr1Light {
+  Shizu_Integer32 type;
+  float color[3];
+  float position[3];
+  /// @brief The normalized direction.
+  float direction[3];
+  /// @brief The radius of the sphere of influence or zero.
+  float radius;
+  /// @brief The cosines of the inner and the outer angle of the cone.
+  float cosInnerAngle, cosOuterAngle;
+} Pbr1Light;
+
+/// @brief Phong or Blinn-Phong information: ambient rgb, diffuse rgb, specular rgb, shininess.
+typedef float Pbr1Material[10];
+
+typedef struct Pbr1Uniforms {
+  float projectionView[4][4];
+  float world[4][4];
+  /// @brief The world matrix of the current instance.
+  float instanceWorld[4][4];
+  /// @brief The model to projection matrix of the current instance.
+  float modelToProjection[4][4];
+  /// @brief The normal matrix of the current instance.
+  float normalMatrix[3][3];
+  /// @brief The material index of the current instance.
+  uint32_t instanceMaterialIndex;
+  float viewer[3];
+  Shizu_Integer32 vertexDescriptor;
+  Shizu_Integer32 instanceDescriptor;
+  /// @brief The light model of the permutation or 0 if the light model is selected by the light type.
+  Shizu_Integer32 lightModel;
+  Pbr1Material phong;
+  Pbr1Material blinnPhong;
+  /// @brief A pointer to the "Materials" uniform block data or the null pointer.
+  uint8_t const* materials;
+  size_t numberOfMaterials;
+  Pbr1Light lights[MaximumNumberOfLights];
+  Shizu_Integer32 numberOfLights;
+  /// @brief A pointer to the "ClusteredLights" uniform block data or the null pointer.
+  /// A light is a position, a radius, a color, and a padding float.
+  float const* clusteredLights;
+  size_t numberOfClusteredLights;
+} Pbr1Uniforms;
+
+static void
+Visuals_Software_Program_finalize
+  (
+    Shizu_State1* state1,
+    Visuals_Software_Program* self
+  );
+
+static void
+Visuals_Software_Program_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_Software_Program_Dispatch* self
+  );
+
+static void
+Visuals_Software_Program_materializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self
+  );
+
+static void
+Visuals_Software_Program_unmaterializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self
+  );
+
+static void
+Visuals_Software_Program_bindMatrix4F32Impl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    char const* name,
+    Matrix4F32* value
+  );
+
+static void
+Visuals_Software_Program_bindVector3F32Impl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    char const* name,
+    Vector3F32* value
+  );
+
+static void
+Visuals_Software_Program_bindVector4F32Impl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    char const* name,
+    Vector4F32* value
+  );
+
+static void
+Visuals_Software_Program_bindInteger32Impl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    char const* name,
+    Shizu_Integer32 value
+  );
+
+static void
+Visuals_Software_Program_bindBooleanImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    char const* name,
+    Shizu_Boolean value
+  );
+
+static void
+Visuals_Software_Program_bindFloat32Impl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    char const* name,
+    Shizu_Float32 value
+  );
+
+static void
+Visuals_Software_Program_bindUniformBlockImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    char const* name,
+    Shizu_Integer32 index
+  );
+
+static Shizu_ObjectTypeDescriptor const Visuals_Software_Program_Type = {
+  .preDestroyType = NULL,
+  .postCreateType = NULL,
+  .visitType = NULL,
+  .size = sizeof(Visuals_Software_Program),
+  .finalize = (Shizu_OnFinalizeCallback*)&Visuals_Software_Program_finalize,
+  .visit = NULL,
+  .dispatchSize = sizeof(Visuals_Software_Program_Dispatch),
+  .dispatchInitialize = (Shizu_OnDispatchInitializeCallback*)&Visuals_Software_Program_dispatchInitialize,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Zeitgeist.Visuals.Software.Program", Visuals_Software_Program, Visuals_Program);
+
+static void
+Visuals_Software_Program_finalize
+  (
+    Shizu_State1* state1,
+    Visuals_Software_Program* self
+  )
+{
+  if (self->kernelUniforms) {
+    free(self->kernelUniforms);
+    self->kernelUniforms = NULL;
+  }
+  if (self->uniforms) {
+    for (size_t i = 0; i < self->numberOfUniforms; ++i) {
+      free(self->uniforms[i].name);
+    }
+    free(self->uniforms);
+    self->uniforms = NULL;
+  }
+  self->numberOfUniforms = 0;
+  self->uniformCapacity = 0;
+}
+
+static void
+Visuals_Software_Program_materializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self
+  )
+{/*Intentionally empty.*/}
+
+static void
+Visuals_Software_Program_unmaterializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self
+  )
+{/*Intentionally empty.*/}
+
+static Visuals_Software_Uniform*
+findUniform
+  (
+    Visuals_Software_Program* self,
+    char const* name,
+    uint8_t kind
+  )
+{
+  for (size_t i = 0; i < self->numberOfUniforms; ++i) {
+    if (!strcmp(self->uniforms[i].name, name)) {
+      return kind == self->uniforms[i].kind ? &self->uniforms[i] : NULL;
+    }
+  }
+  return NULL;
+}
+
+// Get the uniform of the specified name. Create it if it does not exist.
+// Its kind is set to the specified kind.
+static Visuals_Software_Uniform*
+getOrCreateUniform
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    char const* name,
+    uint8_t kind
+  )
+{
+  for (size_t i = 0; i < self->numberOfUniforms; ++i) {
+    if (!strcmp(self->uniforms[i].name, name)) {
+      self->uniforms[i].kind = kind;
+      return &self->uniforms[i];
+    }
+  }
+  if (self->numberOfUniforms == self->uniformCapacity) {
+    size_t newCapacity = self->uniformCapacity ? self->uniformCapacity * 2 : 32;
+    Visuals_Software_Uniform* newUniforms = realloc(self->uniforms, newCapacity * sizeof(Visuals_Software_Uniform));
+    if (!newUniforms) {
+      Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State2_jump(state);
+    }
+    self->uniforms = newUniforms;
+    self->uniformCapacity = newCapacity;
+  }
+  size_t n = strlen(name);
+  char* newName = malloc(n + 1);
+  if (!newName) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  memcpy(newName, name, n + 1);
+  Visuals_Software_Uniform* uniform = &self->uniforms[self->numberOfUniforms++];
+  uniform->name = newName;
+  uniform->kind = kind;
+  memset(&uniform->value, 0, sizeof(uniform->value));
+  return uniform;
+}
+
+static void
+Visuals_Software_Program_bindMatrix4F32Impl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    char const* name,
+    Matrix4F32* value
+  )
+{
+  Visuals_Software_Uniform* uniform = getOrCreateUniform(state, self, name, UniformKind_Matrix4F32);
+  memcpy(uniform->value.f, idlib_matrix_4x4_f32_get_data(&value->m), sizeof(float) * 16);
+}
+
+static void
+Visuals_Software_Program_bindVector3F32Impl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    char const* name,
+    Vector3F32* value
+  )
+{
+  Visuals_Software_Uniform* uniform = getOrCreateUniform(state, self, name, UniformKind_Vector3F32);
+  memcpy(uniform->value.f, &value->v.e[0], sizeof(float) * 3);
+}
+
+static void
+Visuals_Software_Program_bindVector4F32Impl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    char const* name,
+    Vector4F32* value
+  )
+{
+  Visuals_Software_Uniform* uniform = getOrCreateUniform(state, self, name, UniformKind_Vector4F32);
+  memcpy(uniform->value.f, &value->v.e[0], sizeof(float) * 4);
+}
+
+static void
+Visuals_Software_Program_bindInteger32Impl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    char const* name,
+    Shizu_Integer32 value
+  )
+{
+  Visuals_Software_Uniform* uniform = getOrCreateUniform(state, self, name, UniformKind_Integer32);
+  uniform->value.i = value;
+}
+
+static void
+Visuals_Software_Program_bindBooleanImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    char const* name,
+    Shizu_Boolean value
+  )
+{
+  Visuals_Software_Uniform* uniform = getOrCreateUniform(state, self, name, UniformKind_Integer32);
+  uniform->value.i = value ? 1 : 0;
+}
+
+static void
+Visuals_Software_Program_bindFloat32Impl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    char const* name,
+    Shizu_Float32 value
+  )
+{
+  Visuals_Software_Uniform* uniform = getOrCreateUniform(state, self, name, UniformKind_Float32);
+  uniform->value.f[0] = value;
+}
+
+static void
+Visuals_Software_Program_bindUniformBlockImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    char const* name,
+    Shizu_Integer32 index
+  )
+{
+  if (index < 0) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  Visuals_Software_Uniform* uniform = getOrCreateUniform(state, self, name, UniformKind_UniformBlock);
+  uniform->value.i = index;
+}
+
+static void
+Visuals_Software_Program_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_Software_Program_Dispatch* self
+  )
+{
+  ((Visuals_Object_Dispatch*)self)->materialize = (void(*)(Shizu_State2*, Visuals_Object*)) & Visuals_Software_Program_materializeImpl;
+  ((Visuals_Object_Dispatch*)self)->unmaterialize = (void(*)(Shizu_State2*, Visuals_Object*)) & Visuals_Software_Program_unmaterializeImpl;
+  ((Visuals_Program_Dispatch*)self)->bindBoolean = (void(*)(Shizu_State2*, Visuals_Program*, char const*, Shizu_Boolean)) & Visuals_Software_Program_bindBooleanImpl;
+  ((Visuals_Program_Dispatch*)self)->bindFloat32 = (void(*)(Shizu_State2*, Visuals_Program*, char const*, Shizu_Float32)) & Visuals_Software_Program_bindFloat32Impl;
+  ((Visuals_Program_Dispatch*)self)->bindUniformBlock = (void(*)(Shizu_State2*, Visuals_Program*, char const*, Shizu_Integer32)) & Visuals_Software_Program_bindUniformBlockImpl;
+  ((Visuals_Program_Dispatch*)self)->bindInteger32 = (void(*)(Shizu_State2*, Visuals_Program*, char const*, Shizu_Integer32)) & Visuals_Software_Program_bindInteger32Impl;
+  ((Visuals_Program_Dispatch*)self)->bindMatrix4F32 = (void(*)(Shizu_State2*, Visuals_Program*, char const*, Matrix4F32*)) & Visuals_Software_Program_bindMatrix4F32Impl;
+  ((Visuals_Program_Dispatch*)self)->bindVector3F32 = (void(*)(Shizu_State2*, Visuals_Program*, char const*, Vector3F32*)) & Visuals_Software_Program_bindVector3F32Impl;
+  ((Visuals_Program_Dispatch*)self)->bindVector4F32 = (void(*)(Shizu_State2*, Visuals_Program*, char const*, Vector4F32*)) & Visuals_Software_Program_bindVector4F32Impl;
+}
+
+// Get the kernel named by the "#pragma zeitgeist_program(<name>)" directive of a source.
+// Return 0 if there is no such directive or the name is not supported.
+static uint8_t
+getKernel
+  (
+    Shizu_State2* state,
+    Shizu_String* source
+  )
+{
+  static char const PREFIX[] = "#pragma zeitgeist_program(";
+  static struct { char const* name; uint8_t kernel; } const KERNELS[] = {
+    { "simple", Visuals_Software_ProgramKernel_Simple },
+    { "pbr1", Visuals_Software_ProgramKernel_Pbr1 },
+  };
+  char const* p = Shizu_String_getBytes(state, source);
+  size_t n = Shizu_String_getNumberOfBytes(state, source);
+  size_t m = sizeof(PREFIX) - 1;
+  for (size_t i = 0; i + m <= n; ++i) {
+    if (!memcmp(p + i, PREFIX, m)) {
+      char const* name = p + i + m;
+      size_t remaining = n - i - m;
+      for (size_t j = 0; j < sizeof(KERNELS) / sizeof(KERNELS[0]); ++j) {
+        size_t k = strlen(KERNELS[j].name);
+        if (k < remaining && !memcmp(name, KERNELS[j].name, k) && ')' == name[k]) {
+          return KERNELS[j].kernel;
+        }
+      }
+      return 0;
+    }
+  }
+  return 0;
+}
+
+// Get the value of the "#define <name> <value>" directive of a source.
+// Return the specified default value if there is no such directive.
+// This way the permutations of a program select the code paths of the kernel.
+static Shizu_Integer32
+getDefine
+  (
+    Shizu_State2* state,
+    Shizu_String* source,
+    char const* name,
+    Shizu_Integer32 defaultValue
+  )
+{
+  static char const PREFIX[] = "#define ";
+  char const* p = Shizu_String_getBytes(state, source);
+  size_t n = Shizu_String_getNumberOfBytes(state, source);
+  size_t m = sizeof(PREFIX) - 1, k = strlen(name);
+  for (size_t i = 0; i + m + k < n; ++i) {
+    if (!memcmp(p + i, PREFIX, m) && !memcmp(p + i + m, name, k) && ' ' == p[i + m + k]) {
+      char buffer[32];
+      size_t j = 0;
+      for (char const* q = p + i + m + k; q < p + n && '\n' != *q && j < sizeof(buffer) - 1; ++q) {
+        if (' ' != *q && '(' != *q && ')' != *q) {
+          buffer[j++] = *q;
+        }
+      }
+      buffer[j] = '\0';
+      return (Shizu_Integer32)strtol(buffer, NULL, 10);
+    }
+  }
+  return defaultValue;
+}
+
+void
+Visuals_Software_Program_construct
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    Shizu_String* vertexProgramSource,
+    Shizu_String* fragmentProgramSource
+  )
+{
+  Shizu_Type* TYPE = Visuals_Software_Program_getType(state);
+  Visuals_Program_construct(state, (Visuals_Program*)self, vertexProgramSource, fragmentProgramSource);
+  self->kernel = 0;
+  self->uniforms = NULL;
+  self->numberOfUniforms = 0;
+  self->uniformCapacity = 0;
+  self->kernelUniforms = NULL;
+  ((Shizu_Object*)self)->type = TYPE;
+  self->kernel = getKernel(state, vertexProgramSource);
+  self->vertexFormat = getDefine(state, vertexProgramSource, "VERTEX_FORMAT", 0);
+  self->lightModel = getDefine(state, vertexProgramSource, "LIGHT_MODEL", 0);
+  switch (self->kernel) {
+    case Visuals_Software_ProgramKernel_Simple: {
+      self->kernelUniforms = malloc(sizeof(SimpleUniforms));
+    } break;
+    case Visuals_Software_ProgramKernel_Pbr1: {
+      self->kernelUniforms = malloc(sizeof(Pbr1Uniforms));
+    } break;
+    default: {
+      fprintf(stderr, "%s:%d: the program is not supported by the software renderer\n", __FILE__, __LINE__);
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    } break;
+  };
+  if (!self->kernelUniforms) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+}
+
+Visuals_Software_Program*
+Visuals_Software_Program_create
+  (
+    Shizu_State2* state,
+    Shizu_String* vertexProgramSource,
+    Shizu_String* fragmentProgramSource
+  )
+{
+  Visuals_Software_Program* self = (Visuals_Software_Program*)Shizu_Gc_allocateObject(state, sizeof(Visuals_Software_Program));
+  Visuals_Software_Program_construct(state, self, vertexProgramSource, fragmentProgramSource);
+  return self;
+}
+
+static void
+getVector
+  (
+    Visuals_Software_Program* self,
+    char const* name,
+    uint8_t kind,
+    float* value,
+    size_t n
+  )
+{
+  Visuals_Software_Uniform* uniform = findUniform(self, name, kind);
+  if (uniform) {
+    memcpy(value, uniform->value.f, sizeof(float) * n);
+  } else {
+    memset(value, 0, sizeof(float) * n);
+  }
+}
+
+static Shizu_Integer32
+getInteger
+  (
+    Visuals_Software_Program* self,
+    char const* name,
+    uint8_t kind,
+    Shizu_Integer32 defaultValue
+  )
+{
+  Visuals_Software_Uniform* uniform = findUniform(self, name, kind);
+  return uniform ? uniform->value.i : defaultValue;
+}
+
+static float
+getFloat
+  (
+    Visuals_Software_Program* self,
+    char const* name
+  )
+{
+  Visuals_Software_Uniform* uniform = findUniform(self, name, UniformKind_Float32);
+  return uniform ? uniform->value.f[0] : 0.f;
+}
+
+static void
+multiply
+  (
+    float (*target)[4],
+    float const (*a)[4],
+    float const (*b)[4]
+  )
+{
+  for (size_t i = 0; i < 4; ++i) {
+    for (size_t j = 0; j < 4; ++j) {
+      target[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j] + a[i][3] * b[3][j];
+    }
+  }
+}
+
+static inline void
+transform
+  (
+    float const (*m)[4],
+    float const* p,
+    float* target
+  )
+{
+  for (size_t i = 0; i < 4; ++i) {
+    target[i] = m[i][0] * p[0] + m[i][1] * p[1] + m[i][2] * p[2] + m[i][3];
+  }
+}
+
+static inline float
+dot3
+  (
+    float const* a,
+    float const* b
+  )
+{ return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+static inline void
+normalize3
+  (
+    float* v
+  )
+{
+  float s = 1.f / sqrtf(dot3(v, v));
+  v[0] *= s;
+  v[1] *= s;
+  v[2] *= s;
+}
+
+static inline float
+smoothstep01
+  (
+    float x
+  )
+{
+  float t = x < 0.f ? 0.f : (x > 1.f ? 1.f : x);
+  return t * t * (3.f - 2.f * t);
+}
+
+static void
+preparePbr1
+  (
+    Visuals_Software_Program* self,
+    Pbr1Uniforms* uniforms,
+    Visuals_UniformBuffer* const* uniformBuffers,
+    size_t numberOfUniformBuffers
+  )
+{
+  // The matrices, the viewer, and the number of clustered lights are read from the "Frame" uniform block.
+  // If no uniform buffer is bound to its binding point, they are zero.
+  Shizu_Integer32 binding = getInteger(self, "Frame", UniformKind_UniformBlock, 0);
+  Visuals_FrameBlock frame;
+  if ((size_t)binding < numberOfUniformBuffers && uniformBuffers[binding] && uniformBuffers[binding]->numberOfBytes >= sizeof(Visuals_FrameBlock)) {
+    memcpy(&frame, uniformBuffers[binding]->bytes, sizeof(Visuals_FrameBlock));
+  } else {
+    memset(&frame, 0, sizeof(Visuals_FrameBlock));
+  }
+  memcpy(uniforms->world, frame.world, sizeof(float) * 16);
+  multiply(uniforms->projectionView, (float const (*)[4])frame.projection, (float const (*)[4])frame.view);
+  memcpy(uniforms->viewer, frame.viewerPosition, sizeof(float) * 3);
+  uniforms->vertexDescriptor = self->vertexFormat ? self->vertexFormat : getInteger(self, "vertexDescriptor", UniformKind_Integer32, 0);
+  uniforms->lightModel = self->lightModel;
+  // The instance descriptor is set by Visuals_Software_Program_setInstance.
+  uniforms->instanceDescriptor = 0;
+
+  static char const* const MATERIALS[] = { "phongMaterial", "blinnPhongMaterial" };
+  float* materials[] = { uniforms->phong, uniforms->blinnPhong };
+  for (size_t i = 0; i < 2; ++i) {
+    char name[64];
+    snprintf(name, sizeof(name), "%s.ambient", MATERIALS[i]);
+    getVector(self, name, UniformKind_Vector3F32, materials[i] + 0, 3);
+    snprintf(name, sizeof(name), "%s.diffuse", MATERIALS[i]);
+    getVector(self, name, UniformKind_Vector3F32, materials[i] + 3, 3);
+    snprintf(name, sizeof(name), "%s.specular", MATERIALS[i]);
+    getVector(self, name, UniformKind_Vector3F32, materials[i] + 6, 3);
+    snprintf(name, sizeof(name), "%s.shininess", MATERIALS[i]);
+    materials[i][9] = getFloat(self, name);
+  }
+
+  // The binding point of a uniform block is 0 by default.
+  binding = getInteger(self, "Materials", UniformKind_UniformBlock, 0);
+  uniforms->materials = NULL;
+  uniforms->numberOfMaterials = 0;
+  if ((size_t)binding < numberOfUniformBuffers && uniformBuffers[binding]) {
+    Visuals_UniformBuffer* buffer = uniformBuffers[binding];
+    uniforms->materials = (uint8_t const*)buffer->bytes;
+    uniforms->numberOfMaterials = buffer->numberOfBytes / MaterialInfoSize;
+    if (uniforms->numberOfMaterials > MaximumNumberOfMaterials) {
+      uniforms->numberOfMaterials = MaximumNumberOfMaterials;
+    }
+  }
+
+  binding = getInteger(self, "Lights", UniformKind_UniformBlock, 0);
+  uniforms->numberOfLights = 0;
+  if ((size_t)binding < numberOfUniformBuffers && uniformBuffers[binding] && uniformBuffers[binding]->numberOfBytes >= sizeof(Visuals_LightBlock)) {
+    Visuals_LightBlock const* block = (Visuals_LightBlock const*)uniformBuffers[binding]->bytes;
+    Shizu_Integer32 numberOfLights = block->numberOfLights;
+    uniforms->numberOfLights = numberOfLights < 0 ? 0 : (numberOfLights > MaximumNumberOfLights ? MaximumNumberOfLights : numberOfLights);
+    for (Shizu_Integer32 i = 0; i < uniforms->numberOfLights; ++i) {
+      Pbr1Light* light = &uniforms->lights[i];
+      Visuals_LightData const* data = &block->lights[i];
+      light->type = data->type;
+      memcpy(light->color, data->color, sizeof(float) * 3);
+      memcpy(light->position, data->position, sizeof(float) * 3);
+      memcpy(light->direction, data->direction, sizeof(float) * 3);
+      light->radius = data->radius;
+      light->cosInnerAngle = data->cosInnerAngle;
+      light->cosOuterAngle = data->cosOuterAngle;
+    }
+  }
+
+  // The kernel does not use the clusters: It evaluates all clustered lights within their radius.
+  Shizu_Integer32 numberOfClusteredLights = frame.numberOfClusteredLights;
+  binding = getInteger(self, "ClusteredLights", UniformKind_UniformBlock, 0);
+  uniforms->clusteredLights = NULL;
+  uniforms->numberOfClusteredLights = 0;
+  if (numberOfClusteredLights > 0 && (size_t)binding < numberOfUniformBuffers && uniformBuffers[binding]) {
+    Visuals_UniformBuffer* buffer = uniformBuffers[binding];
+    uniforms->clusteredLights = (float const*)buffer->bytes;
+    uniforms->numberOfClusteredLights = buffer->numberOfBytes / (sizeof(float) * 8);
+    if (uniforms->numberOfClusteredLights > (size_t)numberOfClusteredLights) {
+      uniforms->numberOfClusteredLights = (size_t)numberOfClusteredLights;
+    }
+  }
+  Visuals_Software_Program_setInstance(self, NULL);
+}
+
+void
+Visuals_Software_Program_prepare
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    Visuals_UniformBuffer* const* uniformBuffers,
+    size_t numberOfUniformBuffers
+  )
+{
+  switch (self->kernel) {
+    case Visuals_Software_ProgramKernel_Simple: {
+      SimpleUniforms* uniforms = (SimpleUniforms*)self->kernelUniforms;
+      Visuals_Software_Uniform* uniform = findUniform(self, "scale", UniformKind_Matrix4F32);
+      if (uniform) {
+        memcpy(uniforms->scale, uniform->value.f, sizeof(float) * 16);
+      } else {
+        static float const IDENTITY[4][4] = { { 1.f, 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f, 0.f }, { 0.f, 0.f, 1.f, 0.f }, { 0.f, 0.f, 0.f, 1.f } };
+        memcpy(uniforms->scale, IDENTITY, sizeof(float) * 16);
+      }
+      uniform = findUniform(self, "inputColor", UniformKind_Vector4F32);
+      if (uniform) {
+        memcpy(uniforms->color, uniform->value.f, sizeof(float) * 4);
+      } else {
+        static float const DEFAULT_COLOR[4] = { 1.f, 0.8f, 0.2f, 0.f };
+        memcpy(uniforms->color, DEFAULT_COLOR, sizeof(float) * 4);
+      }
+    } break;
+    case Visuals_Software_ProgramKernel_Pbr1: {
+      preparePbr1(self, (Pbr1Uniforms*)self->kernelUniforms, uniformBuffers, numberOfUniformBuffers);
+    } break;
+  };
+}
+
+void
+Visuals_Software_Program_setInstance
+  (
+    Visuals_Software_Program* self,
+    Visuals_Software_InstanceAttributes const* instance
+  )
+{
+  if (Visuals_Software_ProgramKernel_Pbr1 != self->kernel) {
+    return;
+  }
+  Pbr1Uniforms* uniforms = (Pbr1Uniforms*)self->kernelUniforms;
+  uniforms->instanceMaterialIndex = 0;
+  // The format of instance buffers was validated by Visuals_Context_renderInstanced.
+  uniforms->instanceDescriptor = instance ? InstanceSemantics_Transform3x4_MaterialIndex : 0;
+  if (instance) {
+    float const t[4][4] = {
+      { instance->transform[0][0], instance->transform[0][1], instance->transform[0][2], instance->transform[0][3] },
+      { instance->transform[1][0], instance->transform[1][1], instance->transform[1][2], instance->transform[1][3] },
+      { instance->transform[2][0], instance->transform[2][1], instance->transform[2][2], instance->transform[2][3] },
+      { 0.f, 0.f, 0.f, 1.f },
+    };
+    multiply(uniforms->instanceWorld, (float const (*)[4])uniforms->world, t);
+    uniforms->instanceMaterialIndex = instance->materialIndex;
+  } else {
+    memcpy(uniforms->instanceWorld, uniforms->world, sizeof(float) * 16);
+  }
+  multiply(uniforms->modelToProjection, (float const (*)[4])uniforms->projectionView, (float const (*)[4])uniforms->instanceWorld);
+  // The normal matrix is the inverse of the transpose of the upper left 3x3 matrix of the world matrix,
+  // that is its cofactor matrix divided by its determinant.
+  float const (*w)[4] = (float const (*)[4])uniforms->instanceWorld;
+  float (*n)[3] = uniforms->normalMatrix;
+  n[0][0] = w[1][1] * w[2][2] - w[1][2] * w[2][1];
+  n[0][1] = w[1][2] * w[2][0] - w[1][0] * w[2][2];
+  n[0][2] = w[1][0] * w[2][1] - w[1][1] * w[2][0];
+  n[1][0] = w[0][2] * w[2][1] - w[0][1] * w[2][2];
+  n[1][1] = w[0][0] * w[2][2] - w[0][2] * w[2][0];
+  n[1][2] = w[0][1] * w[2][0] - w[0][0] * w[2][1];
+  n[2][0] = w[0][1] * w[1][2] - w[0][2] * w[1][1];
+  n[2][1] = w[0][2] * w[1][0] - w[0][0] * w[1][2];
+  n[2][2] = w[0][0] * w[1][1] - w[0][1] * w[1][0];
+  float determinant = w[0][0] * n[0][0] + w[0][1] * n[0][1] + w[0][2] * n[0][2];
+  float s = 1.f / determinant;
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      n[i][j] *= s;
+    }
+  }
+}
+
+static void
+readMaterial
+  (
+    uint8_t const* p,
+    float* material
+  )
+{
+  memcpy(material + 0, p + 0, sizeof(float) * 3);
+  memcpy(material + 3, p + 16, sizeof(float) * 3);
+  memcpy(material + 6, p + 32, sizeof(float) * 3);
+  memcpy(material + 9, p + 44, sizeof(float) * 1);
+}
+
+static void
+shadeVertexPbr1
+  (
+    Pbr1Uniforms const* uniforms,
+    Visuals_Software_VertexAttributes const* attributes,
+    Visuals_Software_Vertex* vertex
+  )
+{
+  float* v = vertex->varyings;
+  transform((float const (*)[4])uniforms->modelToProjection, attributes->position, vertex->position);
+  float worldPosition[4];
+  transform((float const (*)[4])uniforms->instanceWorld, attributes->position, worldPosition);
+  v[Pbr1_WorldPosition + 0] = worldPosition[0];
+  v[Pbr1_WorldPosition + 1] = worldPosition[1];
+  v[Pbr1_WorldPosition + 2] = worldPosition[2];
+  for (size_t i = 0; i < 3; ++i) {
+    v[Pbr1_Normal + i] = dot3(uniforms->normalMatrix[i], attributes->normal);
+  }
+  Pbr1Material phong, blinnPhong;
+  memcpy(phong, uniforms->phong, sizeof(Pbr1Material));
+  memcpy(blinnPhong, uniforms->blinnPhong, sizeof(Pbr1Material));
+  switch (uniforms->vertexDescriptor) {
+    case VertexSemantics_PositionXyz_NormalXyz_AmbientRgb: {
+      memcpy(phong + 0, attributes->ambient, sizeof(float) * 3);
+      memcpy(blinnPhong + 0, attributes->ambient, sizeof(float) * 3);
+    } break;
+    case VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess: {
+      memcpy(phong + 0, attributes->ambient, sizeof(float) * 3);
+      memcpy(phong + 3, attributes->diffuse, sizeof(float) * 3);
+      memcpy(phong + 6, attributes->specular, sizeof(float) * 3);
+      phong[9] = attributes->shininess;
+      memcpy(blinnPhong, phong, sizeof(Pbr1Material));
+    } break;
+    case VertexSemantics_PositionXyz_NormalXyz_MaterialIndex:
+    case VertexSemantics_PositionXyz_NormalXyz_TextureUv_MaterialIndex: {
+      uint32_t materialIndex = attributes->materialIndex;
+      if (InstanceSemantics_Transform3x4_MaterialIndex == uniforms->instanceDescriptor) {
+        materialIndex = uniforms->instanceMaterialIndex;
+      }
+      if (materialIndex > MaximumNumberOfMaterials - 1) {
+        materialIndex = MaximumNumberOfMaterials - 1;
+      }
+      if (materialIndex < uniforms->numberOfMaterials) {
+        uint8_t const* p = uniforms->materials + materialIndex * MaterialInfoSize;
+        readMaterial(p, phong);
+        readMaterial(p + MaterialInfoSize / 2, blinnPhong);
+      } else {
+        memset(phong, 0, sizeof(Pbr1Material));
+        memset(blinnPhong, 0, sizeof(Pbr1Material));
+      }
+    } break;
+  };
+  memcpy(v + Pbr1_PhongAmbient, phong, sizeof(Pbr1Material));
+  memcpy(v + Pbr1_BlinnPhongSpecular, blinnPhong + 6, sizeof(float) * 4);
+}
+
+// Add the contribution of a point specular light.
+static void
+shadePointSpecularPbr1
+  (
+    Pbr1Uniforms const* uniforms,
+    float const* v,
+    Shizu_Integer32 type,
+    float const* position,
+    float const* color,
+    float* specular
+  )
+{
+  float const* worldPosition = v + Pbr1_WorldPosition;
+  float const* normal = v + Pbr1_Normal;
+  float toViewer[3], toLight[3];
+  for (size_t j = 0; j < 3; ++j) {
+    toViewer[j] = uniforms->viewer[j] - worldPosition[j];
+    toLight[j] = position[j] - worldPosition[j];
+  }
+  normalize3(toViewer);
+  normalize3(toLight);
+  float term, shininess;
+  float const* factor;
+  if (LightModel_Phong == uniforms->lightModel || (!uniforms->lightModel && LightType_PointSpecularPhong == type)) {
+    // reflect(-toLight, normal) with the unnormalized normal.
+    float d = -dot3(normal, toLight);
+    float reflection[3];
+    for (size_t j = 0; j < 3; ++j) {
+      reflection[j] = -toLight[j] - 2.f * d * normal[j];
+    }
+    normalize3(reflection);
+    term = dot3(toViewer, reflection);
+    shininess = v[Pbr1_PhongShininess];
+    factor = v + Pbr1_PhongSpecular;
+  } else {
+    float halfWay[3] = { toViewer[0] + toLight[0], toViewer[1] + toLight[1], toViewer[2] + toLight[2] };
+    normalize3(halfWay);
+    term = dot3(normal, halfWay);
+    shininess = v[Pbr1_BlinnPhongShininess];
+    factor = v + Pbr1_BlinnPhongSpecular;
+  }
+  float intensity = powf(smoothstep01(term), shininess);
+  for (size_t j = 0; j < 3; ++j) {
+    specular[j] += intensity * factor[j] * color[j];
+  }
+}
+
+// Add the contribution of a point light with the specified color.
+// If the radius is positive, the light fades smoothly to zero at the radius.
+static void
+shadePointPbr1
+  (
+    Pbr1Uniforms const* uniforms,
+    float const* v,
+    float const* position,
+    float radius,
+    float const* color,
+    float* diffuse,
+    float* specular
+  )
+{
+  float const* worldPosition = v + Pbr1_WorldPosition;
+  float const* normal = v + Pbr1_Normal;
+  float toLight[3] = { position[0] - worldPosition[0], position[1] - worldPosition[1], position[2] - worldPosition[2] };
+  float distance = sqrtf(dot3(toLight, toLight));
+  if (!(distance > 0.f)) {
+    return;
+  }
+  float attenuation = 1.f;
+  if (radius > 0.f) {
+    float x = distance / radius;
+    if (!(x < 1.f)) {
+      return;
+    }
+    attenuation = 1.f - x * x * x * x;
+    attenuation *= attenuation;
+  }
+  float attenuatedColor[3] = { color[0] * attenuation, color[1] * attenuation, color[2] * attenuation };
+  float fragmentNormal[3] = { normal[0], normal[1], normal[2] };
+  normalize3(fragmentNormal);
+  float intensity = dot3(fragmentNormal, toLight) / distance;
+  intensity = intensity > 0.f ? intensity : 0.f;
+  for (size_t j = 0; j < 3; ++j) {
+    diffuse[j] += intensity * v[Pbr1_PhongDiffuse + j] * attenuatedColor[j];
+  }
+  shadePointSpecularPbr1(uniforms, v, LightType_PointSpecularPhong, position, attenuatedColor, specular);
+}
+
+static void
+shadeFragmentPbr1
+  (
+    void const* context,
+    float const* v,
+    float* color
+  )
+{
+  Pbr1Uniforms const* uniforms = (Pbr1Uniforms const*)context;
+  float ambient[3] = { 0.f, 0.f, 0.f }, diffuse[3] = { 0.f, 0.f, 0.f }, specular[3] = { 0.f, 0.f, 0.f };
+  float const* worldPosition = v + Pbr1_WorldPosition;
+  float const* normal = v + Pbr1_Normal;
+  for (Shizu_Integer32 i = 0; i < uniforms->numberOfLights; ++i) {
+    Pbr1Light const* light = &uniforms->lights[i];
+    switch (light->type) {
+      case LightType_Ambient: {
+        for (size_t j = 0; j < 3; ++j) {
+          ambient[j] += v[Pbr1_PhongAmbient + j] * light->color[j];
+        }
+      } break;
+      case LightType_DirectionalDiffuse: {
+        float fragmentNormal[3] = { normal[0], normal[1], normal[2] };
+        normalize3(fragmentNormal);
+        float intensity = -dot3(fragmentNormal, light->direction);
+        intensity = intensity > 0.f ? intensity : 0.f;
+        for (size_t j = 0; j < 3; ++j) {
+          diffuse[j] += intensity * v[Pbr1_PhongDiffuse + j] * light->color[j];
+        }
+      } break;
+      case LightType_PointSpecularPhong:
+      case LightType_PointSpecularBlinnPhong: {
+        shadePointSpecularPbr1(uniforms, v, light->type, light->position, light->color, specular);
+      } break;
+      case LightType_Point: {
+        shadePointPbr1(uniforms, v, light->position, light->radius, light->color, diffuse, specular);
+      } break;
+      case LightType_Spot: {
+        float fromLight[3] = { worldPosition[0] - light->position[0], worldPosition[1] - light->position[1], worldPosition[2] - light->position[2] };
+        if (!(dot3(fromLight, fromLight) > 0.f)) {
+          break;
+        }
+        normalize3(fromLight);
+        // smoothstep(cosOuterAngle, cosInnerAngle, cosAngle)
+        float width = light->cosInnerAngle - light->cosOuterAngle;
+        float t = (dot3(fromLight, light->direction) - light->cosOuterAngle) / (width > 1e-4f ? width : 1e-4f);
+        float cone = smoothstep01(t);
+        float color[3] = { light->color[0] * cone, light->color[1] * cone, light->color[2] * cone };
+        shadePointPbr1(uniforms, v, light->position, light->radius, color, diffuse, specular);
+      } break;
+    };
+  }
+  for (size_t i = 0; i < uniforms->numberOfClusteredLights; ++i) {
+    float const* light = uniforms->clusteredLights + i * 8;
+    shadePointPbr1(uniforms, v, light, light[3], light + 4, diffuse, specular);
+  }
+  for (size_t j = 0; j < 3; ++j) {
+    if (diffuse[j] <= 0.f) {
+      specular[j] = 0.f;
+    }
+    color[j] = ambient[j] + diffuse[j] + specular[j];
+  }
+  color[3] = 1.f;
+}
+
+static void
+shadeFragmentSimple
+  (
+    void const* context,
+    float const* v,
+    float* color
+  )
+{
+  SimpleUniforms const* uniforms = (SimpleUniforms const*)context;
+  memcpy(color, uniforms->color, sizeof(float) * 4);
+}
+
+void
+Visuals_Software_Program_shadeVertex
+  (
+    Visuals_Software_Program* self,
+    Visuals_Software_VertexAttributes const* attributes,
+    Visuals_Software_Vertex* vertex
+  )
+{
+  switch (self->kernel) {
+    case Visuals_Software_ProgramKernel_Simple: {
+      SimpleUniforms const* uniforms = (SimpleUniforms const*)self->kernelUniforms;
+      transform((float const (*)[4])uniforms->scale, attributes->position, vertex->position);
+    } break;
+    case Visuals_Software_ProgramKernel_Pbr1: {
+      shadeVertexPbr1((Pbr1Uniforms const*)self->kernelUniforms, attributes, vertex);
+    } break;
+  };
+}
+
+void
+Visuals_Software_Program_getFragmentStage
+  (
+    Visuals_Software_Program* self,
+    Visuals_Software_FragmentStage** fragmentStage,
+    void const** uniforms,
+    size_t* numberOfVaryings
+  )
+{
+  *uniforms = self->kernelUniforms;
+  switch (self->kernel) {
+    case Visuals_Software_ProgramKernel_Pbr1: {
+      *fragmentStage = &shadeFragmentPbr1;
+      *numberOfVaryings = Pbr1_NumberOfVaryings;
+    } break;
+    case Visuals_Software_ProgramKernel_Simple:
+    default: {
+      *fragmentStage = &shadeFragmentSimple;
+      *numberOfVaryings = 0;
+    } break;
+  };
+}
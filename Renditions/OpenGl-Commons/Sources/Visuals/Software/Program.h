@@ -0,0 +1,142 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(VISUALS_SOFTWARE_PROGRAM_H_INCLUDED)
+#define VISUALS_SOFTWARE_PROGRAM_H_INCLUDED
+
+#include "Visuals/Program.h"
+#include "Visuals/UniformBuffer.h"
+#include "Visuals/Software/Rasterizer.h"
+#include "Visuals/Software/VertexBuffer.h"
+
+/// @brief The program is the "simple" program of Visuals_getProgram.
+#define Visuals_Software_ProgramKernel_Simple (1)
+
+/// @brief The program is the "pbr1" program of Visuals_getProgram.
+#define Visuals_Software_ProgramKernel_Pbr1 (2)
+
+/// @brief A uniform of a software program.
+typedef struct Visuals_Software_Uniform Visuals_Software_Uniform;
+
+/// @brief
+/// The implementation of Visuals.Program for the software renderer.
+/// @details
+/// The software renderer does not compile GLSL.
+/// Instead, the vertex source names the program by a pragma
+/// @code
+/// #pragma zeitgeist_program(<name>)
+/// @endcode
+/// and the program is executed by the native C implementation of that program.
+/// The supported names are "simple" and "pbr1" (see Visuals_getProgram).
+/// The values of the uniforms are stored by name.
+/// The type is
+/// @code
+/// class Visuals.Software.Program
+/// @endcode
+/// Its constructor is
+/// @code
+/// Visuals.Software.Program.construct(vertexSource, fragmentSource)
+/// @endcode
+Shizu_declareObjectType(Visuals_Software_Program);
+
+struct Visuals_Software_Program_Dispatch {
+  Visuals_Program_Dispatch _parent;
+};
+
+struct Visuals_Software_Program {
+  Visuals_Program _parent;
+  /// @brief Visuals_Software_ProgramKernel_Simple or Visuals_Software_ProgramKernel_Pbr1.
+  uint8_t kernel;
+  /// @brief The VERTEX_FORMAT define of a permutation or 0.
+  Shizu_Integer32 vertexFormat;
+  /// @brief The LIGHT_MODEL define of a permutation or 0.
+  Shizu_Integer32 lightModel;
+  /// @brief A pointer to an array of @a numberOfUniforms uniforms or the null pointer.
+  Visuals_Software_Uniform* uniforms;
+  size_t numberOfUniforms;
+  size_t uniformCapacity;
+  /// @brief A pointer to the uniforms of the kernel or the null pointer.
+  /// Computed by Visuals_Software_Program_prepare.
+  void* kernelUniforms;
+};
+
+/// @error Shizu_Status_ArgumentValueInvalid the vertex source does not name a supported program.
+void
+Visuals_Software_Program_construct
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    Shizu_String* vertexSource,
+    Shizu_String* fragmentSource
+  );
+
+Visuals_Software_Program*
+Visuals_Software_Program_create
+  (
+    Shizu_State2* state,
+    Shizu_String* vertexSource,
+    Shizu_String* fragmentSource
+  );
+
+/// @brief Prepare this program for a draw call.
+/// @param uniformBuffers A pointer to an array of @a numberOfUniformBuffers pointers to the uniform buffers bound to the binding points.
+/// An element is the null pointer if no uniform buffer is bound to the binding point.
+/// @remarks The uniform values and the uniform buffers must not change until the draw call is complete.
+void
+Visuals_Software_Program_prepare
+  (
+    Shizu_State2* state,
+    Visuals_Software_Program* self,
+    Visuals_UniformBuffer* const* uniformBuffers,
+    size_t numberOfUniformBuffers
+  );
+
+/// @brief Set the instance subsequent vertices are shaded for.
+/// @param instance A pointer to the instance attributes or the null pointer if the draw call is not instanced.
+void
+Visuals_Software_Program_setInstance
+  (
+    Visuals_Software_Program* self,
+    Visuals_Software_InstanceAttributes const* instance
+  );
+
+/// @brief Shade a vertex.
+/// @remarks Vertices of the same instance may be shaded concurrently.
+void
+Visuals_Software_Program_shadeVertex
+  (
+    Visuals_Software_Program* self,
+    Visuals_Software_VertexAttributes const* attributes,
+    Visuals_Software_Vertex* vertex
+  );
+
+/// @brief Get the fragment stage, its uniforms, and the number of varyings of this program.
+/// @remarks The uniforms are valid until the next call to Visuals_Software_Program_prepare.
+void
+Visuals_Software_Program_getFragmentStage
+  (
+    Visuals_Software_Program* self,
+    Visuals_Software_FragmentStage** fragmentStage,
+    void const** uniforms,
+    size_t* numberOfVaryings
+  );
+
+#endif // VISUALS_SOFTWARE_PROGRAM_H_INCLUDED
@@ -0,0 +1,1146 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Visuals/Software/Rasterizer.h"
+
+#include "Visuals/Parallel.h"
+// lrintf
+#include <math.h>
+// malloc, realloc, free
+#include <stdlib.h>
+// memcpy
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define Visuals_Software_Rasterizer_WithSse2 (1)
+  // _mm_*_epi32, _mm_*_ps
+  #include <emmintrin.h>
+#else
+  #define Visuals_Software_Rasterizer_WithSse2 (0)
+#endif
+
+/// @brief The number of bits of sub-pixel precision of the vertex positions.
+#define SubPixelBits (4)
+
+/// @brief One pixel in sub-pixel units.
+#define SubPixelScale (1 << SubPixelBits)
+
+/// @brief The extent, in pixels, of the guard band around the viewport.
+/// Triangles are clipped against the guard band rather than against the viewport.
+/// The guard band keeps the sub-pixel coordinates and the edge functions within their integer ranges.
+#define GuardBand (4096)
+
+/// @brief The number of pixels by which the color buffer and the depth buffer are padded.
+#define Padding (4)
+
+/// @brief A triangle after setup.
+typedef struct Triangle {
+  /// @brief The indices of the vertices.
+  /// Indices greater than or equal to the number of vertices of the draw call denote vertices created by clipping.
+  uint32_t indices[3];
+  /// @brief The edge functions E(x,y) = a x + b y + c in sub-pixel units.
+  /// Edge i is opposite to vertex i. A pixel center is covered if all edge functions are positive.
+  /// The top-left rule is applied by biasing c.
+  int32_t a[3], b[3];
+  int64_t c[3];
+  /// @brief The bounding box [xmin, xmax) x [ymin, ymax), in pixels, clipped against the viewport.
+  int32_t xmin, ymin, xmax, ymax;
+  /// @brief The window position of vertex 0 in pixels.
+  float x0, y0;
+  /// @brief The plane of the window depth relative to vertex 0.
+  float z0, dzdx, dzdy;
+  /// @brief The planes of the linear barycentric coordinates of vertex 1 and vertex 2 relative to vertex 0.
+  float l1dx, l1dy, l2dx, l2dy;
+  /// @brief The reciprocal clip w of the vertices.
+  float w[3];
+  /// @brief The number of varyings which are interpolated.
+  /// The remaining varyings are equal for the three vertices and are not interpolated.
+  uint32_t numberOfInterpolatedVaryings;
+} Triangle;
+
+/// @brief The scratch memory of the rasterizer.
+/// Only accessed by the thread invoking Visuals_Software_Rasterizer_draw.
+static struct {
+  Triangle* triangles;
+  size_t triangleCapacity;
+  /// @brief The vertices created by clipping.
+  Visuals_Software_Vertex* vertices;
+  size_t vertexCapacity;
+  /// @brief For each tile the index of the end of its bin in @a bins.
+  uint32_t* binEnds;
+  size_t binEndCapacity;
+  /// @brief The indices of the triangles binned into the tiles.
+  uint32_t* bins;
+  size_t binCapacity;
+} g_scratch = { NULL, 0, NULL, 0, NULL, 0, NULL, 0 };
+
+static void
+reserve
+  (
+    Shizu_State2* state,
+    void** elements,
+    size_t* capacity,
+    size_t requiredCapacity,
+    size_t elementSize
+  )
+{
+  if (*capacity >= requiredCapacity) {
+    return;
+  }
+  size_t newCapacity = *capacity ? *capacity : 64;
+  while (newCapacity < requiredCapacity) {
+    if (newCapacity > SIZE_MAX / 2) {
+      newCapacity = requiredCapacity;
+      break;
+    }
+    newCapacity *= 2;
+  }
+  if (newCapacity > SIZE_MAX / elementSize) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  void* newElements = realloc(*elements, newCapacity * elementSize);
+  if (!newElements) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  *elements = newElements;
+  *capacity = newCapacity;
+}
+
+static inline float
+clamp01
+  (
+    float x
+  )
+{
+  // Not a number is clamped to 0.
+  return x > 0.f ? (x < 1.f ? x : 1.f) : 0.f;
+}
+
+static inline int32_t
+min32
+  (
+    int32_t x,
+    int32_t y
+  )
+{
+  return x < y ? x : y;
+}
+
+static inline int32_t
+max32
+  (
+    int32_t x,
+    int32_t y
+  )
+{
+  return x > y ? x : y;
+}
+
+/// @brief Compute floor(x / SubPixelScale).
+static inline int32_t
+floorSubPixel
+  (
+    int32_t x
+  )
+{
+  return x >= 0 ? x / SubPixelScale : -((-x + SubPixelScale - 1) / SubPixelScale);
+}
+
+void
+Visuals_Software_FrameBuffer_initialize
+  (
+    Visuals_Software_FrameBuffer* self
+  )
+{
+  self->width = 0;
+  self->height = 0;
+  self->colors = NULL;
+  self->depths = NULL;
+}
+
+void
+Visuals_Software_FrameBuffer_uninitialize
+  (
+    Visuals_Software_FrameBuffer* self
+  )
+{
+  if (self->depths) {
+    free(self->depths);
+    self->depths = NULL;
+  }
+  if (self->colors) {
+    free(self->colors);
+    self->colors = NULL;
+  }
+  self->width = 0;
+  self->height = 0;
+}
+
+void
+Visuals_Software_FrameBuffer_resize
+  (
+    Shizu_State2* state,
+    Visuals_Software_FrameBuffer* self,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  )
+{
+  if (width < 0 || width > Visuals_Software_MaximalFrameBufferSize || height < 0 || height > Visuals_Software_MaximalFrameBufferSize) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  if (self->width == width && self->height == height) {
+    return;
+  }
+  uint8_t* colors = NULL;
+  float* depths = NULL;
+  if (width > 0 && height > 0) {
+    size_t numberOfPixels = (size_t)width * (size_t)height + Padding;
+    colors = malloc(numberOfPixels * 4);
+    depths = malloc(numberOfPixels * sizeof(float));
+    if (!colors || !depths) {
+      if (depths) {
+        free(depths);
+      }
+      if (colors) {
+        free(colors);
+      }
+      Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State2_jump(state);
+    }
+    memset(colors, 0, numberOfPixels * 4);
+    for (size_t i = 0; i < numberOfPixels; ++i) {
+      depths[i] = 1.f;
+    }
+  }
+  Visuals_Software_FrameBuffer_uninitialize(self);
+  self->width = width;
+  self->height = height;
+  self->colors = colors;
+  self->depths = depths;
+}
+
+/// @brief The intersection of a viewport with the frame buffer.
+/// @return @a true if the intersection is not empty, @a false otherwise.
+static bool
+getScissorRectangle
+  (
+    Visuals_Software_FrameBuffer const* target,
+    Shizu_Integer32 const* viewport,
+    int32_t* rectangle
+  )
+{
+  rectangle[0] = max32(viewport[0], 0);
+  rectangle[1] = max32(viewport[1], 0);
+  rectangle[2] = (int32_t)((int64_t)viewport[0] + viewport[2] < target->width ? (int64_t)viewport[0] + viewport[2] : target->width);
+  rectangle[3] = (int32_t)((int64_t)viewport[1] + viewport[3] < target->height ? (int64_t)viewport[1] + viewport[3] : target->height);
+  return rectangle[0] < rectangle[2] && rectangle[1] < rectangle[3];
+}
+
+typedef struct ClearContext {
+  Visuals_Software_FrameBuffer* target;
+  int32_t rectangle[4];
+  bool colorBuffer;
+  uint8_t color[4];
+  bool depthBuffer;
+  float depth;
+} ClearContext;
+
+/// @brief The number of rows cleared by one invocation of clearRows.
+#define NumberOfRowsPerBand (32)
+
+static void
+clearRows
+  (
+    void* context,
+    size_t index
+  )
+{
+  ClearContext const* c = (ClearContext const*)context;
+  int32_t y0 = c->rectangle[1] + (int32_t)index * NumberOfRowsPerBand;
+  int32_t y1 = min32(y0 + NumberOfRowsPerBand, c->rectangle[3]);
+  for (int32_t y = y0; y < y1; ++y) {
+    size_t offset = (size_t)y * (size_t)c->target->width;
+    if (c->colorBuffer) {
+      uint8_t* p = c->target->colors + (offset + (size_t)c->rectangle[0]) * 4;
+      for (int32_t x = c->rectangle[0]; x < c->rectangle[2]; ++x) {
+        memcpy(p, c->color, 4);
+        p += 4;
+      }
+    }
+    if (c->depthBuffer) {
+      float* p = c->target->depths + offset;
+      for (int32_t x = c->rectangle[0]; x < c->rectangle[2]; ++x) {
+        p[x] = c->depth;
+      }
+    }
+  }
+}
+
+void
+Visuals_Software_Rasterizer_clear
+  (
+    Shizu_State2* state,
+    Visuals_Software_FrameBuffer* target,
+    Shizu_Integer32 const* viewport,
+    bool colorBuffer,
+    float const* color,
+    bool depthBuffer,
+    float depth
+  )
+{
+  ClearContext context;
+  if (!target->colors || !getScissorRectangle(target, viewport, context.rectangle)) {
+    return;
+  }
+  context.target = target;
+  context.colorBuffer = colorBuffer;
+  for (size_t i = 0; i < 4; ++i) {
+    context.color[i] = (uint8_t)(clamp01(color[i]) * 255.f + 0.5f);
+  }
+  context.depthBuffer = depthBuffer;
+  context.depth = clamp01(depth);
+  size_t numberOfRows = (size_t)(context.rectangle[3] - context.rectangle[1]);
+  Visuals_Parallel_run(&clearRows, &context, (numberOfRows + NumberOfRowsPerBand - 1) / NumberOfRowsPerBand);
+}
+
+/// @brief The weight of the difference between a sample and its neighbours added by the sharpen filter.
+#define Sharpness (0.5f)
+
+typedef struct BlitContext {
+  Visuals_Software_FrameBuffer* target;
+  int32_t rectangle[4];
+  Shizu_Integer32 viewport[4];
+  Visuals_Software_FrameBuffer const* source;
+  Shizu_Integer32 sourceRectangle[4];
+  Visuals_BlitFilter filter;
+} BlitContext;
+
+// Sample the source bilinearly at (u,v) in pixels. Samples outside of the source rectangle are clamped to it.
+static inline void
+sampleLinear
+  (
+    BlitContext const* c,
+    float u,
+    float v,
+    float* color
+  )
+{
+  float x = u - 0.5f, y = v - 0.5f;
+  float fx = floorf(x), fy = floorf(y);
+  float wx = x - fx, wy = y - fy;
+  int32_t x0 = max32(min32((int32_t)fx, c->sourceRectangle[0] + c->sourceRectangle[2] - 1), c->sourceRectangle[0]);
+  int32_t y0 = max32(min32((int32_t)fy, c->sourceRectangle[1] + c->sourceRectangle[3] - 1), c->sourceRectangle[1]);
+  int32_t x1 = max32(min32((int32_t)fx + 1, c->sourceRectangle[0] + c->sourceRectangle[2] - 1), c->sourceRectangle[0]);
+  int32_t y1 = max32(min32((int32_t)fy + 1, c->sourceRectangle[1] + c->sourceRectangle[3] - 1), c->sourceRectangle[1]);
+  uint8_t const* p00 = c->source->colors + ((size_t)y0 * (size_t)c->source->width + (size_t)x0) * 4;
+  uint8_t const* p10 = c->source->colors + ((size_t)y0 * (size_t)c->source->width + (size_t)x1) * 4;
+  uint8_t const* p01 = c->source->colors + ((size_t)y1 * (size_t)c->source->width + (size_t)x0) * 4;
+  uint8_t const* p11 = c->source->colors + ((size_t)y1 * (size_t)c->source->width + (size_t)x1) * 4;
+  for (size_t i = 0; i < 4; ++i) {
+    float bottom = p00[i] + (p10[i] - p00[i]) * wx;
+    float top = p01[i] + (p11[i] - p01[i]) * wx;
+    color[i] = bottom + (top - bottom) * wy;
+  }
+}
+
+static void
+blitRows
+  (
+    void* context,
+    size_t index
+  )
+{
+  BlitContext const* c = (BlitContext const*)context;
+  int32_t y0 = c->rectangle[1] + (int32_t)index * NumberOfRowsPerBand;
+  int32_t y1 = min32(y0 + NumberOfRowsPerBand, c->rectangle[3]);
+  float sx = (float)c->sourceRectangle[2] / (float)c->viewport[2];
+  float sy = (float)c->sourceRectangle[3] / (float)c->viewport[3];
+  for (int32_t y = y0; y < y1; ++y) {
+    float v = (float)c->sourceRectangle[1] + ((float)(y - c->viewport[1]) + 0.5f) * sy;
+    uint8_t* p = c->target->colors + ((size_t)y * (size_t)c->target->width + (size_t)c->rectangle[0]) * 4;
+    for (int32_t x = c->rectangle[0]; x < c->rectangle[2]; ++x) {
+      float u = (float)c->sourceRectangle[0] + ((float)(x - c->viewport[0]) + 0.5f) * sx;
+      switch (c->filter) {
+        case Visuals_BlitFilter_Nearest: {
+          int32_t sx0 = min32((int32_t)u, c->sourceRectangle[0] + c->sourceRectangle[2] - 1);
+          int32_t sy0 = min32((int32_t)v, c->sourceRectangle[1] + c->sourceRectangle[3] - 1);
+          memcpy(p, c->source->colors + ((size_t)sy0 * (size_t)c->source->width + (size_t)sx0) * 4, 4);
+        } break;
+        case Visuals_BlitFilter_Linear: {
+          float color[4];
+          sampleLinear(c, u, v, color);
+          for (size_t i = 0; i < 4; ++i) {
+            p[i] = (uint8_t)(color[i] + 0.5f);
+          }
+        } break;
+        case Visuals_BlitFilter_Sharpen: {
+          float center[4], w[4], e[4], s[4], n[4];
+          sampleLinear(c, u, v, center);
+          sampleLinear(c, u - 1.f, v, w);
+          sampleLinear(c, u + 1.f, v, e);
+          sampleLinear(c, u, v - 1.f, s);
+          sampleLinear(c, u, v + 1.f, n);
+          for (size_t i = 0; i < 4; ++i) {
+            float minimum = fminf(center[i], fminf(fminf(w[i], e[i]), fminf(s[i], n[i])));
+            float maximum = fmaxf(center[i], fmaxf(fmaxf(w[i], e[i]), fmaxf(s[i], n[i])));
+            float sharpened = center[i] + Sharpness * (4.f * center[i] - w[i] - e[i] - s[i] - n[i]);
+            sharpened = sharpened < minimum ? minimum : (sharpened > maximum ? maximum : sharpened);
+            p[i] = (uint8_t)(sharpened + 0.5f);
+          }
+        } break;
+      };
+      p += 4;
+    }
+  }
+}
+
+void
+Visuals_Software_Rasterizer_blit
+  (
+    Shizu_State2* state,
+    Visuals_Software_FrameBuffer* target,
+    Shizu_Integer32 const* viewport,
+    Visuals_Software_FrameBuffer const* source,
+    Shizu_Integer32 const* sourceRectangle,
+    Visuals_BlitFilter filter
+  )
+{
+  BlitContext context;
+  if (!target->colors || !source->colors || !getScissorRectangle(target, viewport, context.rectangle)) {
+    return;
+  }
+  context.target = target;
+  memcpy(context.viewport, viewport, sizeof(context.viewport));
+  context.source = source;
+  memcpy(context.sourceRectangle, sourceRectangle, sizeof(context.sourceRectangle));
+  context.filter = filter;
+  size_t numberOfRows = (size_t)(context.rectangle[3] - context.rectangle[1]);
+  Visuals_Parallel_run(&blitRows, &context, (numberOfRows + NumberOfRowsPerBand - 1) / NumberOfRowsPerBand);
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/// @brief The clip planes.
+/// A vertex is inside of a plane if the distance returned by getDistance is non-negative.
+typedef enum ClipPlane {
+  ClipPlane_Near = 0,
+  ClipPlane_Far = 1,
+  ClipPlane_Left = 2,
+  ClipPlane_Right = 3,
+  ClipPlane_Bottom = 4,
+  ClipPlane_Top = 5,
+} ClipPlane;
+
+#define NumberOfClipPlanes (6)
+
+/// @brief The maximal number of vertices of a triangle clipped against the clip planes.
+#define MaximalNumberOfClippedVertices (3 + NumberOfClipPlanes)
+
+/// @param guardBand The extents of the guard band along the x-axis and the y-axis in normalized device coordinates.
+static inline float
+getDistance
+  (
+    float const* p,
+    ClipPlane plane,
+    float const* guardBand
+  )
+{
+  switch (plane) {
+    case ClipPlane_Near: {
+      return p[2] + p[3];
+    } break;
+    case ClipPlane_Far: {
+      return p[3] - p[2];
+    } break;
+    case ClipPlane_Left: {
+      return p[0] + guardBand[0] * p[3];
+    } break;
+    case ClipPlane_Right: {
+      return guardBand[0] * p[3] - p[0];
+    } break;
+    case ClipPlane_Bottom: {
+      return p[1] + guardBand[1] * p[3];
+    } break;
+    case ClipPlane_Top:
+    default: {
+      return guardBand[1] * p[3] - p[1];
+    } break;
+  };
+}
+
+static inline uint32_t
+getOutCode
+  (
+    float const* p,
+    float const* guardBand
+  )
+{
+  uint32_t outCode = 0;
+  for (uint32_t i = 0; i < NumberOfClipPlanes; ++i) {
+    if (getDistance(p, (ClipPlane)i, guardBand) < 0.f) {
+      outCode |= 1 << i;
+    }
+  }
+  return outCode;
+}
+
+/// @brief The state of the triangle setup of a draw call.
+typedef struct Setup {
+  Visuals_Software_DrawCall const* drawCall;
+  /// @brief The scissor rectangle.
+  int32_t rectangle[4];
+  /// @brief The extents of the guard band.
+  float guardBand[2];
+  /// @brief The number of triangles.
+  size_t numberOfTriangles;
+  /// @brief The number of vertices created by clipping.
+  size_t numberOfVertices;
+} Setup;
+
+static inline Visuals_Software_Vertex const*
+getVertex
+  (
+    Visuals_Software_DrawCall const* drawCall,
+    uint32_t index
+  )
+{
+  return index < drawCall->numberOfVertices ? &drawCall->vertices[index] : &g_scratch.vertices[index - drawCall->numberOfVertices];
+}
+
+/// @brief Setup a triangle and append it to the triangles if it is neither degenerate, culled, nor outside of the scissor rectangle.
+/// The vertices must be inside of the clip planes.
+static void
+setupTriangle
+  (
+    Shizu_State2* state,
+    Setup* setup,
+    uint32_t const* indices
+  )
+{
+  Visuals_Software_DrawCall const* drawCall = setup->drawCall;
+  Visuals_Software_PipelineState const* pipelineState = drawCall->pipelineState;
+  Shizu_Integer32 const* viewport = pipelineState->viewport;
+  Visuals_Software_Vertex const* v[3];
+  float x[3], y[3], z[3], w[3];
+  int32_t X[3], Y[3];
+  for (size_t i = 0; i < 3; ++i) {
+    v[i] = getVertex(drawCall, indices[i]);
+    float const* p = v[i]->position;
+    if (p[3] <= 0.f) {
+      // Degenerate.
+      return;
+    }
+    w[i] = 1.f / p[3];
+    X[i] = (int32_t)lrintf(((float)viewport[0] + (p[0] * w[i] + 1.f) * 0.5f * (float)viewport[2]) * (float)SubPixelScale);
+    Y[i] = (int32_t)lrintf(((float)viewport[1] + (p[1] * w[i] + 1.f) * 0.5f * (float)viewport[3]) * (float)SubPixelScale);
+    x[i] = (float)X[i] / (float)SubPixelScale;
+    y[i] = (float)Y[i] / (float)SubPixelScale;
+    z[i] = clamp01(p[2] * w[i] * 0.5f + 0.5f);
+  }
+  // Twice the signed area in sub-pixel units. Positive for counter-clockwise triangles.
+  int64_t area = (int64_t)(X[1] - X[0]) * (int64_t)(Y[2] - Y[0]) - (int64_t)(X[2] - X[0]) * (int64_t)(Y[1] - Y[0]);
+  if (0 == area) {
+    return;
+  }
+  // Counter-clockwise triangles are front-facing.
+  switch (pipelineState->cullMode) {
+    case Visuals_CullMode_Back: {
+      if (area < 0) {
+        return;
+      }
+    } break;
+    case Visuals_CullMode_Front: {
+      if (area > 0) {
+        return;
+      }
+    } break;
+    case Visuals_CullMode_FrontAndBack: {
+      return;
+    } break;
+    case Visuals_CullMode_None:
+    default: {
+    } break;
+  };
+  uint32_t order[3] = { indices[0], indices[1], indices[2] };
+  if (area < 0) {
+    // Make the triangle counter-clockwise.
+    area = -area;
+  #define SWAP(T, a, b) { T t = a; a = b; b = t; }
+    SWAP(uint32_t, order[1], order[2]);
+    SWAP(Visuals_Software_Vertex const*, v[1], v[2]);
+    SWAP(float, x[1], x[2]);
+    SWAP(float, y[1], y[2]);
+    SWAP(float, z[1], z[2]);
+    SWAP(float, w[1], w[2]);
+    SWAP(int32_t, X[1], X[2]);
+    SWAP(int32_t, Y[1], Y[2]);
+  #undef SWAP
+  }
+  int32_t minX = min32(X[0], min32(X[1], X[2])), maxX = max32(X[0], max32(X[1], X[2]));
+  int32_t minY = min32(Y[0], min32(Y[1], Y[2])), maxY = max32(Y[0], max32(Y[1], Y[2]));
+  // The pixel centers are at (x + 1/2, y + 1/2).
+  int32_t xmin = max32(setup->rectangle[0], floorSubPixel(minX - SubPixelScale / 2 + SubPixelScale - 1));
+  int32_t xmax = min32(setup->rectangle[2], floorSubPixel(maxX - SubPixelScale / 2) + 1);
+  int32_t ymin = max32(setup->rectangle[1], floorSubPixel(minY - SubPixelScale / 2 + SubPixelScale - 1));
+  int32_t ymax = min32(setup->rectangle[3], floorSubPixel(maxY - SubPixelScale / 2) + 1);
+  if (xmin >= xmax || ymin >= ymax) {
+    return;
+  }
+  reserve(state, (void**)&g_scratch.triangles, &g_scratch.triangleCapacity, setup->numberOfTriangles + 1, sizeof(Triangle));
+  Triangle* t = &g_scratch.triangles[setup->numberOfTriangles];
+  for (size_t i = 0; i < 3; ++i) {
+    t->indices[i] = order[i];
+    size_t j = (i + 1) % 3, k = (i + 2) % 3;
+    int32_t dx = X[k] - X[j], dy = Y[k] - Y[j];
+    t->a[i] = -dy;
+    t->b[i] = dx;
+    t->c[i] = (int64_t)dy * (int64_t)X[j] - (int64_t)dx * (int64_t)Y[j];
+    // Top-left rule: Pixel centers on left edges and on top edges are covered.
+    if (dy < 0 || (dy == 0 && dx < 0)) {
+      t->c[i] += 1;
+    }
+    t->w[i] = w[i];
+  }
+  t->xmin = xmin;
+  t->xmax = xmax;
+  t->ymin = ymin;
+  t->ymax = ymax;
+  t->x0 = x[0];
+  t->y0 = y[0];
+  double twiceArea = (double)area / (double)(SubPixelScale * SubPixelScale);
+  t->l1dx = (float)(-(double)(y[0] - y[2]) / twiceArea);
+  t->l1dy = (float)((double)(x[0] - x[2]) / twiceArea);
+  t->l2dx = (float)(-(double)(y[1] - y[0]) / twiceArea);
+  t->l2dy = (float)((double)(x[1] - x[0]) / twiceArea);
+  t->z0 = z[0];
+  t->dzdx = (z[1] - z[0]) * t->l1dx + (z[2] - z[0]) * t->l2dx;
+  t->dzdy = (z[1] - z[0]) * t->l1dy + (z[2] - z[0]) * t->l2dy;
+  uint32_t n = (uint32_t)drawCall->numberOfVaryings;
+  while (n > 0 && v[0]->varyings[n - 1] == v[1]->varyings[n - 1] && v[0]->varyings[n - 1] == v[2]->varyings[n - 1]) {
+    n--;
+  }
+  t->numberOfInterpolatedVaryings = n;
+  setup->numberOfTriangles++;
+}
+
+static void
+interpolateVertex
+  (
+    Visuals_Software_Vertex* target,
+    Visuals_Software_Vertex const* source0,
+    Visuals_Software_Vertex const* source1,
+    float t,
+    size_t numberOfVaryings
+  )
+{
+  for (size_t i = 0; i < 4; ++i) {
+    target->position[i] = source0->position[i] + t * (source1->position[i] - source0->position[i]);
+  }
+  for (size_t i = 0; i < numberOfVaryings; ++i) {
+    target->varyings[i] = source0->varyings[i] + t * (source1->varyings[i] - source0->varyings[i]);
+  }
+}
+
+/// @brief Clip a triangle against the clip planes in @a outCodes and setup the resulting triangles.
+static void
+clipTriangle
+  (
+    Shizu_State2* state,
+    Setup* setup,
+    uint32_t const* indices,
+    uint32_t outCodes
+  )
+{
+  Visuals_Software_DrawCall const* drawCall = setup->drawCall;
+  // Ensure the clipped vertices can be stored without reallocation.
+  size_t base = drawCall->numberOfVertices;
+  if (base + setup->numberOfVertices + NumberOfClipPlanes * 2 > UINT32_MAX) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  reserve(state, (void**)&g_scratch.vertices, &g_scratch.vertexCapacity, setup->numberOfVertices + NumberOfClipPlanes * 2, sizeof(Visuals_Software_Vertex));
+  uint32_t polygon[2][MaximalNumberOfClippedVertices];
+  size_t numberOfPolygonVertices = 3;
+  size_t current = 0;
+  polygon[0][0] = indices[0];
+  polygon[0][1] = indices[1];
+  polygon[0][2] = indices[2];
+  for (uint32_t plane = 0; plane < NumberOfClipPlanes; ++plane) {
+    if (!(outCodes & (1 << plane))) {
+      continue;
+    }
+    uint32_t const* source = polygon[current];
+    uint32_t* target = polygon[1 - current];
+    size_t numberOfTargetVertices = 0;
+    for (size_t i = 0; i < numberOfPolygonVertices; ++i) {
+      uint32_t a = source[i], b = source[(i + 1) % numberOfPolygonVertices];
+      Visuals_Software_Vertex const* va = getVertex(drawCall, a), * vb = getVertex(drawCall, b);
+      float da = getDistance(va->position, (ClipPlane)plane, setup->guardBand);
+      float db = getDistance(vb->position, (ClipPlane)plane, setup->guardBand);
+      if (da >= 0.f) {
+        target[numberOfTargetVertices++] = a;
+      }
+      if ((da >= 0.f) != (db >= 0.f)) {
+        Visuals_Software_Vertex* v = &g_scratch.vertices[setup->numberOfVertices];
+        interpolateVertex(v, va, vb, da / (da - db), drawCall->numberOfVaryings);
+        target[numberOfTargetVertices++] = (uint32_t)(base + setup->numberOfVertices);
+        setup->numberOfVertices++;
+      }
+    }
+    current = 1 - current;
+    numberOfPolygonVertices = numberOfTargetVertices;
+    if (numberOfPolygonVertices < 3) {
+      return;
+    }
+  }
+  for (size_t i = 1; i + 1 < numberOfPolygonVertices; ++i) {
+    uint32_t triangle[3] = { polygon[current][0], polygon[current][i], polygon[current][i + 1] };
+    setupTriangle(state, setup, triangle);
+  }
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/// @brief The context of the rasterization of the tiles.
+typedef struct RasterContext {
+  Visuals_Software_FrameBuffer* target;
+  Visuals_Software_DrawCall const* drawCall;
+  Triangle const* triangles;
+  uint32_t const* binEnds;
+  uint32_t const* bins;
+  size_t numberOfTilesX;
+} RasterContext;
+
+static inline float
+getBlendFactor
+  (
+    Visuals_BlendFactor blendFactor,
+    float sourceAlpha
+  )
+{
+  return Visuals_BlendFactor_SourceAlpha == blendFactor ? sourceAlpha : 1.f - sourceAlpha;
+}
+
+static inline bool
+testDepth
+  (
+    Visuals_DepthFunction depthFunction,
+    float z,
+    float d
+  )
+{
+  switch (depthFunction) {
+    case Visuals_DepthFunction_LessThan: return z < d;
+    case Visuals_DepthFunction_LessThanOrEqualTo: return z <= d;
+    case Visuals_DepthFunction_EqualTo: return z == d;
+    case Visuals_DepthFunction_GreaterThan: return z > d;
+    case Visuals_DepthFunction_GreaterThanOrEqualTo: return z >= d;
+    case Visuals_DepthFunction_NotEqualTo: return z != d;
+    case Visuals_DepthFunction_Always: return true;
+    case Visuals_DepthFunction_Never:
+    default: return false;
+  };
+}
+
+/// @brief Shade a fragment and write its color.
+/// @param b1, b2 The perspective-correct barycentric coordinates of vertex 1 and vertex 2.
+static inline void
+shadeFragment
+  (
+    RasterContext const* context,
+    Triangle const* t,
+    Visuals_Software_Vertex const* v0,
+    float const* d1,
+    float const* d2,
+    float* varyings,
+    float b1,
+    float b2,
+    uint8_t* p
+  )
+{
+  Visuals_Software_PipelineState const* pipelineState = context->drawCall->pipelineState;
+  for (uint32_t i = 0; i < t->numberOfInterpolatedVaryings; ++i) {
+    varyings[i] = v0->varyings[i] + b1 * d1[i] + b2 * d2[i];
+  }
+  float color[4];
+  context->drawCall->fragmentStage(context->drawCall->uniforms, varyings, color);
+  if (pipelineState->blend) {
+    float s = getBlendFactor(pipelineState->sourceFactor, color[3]);
+    float d = getBlendFactor(pipelineState->targetFactor, color[3]);
+    for (size_t i = 0; i < 4; ++i) {
+      color[i] = s * color[i] + d * ((float)p[i] / 255.f);
+    }
+  }
+  for (size_t i = 0; i < 4; ++i) {
+    p[i] = (uint8_t)(clamp01(color[i]) * 255.f + 0.5f);
+  }
+}
+
+/// @brief Rasterize a triangle within the rectangle of a tile.
+static void
+rasterizeTriangle
+  (
+    RasterContext const* context,
+    Triangle const* t,
+    int32_t tileX,
+    int32_t tileY
+  )
+{
+  Visuals_Software_PipelineState const* pipelineState = context->drawCall->pipelineState;
+  int32_t x0 = max32(t->xmin, tileX), x1 = min32(t->xmax, tileX + Visuals_Software_TileSize);
+  int32_t y0 = max32(t->ymin, tileY), y1 = min32(t->ymax, tileY + Visuals_Software_TileSize);
+  if (x0 >= x1 || y0 >= y1) {
+    return;
+  }
+  // The quads of four pixels are aligned to multiples of four.
+  // As the tile size is a multiple of four, a quad never straddles two tiles.
+  int32_t startX = x0 & ~3;
+  // The edges which cross the rectangle.
+  int32_t numberOfEdges = 0;
+  int32_t rowEdges[3], stepX[3], stepY[3];
+  for (size_t i = 0; i < 3; ++i) {
+    int64_t ax0 = (int64_t)t->a[i] * (x0 * SubPixelScale + SubPixelScale / 2);
+    int64_t ax1 = (int64_t)t->a[i] * ((x1 - 1) * SubPixelScale + SubPixelScale / 2);
+    int64_t by0 = (int64_t)t->b[i] * (y0 * SubPixelScale + SubPixelScale / 2) + t->c[i];
+    int64_t by1 = (int64_t)t->b[i] * ((y1 - 1) * SubPixelScale + SubPixelScale / 2) + t->c[i];
+    int64_t e00 = ax0 + by0, e10 = ax1 + by0, e01 = ax0 + by1, e11 = ax1 + by1;
+    if (e00 <= 0 && e10 <= 0 && e01 <= 0 && e11 <= 0) {
+      // The rectangle is outside of the edge.
+      return;
+    }
+    if (e00 > 0 && e10 > 0 && e01 > 0 && e11 > 0) {
+      // The rectangle is inside of the edge.
+      continue;
+    }
+    // The values of the edge function within the rectangle are bounded by the guard band and the tile size and fit into 32 bits.
+    rowEdges[numberOfEdges] = (int32_t)((int64_t)t->a[i] * (startX * SubPixelScale + SubPixelScale / 2) + by0);
+    stepX[numberOfEdges] = t->a[i] * SubPixelScale;
+    stepY[numberOfEdges] = t->b[i] * SubPixelScale;
+    numberOfEdges++;
+  }
+  Visuals_Software_Vertex const* v0 = getVertex(context->drawCall, t->indices[0]);
+  Visuals_Software_Vertex const* v1 = getVertex(context->drawCall, t->indices[1]);
+  Visuals_Software_Vertex const* v2 = getVertex(context->drawCall, t->indices[2]);
+  float d1[Visuals_Software_MaximalNumberOfVaryings], d2[Visuals_Software_MaximalNumberOfVaryings];
+  float varyings[Visuals_Software_MaximalNumberOfVaryings];
+  for (uint32_t i = 0; i < t->numberOfInterpolatedVaryings; ++i) {
+    d1[i] = v1->varyings[i] - v0->varyings[i];
+    d2[i] = v2->varyings[i] - v0->varyings[i];
+  }
+  for (size_t i = t->numberOfInterpolatedVaryings; i < context->drawCall->numberOfVaryings; ++i) {
+    varyings[i] = v0->varyings[i];
+  }
+  bool depthTest = pipelineState->depthTest;
+  Visuals_DepthFunction depthFunction = pipelineState->depthFunction;
+  int32_t width = context->target->width;
+  float rowZ = t->z0 + t->dzdx * ((float)startX + 0.5f - t->x0) + t->dzdy * ((float)y0 + 0.5f - t->y0);
+#if Visuals_Software_Rasterizer_WithSse2
+  __m128i const zero = _mm_setzero_si128();
+  __m128i const lanes = _mm_setr_epi32(0, 1, 2, 3);
+  __m128i const minimumX = _mm_set1_epi32(x0 - 1), maximumX = _mm_set1_epi32(x1);
+  __m128i edgeLanes[3];
+  for (int32_t i = 0; i < numberOfEdges; ++i) {
+    edgeLanes[i] = _mm_setr_epi32(0, stepX[i], stepX[i] * 2, stepX[i] * 3);
+  }
+  __m128 const zLanes = _mm_setr_ps(0.f, t->dzdx, t->dzdx * 2.f, t->dzdx * 3.f);
+  __m128 const zeroDepth = _mm_setzero_ps(), oneDepth = _mm_set1_ps(1.f);
+#endif
+  for (int32_t y = y0; y < y1; ++y) {
+    float* depthRow = context->target->depths + (size_t)y * (size_t)width;
+    int32_t e[3] = { 0, 0, 0 };
+    for (int32_t i = 0; i < numberOfEdges; ++i) {
+      e[i] = rowEdges[i];
+    }
+    float z = rowZ;
+    float dy = (float)y + 0.5f - t->y0;
+    for (int32_t x = startX; x < x1; x += 4) {
+      // Determine the coverage of the quad and test the depth of the covered pixels.
+      // The depth values of pixels beyond the width of the frame buffer belong to the next row and are not loaded.
+      bool full = x + 4 <= width;
+      int mask;
+    #if Visuals_Software_Rasterizer_WithSse2
+      __m128i px = _mm_add_epi32(_mm_set1_epi32(x), lanes);
+      __m128i covered = _mm_and_si128(_mm_cmpgt_epi32(px, minimumX), _mm_cmplt_epi32(px, maximumX));
+      for (int32_t i = 0; i < numberOfEdges; ++i) {
+        covered = _mm_and_si128(covered, _mm_cmpgt_epi32(_mm_add_epi32(_mm_set1_epi32(e[i]), edgeLanes[i]), zero));
+      }
+      mask = _mm_movemask_ps(_mm_castsi128_ps(covered));
+      __m128 pz = _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_set1_ps(z), zLanes), zeroDepth), oneDepth);
+      if (mask && depthTest && full) {
+        __m128 d = _mm_loadu_ps(depthRow + x);
+        __m128 passed;
+        switch (depthFunction) {
+          case Visuals_DepthFunction_LessThan: passed = _mm_cmplt_ps(pz, d); break;
+          case Visuals_DepthFunction_LessThanOrEqualTo: passed = _mm_cmple_ps(pz, d); break;
+          case Visuals_DepthFunction_EqualTo: passed = _mm_cmpeq_ps(pz, d); break;
+          case Visuals_DepthFunction_GreaterThan: passed = _mm_cmpgt_ps(pz, d); break;
+          case Visuals_DepthFunction_GreaterThanOrEqualTo: passed = _mm_cmpge_ps(pz, d); break;
+          case Visuals_DepthFunction_NotEqualTo: passed = _mm_cmpneq_ps(pz, d); break;
+          case Visuals_DepthFunction_Always: passed = _mm_castsi128_ps(_mm_set1_epi32(-1)); break;
+          case Visuals_DepthFunction_Never:
+          default: passed = _mm_setzero_ps(); break;
+        };
+        mask &= _mm_movemask_ps(passed);
+        if (0xf == mask) {
+          _mm_storeu_ps(depthRow + x, pz);
+        } else if (mask) {
+          float temporary[4];
+          _mm_storeu_ps(temporary, pz);
+          for (int32_t j = 0; j < 4; ++j) {
+            if (mask & (1 << j)) {
+              depthRow[x + j] = temporary[j];
+            }
+          }
+        }
+      } else if (mask && depthTest) {
+        float temporary[4];
+        _mm_storeu_ps(temporary, pz);
+        for (int32_t j = 0; j < 4; ++j) {
+          if (mask & (1 << j)) {
+            if (testDepth(depthFunction, temporary[j], depthRow[x + j])) {
+              depthRow[x + j] = temporary[j];
+            } else {
+              mask &= ~(1 << j);
+            }
+          }
+        }
+      }
+    #else
+      (void)full;
+      mask = 0;
+      for (int32_t j = 0; j < 4; ++j) {
+        int32_t px = x + j;
+        if (px < x0 || px >= x1) {
+          continue;
+        }
+        bool covered = true;
+        for (int32_t i = 0; i < numberOfEdges; ++i) {
+          covered = covered && e[i] + stepX[i] * j > 0;
+        }
+        if (covered) {
+          mask |= 1 << j;
+        }
+      }
+      if (mask && depthTest) {
+        for (int32_t j = 0; j < 4; ++j) {
+          if (mask & (1 << j)) {
+            float pz = clamp01(z + t->dzdx * (float)j);
+            if (testDepth(depthFunction, pz, depthRow[x + j])) {
+              depthRow[x + j] = pz;
+            } else {
+              mask &= ~(1 << j);
+            }
+          }
+        }
+      }
+    #endif
+      if (mask) {
+        // Compute the perspective-correct barycentric coordinates of the quad.
+        float b1[4], b2[4];
+      #if Visuals_Software_Rasterizer_WithSse2
+        __m128 dx = _mm_add_ps(_mm_set1_ps((float)x + 0.5f - t->x0), _mm_setr_ps(0.f, 1.f, 2.f, 3.f));
+        __m128 l1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t->l1dx), dx), _mm_set1_ps(t->l1dy * dy));
+        __m128 l2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t->l2dx), dx), _mm_set1_ps(t->l2dy * dy));
+        __m128 p1 = _mm_mul_ps(l1, _mm_set1_ps(t->w[1])), p2 = _mm_mul_ps(l2, _mm_set1_ps(t->w[2]));
+        __m128 p0 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.f), l1), l2), _mm_set1_ps(t->w[0]));
+        __m128 w = _mm_div_ps(_mm_set1_ps(1.f), _mm_add_ps(_mm_add_ps(p0, p1), p2));
+        _mm_storeu_ps(b1, _mm_mul_ps(p1, w));
+        _mm_storeu_ps(b2, _mm_mul_ps(p2, w));
+      #else
+        for (int32_t j = 0; j < 4; ++j) {
+          float dx = (float)(x + j) + 0.5f - t->x0;
+          float l1 = t->l1dx * dx + t->l1dy * dy, l2 = t->l2dx * dx + t->l2dy * dy;
+          float p1 = l1 * t->w[1], p2 = l2 * t->w[2];
+          float w = 1.f / (t->w[0] * (1.f - l1 - l2) + p1 + p2);
+          b1[j] = p1 * w;
+          b2[j] = p2 * w;
+        }
+      #endif
+        uint8_t* colorRow = context->target->colors + (size_t)y * (size_t)width * 4;
+        for (int32_t j = 0; j < 4; ++j) {
+          if (mask & (1 << j)) {
+            shadeFragment(context, t, v0, d1, d2, varyings, b1[j], b2[j], colorRow + (size_t)(x + j) * 4);
+          }
+        }
+      }
+      for (int32_t i = 0; i < numberOfEdges; ++i) {
+        e[i] += stepX[i] * 4;
+      }
+      z += t->dzdx * 4.f;
+    }
+    for (int32_t i = 0; i < numberOfEdges; ++i) {
+      rowEdges[i] += stepY[i];
+    }
+    rowZ += t->dzdy;
+  }
+}
+
+static void
+rasterizeTile
+  (
+    void* context,
+    size_t index
+  )
+{
+  RasterContext const* c = (RasterContext const*)context;
+  uint32_t begin = index > 0 ? c->binEnds[index - 1] : 0;
+  uint32_t end = c->binEnds[index];
+  int32_t tileX = (int32_t)(index % c->numberOfTilesX) * Visuals_Software_TileSize;
+  int32_t tileY = (int32_t)(index / c->numberOfTilesX) * Visuals_Software_TileSize;
+  for (uint32_t i = begin; i < end; ++i) {
+    rasterizeTriangle(c, &c->triangles[c->bins[i]], tileX, tileY);
+  }
+}
+
+void
+Visuals_Software_Rasterizer_draw
+  (
+    Shizu_State2* state,
+    Visuals_Software_FrameBuffer* target,
+    Visuals_Software_DrawCall const* drawCall
+  )
+{
+  Visuals_Software_PipelineState const* pipelineState = drawCall->pipelineState;
+  Shizu_Integer32 const* viewport = pipelineState->viewport;
+  if (drawCall->numberOfVaryings > Visuals_Software_MaximalNumberOfVaryings || drawCall->numberOfVertices > UINT32_MAX) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  Setup setup;
+  if (!target->colors || !drawCall->numberOfTriangles || viewport[2] <= 0 || viewport[3] <= 0 || !getScissorRectangle(target, viewport, setup.rectangle)) {
+    return;
+  }
+  if (Visuals_CullMode_FrontAndBack == pipelineState->cullMode) {
+    return;
+  }
+  setup.drawCall = drawCall;
+  setup.guardBand[0] = 1.f + 2.f * (float)GuardBand / (float)viewport[2];
+  setup.guardBand[1] = 1.f + 2.f * (float)GuardBand / (float)viewport[3];
+  setup.numberOfTriangles = 0;
+  setup.numberOfVertices = 0;
+  // Clip and setup the triangles.
+  for (size_t i = 0; i < drawCall->numberOfTriangles; ++i) {
+    uint32_t const* indices = drawCall->indices + i * 3;
+    if (indices[0] >= drawCall->numberOfVertices || indices[1] >= drawCall->numberOfVertices || indices[2] >= drawCall->numberOfVertices) {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+      Shizu_State2_jump(state);
+    }
+    uint32_t outCodes[3];
+    for (size_t j = 0; j < 3; ++j) {
+      outCodes[j] = getOutCode(drawCall->vertices[indices[j]].position, setup.guardBand);
+    }
+    if (outCodes[0] & outCodes[1] & outCodes[2]) {
+      // All vertices are outside of the same plane.
+      continue;
+    }
+    uint32_t outCode = outCodes[0] | outCodes[1] | outCodes[2];
+    if (outCode) {
+      clipTriangle(state, &setup, indices, outCode);
+    } else {
+      setupTriangle(state, &setup, indices);
+    }
+  }
+  if (!setup.numberOfTriangles) {
+    return;
+  }
+  if (setup.numberOfTriangles > UINT32_MAX) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  // Bin the triangles into the tiles.
+  // The bins are filled in reverse order of the triangles such that each bin is in the order of the draw call.
+  size_t numberOfTilesX = ((size_t)target->width + Visuals_Software_TileSize - 1) / Visuals_Software_TileSize;
+  size_t numberOfTilesY = ((size_t)target->height + Visuals_Software_TileSize - 1) / Visuals_Software_TileSize;
+  size_t numberOfTiles = numberOfTilesX * numberOfTilesY;
+  reserve(state, (void**)&g_scratch.binEnds, &g_scratch.binEndCapacity, numberOfTiles, sizeof(uint32_t));
+  memset(g_scratch.binEnds, 0, numberOfTiles * sizeof(uint32_t));
+  size_t numberOfBinnedTriangles = 0;
+  for (size_t i = 0; i < setup.numberOfTriangles; ++i) {
+    Triangle const* t = &g_scratch.triangles[i];
+    for (int32_t ty = t->ymin / Visuals_Software_TileSize; ty <= (t->ymax - 1) / Visuals_Software_TileSize; ++ty) {
+      for (int32_t tx = t->xmin / Visuals_Software_TileSize; tx <= (t->xmax - 1) / Visuals_Software_TileSize; ++tx) {
+        g_scratch.binEnds[(size_t)ty * numberOfTilesX + (size_t)tx]++;
+        numberOfBinnedTriangles++;
+      }
+    }
+  }
+  if (numberOfBinnedTriangles > UINT32_MAX) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  for (size_t i = 1; i < numberOfTiles; ++i) {
+    g_scratch.binEnds[i] += g_scratch.binEnds[i - 1];
+  }
+  reserve(state, (void**)&g_scratch.bins, &g_scratch.binCapacity, numberOfBinnedTriangles, sizeof(uint32_t));
+  for (size_t i = setup.numberOfTriangles; i > 0; --i) {
+    Triangle const* t = &g_scratch.triangles[i - 1];
+    for (int32_t ty = t->ymin / Visuals_Software_TileSize; ty <= (t->ymax - 1) / Visuals_Software_TileSize; ++ty) {
+      for (int32_t tx = t->xmin / Visuals_Software_TileSize; tx <= (t->xmax - 1) / Visuals_Software_TileSize; ++tx) {
+        g_scratch.bins[--g_scratch.binEnds[(size_t)ty * numberOfTilesX + (size_t)tx]] = (uint32_t)(i - 1);
+      }
+    }
+  }
+  // binEnds now holds the beginnings of the bins. Shift them to obtain the ends.
+  for (size_t i = 0; i + 1 < numberOfTiles; ++i) {
+    g_scratch.binEnds[i] = g_scratch.binEnds[i + 1];
+  }
+  g_scratch.binEnds[numberOfTiles - 1] = (uint32_t)numberOfBinnedTriangles;
+  // Rasterize the tiles.
+  RasterContext context;
+  context.target = target;
+  context.drawCall = drawCall;
+  context.triangles = g_scratch.triangles;
+  context.binEnds = g_scratch.binEnds;
+  context.bins = g_scratch.bins;
+  context.numberOfTilesX = numberOfTilesX;
+  Visuals_Parallel_runDynamic(&rasterizeTile, &context, numberOfTiles);
+}
+
+void
+Visuals_Software_Rasterizer_releaseScratch
+  (
+    Shizu_State2* state
+  )
+{
+  if (g_scratch.bins) {
+    free(g_scratch.bins);
+    g_scratch.bins = NULL;
+    g_scratch.binCapacity = 0;
+  }
+  if (g_scratch.binEnds) {
+    free(g_scratch.binEnds);
+    g_scratch.binEnds = NULL;
+    g_scratch.binEndCapacity = 0;
+  }
+  if (g_scratch.vertices) {
+    free(g_scratch.vertices);
+    g_scratch.vertices = NULL;
+    g_scratch.vertexCapacity = 0;
+  }
+  if (g_scratch.triangles) {
+    free(g_scratch.triangles);
+    g_scratch.triangles = NULL;
+    g_scratch.triangleCapacity = 0;
+  }
+}
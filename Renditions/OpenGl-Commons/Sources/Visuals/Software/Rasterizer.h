@@ -0,0 +1,187 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(VISUALS_SOFTWARE_RASTERIZER_H_INCLUDED)
+#define VISUALS_SOFTWARE_RASTERIZER_H_INCLUDED
+
+#include "Visuals/Context.h"
+
+/// @brief The width and the height, in pixels, of a tile.
+/// The frame buffer is split into tiles, the triangles are binned into the tiles they overlap,
+/// and the tiles are rasterized in parallel.
+#define Visuals_Software_TileSize (64)
+
+/// @brief The maximal number of varyings of a vertex.
+#define Visuals_Software_MaximalNumberOfVaryings (32)
+
+/// @brief The maximal width and the maximal height, in pixels, of a frame buffer.
+#define Visuals_Software_MaximalFrameBufferSize (8192)
+
+/// @brief A frame buffer of the software renderer.
+/// @details
+/// The color buffer consists of RGBA8 pixels, the depth buffer consists of float depth values in [0,1].
+/// The rows are stored from bottom to top like the rows of an OpenGL frame buffer.
+/// Both buffers are padded by a few pixels such that four consecutive pixels can always be loaded.
+typedef struct Visuals_Software_FrameBuffer {
+  /// @brief The width, in pixels.
+  Shizu_Integer32 width;
+  /// @brief The height, in pixels.
+  Shizu_Integer32 height;
+  /// @brief A pointer to the color buffer or the null pointer if the width or the height is zero.
+  uint8_t* colors;
+  /// @brief A pointer to the depth buffer or the null pointer if the width or the height is zero.
+  float* depths;
+} Visuals_Software_FrameBuffer;
+
+/// @brief Initialize a frame buffer with a width and a height of zero.
+void
+Visuals_Software_FrameBuffer_initialize
+  (
+    Visuals_Software_FrameBuffer* self
+  );
+
+/// @brief Uninitialize a frame buffer.
+void
+Visuals_Software_FrameBuffer_uninitialize
+  (
+    Visuals_Software_FrameBuffer* self
+  );
+
+/// @brief Resize a frame buffer.
+/// @param width, height The width and the height. Must be within [0, Visuals_Software_MaximalFrameBufferSize].
+/// @remarks The contents of the frame buffer are undefined after a resize which changed the size.
+/// @error Shizu_Status_ArgumentOutOfRange @a width or @a height is out of range.
+/// @error Shizu_Status_AllocationFailed an allocation failed. The frame buffer is not modified.
+void
+Visuals_Software_FrameBuffer_resize
+  (
+    Shizu_State2* state,
+    Visuals_Software_FrameBuffer* self,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  );
+
+/// @brief The fixed function state of a draw call.
+typedef struct Visuals_Software_PipelineState {
+  Visuals_CullMode cullMode;
+  /// @brief If the depth test is enabled. If disabled, the depth buffer is neither tested nor written.
+  bool depthTest;
+  Visuals_DepthFunction depthFunction;
+  /// @brief If blending is enabled.
+  bool blend;
+  Visuals_BlendFactor sourceFactor;
+  Visuals_BlendFactor targetFactor;
+  /// @brief The viewport x, y, width, and height in pixels.
+  /// The viewport is also the scissor rectangle.
+  Shizu_Integer32 viewport[4];
+} Visuals_Software_PipelineState;
+
+/// @brief A vertex after the vertex stage.
+typedef struct Visuals_Software_Vertex {
+  /// @brief The position in clip space.
+  float position[4];
+  /// @brief The varyings.
+  float varyings[Visuals_Software_MaximalNumberOfVaryings];
+} Visuals_Software_Vertex;
+
+/// @brief The type of a fragment stage.
+/// @param uniforms The uniforms of the draw call.
+/// @param varyings The perspective-correct interpolated varyings of the fragment.
+/// @param color A pointer to an array of four floats receiving the RGBA color of the fragment.
+/// @remarks A fragment stage is invoked concurrently for different tiles and must not jump.
+typedef void (Visuals_Software_FragmentStage)(void const* uniforms, float const* varyings, float* color);
+
+/// @brief A draw call.
+typedef struct Visuals_Software_DrawCall {
+  Visuals_Software_PipelineState const* pipelineState;
+  Visuals_Software_FragmentStage* fragmentStage;
+  void const* uniforms;
+  /// @brief The number of varyings of the vertices. At most Visuals_Software_MaximalNumberOfVaryings.
+  size_t numberOfVaryings;
+  /// @brief A pointer to an array of @a numberOfVertices vertices.
+  Visuals_Software_Vertex const* vertices;
+  size_t numberOfVertices;
+  /// @brief A pointer to an array of 3 * @a numberOfTriangles indices into @a vertices.
+  /// Each three indices form a triangle.
+  uint32_t const* indices;
+  size_t numberOfTriangles;
+} Visuals_Software_DrawCall;
+
+/// @brief Clear the viewport of a frame buffer.
+/// @param viewport The viewport x, y, width, and height in pixels.
+/// @param colorBuffer, color If the color buffer is cleared and the RGBA color it is cleared to.
+/// @param depthBuffer, depth If the depth buffer is cleared and the depth value it is cleared to.
+void
+Visuals_Software_Rasterizer_clear
+  (
+    Shizu_State2* state,
+    Visuals_Software_FrameBuffer* target,
+    Shizu_Integer32 const* viewport,
+    bool colorBuffer,
+    float const* color,
+    bool depthBuffer,
+    float depth
+  );
+
+/// @brief Copy the colors of a rectangle of a frame buffer to the viewport of another frame buffer.
+/// The colors are scaled to the size of the viewport.
+/// @param viewport The viewport x, y, width, and height in pixels.
+/// @param source The frame buffer to copy from. Must not be @a target.
+/// @param sourceRectangle The rectangle x, y, width, and height in pixels. Must be within @a source and not empty.
+/// @param filter The filter.
+/// The sharpen filter samples bilinearly and adds the difference between a sample and its four neighbours,
+/// limited to the range of the neighbours.
+void
+Visuals_Software_Rasterizer_blit
+  (
+    Shizu_State2* state,
+    Visuals_Software_FrameBuffer* target,
+    Shizu_Integer32 const* viewport,
+    Visuals_Software_FrameBuffer const* source,
+    Shizu_Integer32 const* sourceRectangle,
+    Visuals_BlitFilter filter
+  );
+
+/// @brief Rasterize the triangles of a draw call into a frame buffer.
+/// @details
+/// The triangles are clipped against the near plane, the far plane, and a guard band,
+/// culled, and binned into tiles of Visuals_Software_TileSize x Visuals_Software_TileSize pixels.
+/// The tiles are rasterized in parallel by Visuals_Parallel_runDynamic.
+/// Within a tile, the triangles are rasterized in the order of the draw call.
+/// Coverage is determined by integer edge functions with 4 bits of sub-pixel precision and the top-left rule,
+/// four pixels at a time.
+/// @error Shizu_Status_AllocationFailed an allocation failed.
+void
+Visuals_Software_Rasterizer_draw
+  (
+    Shizu_State2* state,
+    Visuals_Software_FrameBuffer* target,
+    Visuals_Software_DrawCall const* drawCall
+  );
+
+/// @brief Release the scratch memory of the rasterizer.
+void
+Visuals_Software_Rasterizer_releaseScratch
+  (
+    Shizu_State2* state
+  );
+
+#endif // VISUALS_SOFTWARE_RASTERIZER_H_INCLUDED
@@ -0,0 +1,211 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Visuals/Software/RenderBuffer.h"
+
+static void
+Visuals_Software_RenderBuffer_dispatchInitialize
+  (
+    Shizu_State2* state,
+    Visuals_Software_RenderBuffer_Dispatch* self
+  );
+
+static void
+Visuals_Software_RenderBuffer_finalize
+  (
+    Shizu_State2* state,
+    Visuals_Software_RenderBuffer* self
+  );
+
+static void
+Visuals_Software_RenderBuffer_materializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_RenderBuffer* self
+  );
+
+static void
+Visuals_Software_RenderBuffer_unmaterializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_RenderBuffer* self
+  );
+
+static void
+Visuals_Software_RenderBuffer_resizeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_RenderBuffer* self,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  );
+
+static void
+Visuals_Software_RenderBuffer_requestReadbackImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_RenderBuffer* self,
+    Visuals_ReadbackTicket* ticket
+  );
+
+static void
+Visuals_Software_RenderBuffer_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  );
+
+static Shizu_ObjectTypeDescriptor const Visuals_Software_RenderBuffer_Type = {
+  .postCreateType = NULL,
+  .preDestroyType = NULL,
+  .visitType = NULL,
+  .size = sizeof(Visuals_Software_RenderBuffer),
+  .construct = &Visuals_Software_RenderBuffer_constructImpl,
+  .finalize = (Shizu_OnFinalizeCallback*)&Visuals_Software_RenderBuffer_finalize,
+  .visit = NULL,
+  .dispatchSize = sizeof(Visuals_Software_RenderBuffer_Dispatch),
+  .dispatchInitialize = (Shizu_OnDispatchInitializeCallback*)&Visuals_Software_RenderBuffer_dispatchInitialize,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Zeitgeist.Visuals.Software.RenderBuffer", Visuals_Software_RenderBuffer, Visuals_RenderBuffer);
+
+static void
+Visuals_Software_RenderBuffer_dispatchInitialize
+  (
+    Shizu_State2* state,
+    Visuals_Software_RenderBuffer_Dispatch* self
+  )
+{
+  ((Visuals_Object_Dispatch*)self)->materialize = (void(*)(Shizu_State2*,Visuals_Object*)) & Visuals_Software_RenderBuffer_materializeImpl;
+  ((Visuals_Object_Dispatch*)self)->unmaterialize = (void(*)(Shizu_State2*,Visuals_Object*)) & Visuals_Software_RenderBuffer_unmaterializeImpl;
+  ((Visuals_RenderBuffer_Dispatch*)self)->resize = (void(*)(Shizu_State2*,Visuals_RenderBuffer*,Shizu_Integer32,Shizu_Integer32)) & Visuals_Software_RenderBuffer_resizeImpl;
+  ((Visuals_RenderBuffer_Dispatch*)self)->requestReadback = (void(*)(Shizu_State2*,Visuals_RenderBuffer*,Visuals_ReadbackTicket*)) & Visuals_Software_RenderBuffer_requestReadbackImpl;
+}
+
+static void
+Visuals_Software_RenderBuffer_finalize
+  (
+    Shizu_State2* state,
+    Visuals_Software_RenderBuffer* self
+  )
+{
+  Visuals_Software_FrameBuffer_uninitialize(&self->frameBuffer);
+}
+
+static void
+Visuals_Software_RenderBuffer_materializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_RenderBuffer* self
+  )
+{
+  if (self->frameBuffer.width != self->width || self->frameBuffer.height != self->height) {
+    Visuals_Software_FrameBuffer_resize(state, &self->frameBuffer, self->width, self->height);
+  }
+}
+
+static void
+Visuals_Software_RenderBuffer_unmaterializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_RenderBuffer* self
+  )
+{
+  Visuals_Software_FrameBuffer_uninitialize(&self->frameBuffer);
+  Visuals_Software_FrameBuffer_initialize(&self->frameBuffer);
+}
+
+static void
+Visuals_Software_RenderBuffer_resizeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_RenderBuffer* self,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  )
+{
+  if (self->width != width || self->height != height) {
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)self);
+    self->width = width;
+    self->height = height;
+    Visuals_Object_materialize(state, (Visuals_Object*)self);
+  }
+}
+
+// The pixels are in memory when the request is made.
+// Hence the ticket is fulfilled before this function returns.
+static void
+Visuals_Software_RenderBuffer_requestReadbackImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_RenderBuffer* self,
+    Visuals_ReadbackTicket* ticket
+  )
+{
+  if (!self->frameBuffer.colors) {
+    Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+    Shizu_State2_jump(state);
+  }
+  Visuals_ReadbackTicket_begin(state, ticket, self->frameBuffer.width, self->frameBuffer.height);
+  Visuals_ReadbackTicket_fulfill(state, ticket, self->frameBuffer.colors);
+}
+
+static void
+Visuals_Software_RenderBuffer_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{
+  if (1 != numberOfArgumentValues) {
+    Shizu_State2_setStatus(state, Shizu_Status_NumberOfArgumentsInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Type* TYPE = Visuals_Software_RenderBuffer_getType(state);
+  Visuals_Software_RenderBuffer* SELF = (Visuals_Software_RenderBuffer*)Shizu_Value_getObject(&argumentValues[0]);
+  {
+    Shizu_Type* PARENTTYPE = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), TYPE);
+    Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value argumentValues[] = { Shizu_Value_InitializerObject(SELF) };
+    Shizu_Type_getObjectTypeDescriptor(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), PARENTTYPE)->construct(state, &returnValue, 1, &argumentValues[0]);
+  }
+  SELF->width = 640;
+  SELF->height = 480;
+  Visuals_Software_FrameBuffer_initialize(&SELF->frameBuffer);
+  ((Shizu_Object*)SELF)->type = TYPE;
+}
+
+Visuals_Software_RenderBuffer*
+Visuals_Software_RenderBuffer_create
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+  Shizu_Value argumentValues[] = { Shizu_Value_InitializerType(Visuals_Software_RenderBuffer_getType(state)) };
+  Shizu_Operations_create(state, &returnValue, 1, &argumentValues[0]);
+  return (Visuals_Software_RenderBuffer*)Shizu_Value_getObject(&returnValue);
+}
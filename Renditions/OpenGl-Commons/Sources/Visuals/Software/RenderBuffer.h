@@ -0,0 +1,59 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(VISUALS_SOFTWARE_RENDERBUFFER_H_INCLUDED)
+#define VISUALS_SOFTWARE_RENDERBUFFER_H_INCLUDED
+
+#include "Visuals/RenderBuffer.h"
+#include "Visuals/Software/Rasterizer.h"
+
+/// @brief
+/// The implementation of Visuals.RenderBuffer for the software renderer.
+/// @details
+/// The color buffer and the depth buffer are allocated when the render buffer is materialized.
+/// The type is
+/// @code
+/// class Visuals.Software.RenderBuffer
+/// @endcode
+/// Its constructor is
+/// @code
+/// Visuals.Software.RenderBuffer.construct()
+/// @endcode
+Shizu_declareObjectType(Visuals_Software_RenderBuffer);
+
+struct Visuals_Software_RenderBuffer_Dispatch {
+  Visuals_RenderBuffer_Dispatch _parent;
+};
+
+struct Visuals_Software_RenderBuffer {
+  Visuals_RenderBuffer _parent;
+  Shizu_Integer32 width;
+  Shizu_Integer32 height;
+  Visuals_Software_FrameBuffer frameBuffer;
+};
+
+Visuals_Software_RenderBuffer*
+Visuals_Software_RenderBuffer_create
+  (
+    Shizu_State2* state
+  );
+
+#endif // VISUALS_SOFTWARE_RENDERBUFFER_H_INCLUDED
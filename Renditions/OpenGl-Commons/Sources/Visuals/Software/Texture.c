@@ -0,0 +1,275 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Visuals/Software/Texture.h"
+
+// malloc, free
+#include <malloc.h>
+// floorf
+#include <math.h>
+
+static void
+Visuals_Software_Texture_finalize
+  (
+    Shizu_State2* state,
+    Visuals_Software_Texture* self
+  );
+
+static void
+Visuals_Software_Texture_materializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Texture* self
+  );
+
+static void
+Visuals_Software_Texture_unmaterializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Texture* self
+  );
+
+static void
+Visuals_Software_Texture_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Texture* self,
+    Visuals_PixelFormat pixelFormat,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    Shizu_ByteArray* pixels
+  );
+
+static void
+Visuals_Software_Texture_setSubDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Texture* self,
+    Shizu_Integer32 x,
+    Shizu_Integer32 y,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    Shizu_ByteArray* pixels
+  );
+
+static void
+Visuals_Software_Texture_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_Software_Texture_Dispatch* self
+  );
+
+static void
+Visuals_Software_Texture_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  );
+
+static Shizu_ObjectTypeDescriptor const Visuals_Software_Texture_Type = {
+  .postCreateType = NULL,
+  .preDestroyType = NULL,
+  .visitType = NULL,
+  .size = sizeof(Visuals_Software_Texture),
+  .construct = &Visuals_Software_Texture_constructImpl,
+  .finalize = (Shizu_OnFinalizeCallback*)&Visuals_Software_Texture_finalize,
+  .visit = NULL,
+  .dispatchSize = sizeof(Visuals_Software_Texture_Dispatch),
+  .dispatchInitialize = (Shizu_OnDispatchInitializeCallback*) & Visuals_Software_Texture_dispatchInitialize,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Zeitgeist.Visuals.Software.Texture", Visuals_Software_Texture, Visuals_Texture);
+
+static void
+Visuals_Software_Texture_finalize
+  (
+    Shizu_State2* state,
+    Visuals_Software_Texture* self
+  )
+{
+  if (self->pixels) {
+    free(self->pixels);
+    self->pixels = NULL;
+  }
+}
+
+static void
+Visuals_Software_Texture_materializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Texture* self
+  )
+{/*Intentionally empty.*/}
+
+static void
+Visuals_Software_Texture_unmaterializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Texture* self
+  )
+{/*Intentionally empty.*/}
+
+static void
+Visuals_Software_Texture_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Texture* self,
+    Visuals_PixelFormat pixelFormat,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    Shizu_ByteArray* pixels
+  )
+{
+  Shizu_Type* parentType = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), ((Shizu_Object*)self)->type);
+  Visuals_Texture_Dispatch* parentDispatch = (Visuals_Texture_Dispatch*)Shizu_Types_getDispatch(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), parentType);
+  parentDispatch->setData(state, (Visuals_Texture*)self, pixelFormat, width, height, pixels);
+
+  size_t numberOfBytes = (size_t)width * (size_t)height * 4;
+  uint8_t* newPixels = malloc(numberOfBytes > 0 ? numberOfBytes : 1);
+  if (!newPixels) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    size_t sourceStride = (size_t)width * (size_t)Visuals_PixelFormat_getBytesPerPixel(state, pixelFormat);
+    Visuals_PixelFormat_convert(state, Visuals_PixelFormat_RGBA_U8, newPixels, (size_t)width * 4,
+                                pixelFormat, Shizu_ByteArray_getRawBytes(state, pixels), sourceStride, width, height);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    free(newPixels);
+    Shizu_State2_jump(state);
+  }
+  if (self->pixels) {
+    free(self->pixels);
+  }
+  self->pixels = newPixels;
+}
+
+static void
+Visuals_Software_Texture_setSubDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_Texture* self,
+    Shizu_Integer32 x,
+    Shizu_Integer32 y,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    Shizu_ByteArray* pixels
+  )
+{
+  Shizu_Type* parentType = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), ((Shizu_Object*)self)->type);
+  Visuals_Texture_Dispatch* parentDispatch = (Visuals_Texture_Dispatch*)Shizu_Types_getDispatch(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), parentType);
+  parentDispatch->setSubData(state, (Visuals_Texture*)self, x, y, width, height, pixels);
+
+  Visuals_Texture* texture = (Visuals_Texture*)self;
+  if (!self->pixels) {
+    return;
+  }
+  size_t sourceStride = (size_t)width * (size_t)Visuals_PixelFormat_getBytesPerPixel(state, texture->pixelFormat);
+  uint8_t* target = self->pixels + ((size_t)y * (size_t)texture->width + (size_t)x) * 4;
+  Visuals_PixelFormat_convert(state, Visuals_PixelFormat_RGBA_U8, target, (size_t)texture->width * 4,
+                              texture->pixelFormat, Shizu_ByteArray_getRawBytes(state, pixels), sourceStride, width, height);
+}
+
+static void
+Visuals_Software_Texture_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_Software_Texture_Dispatch* self
+  )
+{
+  ((Visuals_Object_Dispatch*)self)->materialize = (void(*)(Shizu_State2*, Visuals_Object*)) & Visuals_Software_Texture_materializeImpl;
+  ((Visuals_Object_Dispatch*)self)->unmaterialize = (void(*)(Shizu_State2*, Visuals_Object*)) & Visuals_Software_Texture_unmaterializeImpl;
+  ((Visuals_Texture_Dispatch*)self)->setData = (void(*)(Shizu_State2*, Visuals_Texture*, Visuals_PixelFormat, Shizu_Integer32, Shizu_Integer32, Shizu_ByteArray*)) & Visuals_Software_Texture_setDataImpl;
+  ((Visuals_Texture_Dispatch*)self)->setSubData = (void(*)(Shizu_State2*, Visuals_Texture*, Shizu_Integer32, Shizu_Integer32, Shizu_Integer32, Shizu_Integer32, Shizu_ByteArray*)) & Visuals_Software_Texture_setSubDataImpl;
+}
+
+static void
+Visuals_Software_Texture_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{
+  if (1 != numberOfArgumentValues) {
+    Shizu_State2_setStatus(state, Shizu_Status_NumberOfArgumentsInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Type* TYPE = Visuals_Software_Texture_getType(state);
+  Visuals_Software_Texture* SELF = (Visuals_Software_Texture*)Shizu_Value_getObject(&argumentValues[0]);
+  {
+    Shizu_Type* PARENTTYPE = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), TYPE);
+    Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value argumentValues[] = { Shizu_Value_InitializerObject(SELF) };
+    Shizu_Type_getObjectTypeDescriptor(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), PARENTTYPE)->construct(state, &returnValue, 1, &argumentValues[0]);
+  }
+  SELF->pixels = NULL;
+  ((Shizu_Object*)SELF)->type = TYPE;
+}
+
+Visuals_Software_Texture*
+Visuals_Software_Texture_create
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+  Shizu_Value argumentValues[] = { Shizu_Value_InitializerType(Visuals_Software_Texture_getType(state)) };
+  Shizu_Operations_create(state, &returnValue, 1, &argumentValues[0]);
+  return (Visuals_Software_Texture*)Shizu_Value_getObject(&returnValue);
+}
+
+void
+Visuals_Software_Texture_sample
+  (
+    Visuals_Software_Texture* self,
+    float u,
+    float v,
+    float* rgba
+  )
+{
+  Visuals_Texture* texture = (Visuals_Texture*)self;
+  if (!self->pixels || texture->width <= 0 || texture->height <= 0) {
+    rgba[0] = 0.f;
+    rgba[1] = 0.f;
+    rgba[2] = 0.f;
+    rgba[3] = 1.f;
+    return;
+  }
+  u -= floorf(u);
+  v -= floorf(v);
+  Shizu_Integer32 x = (Shizu_Integer32)(u * (float)texture->width);
+  Shizu_Integer32 y = (Shizu_Integer32)(v * (float)texture->height);
+  x = x < texture->width ? x : texture->width - 1;
+  y = y < texture->height ? y : texture->height - 1;
+  uint8_t const* p = self->pixels + ((size_t)y * (size_t)texture->width + (size_t)x) * 4;
+  for (size_t i = 0; i < 4; ++i) {
+    rgba[i] = (float)p[i] * (1.f / 255.f);
+  }
+}
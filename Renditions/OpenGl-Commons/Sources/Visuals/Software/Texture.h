@@ -0,0 +1,70 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(VISUALS_SOFTWARE_TEXTURE_H_INCLUDED)
+#define VISUALS_SOFTWARE_TEXTURE_H_INCLUDED
+
+#include "Visuals/Texture.h"
+
+/// @brief
+/// The implementation of Visuals.Texture for the software renderer.
+/// @details
+/// Only level 0 is kept. Its pixels are converted to Visuals_PixelFormat_RGBA_U8.
+/// The type is
+/// @code
+/// class Visuals.Software.Texture
+/// @endcode
+/// Its constructor is
+/// @code
+/// Visuals.Software.Texture.construct()
+/// @endcode
+Shizu_declareObjectType(Visuals_Software_Texture);
+
+struct Visuals_Software_Texture_Dispatch {
+  Visuals_Texture_Dispatch _parent;
+};
+
+struct Visuals_Software_Texture {
+  Visuals_Texture parent;
+  /// @brief A pointer to the width times height pixels of level 0 in the pixel format Visuals_PixelFormat_RGBA_U8 or the null pointer.
+  uint8_t* pixels;
+};
+
+Visuals_Software_Texture*
+Visuals_Software_Texture_create
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Sample level 0 of this texture by the nearest pixel.
+/// @param u, v The texture coordinates. Wrapped to [0,1).
+/// @param rgba A pointer to an array of four float values receiving the red, green, blue, and alpha components.
+/// The components are (0,0,0,1) if the texture has no pixels.
+void
+Visuals_Software_Texture_sample
+  (
+    Visuals_Software_Texture* self,
+    float u,
+    float v,
+    float* rgba
+  );
+
+#endif // VISUALS_SOFTWARE_TEXTURE_H_INCLUDED
@@ -0,0 +1,55 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(VISUALS_SOFTWARE_UNIFORMBUFFER_H_INCLUDED)
+#define VISUALS_SOFTWARE_UNIFORMBUFFER_H_INCLUDED
+
+#include "Visuals/UniformBuffer.h"
+
+/// @brief
+/// The implementation of Visuals.UniformBuffer for the software renderer.
+/// @details
+/// The uniform block data is read from the copy of the data kept by Visuals.UniformBuffer.
+/// The type is
+/// @code
+/// class Visuals.Software.UniformBuffer
+/// @endcode
+/// Its constructor is
+/// @code
+/// Visuals.Software.UniformBuffer.construct()
+/// @endcode
+Shizu_declareObjectType(Visuals_Software_UniformBuffer);
+
+struct Visuals_Software_UniformBuffer_Dispatch {
+  Visuals_UniformBuffer_Dispatch _parent;
+};
+
+struct Visuals_Software_UniformBuffer {
+  Visuals_UniformBuffer parent;
+};
+
+Visuals_Software_UniformBuffer*
+Visuals_Software_UniformBuffer_create
+  (
+    Shizu_State2* state
+  );
+
+#endif // VISUALS_SOFTWARE_UNIFORMBUFFER_H_INCLUDED
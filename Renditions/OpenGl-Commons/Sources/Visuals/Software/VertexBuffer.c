@@ -0,0 +1,394 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Visuals/Software/VertexBuffer.h"
+
+// malloc, free
+#include <malloc.h>
+// memcpy, memset
+#include <string.h>
+
+static void
+Visuals_Software_VertexBuffer_finalize
+  (
+    Shizu_State2* state,
+    Visuals_Software_VertexBuffer* self
+  );
+
+static void
+Visuals_Software_VertexBuffer_materializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_VertexBuffer* self
+  );
+
+static void
+Visuals_Software_VertexBuffer_unmaterializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_VertexBuffer* self
+  );
+
+static void
+Visuals_Software_VertexBuffer_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_VertexBuffer* self,
+    uint16_t flags,
+    void const* bytes,
+    size_t numberOfBytes
+  );
+
+static void
+Visuals_Software_VertexBuffer_adoptDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_VertexBuffer* self,
+    uint16_t flags,
+    void* bytes,
+    size_t numberOfBytes
+  );
+
+static void
+Visuals_Software_VertexBuffer_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_Software_VertexBuffer_Dispatch* self
+  );
+
+static void
+Visuals_Software_VertexBuffer_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  );
+
+static Shizu_ObjectTypeDescriptor const Visuals_Software_VertexBuffer_Type = {
+  .postCreateType = NULL,
+  .preDestroyType = NULL,
+  .visitType = NULL,
+  .size = sizeof(Visuals_Software_VertexBuffer),
+  .construct = &Visuals_Software_VertexBuffer_constructImpl,
+  .finalize = (Shizu_OnFinalizeCallback*)&Visuals_Software_VertexBuffer_finalize,
+  .visit = NULL,
+  .dispatchSize = sizeof(Visuals_Software_VertexBuffer_Dispatch),
+  .dispatchInitialize = (Shizu_OnDispatchInitializeCallback*) & Visuals_Software_VertexBuffer_dispatchInitialize,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Zeitgeist.Visuals.Software.VertexBuffer", Visuals_Software_VertexBuffer, Visuals_VertexBuffer);
+
+static void
+Visuals_Software_VertexBuffer_finalize
+  (
+    Shizu_State2* state,
+    Visuals_Software_VertexBuffer* self
+  )
+{
+  if (self->bytes) {
+    free(self->bytes);
+    self->bytes = NULL;
+  }
+}
+
+static void
+Visuals_Software_VertexBuffer_materializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_VertexBuffer* self
+  )
+{/*Intentionally empty.*/}
+
+static void
+Visuals_Software_VertexBuffer_unmaterializeImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_VertexBuffer* self
+  )
+{/*Intentionally empty.*/}
+
+// Release the copy of the vertex data (if any).
+static void
+Visuals_Software_VertexBuffer_releaseBytes
+  (
+    Visuals_Software_VertexBuffer* self
+  )
+{
+  if (self->bytes) {
+    free(self->bytes);
+    self->bytes = NULL;
+  }
+}
+
+// Replace the copy of the vertex data.
+static void
+Visuals_Software_VertexBuffer_copyBytes
+  (
+    Shizu_State2* state,
+    Visuals_Software_VertexBuffer* self,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{
+  void* newBytes = malloc(numberOfBytes > 0 ? numberOfBytes : 1);
+  if (!newBytes) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  memcpy(newBytes, bytes, numberOfBytes);
+  Visuals_Software_VertexBuffer_releaseBytes(self);
+  self->bytes = newBytes;
+}
+
+static void
+Visuals_Software_VertexBuffer_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_VertexBuffer* self,
+    uint16_t flags,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{
+  Shizu_Type* parentType = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), ((Shizu_Object*)self)->type);
+  Visuals_VertexBuffer_Dispatch* parentDispatch = (Visuals_VertexBuffer_Dispatch*)Shizu_Types_getDispatch(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), parentType);
+  parentDispatch->setData(state, (Visuals_VertexBuffer*)self, flags, bytes, numberOfBytes);
+  // Keep a copy of the vertex data if Visuals.VertexBuffer does not retain the vertex data.
+  if (((Visuals_VertexBuffer*)self)->bytes) {
+    Visuals_Software_VertexBuffer_releaseBytes(self);
+  } else {
+    Visuals_Software_VertexBuffer_copyBytes(state, self, bytes, numberOfBytes);
+  }
+}
+
+static void
+Visuals_Software_VertexBuffer_adoptDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Software_VertexBuffer* self,
+    uint16_t flags,
+    void* bytes,
+    size_t numberOfBytes
+  )
+{
+  Shizu_Type* parentType = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), ((Shizu_Object*)self)->type);
+  Visuals_VertexBuffer_Dispatch* parentDispatch = (Visuals_VertexBuffer_Dispatch*)Shizu_Types_getDispatch(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), parentType);
+  parentDispatch->adoptData(state, (Visuals_VertexBuffer*)self, flags, bytes, numberOfBytes);
+  // Keep a copy of the adopted Bytes if they are released by the retention policy.
+  Visuals_VertexBuffer* parent = (Visuals_VertexBuffer*)self;
+  if (Visuals_VertexBufferUsage_Static != parent->usage || Visuals_VertexBufferRetention_Keep != parent->retention) {
+    Visuals_Software_VertexBuffer_copyBytes(state, self, parent->bytes, numberOfBytes);
+  } else {
+    Visuals_Software_VertexBuffer_releaseBytes(self);
+  }
+  Visuals_VertexBuffer_applyRetention(state, parent);
+}
+
+static void
+Visuals_Software_VertexBuffer_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_Software_VertexBuffer_Dispatch* self
+  )
+{
+  ((Visuals_Object_Dispatch*)self)->materialize = (void(*)(Shizu_State2*,Visuals_Object*)) & Visuals_Software_VertexBuffer_materializeImpl;
+  ((Visuals_Object_Dispatch*)self)->unmaterialize = (void(*)(Shizu_State2*,Visuals_Object*)) & Visuals_Software_VertexBuffer_unmaterializeImpl;
+  ((Visuals_VertexBuffer_Dispatch*)self)->setData = (void(*)(Shizu_State2*, Visuals_VertexBuffer*, uint16_t,void const*,size_t)) & Visuals_Software_VertexBuffer_setDataImpl;
+  ((Visuals_VertexBuffer_Dispatch*)self)->adoptData = (void(*)(Shizu_State2*, Visuals_VertexBuffer*, uint16_t,void*,size_t)) & Visuals_Software_VertexBuffer_adoptDataImpl;
+}
+
+static void
+Visuals_Software_VertexBuffer_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{
+  if (1 != numberOfArgumentValues) {
+    Shizu_State2_setStatus(state, Shizu_Status_NumberOfArgumentsInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Type* TYPE = Visuals_Software_VertexBuffer_getType(state);
+  Visuals_Software_VertexBuffer* SELF = (Visuals_Software_VertexBuffer*)Shizu_Value_getObject(&argumentValues[0]);
+  {
+    Shizu_Type* PARENTTYPE = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), TYPE);
+    Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value argumentValues[] = { Shizu_Value_InitializerObject(SELF) };
+    Shizu_Type_getObjectTypeDescriptor(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), PARENTTYPE)->construct(state, &returnValue, 1, &argumentValues[0]);
+  }
+  SELF->bytes = NULL;
+  ((Shizu_Object*)SELF)->type = TYPE;
+}
+
+Visuals_Software_VertexBuffer*
+Visuals_Software_VertexBuffer_create
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+  Shizu_Value argumentValues[] = { Shizu_Value_InitializerType(Visuals_Software_VertexBuffer_getType(state)) };
+  Shizu_Operations_create(state, &returnValue, 1, &argumentValues[0]);
+  return (Visuals_Software_VertexBuffer*)Shizu_Value_getObject(&returnValue);
+}
+
+void const*
+Visuals_Software_VertexBuffer_getBytes
+  (
+    Visuals_Software_VertexBuffer* self
+  )
+{
+  Visuals_VertexBuffer* parent = (Visuals_VertexBuffer*)self;
+  if (!parent->numberOfVertices) {
+    return NULL;
+  }
+  return parent->bytes ? parent->bytes : self->bytes;
+}
+
+// Unpack a half float value (see Visuals_packHalf).
+static inline float
+unpackHalf
+  (
+    uint16_t value
+  )
+{
+  uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+  uint32_t exponent = (value >> 10) & 0x1f;
+  uint32_t mantissa = value & 0x3ff;
+  union { float f; uint32_t u; } x;
+  if (0 == exponent) {
+    // zero or subnormal
+    x.f = (float)mantissa * (1.f / 16777216.f);
+    x.u |= sign;
+  } else if (31 == exponent) {
+    // infinity or not a number
+    x.u = sign | 0x7f800000 | (mantissa << 13);
+  } else {
+    x.u = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+  }
+  return x.f;
+}
+
+// Unpack a signed normalized 10:10:10:2 value (see Visuals_packNormal).
+static inline void
+unpackNormal
+  (
+    uint32_t packed,
+    float* normal
+  )
+{
+  for (size_t i = 0; i < 3; ++i) {
+    int32_t s = (int32_t)((packed >> (10 * i)) & 0x3ff);
+    if (s & 0x200) {
+      s -= 0x400;
+    }
+    float c = (float)s / 511.f;
+    normal[i] = c < -1.f ? -1.f : c;
+  }
+}
+
+void
+Visuals_Software_VertexBuffer_getVertexAttributes
+  (
+    Visuals_Software_VertexBuffer* self,
+    size_t index,
+    Visuals_Software_VertexAttributes* attributes
+  )
+{
+  memset(attributes, 0, sizeof(Visuals_Software_VertexAttributes));
+  uint8_t const* p = (uint8_t const*)Visuals_Software_VertexBuffer_getBytes(self);
+  if (!p) {
+    return;
+  }
+  switch (((Visuals_VertexBuffer*)self)->flags) {
+    case (Visuals_VertexSemantics_PositionXyz | Visuals_VertexSyntactics_Float3): {
+      p += index * sizeof(float) * 3;
+      memcpy(attributes->position, p, sizeof(float) * 3);
+    } break;
+    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb | Visuals_VertexSyntactics_Float3_Float3_Float3): {
+      p += index * sizeof(float) * 9;
+      memcpy(attributes->position, p + sizeof(float) * 0, sizeof(float) * 3);
+      memcpy(attributes->normal, p + sizeof(float) * 3, sizeof(float) * 3);
+      memcpy(attributes->ambient, p + sizeof(float) * 6, sizeof(float) * 3);
+    } break;
+    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess | Visuals_VertexSyntactics_Float3_Float3_Float3_Float3_Float3_Float): {
+      p += index * sizeof(float) * 16;
+      memcpy(attributes->position, p + sizeof(float) * 0, sizeof(float) * 3);
+      memcpy(attributes->normal, p + sizeof(float) * 3, sizeof(float) * 3);
+      memcpy(attributes->ambient, p + sizeof(float) * 6, sizeof(float) * 3);
+      memcpy(attributes->diffuse, p + sizeof(float) * 9, sizeof(float) * 3);
+      memcpy(attributes->specular, p + sizeof(float) * 12, sizeof(float) * 3);
+      memcpy(&attributes->shininess, p + sizeof(float) * 15, sizeof(float) * 1);
+    } break;
+    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_MaterialIndex | Visuals_VertexSyntactics_Float3_Int2101010_UInt16): {
+      p += index * (sizeof(float) * 3 + sizeof(uint32_t) + sizeof(uint16_t) * 2);
+      uint32_t normal;
+      uint16_t materialIndex;
+      memcpy(attributes->position, p, sizeof(float) * 3);
+      memcpy(&normal, p + sizeof(float) * 3, sizeof(uint32_t));
+      memcpy(&materialIndex, p + sizeof(float) * 3 + sizeof(uint32_t), sizeof(uint16_t));
+      unpackNormal(normal, attributes->normal);
+      attributes->materialIndex = materialIndex;
+    } break;
+    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_TextureUv_MaterialIndex | Visuals_VertexSyntactics_Float3_Int2101010_Half2_UInt16): {
+      p += index * (sizeof(float) * 3 + sizeof(uint32_t) + sizeof(uint16_t) * 2 + sizeof(uint16_t) * 2);
+      uint32_t normal;
+      uint16_t textureUv[2];
+      uint16_t materialIndex;
+      memcpy(attributes->position, p, sizeof(float) * 3);
+      memcpy(&normal, p + sizeof(float) * 3, sizeof(uint32_t));
+      memcpy(textureUv, p + sizeof(float) * 3 + sizeof(uint32_t), sizeof(uint16_t) * 2);
+      memcpy(&materialIndex, p + sizeof(float) * 3 + sizeof(uint32_t) + sizeof(uint16_t) * 2, sizeof(uint16_t));
+      unpackNormal(normal, attributes->normal);
+      attributes->textureUv[0] = unpackHalf(textureUv[0]);
+      attributes->textureUv[1] = unpackHalf(textureUv[1]);
+      attributes->materialIndex = materialIndex;
+    } break;
+    default: {
+      /* Instance data has no vertex attributes. */
+    } break;
+  };
+}
+
+void
+Visuals_Software_VertexBuffer_getInstanceAttributes
+  (
+    Visuals_Software_VertexBuffer* self,
+    size_t index,
+    Visuals_Software_InstanceAttributes* attributes
+  )
+{
+  uint8_t const* p = (uint8_t const*)Visuals_Software_VertexBuffer_getBytes(self);
+  if (!p || ((Visuals_VertexBuffer*)self)->flags != (Visuals_VertexSemantics_Transform3x4_MaterialIndex | Visuals_VertexSyntactics_Float4_Float4_Float4_UInt32)) {
+    memset(attributes, 0, sizeof(Visuals_Software_InstanceAttributes));
+    attributes->transform[0][0] = 1.f;
+    attributes->transform[1][1] = 1.f;
+    attributes->transform[2][2] = 1.f;
+    return;
+  }
+  p += index * (sizeof(float) * 4 * 3 + sizeof(uint32_t));
+  memcpy(attributes->transform, p, sizeof(float) * 4 * 3);
+  memcpy(&attributes->materialIndex, p + sizeof(float) * 4 * 3, sizeof(uint32_t));
+}
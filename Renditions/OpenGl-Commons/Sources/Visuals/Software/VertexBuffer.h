@@ -0,0 +1,109 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(VISUALS_SOFTWARE_VERTEXBUFFER_H_INCLUDED)
+#define VISUALS_SOFTWARE_VERTEXBUFFER_H_INCLUDED
+
+#include "Visuals/VertexBuffer.h"
+
+/// @brief The attributes of a vertex decoded from the vertex data of a vertex buffer.
+/// Attributes not provided by the vertex format are zero.
+typedef struct Visuals_Software_VertexAttributes {
+  float position[3];
+  float normal[3];
+  float ambient[3];
+  float diffuse[3];
+  float specular[3];
+  float shininess;
+  float textureUv[2];
+  uint32_t materialIndex;
+} Visuals_Software_VertexAttributes;
+
+/// @brief The attributes of an instance decoded from the vertex data of a vertex buffer of the format
+/// Visuals_VertexSemantics_Transform3x4_MaterialIndex | Visuals_VertexSyntactics_Float4_Float4_Float4_UInt32.
+typedef struct Visuals_Software_InstanceAttributes {
+  /// @brief The rows of the transform.
+  float transform[3][4];
+  uint32_t materialIndex;
+} Visuals_Software_InstanceAttributes;
+
+/// @brief
+/// The implementation of Visuals.VertexBuffer for the software renderer.
+/// @details
+/// The vertex data is kept in memory as the vertex stage reads from it.
+/// If the vertex data is retained by Visuals.VertexBuffer, that copy is used.
+/// Otherwise, this vertex buffer keeps a copy of its own.
+/// The type is
+/// @code
+/// class Visuals.Software.VertexBuffer
+/// @endcode
+/// Its constructor is
+/// @code
+/// Visuals.Software.VertexBuffer.construct()
+/// @endcode
+Shizu_declareObjectType(Visuals_Software_VertexBuffer);
+
+struct Visuals_Software_VertexBuffer_Dispatch {
+  Visuals_VertexBuffer_Dispatch _parent;
+};
+
+struct Visuals_Software_VertexBuffer {
+  Visuals_VertexBuffer parent;
+  /// @brief A pointer to the copy of the vertex data or the null pointer.
+  void* bytes;
+};
+
+Visuals_Software_VertexBuffer*
+Visuals_Software_VertexBuffer_create
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Get the vertex data of this vertex buffer.
+/// @return A pointer to the vertex data. The null pointer if the vertex buffer has no vertex data.
+void const*
+Visuals_Software_VertexBuffer_getBytes
+  (
+    Visuals_Software_VertexBuffer* self
+  );
+
+/// @brief Decode the attributes of a vertex of this vertex buffer.
+/// @param index The index of the vertex. Must be less than the number of vertices.
+void
+Visuals_Software_VertexBuffer_getVertexAttributes
+  (
+    Visuals_Software_VertexBuffer* self,
+    size_t index,
+    Visuals_Software_VertexAttributes* attributes
+  );
+
+/// @brief Decode the attributes of an instance of this vertex buffer.
+/// @param index The index of the instance. Must be less than the number of vertices.
+/// @remarks If the vertex buffer is not of the instance format, the transform is the identity and the material index is zero.
+void
+Visuals_Software_VertexBuffer_getInstanceAttributes
+  (
+    Visuals_Software_VertexBuffer* self,
+    size_t index,
+    Visuals_Software_InstanceAttributes* attributes
+  );
+
+#endif // VISUALS_SOFTWARE_VERTEXBUFFER_H_INCLUDED
@@ -0,0 +1,514 @@
+#include "Building.h"
+
+// FLT_MAX, FLT_EPSILON
+#include <float.h>
+// malloc, realloc, free
+#include <malloc.h>
+// memcpy, memset
+#include <string.h>
+
+static void
+Cell_visit
+  (
+    Shizu_State2* state,
+    Cell* self
+  );
+
+static Shizu_ObjectTypeDescriptor const Cell_Type = {
+  .postCreateType = NULL,
+  .preDestroyType = NULL,
+  .visitType = NULL,
+  .size = sizeof(Cell),
+  .finalize = NULL,
+  .visit = (Shizu_OnVisitCallback*)&Cell_visit,
+  .dispatchSize = sizeof(Cell_Dispatch),
+  .dispatchInitialize = NULL,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Zeitgeist.Cell", Cell, Shizu_Object);
+
+static void
+Cell_visit
+  (
+    Shizu_State2* state,
+    Cell* self
+  )
+{
+  if (self->geometries) {
+    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->geometries);
+  }
+  if (self->batches) {
+    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->batches);
+  }
+}
+
+static Cell*
+Cell_create
+  (
+    Shizu_State2* state,
+    Visuals_Aabb const* bounds
+  )
+{
+  Shizu_Type* type = Cell_getType(state);
+  Cell* self = (Cell*)Shizu_Gc_allocateObject(state, sizeof(Cell));
+  self->bounds = *bounds;
+  self->geometries = NULL;
+  self->batches = NULL;
+  self->visible = false;
+  self->region[0] = -1.f;
+  self->region[1] = -1.f;
+  self->region[2] = +1.f;
+  self->region[3] = +1.f;
+  ((Shizu_Object*)self)->type = type;
+  self->geometries = Shizu_Runtime_Extensions_createList(state);
+  return self;
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+static void
+Building_finalize
+  (
+    Shizu_State2* state,
+    Building* self
+  );
+
+static void
+Building_visit
+  (
+    Shizu_State2* state,
+    Building* self
+  );
+
+static Shizu_ObjectTypeDescriptor const Building_Type = {
+  .postCreateType = NULL,
+  .preDestroyType = NULL,
+  .visitType = NULL,
+  .size = sizeof(Building),
+  .finalize = (Shizu_OnFinalizeCallback*)&Building_finalize,
+  .visit = (Shizu_OnVisitCallback*)&Building_visit,
+  .dispatchSize = sizeof(Building_Dispatch),
+  .dispatchInitialize = NULL,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Zeitgeist.Building", Building, Shizu_Object);
+
+static void
+Building_finalize
+  (
+    Shizu_State2* state,
+    Building* self
+  )
+{
+  if (self->onPath) {
+    free(self->onPath);
+    self->onPath = NULL;
+  }
+  if (self->cellArray) {
+    free(self->cellArray);
+    self->cellArray = NULL;
+  }
+  self->numberOfCells = 0;
+  if (self->pvs) {
+    free(self->pvs);
+    self->pvs = NULL;
+  }
+  if (self->portals) {
+    free(self->portals);
+    self->portals = NULL;
+  }
+  self->numberOfPortals = 0;
+  self->cells = NULL;
+}
+
+static void
+Building_visit
+  (
+    Shizu_State2* state,
+    Building* self
+  )
+{
+  if (self->cells) {
+    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->cells);
+  }
+}
+
+static inline Cell*
+Building_getCell
+  (
+    Shizu_State2* state,
+    Building* self,
+    size_t index
+  )
+{
+  return self->cellArray[index];
+}
+
+static void
+Building_invalidatePvs
+  (
+    Shizu_State2* state,
+    Building* self
+  )
+{
+  if (self->pvs) {
+    free(self->pvs);
+    self->pvs = NULL;
+  }
+}
+
+// Project the corners of a portal and intersect the rectangle enclosing them with a region of the viewport.
+// Return false if the portal is not visible through the region.
+static Shizu_Boolean
+clipPortal
+  (
+    Portal const* portal,
+    Shizu_Float32 m[4][4],
+    Shizu_Float32 const region[4],
+    Shizu_Float32 result[4]
+  )
+{
+  Shizu_Float32 rectangle[4] = { +FLT_MAX, +FLT_MAX, -FLT_MAX, -FLT_MAX };
+  size_t numberOfCornersBehind = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    Shizu_Float32 const* p = portal->corners[i];
+    Shizu_Float32 x = m[0][0] * p[0] + m[0][1] * p[1] + m[0][2] * p[2] + m[0][3];
+    Shizu_Float32 y = m[1][0] * p[0] + m[1][1] * p[1] + m[1][2] * p[2] + m[1][3];
+    Shizu_Float32 w = m[3][0] * p[0] + m[3][1] * p[1] + m[3][2] * p[2] + m[3][3];
+    if (w <= FLT_EPSILON) {
+      numberOfCornersBehind++;
+      continue;
+    }
+    x /= w;
+    y /= w;
+    rectangle[0] = x < rectangle[0] ? x : rectangle[0];
+    rectangle[1] = y < rectangle[1] ? y : rectangle[1];
+    rectangle[2] = x > rectangle[2] ? x : rectangle[2];
+    rectangle[3] = y > rectangle[3] ? y : rectangle[3];
+  }
+  if (numberOfCornersBehind == 4) {
+    // The portal is behind the viewer.
+    return false;
+  }
+  if (numberOfCornersBehind > 0) {
+    // The portal crosses the plane of the viewer, its projection is unbounded: Keep the region as it is.
+    memcpy(result, region, sizeof(Shizu_Float32) * 4);
+    return true;
+  }
+  result[0] = rectangle[0] > region[0] ? rectangle[0] : region[0];
+  result[1] = rectangle[1] > region[1] ? rectangle[1] : region[1];
+  result[2] = rectangle[2] < region[2] ? rectangle[2] : region[2];
+  result[3] = rectangle[3] < region[3] ? rectangle[3] : region[3];
+  return result[0] < result[2] && result[1] < result[3];
+}
+
+static void
+Building_traverse
+  (
+    Shizu_State2* state,
+    Building* self,
+    Shizu_Float32 m[4][4],
+    size_t source,
+    size_t index,
+    Shizu_Float32 const region[4],
+    size_t depth
+  )
+{
+  Cell* cell = Building_getCell(state, self, index);
+  if (!cell->visible) {
+    cell->visible = true;
+    memcpy(cell->region, region, sizeof(Shizu_Float32) * 4);
+  } else {
+    // The cell is visible through several portals: Use the rectangle enclosing all regions.
+    cell->region[0] = region[0] < cell->region[0] ? region[0] : cell->region[0];
+    cell->region[1] = region[1] < cell->region[1] ? region[1] : cell->region[1];
+    cell->region[2] = region[2] > cell->region[2] ? region[2] : cell->region[2];
+    cell->region[3] = region[3] > cell->region[3] ? region[3] : cell->region[3];
+  }
+  if (depth == Building_MaximumPortalDepth) {
+    return;
+  }
+  size_t numberOfCells = self->numberOfCells;
+  self->onPath[index] = 1;
+  for (size_t i = 0; i < self->numberOfPortals; ++i) {
+    Portal const* portal = &self->portals[i];
+    size_t other;
+    if (portal->cells[0] == index) {
+      other = portal->cells[1];
+    } else if (portal->cells[1] == index) {
+      other = portal->cells[0];
+    } else {
+      continue;
+    }
+    // Do not walk in circles.
+    if (self->onPath[other]) {
+      continue;
+    }
+    if (self->pvs && !self->pvs[source * numberOfCells + other]) {
+      continue;
+    }
+    Shizu_Float32 portalRegion[4];
+    if (!clipPortal(portal, m, region, portalRegion)) {
+      continue;
+    }
+    Building_traverse(state, self, m, source, other, portalRegion, depth + 1);
+  }
+  self->onPath[index] = 0;
+}
+
+static void
+Building_resetVisibility
+  (
+    Shizu_State2* state,
+    Building* self
+  )
+{
+  for (size_t i = 0, n = self->numberOfCells; i < n; ++i) {
+    Cell* cell = Building_getCell(state, self, i);
+    cell->visible = false;
+  }
+}
+
+Building*
+Building_create
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Type* type = Building_getType(state);
+  Building* self = (Building*)Shizu_Gc_allocateObject(state, sizeof(Building));
+  self->cells = NULL;
+  self->cellArray = NULL;
+  self->numberOfCells = 0;
+  self->portals = NULL;
+  self->numberOfPortals = 0;
+  self->pvs = NULL;
+  self->onPath = NULL;
+  ((Shizu_Object*)self)->type = type;
+  self->cells = Shizu_Runtime_Extensions_createList(state);
+  return self;
+}
+
+Cell*
+Building_addCell
+  (
+    Shizu_State2* state,
+    Building* self,
+    Visuals_Aabb const* bounds
+  )
+{
+  size_t numberOfCells = self->numberOfCells;
+  uint8_t* onPath = realloc(self->onPath, sizeof(uint8_t) * (numberOfCells + 1));
+  if (!onPath) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  self->onPath = onPath;
+  self->onPath[numberOfCells] = 0;
+  Cell** cellArray = realloc(self->cellArray, sizeof(Cell*) * (numberOfCells + 1));
+  if (!cellArray) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  self->cellArray = cellArray;
+  Cell* cell = Cell_create(state, bounds);
+  Shizu_List_appendObject(state, self->cells, (Shizu_Object*)cell);
+  self->cellArray[numberOfCells] = cell;
+  self->numberOfCells++;
+  Building_invalidatePvs(state, self);
+  return cell;
+}
+
+void
+Building_addPortal
+  (
+    Shizu_State2* state,
+    Building* self,
+    size_t cell0,
+    size_t cell1,
+    Shizu_Float32 const corners[4][3]
+  )
+{
+  size_t numberOfCells = self->numberOfCells;
+  if (cell0 >= numberOfCells || cell1 >= numberOfCells || cell0 == cell1) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  Portal* portals = realloc(self->portals, sizeof(Portal) * (self->numberOfPortals + 1));
+  if (!portals) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  self->portals = portals;
+  Portal* portal = &self->portals[self->numberOfPortals];
+  portal->cells[0] = cell0;
+  portal->cells[1] = cell1;
+  memcpy(portal->corners, corners, sizeof(Shizu_Float32) * 4 * 3);
+  Visuals_Aabb_fromPositions(&portal->bounds, corners, 4, sizeof(Shizu_Float32) * 3);
+  self->numberOfPortals++;
+  Building_invalidatePvs(state, self);
+}
+
+// The view-projection matrix of one of the six faces of a cube centered on a point.
+// Only the x, y, and w rows are used by the traversal.
+static void
+getCubeFaceMatrix
+  (
+    Shizu_Float32 const eye[3],
+    size_t face,
+    Shizu_Float32 m[4][4]
+  )
+{
+  // The forward, right, and up vectors of the faces.
+  static Shizu_Float32 const axes[6][3][3] = {
+    { { 0.f, 0.f, -1.f }, { +1.f, 0.f, 0.f }, { 0.f, +1.f, 0.f } },
+    { { 0.f, 0.f, +1.f }, { -1.f, 0.f, 0.f }, { 0.f, +1.f, 0.f } },
+    { { +1.f, 0.f, 0.f }, { 0.f, 0.f, +1.f }, { 0.f, +1.f, 0.f } },
+    { { -1.f, 0.f, 0.f }, { 0.f, 0.f, -1.f }, { 0.f, +1.f, 0.f } },
+    { { 0.f, +1.f, 0.f }, { +1.f, 0.f, 0.f }, { 0.f, 0.f, +1.f } },
+    { { 0.f, -1.f, 0.f }, { +1.f, 0.f, 0.f }, { 0.f, 0.f, -1.f } },
+  };
+  static Shizu_Float32 const near = 0.01f, far = 100.f;
+  Shizu_Float32 const* f = axes[face][0];
+  Shizu_Float32 const* r = axes[face][1];
+  Shizu_Float32 const* u = axes[face][2];
+  // A 90 degrees perspective projection with an aspect ratio of 1 times the view matrix (right, up, -forward).
+  Shizu_Float32 a = (far + near) / (near - far), b = 2.f * far * near / (near - far);
+  for (size_t j = 0; j < 3; ++j) {
+    m[0][j] = r[j];
+    m[1][j] = u[j];
+    m[2][j] = -a * f[j];
+    m[3][j] = f[j];
+  }
+  m[0][3] = -(r[0] * eye[0] + r[1] * eye[1] + r[2] * eye[2]);
+  m[1][3] = -(u[0] * eye[0] + u[1] * eye[1] + u[2] * eye[2]);
+  m[3][3] = -(f[0] * eye[0] + f[1] * eye[1] + f[2] * eye[2]);
+  m[2][3] = -a * m[3][3] + b;
+}
+
+void
+Building_computePvs
+  (
+    Shizu_State2* state,
+    Building* self
+  )
+{
+  static Shizu_Float32 const full[4] = { -1.f, -1.f, +1.f, +1.f };
+  Building_invalidatePvs(state, self);
+  size_t numberOfCells = self->numberOfCells;
+  if (!numberOfCells) {
+    return;
+  }
+  uint8_t* pvs = malloc(sizeof(uint8_t) * numberOfCells * numberOfCells);
+  if (!pvs) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  memset(pvs, 0, sizeof(uint8_t) * numberOfCells * numberOfCells);
+  for (size_t i = 0; i < numberOfCells; ++i) {
+    Cell* cell = Building_getCell(state, self, i);
+    Shizu_Float32 const* minimum = cell->bounds.minimum, * maximum = cell->bounds.maximum;
+    // A grid of sample points inside the cell followed by one sample point in front of each portal of the cell.
+    static Shizu_Float32 const grid[3] = { 0.1f, 0.5f, 0.9f };
+    static Shizu_Float32 const levels[2] = { 0.25f, 0.75f };
+    size_t numberOfGridSamples = 3 * 3 * 2;
+    for (size_t j = 0; j < numberOfGridSamples + self->numberOfPortals; ++j) {
+      Shizu_Float32 eye[3];
+      if (j < numberOfGridSamples) {
+        eye[0] = minimum[0] + grid[j % 3] * (maximum[0] - minimum[0]);
+        eye[1] = minimum[1] + levels[j / 9] * (maximum[1] - minimum[1]);
+        eye[2] = minimum[2] + grid[(j / 3) % 3] * (maximum[2] - minimum[2]);
+      } else {
+        Portal const* portal = &self->portals[j - numberOfGridSamples];
+        if (portal->cells[0] != i && portal->cells[1] != i) {
+          continue;
+        }
+        // The center of the portal moved slightly towards the center of the cell.
+        for (size_t k = 0; k < 3; ++k) {
+          Shizu_Float32 portalCenter = (portal->bounds.minimum[k] + portal->bounds.maximum[k]) * 0.5f;
+          Shizu_Float32 cellCenter = (minimum[k] + maximum[k]) * 0.5f;
+          eye[k] = portalCenter + 0.05f * (cellCenter - portalCenter);
+        }
+      }
+      for (size_t face = 0; face < 6; ++face) {
+        Shizu_Float32 m[4][4];
+        getCubeFaceMatrix(eye, face, m);
+        Building_resetVisibility(state, self);
+        Building_traverse(state, self, m, i, i, full, 0);
+        for (size_t k = 0; k < numberOfCells; ++k) {
+          if (Building_getCell(state, self, k)->visible) {
+            pvs[i * numberOfCells + k] = 1;
+          }
+        }
+      }
+    }
+    // A cell is always visible from itself and from the cells it is connected to.
+    pvs[i * numberOfCells + i] = 1;
+    for (size_t j = 0; j < self->numberOfPortals; ++j) {
+      Portal const* portal = &self->portals[j];
+      if (portal->cells[0] == i) {
+        pvs[i * numberOfCells + portal->cells[1]] = 1;
+      } else if (portal->cells[1] == i) {
+        pvs[i * numberOfCells + portal->cells[0]] = 1;
+      }
+    }
+  }
+  self->pvs = pvs;
+}
+
+Shizu_Boolean
+Building_findCell
+  (
+    Shizu_State2* state,
+    Building* self,
+    Shizu_Float32 const point[3],
+    size_t* index
+  )
+{
+  for (size_t i = 0, n = self->numberOfCells; i < n; ++i) {
+    Cell* cell = Building_getCell(state, self, i);
+    if (cell->bounds.minimum[0] <= point[0] && point[0] <= cell->bounds.maximum[0] &&
+        cell->bounds.minimum[1] <= point[1] && point[1] <= cell->bounds.maximum[1] &&
+        cell->bounds.minimum[2] <= point[2] && point[2] <= cell->bounds.maximum[2]) {
+      *index = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t
+Building_computeVisibility
+  (
+    Shizu_State2* state,
+    Building* self,
+    idlib_matrix_4x4_f32 const* matrix,
+    Shizu_Float32 const eye[3]
+  )
+{
+  static Shizu_Float32 const full[4] = { -1.f, -1.f, +1.f, +1.f };
+  size_t numberOfCells = self->numberOfCells;
+  size_t source;
+  if (!Building_findCell(state, self, eye, &source)) {
+    // The viewer is outside of the building: Only the view frustum applies.
+    for (size_t i = 0; i < numberOfCells; ++i) {
+      Cell* cell = Building_getCell(state, self, i);
+      cell->visible = true;
+      memcpy(cell->region, full, sizeof(Shizu_Float32) * 4);
+    }
+    return numberOfCells;
+  }
+  Building_resetVisibility(state, self);
+  Shizu_Float32 m[4][4];
+  memcpy(m, matrix->e, sizeof(m));
+  Building_traverse(state, self, m, source, source, full, 0);
+  size_t numberOfVisibleCells = 0;
+  for (size_t i = 0; i < numberOfCells; ++i) {
+    if (Building_getCell(state, self, i)->visible) {
+      numberOfVisibleCells++;
+    }
+  }
+  return numberOfVisibleCells;
+}
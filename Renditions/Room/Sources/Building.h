@@ -0,0 +1,186 @@
+#if !defined(BUILDING_H_INCLUDED)
+#define BUILDING_H_INCLUDED
+
+#include "Visuals/Frustum.h"
+
+/// @since 2.0
+/// @brief The maximal number of portals traversed from the cell of the viewer.
+#define Building_MaximumPortalDepth (16)
+
+/// @since 2.0
+/// @brief
+/// A cell of a building that is a room.
+/// @details
+/// The geometries of a cell are merged into static batches of their own such that the cell can be skipped if it is not visible.
+Shizu_declareObjectType(Cell)
+
+struct Cell_Dispatch {
+  Shizu_Object_Dispatch _parent;
+};
+
+struct Cell {
+  Shizu_Object parent;
+
+  /// @brief The bounding box of the cell in the coordinate system of the vertices.
+  Visuals_Aabb bounds;
+
+  /// @brief
+  /// A pointer to the list of StaticGeometry objects of this cell. Must not be null.
+  Shizu_List* geometries;
+
+  /// @brief
+  /// A pointer to the list of StaticBatch objects of this cell. Null until the geometries were merged.
+  Shizu_List* batches;
+
+  /// @brief If this cell is possibly visible in the current frame.
+  Shizu_Boolean visible;
+
+  /// @brief
+  /// The minimal x, minimal y, maximal x, and maximal y normalized device coordinates of the region of the viewport
+  /// through which this cell is possibly visible in the current frame.
+  Shizu_Float32 region[4];
+};
+
+/// @since 2.0
+/// @brief An opening between two cells of a building, for example a doorway.
+typedef struct Portal {
+  /// @brief The indices of the two cells connected by this portal.
+  size_t cells[2];
+  /// @brief The four corners of the opening in the coordinate system of the vertices.
+  Shizu_Float32 corners[4][3];
+  /// @brief The bounding box of the corners.
+  Visuals_Aabb bounds;
+} Portal;
+
+/// @since 2.0
+/// @brief
+/// The cells and portals of a building.
+/// @details
+/// The visible cells are determined by traversing the portals starting at the cell of the viewer.
+/// The region of the viewport through which a cell is visible is narrowed by each portal on the way.
+/// For static layouts, a potentially visible set can be precomputed to prune the traversal further.
+Shizu_declareObjectType(Building)
+
+struct Building_Dispatch {
+  Shizu_Object_Dispatch _parent;
+};
+
+struct Building {
+  Shizu_Object parent;
+
+  /// @brief
+  /// A pointer to the list of Cell objects. Must not be null.
+  Shizu_List* cells;
+
+  /// @brief
+  /// A pointer to an array of @a numberOfCells pointers to the Cell objects of @a cells.
+  /// The visibility is determined from this array such that it does not access the list.
+  Cell** cellArray;
+
+  /// @brief The number of cells.
+  size_t numberOfCells;
+
+  /// @brief A pointer to an array of @a numberOfPortals portals.
+  Portal* portals;
+
+  /// @brief The number of portals.
+  size_t numberOfPortals;
+
+  /// @brief
+  /// A pointer to the potentially visible set or a null pointer if it was not computed.
+  /// Element i * n + j is 1 if cell j is possibly visible from cell i and 0 otherwise, where n is the number of cells.
+  uint8_t* pvs;
+
+  /// @brief A pointer to an array of one flag per cell. Flag i is 1 if cell i is on the current traversal path.
+  uint8_t* onPath;
+};
+
+/// @brief Create an empty building.
+/// @param state A pointer to the state.
+/// @return A pointer to the building.
+Building*
+Building_create
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Add a cell to this building.
+/// @param state A pointer to the state.
+/// @param self A pointer to this building.
+/// @param bounds A pointer to the bounding box of the cell.
+/// @return A pointer to the cell. Its index is the number of cells before the call.
+/// @remarks The potentially visible set is discarded.
+Cell*
+Building_addCell
+  (
+    Shizu_State2* state,
+    Building* self,
+    Visuals_Aabb const* bounds
+  );
+
+/// @brief Add a portal to this building.
+/// @param state A pointer to the state.
+/// @param self A pointer to this building.
+/// @param cell0, cell1 The indices of the two distinct cells connected by the portal.
+/// @param corners The four corners of the opening.
+/// @error Shizu_Status_ArgumentValueInvalid @a cell0 or @a cell1 is not the index of a cell or @a cell0 and @a cell1 are equal.
+/// @remarks The potentially visible set is discarded.
+void
+Building_addPortal
+  (
+    Shizu_State2* state,
+    Building* self,
+    size_t cell0,
+    size_t cell1,
+    Shizu_Float32 const corners[4][3]
+  );
+
+/// @brief Compute the potentially visible set of this building.
+/// @param state A pointer to the state.
+/// @param self A pointer to this building.
+/// @details
+/// For each cell, the cells visible through the portals are collected for views in all directions from sample points
+/// in the cell and in front of its portals. The layout of the building must not change afterwards.
+void
+Building_computePvs
+  (
+    Shizu_State2* state,
+    Building* self
+  );
+
+/// @brief Get the cell containing a point.
+/// @param state A pointer to the state.
+/// @param self A pointer to this building.
+/// @param point The point in the coordinate system of the vertices.
+/// @param index A pointer to a size_t variable receiving the index of the cell.
+/// @return @a true if a cell contains the point, @a false otherwise.
+Shizu_Boolean
+Building_findCell
+  (
+    Shizu_State2* state,
+    Building* self,
+    Shizu_Float32 const point[3],
+    size_t* index
+  );
+
+/// @brief Determine the possibly visible cells and the regions of the viewport through which they are visible.
+/// @param state A pointer to the state.
+/// @param self A pointer to this building.
+/// @param matrix The product of the projection, the view, and the world matrix.
+/// @param eye The position of the viewer in the coordinate system of the vertices.
+/// @return The number of possibly visible cells.
+/// The Cell.visible and Cell.region fields of the cells are updated.
+/// If the viewer is not in any cell, all cells are possibly visible through the whole viewport.
+/// @remarks
+/// This function does not access Shizu objects other than this building and its cells and does not raise errors.
+/// It may run on a thread of the pool while the main thread does not access this building.
+size_t
+Building_computeVisibility
+  (
+    Shizu_State2* state,
+    Building* self,
+    idlib_matrix_4x4_f32 const* matrix,
+    Shizu_Float32 const eye[3]
+  );
+
+#endif // BUILDING_H_INCLUDED
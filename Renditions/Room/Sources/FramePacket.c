@@ -0,0 +1,181 @@
+#include "FramePacket.h"
+
+// malloc, free
+#include <malloc.h>
+// memcpy
+#include <string.h>
+
+static void
+FramePacket_freeArrays
+  (
+    FramePacket* self
+  )
+{
+  if (self->counts) {
+    free(self->counts);
+    self->counts = NULL;
+  }
+  if (self->firsts) {
+    free(self->firsts);
+    self->firsts = NULL;
+  }
+  if (self->draws) {
+    free(self->draws);
+    self->draws = NULL;
+  }
+  if (self->batches) {
+    free(self->batches);
+    self->batches = NULL;
+  }
+  if (self->cells) {
+    free(self->cells);
+    self->cells = NULL;
+  }
+}
+
+void
+FramePacket_initialize
+  (
+    Shizu_State2* state,
+    FramePacket* self,
+    World* world
+  )
+{
+  Building* building = world->building;
+  size_t numberOfCells = building->numberOfCells;
+  size_t numberOfBatches = 0;
+  size_t numberOfRanges = 0;
+  for (size_t j = 0; j < numberOfCells; ++j) {
+    Cell* cell = building->cellArray[j];
+    if (!cell->batches) {
+      continue;
+    }
+    for (size_t i = 0, n = Shizu_List_getSize(state, cell->batches); i < n; ++i) {
+      Shizu_Value elementValue = Shizu_List_getValue(state, cell->batches, i);
+      StaticBatch* element = (StaticBatch*)Shizu_Value_getObject(&elementValue);
+      numberOfBatches++;
+      numberOfRanges += element->numberOfRanges;
+    }
+  }
+  // Allocate at least one element such that a null pointer indicates a failed allocation.
+  self->cells = malloc(sizeof(FrameCell) * (numberOfCells ? numberOfCells : 1));
+  self->batches = malloc(sizeof(StaticBatch*) * (numberOfBatches ? numberOfBatches : 1));
+  self->draws = malloc(sizeof(FrameDraw) * (numberOfBatches ? numberOfBatches : 1));
+  self->firsts = malloc(sizeof(Shizu_Integer32) * (numberOfRanges ? numberOfRanges : 1));
+  self->counts = malloc(sizeof(Shizu_Integer32) * (numberOfRanges ? numberOfRanges : 1));
+  if (!self->cells || !self->batches || !self->draws || !self->firsts || !self->counts) {
+    FramePacket_freeArrays(self);
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    // Copy the cells and their batches such that preparing this frame packet does not access the lists.
+    size_t firstBatch = 0;
+    for (size_t j = 0; j < numberOfCells; ++j) {
+      Cell* cell = building->cellArray[j];
+      FrameCell* frameCell = &self->cells[j];
+      frameCell->cell = cell;
+      frameCell->firstBatch = firstBatch;
+      frameCell->numberOfBatches = cell->batches ? Shizu_List_getSize(state, cell->batches) : 0;
+      frameCell->numberOfGeometries = Shizu_List_getSize(state, cell->geometries);
+      for (size_t i = 0; i < frameCell->numberOfBatches; ++i) {
+        Shizu_Value elementValue = Shizu_List_getValue(state, cell->batches, i);
+        self->batches[firstBatch + i] = (StaticBatch*)Shizu_Value_getObject(&elementValue);
+      }
+      firstBatch += frameCell->numberOfBatches;
+    }
+    self->lightClusters = Visuals_LightClusters_create(state);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    FramePacket_freeArrays(self);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)self->lightClusters);
+  self->building = building;
+  self->numberOfCells = numberOfCells;
+  self->numberOfDraws = 0;
+  self->numberOfVisibleGeometries = 0;
+  self->numberOfCulledGeometries = 0;
+}
+
+void
+FramePacket_uninitialize
+  (
+    Shizu_State2* state,
+    FramePacket* self
+  )
+{
+  Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)self->lightClusters);
+  self->lightClusters = NULL;
+  FramePacket_freeArrays(self);
+  self->numberOfCells = 0;
+  self->building = NULL;
+}
+
+void
+FramePacket_setCamera
+  (
+    Shizu_State2* state,
+    FramePacket* self,
+    FramePacket_Camera const* camera
+  )
+{
+  self->world = camera->world->m;
+  self->view = camera->view->m;
+  self->projection = camera->projection->m;
+  self->modelToProjection = camera->modelToProjection->m;
+  memcpy(self->viewerPosition, camera->viewerPosition, sizeof(Shizu_Float32) * 3);
+  memcpy(self->eye, camera->eye, sizeof(Shizu_Float32) * 3);
+}
+
+void
+FramePacket_prepare
+  (
+    Shizu_State2* state,
+    FramePacket* self,
+    Visuals_PointLight const* lights,
+    size_t numberOfLights
+  )
+{
+  // Assign the point lights to the clusters of the view frustum.
+  Visuals_LightClusters_build(state, self->lightClusters, &self->view, &self->projection, lights, numberOfLights);
+
+  // Determine the rooms visible through the doorways from the room of the player.
+  Building_computeVisibility(state, self->building, &self->modelToProjection, self->eye);
+  self->numberOfDraws = 0;
+  self->numberOfVisibleGeometries = 0;
+  self->numberOfCulledGeometries = 0;
+  size_t numberOfRanges = 0;
+  for (size_t j = 0; j < self->numberOfCells; ++j) {
+    FrameCell const* frameCell = &self->cells[j];
+    Cell* cell = frameCell->cell;
+    if (!cell->visible) {
+      self->numberOfCulledGeometries += frameCell->numberOfGeometries;
+      continue;
+    }
+    // The frustum in the coordinate system of the vertices narrowed to the region through which the room is visible.
+    Visuals_Frustum frustum;
+    Visuals_Frustum_extractRegion(state, &frustum, &self->modelToProjection, cell->region);
+    for (size_t i = 0; i < frameCell->numberOfBatches; ++i) {
+      StaticBatch* element = self->batches[frameCell->firstBatch + i];
+      // Reject the invisible geometries of the batch before binding and drawing.
+      size_t numberOfVisibleRanges = StaticBatch_cull(state, element, &frustum);
+      self->numberOfVisibleGeometries += numberOfVisibleRanges;
+      self->numberOfCulledGeometries += element->numberOfRanges - numberOfVisibleRanges;
+      if (!numberOfVisibleRanges) {
+        continue;
+      }
+      // The culling results of the batch are overwritten by the next frame packet, hence they are copied.
+      FrameDraw* draw = &self->draws[self->numberOfDraws++];
+      draw->batch = element;
+      draw->firstRange = numberOfRanges;
+      draw->numberOfRanges = numberOfVisibleRanges;
+      memcpy(self->firsts + numberOfRanges, element->visibleFirsts, sizeof(Shizu_Integer32) * numberOfVisibleRanges);
+      memcpy(self->counts + numberOfRanges, element->visibleCounts, sizeof(Shizu_Integer32) * numberOfVisibleRanges);
+      numberOfRanges += numberOfVisibleRanges;
+    }
+  }
+}
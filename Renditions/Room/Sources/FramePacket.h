@@ -0,0 +1,130 @@
+#if !defined(FRAMEPACKET_H_INCLUDED)
+#define FRAMEPACKET_H_INCLUDED
+
+#include "StaticBatch.h"
+#include "Visuals/LightClusters.h"
+
+/// @brief A batch to draw and its possibly visible sub-ranges.
+typedef struct FrameDraw {
+  /// @brief A pointer to the batch.
+  StaticBatch* batch;
+  /// @brief The index of the first sub-range of this draw in the sub-ranges of the frame packet.
+  size_t firstRange;
+  /// @brief The number of sub-ranges of this draw.
+  size_t numberOfRanges;
+} FrameDraw;
+
+/// @brief The batches of a cell of the building.
+typedef struct FrameCell {
+  /// @brief A pointer to the cell.
+  Cell* cell;
+  /// @brief The index of the first batch of this cell in the batches of the frame packet.
+  size_t firstBatch;
+  /// @brief The number of batches of this cell.
+  size_t numberOfBatches;
+  /// @brief The number of geometries of this cell.
+  size_t numberOfGeometries;
+} FrameCell;
+
+/// @brief A snapshot of everything a frame is drawn from.
+/// @details
+/// A frame packet is prepared from the state of the world and then drawn.
+/// Once prepared, it is not modified until it is drawn.
+/// This allows for preparing the next frame packet on a thread of the pool while the previous frame packet is drawn.
+/// The cells and batches of the world are copied to arrays when the frame packet is initialized such that preparing a frame packet does not access Shizu lists.
+/// All arrays are allocated for the worst case when the frame packet is initialized such that preparing a frame packet does not allocate.
+typedef struct FramePacket {
+  /// @brief A pointer to the building of the world.
+  Building* building;
+  /// @brief A pointer to an array of @a numberOfCells cells, one for each cell of the building.
+  FrameCell* cells;
+  size_t numberOfCells;
+  /// @brief A pointer to an array of the batches of all cells ordered by cell.
+  StaticBatch** batches;
+  /// @brief The world, view, and projection matrices.
+  idlib_matrix_4x4_f32 world, view, projection;
+  /// @brief The product of the projection, the view, and the world matrices.
+  idlib_matrix_4x4_f32 modelToProjection;
+  /// @brief The position of the viewer in world coordinates.
+  Shizu_Float32 viewerPosition[3];
+  /// @brief The position of the viewer in the coordinate system of the vertices.
+  Shizu_Float32 eye[3];
+  /// @brief A pointer to the assignment of the point lights to clusters. Locked.
+  Visuals_LightClusters* lightClusters;
+  /// @brief A pointer to an array of @a numberOfDraws draws.
+  FrameDraw* draws;
+  size_t numberOfDraws;
+  /// @brief Pointers to arrays of the indices of the first vertices and the numbers of vertices of the sub-ranges of all draws.
+  Shizu_Integer32* firsts, * counts;
+  /// @brief The number of possibly visible geometries and the number of culled geometries.
+  size_t numberOfVisibleGeometries, numberOfCulledGeometries;
+} FramePacket;
+
+/// @brief Initialize a frame packet for the cells and batches of a world.
+/// @param state A pointer to the state.
+/// @param self A pointer to the frame packet.
+/// @param world A pointer to the world. Its cells and batches must not change while this frame packet is in use.
+/// @error Shizu_Status_AllocationFailed an allocation failed.
+void
+FramePacket_initialize
+  (
+    Shizu_State2* state,
+    FramePacket* self,
+    World* world
+  );
+
+/// @brief Uninitialize a frame packet.
+/// @param state A pointer to the state.
+/// @param self A pointer to the frame packet.
+void
+FramePacket_uninitialize
+  (
+    Shizu_State2* state,
+    FramePacket* self
+  );
+
+/// @brief The arguments of FramePacket_setCamera.
+typedef struct FramePacket_Camera {
+  /// @brief Pointers to the world, the view, and the projection matrices.
+  Matrix4F32* world, * view, * projection;
+  /// @brief A pointer to the product of the projection, the view, and the world matrices.
+  Matrix4F32* modelToProjection;
+  /// @brief The position of the viewer in world coordinates.
+  Shizu_Float32 viewerPosition[3];
+  /// @brief The position of the viewer in the coordinate system of the vertices.
+  Shizu_Float32 eye[3];
+} FramePacket_Camera;
+
+/// @brief Copy a camera to a frame packet.
+/// @param state A pointer to the state.
+/// @param self A pointer to the frame packet.
+/// @param camera A pointer to the camera.
+/// @remarks This function accesses Shizu objects and hence must run on the main thread.
+void
+FramePacket_setCamera
+  (
+    Shizu_State2* state,
+    FramePacket* self,
+    FramePacket_Camera const* camera
+  );
+
+/// @brief Prepare a frame packet for its camera.
+/// Determine the visible rooms and the possibly visible sub-ranges of their batches and assign the point lights to clusters.
+/// @param state A pointer to the state.
+/// @param self A pointer to the frame packet.
+/// @param lights, numberOfLights A pointer to an array of @a numberOfLights point lights.
+/// @remarks
+/// This function does not allocate and does not raise errors.
+/// It does not access Shizu objects other than the cells and batches of the frame packet and its light clusters.
+/// Hence it may run on a thread of the pool while the main thread draws another frame packet.
+/// It modifies the visibility of the cells of the building and the culling results of the batches of the world.
+void
+FramePacket_prepare
+  (
+    Shizu_State2* state,
+    FramePacket* self,
+    Visuals_PointLight const* lights,
+    size_t numberOfLights
+  );
+
+#endif // FRAMEPACKET_H_INCLUDED
@@ -11,18 +11,23 @@
 // fprintf, stdout
 #include <stdio.h>
 
+// ceilf
+#include <math.h>
+
 #include "KeyboardKeyMessage.h"
 #include "Visuals/Service.h"
+#include "FramePacket.h"
+#include "StaticBatch.h"
 #include "World.h"
 
 #include "Visuals/DefaultPrograms.h"
+#include "Visuals/Frustum.h"
+#include "Visuals/LightClusters.h"
+#include "Visuals/LightSet.h"
+#include "Visuals/Parallel.h"
 #include "Visuals/Program.h"
 #include "Visuals/RenderBuffer.h"
 #include "Visuals/VertexBuffer.h"
-#include "Visuals/MaterialTechnique.h"
-#include "Visuals/PhongMaterialTechnique.h"
-#include "Visuals/BlinnPhongMaterialTechnique.h"
-#include "Visuals/Gl/Context.h"
 
 #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
   #define Shizu_Rendition_Export _declspec(dllexport)
@@ -50,92 +55,133 @@ Zeitgeist_Rendition_getName
   return Shizu_String_create(state, "Room (OpenGL)", strlen("Room (OpenGL)"));
 }
 
-static Visuals_Program* g_program = NULL;
 static Visuals_RenderBuffer* g_renderBuffer = NULL;
 static World* g_world = NULL;
 
-#define LightModel_Phong (1)
-#define LightModel_BlinnPhong (2)
-static Shizu_Integer32 g_lightModel = LightModel_Phong;
-
-/// The "Phong" material expects the program to provide the following constants:
-/// | name                    | GLSL type |
-/// |-------------------------|-----------|
-/// | phongMaterial.ambient   | vec3      |
-/// | phongMaterial.diffuse   | vec3      |
-/// | phongMaterial.specular  | vec3      |
-/// | phongMaterial.shininess | float     |
-
-static void bindPhongMaterial(Shizu_State2* state, Visuals_Context* context, Visuals_Program* program, Visuals_PhongMaterialTechnique* material) {
-  Visuals_Program_bindVector3F32(state, g_program, "phongMaterial.ambient", Vector3F32_create(state, ((Shizu_Float32)material->ambientR) / 255.f,
-                                                                                                     ((Shizu_Float32)material->ambientG) / 255.f,
-                                                                                                     ((Shizu_Float32)material->ambientB) / 255.f));
-  Visuals_Program_bindVector3F32(state, g_program, "phongMaterial.diffuse", Vector3F32_create(state, ((Shizu_Float32)material->diffuseR) / 255.f,
-                                                                                                     ((Shizu_Float32)material->diffuseG) / 255.f,
-                                                                                                     ((Shizu_Float32)material->diffuseB) / 255.f));
-  Visuals_Program_bindVector3F32(state, g_program, "phongMaterial.specular", Vector3F32_create(state, ((Shizu_Float32)material->specularR) / 255.f,
-                                                                                                      ((Shizu_Float32)material->specularG) / 255.f,
-                                                                                                      ((Shizu_Float32)material->specularB) / 255.f));
-  Visuals_Program_bindFloat32(state, g_program, "phongMaterial.shininess", ((Shizu_Float32)material->shininess) / 255.f);
-}
-
-/// The "Blinn-Phong" material expects the program to provide the following constants:
-/// | name                         | GLSL type |
-/// |------------------------------|-----------|
-/// | blinnPhongMaterial.ambient   | vec3      |
-/// | blinnPhongMaterial.diffuse   | vec3      |
-/// | blinnPhongMaterial.specular  | vec3      |
-/// | blinnPhongMaterial.shininess | float     |
-static void bindBlinnPhongMaterial(Shizu_State2* state, Visuals_Context* context, Visuals_Program* program, Visuals_BlinnPhongMaterialTechnique* material) {
-  Visuals_Program_bindVector3F32(state, g_program, "blinnPhongMaterial.ambient", Vector3F32_create(state, ((Shizu_Float32)material->ambientR) / 255.f,
-                                                                                                          ((Shizu_Float32)material->ambientG) / 255.f,
-                                                                                                          ((Shizu_Float32)material->ambientB) / 255.f));
-  Visuals_Program_bindVector3F32(state, g_program, "blinnPhongMaterial.diffuse", Vector3F32_create(state, ((Shizu_Float32)material->diffuseR) / 255.f,
-                                                                                                          ((Shizu_Float32)material->diffuseG) / 255.f,
-                                                                                                          ((Shizu_Float32)material->diffuseB) / 255.f));
-  Visuals_Program_bindVector3F32(state, g_program, "blinnPhongMaterial.specular", Vector3F32_create(state, ((Shizu_Float32)material->specularR) / 255.f,
-                                                                                                           ((Shizu_Float32)material->specularG) / 255.f,
-                                                                                                           ((Shizu_Float32)material->specularB) / 255.f));
-  Visuals_Program_bindFloat32(state, g_program, "blinnPhongMaterial.shininess", ((Shizu_Float32)material->shininess) / 255.f);
+/// The scale of the world matrix. The player moves in the scaled coordinate system.
+static const Shizu_Float32 g_worldScale[3] = { 0.75f, 0.75f, 1.f };
+
+/// The light model. Selects the permutations of the "pbr1" program.
+static Shizu_Integer32 g_lightModel = Visuals_LightModel_Phong;
+
+/// The ambient light, the directional light, and the point light.
+/// Their number selects the permutations of the "pbr1" program.
+static Visuals_LightSet* g_lightSet = NULL;
+/// The uniform buffer of the "Lights" uniform block.
+/// Bound to the uniform buffer binding point Visuals_UniformBlockBinding_Lights.
+static Visuals_UniformBuffer* g_lightBuffer = NULL;
+
+/// The point lights below the ceiling: a grid of PointLightsX x PointLightsZ lights.
+#define PointLightsX (4)
+#define PointLightsZ (4)
+static Visuals_PointLight g_pointLights[PointLightsX * PointLightsZ];
+/// The lamps of the point lights: a small quad facing downwards drawn once per point light.
+/// The vertex buffer holds the quad, the instance buffer holds the transform and the material of each lamp.
+static Visuals_VertexBuffer* g_lampVertexBuffer = NULL;
+static Visuals_VertexBuffer* g_lampInstanceBuffer = NULL;
+/// The frame packets.
+/// While the frame packet of the previous update is drawn, the frame packet of the current update is prepared on a thread of the pool.
+static FramePacket g_framePackets[2];
+/// The index of the frame packet to draw.
+static size_t g_currentFramePacket = 0;
+/// The uniform buffers of the "ClusteredLights", "ClusterGrid", and "ClusterIndices" uniform blocks.
+/// Bound to the uniform buffer binding points Visuals_UniformBlockBinding_ClusteredLights, Visuals_UniformBlockBinding_ClusterGrid, and Visuals_UniformBlockBinding_ClusterIndices.
+/// Their contents are written once per frame.
+static Visuals_UniformBuffer* g_lightClusterBuffers[3] = { NULL, NULL, NULL };
+/// The uniform buffer of the "Frame" uniform block.
+/// Its contents are written once per frame.
+static Visuals_UniformBuffer* g_frameBuffer = NULL;
+
+/// Get the vertex semantics of a vertex buffer.
+static uint32_t getVertexSemantics(Shizu_State2* state, Visuals_VertexBuffer* vertexBuffer) {
+  switch (vertexBuffer->flags) {
+    case (Visuals_VertexSemantics_PositionXyz | Visuals_VertexSyntactics_Float3): {
+      return Visuals_VertexSemantics_PositionXyz;
+    } break;
+    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb | Visuals_VertexSyntactics_Float3_Float3_Float3): {
+      return Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb;
+    } break;
+    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess | Visuals_VertexSyntactics_Float3_Float3_Float3_Float3_Float3_Float): {
+      return Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess;
+    } break;
+    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_MaterialIndex | Visuals_VertexSyntactics_Float3_Int2101010_UInt16): {
+      return Visuals_VertexSemantics_PositionXyz_NormalXyz_MaterialIndex;
+    } break;
+    default: {
+      fprintf(stderr, "%s:%d: unreachable code reached\n", __FILE__, __LINE__);
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    } break;
+  };
 }
 
-static void bindMaterial(Shizu_State2* state, Visuals_Context* context, Visuals_Program* program, Visuals_MaterialTechnique* material) {
-  if (Shizu_Types_isSubTypeOf(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), ((Shizu_Object*)material)->type, Visuals_PhongMaterialTechnique_getType(state))) {
-    bindPhongMaterial(state, context, program, (Visuals_PhongMaterialTechnique*)material);
+/// Create the vertex buffer and the instance buffer of the lamps.
+static void createLamps(Shizu_State2* state, Visuals_Context* visualsContext) {
+  struct {
+    float position[3];
+    uint32_t normal;
+    uint16_t materialIndex;
+    uint16_t padding;
+  } vertices[4];
+  // A strip of two triangles facing downwards.
+  static const float positions[4][3] = {
+    { -0.1f, 0.f, -0.1f }, { +0.1f, 0.f, -0.1f }, { -0.1f, 0.f, +0.1f }, { +0.1f, 0.f, +0.1f },
+  };
+  for (size_t i = 0; i < 4; ++i) {
+    memcpy(vertices[i].position, positions[i], sizeof(float) * 3);
+    vertices[i].normal = Visuals_packNormal(0.f, -1.f, 0.f);
+    // The material index of the instance is used.
+    vertices[i].materialIndex = 0;
+    vertices[i].padding = 0;
   }
-  if (Shizu_Types_isSubTypeOf(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), ((Shizu_Object*)material)->type, Visuals_BlinnPhongMaterialTechnique_getType(state))) {
-    bindBlinnPhongMaterial(state, context, program, (Visuals_BlinnPhongMaterialTechnique*)material);
+  Visuals_VertexBuffer* vertexBuffer = (Visuals_VertexBuffer*)Visuals_Context_createVertexBuffer(state, visualsContext);
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)vertexBuffer);
+  g_lampVertexBuffer = vertexBuffer;
+  Visuals_Object_materialize(state, (Visuals_Object*)vertexBuffer);
+  Visuals_VertexBuffer_setData(state, vertexBuffer, Visuals_VertexSemantics_PositionXyz_NormalXyz_MaterialIndex | Visuals_VertexSyntactics_Float3_Int2101010_UInt16, vertices, sizeof(vertices));
+
+  struct {
+    float transform[3][4];
+    uint32_t materialIndex;
+  } instances[PointLightsX * PointLightsZ];
+  for (size_t i = 0; i < PointLightsX * PointLightsZ; ++i) {
+    // The lights are in world coordinates, the instances are transformed by the world matrix.
+    float const t[3][4] = {
+      { 1.f, 0.f, 0.f, g_pointLights[i].position[0] / g_worldScale[0] },
+      { 0.f, 1.f, 0.f, g_pointLights[i].position[1] / g_worldScale[1] },
+      { 0.f, 0.f, 1.f, g_pointLights[i].position[2] / g_worldScale[2] },
+    };
+    memcpy(instances[i].transform, t, sizeof(t));
+    instances[i].materialIndex = 1;
   }
+  Visuals_VertexBuffer* instanceBuffer = (Visuals_VertexBuffer*)Visuals_Context_createVertexBuffer(state, visualsContext);
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)instanceBuffer);
+  g_lampInstanceBuffer = instanceBuffer;
+  Visuals_Object_materialize(state, (Visuals_Object*)instanceBuffer);
+  Visuals_VertexBuffer_setData(state, instanceBuffer, Visuals_VertexSemantics_Transform3x4_MaterialIndex | Visuals_VertexSyntactics_Float4_Float4_Float4_UInt32, instances, sizeof(instances));
 }
 
-Shizu_Rendition_Export void
-Zeitgeist_Rendition_update
-  (
-    Shizu_State2* state,
-    Shizu_Value* returnValue,
-    Shizu_Integer32 numberOfArgumentValues,
-    Shizu_Value* argumentValues
-  )
-{
-  Visuals_Service_update(state);
-  World_update(state, g_world, 200); /* TODO: Pass delta time. */
-
-  if (Visuals_Service_quitRequested(state)) {
-    Zeitgeist_UpstreamRequest* request = Zeitgeist_UpstreamRequest_createExitProcessRequest(state);
-    Zeitgeist_sendUpstreamRequest(state, request);
+/// Destroy the vertex buffer and the instance buffer of the lamps.
+static void destroyLamps(Shizu_State2* state) {
+  if (g_lampInstanceBuffer) {
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)g_lampInstanceBuffer);
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_lampInstanceBuffer);
+    g_lampInstanceBuffer = NULL;
   }
+  if (g_lampVertexBuffer) {
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)g_lampVertexBuffer);
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_lampVertexBuffer);
+    g_lampVertexBuffer = NULL;
+  }
+}
 
-  Visuals_Context* visualsContext = (Visuals_Context*)Visuals_Gl_Context_create(state);
-
+/// Copy the camera of the player to a frame packet.
+static void setCamera(Shizu_State2* state, FramePacket* framePacket) {
   Shizu_Integer32 canvasWidth, canvasHeight;
   Visuals_Service_getClientSize(state, &canvasWidth, &canvasHeight);
-  Visuals_Service_beginFrame(state);
-
-  Visuals_Context_clear(state, visualsContext, true, true);
 
   Matrix4F32* world = NULL;
-  world = Matrix4F32_createScale(state, Vector3F32_create(state, 0.75f, 0.75f, 1.f));
-  Visuals_Program_bindMatrix4F32(state, g_program, "matrices.world", world);
+  world = Matrix4F32_createScale(state, Vector3F32_create(state, g_worldScale[0], g_worldScale[1], g_worldScale[2]));
   // (viewRotateY^-1 * viewTranslate^-1)
   // is equivalent to
   // (viewTranslate * viewRotateY)^-1
@@ -148,62 +194,169 @@ Zeitgeist_Rendition_update
   viewRotateY = Matrix4F32_createRotateY(state, -g_world->player->rotationY);
   Matrix4F32* view = NULL;
   view = Matrix4F32_multiply(state, viewRotateY, viewTranslate);
-  Visuals_Program_bindMatrix4F32(state, g_program, "matrices.view", view);
 
-  Visuals_Program_bindVector3F32(state, g_program, "viewer.position",
-                                 Vector3F32_create(state, g_world->player->position->v.e[0], g_world->player->position->v.e[1], g_world->player->position->v.e[2]));
+  Vector3F32* viewerPosition = Vector3F32_create(state, g_world->player->position->v.e[0], g_world->player->position->v.e[1], g_world->player->position->v.e[2]);
 
   Matrix4F32* projection = NULL;
   //projection = Matrix4R32_createOrthographic(state, -1.f, +1.f, -1.f, +1.f, -100.f, +100.f);
   projection = Matrix4F32_createPerspective(state, 90.f, canvasHeight > 0.f ? canvasWidth / canvasHeight : 16.f/9.f, 0.1f, 100.f);
-  Visuals_Program_bindMatrix4F32(state, g_program, "matrices.projection", projection);
-
-  Visuals_Program_bindInteger32(state, g_program, "currentNumberOfLights", 3);
-  // Define an ambient light source.
-  Visuals_Program_bindInteger32(state, g_program, "g_lights[0].type", 4);
-  Visuals_Program_bindVector3F32(state, g_program, "g_lights[0].color", Vector3F32_create(state, 0.2f, 0.2f, 0.2f));
-  // Define a directional diffuse light source.
-  Visuals_Program_bindInteger32(state, g_program, "g_lights[1].type", 8);
-  Visuals_Program_bindVector3F32(state, g_program, "g_lights[1].direction", Vector3F32_create(state, -1.f, -1.f, -1.f));
-  Visuals_Program_bindVector3F32(state, g_program, "g_lights[1].color", Vector3F32_create(state, 0.4f, 0.4f, 0.4f));
-  // Define a positional specular light source.
-  Visuals_Program_bindInteger32(state, g_program, "g_lights[2].type", 64);
-  Visuals_Program_bindVector3F32(state, g_program, "g_lights[2].direction", Vector3F32_create(state, -1.f, -1.f, -1.f));
-  Visuals_Program_bindVector3F32(state, g_program, "g_lights[2].color", Vector3F32_create(state, 0.8f, 0.8f, 0.8f));
-  Visuals_Program_bindVector3F32(state, g_program, "g_lights[2].position", Vector3F32_create(state, 0.f, 0.f, 0.f));
-
-  for (size_t i = 0, n = Shizu_List_getSize(state, g_world->geometries); i < n; ++i) {
-    Shizu_Value elementValue = Shizu_List_getValue(state, g_world->geometries, i);
-    StaticGeometry *element = (StaticGeometry*)Shizu_Value_getObject(&elementValue);
-    // Bind materials.
-    for (size_t i = 0, n = Shizu_List_getSize(state, element->materials); i < n; ++i) {
-      Shizu_Value elementValue = Shizu_List_getValue(state, element->materials, i);
-      Visuals_MaterialTechnique* element = (Visuals_MaterialTechnique*)Shizu_Value_getObject(&elementValue);
-      bindMaterial(state, visualsContext, g_program, element);
+
+  FramePacket_Camera camera;
+  camera.world = world;
+  camera.view = view;
+  camera.projection = projection;
+  camera.modelToProjection = Matrix4F32_multiply(state, projection, Matrix4F32_multiply(state, view, world));
+  for (size_t i = 0; i < 3; ++i) {
+    camera.viewerPosition[i] = viewerPosition->v.e[i];
+    camera.eye[i] = g_world->player->position->v.e[i] / g_worldScale[i];
+  }
+  FramePacket_setCamera(state, framePacket, &camera);
+}
+
+/// The arguments of prepareFramePacket.
+typedef struct PrepareContext {
+  Shizu_State2* state;
+  FramePacket* framePacket;
+} PrepareContext;
+
+/// Prepare a frame packet for its camera. A Visuals_Parallel_Callback.
+/// Does not access Shizu objects other than those of the frame packet and does not raise errors.
+static void prepareFramePacket(void* context, size_t index) {
+  PrepareContext* prepareContext = (PrepareContext*)context;
+  FramePacket_prepare(prepareContext->state, prepareContext->framePacket, g_pointLights, PointLightsX * PointLightsZ);
+}
+
+/// Draw a frame packet and present the frame.
+static void drawFramePacket(Shizu_State2* state, FramePacket* framePacket) {
+  Visuals_Context* visualsContext = Visuals_Service_createContext(state);
+
+  Shizu_Integer32 canvasWidth, canvasHeight;
+  Visuals_Service_getClientSize(state, &canvasWidth, &canvasHeight);
+  Visuals_Service_beginFrame(state);
+
+  // With dynamic resolution, the scene is rendered to the lower left part of the render buffer and upscaled to the window.
+  // The render buffer is sized for the maximal scale such that it is not resized when the scale changes.
+  Shizu_Float32 resolutionScale, maximumResolutionScale;
+  Visuals_BlitFilter upscaleFilter;
+  Shizu_Boolean dynamicResolution = Visuals_Service_getResolutionScale(state, &resolutionScale, &maximumResolutionScale, &upscaleFilter);
+  Shizu_Integer32 renderWidth = canvasWidth, renderHeight = canvasHeight;
+  Shizu_Float32 renderPart = 1.f;
+  if (dynamicResolution && canvasWidth > 0 && canvasHeight > 0) {
+    Shizu_Integer32 bufferWidth = (Shizu_Integer32)ceilf(canvasWidth * maximumResolutionScale);
+    Shizu_Integer32 bufferHeight = (Shizu_Integer32)ceilf(canvasHeight * maximumResolutionScale);
+    // Resize before binding: a resize rebinds the default frame buffer.
+    Visuals_RenderBuffer_resize(state, g_renderBuffer, bufferWidth, bufferHeight);
+    Visuals_Context_setRenderBuffer(state, visualsContext, g_renderBuffer);
+    renderPart = resolutionScale / maximumResolutionScale;
+    Visuals_Context_setViewport(state, visualsContext, 0.f, 0.f, renderPart, renderPart);
+    renderWidth = (Shizu_Integer32)(renderPart * bufferWidth);
+    renderHeight = (Shizu_Integer32)(renderPart * bufferHeight);
+  } else {
+    dynamicResolution = false;
+  }
+
+  Visuals_Context_clear(state, visualsContext, true, true);
+
+  // The uniform blocks were assigned to their binding points when the permutations were created.
+  // Only the contents of the uniform buffers are written per frame.
+  Visuals_Context_setUniformBuffer(state, visualsContext, Visuals_UniformBlockBinding_Materials, g_world->materialBuffer);
+
+  Visuals_LightClusters_upload(state, framePacket->lightClusters, g_lightClusterBuffers[0], g_lightClusterBuffers[1], g_lightClusterBuffers[2]);
+  Visuals_Context_setUniformBuffer(state, visualsContext, Visuals_UniformBlockBinding_ClusteredLights, g_lightClusterBuffers[0]);
+  Visuals_Context_setUniformBuffer(state, visualsContext, Visuals_UniformBlockBinding_ClusterGrid, g_lightClusterBuffers[1]);
+  Visuals_Context_setUniformBuffer(state, visualsContext, Visuals_UniformBlockBinding_ClusterIndices, g_lightClusterBuffers[2]);
+
+  // The matrices, the viewer, and the parameters of the clusters are written once per frame for all permutations.
+  Visuals_FrameBlock frame;
+  memcpy(frame.world, idlib_matrix_4x4_f32_get_data(&framePacket->world), sizeof(frame.world));
+  memcpy(frame.view, idlib_matrix_4x4_f32_get_data(&framePacket->view), sizeof(frame.view));
+  memcpy(frame.projection, idlib_matrix_4x4_f32_get_data(&framePacket->projection), sizeof(frame.projection));
+  memcpy(frame.viewerPosition, framePacket->viewerPosition, sizeof(Shizu_Float32) * 3);
+  frame.viewerPosition[3] = 0.f;
+  // The clusters are addressed by the window coordinates of the fragments, hence the size rendered to is passed.
+  Visuals_LightClusters_getParameters(state, framePacket->lightClusters, renderWidth > 0 ? renderWidth : 1, renderHeight > 0 ? renderHeight : 1, frame.clusterParameters);
+  frame.numberOfClusteredLights = (Shizu_Integer32)framePacket->lightClusters->numberOfLights;
+  memset(frame.padding, 0, sizeof(frame.padding));
+  Visuals_UniformBuffer_setData(state, g_frameBuffer, &frame, sizeof(frame));
+  Visuals_Context_setUniformBuffer(state, visualsContext, Visuals_UniformBlockBinding_Frame, g_frameBuffer);
+
+  // Only the lights modified since the last frame are written.
+  Visuals_LightSet_upload(state, g_lightSet, g_lightBuffer);
+  Visuals_Context_setUniformBuffer(state, visualsContext, Visuals_UniformBlockBinding_Lights, g_lightBuffer);
+  size_t numberOfLights = Visuals_LightSet_getNumberOfLights(state, g_lightSet);
+
+  Visuals_Service_beginGpuTiming(state, "pbr1");
+  for (size_t i = 0; i < framePacket->numberOfDraws; ++i) {
+    FrameDraw const* draw = &framePacket->draws[i];
+    StaticBatch* element = draw->batch;
+    // Select the permutation for the vertices and the light model.
+    uint32_t vertexSemantics = getVertexSemantics(state, element->vertexBuffer);
+    Visuals_Program* program = Visuals_getProgramPermutation(state, "pbr1", vertexSemantics, g_lightModel, numberOfLights);
+    if (Visuals_Program_isPending(state, program)) {
+      // Skip the batch until its permutation was compiled.
+      continue;
     }
-    // Bind vertices.
-    switch (element->vertexBuffer->flags) {
-      case (Visuals_VertexSemantics_PositionXyz | Visuals_VertexSyntactics_Float3): {
-        Visuals_Program_bindInteger32(state, g_program, "vertexDescriptor", Visuals_VertexSemantics_PositionXyz);
-      } break;
-      case (Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb | Visuals_VertexSyntactics_Float3_Float3_Float3): {
-        Visuals_Program_bindInteger32(state, g_program, "vertexDescriptor", Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb);
-      } break;
-      case (Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess | Visuals_VertexSyntactics_Float3_Float3_Float3_Float3_Float3_Float): {
-        Visuals_Program_bindInteger32(state, g_program, "vertexDescriptor", Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess);
-      } break;
-      default: {
-        fprintf(stderr, "%s:%d: unreachable code reached\n", __FILE__, __LINE__);
-        Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
-        Shizu_State2_jump(state);
-      } break;
-    };
-    Visuals_Context_render(state, visualsContext, element->vertexBuffer, g_program);
+    // The materials are read from the "Materials" uniform block by the material indices of the vertices.
+    Visuals_Context_renderRanges(state, visualsContext, element->vertexBuffer, framePacket->firsts + draw->firstRange, framePacket->counts + draw->firstRange, draw->numberOfRanges, program);
+  }
+  // The lamps of all point lights in one draw call.
+  {
+    uint32_t vertexSemantics = getVertexSemantics(state, g_lampVertexBuffer);
+    Visuals_Program* program = Visuals_getProgramPermutation(state, "pbr1", vertexSemantics, g_lightModel, numberOfLights);
+    if (!Visuals_Program_isPending(state, program)) {
+      Visuals_Context_renderInstanced(state, visualsContext, g_lampVertexBuffer, g_lampInstanceBuffer, PointLightsX * PointLightsZ, Visuals_PrimitiveType_TriangleStrip, program);
+    }
+  }
+  Visuals_Service_endGpuTiming(state);
+  Visuals_Service_addCullingStatistics(state, framePacket->numberOfVisibleGeometries, framePacket->numberOfCulledGeometries);
+
+  if (dynamicResolution) {
+    Visuals_Context_setRenderBuffer(state, visualsContext, NULL);
+    Visuals_Context_setViewport(state, visualsContext, 0.f, 0.f, 1.f, 1.f);
+    Visuals_Context_blitRenderBuffer(state, visualsContext, g_renderBuffer, renderPart, renderPart, upscaleFilter);
   }
 
   Visuals_Service_endFrame(state);
 }
 
+Shizu_Rendition_Export void
+Zeitgeist_Rendition_update
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{
+  Visuals_Service_update(state);
+  World_update(state, g_world, 200); /* TODO: Pass delta time. */
+
+  if (Visuals_Service_quitRequested(state)) {
+    Zeitgeist_UpstreamRequest* request = Zeitgeist_UpstreamRequest_createExitProcessRequest(state);
+    Zeitgeist_sendUpstreamRequest(state, request);
+  }
+
+  // Prepare the frame packet of this update on a thread of the pool while the frame packet of the previous update is drawn.
+  // The frame shown hence lags the simulation by one update.
+  PrepareContext prepareContext;
+  prepareContext.state = state;
+  prepareContext.framePacket = &g_framePackets[1 - g_currentFramePacket];
+  setCamera(state, prepareContext.framePacket);
+  Visuals_Parallel_Task* task = Visuals_Parallel_startTask(&prepareFramePacket, &prepareContext);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    drawFramePacket(state, &g_framePackets[g_currentFramePacket]);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Visuals_Parallel_joinTask(task);
+    Shizu_State2_jump(state);
+  }
+  Visuals_Parallel_joinTask(task);
+  g_currentFramePacket = 1 - g_currentFramePacket;
+}
+
 static void
 onKeyboardKeyMessage
   (
@@ -240,11 +393,11 @@ onKeyboardKeyMessage
   } else if (KeyboardKey_L == KeyboardKeyMessage_getKey(state, message)) {
     if (KeyboardKey_Action_Released == KeyboardKeyMessage_getAction(state, message)) {
       switch (g_lightModel) {
-        case LightModel_Phong: {
-          g_lightModel = LightModel_BlinnPhong;
+        case Visuals_LightModel_Phong: {
+          g_lightModel = Visuals_LightModel_BlinnPhong;
         } break;
         default: {
-          g_lightModel = LightModel_Phong;
+          g_lightModel = Visuals_LightModel_Phong;
         } break;
       }
     }
@@ -272,14 +425,72 @@ Zeitgeist_Rendition_load
   Shizu_JumpTarget jumpTarget;
   Shizu_State2_pushJumpTarget(state, &jumpTarget);
   if (!setjmp(jumpTarget.environment)) {
-    Visuals_Context* visualsContext = (Visuals_Context*)Visuals_Gl_Context_create(state);
-    Visuals_Program* program = Visuals_getProgram(state, "pbr1");
-    Visuals_Object_materialize(state, (Visuals_Object*)program);
-    Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)program);
-    g_program = program;
+    Visuals_Context* visualsContext = Visuals_Service_createContext(state);
     World* world = World_create(state, visualsContext);
     Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)world);
     g_world = world;
+    for (size_t i = 0; i < 2; ++i) {
+      FramePacket_initialize(state, &g_framePackets[i], world);
+    }
+    for (size_t i = 0; i < 3; ++i) {
+      Visuals_UniformBuffer* buffer = Visuals_Context_createUniformBuffer(state, visualsContext);
+      Visuals_Object_materialize(state, (Visuals_Object*)buffer);
+      Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)buffer);
+      g_lightClusterBuffers[i] = buffer;
+    }
+    Visuals_UniformBuffer* frameBuffer = Visuals_Context_createUniformBuffer(state, visualsContext);
+    Visuals_Object_materialize(state, (Visuals_Object*)frameBuffer);
+    Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)frameBuffer);
+    g_frameBuffer = frameBuffer;
+    // Place warm and cold point lights alternately below the ceiling.
+    for (size_t z = 0; z < PointLightsZ; ++z) {
+      for (size_t x = 0; x < PointLightsX; ++x) {
+        Visuals_PointLight* light = &g_pointLights[z * PointLightsX + x];
+        light->position[0] = -1.5f + 3.f * ((Shizu_Float32)x + 0.5f) / PointLightsX;
+        light->position[1] = 1.2f;
+        light->position[2] = -2.f + 4.f * ((Shizu_Float32)z + 0.5f) / PointLightsZ;
+        light->radius = 2.f;
+        Shizu_Boolean warm = (x + z) % 2 == 0;
+        light->color[0] = warm ? 0.4f : 0.2f;
+        light->color[1] = 0.3f;
+        light->color[2] = warm ? 0.2f : 0.4f;
+      }
+    }
+    createLamps(state, visualsContext);
+    // The first update draws the frame packet prepared here.
+    g_currentFramePacket = 0;
+    setCamera(state, &g_framePackets[0]);
+    FramePacket_prepare(state, &g_framePackets[0], g_pointLights, PointLightsX * PointLightsZ);
+    Visuals_LightSet* lightSet = Visuals_LightSet_create(state);
+    Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)lightSet);
+    g_lightSet = lightSet;
+    Visuals_UniformBuffer* lightBuffer = Visuals_Context_createUniformBuffer(state, visualsContext);
+    Visuals_Object_materialize(state, (Visuals_Object*)lightBuffer);
+    Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)lightBuffer);
+    g_lightBuffer = lightBuffer;
+    // An ambient light.
+    Visuals_Light* light = Visuals_Light_create(state, Visuals_LightType_Ambient);
+    Visuals_Light_setColor(state, light, 0.2f, 0.2f, 0.2f);
+    Visuals_LightSet_add(state, g_lightSet, light);
+    // A directional light.
+    light = Visuals_Light_create(state, Visuals_LightType_Directional);
+    Visuals_Light_setDirection(state, light, -1.f, -1.f, -1.f);
+    Visuals_Light_setColor(state, light, 0.4f, 0.4f, 0.4f);
+    Visuals_LightSet_add(state, g_lightSet, light);
+    // A point light at the origin.
+    light = Visuals_Light_create(state, Visuals_LightType_Point);
+    Visuals_Light_setPosition(state, light, 0.f, 0.f, 0.f);
+    Visuals_Light_setColor(state, light, 0.8f, 0.8f, 0.8f);
+    Visuals_LightSet_add(state, g_lightSet, light);
+    size_t numberOfLights = Visuals_LightSet_getNumberOfLights(state, g_lightSet);
+    // The permutations of the batches for both light models are compiled while the first frames are shown.
+    for (size_t i = 0, n = Shizu_List_getSize(state, g_world->batches); i < n; ++i) {
+      Shizu_Value elementValue = Shizu_List_getValue(state, g_world->batches, i);
+      StaticBatch* element = (StaticBatch*)Shizu_Value_getObject(&elementValue);
+      uint32_t vertexSemantics = getVertexSemantics(state, element->vertexBuffer);
+      Visuals_getProgramPermutation(state, "pbr1", vertexSemantics, Visuals_LightModel_Phong, numberOfLights);
+      Visuals_getProgramPermutation(state, "pbr1", vertexSemantics, Visuals_LightModel_BlinnPhong, numberOfLights);
+    }
     Visuals_RenderBuffer* renderBuffer = Visuals_Context_createRenderBuffer(state, visualsContext);
     Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)renderBuffer);
     g_renderBuffer = renderBuffer;
@@ -309,15 +520,37 @@ Zeitgeist_Rendition_load
       Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_renderBuffer);
       g_renderBuffer = NULL;
     }
+    for (size_t i = 0; i < 3; ++i) {
+      if (g_lightClusterBuffers[i]) {
+        Visuals_Object_unmaterialize(state, (Visuals_Object*)g_lightClusterBuffers[i]);
+        Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_lightClusterBuffers[i]);
+        g_lightClusterBuffers[i] = NULL;
+      }
+    }
+    if (g_frameBuffer) {
+      Visuals_Object_unmaterialize(state, (Visuals_Object*)g_frameBuffer);
+      Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_frameBuffer);
+      g_frameBuffer = NULL;
+    }
+    for (size_t i = 0; i < 2; ++i) {
+      if (g_framePackets[i].draws) {
+        FramePacket_uninitialize(state, &g_framePackets[i]);
+      }
+    }
+    destroyLamps(state);
+    if (g_lightBuffer) {
+      Visuals_Object_unmaterialize(state, (Visuals_Object*)g_lightBuffer);
+      Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_lightBuffer);
+      g_lightBuffer = NULL;
+    }
+    if (g_lightSet) {
+      Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_lightSet);
+      g_lightSet = NULL;
+    }
     if (g_world) {
       Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_world);
       g_world = NULL;
     }
-    if (g_program) {
-      Visuals_Object_unmaterialize(state, (Visuals_Object*)g_program);
-      Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_program);
-      g_program = NULL;
-    }
     Shizu_State2_jump(state);
   }
 }
@@ -331,31 +564,56 @@ Zeitgeist_Rendition_unload
     Shizu_Value* argumentValues
   )
 {
-  for (size_t i = 0, n = Shizu_List_getSize(state, g_world->geometries); i < n; ++i) {
-    Shizu_Value elementValue = Shizu_List_getValue(state, g_world->geometries, i);
-    StaticGeometry* element = (StaticGeometry*)Shizu_Value_getObject(&elementValue);
+  for (size_t i = 0, n = Shizu_List_getSize(state, g_world->batches); i < n; ++i) {
+    Shizu_Value elementValue = Shizu_List_getValue(state, g_world->batches, i);
+    StaticBatch* element = (StaticBatch*)Shizu_Value_getObject(&elementValue);
     Shizu_JumpTarget jumpTarget;
     Shizu_State2_pushJumpTarget(state, &jumpTarget);
     if (!setjmp(jumpTarget.environment)) {
-      StaticGeometry_unmaterialize(state, element);
+      StaticBatch_unmaterialize(state, element);
       Shizu_State2_popJumpTarget(state);
     } else {
       Shizu_State2_popJumpTarget(state);
     }
   }
+  if (g_world && g_world->materialBuffer) {
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)g_world->materialBuffer);
+  }
   if (g_renderBuffer) {
     Visuals_Object_unmaterialize(state, (Visuals_Object*)g_renderBuffer);
     Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_renderBuffer);
     g_renderBuffer = NULL;
   }
+  for (size_t i = 0; i < 3; ++i) {
+    if (g_lightClusterBuffers[i]) {
+      Visuals_Object_unmaterialize(state, (Visuals_Object*)g_lightClusterBuffers[i]);
+      Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_lightClusterBuffers[i]);
+      g_lightClusterBuffers[i] = NULL;
+    }
+  }
+  if (g_frameBuffer) {
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)g_frameBuffer);
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_frameBuffer);
+    g_frameBuffer = NULL;
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    if (g_framePackets[i].draws) {
+      FramePacket_uninitialize(state, &g_framePackets[i]);
+    }
+  }
+  destroyLamps(state);
+  if (g_lightBuffer) {
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)g_lightBuffer);
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_lightBuffer);
+    g_lightBuffer = NULL;
+  }
+  if (g_lightSet) {
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_lightSet);
+    g_lightSet = NULL;
+  }
   if (g_world) {
     Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_world);
     g_world = NULL;
   }
-  if (g_program) {
-    Visuals_Object_unmaterialize(state, (Visuals_Object*)g_program);
-    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)g_program);
-    g_program = NULL;
-  }
   Visuals_Service_shutdown(state);
 }
@@ -0,0 +1,316 @@
+#include "StaticBatch.h"
+
+// malloc, realloc, free
+#include <malloc.h>
+// memcpy
+#include <string.h>
+
+static void
+StaticBatch_finalize
+  (
+    Shizu_State2* state,
+    StaticBatch* self
+  );
+
+static void
+StaticBatch_visit
+  (
+    Shizu_State2* state,
+    StaticBatch* self
+  );
+
+static void
+StaticBatch_upload
+  (
+    Shizu_State2* state,
+    StaticBatch* self
+  );
+
+// Re-fetch the merged vertices of the batch if its vertex buffer is materialized again.
+// The vertices are merged again from the vertices of the geometries, the only CPU copy of them.
+static void
+StaticBatch_fetch
+  (
+    Shizu_State2* state,
+    Visuals_VertexBuffer* vertexBuffer,
+    void* context
+  )
+{ StaticBatch_upload(state, (StaticBatch*)context); }
+
+static StaticBatch*
+StaticBatch_create
+  (
+    Shizu_State2* state,
+    Visuals_Context* visualsContext,
+    uint16_t flags
+  );
+
+static void
+StaticBatch_append
+  (
+    Shizu_State2* state,
+    StaticBatch* self,
+    StaticGeometry* geometry
+  );
+
+static void
+StaticBatch_upload
+  (
+    Shizu_State2* state,
+    StaticBatch* self
+  );
+
+static Shizu_ObjectTypeDescriptor const StaticBatch_Type = {
+  .postCreateType = NULL,
+  .preDestroyType = NULL,
+  .visitType = NULL,
+  .size = sizeof(StaticBatch),
+  .finalize = (Shizu_OnFinalizeCallback*)&StaticBatch_finalize,
+  .visit = (Shizu_OnVisitCallback*)&StaticBatch_visit,
+  .dispatchSize = sizeof(StaticBatch_Dispatch),
+  .dispatchInitialize = NULL,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Zeitgeist.StaticBatch", StaticBatch, Shizu_Object);
+
+static void
+StaticBatch_finalize
+  (
+    Shizu_State2* state,
+    StaticBatch* self
+  )
+{
+  if (self->visibleCounts) {
+    free(self->visibleCounts);
+    self->visibleCounts = NULL;
+  }
+  if (self->visibleFirsts) {
+    free(self->visibleFirsts);
+    self->visibleFirsts = NULL;
+  }
+  if (self->visible) {
+    free(self->visible);
+    self->visible = NULL;
+  }
+  if (self->bounds) {
+    free(self->bounds);
+    self->bounds = NULL;
+  }
+  if (self->counts) {
+    free(self->counts);
+    self->counts = NULL;
+  }
+  if (self->firsts) {
+    free(self->firsts);
+    self->firsts = NULL;
+  }
+  self->numberOfRanges = 0;
+  self->geometries = NULL;
+  self->vertexBuffer = NULL;
+}
+
+static void
+StaticBatch_visit
+  (
+    Shizu_State2* state,
+    StaticBatch* self
+  )
+{
+  if (self->geometries) {
+    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->geometries);
+  }
+  if (self->vertexBuffer) {
+    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->vertexBuffer);
+  }
+}
+
+static StaticBatch*
+StaticBatch_create
+  (
+    Shizu_State2* state,
+    Visuals_Context* visualsContext,
+    uint16_t flags
+  )
+{
+  Shizu_Type* type = StaticBatch_getType(state);
+  StaticBatch* self = (StaticBatch*)Shizu_Gc_allocateObject(state, sizeof(StaticBatch));
+  self->geometries = NULL;
+  self->vertexBuffer = NULL;
+  self->flags = flags;
+  self->firsts = NULL;
+  self->counts = NULL;
+  self->numberOfRanges = 0;
+  self->bounds = NULL;
+  self->visible = NULL;
+  self->visibleFirsts = NULL;
+  self->visibleCounts = NULL;
+  ((Shizu_Object*)self)->type = type;
+  self->geometries = Shizu_Runtime_Extensions_createList(state);
+  self->vertexBuffer = Visuals_Context_createVertexBuffer(state, visualsContext);
+  // The merged vertices can be recomputed from the geometries: Do not keep a second copy of them.
+  Visuals_VertexBuffer_setRetention(state, self->vertexBuffer, Visuals_VertexBufferRetention_Refetch);
+  Visuals_VertexBuffer_setFetchCallback(state, self->vertexBuffer, &StaticBatch_fetch, self);
+  Visuals_Object_materialize(state, (Visuals_Object*)self->vertexBuffer);
+  return self;
+}
+
+static void
+StaticBatch_append
+  (
+    Shizu_State2* state,
+    StaticBatch* self,
+    StaticGeometry* geometry
+  )
+{
+  Shizu_Integer32* firsts = realloc(self->firsts, sizeof(Shizu_Integer32) * (self->numberOfRanges + 1));
+  if (!firsts) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  self->firsts = firsts;
+  Shizu_Integer32* counts = realloc(self->counts, sizeof(Shizu_Integer32) * (self->numberOfRanges + 1));
+  if (!counts) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  self->counts = counts;
+  Visuals_Aabb* bounds = realloc(self->bounds, sizeof(Visuals_Aabb) * (self->numberOfRanges + 1));
+  if (!bounds) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  self->bounds = bounds;
+  uint8_t* visible = realloc(self->visible, sizeof(uint8_t) * (self->numberOfRanges + 1));
+  if (!visible) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  self->visible = visible;
+  Shizu_Integer32* visibleFirsts = realloc(self->visibleFirsts, sizeof(Shizu_Integer32) * (self->numberOfRanges + 1));
+  if (!visibleFirsts) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  self->visibleFirsts = visibleFirsts;
+  Shizu_Integer32* visibleCounts = realloc(self->visibleCounts, sizeof(Shizu_Integer32) * (self->numberOfRanges + 1));
+  if (!visibleCounts) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  self->visibleCounts = visibleCounts;
+  Shizu_List_appendObject(state, self->geometries, (Shizu_Object*)geometry);
+  self->bounds[self->numberOfRanges] = geometry->bounds;
+  self->firsts[self->numberOfRanges] = self->numberOfRanges > 0 ? self->firsts[self->numberOfRanges - 1] + self->counts[self->numberOfRanges - 1] : 0;
+  self->counts[self->numberOfRanges] = (Shizu_Integer32)geometry->numberOfVertices;
+  self->numberOfRanges++;
+}
+
+static void
+StaticBatch_upload
+  (
+    Shizu_State2* state,
+    StaticBatch* self
+  )
+{
+  size_t numberOfBytes = 0;
+  for (size_t i = 0, n = Shizu_List_getSize(state, self->geometries); i < n; ++i) {
+    Shizu_Value elementValue = Shizu_List_getValue(state, self->geometries, i);
+    StaticGeometry* element = (StaticGeometry*)Shizu_Value_getObject(&elementValue);
+    numberOfBytes += element->numberOfBytes;
+  }
+  char* bytes = malloc(numberOfBytes > 0 ? numberOfBytes : 1);
+  if (!bytes) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    size_t offset = 0;
+    for (size_t i = 0, n = Shizu_List_getSize(state, self->geometries); i < n; ++i) {
+      Shizu_Value elementValue = Shizu_List_getValue(state, self->geometries, i);
+      StaticGeometry* element = (StaticGeometry*)Shizu_Value_getObject(&elementValue);
+      memcpy(bytes + offset, element->bytes, element->numberOfBytes);
+      offset += element->numberOfBytes;
+    }
+    // The vertex buffer takes ownership of the merged vertices.
+    Visuals_VertexBuffer_adoptData(state, self->vertexBuffer, self->flags, bytes, numberOfBytes);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    free(bytes);
+    bytes = NULL;
+    Shizu_State2_jump(state);
+  }
+  bytes = NULL;
+}
+
+size_t
+StaticBatch_cull
+  (
+    Shizu_State2* state,
+    StaticBatch* self,
+    Visuals_Frustum const* frustum
+  )
+{
+  Visuals_Frustum_cullBoxes(state, frustum, self->bounds, self->numberOfRanges, self->visible);
+  size_t numberOfVisibleRanges = 0;
+  for (size_t i = 0; i < self->numberOfRanges; ++i) {
+    if (self->visible[i]) {
+      self->visibleFirsts[numberOfVisibleRanges] = self->firsts[i];
+      self->visibleCounts[numberOfVisibleRanges] = self->counts[i];
+      numberOfVisibleRanges++;
+    }
+  }
+  return numberOfVisibleRanges;
+}
+
+void
+StaticBatch_unmaterialize
+  (
+    Shizu_State2* state,
+    StaticBatch* self
+  )
+{
+  if (self->vertexBuffer) {
+    Visuals_Object_unmaterialize(state, (Visuals_Object*)self->vertexBuffer);
+  }
+}
+
+Shizu_List*
+StaticBatch_build
+  (
+    Shizu_State2* state,
+    Visuals_Context* visualsContext,
+    Shizu_List* geometries
+  )
+{
+  Shizu_List* batches = Shizu_Runtime_Extensions_createList(state);
+  // Assign the geometries to batches.
+  for (size_t i = 0, n = Shizu_List_getSize(state, geometries); i < n; ++i) {
+    Shizu_Value elementValue = Shizu_List_getValue(state, geometries, i);
+    StaticGeometry* element = (StaticGeometry*)Shizu_Value_getObject(&elementValue);
+    StaticBatch* batch = NULL;
+    for (size_t j = 0, m = Shizu_List_getSize(state, batches); j < m; ++j) {
+      Shizu_Value batchValue = Shizu_List_getValue(state, batches, j);
+      StaticBatch* candidate = (StaticBatch*)Shizu_Value_getObject(&batchValue);
+      if (candidate->flags == element->vertexFlags) {
+        batch = candidate;
+        break;
+      }
+    }
+    if (!batch) {
+      batch = StaticBatch_create(state, visualsContext, element->vertexFlags);
+      Shizu_List_appendObject(state, batches, (Shizu_Object*)batch);
+    }
+    StaticBatch_append(state, batch, element);
+  }
+  // Upload the merged vertices of each batch.
+  for (size_t i = 0, n = Shizu_List_getSize(state, batches); i < n; ++i) {
+    Shizu_Value elementValue = Shizu_List_getValue(state, batches, i);
+    StaticBatch* element = (StaticBatch*)Shizu_Value_getObject(&elementValue);
+    StaticBatch_upload(state, element);
+  }
+  return batches;
+}
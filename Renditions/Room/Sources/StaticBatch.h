@@ -0,0 +1,90 @@
+#if !defined(STATICBATCH_H_INCLUDED)
+#define STATICBATCH_H_INCLUDED
+
+#include "World.h"
+
+/// @since 2.0
+/// @brief
+/// A set of static geometries merged into a single vertex buffer.
+/// @details
+/// All geometries of a batch share the same vertex format.
+/// The materials are not a property of the batch: the vertices carry material indices into World.materialBuffer.
+/// The vertices of the i-th geometry of the batch are the vertices [firsts[i], firsts[i] + counts[i]) of the vertex buffer.
+/// Each of these sub-ranges is a triangle strip.
+/// A batch is rendered by a single call to Visuals_Context_renderRanges.
+/// The vertex buffer does not retain the merged vertices, they are merged again from the geometries when needed.
+Shizu_declareObjectType(StaticBatch)
+
+struct StaticBatch_Dispatch {
+  Shizu_Object_Dispatch _parent;
+};
+
+struct StaticBatch {
+  Shizu_Object parent;
+
+  /// @brief
+  /// A pointer to the list of StaticGeometry objects merged into this batch. Must not be null.
+  Shizu_List* geometries;
+
+  /// @brief The vertex buffer.
+  Visuals_VertexBuffer* vertexBuffer;
+
+  /// @brief The vertex format shared by all geometries of this batch.
+  uint16_t flags;
+
+  /// @brief A pointer to an array of @a numberOfRanges indices of the first vertices of the sub-ranges.
+  Shizu_Integer32* firsts;
+
+  /// @brief A pointer to an array of @a numberOfRanges numbers of vertices of the sub-ranges.
+  Shizu_Integer32* counts;
+
+  /// @brief The number of sub-ranges.
+  size_t numberOfRanges;
+
+  /// @brief A pointer to an array of @a numberOfRanges bounding boxes of the sub-ranges.
+  /// The boxes are contiguous such that they are tested against a view frustum in a single pass.
+  Visuals_Aabb* bounds;
+
+  /// @brief A pointer to an array of @a numberOfRanges flags. Flag i is 1 if sub-range i is possibly visible.
+  uint8_t* visible;
+
+  /// @brief Pointers to arrays of @a numberOfRanges elements receiving the possibly visible sub-ranges.
+  Shizu_Integer32* visibleFirsts, * visibleCounts;
+};
+
+void
+StaticBatch_unmaterialize
+  (
+    Shizu_State2* state,
+    StaticBatch* self
+  );
+
+/// @brief Cull the sub-ranges of this batch against a view frustum.
+/// @param state A pointer to the state.
+/// @param self A pointer to this batch.
+/// @param frustum A pointer to the view frustum in the coordinate system of the vertices.
+/// @return The number of possibly visible sub-ranges.
+/// These are stored in @a visibleFirsts and @a visibleCounts.
+size_t
+StaticBatch_cull
+  (
+    Shizu_State2* state,
+    StaticBatch* self,
+    Visuals_Frustum const* frustum
+  );
+
+/// @brief Merge static geometries into static batches.
+/// @param state A pointer to the state.
+/// @param visualsContext A pointer to the visuals context.
+/// @param geometries A pointer to a list of StaticGeometry objects.
+/// @return A pointer to a list of StaticBatch objects.
+/// Geometries which share the same vertex format are merged into the same batch.
+Shizu_List*
+StaticBatch_build
+  (
+    Shizu_State2* state,
+    Visuals_Context* visualsContext,
+    Shizu_List* geometries
+  );
+
+#endif // STATICBATCH_H_INCLUDED
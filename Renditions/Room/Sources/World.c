@@ -1,11 +1,15 @@
 #include "World.h"
 
-#include "Visuals/BlinnPhongMaterialTechnique.h"
 #include "Visuals/Context.h"
-#include "Visuals/PhongMaterialTechnique.h"
 #include "Visuals/VertexBuffer.h"
 
 #include "Loader.h"
+#include "StaticBatch.h"
+
+// realloc, free
+#include <malloc.h>
+// memcpy
+#include <string.h>
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
@@ -83,20 +87,13 @@ StaticGeometry_finalize
     StaticGeometry* self
   );
 
-static void
-StaticGeometry_visit
-  (
-    Shizu_State2* state,
-    StaticGeometry* self
-  );
-
 static Shizu_ObjectTypeDescriptor const StaticGeometryGl_Type = {
   .postCreateType = NULL,
   .preDestroyType = NULL,
   .visitType = NULL,
   .size = sizeof(StaticGeometry),
   .finalize = (Shizu_OnFinalizeCallback*)&StaticGeometry_finalize,
-  .visit = (Shizu_OnVisitCallback*)&StaticGeometry_visit,
+  .visit = NULL,
   .dispatchSize = sizeof(StaticGeometry_Dispatch),
   .dispatchInitialize = NULL,
   .dispatchUninitialize = NULL,
@@ -111,58 +108,26 @@ StaticGeometry_finalize
     StaticGeometry* self
   )
 {
-  self->materials = NULL;
-  self->vertexBuffer = NULL;
-}
-
-static void
-StaticGeometry_visit
-  (
-    Shizu_State2* state,
-    StaticGeometry* self
-  )
-{
-  if (self->materials) {
-    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->materials);
-  }
-  if (self->vertexBuffer) {
-    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->vertexBuffer);
-  }
-}
-
-void
-StaticGeometry_unmaterialize
-  (
-    Shizu_State2* state,
-    StaticGeometry* self
-  )
-{
-  for (size_t i = 0, n = Shizu_List_getSize(state, self->materials); i < n; ++i) {
-    Shizu_Value element = Shizu_List_getValue(state, self->materials, i);
-    Visuals_Object_unmaterialize(state, (Visuals_Object*)Shizu_Value_getObject(&element));
-  }
-  if (self->vertexBuffer) {
-    Visuals_Object_unmaterialize(state, (Visuals_Object*)self->vertexBuffer);
+  if (self->bytes) {
+    free(self->bytes);
+    self->bytes = NULL;
   }
+  self->numberOfBytes = 0;
 }
 
 StaticGeometry*
 StaticGeometry_create
   (
-    Shizu_State2* state,
-    Visuals_Context* visualsContext
+    Shizu_State2* state
   )
 {
   Shizu_Type* type = StaticGeometryGl_getType(state);
   StaticGeometry* self = (StaticGeometry*)Shizu_Gc_allocateObject(state, sizeof(StaticGeometry));
-  self->vertexBuffer = (Visuals_VertexBuffer*)Visuals_Context_createVertexBuffer(state, visualsContext);
-  self->materials = Shizu_Runtime_Extensions_createList(state);
-  {
-    Shizu_List_appendObject(state, self->materials, (Shizu_Object*)Visuals_PhongMaterialTechnique_create(state));
-    Shizu_List_appendObject(state, self->materials, (Shizu_Object*)Visuals_BlinnPhongMaterialTechnique_create(state));
-  }
+  self->vertexFlags = 0;
+  self->bytes = NULL;
+  self->numberOfBytes = 0;
   self->numberOfVertices = 0;
-  Visuals_Object_materialize(state, (Visuals_Object*)self->vertexBuffer);
+  Visuals_Aabb_fromPositions(&self->bounds, NULL, 0, 0);
   ((Shizu_Object*)self)->type = type;
   return self;
 }
@@ -172,14 +137,23 @@ StaticGeometry_setData
   (
     Shizu_State2* state,
     StaticGeometry* self,
-    uint8_t flags,
+    uint16_t flags,
     size_t numberOfVertices,
     size_t numberOfBytes,
     void const* bytes
   )
 {
-  Visuals_VertexBuffer_setData(state, self->vertexBuffer, flags, bytes, numberOfBytes);
+  void* newBytes = realloc(self->bytes, numberOfBytes > 0 ? numberOfBytes : 1);
+  if (!newBytes) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  memcpy(newBytes, bytes, numberOfBytes);
+  self->bytes = newBytes;
+  self->numberOfBytes = numberOfBytes;
+  self->vertexFlags = flags;
   self->numberOfVertices = numberOfVertices;
+  Visuals_Aabb_fromPositions(&self->bounds, bytes, numberOfVertices, numberOfVertices > 0 ? numberOfBytes / numberOfVertices : 0);
 }
 
 struct VERTEX {
@@ -240,6 +214,38 @@ struct VERTEX {
 
 #endif
 
+struct COMPACT_VERTEX {
+  idlib_vector_3_f32 position;
+  uint32_t normal;
+  uint16_t materialIndex;
+  uint16_t padding;
+};
+
+// Convert the vertices into the compact vertex format and set the vertex data.
+// The material of the vertices is replaced by the material at index 0 of World.materialBuffer.
+static void
+StaticGeometry_setDataCompact
+  (
+    Shizu_State2* state,
+    StaticGeometry* self,
+    size_t numberOfVertices,
+    struct VERTEX const* vertices
+  )
+{
+  struct COMPACT_VERTEX compactVertices[4];
+  if (numberOfVertices > sizeof(compactVertices) / sizeof(struct COMPACT_VERTEX)) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  for (size_t i = 0; i < numberOfVertices; ++i) {
+    compactVertices[i].position = vertices[i].position;
+    compactVertices[i].normal = Visuals_packNormal(vertices[i].normal.e[0], vertices[i].normal.e[1], vertices[i].normal.e[2]);
+    compactVertices[i].materialIndex = 0;
+    compactVertices[i].padding = 0;
+  }
+  StaticGeometry_setData(state, self, Visuals_VertexSemantics_PositionXyz_NormalXyz_MaterialIndex | Visuals_VertexSyntactics_Float3_Int2101010_UInt16, numberOfVertices, sizeof(struct COMPACT_VERTEX) * numberOfVertices, compactVertices);
+}
+
 void
 StaticGeometry_setDataNorthWall
   (
@@ -274,7 +280,7 @@ StaticGeometry_setDataNorthWall
   debugCheckNormal(state, &vertices[0], &n);
 
   size_t numberOfVertices = sizeof(vertices) / sizeof(struct VERTEX);
-  StaticGeometry_setData(state, self, Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess | Visuals_VertexSyntactics_Float3_Float3_Float3_Float3_Float3_Float, numberOfVertices, sizeof(vertices), vertices);
+  StaticGeometry_setDataCompact(state, self, numberOfVertices, vertices);
   self->flags = NORTH_WALL;
 }
 
@@ -312,7 +318,7 @@ StaticGeometry_setDataSouthWall
   debugCheckNormal(state, &vertices[0], &n);
 
   size_t numberOfVertices = sizeof(vertices) / sizeof(struct VERTEX);
-  StaticGeometry_setData(state, self, Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess | Visuals_VertexSyntactics_Float3_Float3_Float3_Float3_Float3_Float, numberOfVertices, sizeof(vertices), vertices);
+  StaticGeometry_setDataCompact(state, self, numberOfVertices, vertices);
   self->flags = SOUTH_WALL;
 }
 
@@ -350,7 +356,7 @@ StaticGeometry_setDataEastWall
   debugCheckNormal(state, &vertices[0], &n);
 
   size_t numberOfVertices = sizeof(vertices) / sizeof(struct VERTEX);
-  StaticGeometry_setData(state, self, Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess | Visuals_VertexSyntactics_Float3_Float3_Float3_Float3_Float3_Float, numberOfVertices, sizeof(vertices), vertices);
+  StaticGeometry_setDataCompact(state, self, numberOfVertices, vertices);
   self->flags = EAST_WALL;
 }
 
@@ -388,7 +394,7 @@ StaticGeometry_setDataWestWall
   debugCheckNormal(state, &vertices[0], &n);
 
   size_t numberOfVertices = sizeof(vertices) / sizeof(struct VERTEX);
-  StaticGeometry_setData(state, self, Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess | Visuals_VertexSyntactics_Float3_Float3_Float3_Float3_Float3_Float, numberOfVertices, sizeof(vertices), vertices);
+  StaticGeometry_setDataCompact(state, self, numberOfVertices, vertices);
   self->flags = WEST_WALL;
 }
 
@@ -426,7 +432,7 @@ StaticGeometry_setDataFloor
   debugCheckNormal(state, &vertices[0], &n);
 
   size_t numberOfVertices = sizeof(vertices) / sizeof(struct VERTEX);
-  StaticGeometry_setData(state, self, Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess | Visuals_VertexSyntactics_Float3_Float3_Float3_Float3_Float3_Float, numberOfVertices, sizeof(vertices), vertices);
+  StaticGeometry_setDataCompact(state, self, numberOfVertices, vertices);
   self->flags = FLOOR;
 }
 
@@ -464,10 +470,126 @@ StaticGeometry_setDataCeiling
   debugCheckNormal(state, &vertices[0], &n);
 
   size_t numberOfVertices = sizeof(vertices) / sizeof(struct VERTEX);
-  StaticGeometry_setData(state, self, Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess | Visuals_VertexSyntactics_Float3_Float3_Float3_Float3_Float3_Float, numberOfVertices, sizeof(vertices), vertices);
+  StaticGeometry_setDataCompact(state, self, numberOfVertices, vertices);
   self->flags = CEILING;
 }
 
+// The rooms of the building are a grid of RoomsX x RoomsZ rooms centered on the origin.
+// Room x + z * RoomsX is the x-th room from the west and the z-th room from the north.
+#define RoomsX (3)
+#define RoomsZ (3)
+
+// The extends of a room along the x-axis, the z-axis, and the y-axis in metres.
+#define RoomBreadth (5.f)
+#define RoomLength (5.f)
+#define RoomHeight (4.f)
+
+// The extends of a doorway along its wall and along the y-axis in metres.
+#define DoorwayBreadth (1.2f)
+#define DoorwayHeight (2.5f)
+
+// The pairs of rooms connected by doorways.
+// The rooms of a pair are neighbours and the first room is west or north of the second room.
+static const size_t g_doorways[][2] = {
+  { 0, 1 }, { 1, 2 }, { 2, 5 }, { 4, 5 }, { 3, 4 }, { 3, 6 }, { 6, 7 }, { 7, 8 },
+};
+
+static Shizu_Float32
+getRoomCenterX
+  (
+    size_t x
+  )
+{
+  return ((Shizu_Float32)x - (Shizu_Float32)(RoomsX - 1) / 2.f) * RoomBreadth;
+}
+
+static Shizu_Float32
+getRoomCenterZ
+  (
+    size_t z
+  )
+{
+  return ((Shizu_Float32)z - (Shizu_Float32)(RoomsZ - 1) / 2.f) * RoomLength;
+}
+
+static bool
+hasDoorway
+  (
+    size_t a,
+    size_t b
+  )
+{
+  for (size_t i = 0; i < sizeof(g_doorways) / sizeof(g_doorways[0]); ++i) {
+    if (g_doorways[i][0] == a && g_doorways[i][1] == b) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void
+addWallSegment
+  (
+    Shizu_State2* state,
+    Cell* cell,
+    uint8_t wall,
+    Shizu_Float32 x,
+    Shizu_Float32 y,
+    Shizu_Float32 z,
+    Shizu_Float32 breadth,
+    Shizu_Float32 height
+  )
+{
+  StaticGeometry* geometry = StaticGeometry_create(state);
+  Vector3F32* translation = Vector3F32_create(state, x, y, z);
+  switch (wall) {
+    case WEST_WALL: {
+      StaticGeometry_setDataWestWall(state, geometry, translation, breadth, height);
+    } break;
+    case NORTH_WALL: {
+      StaticGeometry_setDataNorthWall(state, geometry, translation, breadth, height);
+    } break;
+    case EAST_WALL: {
+      StaticGeometry_setDataEastWall(state, geometry, translation, breadth, height);
+    } break;
+    case SOUTH_WALL: {
+      StaticGeometry_setDataSouthWall(state, geometry, translation, breadth, height);
+    } break;
+    default: {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    } break;
+  }
+  Shizu_List_appendObject(state, cell->geometries, (Shizu_Object*)geometry);
+}
+
+// Add a wall of a room centered on (x, z).
+// A wall with a doorway is composed of the parts left and right of the doorway and the part above the doorway.
+static void
+addWall
+  (
+    Shizu_State2* state,
+    Cell* cell,
+    uint8_t wall,
+    Shizu_Float32 x,
+    Shizu_Float32 z,
+    Shizu_Float32 breadth,
+    bool doorway
+  )
+{
+  if (!doorway) {
+    addWallSegment(state, cell, wall, x, 0.f, z, breadth, RoomHeight);
+    return;
+  }
+  // The direction along the wall.
+  Shizu_Float32 dx = (wall == NORTH_WALL || wall == SOUTH_WALL) ? 1.f : 0.f, dz = 1.f - dx;
+  Shizu_Float32 sideBreadth = (breadth - DoorwayBreadth) / 2.f, sideOffset = (breadth + DoorwayBreadth) / 4.f;
+  addWallSegment(state, cell, wall, x - dx * sideOffset, 0.f, z - dz * sideOffset, sideBreadth, RoomHeight);
+  addWallSegment(state, cell, wall, x + dx * sideOffset, 0.f, z + dz * sideOffset, sideBreadth, RoomHeight);
+  Shizu_Float32 lintelHeight = RoomHeight - DoorwayHeight;
+  addWallSegment(state, cell, wall, x, -RoomHeight / 2.f + DoorwayHeight + lintelHeight / 2.f, z, DoorwayBreadth, lintelHeight);
+}
+
 static void
 World_visit
   (
@@ -499,6 +621,15 @@ World_visit
   if (self->geometries) {
     Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->geometries);
   }
+  if (self->batches) {
+    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->batches);
+  }
+  if (self->building) {
+    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->building);
+  }
+  if (self->materialBuffer) {
+    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->materialBuffer);
+  }
   if (self->player) {
     Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->player);
   }
@@ -515,18 +646,12 @@ World_create
   World* self = (World*)Shizu_Gc_allocateObject(state, sizeof(World));
   self->player = NULL;
   self->geometries = NULL;
+  self->batches = NULL;
+  self->building = NULL;
+  self->materialBuffer = NULL;
 
   self->geometries = Shizu_Runtime_Extensions_createList(state);
 
-  StaticGeometry* geometry = NULL;
-
-  // Extend along the x-axis in metres.
-  static const Shizu_Float32 breadth = 5.f;
-  // Extend along the z-axis in metres.
-  static const Shizu_Float32 length = 5.f;
-  // Extend along the y-axis in metres.
-  static const Shizu_Float32 height = 4.f;
-
   Reader reader = { 
     .file = { 
       .path = NULL,
@@ -583,29 +708,99 @@ World_create
 
 
 
-  geometry = StaticGeometry_create(state, visualsContext);
-  StaticGeometry_setDataFloor(state, geometry, Vector3F32_create(state, 0.f, -height / 2.f, 0.f), breadth, length);
-  Shizu_List_appendObject(state, self->geometries, (Shizu_Object*)geometry);
-
-  geometry = StaticGeometry_create(state, visualsContext);
-  StaticGeometry_setDataCeiling(state, geometry, Vector3F32_create(state, 0.f, +height / 2.f, 0.f), breadth, length);
-  Shizu_List_appendObject(state, self->geometries, (Shizu_Object*)geometry);
-
-  geometry = StaticGeometry_create(state, visualsContext);
-  StaticGeometry_setDataWestWall(state, geometry, Vector3F32_create(state, -breadth / 2.f, 0.f, 0.f), length, height);
-  Shizu_List_appendObject(state, self->geometries, (Shizu_Object*)geometry);
-
-  geometry = StaticGeometry_create(state, visualsContext);
-  StaticGeometry_setDataNorthWall(state, geometry, Vector3F32_create(state, 0.f, 0.f, -length / 2.f), breadth, height);
-  Shizu_List_appendObject(state, self->geometries, (Shizu_Object*)geometry);
-
-  geometry = StaticGeometry_create(state, visualsContext);
-  StaticGeometry_setDataEastWall(state, geometry, Vector3F32_create(state, +breadth / 2.f, 0.f, 0.f), length, height);
-  Shizu_List_appendObject(state, self->geometries, (Shizu_Object*)geometry);
-
-  geometry = StaticGeometry_create(state, visualsContext);
-  StaticGeometry_setDataSouthWall(state, geometry, Vector3F32_create(state, 0.f, 0.f, +length / 2.f), breadth, height);
-  Shizu_List_appendObject(state, self->geometries, (Shizu_Object*)geometry);
+  self->building = Building_create(state);
+  self->batches = Shizu_Runtime_Extensions_createList(state);
+  for (size_t z = 0; z < RoomsZ; ++z) {
+    for (size_t x = 0; x < RoomsX; ++x) {
+      size_t room = z * RoomsX + x;
+      Shizu_Float32 centerX = getRoomCenterX(x), centerZ = getRoomCenterZ(z);
+      Visuals_Aabb bounds = {
+        .minimum = { centerX - RoomBreadth / 2.f, -RoomHeight / 2.f, centerZ - RoomLength / 2.f },
+        .maximum = { centerX + RoomBreadth / 2.f, +RoomHeight / 2.f, centerZ + RoomLength / 2.f },
+      };
+      Cell* cell = Building_addCell(state, self->building, &bounds);
+
+      StaticGeometry* geometry = NULL;
+
+      geometry = StaticGeometry_create(state);
+      StaticGeometry_setDataFloor(state, geometry, Vector3F32_create(state, centerX, -RoomHeight / 2.f, centerZ), RoomBreadth, RoomLength);
+      Shizu_List_appendObject(state, cell->geometries, (Shizu_Object*)geometry);
+
+      geometry = StaticGeometry_create(state);
+      StaticGeometry_setDataCeiling(state, geometry, Vector3F32_create(state, centerX, +RoomHeight / 2.f, centerZ), RoomBreadth, RoomLength);
+      Shizu_List_appendObject(state, cell->geometries, (Shizu_Object*)geometry);
+
+      addWall(state, cell, WEST_WALL, centerX - RoomBreadth / 2.f, centerZ, RoomLength,
+              x > 0 && hasDoorway(room - 1, room));
+      addWall(state, cell, NORTH_WALL, centerX, centerZ - RoomLength / 2.f, RoomBreadth,
+              z > 0 && hasDoorway(room - RoomsX, room));
+      addWall(state, cell, EAST_WALL, centerX + RoomBreadth / 2.f, centerZ, RoomLength,
+              x + 1 < RoomsX && hasDoorway(room, room + 1));
+      addWall(state, cell, SOUTH_WALL, centerX, centerZ + RoomLength / 2.f, RoomBreadth,
+              z + 1 < RoomsZ && hasDoorway(room, room + RoomsX));
+
+      // Merge the geometries of each room separately such that rooms which are not visible are skipped entirely.
+      cell->batches = StaticBatch_build(state, visualsContext, cell->geometries);
+      for (size_t i = 0, n = Shizu_List_getSize(state, cell->geometries); i < n; ++i) {
+        Shizu_Value elementValue = Shizu_List_getValue(state, cell->geometries, i);
+        Shizu_List_appendValue(state, self->geometries, &elementValue);
+      }
+      for (size_t i = 0, n = Shizu_List_getSize(state, cell->batches); i < n; ++i) {
+        Shizu_Value elementValue = Shizu_List_getValue(state, cell->batches, i);
+        Shizu_List_appendValue(state, self->batches, &elementValue);
+      }
+    }
+  }
+  for (size_t i = 0; i < sizeof(g_doorways) / sizeof(g_doorways[0]); ++i) {
+    size_t a = g_doorways[i][0], b = g_doorways[i][1];
+    Shizu_Float32 floor = -RoomHeight / 2.f, top = -RoomHeight / 2.f + DoorwayHeight;
+    Shizu_Float32 corners[4][3];
+    if (b == a + 1) {
+      // A doorway in the east wall of room a.
+      Shizu_Float32 x = getRoomCenterX(a % RoomsX) + RoomBreadth / 2.f, z = getRoomCenterZ(a / RoomsX);
+      Shizu_Float32 const c[4][3] = {
+        { x, floor, z - DoorwayBreadth / 2.f }, { x, floor, z + DoorwayBreadth / 2.f },
+        { x, top, z + DoorwayBreadth / 2.f }, { x, top, z - DoorwayBreadth / 2.f },
+      };
+      memcpy(corners, c, sizeof(corners));
+    } else {
+      // A doorway in the south wall of room a.
+      Shizu_Float32 x = getRoomCenterX(a % RoomsX), z = getRoomCenterZ(a / RoomsX) + RoomLength / 2.f;
+      Shizu_Float32 const c[4][3] = {
+        { x - DoorwayBreadth / 2.f, floor, z }, { x + DoorwayBreadth / 2.f, floor, z },
+        { x + DoorwayBreadth / 2.f, top, z }, { x - DoorwayBreadth / 2.f, top, z },
+      };
+      memcpy(corners, c, sizeof(corners));
+    }
+    Building_addPortal(state, self->building, a, b, corners);
+  }
+  // The layout of the building is static.
+  Building_computePvs(state, self->building);
+
+  // The materials in the std140 layout of the "Materials" uniform block.
+  // A material consists of a PhongInfo and a BlinnPhongInfo of 12 floats each:
+  // ambient (3 floats, 1 float padding), diffuse (3 floats, 1 float padding), specular (3 floats), and shininess (1 float).
+  static const Shizu_Float32 materials[] = {
+    // material 0: phong
+    0.3f, 0.3f, 0.3f, 0.f,
+    0.3f, 0.3f, 0.3f, 0.f,
+    0.3f, 0.3f, 0.3f, 0.9f,
+    // material 0: blinn-phong
+    0.3f, 0.3f, 0.3f, 0.f,
+    0.3f, 0.3f, 0.3f, 0.f,
+    0.3f, 0.3f, 0.3f, 0.9f,
+    // material 1: phong
+    1.0f, 1.0f, 0.9f, 0.f,
+    0.2f, 0.2f, 0.2f, 0.f,
+    0.0f, 0.0f, 0.0f, 0.9f,
+    // material 1: blinn-phong
+    1.0f, 1.0f, 0.9f, 0.f,
+    0.2f, 0.2f, 0.2f, 0.f,
+    0.0f, 0.0f, 0.0f, 0.9f,
+  };
+  self->materialBuffer = Visuals_Context_createUniformBuffer(state, visualsContext);
+  Visuals_Object_materialize(state, (Visuals_Object*)self->materialBuffer);
+  Visuals_UniformBuffer_setData(state, self->materialBuffer, materials, sizeof(materials));
 
   self->player = Player_create(state);
 
@@ -1,10 +1,13 @@
 #if !defined(WORLD_H_INCLUDED)
 #define WORLD_H_INCLUDED
 
+#include "Building.h"
 #include "Player.h"
 #include "Vector3F32.h"
 #include "Visuals/Context.h"
+#include "Visuals/Frustum.h"
 #include "Visuals/Texture.h"
+#include "Visuals/UniformBuffer.h"
 #include "Visuals/VertexBuffer.h"
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
@@ -76,15 +79,14 @@ struct StaticGeometry_Dispatch {
 struct StaticGeometry {
   Shizu_Object parent;
 
-  /// @brief
-  /// A pointer to a list of materials. Must not be null.
-  /// @remarks
-  /// The supported materials are Visuals_PhongMaterial and Visuals_BlinnPhongMaterial.
-  /// The first material in the list is used.
-  Shizu_List* materials;
+  /// @brief The vertex format of the vertices of this wall.
+  /// @remarks The vertices carry material indices into World.materialBuffer, a wall has no material of its own.
+  uint16_t vertexFlags;
 
-  /// @brief The vertex buffer.
-  Visuals_VertexBuffer* vertexBuffer;
+  /// @brief A pointer to an array of @a numberOfBytes Bytes, the vertices of this wall.
+  /// @remarks The vertices are not uploaded by the wall.
+  /// Walls are merged into static batches (see StaticBatch_build) and only the vertex buffers of the batches are materialized.
+  void* bytes;
 
   /// @brief The number of vertices of this wall.
   size_t numberOfVertices;
@@ -92,19 +94,17 @@ struct StaticGeometry {
   /// @brief The number of Bytes of this wall.
   size_t numberOfBytes;
 
+  /// @brief The bounding box of the vertices in world space.
+  /// Computed when the vertex data is set.
+  Visuals_Aabb bounds;
+
   /// @brief Either FLOOR or CEILING, WEST_WALL, NORTH_WALL, EAST_WALL, or SOUTH_WALL.
   uint8_t flags;
 
 };
 
-void
-StaticGeometry_unmaterialize
-  (
-    Shizu_State2* state,
-    StaticGeometry* self
-  );
-
 /// @brief Set the vertex data.
+/// The bounding box is computed from the positions, the first three Shizu_Float32 values of each vertex.
 /// @param state A pointer to the state.
 /// @param self A pointer to to this StaticGeometryGl object.
 /// @param numberOfVertices The size, in vertices, of the data.
@@ -115,7 +115,7 @@ StaticGeometry_setData
   (
     Shizu_State2* state,
     StaticGeometry* self,
-    uint8_t flags,
+    uint16_t flags,
     size_t numberOfVertices,
     size_t numberOfBytes,
     void const* bytes
@@ -220,8 +220,7 @@ StaticGeometry_setDataCeiling
 StaticGeometry*
 StaticGeometry_create
   (
-    Shizu_State2* state,
-    Visuals_Context* visualsContext
+    Shizu_State2* state
   );
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
@@ -236,6 +235,17 @@ struct World {
   Shizu_Object _parent;
   /// @brief Pointer to the list of StaticGeometryGl objects.
   Shizu_List* geometries;
+  /// @brief Pointer to the list of StaticBatch objects.
+  /// The geometries merged into static batches for rendering.
+  /// The batches of all cells of the building.
+  Shizu_List* batches;
+  /// @brief Pointer to the building.
+  /// The rooms of the building are its cells, the doorways are its portals.
+  Building* building;
+  /// @brief Pointer to the uniform buffer of the materials.
+  /// The data of the "Materials" uniform block indexed by the material indices of the vertices and instances.
+  /// Material 0 is the material of the walls, material 1 is the material of the lamps.
+  Visuals_UniformBuffer* materialBuffer;
   /// @brief Information on the player.
   Player* player;
 };
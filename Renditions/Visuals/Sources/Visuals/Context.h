@@ -2,9 +2,11 @@
 #define VISUALS_CONTEXT_H_INCLUDED
 
 #include "Zeitgeist.h"
+typedef struct Visuals_IndexBuffer Visuals_IndexBuffer;
 typedef struct Visuals_Program Visuals_Program;
 typedef struct Visuals_RenderBuffer Visuals_RenderBuffer;
 typedef struct Visuals_Texture Visuals_Texture;
+typedef struct Visuals_UniformBuffer Visuals_UniformBuffer;
 typedef struct Visuals_VertexBuffer Visuals_VertexBuffer;
 
 typedef enum Visuals_BlendFactor {
@@ -30,6 +32,27 @@ typedef enum Visuals_DepthFunction {
   Visuals_DepthFunction_Never,
 } Visuals_DepthFunction;
 
+typedef enum Visuals_PrimitiveType {
+  /// Each three indices form a triangle.
+  Visuals_PrimitiveType_Triangles,
+  /// The indices form one or more triangle strips.
+  /// A primitive restart index terminates the current strip and starts a new one.
+  Visuals_PrimitiveType_TriangleStrip,
+  /// Each two indices form a line.
+  Visuals_PrimitiveType_Lines,
+} Visuals_PrimitiveType;
+
+/// @since 1.0
+/// @brief The filters of Visuals_Context_blitRenderBuffer.
+typedef enum Visuals_BlitFilter {
+  /// The nearest pixel is used.
+  Visuals_BlitFilter_Nearest,
+  /// The four nearest pixels are interpolated bilinearly.
+  Visuals_BlitFilter_Linear,
+  /// Like Visuals_BlitFilter_Linear followed by a sharpening filter restoring some of the detail lost by upscaling.
+  Visuals_BlitFilter_Sharpen,
+} Visuals_BlitFilter;
+
 /// @since 1.0
 /// @brief A visuals context.
 Shizu_declareObjectType(Visuals_Context);
@@ -40,6 +63,8 @@ struct Visuals_Context_Dispatch {
   Visuals_RenderBuffer* (*createRenderBuffer)(Shizu_State2*, Visuals_Context*);
   Visuals_Texture* (*createTexture)(Shizu_State2*, Visuals_Context*);
   Visuals_VertexBuffer* (*createVertexBuffer)(Shizu_State2*, Visuals_Context*);
+  Visuals_IndexBuffer* (*createIndexBuffer)(Shizu_State2*, Visuals_Context*);
+  Visuals_UniformBuffer* (*createUniformBuffer)(Shizu_State2*, Visuals_Context*);
   void (*setClearColor)(Shizu_State2*, Visuals_Context*, Shizu_Float32 r, Shizu_Float32 g, Shizu_Float32 b, Shizu_Float32 a);
   void (*setClearDepth)(Shizu_State2*, Visuals_Context*, Shizu_Float32 z);
   void (*setBlendFactors)(Shizu_State2*, Visuals_Context*, Visuals_BlendFactor, Visuals_BlendFactor);
@@ -48,7 +73,12 @@ struct Visuals_Context_Dispatch {
   void (*setViewport)(Shizu_State2*, Visuals_Context*, Shizu_Float32 left, Shizu_Float32 bottom, Shizu_Float32 width, Shizu_Float32 height);
   void (*clear)(Shizu_State2*, Visuals_Context*, bool colorBuffer, bool depthBuffer);
   void (*setRenderBuffer)(Shizu_State2*, Visuals_Context*, Visuals_RenderBuffer*);
+  void (*blitRenderBuffer)(Shizu_State2*, Visuals_Context*, Visuals_RenderBuffer* renderBuffer, Shizu_Float32 width, Shizu_Float32 height, Visuals_BlitFilter filter);
+  void (*setUniformBuffer)(Shizu_State2*, Visuals_Context*, Shizu_Integer32 index, Visuals_UniformBuffer*);
   void (*render)(Shizu_State2*, Visuals_Context*, Visuals_VertexBuffer* vertexBuffer, Visuals_Program* program);
+  void (*renderRanges)(Shizu_State2*, Visuals_Context*, Visuals_VertexBuffer* vertexBuffer, Shizu_Integer32 const* firsts, Shizu_Integer32 const* counts, size_t numberOfRanges, Visuals_Program* program);
+  void (*renderIndexed)(Shizu_State2*, Visuals_Context*, Visuals_VertexBuffer* vertexBuffer, Visuals_IndexBuffer* indexBuffer, Visuals_PrimitiveType primitiveType, Visuals_Program* program);
+  void (*renderInstanced)(Shizu_State2*, Visuals_Context*, Visuals_VertexBuffer* vertexBuffer, Visuals_VertexBuffer* instanceBuffer, size_t numberOfInstances, Visuals_PrimitiveType primitiveType, Visuals_Program* program);
 };
 
 struct Visuals_Context {
@@ -96,6 +126,22 @@ Visuals_Context_createVertexBuffer
   )
 { Shizu_VirtualCallWithReturn(Visuals_Context, createVertexBuffer, self); }
 
+static inline Visuals_IndexBuffer*
+Visuals_Context_createIndexBuffer
+  (
+    Shizu_State2* state,
+    Visuals_Context* self
+  )
+{ Shizu_VirtualCallWithReturn(Visuals_Context, createIndexBuffer, self); }
+
+static inline Visuals_UniformBuffer*
+Visuals_Context_createUniformBuffer
+  (
+    Shizu_State2* state,
+    Visuals_Context* self
+  )
+{ Shizu_VirtualCallWithReturn(Visuals_Context, createUniformBuffer, self); }
+
 /// default value (0,0,0,0)
 static inline void
 Visuals_Context_setClearColor
@@ -182,6 +228,43 @@ Visuals_Context_setRenderBuffer
   )
 { Shizu_VirtualCall(Visuals_Context, setRenderBuffer, self, renderBuffer); }
 
+/// @brief Copy the colors of a part of a render buffer to the viewport of the render buffer rendered to.
+/// The colors are scaled to the size of the viewport.
+/// @param renderBuffer A pointer to the render buffer to copy from. Must not be the render buffer rendered to.
+/// @param width, height The width and the height of the part relative to the width and the height of the render buffer.
+/// The part begins at the lower left corner of the render buffer. Must be within (0,1].
+/// @param filter The filter.
+/// @remarks The cull mode, the depth function, and the blend factors are unspecified afterwards.
+/// @error Shizu_Status_ArgumentOutOfRange @a width or @a height is not within (0,1] or @a filter is not a blit filter.
+/// @error Shizu_Status_ArgumentValueInvalid @a renderBuffer is null or the render buffer rendered to.
+/// @error Shizu_Status_OperationInvalid @a renderBuffer is not materialized.
+static inline void
+Visuals_Context_blitRenderBuffer
+  (
+    Shizu_State2* state,
+    Visuals_Context* self,
+    Visuals_RenderBuffer* renderBuffer,
+    Shizu_Float32 width,
+    Shizu_Float32 height,
+    Visuals_BlitFilter filter
+  )
+{ Shizu_VirtualCall(Visuals_Context, blitRenderBuffer, self, renderBuffer, width, height, filter); }
+
+/// @brief Bind a uniform buffer to a uniform buffer binding point.
+/// @param index The index of the uniform buffer binding point. Must be non-negative.
+/// @param uniformBuffer A pointer to the uniform buffer or a null pointer.
+/// If this is a null pointer, the uniform buffer bound to the binding point is unbound.
+static inline void
+Visuals_Context_setUniformBuffer
+  (
+    Shizu_State2* state,
+    Visuals_Context* self,
+    Shizu_Integer32 index,
+    Visuals_UniformBuffer* uniformBuffer
+  )
+{ Shizu_VirtualCall(Visuals_Context, setUniformBuffer, self, index, uniformBuffer); }
+
+/// @brief Render the vertices of a vertex buffer as a single triangle strip.
 static inline void
 Visuals_Context_render
   (
@@ -192,4 +275,64 @@ Visuals_Context_render
   )
 { Shizu_VirtualCall(Visuals_Context, render, self, vertexBuffer, program); }
 
+/// @brief Render sub-ranges of the vertices of a vertex buffer, each as a triangle strip, in a single draw call.
+/// @param vertexBuffer A pointer to the vertex buffer.
+/// @param firsts A pointer to an array of @a numberOfRanges indices of the first vertices of the sub-ranges.
+/// @param counts A pointer to an array of @a numberOfRanges numbers of vertices of the sub-ranges.
+/// @param numberOfRanges The number of sub-ranges.
+/// @param program A pointer to the program.
+static inline void
+Visuals_Context_renderRanges
+  (
+    Shizu_State2* state,
+    Visuals_Context* self,
+    Visuals_VertexBuffer* vertexBuffer,
+    Shizu_Integer32 const* firsts,
+    Shizu_Integer32 const* counts,
+    size_t numberOfRanges,
+    Visuals_Program* program
+  )
+{ Shizu_VirtualCall(Visuals_Context, renderRanges, self, vertexBuffer, firsts, counts, numberOfRanges, program); }
+
+/// @brief Render the vertices of a vertex buffer in the order given by an index buffer.
+/// @param vertexBuffer A pointer to the vertex buffer.
+/// @param indexBuffer A pointer to the index buffer.
+/// The maximum index of the index buffer must be smaller than the number of vertices of @a vertexBuffer.
+/// @param primitiveType The type of the primitives formed by the indices.
+/// @param program A pointer to the program.
+static inline void
+Visuals_Context_renderIndexed
+  (
+    Shizu_State2* state,
+    Visuals_Context* self,
+    Visuals_VertexBuffer* vertexBuffer,
+    Visuals_IndexBuffer* indexBuffer,
+    Visuals_PrimitiveType primitiveType,
+    Visuals_Program* program
+  )
+{ Shizu_VirtualCall(Visuals_Context, renderIndexed, self, vertexBuffer, indexBuffer, primitiveType, program); }
+
+/// @brief Render @a numberOfInstances instances of the vertices of a vertex buffer in a single draw call.
+/// @param vertexBuffer A pointer to the vertex buffer providing the per-vertex data.
+/// @param instanceBuffer A pointer to the vertex buffer providing the per-instance data.
+/// Its format must be Visuals_VertexSemantics_Transform3x4_MaterialIndex | Visuals_VertexSyntactics_Float4_Float4_Float4_UInt32.
+/// @param numberOfInstances The number of instances to render.
+/// Must not exceed the number of vertices of @a instanceBuffer.
+/// @param primitiveType The type of the primitives formed by the vertices of @a vertexBuffer.
+/// @param program A pointer to the program.
+/// @remarks The "instanceDescriptor" uniform of the program is set to the semantics of @a instanceBuffer for this draw call
+/// and is reset to @a 0 afterwards. It must not be bound by the caller.
+static inline void
+Visuals_Context_renderInstanced
+  (
+    Shizu_State2* state,
+    Visuals_Context* self,
+    Visuals_VertexBuffer* vertexBuffer,
+    Visuals_VertexBuffer* instanceBuffer,
+    size_t numberOfInstances,
+    Visuals_PrimitiveType primitiveType,
+    Visuals_Program* program
+  )
+{ Shizu_VirtualCall(Visuals_Context, renderInstanced, self, vertexBuffer, instanceBuffer, numberOfInstances, primitiveType, program); }
+
 #endif // VISUALS_CONTEXT_H_INCLUDED
@@ -0,0 +1,88 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Visuals/DynamicResolution.h"
+
+// fabsf, sqrtf
+#include <math.h>
+
+/// @brief The weight of a new frame time in the moving average.
+#define AverageWeight (0.1f)
+
+/// @brief The fraction of the target frame time aimed at, leaving room for spikes.
+#define Headroom (0.9f)
+
+/// @brief The maximal relative change of the scale per frame.
+#define MaximalChange (0.1f)
+
+/// @brief The minimal relative change of the scale. Smaller changes are not applied.
+#define MinimalChange (0.02f)
+
+void
+Visuals_DynamicResolution_initialize
+  (
+    Shizu_State2* state,
+    Visuals_DynamicResolution* self,
+    Shizu_Float32 targetFramesPerSecond,
+    Shizu_Float32 minimumScale,
+    Shizu_Float32 maximumScale
+  )
+{
+  if (!(targetFramesPerSecond > 0.f) || !(minimumScale > 0.f) || !(minimumScale <= maximumScale)) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  self->targetMilliseconds = 1000.f / targetFramesPerSecond;
+  self->minimumScale = minimumScale;
+  self->maximumScale = maximumScale;
+  self->scale = maximumScale;
+  self->averageMilliseconds = -1.f;
+}
+
+Shizu_Float32
+Visuals_DynamicResolution_update
+  (
+    Shizu_State2* state,
+    Visuals_DynamicResolution* self,
+    Shizu_Float32 milliseconds
+  )
+{
+  if (!(milliseconds > 0.f)) {
+    return self->scale;
+  }
+  if (self->averageMilliseconds < 0.f) {
+    self->averageMilliseconds = milliseconds;
+  } else {
+    self->averageMilliseconds += AverageWeight * (milliseconds - self->averageMilliseconds);
+  }
+  // The frame time is proportional to the square of the scale.
+  Shizu_Float32 scale = self->scale * sqrtf(Headroom * self->targetMilliseconds / self->averageMilliseconds);
+  Shizu_Float32 lower = self->scale * (1.f - MaximalChange), upper = self->scale * (1.f + MaximalChange);
+  scale = scale < lower ? lower : scale;
+  scale = scale > upper ? upper : scale;
+  scale = scale < self->minimumScale ? self->minimumScale : scale;
+  scale = scale > self->maximumScale ? self->maximumScale : scale;
+  // Do not follow noise. Always reach the bounds.
+  if (fabsf(scale - self->scale) >= MinimalChange * self->scale || scale == self->minimumScale || scale == self->maximumScale) {
+    self->scale = scale;
+  }
+  return self->scale;
+}
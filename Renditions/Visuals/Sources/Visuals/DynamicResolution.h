@@ -0,0 +1,76 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(VISUALS_DYNAMICRESOLUTION_H_INCLUDED)
+#define VISUALS_DYNAMICRESOLUTION_H_INCLUDED
+
+#include "Zeitgeist.h"
+
+/// @since 1.0
+/// @brief A controller adjusting the resolution at which a scene is rendered to hold a target frame time.
+/// @details
+/// The scale is the ratio of the width (and the height) of the rendered image to the width (and the height) of the window.
+/// The cost of a frame is assumed to be proportional to the number of pixels rendered, that is to the square of the scale.
+typedef struct Visuals_DynamicResolution {
+  /// @brief The target frame time, in milliseconds.
+  Shizu_Float32 targetMilliseconds;
+  /// @brief The minimal scale and the maximal scale.
+  Shizu_Float32 minimumScale, maximumScale;
+  /// @brief The current scale.
+  Shizu_Float32 scale;
+  /// @brief The exponential moving average of the measured frame times, in milliseconds.
+  /// Negative if no frame time was measured yet.
+  Shizu_Float32 averageMilliseconds;
+} Visuals_DynamicResolution;
+
+/// @since 1.0
+/// @brief Initialize a dynamic resolution controller.
+/// @param self A pointer to the Visuals_DynamicResolution value.
+/// @param targetFramesPerSecond The target frame rate. Must be positive.
+/// @param minimumScale, maximumScale The minimal and the maximal scale.
+/// Must be positive, @a minimumScale must not be greater than @a maximumScale.
+/// @remarks The scale starts at the maximal scale.
+/// @error Shizu_Status_ArgumentValueInvalid an argument is invalid.
+void
+Visuals_DynamicResolution_initialize
+  (
+    Shizu_State2* state,
+    Visuals_DynamicResolution* self,
+    Shizu_Float32 targetFramesPerSecond,
+    Shizu_Float32 minimumScale,
+    Shizu_Float32 maximumScale
+  );
+
+/// @since 1.0
+/// @brief Adjust the scale to the time spent on a frame.
+/// @param self A pointer to the Visuals_DynamicResolution value.
+/// @param milliseconds The time, in milliseconds, spent on a frame. Non-positive values are ignored.
+/// @return The scale.
+/// @remarks The scale changes by at most 10 percent per frame and is kept if it would change by less than 2 percent.
+Shizu_Float32
+Visuals_DynamicResolution_update
+  (
+    Shizu_State2* state,
+    Visuals_DynamicResolution* self,
+    Shizu_Float32 milliseconds
+  );
+
+#endif // VISUALS_DYNAMICRESOLUTION_H_INCLUDED
@@ -0,0 +1,125 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Visuals/Frustum.h"
+
+// FLT_MAX
+#include <float.h>
+// fabsf
+#include <math.h>
+// memcpy
+#include <string.h>
+
+void
+Visuals_Aabb_fromPositions
+  (
+    Visuals_Aabb* aabb,
+    void const* bytes,
+    size_t numberOfPositions,
+    size_t stride
+  )
+{
+  for (size_t j = 0; j < 3; ++j) {
+    aabb->minimum[j] = +FLT_MAX;
+    aabb->maximum[j] = -FLT_MAX;
+  }
+  uint8_t const* p = (uint8_t const*)bytes;
+  for (size_t i = 0; i < numberOfPositions; ++i, p += stride) {
+    Shizu_Float32 position[3];
+    // The positions are not necessarily aligned.
+    memcpy(position, p, sizeof(position));
+    for (size_t j = 0; j < 3; ++j) {
+      aabb->minimum[j] = position[j] < aabb->minimum[j] ? position[j] : aabb->minimum[j];
+      aabb->maximum[j] = position[j] > aabb->maximum[j] ? position[j] : aabb->maximum[j];
+    }
+  }
+}
+
+void
+Visuals_Frustum_extract
+  (
+    Shizu_State2* state,
+    Visuals_Frustum* frustum,
+    idlib_matrix_4x4_f32 const* matrix
+  )
+{
+  static Shizu_Float32 const region[4] = { -1.f, -1.f, +1.f, +1.f };
+  Visuals_Frustum_extractRegion(state, frustum, matrix, region);
+}
+
+void
+Visuals_Frustum_extractRegion
+  (
+    Shizu_State2* state,
+    Visuals_Frustum* frustum,
+    idlib_matrix_4x4_f32 const* matrix,
+    Shizu_Float32 const region[4]
+  )
+{
+  // A point is inside the frustum if minimum.x * w <= x <= maximum.x * w, minimum.y * w <= y <= maximum.y * w, and -w <= z <= +w
+  // hold for its clip space coordinates (x, y, z, w).
+  // Each of these inequalities is a plane: row 0, 1, or 2 of the matrix plus or minus a multiple of row 3.
+  Shizu_Float32 const bounds[6] = { region[0], region[2], region[1], region[3], -1.f, +1.f };
+  for (size_t i = 0; i < 6; ++i) {
+    size_t row = i / 2;
+    Shizu_Float32 sign = (i % 2) ? -1.f : +1.f;
+    for (size_t j = 0; j < 4; ++j) {
+      frustum->planes[i][j] = sign * (matrix->e[row][j] - bounds[i] * matrix->e[3][j]);
+    }
+    for (size_t j = 0; j < 3; ++j) {
+      frustum->absoluteNormals[i][j] = fabsf(frustum->planes[i][j]);
+    }
+  }
+}
+
+size_t
+Visuals_Frustum_cullBoxes
+  (
+    Shizu_State2* state,
+    Visuals_Frustum const* frustum,
+    Visuals_Aabb const* boxes,
+    size_t numberOfBoxes,
+    uint8_t* visible
+  )
+{
+  size_t numberOfVisibleBoxes = 0;
+  for (size_t i = 0; i < numberOfBoxes; ++i) {
+    Visuals_Aabb const* box = &boxes[i];
+    Shizu_Float32 center[3], extent[3];
+    for (size_t j = 0; j < 3; ++j) {
+      center[j] = (box->maximum[j] + box->minimum[j]) * 0.5f;
+      extent[j] = (box->maximum[j] - box->minimum[j]) * 0.5f;
+    }
+    // The box is outside of a plane if the corner farthest along the normal of the plane is outside.
+    // The test does not branch per plane such that the loop over the boxes stays cheap.
+    uint8_t inside = 1;
+    for (size_t j = 0; j < 6; ++j) {
+      Shizu_Float32 const* plane = frustum->planes[j];
+      Shizu_Float32 const* absoluteNormal = frustum->absoluteNormals[j];
+      Shizu_Float32 distance = plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3];
+      Shizu_Float32 radius = absoluteNormal[0] * extent[0] + absoluteNormal[1] * extent[1] + absoluteNormal[2] * extent[2];
+      inside &= (uint8_t)(distance + radius >= 0.f);
+    }
+    visible[i] = inside;
+    numberOfVisibleBoxes += inside;
+  }
+  return numberOfVisibleBoxes;
+}
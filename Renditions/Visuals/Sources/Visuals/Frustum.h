@@ -0,0 +1,115 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(VISUALS_FRUSTUM_H_INCLUDED)
+#define VISUALS_FRUSTUM_H_INCLUDED
+
+#include "Zeitgeist.h"
+#include "Matrix4F32.h"
+
+/// @since 1.0
+/// @brief An axis aligned bounding box.
+typedef struct Visuals_Aabb {
+  /// @brief The minimal coordinates along the x-, y-, and z-axis.
+  Shizu_Float32 minimum[3];
+  /// @brief The maximal coordinates along the x-, y-, and z-axis.
+  Shizu_Float32 maximum[3];
+} Visuals_Aabb;
+
+/// @since 1.0
+/// @brief Compute the axis aligned bounding box of positions.
+/// @param aabb A pointer to the Visuals_Aabb value receiving the box.
+/// @param bytes A pointer to the first position. A position is three Shizu_Float32 values.
+/// @param numberOfPositions The number of positions.
+/// If zero, the box is empty (the minimum is greater than the maximum).
+/// @param stride The distance, in Bytes, between two consecutive positions.
+void
+Visuals_Aabb_fromPositions
+  (
+    Visuals_Aabb* aabb,
+    void const* bytes,
+    size_t numberOfPositions,
+    size_t stride
+  );
+
+/// @since 1.0
+/// @brief The six planes of a view frustum.
+/// @details
+/// A point p is inside the plane (a, b, c, d) if a * p.x + b * p.y + c * p.z + d >= 0.
+typedef struct Visuals_Frustum {
+  /// @brief The left, right, bottom, top, near, and far plane.
+  Shizu_Float32 planes[6][4];
+  /// @brief The absolute values of the normals of the planes.
+  Shizu_Float32 absoluteNormals[6][3];
+} Visuals_Frustum;
+
+/// @since 1.0
+/// @brief Extract the planes of the view frustum of a matrix.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param frustum A pointer to the Visuals_Frustum value receiving the planes.
+/// @param matrix The product of the projection, the view, and optionally the world matrix.
+/// The planes are in the coordinate system the matrix maps to clip space.
+void
+Visuals_Frustum_extract
+  (
+    Shizu_State2* state,
+    Visuals_Frustum* frustum,
+    idlib_matrix_4x4_f32 const* matrix
+  );
+
+/// @since 1.0
+/// @brief Extract the planes of the part of the view frustum of a matrix which projects into a region of the viewport.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param frustum A pointer to the Visuals_Frustum value receiving the planes.
+/// @param matrix The product of the projection, the view, and optionally the world matrix.
+/// @param region The minimal x, minimal y, maximal x, and maximal y normalized device coordinates of the region.
+/// Visuals_Frustum_extract is equivalent to this function with the region (-1, -1, +1, +1).
+void
+Visuals_Frustum_extractRegion
+  (
+    Shizu_State2* state,
+    Visuals_Frustum* frustum,
+    idlib_matrix_4x4_f32 const* matrix,
+    Shizu_Float32 const region[4]
+  );
+
+/// @since 1.0
+/// @brief Test boxes against a view frustum.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param frustum A pointer to the frustum.
+/// @param boxes A pointer to an array of @a numberOfBoxes boxes.
+/// @param numberOfBoxes The number of boxes.
+/// @param visible A pointer to an array of @a numberOfBoxes elements.
+/// Element i receives 1 if box i is possibly visible and 0 if it is outside of the frustum.
+/// @return The number of possibly visible boxes.
+/// @remarks A box is culled if it is completely outside of one of the planes.
+/// Boxes outside of the frustum but not completely outside of one of its planes are not culled.
+size_t
+Visuals_Frustum_cullBoxes
+  (
+    Shizu_State2* state,
+    Visuals_Frustum const* frustum,
+    Visuals_Aabb const* boxes,
+    size_t numberOfBoxes,
+    uint8_t* visible
+  );
+
+#endif // VISUALS_FRUSTUM_H_INCLUDED
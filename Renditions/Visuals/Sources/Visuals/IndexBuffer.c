@@ -0,0 +1,237 @@
+/*
+  Zeitgeist
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "Visuals/IndexBuffer.h"
+
+// fprintf, stderr
+#include <stdio.h>
+// malloc, free
+#include <malloc.h>
+// memcpy
+#include <string.h>
+
+static void
+Visuals_IndexBuffer_finalize
+  (
+    Shizu_State2* state,
+    Visuals_IndexBuffer* self
+  );
+
+static void
+Visuals_IndexBuffer_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_IndexBuffer_Dispatch* self
+  );
+
+static void
+Visuals_IndexBuffer_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_IndexBuffer* self,
+    uint8_t flags,
+    void const* bytes,
+    size_t numberOfBytes
+  );
+
+static void
+Visuals_IndexBuffer_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  );
+
+static Shizu_ObjectTypeDescriptor const Visuals_IndexBuffer_Type = {
+  .postCreateType = NULL,
+  .preDestroyType = NULL,
+  .visitType = NULL,
+  .size = sizeof(Visuals_IndexBuffer),
+  .construct = &Visuals_IndexBuffer_constructImpl,
+  .finalize = (Shizu_OnFinalizeCallback*)&Visuals_IndexBuffer_finalize,
+  .visit = NULL,
+  .dispatchSize = sizeof(Visuals_IndexBuffer_Dispatch),
+  .dispatchInitialize = (Shizu_OnDispatchInitializeCallback*)&Visuals_IndexBuffer_dispatchInitialize,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Zeitgeist.Visuals.IndexBuffer", Visuals_IndexBuffer, Visuals_Object);
+
+static void
+Visuals_IndexBuffer_finalize
+  (
+    Shizu_State2* state,
+    Visuals_IndexBuffer* self
+  )
+{
+  if (self->bytes) {
+    free(self->bytes);
+    self->bytes = NULL;
+  }
+  self->numberOfBytes = 0;
+
+  self->numberOfIndices = 0;
+  self->minimumIndex = 0;
+  self->maximumIndex = 0;
+  self->minimumNonRestartIndex = 0;
+  self->maximumNonRestartIndex = 0;
+  self->numberOfRestartIndices = 0;
+
+  self->flags = 0;
+}
+
+static void
+Visuals_IndexBuffer_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_IndexBuffer_Dispatch* self
+  )
+{
+  self->setData = (void(*)(Shizu_State2*, Visuals_IndexBuffer*, uint8_t, void const*, size_t)) & Visuals_IndexBuffer_setDataImpl;
+}
+
+static void
+Visuals_IndexBuffer_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_IndexBuffer* self,
+    uint8_t flags,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{
+  size_t newIndexSize = 0;
+  switch (flags) {
+    case Visuals_IndexSyntactics_UInt16: {
+      newIndexSize = sizeof(uint16_t);
+    } break;
+    case Visuals_IndexSyntactics_UInt32: {
+      newIndexSize = sizeof(uint32_t);
+    } break;
+    default: {
+      fprintf(stderr, "%s:%d: unreachable code reached\n", __FILE__, __LINE__);
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    } break;
+  };
+  // Compute new number of indices.
+  size_t newNumberOfIndices = numberOfBytes / newIndexSize;
+  // Fail if this does not hold.
+  if (numberOfBytes % newIndexSize) {
+    fprintf(stderr, "%s:%d: warning: number of Bytes %zu is not a multiple of the index size %zu\n", __FILE__, __LINE__, numberOfBytes, newIndexSize);
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  // Compute the index range including and excluding the primitive restart index.
+  // Whether primitive restart indices are read as indices depends on the primitive type of the draw call (see Visuals_IndexBuffer_getIndexRange).
+  uint32_t const restartIndex = Visuals_IndexBuffer_getRestartIndex(flags);
+  uint32_t minimumIndex = UINT32_MAX, maximumIndex = 0;
+  uint32_t minimumNonRestartIndex = UINT32_MAX, maximumNonRestartIndex = 0;
+  size_t numberOfRestartIndices = 0;
+  for (size_t i = 0; i < newNumberOfIndices; ++i) {
+    uint32_t index = Visuals_IndexSyntactics_UInt16 == flags ? ((uint16_t const*)bytes)[i] : ((uint32_t const*)bytes)[i];
+    if (index < minimumIndex) {
+      minimumIndex = index;
+    }
+    if (index > maximumIndex) {
+      maximumIndex = index;
+    }
+    if (index == restartIndex) {
+      numberOfRestartIndices++;
+      continue;
+    }
+    if (index < minimumNonRestartIndex) {
+      minimumNonRestartIndex = index;
+    }
+    if (index > maximumNonRestartIndex) {
+      maximumNonRestartIndex = index;
+    }
+  }
+  if (minimumIndex > maximumIndex) {
+    // No indices.
+    minimumIndex = 0;
+    maximumIndex = 0;
+  }
+  if (minimumNonRestartIndex > maximumNonRestartIndex) {
+    // No indices or only primitive restart indices.
+    minimumNonRestartIndex = 0;
+    maximumNonRestartIndex = 0;
+  }
+  // Allocate new Bytes.
+  void* newBytes = realloc(self->bytes, numberOfBytes > 0 ? numberOfBytes : 1);
+  if (!newBytes) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  memcpy(newBytes, bytes, numberOfBytes);
+  // Store the flags.
+  self->flags = flags;
+  // Store the number of indices and the index range.
+  self->numberOfIndices = newNumberOfIndices;
+  self->minimumIndex = minimumIndex;
+  self->maximumIndex = maximumIndex;
+  self->minimumNonRestartIndex = minimumNonRestartIndex;
+  self->maximumNonRestartIndex = maximumNonRestartIndex;
+  self->numberOfRestartIndices = numberOfRestartIndices;
+  // Store the bytes and the number of Bytes.
+  self->bytes = newBytes;
+  self->numberOfBytes = numberOfBytes;
+}
+
+static void
+Visuals_IndexBuffer_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{
+  if (1 != numberOfArgumentValues) {
+    Shizu_State2_setStatus(state, Shizu_Status_NumberOfArgumentsInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Type* TYPE = Visuals_IndexBuffer_getType(state);
+  Visuals_IndexBuffer* SELF = (Visuals_IndexBuffer*)Shizu_Value_getObject(&argumentValues[0]);
+  {
+    Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value argumentValues[] = { Shizu_Value_InitializerObject(SELF) };
+    Shizu_Type* PARENTTYPE = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), TYPE);
+    Shizu_Type_getObjectTypeDescriptor(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), PARENTTYPE)->construct
+    (state, &returnValue, 1, &argumentValues[0]);
+  }
+  SELF->bytes = malloc(sizeof(char));
+  if (!SELF->bytes) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  SELF->numberOfBytes = 0;
+  SELF->numberOfIndices = 0;
+  SELF->minimumIndex = 0;
+  SELF->maximumIndex = 0;
+  SELF->minimumNonRestartIndex = 0;
+  SELF->maximumNonRestartIndex = 0;
+  SELF->numberOfRestartIndices = 0;
+  SELF->flags = Visuals_IndexSyntactics_UInt16;
+  ((Shizu_Object*)SELF)->type = TYPE;
+}
@@ -0,0 +1,150 @@
+/*
+  Zeitgeist
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(VISUALS_INDEXBUFFER_H_INCLUDED)
+#define VISUALS_INDEXBUFFER_H_INCLUDED
+
+#include "Visuals/Object.h"
+
+// UINT16_MAX, UINT32_MAX
+#include <stdint.h>
+
+/// @brief An index is a single uint16_t value.
+/// The index 0xffff is the primitive restart index.
+#define Visuals_IndexSyntactics_UInt16 (1)
+/// @brief An index is a single uint32_t value.
+/// The index 0xffffffff is the primitive restart index.
+#define Visuals_IndexSyntactics_UInt32 (2)
+
+/// @since 1.0
+/// @brief
+/// An index buffer.
+/// @details
+/// An index buffer comprises
+/// - n indices all of the same index syntactics
+/// - the index syntactics of its indices
+/// - the minimum and the maximum index (including and excluding the primitive restart index)
+/// - the number of primitive restart indices
+/// Currently, the following formats are supported
+/// - Visuals_IndexSyntactics_UInt16
+/// - Visuals_IndexSyntactics_UInt32
+/// @details
+/// The type is
+/// @code
+/// class Visuals.IndexBuffer
+/// @endcode
+/// Its constructor is
+/// @code
+/// Visuals.IndexBuffer.construct()
+/// @endcode
+/// which initializes the index buffer with default values. The default values are
+/// - zero indices
+/// - of the format Visuals_IndexSyntactics_UInt16
+Shizu_declareObjectType(Visuals_IndexBuffer);
+
+struct Visuals_IndexBuffer_Dispatch {
+  Visuals_Object_Dispatch _parent;
+  void (*setData)(Shizu_State2* state, Visuals_IndexBuffer* self, uint8_t flags, void const* bytes, size_t numberOfBytes);
+};
+
+struct Visuals_IndexBuffer {
+  Visuals_Object parent;
+  /// @brief The number of indices.
+  size_t numberOfIndices;
+  /// @brief The index format.
+  uint8_t flags;
+  /// @brief A pointer to an array of @a numberOfBytes Bytes.
+  void* bytes;
+  /// @brief The number of Bytes in the array pointed to by @a bytes.
+  size_t numberOfBytes;
+  /// @brief The minimum index (including the primitive restart index).
+  /// @remarks Zero if there are no indices.
+  uint32_t minimumIndex;
+  /// @brief The maximum index (including the primitive restart index).
+  /// @remarks Zero if there are no indices.
+  uint32_t maximumIndex;
+  /// @brief The minimum index (excluding the primitive restart index).
+  /// @remarks Zero if there are no indices or only primitive restart indices.
+  uint32_t minimumNonRestartIndex;
+  /// @brief The maximum index (excluding the primitive restart index).
+  /// @remarks Zero if there are no indices or only primitive restart indices.
+  uint32_t maximumNonRestartIndex;
+  /// @brief The number of primitive restart indices.
+  size_t numberOfRestartIndices;
+};
+
+/// @brief Get the primitive restart index of an index format.
+/// @param flags The index format.
+/// @return The primitive restart index.
+static inline uint32_t
+Visuals_IndexBuffer_getRestartIndex
+  (
+    uint8_t flags
+  )
+{ return Visuals_IndexSyntactics_UInt16 == flags ? UINT16_MAX : UINT32_MAX; }
+
+/// @brief Get the range of the indices read by a draw call.
+/// @param self A pointer to this index buffer.
+/// @param primitiveRestart If the draw call enables primitive restart.
+/// If it does, primitive restart indices are not included in the range.
+/// Otherwise they are included and must be in bounds like any other index.
+/// @param minimumIndex A pointer to a uint32_t variable receiving the minimum index.
+/// @param maximumIndex A pointer to a uint32_t variable receiving the maximum index.
+/// @return @a true if the draw call reads vertices, @a false if there are no indices or only primitive restart indices are read with primitive restart enabled.
+/// In the latter case, the variables are not assigned to.
+static inline Shizu_Boolean
+Visuals_IndexBuffer_getIndexRange
+  (
+    Visuals_IndexBuffer const* self,
+    Shizu_Boolean primitiveRestart,
+    uint32_t* minimumIndex,
+    uint32_t* maximumIndex
+  )
+{
+  if (!self->numberOfIndices) {
+    return Shizu_Boolean_False;
+  }
+  if (!primitiveRestart) {
+    *minimumIndex = self->minimumIndex;
+    *maximumIndex = self->maximumIndex;
+    return Shizu_Boolean_True;
+  }
+  if (self->numberOfRestartIndices == self->numberOfIndices) {
+    return Shizu_Boolean_False;
+  }
+  *minimumIndex = self->minimumNonRestartIndex;
+  *maximumIndex = self->maximumNonRestartIndex;
+  return Shizu_Boolean_True;
+}
+
+static inline void
+Visuals_IndexBuffer_setData
+  (
+    Shizu_State2* state,
+    Visuals_IndexBuffer* self,
+    uint8_t flags,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{ Shizu_VirtualCall(Visuals_IndexBuffer, setData, self, flags, bytes, numberOfBytes); }
+
+#endif // VISUALS_INDEXBUFFER_H_INCLUDED
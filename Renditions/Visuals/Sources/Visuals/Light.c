@@ -0,0 +1,203 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Visuals/Light.h"
+
+// sqrtf
+#include <math.h>
+
+Shizu_defineEnumerationType("Zeitgeist.Visuals.LightType", Visuals_LightType);
+
+static void
+Visuals_Light_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  );
+
+static Shizu_ObjectTypeDescriptor const Visuals_Light_Type = {
+  .postCreateType = NULL,
+  .preDestroyType = NULL,
+  .visitType = NULL,
+  .size = sizeof(Visuals_Light),
+  .construct = &Visuals_Light_constructImpl,
+  .finalize = NULL,
+  .visit = NULL,
+  .dispatchSize = sizeof(Visuals_Light_Dispatch),
+  .dispatchInitialize = NULL,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Zeitgeist.Visuals.Light", Visuals_Light, Shizu_Object);
+
+static void
+Visuals_Light_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{
+  if (2 != numberOfArgumentValues) {
+    Shizu_State2_setStatus(state, Shizu_Status_NumberOfArgumentsInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Type* TYPE = Visuals_Light_getType(state);
+  Visuals_Light* SELF = (Visuals_Light*)Shizu_Value_getObject(&argumentValues[0]);
+  Shizu_Integer32 type = Shizu_Runtime_Extensions_getInteger32Value(state, &argumentValues[1]);
+  switch (type) {
+    case Visuals_LightType_Ambient:
+    case Visuals_LightType_Directional:
+    case Visuals_LightType_Point:
+    case Visuals_LightType_Spot: {
+    } break;
+    default: {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    } break;
+  };
+  {
+    Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value argumentValues[] = { Shizu_Value_InitializerObject(SELF) };
+    Shizu_Type* PARENTTYPE = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), TYPE);
+    Shizu_Type_getObjectTypeDescriptor(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), PARENTTYPE)->construct
+    (state, &returnValue, 1, &argumentValues[0]);
+  }
+  SELF->type = (Visuals_LightType)type;
+  SELF->color[0] = 1.f;
+  SELF->color[1] = 1.f;
+  SELF->color[2] = 1.f;
+  SELF->position[0] = 0.f;
+  SELF->position[1] = 0.f;
+  SELF->position[2] = 0.f;
+  SELF->direction[0] = 0.f;
+  SELF->direction[1] = 0.f;
+  SELF->direction[2] = -1.f;
+  SELF->radius = 0.f;
+  SELF->innerAngle = 0.3926991f;
+  SELF->outerAngle = 0.7853982f;
+  SELF->version = 0;
+  ((Shizu_Object*)SELF)->type = TYPE;
+}
+
+Visuals_Light*
+Visuals_Light_create
+  (
+    Shizu_State2* state,
+    Visuals_LightType type
+  )
+{
+  Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+  Shizu_Value argumentValues[] = { Shizu_Value_InitializerType(Visuals_Light_getType(state)),
+                                   Shizu_Value_InitializerInteger32((Shizu_Integer32)type), };
+  Shizu_Operations_create(state, &returnValue, 2, &argumentValues[0]);
+  return (Visuals_Light*)Shizu_Value_getObject(&returnValue);
+}
+
+void
+Visuals_Light_setColor
+  (
+    Shizu_State2* state,
+    Visuals_Light* self,
+    Shizu_Float32 red,
+    Shizu_Float32 green,
+    Shizu_Float32 blue
+  )
+{
+  self->color[0] = red;
+  self->color[1] = green;
+  self->color[2] = blue;
+  self->version++;
+}
+
+void
+Visuals_Light_setPosition
+  (
+    Shizu_State2* state,
+    Visuals_Light* self,
+    Shizu_Float32 x,
+    Shizu_Float32 y,
+    Shizu_Float32 z
+  )
+{
+  self->position[0] = x;
+  self->position[1] = y;
+  self->position[2] = z;
+  self->version++;
+}
+
+void
+Visuals_Light_setDirection
+  (
+    Shizu_State2* state,
+    Visuals_Light* self,
+    Shizu_Float32 x,
+    Shizu_Float32 y,
+    Shizu_Float32 z
+  )
+{
+  Shizu_Float32 length = sqrtf(x * x + y * y + z * z);
+  if (!(length > 0.f)) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  self->direction[0] = x / length;
+  self->direction[1] = y / length;
+  self->direction[2] = z / length;
+  self->version++;
+}
+
+void
+Visuals_Light_setRadius
+  (
+    Shizu_State2* state,
+    Visuals_Light* self,
+    Shizu_Float32 radius
+  )
+{
+  if (!(radius >= 0.f)) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  self->radius = radius;
+  self->version++;
+}
+
+void
+Visuals_Light_setAngles
+  (
+    Shizu_State2* state,
+    Visuals_Light* self,
+    Shizu_Float32 innerAngle,
+    Shizu_Float32 outerAngle
+  )
+{
+  if (!(0.f <= innerAngle && innerAngle <= outerAngle && outerAngle <= 1.5707964f)) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  self->innerAngle = innerAngle;
+  self->outerAngle = outerAngle;
+  self->version++;
+}
@@ -0,0 +1,162 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(VISUALS_LIGHT_H_INCLUDED)
+#define VISUALS_LIGHT_H_INCLUDED
+
+#include "Zeitgeist.h"
+
+/// @since 1.0
+/// An enumeration of the types of lights.
+/// The values are the light types of the "pbr1" program.
+Shizu_declareEnumerationType(Visuals_LightType);
+
+enum Visuals_LightType {
+  /// A light illuminating all surfaces uniformly.
+  /// Its color scales the ambient color of the materials.
+  Visuals_LightType_Ambient = 4,
+  /// A light infinitely far away shining along its direction.
+  Visuals_LightType_Directional = 8,
+  /// A light at its position shining in all directions.
+  /// If its radius is positive, the light fades to zero at that distance.
+  Visuals_LightType_Point = 16,
+  /// A point light shining along its direction into a cone.
+  /// The light fades from the inner angle to the outer angle of the cone.
+  Visuals_LightType_Spot = 256,
+};
+
+/// @since 1.0
+/// @brief A light.
+/// @details
+/// A light is added to light sets (see Visuals_LightSet).
+/// Each modification of a light increments its version such that light sets only write modified lights.
+///
+/// The type is
+/// @code
+/// class Visuals.Light
+/// @endcode
+/// Its constructor is
+/// @code
+/// Visuals.Light.construct(type : Visuals.LightType)
+/// @endcode
+/// which creates a white light at the origin shining along the negative z-axis.
+/// Its radius is zero, its inner and outer angles are pi/8 and pi/4.
+Shizu_declareObjectType(Visuals_Light);
+
+struct Visuals_Light_Dispatch {
+  Shizu_Object_Dispatch _parent;
+};
+
+struct Visuals_Light {
+  Shizu_Object _parent;
+  /// @brief The type of this light.
+  Visuals_LightType type;
+  /// @brief The color.
+  Shizu_Float32 color[3];
+  /// @brief The position in world space. Used by point and spot lights.
+  Shizu_Float32 position[3];
+  /// @brief The normalized direction in world space. Used by directional and spot lights.
+  Shizu_Float32 direction[3];
+  /// @brief The radius of the sphere of influence or zero. Used by point and spot lights.
+  Shizu_Float32 radius;
+  /// @brief The inner and the outer angle, in radians, of the cone. Used by spot lights.
+  Shizu_Float32 innerAngle, outerAngle;
+  /// @brief The version. Incremented by each modification of this light.
+  uint32_t version;
+};
+
+/// @since 1.0
+/// @brief Create a light.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param type The type of the light.
+/// @return A pointer to the light.
+/// @error Shizu_Status_ArgumentValueInvalid @a type is not a light type.
+Visuals_Light*
+Visuals_Light_create
+  (
+    Shizu_State2* state,
+    Visuals_LightType type
+  );
+
+/// @since 1.0
+/// @brief Set the color of this light.
+void
+Visuals_Light_setColor
+  (
+    Shizu_State2* state,
+    Visuals_Light* self,
+    Shizu_Float32 red,
+    Shizu_Float32 green,
+    Shizu_Float32 blue
+  );
+
+/// @since 1.0
+/// @brief Set the position of this light.
+void
+Visuals_Light_setPosition
+  (
+    Shizu_State2* state,
+    Visuals_Light* self,
+    Shizu_Float32 x,
+    Shizu_Float32 y,
+    Shizu_Float32 z
+  );
+
+/// @since 1.0
+/// @brief Set the direction of this light.
+/// The direction is normalized.
+/// @error Shizu_Status_ArgumentValueInvalid the direction is the zero vector.
+void
+Visuals_Light_setDirection
+  (
+    Shizu_State2* state,
+    Visuals_Light* self,
+    Shizu_Float32 x,
+    Shizu_Float32 y,
+    Shizu_Float32 z
+  );
+
+/// @since 1.0
+/// @brief Set the radius of the sphere of influence of this light.
+/// @param radius The radius. If zero, the light does not fade with the distance.
+/// @error Shizu_Status_ArgumentValueInvalid @a radius is negative or not a number.
+void
+Visuals_Light_setRadius
+  (
+    Shizu_State2* state,
+    Visuals_Light* self,
+    Shizu_Float32 radius
+  );
+
+/// @since 1.0
+/// @brief Set the angles of the cone of this light.
+/// @param innerAngle, outerAngle The angles, in radians, between the direction and the boundaries of the cone.
+/// @error Shizu_Status_ArgumentValueInvalid not 0 <= @a innerAngle <= @a outerAngle <= pi/2.
+void
+Visuals_Light_setAngles
+  (
+    Shizu_State2* state,
+    Visuals_Light* self,
+    Shizu_Float32 innerAngle,
+    Shizu_Float32 outerAngle
+  );
+
+#endif // VISUALS_LIGHT_H_INCLUDED
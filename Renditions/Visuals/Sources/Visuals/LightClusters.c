@@ -0,0 +1,312 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Visuals/LightClusters.h"
+
+#include "Visuals/Parallel.h"
+// logf, floorf, fmaxf, fminf
+#include <math.h>
+// memset
+#include <string.h>
+
+/// @brief The number of clusters of a depth slice.
+#define NumberOfClustersPerSlice (Visuals_LightClusters_GridWidth * Visuals_LightClusters_GridHeight)
+
+/// @brief The number of lights from which on the depth slices are split among threads.
+#define ParallelThreshold (64)
+
+static void
+Visuals_LightClusters_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  );
+
+static Shizu_ObjectTypeDescriptor const Visuals_LightClusters_Type = {
+  .postCreateType = NULL,
+  .preDestroyType = NULL,
+  .visitType = NULL,
+  .size = sizeof(Visuals_LightClusters),
+  .construct = &Visuals_LightClusters_constructImpl,
+  .finalize = NULL,
+  .visit = NULL,
+  .dispatchSize = sizeof(Visuals_LightClusters_Dispatch),
+  .dispatchInitialize = NULL,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Zeitgeist.Visuals.LightClusters", Visuals_LightClusters, Shizu_Object);
+
+static void
+Visuals_LightClusters_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{
+  if (1 != numberOfArgumentValues) {
+    Shizu_State2_setStatus(state, Shizu_Status_NumberOfArgumentsInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Type* TYPE = Visuals_LightClusters_getType(state);
+  Visuals_LightClusters* SELF = (Visuals_LightClusters*)Shizu_Value_getObject(&argumentValues[0]);
+  {
+    Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value argumentValues[] = { Shizu_Value_InitializerObject(SELF) };
+    Shizu_Type* PARENTTYPE = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), TYPE);
+    Shizu_Type_getObjectTypeDescriptor(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), PARENTTYPE)->construct
+    (state, &returnValue, 1, &argumentValues[0]);
+  }
+  SELF->numberOfLights = 0;
+  SELF->numberOfIndices = 0;
+  SELF->depthScale = 0.f;
+  SELF->depthBias = 0.f;
+  memset(SELF->lights, 0, sizeof(SELF->lights));
+  memset(SELF->grid, 0, sizeof(SELF->grid));
+  memset(SELF->indices, 0, sizeof(SELF->indices));
+  memset(SELF->counts, 0, sizeof(SELF->counts));
+  ((Shizu_Object*)SELF)->type = TYPE;
+}
+
+Visuals_LightClusters*
+Visuals_LightClusters_create
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+  Shizu_Value argumentValues[] = { Shizu_Value_InitializerType(Visuals_LightClusters_getType(state)), };
+  Shizu_Operations_create(state, &returnValue, 1, &argumentValues[0]);
+  return (Visuals_LightClusters*)Shizu_Value_getObject(&returnValue);
+}
+
+static inline uint8_t
+clamp
+  (
+    Shizu_Float32 x,
+    uint8_t maximum
+  )
+{
+  if (!(x > 0.f)) {
+    return 0;
+  }
+  if (x >= (Shizu_Float32)maximum) {
+    return maximum;
+  }
+  return (uint8_t)x;
+}
+
+// Compute the range of tiles along an axis overlapped by a sphere.
+// x is the view space coordinate of the center along the axis, z the view depth of the center, r the radius,
+// s the scale of the projection along the axis, and n the number of tiles along the axis.
+// The view depth of the sphere is in [z - r, z + r] and z - r is positive.
+// The projection x / z of the sphere is minimal (maximal) at z - r or z + r depending on the sign of x - r (x + r).
+static void
+getTileRange
+  (
+    Shizu_Float32 x,
+    Shizu_Float32 z,
+    Shizu_Float32 r,
+    Shizu_Float32 s,
+    uint8_t n,
+    uint8_t* minimum,
+    uint8_t* maximum
+  )
+{
+  Shizu_Float32 a = x - r, b = x + r;
+  Shizu_Float32 ndcMinimum = s * a / (a < 0.f ? z - r : z + r);
+  Shizu_Float32 ndcMaximum = s * b / (b > 0.f ? z - r : z + r);
+  *minimum = clamp((ndcMinimum * 0.5f + 0.5f) * n, n - 1);
+  *maximum = clamp((ndcMaximum * 0.5f + 0.5f) * n, n - 1);
+}
+
+typedef struct BuildContext {
+  Visuals_LightClusters* self;
+  /// @brief Whether the indices are written (second pass) or counted (first pass).
+  bool write;
+} BuildContext;
+
+// Count or write the indices of the clusters of a depth slice.
+// Each slice is processed by one thread such that no two threads write the same cluster.
+static void
+buildSlice
+  (
+    void* context,
+    size_t z
+  )
+{
+  BuildContext* buildContext = (BuildContext*)context;
+  Visuals_LightClusters* self = buildContext->self;
+  for (size_t i = 0; i < self->numberOfLights; ++i) {
+    uint8_t const* range = self->ranges[i];
+    if (z < range[2] || z > range[5]) {
+      continue;
+    }
+    for (size_t y = range[1]; y <= range[4]; ++y) {
+      for (size_t x = range[0]; x <= range[3]; ++x) {
+        size_t cluster = (z * Visuals_LightClusters_GridHeight + y) * Visuals_LightClusters_GridWidth + x;
+        if (buildContext->write) {
+          // The number of indices of the cluster might have been reduced to the maximum number of indices.
+          if (self->counts[cluster] < (self->grid[cluster] & 0xFFFF)) {
+            self->indices[(self->grid[cluster] >> 16) + self->counts[cluster]] = (uint16_t)i;
+            self->counts[cluster]++;
+          }
+        } else {
+          self->counts[cluster]++;
+        }
+      }
+    }
+  }
+}
+
+static void
+run
+  (
+    BuildContext* context
+  )
+{
+  if (context->self->numberOfLights < ParallelThreshold) {
+    for (size_t z = 0; z < Visuals_LightClusters_GridDepth; ++z) {
+      buildSlice(context, z);
+    }
+  } else {
+    Visuals_Parallel_run(&buildSlice, context, Visuals_LightClusters_GridDepth);
+  }
+}
+
+void
+Visuals_LightClusters_build
+  (
+    Shizu_State2* state,
+    Visuals_LightClusters* self,
+    idlib_matrix_4x4_f32 const* view,
+    idlib_matrix_4x4_f32 const* projection,
+    Visuals_PointLight const* lights,
+    size_t numberOfLights
+  )
+{
+  idlib_f32 const (*v)[4] = view->e;
+  idlib_f32 const (*p)[4] = projection->e;
+  // p[2][2] = (far + near) / (near - far), p[2][3] = 2 far near / (near - far).
+  Shizu_Float32 near = p[2][3] / (p[2][2] - 1.f), far = p[2][3] / (p[2][2] + 1.f);
+  self->depthScale = Visuals_LightClusters_GridDepth / logf(far / near);
+  self->depthBias = -logf(near) * self->depthScale;
+
+  if (numberOfLights > Visuals_LightClusters_MaximumNumberOfLights) {
+    numberOfLights = Visuals_LightClusters_MaximumNumberOfLights;
+  }
+  // Compute the ranges of clusters overlapped by the lights. Lights outside of the view frustum depth range are dropped.
+  self->numberOfLights = 0;
+  for (size_t i = 0; i < numberOfLights; ++i) {
+    Visuals_PointLight const* light = &lights[i];
+    Shizu_Float32 const* q = light->position;
+    Shizu_Float32 r = light->radius;
+    Shizu_Float32 x = v[0][0] * q[0] + v[0][1] * q[1] + v[0][2] * q[2] + v[0][3];
+    Shizu_Float32 y = v[1][0] * q[0] + v[1][1] * q[1] + v[1][2] * q[2] + v[1][3];
+    Shizu_Float32 z = -(v[2][0] * q[0] + v[2][1] * q[1] + v[2][2] * q[2] + v[2][3]);
+    if (!(r > 0.f) || z + r < near || z - r > far) {
+      continue;
+    }
+    uint8_t* range = self->ranges[self->numberOfLights];
+    if (z - r > near) {
+      getTileRange(x, z, r, p[0][0], Visuals_LightClusters_GridWidth, &range[0], &range[3]);
+      getTileRange(y, z, r, p[1][1], Visuals_LightClusters_GridHeight, &range[1], &range[4]);
+    } else {
+      // The sphere intersects the near plane: Assume it covers the viewport.
+      range[0] = 0;
+      range[1] = 0;
+      range[3] = Visuals_LightClusters_GridWidth - 1;
+      range[4] = Visuals_LightClusters_GridHeight - 1;
+    }
+    range[2] = clamp(logf(fmaxf(z - r, near)) * self->depthScale + self->depthBias, Visuals_LightClusters_GridDepth - 1);
+    range[5] = clamp(logf(fminf(z + r, far)) * self->depthScale + self->depthBias, Visuals_LightClusters_GridDepth - 1);
+    Shizu_Float32* target = self->lights[self->numberOfLights];
+    target[0] = q[0];
+    target[1] = q[1];
+    target[2] = q[2];
+    target[3] = r;
+    target[4] = light->color[0];
+    target[5] = light->color[1];
+    target[6] = light->color[2];
+    target[7] = 0.f;
+    self->numberOfLights++;
+  }
+
+  BuildContext context = { .self = self, .write = false };
+  // Count the indices of the clusters.
+  memset(self->counts, 0, sizeof(self->counts));
+  run(&context);
+  // Compute the offsets of the indices of the clusters. Drop the indices beyond the maximum number of indices.
+  size_t offset = 0;
+  for (size_t i = 0; i < sizeof(self->grid) / sizeof(self->grid[0]); ++i) {
+    size_t count = self->counts[i];
+    if (offset + count > Visuals_LightClusters_MaximumNumberOfIndices) {
+      count = Visuals_LightClusters_MaximumNumberOfIndices - offset;
+    }
+    self->grid[i] = (uint32_t)(offset << 16) | (uint32_t)count;
+    offset += count;
+  }
+  self->numberOfIndices = offset;
+  // Write the indices of the clusters.
+  memset(self->counts, 0, sizeof(self->counts));
+  context.write = true;
+  run(&context);
+}
+
+void
+Visuals_LightClusters_upload
+  (
+    Shizu_State2* state,
+    Visuals_LightClusters* self,
+    Visuals_UniformBuffer* lights,
+    Visuals_UniformBuffer* grid,
+    Visuals_UniformBuffer* indices
+  )
+{
+  // The buffers are as large as the uniform blocks as the results of a program are undefined otherwise.
+  Visuals_UniformBuffer_setData(state, lights, self->lights, sizeof(self->lights));
+  Visuals_UniformBuffer_setData(state, grid, self->grid, sizeof(self->grid));
+  Visuals_UniformBuffer_setData(state, indices, self->indices, sizeof(self->indices));
+}
+
+void
+Visuals_LightClusters_getParameters
+  (
+    Shizu_State2* state,
+    Visuals_LightClusters* self,
+    Shizu_Integer32 viewportWidth,
+    Shizu_Integer32 viewportHeight,
+    Shizu_Float32 parameters[4]
+  )
+{
+  if (viewportWidth <= 0 || viewportHeight <= 0) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  parameters[0] = (Shizu_Float32)Visuals_LightClusters_GridWidth / (Shizu_Float32)viewportWidth;
+  parameters[1] = (Shizu_Float32)Visuals_LightClusters_GridHeight / (Shizu_Float32)viewportHeight;
+  parameters[2] = self->depthScale;
+  parameters[3] = self->depthBias;
+}
@@ -0,0 +1,173 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(VISUALS_LIGHTCLUSTERS_H_INCLUDED)
+#define VISUALS_LIGHTCLUSTERS_H_INCLUDED
+
+#include "Visuals/UniformBuffer.h"
+#include "Matrix4F32.h"
+
+/// @since 1.0
+/// @brief The maximum number of point lights of light clusters.
+/// The lights fill a uniform buffer of 16384 Bytes, the minimum uniform block size guaranteed by OpenGL.
+#define Visuals_LightClusters_MaximumNumberOfLights (512)
+
+/// @since 1.0
+/// @brief The number of clusters along the x-axis of the viewport.
+#define Visuals_LightClusters_GridWidth (16)
+
+/// @since 1.0
+/// @brief The number of clusters along the y-axis of the viewport.
+#define Visuals_LightClusters_GridHeight (8)
+
+/// @since 1.0
+/// @brief The number of clusters along the z-axis of the view frustum.
+/// The slices are spaced exponentially between the near and the far plane.
+#define Visuals_LightClusters_GridDepth (24)
+
+/// @since 1.0
+/// @brief The maximum number of light indices of all clusters.
+/// The 16 bit indices fill a uniform buffer of 16384 Bytes.
+#define Visuals_LightClusters_MaximumNumberOfIndices (8192)
+
+/// @since 1.0
+/// @brief A point light assigned to clusters.
+typedef struct Visuals_PointLight {
+  /// @brief The position in world space.
+  Shizu_Float32 position[3];
+  /// @brief The radius of the sphere of influence. Must be positive.
+  /// The light fades to zero at this distance.
+  Shizu_Float32 radius;
+  /// @brief The color.
+  Shizu_Float32 color[3];
+} Visuals_PointLight;
+
+/// @since 1.0
+/// @brief The assignment of point lights to the clusters of a view frustum for clustered forward shading.
+/// @details
+/// The view frustum is divided into Visuals_LightClusters_GridWidth x Visuals_LightClusters_GridHeight x Visuals_LightClusters_GridDepth clusters.
+/// Visuals_LightClusters_build assigns each light to the clusters its sphere of influence overlaps.
+/// A fragment shader then only evaluates the lights of the cluster of the fragment.
+///
+/// The data of the uniform blocks of the "pbr1" program is
+/// - "ClusteredLights": a vec4 (position, radius) and a vec4 (color, 0) per light,
+/// - "ClusterGrid": a uint per cluster, the offset of its indices in the upper and their number in the lower 16 bits,
+///   packed into uvec4 values,
+/// - "ClusterIndices": 16 bit light indices packed into uvec4 values.
+///
+/// The type is
+/// @code
+/// class Visuals.LightClusters
+/// @endcode
+/// Its constructor is
+/// @code
+/// Visuals.LightClusters.construct()
+/// @endcode
+Shizu_declareObjectType(Visuals_LightClusters);
+
+struct Visuals_LightClusters_Dispatch {
+  Shizu_Object_Dispatch _parent;
+};
+
+struct Visuals_LightClusters {
+  Shizu_Object _parent;
+  /// @brief The number of lights.
+  size_t numberOfLights;
+  /// @brief The number of indices of all clusters.
+  size_t numberOfIndices;
+  /// @brief The depth slicing: The slice of a view depth z is log(z) * depthScale + depthBias.
+  Shizu_Float32 depthScale, depthBias;
+  /// @brief The data of the "ClusteredLights" uniform block.
+  Shizu_Float32 lights[Visuals_LightClusters_MaximumNumberOfLights][8];
+  /// @brief The data of the "ClusterGrid" uniform block.
+  uint32_t grid[Visuals_LightClusters_GridWidth * Visuals_LightClusters_GridHeight * Visuals_LightClusters_GridDepth];
+  /// @brief The data of the "ClusterIndices" uniform block.
+  uint16_t indices[Visuals_LightClusters_MaximumNumberOfIndices];
+  /// @brief The ranges of clusters overlapped by the lights: minimum x, y, z and maximum x, y, z.
+  uint8_t ranges[Visuals_LightClusters_MaximumNumberOfLights][6];
+  /// @brief The number of indices per cluster.
+  uint32_t counts[Visuals_LightClusters_GridWidth * Visuals_LightClusters_GridHeight * Visuals_LightClusters_GridDepth];
+};
+
+Visuals_LightClusters*
+Visuals_LightClusters_create
+  (
+    Shizu_State2* state
+  );
+
+/// @since 1.0
+/// @brief Assign point lights to clusters.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to these light clusters.
+/// @param view The view matrix.
+/// @param projection The projection matrix. Must be a symmetric perspective projection as created by Matrix4F32_createPerspective.
+/// @param lights A pointer to an array of @a numberOfLights lights.
+/// @param numberOfLights The number of lights.
+/// Lights beyond Visuals_LightClusters_MaximumNumberOfLights are ignored.
+/// @remarks
+/// If there are many lights, the depth slices are split among threads.
+/// If the indices of all clusters exceed Visuals_LightClusters_MaximumNumberOfIndices, the excess indices are dropped.
+/// This function does not access Shizu objects other than these light clusters and does not raise errors.
+/// It may run on a thread of the pool while the main thread does not access these light clusters.
+void
+Visuals_LightClusters_build
+  (
+    Shizu_State2* state,
+    Visuals_LightClusters* self,
+    idlib_matrix_4x4_f32 const* view,
+    idlib_matrix_4x4_f32 const* projection,
+    Visuals_PointLight const* lights,
+    size_t numberOfLights
+  );
+
+/// @since 1.0
+/// @brief Write the data of the uniform blocks to uniform buffers.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to these light clusters.
+/// @param lights, grid, indices Pointers to the uniform buffers of the "ClusteredLights", "ClusterGrid", and "ClusterIndices" uniform blocks.
+void
+Visuals_LightClusters_upload
+  (
+    Shizu_State2* state,
+    Visuals_LightClusters* self,
+    Visuals_UniformBuffer* lights,
+    Visuals_UniformBuffer* grid,
+    Visuals_UniformBuffer* indices
+  );
+
+/// @since 1.0
+/// @brief Get the values of the "clusters.parameters" uniform of the "pbr1" program.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to these light clusters.
+/// @param viewportWidth, viewportHeight The size, in pixels, of the viewport. Must be positive.
+/// @param parameters A pointer to an array receiving the scale from pixels to clusters along the x-axis and the y-axis,
+/// the depth scale, and the depth bias.
+void
+Visuals_LightClusters_getParameters
+  (
+    Shizu_State2* state,
+    Visuals_LightClusters* self,
+    Shizu_Integer32 viewportWidth,
+    Shizu_Integer32 viewportHeight,
+    Shizu_Float32 parameters[4]
+  );
+
+#endif // VISUALS_LIGHTCLUSTERS_H_INCLUDED
@@ -0,0 +1,254 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Visuals/LightSet.h"
+
+// cosf
+#include <math.h>
+// offsetof
+#include <stddef.h>
+// memset
+#include <string.h>
+
+static void
+Visuals_LightSet_visit
+  (
+    Shizu_State2* state,
+    Visuals_LightSet* self
+  );
+
+static void
+Visuals_LightSet_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  );
+
+static Shizu_ObjectTypeDescriptor const Visuals_LightSet_Type = {
+  .postCreateType = NULL,
+  .preDestroyType = NULL,
+  .visitType = NULL,
+  .size = sizeof(Visuals_LightSet),
+  .construct = &Visuals_LightSet_constructImpl,
+  .finalize = NULL,
+  .visit = (Shizu_OnVisitCallback*)&Visuals_LightSet_visit,
+  .dispatchSize = sizeof(Visuals_LightSet_Dispatch),
+  .dispatchInitialize = NULL,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Zeitgeist.Visuals.LightSet", Visuals_LightSet, Shizu_Object);
+
+static void
+Visuals_LightSet_visit
+  (
+    Shizu_State2* state,
+    Visuals_LightSet* self
+  )
+{
+  for (size_t i = 0; i < self->numberOfLights; ++i) {
+    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->lights[i]);
+  }
+  if (self->buffer) {
+    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->buffer);
+  }
+}
+
+static void
+Visuals_LightSet_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{
+  if (1 != numberOfArgumentValues) {
+    Shizu_State2_setStatus(state, Shizu_Status_NumberOfArgumentsInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Type* TYPE = Visuals_LightSet_getType(state);
+  Visuals_LightSet* SELF = (Visuals_LightSet*)Shizu_Value_getObject(&argumentValues[0]);
+  {
+    Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value argumentValues[] = { Shizu_Value_InitializerObject(SELF) };
+    Shizu_Type* PARENTTYPE = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), TYPE);
+    Shizu_Type_getObjectTypeDescriptor(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), PARENTTYPE)->construct
+    (state, &returnValue, 1, &argumentValues[0]);
+  }
+  for (size_t i = 0; i < Visuals_LightSet_MaximumNumberOfLights; ++i) {
+    SELF->lights[i] = NULL;
+    SELF->versions[i] = 0;
+  }
+  SELF->numberOfLights = 0;
+  SELF->dirty = 0;
+  SELF->numberOfLightsDirty = Shizu_Boolean_True;
+  SELF->buffer = NULL;
+  memset(&SELF->block, 0, sizeof(Visuals_LightBlock));
+  ((Shizu_Object*)SELF)->type = TYPE;
+}
+
+Visuals_LightSet*
+Visuals_LightSet_create
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+  Shizu_Value argumentValues[] = { Shizu_Value_InitializerType(Visuals_LightSet_getType(state)), };
+  Shizu_Operations_create(state, &returnValue, 1, &argumentValues[0]);
+  return (Visuals_LightSet*)Shizu_Value_getObject(&returnValue);
+}
+
+void
+Visuals_LightSet_add
+  (
+    Shizu_State2* state,
+    Visuals_LightSet* self,
+    Visuals_Light* light
+  )
+{
+  for (size_t i = 0; i < self->numberOfLights; ++i) {
+    if (self->lights[i] == light) {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    }
+  }
+  if (self->numberOfLights == Visuals_LightSet_MaximumNumberOfLights) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  size_t i = self->numberOfLights++;
+  self->lights[i] = light;
+  self->dirty |= UINT32_C(1) << i;
+  self->numberOfLightsDirty = Shizu_Boolean_True;
+}
+
+void
+Visuals_LightSet_remove
+  (
+    Shizu_State2* state,
+    Visuals_LightSet* self,
+    Visuals_Light* light
+  )
+{
+  for (size_t i = 0; i < self->numberOfLights; ++i) {
+    if (self->lights[i] == light) {
+      // Move the last light into the slot of the removed light.
+      size_t j = --self->numberOfLights;
+      if (i != j) {
+        self->lights[i] = self->lights[j];
+        self->dirty |= UINT32_C(1) << i;
+      }
+      self->lights[j] = NULL;
+      self->dirty &= ~(UINT32_C(1) << j);
+      self->numberOfLightsDirty = Shizu_Boolean_True;
+      return;
+    }
+  }
+  Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+  Shizu_State2_jump(state);
+}
+
+size_t
+Visuals_LightSet_getNumberOfLights
+  (
+    Shizu_State2* state,
+    Visuals_LightSet* self
+  )
+{ return self->numberOfLights; }
+
+static void
+pack
+  (
+    Visuals_LightData* target,
+    Visuals_Light const* source
+  )
+{
+  target->type = (Shizu_Integer32)source->type;
+  target->radius = source->radius;
+  target->cosInnerAngle = cosf(source->innerAngle);
+  target->cosOuterAngle = cosf(source->outerAngle);
+  for (size_t j = 0; j < 3; ++j) {
+    target->color[j] = source->color[j];
+    target->position[j] = source->position[j];
+    target->direction[j] = source->direction[j];
+  }
+  target->color[3] = 0.f;
+  target->position[3] = 0.f;
+  target->direction[3] = 0.f;
+}
+
+void
+Visuals_LightSet_upload
+  (
+    Shizu_State2* state,
+    Visuals_LightSet* self,
+    Visuals_UniformBuffer* buffer
+  )
+{
+  Shizu_Boolean all = buffer != self->buffer || buffer->numberOfBytes != sizeof(Visuals_LightBlock);
+  uint32_t dirty = self->dirty;
+  for (size_t i = 0; i < self->numberOfLights; ++i) {
+    if (all || self->versions[i] != self->lights[i]->version) {
+      dirty |= UINT32_C(1) << i;
+    }
+  }
+  if (!dirty && !self->numberOfLightsDirty && !all) {
+    return;
+  }
+  for (size_t i = 0; i < self->numberOfLights; ++i) {
+    if (dirty & (UINT32_C(1) << i)) {
+      pack(&self->block.lights[i], self->lights[i]);
+      self->versions[i] = self->lights[i]->version;
+    }
+  }
+  self->block.numberOfLights = (Shizu_Integer32)self->numberOfLights;
+  // If a write fails, all lights are written by the next upload.
+  self->buffer = NULL;
+  if (all) {
+    Visuals_UniformBuffer_setData(state, buffer, &self->block, sizeof(Visuals_LightBlock));
+  } else {
+    if (self->numberOfLightsDirty) {
+      Visuals_UniformBuffer_setSubData(state, buffer, offsetof(Visuals_LightBlock, numberOfLights), &self->block.numberOfLights, sizeof(Shizu_Integer32));
+    }
+    // Write each run of consecutive modified lights by a single write.
+    size_t i = 0;
+    while (i < self->numberOfLights) {
+      if (!(dirty & (UINT32_C(1) << i))) {
+        i++;
+        continue;
+      }
+      size_t j = i + 1;
+      while (j < self->numberOfLights && (dirty & (UINT32_C(1) << j))) {
+        j++;
+      }
+      Visuals_UniformBuffer_setSubData(state, buffer, offsetof(Visuals_LightBlock, lights) + i * sizeof(Visuals_LightData),
+                                       &self->block.lights[i], (j - i) * sizeof(Visuals_LightData));
+      i = j;
+    }
+  }
+  self->buffer = buffer;
+  self->dirty = 0;
+  self->numberOfLightsDirty = Shizu_Boolean_False;
+}
@@ -0,0 +1,159 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(VISUALS_LIGHTSET_H_INCLUDED)
+#define VISUALS_LIGHTSET_H_INCLUDED
+
+#include "Visuals/Light.h"
+#include "Visuals/UniformBuffer.h"
+
+/// @since 1.0
+/// @brief The maximum number of lights of a light set.
+/// At most 32 such that the lights to be written fit into the bits of an uint32_t value.
+#define Visuals_LightSet_MaximumNumberOfLights (32)
+
+/// @since 1.0
+/// @brief The std140 layout of a light of the "Lights" uniform block of the "pbr1" program.
+typedef struct Visuals_LightData {
+  /// @brief The type of the light.
+  Shizu_Integer32 type;
+  /// @brief The radius of the sphere of influence or zero.
+  Shizu_Float32 radius;
+  /// @brief The cosines of the inner and the outer angle of the cone.
+  Shizu_Float32 cosInnerAngle, cosOuterAngle;
+  /// @brief The color, the position, and the direction. The fourth components are zero.
+  Shizu_Float32 color[4], position[4], direction[4];
+} Visuals_LightData;
+
+/// @since 1.0
+/// @brief The std140 layout of the "Lights" uniform block of the "pbr1" program.
+typedef struct Visuals_LightBlock {
+  /// @brief The number of lights.
+  Shizu_Integer32 numberOfLights;
+  Shizu_Integer32 padding[3];
+  /// @brief The lights.
+  Visuals_LightData lights[Visuals_LightSet_MaximumNumberOfLights];
+} Visuals_LightBlock;
+
+/// @since 1.0
+/// @brief A set of lights written to the uniform buffer of the "Lights" uniform block of the "pbr1" program.
+/// @details
+/// Visuals_LightSet_upload only writes the lights added or modified since the last upload
+/// and writes nothing if there are no such lights.
+/// The order of the lights in the uniform block is unspecified.
+///
+/// The type is
+/// @code
+/// class Visuals.LightSet
+/// @endcode
+/// Its constructor is
+/// @code
+/// Visuals.LightSet.construct()
+/// @endcode
+/// which creates an empty light set.
+Shizu_declareObjectType(Visuals_LightSet);
+
+struct Visuals_LightSet_Dispatch {
+  Shizu_Object_Dispatch _parent;
+};
+
+struct Visuals_LightSet {
+  Shizu_Object _parent;
+  /// @brief The lights.
+  Visuals_Light* lights[Visuals_LightSet_MaximumNumberOfLights];
+  /// @brief The number of lights.
+  size_t numberOfLights;
+  /// @brief The versions of the lights when they were written.
+  uint32_t versions[Visuals_LightSet_MaximumNumberOfLights];
+  /// @brief Bit i is set if light i must be written regardless of its version.
+  uint32_t dirty;
+  /// @brief If the number of lights must be written.
+  Shizu_Boolean numberOfLightsDirty;
+  /// @brief A pointer to the uniform buffer the lights were written to or the null pointer.
+  Visuals_UniformBuffer* buffer;
+  /// @brief The data of the "Lights" uniform block.
+  Visuals_LightBlock block;
+};
+
+Visuals_LightSet*
+Visuals_LightSet_create
+  (
+    Shizu_State2* state
+  );
+
+/// @since 1.0
+/// @brief Add a light to this light set.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this light set.
+/// @param light A pointer to the light.
+/// @error Shizu_Status_ArgumentValueInvalid @a light is already in this light set.
+/// @error Shizu_Status_ArgumentOutOfRange this light set contains Visuals_LightSet_MaximumNumberOfLights lights.
+void
+Visuals_LightSet_add
+  (
+    Shizu_State2* state,
+    Visuals_LightSet* self,
+    Visuals_Light* light
+  );
+
+/// @since 1.0
+/// @brief Remove a light from this light set.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this light set.
+/// @param light A pointer to the light.
+/// @error Shizu_Status_ArgumentValueInvalid @a light is not in this light set.
+void
+Visuals_LightSet_remove
+  (
+    Shizu_State2* state,
+    Visuals_LightSet* self,
+    Visuals_Light* light
+  );
+
+/// @since 1.0
+/// @brief Get the number of lights of this light set.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this light set.
+/// @return The number of lights.
+size_t
+Visuals_LightSet_getNumberOfLights
+  (
+    Shizu_State2* state,
+    Visuals_LightSet* self
+  );
+
+/// @since 1.0
+/// @brief Write the lights added or modified since the last upload to a uniform buffer.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this light set.
+/// @param buffer A pointer to the uniform buffer of the "Lights" uniform block.
+/// @remarks
+/// All lights are written if @a buffer is not the uniform buffer of the last upload or its size was changed.
+/// Otherwise only the ranges of the added or modified lights are written.
+void
+Visuals_LightSet_upload
+  (
+    Shizu_State2* state,
+    Visuals_LightSet* self,
+    Visuals_UniformBuffer* buffer
+  );
+
+#endif // VISUALS_LIGHTSET_H_INCLUDED
@@ -0,0 +1,654 @@
+/*
+  Zeitgeist
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Visuals/Mipmap.h"
+
+#include "Visuals/Parallel.h"
+
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  #define WIN32_LEAN_AND_MEAN
+  #include <Windows.h>
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  // pthread_once
+  #include <pthread.h>
+#else
+  #error("operating system not (yet) supported")
+#endif
+
+// SSE2 is available on all x64 CPUs.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define Visuals_Mipmap_WithSse2 (1)
+  #include <emmintrin.h>
+#else
+  #define Visuals_Mipmap_WithSse2 (0)
+#endif
+
+// sin, sqrt, pow
+#include <math.h>
+
+// malloc, free
+#include <stdlib.h>
+
+// memcpy
+#include <string.h>
+
+// timespec_get
+#include <time.h>
+
+Shizu_defineEnumerationType("Zeitgeist.Visuals.MipmapFilter", Visuals_MipmapFilter);
+
+/// The number of taps of the Kaiser and the Lanczos filter.
+/// The taps are at the offsets -5 to +6 from the left/top pixel of the 2x2 pixels of the previous level.
+#define Visuals_Mipmap_NumberOfTaps (12)
+
+/// The offset of the first tap.
+#define Visuals_Mipmap_FirstTap (-5)
+
+/// The size of the tables mapping linear values in [0,1] to 8 bit values.
+#define Visuals_Mipmap_EncodeTableSize (16384)
+
+/// The minimal number of pixels of a level for splitting the level into bands.
+#define Visuals_Mipmap_MinimalNumberOfPixelsPerBand (128 * 128)
+
+/// The tables mapping 8 bit values to linear values in [0,1].
+/// Index 0 is for linear values, index 1 is for sRGB encoded values.
+static float g_decodeTables[2][256];
+
+/// The tables mapping linear values in [0,1] to 8 bit values.
+/// Index 0 is for linear values, index 1 is for sRGB encoded values.
+static uint8_t g_encodeTables[2][Visuals_Mipmap_EncodeTableSize];
+
+/// The tables are initialized once by the first thread generating a level.
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+static INIT_ONCE g_tablesInitialized = INIT_ONCE_STATIC_INIT;
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+static pthread_once_t g_tablesInitialized = PTHREAD_ONCE_INIT;
+#endif
+
+static void
+Visuals_Mipmap_computeTables
+  (
+    void
+  )
+{
+  for (size_t i = 0; i < 256; ++i) {
+    double v = (double)i / 255.;
+    g_decodeTables[0][i] = (float)v;
+    g_decodeTables[1][i] = (float)(v <= 0.04045 ? v / 12.92 : pow((v + 0.055) / 1.055, 2.4));
+  }
+  for (size_t i = 0; i < Visuals_Mipmap_EncodeTableSize; ++i) {
+    double v = (double)i / (double)(Visuals_Mipmap_EncodeTableSize - 1);
+    g_encodeTables[0][i] = (uint8_t)(v * 255. + 0.5);
+    double w = v <= 0.0031308 ? v * 12.92 : 1.055 * pow(v, 1. / 2.4) - 0.055;
+    g_encodeTables[1][i] = (uint8_t)(w * 255. + 0.5);
+  }
+}
+
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+
+static BOOL CALLBACK
+Visuals_Mipmap_computeTablesOnce
+  (
+    PINIT_ONCE initOnce,
+    PVOID parameter,
+    PVOID* context
+  )
+{
+  Visuals_Mipmap_computeTables();
+  return TRUE;
+}
+
+#endif
+
+static void
+Visuals_Mipmap_initializeTables
+  (
+    void
+  )
+{
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  InitOnceExecuteOnce(&g_tablesInitialized, &Visuals_Mipmap_computeTablesOnce, NULL, NULL);
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  pthread_once(&g_tablesInitialized, &Visuals_Mipmap_computeTables);
+#endif
+}
+
+static inline uint8_t
+Visuals_Mipmap_encode
+  (
+    uint8_t const* table,
+    float v
+  )
+{
+  // Filters with negative lobes overshoot [0,1].
+  if (!(v > 0.f)) {
+    v = 0.f;
+  } else if (v > 1.f) {
+    v = 1.f;
+  }
+  return table[(size_t)(v * (float)(Visuals_Mipmap_EncodeTableSize - 1) + 0.5f)];
+}
+
+static double
+Visuals_Mipmap_sinc
+  (
+    double x
+  )
+{
+  static const double PI = 3.14159265358979323846;
+  return x == 0. ? 1. : sin(PI * x) / (PI * x);
+}
+
+// The modified Bessel function of the first kind of order 0.
+static double
+Visuals_Mipmap_besselI0
+  (
+    double x
+  )
+{
+  double sum = 1., term = 1.;
+  for (int k = 1; k < 32; ++k) {
+    term *= (x / (2. * k)) * (x / (2. * k));
+    sum += term;
+  }
+  return sum;
+}
+
+// Compute the normalized weights of the taps of a filter.
+static void
+Visuals_Mipmap_getWeights
+  (
+    Visuals_MipmapFilter filter,
+    float weights[Visuals_Mipmap_NumberOfTaps]
+  )
+{
+  static const double RADIUS = 3.;
+  static const double BETA = 4.;
+  double w[Visuals_Mipmap_NumberOfTaps];
+  double sum = 0.;
+  for (int k = 0; k < Visuals_Mipmap_NumberOfTaps; ++k) {
+    // The distance, in pixels of the level, of the tap from the center of the pixel of the level.
+    double d = ((double)(k + Visuals_Mipmap_FirstTap) - 0.5) / 2.;
+    if (fabs(d) >= RADIUS) {
+      w[k] = 0.;
+    } else if (Visuals_MipmapFilter_Lanczos == filter) {
+      w[k] = Visuals_Mipmap_sinc(d) * Visuals_Mipmap_sinc(d / RADIUS);
+    } else {
+      double t = d / RADIUS;
+      w[k] = Visuals_Mipmap_sinc(d) * Visuals_Mipmap_besselI0(BETA * sqrt(1. - t * t)) / Visuals_Mipmap_besselI0(BETA);
+    }
+    sum += w[k];
+  }
+  for (int k = 0; k < Visuals_Mipmap_NumberOfTaps; ++k) {
+    weights[k] = (float)(w[k] / sum);
+  }
+}
+
+typedef struct Visuals_Mipmap_Job {
+  Visuals_MipmapFilter filter;
+  bool sRGB;
+  size_t numberOfComponents;
+  /// For each component the table to decode and encode it.
+  float const* decodeTables[4];
+  uint8_t const* encodeTables[4];
+  float weights[Visuals_Mipmap_NumberOfTaps];
+  uint8_t const* source;
+  size_t sourceWidth;
+  size_t sourceHeight;
+  uint8_t* target;
+  size_t targetWidth;
+  size_t targetHeight;
+  size_t numberOfBands;
+  /// The scratch memory of the bands or null.
+  float* scratch;
+  /// The number of floats of the scratch memory of a band.
+  size_t scratchSize;
+} Visuals_Mipmap_Job;
+
+#if Visuals_Mipmap_WithSse2
+
+// Average 2x2 pixels of 4 components of two rows without sRGB conversion.
+// @return The number of target pixels computed.
+static size_t
+Visuals_Mipmap_boxSse2
+  (
+    uint8_t* target,
+    uint8_t const* source0,
+    uint8_t const* source1,
+    size_t targetWidth
+  )
+{
+  __m128i zero = _mm_setzero_si128();
+  __m128i two = _mm_set1_epi16(2);
+  size_t x = 0;
+  for (; x + 4 <= targetWidth; x += 4) {
+    __m128i r[2];
+    for (size_t i = 0; i < 2; ++i) {
+      __m128i a = _mm_loadu_si128((__m128i const*)(source0 + 8 * x + 16 * i));
+      __m128i b = _mm_loadu_si128((__m128i const*)(source1 + 8 * x + 16 * i));
+      // The vertical sums of the source pixels 0 and 1 and of the source pixels 2 and 3.
+      __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+      __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+      // The sums of the source pixels 0 and 1 and of the source pixels 2 and 3.
+      __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+      r[i] = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+    }
+    _mm_storeu_si128((__m128i*)(target + 4 * x), _mm_packus_epi16(r[0], r[1]));
+  }
+  return x;
+}
+
+#endif
+
+static void
+Visuals_Mipmap_Job_runBox
+  (
+    Visuals_Mipmap_Job const* self,
+    size_t band
+  )
+{
+  size_t n = self->numberOfComponents;
+  size_t sourceStride = self->sourceWidth * n, targetStride = self->targetWidth * n;
+  size_t start = (self->targetHeight * band) / self->numberOfBands,
+         end = (self->targetHeight * (band + 1)) / self->numberOfBands;
+  for (size_t y = start; y < end; ++y) {
+    size_t y0 = 2 * y, y1 = 2 * y + 1 < self->sourceHeight ? 2 * y + 1 : self->sourceHeight - 1;
+    uint8_t const* source0 = self->source + y0 * sourceStride;
+    uint8_t const* source1 = self->source + y1 * sourceStride;
+    uint8_t* target = self->target + y * targetStride;
+    size_t x = 0;
+  #if Visuals_Mipmap_WithSse2
+    if (!self->sRGB && 4 == n && self->sourceWidth >= 2) {
+      x = Visuals_Mipmap_boxSse2(target, source0, source1, self->targetWidth);
+    }
+  #endif
+    for (; x < self->targetWidth; ++x) {
+      size_t x0 = 2 * x, x1 = 2 * x + 1 < self->sourceWidth ? 2 * x + 1 : self->sourceWidth - 1;
+      for (size_t c = 0; c < n; ++c) {
+        uint8_t a = source0[x0 * n + c], b = source0[x1 * n + c],
+                d = source1[x0 * n + c], e = source1[x1 * n + c];
+        if (!self->sRGB) {
+          target[x * n + c] = (uint8_t)((a + b + d + e + 2) >> 2);
+        } else {
+          float const* decode = self->decodeTables[c];
+          float v = (decode[a] + decode[b] + decode[d] + decode[e]) * 0.25f;
+          target[x * n + c] = Visuals_Mipmap_encode(self->encodeTables[c], v);
+        }
+      }
+    }
+  }
+}
+
+// Filter a row of the source horizontally.
+// line receives the linear components of the row padded by clamped copies of the first and the last pixel.
+// row receives the 4 components of each of the target pixels.
+static void
+Visuals_Mipmap_Job_filterRow
+  (
+    Visuals_Mipmap_Job const* self,
+    size_t y,
+    float* line,
+    float* row
+  )
+{
+  size_t n = self->numberOfComponents;
+  uint8_t const* source = self->source + y * self->sourceWidth * n;
+  size_t padding = -Visuals_Mipmap_FirstTap;
+  size_t length = self->sourceWidth + Visuals_Mipmap_NumberOfTaps - 1;
+  float const* decodeTables[4] = { self->decodeTables[0], self->decodeTables[1], self->decodeTables[2], self->decodeTables[3] };
+  for (size_t x = 0, m = self->sourceWidth; x < m; ++x) {
+    float* p = line + 4 * (padding + x);
+    for (size_t c = 0; c < n; ++c) {
+      p[c] = decodeTables[c][source[x * n + c]];
+    }
+    for (size_t c = n; c < 4; ++c) {
+      p[c] = 0.f;
+    }
+  }
+  for (size_t i = 0; i < padding; ++i) {
+    memcpy(line + 4 * i, line + 4 * padding, 4 * sizeof(float));
+  }
+  for (size_t i = padding + self->sourceWidth; i < length; ++i) {
+    memcpy(line + 4 * i, line + 4 * (padding + self->sourceWidth - 1), 4 * sizeof(float));
+  }
+#if Visuals_Mipmap_WithSse2
+  __m128 weights[Visuals_Mipmap_NumberOfTaps];
+  for (size_t k = 0; k < Visuals_Mipmap_NumberOfTaps; ++k) {
+    weights[k] = _mm_set1_ps(self->weights[k]);
+  }
+  for (size_t x = 0, m = self->targetWidth; x < m; ++x) {
+    float const* p = line + 4 * (2 * x);
+    // Two sums to shorten the dependency chain.
+    __m128 sum0 = _mm_mul_ps(weights[0], _mm_loadu_ps(p + 0));
+    __m128 sum1 = _mm_mul_ps(weights[1], _mm_loadu_ps(p + 4));
+    for (size_t k = 2; k < Visuals_Mipmap_NumberOfTaps; k += 2) {
+      sum0 = _mm_add_ps(sum0, _mm_mul_ps(weights[k + 0], _mm_loadu_ps(p + 4 * (k + 0))));
+      sum1 = _mm_add_ps(sum1, _mm_mul_ps(weights[k + 1], _mm_loadu_ps(p + 4 * (k + 1))));
+    }
+    _mm_storeu_ps(row + 4 * x, _mm_add_ps(sum0, sum1));
+  }
+#else
+  float weights[Visuals_Mipmap_NumberOfTaps];
+  memcpy(weights, self->weights, sizeof(weights));
+  for (size_t x = 0, m = self->targetWidth; x < m; ++x) {
+    float const* p = line + 4 * (2 * x);
+    float sum[4] = { 0.f, 0.f, 0.f, 0.f };
+    for (size_t k = 0; k < Visuals_Mipmap_NumberOfTaps; ++k) {
+      for (size_t c = 0; c < 4; ++c) {
+        sum[c] += weights[k] * p[4 * k + c];
+      }
+    }
+    memcpy(row + 4 * x, sum, sizeof(sum));
+  }
+#endif
+}
+
+static void
+Visuals_Mipmap_Job_runSeparable
+  (
+    Visuals_Mipmap_Job const* self,
+    size_t band
+  )
+{
+  size_t n = self->numberOfComponents;
+  size_t rowSize = 4 * self->targetWidth;
+  // The horizontally filtered rows of the source are kept in a ring as consecutive target rows share most of them.
+  float* ring = self->scratch + band * self->scratchSize;
+  float* accumulator = ring + Visuals_Mipmap_NumberOfTaps * rowSize;
+  float* line = accumulator + rowSize;
+  size_t ringRows[Visuals_Mipmap_NumberOfTaps];
+  for (size_t k = 0; k < Visuals_Mipmap_NumberOfTaps; ++k) {
+    ringRows[k] = SIZE_MAX;
+  }
+  uint8_t const* encodeTables[4] = { self->encodeTables[0], self->encodeTables[1], self->encodeTables[2], self->encodeTables[3] };
+#if Visuals_Mipmap_WithSse2
+  __m128 weights[Visuals_Mipmap_NumberOfTaps];
+  for (size_t k = 0; k < Visuals_Mipmap_NumberOfTaps; ++k) {
+    weights[k] = _mm_set1_ps(self->weights[k]);
+  }
+#else
+  float weights[Visuals_Mipmap_NumberOfTaps];
+  memcpy(weights, self->weights, sizeof(weights));
+#endif
+  size_t start = (self->targetHeight * band) / self->numberOfBands,
+         end = (self->targetHeight * (band + 1)) / self->numberOfBands;
+  for (size_t y = start; y < end; ++y) {
+    float const* rows[Visuals_Mipmap_NumberOfTaps];
+    for (size_t k = 0; k < Visuals_Mipmap_NumberOfTaps; ++k) {
+      ptrdiff_t z = (ptrdiff_t)(2 * y) + (ptrdiff_t)k + Visuals_Mipmap_FirstTap;
+      size_t r = z < 0 ? 0 : ((size_t)z >= self->sourceHeight ? self->sourceHeight - 1 : (size_t)z);
+      // At most 12 consecutive rows are used by a target row, hence their slots are distinct.
+      size_t slot = r % Visuals_Mipmap_NumberOfTaps;
+      if (ringRows[slot] != r) {
+        Visuals_Mipmap_Job_filterRow(self, r, line, ring + slot * rowSize);
+        ringRows[slot] = r;
+      }
+      rows[k] = ring + slot * rowSize;
+    }
+    // Filter vertically.
+  #if Visuals_Mipmap_WithSse2
+    for (size_t i = 0; i < rowSize; i += 4) {
+      // Two sums to shorten the dependency chain.
+      __m128 sum0 = _mm_mul_ps(weights[0], _mm_loadu_ps(rows[0] + i));
+      __m128 sum1 = _mm_mul_ps(weights[1], _mm_loadu_ps(rows[1] + i));
+      for (size_t k = 2; k < Visuals_Mipmap_NumberOfTaps; k += 2) {
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(weights[k + 0], _mm_loadu_ps(rows[k + 0] + i)));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(weights[k + 1], _mm_loadu_ps(rows[k + 1] + i)));
+      }
+      _mm_storeu_ps(accumulator + i, _mm_add_ps(sum0, sum1));
+    }
+  #else
+    for (size_t i = 0; i < rowSize; ++i) {
+      float sum = 0.f;
+      for (size_t k = 0; k < Visuals_Mipmap_NumberOfTaps; ++k) {
+        sum += weights[k] * rows[k][i];
+      }
+      accumulator[i] = sum;
+    }
+  #endif
+    uint8_t* target = self->target + y * self->targetWidth * n;
+  #if Visuals_Mipmap_WithSse2
+    __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f);
+    __m128 scale = _mm_set1_ps((float)(Visuals_Mipmap_EncodeTableSize - 1)), half = _mm_set1_ps(0.5f);
+    for (size_t x = 0, m = self->targetWidth; x < m; ++x) {
+      // Filters with negative lobes overshoot [0,1].
+      __m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(accumulator + 4 * x), zero), one);
+      int32_t indices[4];
+      _mm_storeu_si128((__m128i*)indices, _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), half)));
+      for (size_t c = 0; c < n; ++c) {
+        target[x * n + c] = encodeTables[c][indices[c]];
+      }
+    }
+  #else
+    for (size_t x = 0, m = self->targetWidth; x < m; ++x) {
+      for (size_t c = 0; c < n; ++c) {
+        target[x * n + c] = Visuals_Mipmap_encode(encodeTables[c], accumulator[4 * x + c]);
+      }
+    }
+  #endif
+  }
+}
+
+Shizu_WarnUnusedReturnValue()Shizu_Integer32
+Visuals_Mipmap_getNumberOfLevels
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  )
+{
+  if (width < 0 || height < 0) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Integer32 size = width > height ? width : height;
+  Shizu_Integer32 numberOfLevels = 1;
+  while (size > 1) {
+    size /= 2;
+    numberOfLevels++;
+  }
+  return numberOfLevels;
+}
+
+bool
+Visuals_Mipmap_tryGenerateLevel
+  (
+    Visuals_MipmapFilter filter,
+    bool sRGB,
+    Visuals_PixelFormat pixelFormat,
+    size_t sourceWidth,
+    size_t sourceHeight,
+    void const* sourcePixels,
+    void* targetPixels
+  )
+{
+  if (Visuals_MipmapFilter_Box != filter && Visuals_MipmapFilter_Kaiser != filter && Visuals_MipmapFilter_Lanczos != filter) {
+    return false;
+  }
+  if (!sourceWidth || !sourceHeight || !sourcePixels || !targetPixels) {
+    return false;
+  }
+  // The number of components and the index of the alpha component or -1.
+  size_t numberOfComponents;
+  int alphaIndex;
+  switch (pixelFormat) {
+    case Visuals_PixelFormat_ABGR_U8:
+    case Visuals_PixelFormat_ARGB_U8: {
+      numberOfComponents = 4;
+      alphaIndex = 0;
+    } break;
+    case Visuals_PixelFormat_BGRA_U8:
+    case Visuals_PixelFormat_RGBA_U8: {
+      numberOfComponents = 4;
+      alphaIndex = 3;
+    } break;
+    case Visuals_PixelFormat_BGR_U8:
+    case Visuals_PixelFormat_RGB_U8: {
+      numberOfComponents = 3;
+      alphaIndex = -1;
+    } break;
+    default: {
+      return false;
+    } break;
+  };
+  Visuals_Mipmap_initializeTables();
+  Visuals_Mipmap_Job job;
+  job.filter = filter;
+  job.sRGB = sRGB;
+  job.numberOfComponents = numberOfComponents;
+  for (size_t c = 0; c < 4; ++c) {
+    size_t i = (sRGB && (int)c != alphaIndex) ? 1 : 0;
+    job.decodeTables[c] = g_decodeTables[i];
+    job.encodeTables[c] = g_encodeTables[i];
+  }
+  job.source = (uint8_t const*)sourcePixels;
+  job.sourceWidth = sourceWidth;
+  job.sourceHeight = sourceHeight;
+  job.target = (uint8_t*)targetPixels;
+  job.targetWidth = sourceWidth > 1 ? sourceWidth / 2 : 1;
+  job.targetHeight = sourceHeight > 1 ? sourceHeight / 2 : 1;
+  job.numberOfBands = (job.targetWidth * job.targetHeight) / Visuals_Mipmap_MinimalNumberOfPixelsPerBand;
+  if (job.numberOfBands > Visuals_Parallel_getNumberOfThreads()) {
+    job.numberOfBands = Visuals_Parallel_getNumberOfThreads();
+  }
+  if (job.numberOfBands > job.targetHeight) {
+    job.numberOfBands = job.targetHeight;
+  }
+  if (job.numberOfBands < 1) {
+    job.numberOfBands = 1;
+  }
+  job.scratch = NULL;
+  job.scratchSize = 0;
+  if (Visuals_MipmapFilter_Box == filter) {
+    Visuals_Parallel_run((Visuals_Parallel_Callback*)&Visuals_Mipmap_Job_runBox, &job, job.numberOfBands);
+  } else {
+    Visuals_Mipmap_getWeights(filter, job.weights);
+    // The ring of rows, the accumulator, and the padded line of each band.
+    job.scratchSize = (Visuals_Mipmap_NumberOfTaps + 1) * 4 * job.targetWidth + 4 * (job.sourceWidth + Visuals_Mipmap_NumberOfTaps - 1);
+    job.scratch = malloc(job.numberOfBands * job.scratchSize * sizeof(float));
+    if (!job.scratch) {
+      return false;
+    }
+    Visuals_Parallel_run((Visuals_Parallel_Callback*)&Visuals_Mipmap_Job_runSeparable, &job, job.numberOfBands);
+    free(job.scratch);
+    job.scratch = NULL;
+  }
+  return true;
+}
+
+void
+Visuals_Mipmap_generateLevel
+  (
+    Shizu_State2* state,
+    Visuals_MipmapFilter filter,
+    Shizu_Boolean sRGB,
+    Visuals_PixelFormat pixelFormat,
+    Shizu_Integer32 sourceWidth,
+    Shizu_Integer32 sourceHeight,
+    void const* sourcePixels,
+    void* targetPixels
+  )
+{
+  if (Visuals_MipmapFilter_Box != filter && Visuals_MipmapFilter_Kaiser != filter && Visuals_MipmapFilter_Lanczos != filter) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  if (sourceWidth <= 0 || sourceHeight <= 0 || !sourcePixels || !targetPixels) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  // Validate the pixel format.
+  (void)Visuals_PixelFormat_getBytesPerPixel(state, pixelFormat);
+  // The arguments were validated above, hence the generation only fails if an allocation fails.
+  if (!Visuals_Mipmap_tryGenerateLevel(filter, sRGB, pixelFormat, (size_t)sourceWidth, (size_t)sourceHeight, sourcePixels, targetPixels)) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+}
+
+static double
+Visuals_Mipmap_getSeconds
+  (
+    void
+  )
+{
+  struct timespec t;
+  timespec_get(&t, TIME_UTC);
+  return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+void
+Visuals_Mipmap_benchmark
+  (
+    Shizu_State2* state,
+    Visuals_MipmapFilter filter,
+    Shizu_Boolean sRGB,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    double* seconds,
+    double* megabytesPerSecond
+  )
+{
+  if (width <= 0 || height <= 0 || !seconds || !megabytesPerSecond) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  size_t numberOfBytes = (size_t)width * (size_t)height * 4;
+  // Level 0 and the levels generated from it.
+  // The levels generated have at most as many pixels as level 0 plus one pixel for each of the at most 32 levels.
+  uint8_t* source = malloc(numberOfBytes);
+  uint8_t* target = malloc(numberOfBytes + 4 * 32);
+  if (!source || !target) {
+    free(target);
+    free(source);
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  for (size_t i = 0; i < numberOfBytes; ++i) {
+    source[i] = (uint8_t)(i * 31 + (i >> 10));
+  }
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    double start = Visuals_Mipmap_getSeconds();
+    // The levels are stored one after another in the target.
+    uint8_t const* p = source;
+    uint8_t* q = target;
+    Shizu_Integer32 w = width, h = height;
+    while (w > 1 || h > 1) {
+      Visuals_Mipmap_generateLevel(state, filter, sRGB, Visuals_PixelFormat_RGBA_U8, w, h, p, q);
+      w = w > 1 ? w / 2 : 1;
+      h = h > 1 ? h / 2 : 1;
+      p = q;
+      q += (size_t)w * (size_t)h * 4;
+    }
+    *seconds = Visuals_Mipmap_getSeconds() - start;
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    free(target);
+    free(source);
+    Shizu_State2_jump(state);
+  }
+  free(target);
+  free(source);
+  *megabytesPerSecond = *seconds > 0. ? ((double)numberOfBytes / (1024. * 1024.)) / *seconds : 0.;
+}
@@ -0,0 +1,122 @@
+/*
+  Zeitgeist
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(VISUALS_MIPMAP_H_INCLUDED)
+#define VISUALS_MIPMAP_H_INCLUDED
+
+#include "Visuals/PixelFormat.h"
+
+/// An enumeration of filters for generating the levels of a mipmap chain.
+Shizu_declareEnumerationType(Visuals_MipmapFilter);
+
+enum Visuals_MipmapFilter {
+  /// No levels are generated.
+  Visuals_MipmapFilter_None,
+  /// Each pixel of a level is the average of 2x2 pixels of the previous level.
+  /// The fastest filter. Blurs and aliases more than the other filters.
+  Visuals_MipmapFilter_Box,
+  /// A Kaiser windowed sinc filter with a radius of three pixels of the level.
+  /// Sharper than the box filter with little ringing.
+  Visuals_MipmapFilter_Kaiser,
+  /// A Lanczos filter with a radius of three pixels of the level.
+  /// The sharpest filter. Can cause ringing at hard edges.
+  Visuals_MipmapFilter_Lanczos,
+};
+
+/// @brief Get the number of levels of a full mipmap chain.
+/// @param state The state.
+/// @param width, height The size, in pixels, of level 0. Must be non-negative.
+/// @return The number of levels including level 0.
+/// The size of level @a i is max(1, width / 2^i) times max(1, height / 2^i).
+Shizu_WarnUnusedReturnValue()Shizu_Integer32
+Visuals_Mipmap_getNumberOfLevels
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  );
+
+/// @brief Generate a level of a mipmap chain from the previous level.
+/// @param state The state.
+/// @param filter The filter. Must not be Visuals_MipmapFilter_None.
+/// @param sRGB If true, the color components are sRGB encoded and filtered in linear space.
+/// The alpha component is always filtered as is.
+/// @param pixelFormat The pixel format of the levels.
+/// @param sourceWidth, sourceHeight The size, in pixels, of the previous level. Must be positive.
+/// @param sourcePixels A pointer to the pixels of the previous level. The rows are tightly packed.
+/// @param targetPixels A pointer to the pixels of the level.
+/// The size of the level is max(1, sourceWidth / 2) times max(1, sourceHeight / 2). The rows are tightly packed.
+/// @remarks
+/// The rows of the level are split into bands filtered by multiple threads.
+/// The filters use SSE2 if available.
+void
+Visuals_Mipmap_generateLevel
+  (
+    Shizu_State2* state,
+    Visuals_MipmapFilter filter,
+    Shizu_Boolean sRGB,
+    Visuals_PixelFormat pixelFormat,
+    Shizu_Integer32 sourceWidth,
+    Shizu_Integer32 sourceHeight,
+    void const* sourcePixels,
+    void* targetPixels
+  );
+
+/// @brief Generate a level of a mipmap chain from the previous level.
+/// @param filter, sRGB, pixelFormat, sourceWidth, sourceHeight, sourcePixels, targetPixels
+/// See Visuals_Mipmap_generateLevel.
+/// @return @a true on success. @a false if an argument is invalid or an allocation failed.
+/// @remarks
+/// Unlike Visuals_Mipmap_generateLevel, this function takes no state and does not jump.
+/// Hence it can be invoked by the callback of a task started by Visuals_Parallel_startTask.
+bool
+Visuals_Mipmap_tryGenerateLevel
+  (
+    Visuals_MipmapFilter filter,
+    bool sRGB,
+    Visuals_PixelFormat pixelFormat,
+    size_t sourceWidth,
+    size_t sourceHeight,
+    void const* sourcePixels,
+    void* targetPixels
+  );
+
+/// @brief Measure the time to generate a full mipmap chain.
+/// @param state The state.
+/// @param filter The filter. Must not be Visuals_MipmapFilter_None.
+/// @param sRGB If true, the color components are sRGB encoded.
+/// @param width, height The size, in pixels, of level 0. Must be positive.
+/// @param seconds A pointer to a variable receiving the time, in seconds, to generate the levels from level 0.
+/// @param megabytesPerSecond A pointer to a variable receiving the throughput, in MB of level 0 per second.
+/// @remarks A texture of size 4096x4096 in the pixel format Visuals_PixelFormat_RGBA_U8 is representative.
+void
+Visuals_Mipmap_benchmark
+  (
+    Shizu_State2* state,
+    Visuals_MipmapFilter filter,
+    Shizu_Boolean sRGB,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    double* seconds,
+    double* megabytesPerSecond
+  );
+
+#endif // VISUALS_MIPMAP_H_INCLUDED
@@ -0,0 +1,575 @@
+/*
+  Zeitgeist
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Visuals/Parallel.h"
+
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  #define WIN32_LEAN_AND_MEAN
+  #include <Windows.h>
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  // pthread_create, pthread_join, pthread_mutex_*, pthread_cond_*
+  #include <pthread.h>
+  // sysconf
+  #include <unistd.h>
+#else
+  #error("operating system not (yet) supported")
+#endif
+
+// malloc, free
+#include <malloc.h>
+
+/// @brief An item of work queued to the threads of the pool.
+typedef struct Visuals_Parallel_Work Visuals_Parallel_Work;
+
+struct Visuals_Parallel_Work {
+  /// @brief A pointer to the next item of the queue or the null pointer.
+  Visuals_Parallel_Work* next;
+  /// @brief The function performing the work of this item.
+  void (*run)(Visuals_Parallel_Work* self);
+  /// @brief A pointer to the number of unfinished items of the call which queued this item.
+  size_t* remaining;
+};
+
+/// @brief The thread pool.
+/// The threads are started by Visuals_Parallel_startup and joined by Visuals_Parallel_shutdown.
+/// The items are queued in FIFO order. The pool does not allocate: the items are owned by the calls which queued them.
+static struct {
+  /// @brief The number of threads of the pool. Zero if the pool is not started.
+  size_t numberOfWorkers;
+  /// @brief If the threads of the pool must exit once the queue is empty.
+  bool quit;
+  Visuals_Parallel_Work* first;
+  Visuals_Parallel_Work* last;
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  CRITICAL_SECTION mutex;
+  /// @brief Signaled if an item was queued or the threads must exit.
+  CONDITION_VARIABLE workAvailable;
+  /// @brief Signaled if an item was finished.
+  CONDITION_VARIABLE workDone;
+  HANDLE workers[Visuals_Parallel_MaximalNumberOfThreads - 1];
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  pthread_mutex_t mutex;
+  /// @brief Signaled if an item was queued or the threads must exit.
+  pthread_cond_t workAvailable;
+  /// @brief Signaled if an item was finished.
+  pthread_cond_t workDone;
+  pthread_t workers[Visuals_Parallel_MaximalNumberOfThreads - 1];
+#endif
+} g_pool = {
+  .numberOfWorkers = 0,
+  .quit = false,
+  .first = NULL,
+  .last = NULL,
+};
+
+static inline void
+Visuals_Parallel_lock
+  (
+    void
+  )
+{
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  EnterCriticalSection(&g_pool.mutex);
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  pthread_mutex_lock(&g_pool.mutex);
+#endif
+}
+
+static inline void
+Visuals_Parallel_unlock
+  (
+    void
+  )
+{
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  LeaveCriticalSection(&g_pool.mutex);
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  pthread_mutex_unlock(&g_pool.mutex);
+#endif
+}
+
+// Enqueue an item. The pool must be locked.
+static inline void
+Visuals_Parallel_enqueue
+  (
+    Visuals_Parallel_Work* work
+  )
+{
+  work->next = NULL;
+  if (g_pool.last) {
+    g_pool.last->next = work;
+  } else {
+    g_pool.first = work;
+  }
+  g_pool.last = work;
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  WakeConditionVariable(&g_pool.workAvailable);
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  pthread_cond_signal(&g_pool.workAvailable);
+#endif
+}
+
+// Dequeue an item. The pool must be locked.
+// Return the null pointer if the queue is empty.
+static inline Visuals_Parallel_Work*
+Visuals_Parallel_dequeue
+  (
+    void
+  )
+{
+  Visuals_Parallel_Work* work = g_pool.first;
+  if (work) {
+    g_pool.first = work->next;
+    if (!g_pool.first) {
+      g_pool.last = NULL;
+    }
+  }
+  return work;
+}
+
+// Perform the work of an item. The pool must be locked.
+// The pool is unlocked while the work is performed.
+static inline void
+Visuals_Parallel_perform
+  (
+    Visuals_Parallel_Work* work
+  )
+{
+  Visuals_Parallel_unlock();
+  work->run(work);
+  Visuals_Parallel_lock();
+  (*work->remaining)--;
+  // The item must not be accessed after this point: It is released by the call which queued it.
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  WakeAllConditionVariable(&g_pool.workDone);
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  pthread_cond_broadcast(&g_pool.workDone);
+#endif
+}
+
+// Wait until the items of a call are finished.
+// While waiting, the calling thread performs queued items.
+// Hence calls from the threads of the pool do not deadlock.
+static void
+Visuals_Parallel_wait
+  (
+    size_t* remaining
+  )
+{
+  Visuals_Parallel_lock();
+  while (*remaining) {
+    Visuals_Parallel_Work* work = Visuals_Parallel_dequeue();
+    if (work) {
+      Visuals_Parallel_perform(work);
+    } else {
+    #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+      SleepConditionVariableCS(&g_pool.workDone, &g_pool.mutex, INFINITE);
+    #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+      pthread_cond_wait(&g_pool.workDone, &g_pool.mutex);
+    #endif
+    }
+  }
+  Visuals_Parallel_unlock();
+}
+
+static void
+Visuals_Parallel_Worker_run
+  (
+    void
+  )
+{
+  Visuals_Parallel_lock();
+  while (true) {
+    Visuals_Parallel_Work* work = Visuals_Parallel_dequeue();
+    if (work) {
+      Visuals_Parallel_perform(work);
+    } else if (g_pool.quit) {
+      break;
+    } else {
+    #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+      SleepConditionVariableCS(&g_pool.workAvailable, &g_pool.mutex, INFINITE);
+    #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+      pthread_cond_wait(&g_pool.workAvailable, &g_pool.mutex);
+    #endif
+    }
+  }
+  Visuals_Parallel_unlock();
+}
+
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+
+static DWORD WINAPI
+Visuals_Parallel_Worker_main
+  (
+    LPVOID parameter
+  )
+{
+  Visuals_Parallel_Worker_run();
+  return 0;
+}
+
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+
+static void*
+Visuals_Parallel_Worker_main
+  (
+    void* parameter
+  )
+{
+  Visuals_Parallel_Worker_run();
+  return NULL;
+}
+
+#endif
+
+/// @brief A contiguous range of bands processed by a thread.
+typedef struct Visuals_Parallel_Range {
+  Visuals_Parallel_Work work;
+  Visuals_Parallel_Callback* callback;
+  void* context;
+  size_t start;
+  size_t end;
+} Visuals_Parallel_Range;
+
+static void
+Visuals_Parallel_Range_run
+  (
+    Visuals_Parallel_Range const* self
+  )
+{
+  for (size_t i = self->start; i < self->end; ++i) {
+    self->callback(self->context, i);
+  }
+}
+
+static void
+Visuals_Parallel_Range_perform
+  (
+    Visuals_Parallel_Work* work
+  )
+{ Visuals_Parallel_Range_run((Visuals_Parallel_Range const*)work); }
+
+struct Visuals_Parallel_Task {
+  Visuals_Parallel_Work work;
+  Visuals_Parallel_Callback* callback;
+  void* context;
+  /// @brief One until the callback returned, zero afterwards.
+  size_t remaining;
+};
+
+static void
+Visuals_Parallel_Task_perform
+  (
+    Visuals_Parallel_Work* work
+  )
+{
+  Visuals_Parallel_Task* task = (Visuals_Parallel_Task*)work;
+  task->callback(task->context, 0);
+}
+
+/// @brief A queue of items claimed by threads.
+typedef struct Visuals_Parallel_Queue {
+  Visuals_Parallel_Callback* callback;
+  void* context;
+  size_t numberOfItems;
+  /// @brief The index of the next unclaimed item.
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  LONG64 volatile next;
+#else
+  size_t next;
+#endif
+} Visuals_Parallel_Queue;
+
+static void
+Visuals_Parallel_Queue_run
+  (
+    Visuals_Parallel_Queue* self
+  )
+{
+  while (true) {
+  #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+    size_t i = (size_t)(InterlockedIncrement64(&self->next) - 1);
+  #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+    size_t i = __atomic_fetch_add(&self->next, 1, __ATOMIC_RELAXED);
+  #endif
+    if (i >= self->numberOfItems) {
+      break;
+    }
+    self->callback(self->context, i);
+  }
+}
+
+/// @brief A thread claiming items of a queue.
+typedef struct Visuals_Parallel_QueueWork {
+  Visuals_Parallel_Work work;
+  Visuals_Parallel_Queue* queue;
+} Visuals_Parallel_QueueWork;
+
+static void
+Visuals_Parallel_QueueWork_perform
+  (
+    Visuals_Parallel_Work* work
+  )
+{ Visuals_Parallel_Queue_run(((Visuals_Parallel_QueueWork*)work)->queue); }
+
+void
+Visuals_Parallel_startup
+  (
+    void
+  )
+{
+  if (g_pool.numberOfWorkers) {
+    return;
+  }
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  size_t numberOfProcessors = systemInfo.dwNumberOfProcessors > 0 ? (size_t)systemInfo.dwNumberOfProcessors : 1;
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  long temporary = sysconf(_SC_NPROCESSORS_ONLN);
+  size_t numberOfProcessors = temporary > 0 ? (size_t)temporary : 1;
+#endif
+  // The calling threads participate in the work.
+  size_t numberOfWorkers = (numberOfProcessors < Visuals_Parallel_MaximalNumberOfThreads ? numberOfProcessors : Visuals_Parallel_MaximalNumberOfThreads) - 1;
+  if (!numberOfWorkers) {
+    return;
+  }
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  InitializeCriticalSection(&g_pool.mutex);
+  InitializeConditionVariable(&g_pool.workAvailable);
+  InitializeConditionVariable(&g_pool.workDone);
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  if (pthread_mutex_init(&g_pool.mutex, NULL)) {
+    return;
+  }
+  if (pthread_cond_init(&g_pool.workAvailable, NULL)) {
+    pthread_mutex_destroy(&g_pool.mutex);
+    return;
+  }
+  if (pthread_cond_init(&g_pool.workDone, NULL)) {
+    pthread_cond_destroy(&g_pool.workAvailable);
+    pthread_mutex_destroy(&g_pool.mutex);
+    return;
+  }
+#endif
+  g_pool.quit = false;
+  g_pool.first = NULL;
+  g_pool.last = NULL;
+  // If a thread can not be created, the pool has fewer threads.
+  size_t numberOfStartedWorkers = 0;
+  for (size_t i = 0; i < numberOfWorkers; ++i) {
+  #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+    g_pool.workers[numberOfStartedWorkers] = CreateThread(NULL, 0, &Visuals_Parallel_Worker_main, NULL, 0, NULL);
+    if (!g_pool.workers[numberOfStartedWorkers]) {
+      break;
+    }
+  #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+    if (pthread_create(&g_pool.workers[numberOfStartedWorkers], NULL, &Visuals_Parallel_Worker_main, NULL)) {
+      break;
+    }
+  #endif
+    numberOfStartedWorkers++;
+  }
+  if (!numberOfStartedWorkers) {
+  #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+    DeleteCriticalSection(&g_pool.mutex);
+  #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+    pthread_cond_destroy(&g_pool.workDone);
+    pthread_cond_destroy(&g_pool.workAvailable);
+    pthread_mutex_destroy(&g_pool.mutex);
+  #endif
+    return;
+  }
+  g_pool.numberOfWorkers = numberOfStartedWorkers;
+}
+
+void
+Visuals_Parallel_shutdown
+  (
+    void
+  )
+{
+  if (!g_pool.numberOfWorkers) {
+    return;
+  }
+  Visuals_Parallel_lock();
+  g_pool.quit = true;
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  WakeAllConditionVariable(&g_pool.workAvailable);
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  pthread_cond_broadcast(&g_pool.workAvailable);
+#endif
+  Visuals_Parallel_unlock();
+  for (size_t i = 0; i < g_pool.numberOfWorkers; ++i) {
+  #if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+    WaitForSingleObject(g_pool.workers[i], INFINITE);
+    CloseHandle(g_pool.workers[i]);
+  #elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+    pthread_join(g_pool.workers[i], NULL);
+  #endif
+  }
+#if Shizu_Configuration_OperatingSystem_Windows == Shizu_Configuration_OperatingSystem
+  DeleteCriticalSection(&g_pool.mutex);
+#elif Shizu_Configuration_OperatingSystem_Linux == Shizu_Configuration_OperatingSystem
+  pthread_cond_destroy(&g_pool.workDone);
+  pthread_cond_destroy(&g_pool.workAvailable);
+  pthread_mutex_destroy(&g_pool.mutex);
+#endif
+  g_pool.numberOfWorkers = 0;
+  g_pool.quit = false;
+}
+
+size_t
+Visuals_Parallel_getNumberOfThreads
+  (
+    void
+  )
+{ return g_pool.numberOfWorkers + 1; }
+
+void
+Visuals_Parallel_run
+  (
+    Visuals_Parallel_Callback* callback,
+    void* context,
+    size_t numberOfBands
+  )
+{
+  size_t numberOfThreads = Visuals_Parallel_getNumberOfThreads();
+  if (numberOfThreads > numberOfBands) {
+    numberOfThreads = numberOfBands;
+  }
+  if (numberOfThreads <= 1) {
+    for (size_t i = 0; i < numberOfBands; ++i) {
+      callback(context, i);
+    }
+    return;
+  }
+  Visuals_Parallel_Range ranges[Visuals_Parallel_MaximalNumberOfThreads];
+  size_t remaining = numberOfThreads - 1;
+  for (size_t i = 0; i < numberOfThreads; ++i) {
+    ranges[i].work.run = &Visuals_Parallel_Range_perform;
+    ranges[i].work.remaining = &remaining;
+    ranges[i].callback = callback;
+    ranges[i].context = context;
+    ranges[i].start = (numberOfBands * i) / numberOfThreads;
+    ranges[i].end = (numberOfBands * (i + 1)) / numberOfThreads;
+  }
+  Visuals_Parallel_lock();
+  for (size_t i = 0; i < numberOfThreads - 1; ++i) {
+    Visuals_Parallel_enqueue(&ranges[i].work);
+  }
+  Visuals_Parallel_unlock();
+  Visuals_Parallel_Range_run(&ranges[numberOfThreads - 1]);
+  Visuals_Parallel_wait(&remaining);
+}
+
+void
+Visuals_Parallel_runDynamic
+  (
+    Visuals_Parallel_Callback* callback,
+    void* context,
+    size_t numberOfItems
+  )
+{
+  size_t numberOfThreads = Visuals_Parallel_getNumberOfThreads();
+  if (numberOfThreads > numberOfItems) {
+    numberOfThreads = numberOfItems;
+  }
+  if (numberOfThreads <= 1) {
+    for (size_t i = 0; i < numberOfItems; ++i) {
+      callback(context, i);
+    }
+    return;
+  }
+  Visuals_Parallel_Queue queue;
+  queue.callback = callback;
+  queue.context = context;
+  queue.numberOfItems = numberOfItems;
+  queue.next = 0;
+  // If the threads of the pool are busy, the calling thread claims their share of the items.
+  Visuals_Parallel_QueueWork works[Visuals_Parallel_MaximalNumberOfThreads - 1];
+  size_t remaining = numberOfThreads - 1;
+  Visuals_Parallel_lock();
+  for (size_t i = 0; i < numberOfThreads - 1; ++i) {
+    works[i].work.run = &Visuals_Parallel_QueueWork_perform;
+    works[i].work.remaining = &remaining;
+    works[i].queue = &queue;
+    Visuals_Parallel_enqueue(&works[i].work);
+  }
+  Visuals_Parallel_unlock();
+  Visuals_Parallel_Queue_run(&queue);
+  Visuals_Parallel_wait(&remaining);
+}
+
+Visuals_Parallel_Task*
+Visuals_Parallel_startTask
+  (
+    Visuals_Parallel_Callback* callback,
+    void* context
+  )
+{
+  if (!g_pool.numberOfWorkers) {
+    callback(context, 0);
+    return NULL;
+  }
+  Visuals_Parallel_Task* task = malloc(sizeof(Visuals_Parallel_Task));
+  if (!task) {
+    callback(context, 0);
+    return NULL;
+  }
+  task->work.run = &Visuals_Parallel_Task_perform;
+  task->work.remaining = &task->remaining;
+  task->callback = callback;
+  task->context = context;
+  task->remaining = 1;
+  Visuals_Parallel_lock();
+  Visuals_Parallel_enqueue(&task->work);
+  Visuals_Parallel_unlock();
+  return task;
+}
+
+bool
+Visuals_Parallel_isTaskDone
+  (
+    Visuals_Parallel_Task* task
+  )
+{
+  if (!task) {
+    return true;
+  }
+  Visuals_Parallel_lock();
+  bool done = !task->remaining;
+  Visuals_Parallel_unlock();
+  return done;
+}
+
+void
+Visuals_Parallel_joinTask
+  (
+    Visuals_Parallel_Task* task
+  )
+{
+  if (!task) {
+    return;
+  }
+  Visuals_Parallel_wait(&task->remaining);
+  free(task);
+}
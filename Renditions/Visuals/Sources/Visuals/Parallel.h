@@ -0,0 +1,134 @@
+/*
+  Zeitgeist
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(VISUALS_PARALLEL_H_INCLUDED)
+#define VISUALS_PARALLEL_H_INCLUDED
+
+#include "Zeitgeist.h"
+
+/// @brief The maximal number of threads Visuals_Parallel_run splits work among.
+#define Visuals_Parallel_MaximalNumberOfThreads (8)
+
+/// @brief A callback invoked by Visuals_Parallel_run for a band of work.
+/// @param context The context passed to Visuals_Parallel_run.
+/// @param index The index of the band.
+/// @remarks The callback must not jump.
+typedef void (Visuals_Parallel_Callback)(void* context, size_t index);
+
+/// @brief Start the thread pool.
+/// @remarks
+/// The pool has one thread less than the number of processors but at most Visuals_Parallel_MaximalNumberOfThreads - 1 threads.
+/// The threads are started once and wait for work until Visuals_Parallel_shutdown is invoked.
+/// If the pool is not started, all work is done by the calling threads.
+/// Invoked by the visuals service when it starts up.
+void
+Visuals_Parallel_startup
+  (
+    void
+  );
+
+/// @brief Join the threads of the thread pool.
+/// @remarks All tasks must have been joined.
+/// Invoked by the visuals service when it shuts down.
+void
+Visuals_Parallel_shutdown
+  (
+    void
+  );
+
+/// @brief Get the number of threads Visuals_Parallel_run splits work among.
+/// @return The number of threads of the pool plus one for the calling thread.
+size_t
+Visuals_Parallel_getNumberOfThreads
+  (
+    void
+  );
+
+/// @brief Invoke a callback for the bands @a 0 to @a numberOfBands - 1.
+/// @param callback The callback.
+/// @param context The context passed to the callback.
+/// @param numberOfBands The number of bands.
+/// @remarks
+/// The bands are split into contiguous ranges among Visuals_Parallel_getNumberOfThreads threads.
+/// The calling thread processes the last range and returns after all bands were processed.
+/// While it waits, it processes ranges not yet claimed by the threads of the pool.
+void
+Visuals_Parallel_run
+  (
+    Visuals_Parallel_Callback* callback,
+    void* context,
+    size_t numberOfBands
+  );
+
+/// @brief Invoke a callback for the items @a 0 to @a numberOfItems - 1.
+/// @param callback The callback.
+/// @param context The context passed to the callback.
+/// @param numberOfItems The number of items.
+/// @remarks
+/// Unlike Visuals_Parallel_run, the items are not split into ranges in advance.
+/// Each thread claims the next unprocessed item by incrementing a shared counter until all items are claimed.
+/// Hence the threads balance items of varying cost among themselves.
+/// The calling thread participates and returns after all items were processed.
+void
+Visuals_Parallel_runDynamic
+  (
+    Visuals_Parallel_Callback* callback,
+    void* context,
+    size_t numberOfItems
+  );
+
+/// @brief A callback started by Visuals_Parallel_startTask.
+typedef struct Visuals_Parallel_Task Visuals_Parallel_Task;
+
+/// @brief Invoke a callback for the band @a 0 on a thread of the pool and return without waiting for the callback.
+/// @param callback The callback.
+/// @param context The context passed to the callback.
+/// @return A pointer to the task which must be passed to Visuals_Parallel_joinTask.
+/// The null pointer if the pool is not started. In that case, the calling thread invoked the callback.
+/// @remarks The callback runs concurrently to the calling thread.
+/// Both must not modify data read by the other until the task was joined.
+Visuals_Parallel_Task*
+Visuals_Parallel_startTask
+  (
+    Visuals_Parallel_Callback* callback,
+    void* context
+  );
+
+/// @brief Get if the callback of a task returned.
+/// @param task A pointer to the task returned by Visuals_Parallel_startTask or the null pointer.
+/// @return @a true if the callback returned or @a task is the null pointer, @a false otherwise.
+/// @remarks Does not wait. The task must still be joined by Visuals_Parallel_joinTask.
+bool
+Visuals_Parallel_isTaskDone
+  (
+    Visuals_Parallel_Task* task
+  );
+
+/// @brief Wait for the callback of a task to return and destroy the task.
+/// If no thread of the pool has started the callback yet, the calling thread invokes it.
+/// @param task A pointer to the task returned by Visuals_Parallel_startTask or the null pointer.
+void
+Visuals_Parallel_joinTask
+  (
+    Visuals_Parallel_Task* task
+  );
+
+#endif // VISUALS_PARALLEL_H_INCLUDED
@@ -21,6 +21,37 @@
 
 #include "Visuals/PixelFormat.h"
 
+#include "Visuals/Parallel.h"
+
+// The shuffle kernels are only available on x86 and x64.
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+  #define Visuals_PixelFormat_WithShuffleKernels (1)
+#else
+  #define Visuals_PixelFormat_WithShuffleKernels (0)
+#endif
+
+#if Visuals_PixelFormat_WithShuffleKernels
+  #if defined(_MSC_VER)
+    // __cpuid, __cpuidex, _xgetbv
+    #include <intrin.h>
+    // MSVC allows for intrinsics of any instruction set in any function.
+    #define Visuals_PixelFormat_Target(x)
+  #else
+    // GCC and Clang allow for intrinsics of an instruction set in functions compiled for that instruction set.
+    #define Visuals_PixelFormat_Target(x) __attribute__((target(x)))
+  #endif
+  #include <immintrin.h>
+#endif
+
+// malloc, free
+#include <stdlib.h>
+
+// memcpy, memcmp
+#include <string.h>
+
+// timespec_get
+#include <time.h>
+
 Shizu_defineEnumerationType("Zeitgeist.Visuals.PixelFormat", Visuals_PixelFormat);
 
 Shizu_WarnUnusedReturnValue()Shizu_Integer32
@@ -96,3 +127,515 @@ Visuals_PixelFormat_getComponents
     } break;
   };
 }
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/// The minimal number of pixels of a band of rows converted by a thread.
+#define Visuals_PixelFormat_MinimalNumberOfPixelsPerBand (256 * 256)
+
+typedef struct Visuals_PixelFormat_Conversion Visuals_PixelFormat_Conversion;
+
+/// @brief A kernel converting a prefix of a row of pixels.
+/// @return The number of pixels converted.
+typedef size_t (Visuals_PixelFormat_Kernel)(Visuals_PixelFormat_Conversion const* conversion, uint8_t* target, uint8_t const* source, size_t numberOfPixels);
+
+struct Visuals_PixelFormat_Conversion {
+  /// The number of Bytes per source pixel.
+  size_t sourceBytesPerPixel;
+  /// The number of Bytes per target pixel.
+  size_t targetBytesPerPixel;
+  /// For each Byte of a target pixel the index of the source Byte or -1 for an opaque alpha component.
+  int8_t map[4];
+  /// The shuffle mask for four pixels.
+  /// For each Byte of four target pixels the index of the source Byte or 0x80 for zero.
+  uint8_t mask[16];
+  /// The values ORed into four target pixels.
+  uint8_t fill[16];
+  /// The kernel or null.
+  Visuals_PixelFormat_Kernel* kernel;
+};
+
+/// @brief Get the offsets of the red, green, blue, and alpha component in a pixel of a pixel format.
+/// The offset of the alpha component is -1 if the pixel format has no alpha component.
+static void
+Visuals_PixelFormat_getOffsets
+  (
+    Visuals_PixelFormat self,
+    int8_t offsets[4]
+  )
+{
+  static const int8_t OFFSETS[][4] = {
+    [Visuals_PixelFormat_ABGR_U8] = { 3, 2, 1, 0 },
+    [Visuals_PixelFormat_ARGB_U8] = { 1, 2, 3, 0 },
+    [Visuals_PixelFormat_BGR_U8] = { 2, 1, 0, -1 },
+    [Visuals_PixelFormat_BGRA_U8] = { 2, 1, 0, 3 },
+    [Visuals_PixelFormat_RGB_U8] = { 0, 1, 2, -1 },
+    [Visuals_PixelFormat_RGBA_U8] = { 0, 1, 2, 3 },
+  };
+  memcpy(offsets, OFFSETS[self], 4);
+}
+
+Shizu_WarnUnusedReturnValue()Shizu_Integer32
+Visuals_PixelFormat_getAlphaIndex
+  (
+    Shizu_State2* state,
+    Visuals_PixelFormat self
+  )
+{
+  // Validate the pixel format.
+  (void)Visuals_PixelFormat_getBytesPerPixel(state, self);
+  int8_t offsets[4];
+  Visuals_PixelFormat_getOffsets(self, offsets);
+  return offsets[3];
+}
+
+static size_t
+Visuals_PixelFormat_convertScalar
+  (
+    Visuals_PixelFormat_Conversion const* conversion,
+    uint8_t* target,
+    uint8_t const* source,
+    size_t numberOfPixels
+  )
+{
+  int8_t const* map = conversion->map;
+  size_t sourceBytesPerPixel = conversion->sourceBytesPerPixel;
+  if (conversion->targetBytesPerPixel == 4) {
+    for (size_t i = 0; i < numberOfPixels; ++i) {
+      target[0] = map[0] < 0 ? 255 : source[map[0]];
+      target[1] = map[1] < 0 ? 255 : source[map[1]];
+      target[2] = map[2] < 0 ? 255 : source[map[2]];
+      target[3] = map[3] < 0 ? 255 : source[map[3]];
+      target += 4;
+      source += sourceBytesPerPixel;
+    }
+  } else {
+    // A target pixel without an alpha component never receives an opaque alpha component.
+    for (size_t i = 0; i < numberOfPixels; ++i) {
+      target[0] = source[map[0]];
+      target[1] = source[map[1]];
+      target[2] = source[map[2]];
+      target += 3;
+      source += sourceBytesPerPixel;
+    }
+  }
+  return numberOfPixels;
+}
+
+#if Visuals_PixelFormat_WithShuffleKernels
+
+Visuals_PixelFormat_Target("ssse3") static size_t
+Visuals_PixelFormat_convertSsse3
+  (
+    Visuals_PixelFormat_Conversion const* conversion,
+    uint8_t* target,
+    uint8_t const* source,
+    size_t numberOfPixels
+  )
+{
+  size_t sourceBytesPerPixel = conversion->sourceBytesPerPixel;
+  size_t targetBytesPerPixel = conversion->targetBytesPerPixel;
+  __m128i mask = _mm_loadu_si128((__m128i const*)conversion->mask);
+  __m128i fill = _mm_loadu_si128((__m128i const*)conversion->fill);
+  // Four pixels are converted at a time. 16 Bytes are loaded even if the source pixels have 3 Bytes.
+  size_t i = 0;
+  while (numberOfPixels - i >= 4 && (numberOfPixels - i) * sourceBytesPerPixel >= 16) {
+    __m128i pixels = _mm_loadu_si128((__m128i const*)source);
+    pixels = _mm_or_si128(_mm_shuffle_epi8(pixels, mask), fill);
+    if (targetBytesPerPixel == 4) {
+      _mm_storeu_si128((__m128i*)target, pixels);
+    } else {
+      _mm_storel_epi64((__m128i*)target, pixels);
+      uint32_t x = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(pixels, 8));
+      memcpy(target + 8, &x, 4);
+    }
+    source += 4 * sourceBytesPerPixel;
+    target += 4 * targetBytesPerPixel;
+    i += 4;
+  }
+  return i;
+}
+
+Visuals_PixelFormat_Target("avx2") static size_t
+Visuals_PixelFormat_convertAvx2
+  (
+    Visuals_PixelFormat_Conversion const* conversion,
+    uint8_t* target,
+    uint8_t const* source,
+    size_t numberOfPixels
+  )
+{
+  size_t sourceBytesPerPixel = conversion->sourceBytesPerPixel;
+  size_t targetBytesPerPixel = conversion->targetBytesPerPixel;
+  // _mm256_shuffle_epi8 does not cross the 128 bit lanes. Each lane holds four pixels.
+  __m256i mask = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i const*)conversion->mask));
+  __m256i fill = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i const*)conversion->fill));
+  // Move the source Bytes 12 to 27 of eight 3 Byte pixels into the upper lane.
+  __m256i spread = _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6);
+  // Move the target Bytes 16 to 27 of eight 3 Byte pixels from the upper lane next to the lower lane's 12 Bytes.
+  __m256i pack = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+  // Eight pixels are converted at a time. 32 Bytes are loaded even if the source pixels have 3 Bytes.
+  size_t i = 0;
+  while (numberOfPixels - i >= 8 && (numberOfPixels - i) * sourceBytesPerPixel >= 32) {
+    __m256i pixels = _mm256_loadu_si256((__m256i const*)source);
+    if (sourceBytesPerPixel == 3) {
+      pixels = _mm256_permutevar8x32_epi32(pixels, spread);
+    }
+    pixels = _mm256_or_si256(_mm256_shuffle_epi8(pixels, mask), fill);
+    if (targetBytesPerPixel == 4) {
+      _mm256_storeu_si256((__m256i*)target, pixels);
+    } else {
+      pixels = _mm256_permutevar8x32_epi32(pixels, pack);
+      _mm_storeu_si128((__m128i*)target, _mm256_castsi256_si128(pixels));
+      _mm_storel_epi64((__m128i*)(target + 16), _mm256_extracti128_si256(pixels, 1));
+    }
+    source += 8 * sourceBytesPerPixel;
+    target += 8 * targetBytesPerPixel;
+    i += 8;
+  }
+  return i;
+}
+
+/// @brief Get the best kernel supported by the CPU.
+static Visuals_PixelFormat_Kernel*
+Visuals_PixelFormat_getKernel
+  (
+    void
+  )
+{
+  static int g_kernel = -1;
+  if (g_kernel == -1) {
+    int kernel = 0;
+  #if defined(_MSC_VER)
+    int registers[4];
+    __cpuid(registers, 0);
+    int numberOfLeaves = registers[0];
+    __cpuid(registers, 1);
+    bool ssse3 = 0 != (registers[2] & (1 << 9));
+    bool avx = 0 != (registers[2] & (1 << 27)) /* OSXSAVE */ && 0 != (registers[2] & (1 << 28)) /* AVX */
+            && 6 == (_xgetbv(0) & 6);
+    bool avx2 = false;
+    if (avx && numberOfLeaves >= 7) {
+      __cpuidex(registers, 7, 0);
+      avx2 = 0 != (registers[1] & (1 << 5));
+    }
+  #else
+    __builtin_cpu_init();
+    bool ssse3 = __builtin_cpu_supports("ssse3");
+    bool avx2 = __builtin_cpu_supports("avx2");
+  #endif
+    if (avx2) {
+      kernel = 2;
+    } else if (ssse3) {
+      kernel = 1;
+    }
+    g_kernel = kernel;
+  }
+  switch (g_kernel) {
+    case 2: {
+      return &Visuals_PixelFormat_convertAvx2;
+    } break;
+    case 1: {
+      return &Visuals_PixelFormat_convertSsse3;
+    } break;
+    default: {
+      return NULL;
+    } break;
+  };
+}
+
+#endif
+
+/// @brief Get if a value is a pixel format.
+static inline bool
+Visuals_PixelFormat_isValid
+  (
+    Visuals_PixelFormat self
+  )
+{ return Visuals_PixelFormat_ABGR_U8 <= self && self <= Visuals_PixelFormat_RGBA_U8; }
+
+/// @brief Initialize a conversion.
+/// The pixel formats must be valid.
+static void
+Visuals_PixelFormat_Conversion_initialize
+  (
+    Visuals_PixelFormat_Conversion* self,
+    Visuals_PixelFormat targetPixelFormat,
+    Visuals_PixelFormat sourcePixelFormat
+  )
+{
+  int8_t sourceOffsets[4], targetOffsets[4];
+  Visuals_PixelFormat_getOffsets(sourcePixelFormat, sourceOffsets);
+  Visuals_PixelFormat_getOffsets(targetPixelFormat, targetOffsets);
+  // A pixel format without an alpha component has three Bytes per pixel.
+  self->sourceBytesPerPixel = -1 == sourceOffsets[3] ? 3 : 4;
+  self->targetBytesPerPixel = -1 == targetOffsets[3] ? 3 : 4;
+  for (size_t i = 0; i < 4; ++i) {
+    if (targetOffsets[i] != -1) {
+      self->map[targetOffsets[i]] = sourceOffsets[i];
+    }
+  }
+  memset(self->mask, 0x80, sizeof(self->mask));
+  memset(self->fill, 0, sizeof(self->fill));
+  for (size_t i = 0; i < 4; ++i) {
+    for (size_t j = 0; j < self->targetBytesPerPixel; ++j) {
+      int8_t k = self->map[j];
+      if (k < 0) {
+        self->fill[i * self->targetBytesPerPixel + j] = 255;
+      } else {
+        self->mask[i * self->targetBytesPerPixel + j] = (uint8_t)(i * self->sourceBytesPerPixel + (size_t)k);
+      }
+    }
+  }
+#if Visuals_PixelFormat_WithShuffleKernels
+  self->kernel = Visuals_PixelFormat_getKernel();
+#else
+  self->kernel = NULL;
+#endif
+}
+
+/// @brief A conversion of the rows of an image split into bands.
+typedef struct Visuals_PixelFormat_Job {
+  Visuals_PixelFormat_Conversion const* conversion;
+  uint8_t* target;
+  size_t targetStride;
+  uint8_t const* source;
+  size_t sourceStride;
+  size_t width;
+  size_t height;
+  size_t numberOfBands;
+} Visuals_PixelFormat_Job;
+
+static void
+Visuals_PixelFormat_Job_run
+  (
+    Visuals_PixelFormat_Job const* self,
+    size_t band
+  )
+{
+  Visuals_PixelFormat_Conversion const* conversion = self->conversion;
+  size_t start = (self->height * band) / self->numberOfBands,
+         end = (self->height * (band + 1)) / self->numberOfBands;
+  for (size_t y = start; y < end; ++y) {
+    uint8_t* target = self->target + y * self->targetStride;
+    uint8_t const* source = self->source + y * self->sourceStride;
+    size_t i = 0;
+    if (conversion->kernel) {
+      i = conversion->kernel(conversion, target, source, self->width);
+    }
+    Visuals_PixelFormat_convertScalar(conversion, target + i * conversion->targetBytesPerPixel,
+                                      source + i * conversion->sourceBytesPerPixel, self->width - i);
+  }
+}
+
+bool
+Visuals_PixelFormat_tryConvert
+  (
+    Visuals_PixelFormat targetPixelFormat,
+    void* targetPixels,
+    size_t targetStride,
+    Visuals_PixelFormat sourcePixelFormat,
+    void const* sourcePixels,
+    size_t sourceStride,
+    size_t width,
+    size_t height
+  )
+{
+  if (!targetPixels || !sourcePixels) {
+    return false;
+  }
+  if (!Visuals_PixelFormat_isValid(targetPixelFormat) || !Visuals_PixelFormat_isValid(sourcePixelFormat)) {
+    return false;
+  }
+  Visuals_PixelFormat_Conversion conversion;
+  Visuals_PixelFormat_Conversion_initialize(&conversion, targetPixelFormat, sourcePixelFormat);
+  if (targetStride < width * conversion.targetBytesPerPixel || sourceStride < width * conversion.sourceBytesPerPixel) {
+    return false;
+  }
+  if (0 == width || 0 == height) {
+    return true;
+  }
+  if (targetPixelFormat == sourcePixelFormat) {
+    for (size_t y = 0; y < height; ++y) {
+      memcpy((uint8_t*)targetPixels + y * targetStride, (uint8_t const*)sourcePixels + y * sourceStride, width * conversion.targetBytesPerPixel);
+    }
+    return true;
+  }
+  // Split the rows of large images into bands converted by multiple threads.
+  size_t numberOfBands = (width * height) / Visuals_PixelFormat_MinimalNumberOfPixelsPerBand;
+  if (numberOfBands > Visuals_Parallel_getNumberOfThreads()) {
+    numberOfBands = Visuals_Parallel_getNumberOfThreads();
+  }
+  if (numberOfBands > height) {
+    numberOfBands = height;
+  }
+  if (numberOfBands < 1) {
+    numberOfBands = 1;
+  }
+  Visuals_PixelFormat_Job job = {
+    .conversion = &conversion,
+    .target = (uint8_t*)targetPixels,
+    .targetStride = targetStride,
+    .source = (uint8_t const*)sourcePixels,
+    .sourceStride = sourceStride,
+    .width = width,
+    .height = height,
+    .numberOfBands = numberOfBands,
+  };
+  Visuals_Parallel_run((Visuals_Parallel_Callback*)&Visuals_PixelFormat_Job_run, &job, numberOfBands);
+  return true;
+}
+
+void
+Visuals_PixelFormat_convert
+  (
+    Shizu_State2* state,
+    Visuals_PixelFormat targetPixelFormat,
+    void* targetPixels,
+    size_t targetStride,
+    Visuals_PixelFormat sourcePixelFormat,
+    void const* sourcePixels,
+    size_t sourceStride,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  )
+{
+  if (width < 0 || height < 0) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  if (!Visuals_PixelFormat_tryConvert(targetPixelFormat, targetPixels, targetStride, sourcePixelFormat, sourcePixels, sourceStride,
+                                      (size_t)width, (size_t)height)) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+}
+
+void
+Visuals_PixelFormat_convertNaive
+  (
+    Visuals_PixelFormat targetPixelFormat,
+    void* targetPixels,
+    Visuals_PixelFormat sourcePixelFormat,
+    void const* sourcePixels,
+    size_t numberOfPixels
+  )
+{
+  uint8_t* target = (uint8_t*)targetPixels;
+  uint8_t const* source = (uint8_t const*)sourcePixels;
+  for (size_t i = 0; i < numberOfPixels; ++i) {
+    uint8_t r, g, b, a = 255;
+    switch (sourcePixelFormat) {
+      case Visuals_PixelFormat_ABGR_U8: {
+        a = source[0]; b = source[1]; g = source[2]; r = source[3]; source += 4;
+      } break;
+      case Visuals_PixelFormat_ARGB_U8: {
+        a = source[0]; r = source[1]; g = source[2]; b = source[3]; source += 4;
+      } break;
+      case Visuals_PixelFormat_BGR_U8: {
+        b = source[0]; g = source[1]; r = source[2]; source += 3;
+      } break;
+      case Visuals_PixelFormat_BGRA_U8: {
+        b = source[0]; g = source[1]; r = source[2]; a = source[3]; source += 4;
+      } break;
+      case Visuals_PixelFormat_RGB_U8: {
+        r = source[0]; g = source[1]; b = source[2]; source += 3;
+      } break;
+      case Visuals_PixelFormat_RGBA_U8:
+      default: {
+        r = source[0]; g = source[1]; b = source[2]; a = source[3]; source += 4;
+      } break;
+    };
+    switch (targetPixelFormat) {
+      case Visuals_PixelFormat_ABGR_U8: {
+        target[0] = a; target[1] = b; target[2] = g; target[3] = r; target += 4;
+      } break;
+      case Visuals_PixelFormat_ARGB_U8: {
+        target[0] = a; target[1] = r; target[2] = g; target[3] = b; target += 4;
+      } break;
+      case Visuals_PixelFormat_BGR_U8: {
+        target[0] = b; target[1] = g; target[2] = r; target += 3;
+      } break;
+      case Visuals_PixelFormat_BGRA_U8: {
+        target[0] = b; target[1] = g; target[2] = r; target[3] = a; target += 4;
+      } break;
+      case Visuals_PixelFormat_RGB_U8: {
+        target[0] = r; target[1] = g; target[2] = b; target += 3;
+      } break;
+      case Visuals_PixelFormat_RGBA_U8:
+      default: {
+        target[0] = r; target[1] = g; target[2] = b; target[3] = a; target += 4;
+      } break;
+    };
+  }
+}
+
+static double
+Visuals_PixelFormat_getSeconds
+  (
+    void
+  )
+{
+  struct timespec t;
+  timespec_get(&t, TIME_UTC);
+  return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+void
+Visuals_PixelFormat_benchmarkConversion
+  (
+    Shizu_State2* state,
+    Visuals_PixelFormat targetPixelFormat,
+    Visuals_PixelFormat sourcePixelFormat,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    double* naiveMegabytesPerSecond,
+    double* megabytesPerSecond
+  )
+{
+  if (width <= 0 || height <= 0 || !naiveMegabytesPerSecond || !megabytesPerSecond) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  size_t numberOfPixels = (size_t)width * (size_t)height;
+  size_t numberOfSourceBytes = numberOfPixels * (size_t)Visuals_PixelFormat_getBytesPerPixel(state, sourcePixelFormat);
+  size_t numberOfTargetBytes = numberOfPixels * (size_t)Visuals_PixelFormat_getBytesPerPixel(state, targetPixelFormat);
+  uint8_t* source = malloc(numberOfSourceBytes);
+  uint8_t* naiveTarget = malloc(numberOfTargetBytes);
+  uint8_t* target = malloc(numberOfTargetBytes);
+  if (!source || !naiveTarget || !target) {
+    free(target);
+    free(naiveTarget);
+    free(source);
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  for (size_t i = 0; i < numberOfSourceBytes; ++i) {
+    source[i] = (uint8_t)(i * 31 + (i >> 8));
+  }
+  static const size_t numberOfIterations = 8;
+  double start = Visuals_PixelFormat_getSeconds();
+  for (size_t i = 0; i < numberOfIterations; ++i) {
+    Visuals_PixelFormat_convertNaive(targetPixelFormat, naiveTarget, sourcePixelFormat, source, numberOfPixels);
+  }
+  double naiveSeconds = Visuals_PixelFormat_getSeconds() - start;
+  // The arguments were validated above, hence the conversion does not fail.
+  start = Visuals_PixelFormat_getSeconds();
+  for (size_t i = 0; i < numberOfIterations; ++i) {
+    Visuals_PixelFormat_convert(state, targetPixelFormat, target, numberOfTargetBytes / (size_t)height,
+                                sourcePixelFormat, source, numberOfSourceBytes / (size_t)height,
+                                width, height);
+  }
+  double seconds = Visuals_PixelFormat_getSeconds() - start;
+  bool equal = 0 == memcmp(naiveTarget, target, numberOfTargetBytes);
+  free(target);
+  free(naiveTarget);
+  free(source);
+  if (!equal) {
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+  double megabytes = (double)(numberOfSourceBytes * numberOfIterations) / (1024. * 1024.);
+  *naiveMegabytesPerSecond = naiveSeconds > 0. ? megabytes / naiveSeconds : 0.;
+  *megabytesPerSecond = seconds > 0. ? megabytes / seconds : 0.;
+}
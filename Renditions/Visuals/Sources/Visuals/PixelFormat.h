@@ -87,4 +87,106 @@ Visuals_PixelFormat_getComponents
     Visuals_PixelFormat self
   );
 
+/// @brief Get the index of the alpha component in a pixel of this pixel format.
+/// @param state The state.
+/// @param self The pixel format.
+/// @return The index of the alpha component or -1 if the pixel format has no alpha component.
+Shizu_WarnUnusedReturnValue()Shizu_Integer32
+Visuals_PixelFormat_getAlphaIndex
+  (
+    Shizu_State2* state,
+    Visuals_PixelFormat self
+  );
+
+/// @brief Convert pixels from one pixel format into another pixel format.
+/// @param state The state.
+/// @param targetPixelFormat The pixel format of the target pixels.
+/// @param targetPixels A pointer to the target pixels.
+/// @param targetStride The distance, in Bytes, from the start of a row of the target pixels to the start of the next row.
+/// Must not be less than @a width times the number of Bytes per pixel of the target pixel format.
+/// @param sourcePixelFormat The pixel format of the source pixels.
+/// @param sourcePixels A pointer to the source pixels.
+/// @param sourceStride The distance, in Bytes, from the start of a row of the source pixels to the start of the next row.
+/// Must not be less than @a width times the number of Bytes per pixel of the source pixel format.
+/// @param width The width, in pixels, of the image. Must be non-negative.
+/// @param height The height, in pixels, of the image. Must be non-negative.
+/// @remarks
+/// Any pair of pixel formats is supported.
+/// If a component is dropped, its value is discarded.
+/// If an alpha component is added, its value is the maximum intensity.
+/// The source pixels and the target pixels must not overlap.
+/// @remarks
+/// The conversion uses SSSE3 or AVX2 shuffles if the compiler and the CPU support them and a scalar loop otherwise.
+/// The rows of large images are split among multiple threads.
+void
+Visuals_PixelFormat_convert
+  (
+    Shizu_State2* state,
+    Visuals_PixelFormat targetPixelFormat,
+    void* targetPixels,
+    size_t targetStride,
+    Visuals_PixelFormat sourcePixelFormat,
+    void const* sourcePixels,
+    size_t sourceStride,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  );
+
+/// @brief Convert pixels from one pixel format into another pixel format.
+/// @param targetPixelFormat, targetPixels, targetStride, sourcePixelFormat, sourcePixels, sourceStride, width, height
+/// See Visuals_PixelFormat_convert.
+/// @return @a true on success. @a false if an argument is invalid. In that case, no pixels were converted.
+/// @remarks
+/// Unlike Visuals_PixelFormat_convert, this function takes no state and does not jump.
+/// Hence it can be invoked by the callback of a task started by Visuals_Parallel_startTask.
+bool
+Visuals_PixelFormat_tryConvert
+  (
+    Visuals_PixelFormat targetPixelFormat,
+    void* targetPixels,
+    size_t targetStride,
+    Visuals_PixelFormat sourcePixelFormat,
+    void const* sourcePixels,
+    size_t sourceStride,
+    size_t width,
+    size_t height
+  );
+
+/// @brief Convert pixels one by one by decomposing them into components and composing them from components.
+/// @param targetPixelFormat The pixel format of the target pixels. Must be valid.
+/// @param targetPixels A pointer to the target pixels.
+/// @param sourcePixelFormat The pixel format of the source pixels. Must be valid.
+/// @param sourcePixels A pointer to the source pixels.
+/// @param numberOfPixels The number of pixels.
+/// @remarks The reference for Visuals_PixelFormat_convert in tests and benchmarks.
+void
+Visuals_PixelFormat_convertNaive
+  (
+    Visuals_PixelFormat targetPixelFormat,
+    void* targetPixels,
+    Visuals_PixelFormat sourcePixelFormat,
+    void const* sourcePixels,
+    size_t numberOfPixels
+  );
+
+/// @brief Measure the throughput of Visuals_PixelFormat_convert.
+/// @param state The state.
+/// @param targetPixelFormat The target pixel format.
+/// @param sourcePixelFormat The source pixel format.
+/// @param width, height The size, in pixels, of the image. Must be positive.
+/// @param naiveMegabytesPerSecond A pointer to a variable receiving the throughput, in source MB/s, of a naive per-pixel loop.
+/// @param megabytesPerSecond A pointer to a variable receiving the throughput, in source MB/s, of Visuals_PixelFormat_convert.
+/// @remarks The results of both conversions are compared. If they differ, Shizu_Status_EnvironmentFailed is raised.
+void
+Visuals_PixelFormat_benchmarkConversion
+  (
+    Shizu_State2* state,
+    Visuals_PixelFormat targetPixelFormat,
+    Visuals_PixelFormat sourcePixelFormat,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    double* naiveMegabytesPerSecond,
+    double* megabytesPerSecond
+  );
+
 #endif // VISUALS_PIXELFORMAT_H_INCLUDED
@@ -0,0 +1,199 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Visuals/ReadbackTicket.h"
+
+// memcpy
+#include <string.h>
+
+static void
+Visuals_ReadbackTicket_visit
+  (
+    Shizu_State2* state,
+    Visuals_ReadbackTicket* self
+  );
+
+static void
+Visuals_ReadbackTicket_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  );
+
+static Shizu_ObjectTypeDescriptor const Visuals_ReadbackTicket_Type = {
+  .postCreateType = NULL,
+  .preDestroyType = NULL,
+  .visitType = NULL,
+  .size = sizeof(Visuals_ReadbackTicket),
+  .construct = &Visuals_ReadbackTicket_constructImpl,
+  .finalize = NULL,
+  .visit = (Shizu_OnVisitCallback*)&Visuals_ReadbackTicket_visit,
+  .dispatchSize = sizeof(Visuals_ReadbackTicket_Dispatch),
+  .dispatchInitialize = NULL,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Zeitgeist.Visuals.ReadbackTicket", Visuals_ReadbackTicket, Shizu_Object);
+
+static void
+Visuals_ReadbackTicket_visit
+  (
+    Shizu_State2* state,
+    Visuals_ReadbackTicket* self
+  )
+{
+  if (self->byteArray) {
+    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->byteArray);
+  }
+}
+
+static void
+Visuals_ReadbackTicket_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{
+  if (1 != numberOfArgumentValues) {
+    Shizu_State2_setStatus(state, Shizu_Status_NumberOfArgumentsInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Type* TYPE = Visuals_ReadbackTicket_getType(state);
+  Visuals_ReadbackTicket* SELF = (Visuals_ReadbackTicket*)Shizu_Value_getObject(&argumentValues[0]);
+  {
+    Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value argumentValues[] = { Shizu_Value_InitializerObject(SELF) };
+    Shizu_Type* PARENTTYPE = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), TYPE);
+    Shizu_Type_getObjectTypeDescriptor(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), PARENTTYPE)->construct
+    (state, &returnValue, 1, &argumentValues[0]);
+  }
+  SELF->status = Visuals_ReadbackStatus_Pending;
+  SELF->width = 0;
+  SELF->height = 0;
+  SELF->byteArray = NULL;
+  SELF->bytes = NULL;
+  SELF->numberOfBytes = 0;
+  SELF->callback = NULL;
+  ((Shizu_Object*)SELF)->type = TYPE;
+}
+
+Visuals_ReadbackTicket*
+Visuals_ReadbackTicket_create
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+  Shizu_Value argumentValues[] = { Shizu_Value_InitializerType(Visuals_ReadbackTicket_getType(state)), };
+  Shizu_Operations_create(state, &returnValue, 1, &argumentValues[0]);
+  return (Visuals_ReadbackTicket*)Shizu_Value_getObject(&returnValue);
+}
+
+Visuals_ReadbackStatus
+Visuals_ReadbackTicket_getStatus
+  (
+    Shizu_State2* state,
+    Visuals_ReadbackTicket* self
+  )
+{ return self->status; }
+
+static void
+invokeCallback
+  (
+    Shizu_State2* state,
+    Visuals_ReadbackTicket* self
+  )
+{
+  if (self->callback) {
+    Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value argumentValues[] = { Shizu_Value_InitializerObject(self) };
+    (*self->callback)(state, &returnValue, 1, &argumentValues[0]);
+  }
+}
+
+void
+Visuals_ReadbackTicket_setCallback
+  (
+    Shizu_State2* state,
+    Visuals_ReadbackTicket* self,
+    Shizu_CxxFunction* callback
+  )
+{
+  self->callback = callback;
+  if (Visuals_ReadbackStatus_Pending != self->status) {
+    invokeCallback(state, self);
+  }
+}
+
+void
+Visuals_ReadbackTicket_begin
+  (
+    Shizu_State2* state,
+    Visuals_ReadbackTicket* self,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  )
+{
+  if (width < 0 || height < 0) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  size_t numberOfBytes = (size_t)width * (size_t)height * 4;
+  size_t capacity = self->byteArray ? Shizu_ByteArray_getNumberOfRawBytes(state, self->byteArray) : self->numberOfBytes;
+  if (capacity < numberOfBytes) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  self->width = width;
+  self->height = height;
+}
+
+void
+Visuals_ReadbackTicket_fulfill
+  (
+    Shizu_State2* state,
+    Visuals_ReadbackTicket* self,
+    void const* pixels
+  )
+{
+  size_t numberOfBytes = (size_t)self->width * (size_t)self->height * 4;
+  if (numberOfBytes) {
+    void* target = self->byteArray ? Shizu_ByteArray_getRawBytes(state, self->byteArray) : self->bytes;
+    memcpy(target, pixels, numberOfBytes);
+  }
+  self->status = Visuals_ReadbackStatus_Fulfilled;
+  invokeCallback(state, self);
+}
+
+void
+Visuals_ReadbackTicket_fail
+  (
+    Shizu_State2* state,
+    Visuals_ReadbackTicket* self
+  )
+{
+  self->status = Visuals_ReadbackStatus_Failed;
+  invokeCallback(state, self);
+}
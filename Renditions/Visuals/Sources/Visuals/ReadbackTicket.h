@@ -0,0 +1,143 @@
+/*
+  Shizu Visuals
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(VISUALS_READBACKTICKET_H_INCLUDED)
+#define VISUALS_READBACKTICKET_H_INCLUDED
+
+#include "Zeitgeist.h"
+
+/// @since 1.0
+/// @brief The status of a readback ticket.
+typedef enum Visuals_ReadbackStatus {
+  /// @brief The pixels are not available yet.
+  Visuals_ReadbackStatus_Pending,
+  /// @brief The pixels were written to the target.
+  Visuals_ReadbackStatus_Fulfilled,
+  /// @brief The pixels could not be read back. The target was not written to.
+  Visuals_ReadbackStatus_Failed,
+} Visuals_ReadbackStatus;
+
+/// @since 1.0
+/// @brief A ticket for the pixels of a render buffer read back without stalling the pipeline.
+/// @details
+/// A ticket is returned by Visuals_RenderBuffer_requestReadback and Visuals_RenderBuffer_requestReadbackToBytes.
+/// It is usually fulfilled one or two frames later.
+/// Poll its status with Visuals_ReadbackTicket_getStatus or set a callback with Visuals_ReadbackTicket_setCallback.
+///
+/// The pixels are written to the target in the RGBA format with 8 bits per component.
+/// The rows are tightly packed and ordered from the bottom row to the top row.
+/// The size, in Bytes, of the pixels is 4 * width * height.
+Shizu_declareObjectType(Visuals_ReadbackTicket);
+
+struct Visuals_ReadbackTicket_Dispatch {
+  Shizu_Object_Dispatch _parent;
+};
+
+struct Visuals_ReadbackTicket {
+  Shizu_Object _parent;
+  /// @brief The status of this ticket.
+  Visuals_ReadbackStatus status;
+  /// @brief The width and the height, in pixels, of the pixels read back.
+  Shizu_Integer32 width, height;
+  /// @brief A pointer to the byte array the pixels are written to or the null pointer.
+  Shizu_ByteArray* byteArray;
+  /// @brief A pointer to the caller buffer the pixels are written to or the null pointer.
+  /// The caller must keep the buffer alive while the ticket is pending.
+  void* bytes;
+  /// @brief The size, in Bytes, of the caller buffer.
+  size_t numberOfBytes;
+  /// @brief A pointer to the function invoked when this ticket is fulfilled or failed or the null pointer.
+  Shizu_CxxFunction* callback;
+};
+
+Visuals_ReadbackTicket*
+Visuals_ReadbackTicket_create
+  (
+    Shizu_State2* state
+  );
+
+/// @since 1.0
+/// @brief Get the status of this ticket.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this ticket.
+/// @return The status.
+Visuals_ReadbackStatus
+Visuals_ReadbackTicket_getStatus
+  (
+    Shizu_State2* state,
+    Visuals_ReadbackTicket* self
+  );
+
+/// @since 1.0
+/// @brief Set the function invoked when this ticket is fulfilled or failed.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this ticket.
+/// @param callback A pointer to the function or the null pointer.
+/// The function is invoked with this ticket as its single argument.
+/// @remarks If this ticket is not pending anymore, the function is invoked immediately.
+void
+Visuals_ReadbackTicket_setCallback
+  (
+    Shizu_State2* state,
+    Visuals_ReadbackTicket* self,
+    Shizu_CxxFunction* callback
+  );
+
+/// @brief Set the size of the pixels read back.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this ticket.
+/// @param width, height The width and the height, in pixels.
+/// @error Shizu_Status_ArgumentValueInvalid the target is too small for the pixels.
+/// @remarks Called by the implementations of Visuals_RenderBuffer before the readback is issued.
+void
+Visuals_ReadbackTicket_begin
+  (
+    Shizu_State2* state,
+    Visuals_ReadbackTicket* self,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  );
+
+/// @brief Write the pixels to the target, mark this ticket as fulfilled, and invoke the callback.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this ticket.
+/// @param pixels A pointer to 4 * width * height Bytes.
+/// @remarks Called by the implementations of Visuals_RenderBuffer.
+void
+Visuals_ReadbackTicket_fulfill
+  (
+    Shizu_State2* state,
+    Visuals_ReadbackTicket* self,
+    void const* pixels
+  );
+
+/// @brief Mark this ticket as failed and invoke the callback.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this ticket.
+/// @remarks Called by the implementations of Visuals_RenderBuffer.
+void
+Visuals_ReadbackTicket_fail
+  (
+    Shizu_State2* state,
+    Visuals_ReadbackTicket* self
+  );
+
+#endif // VISUALS_READBACKTICKET_H_INCLUDED
@@ -30,6 +30,13 @@ Visuals_RenderBuffer_constructImpl
     Shizu_Value* argumentValues
   );
 
+static void
+Visuals_RenderBuffer_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_RenderBuffer_Dispatch* self
+  );
+
 static Shizu_ObjectTypeDescriptor const Visuals_RenderBuffer_Type = {
   .postCreateType = NULL,
   .preDestroyType = NULL,
@@ -39,12 +46,23 @@ static Shizu_ObjectTypeDescriptor const Visuals_RenderBuffer_Type = {
   .finalize = NULL,
   .visit = NULL,
   .dispatchSize = sizeof(Visuals_RenderBuffer_Dispatch),
-  .dispatchInitialize = NULL,
+  .dispatchInitialize = (Shizu_OnDispatchInitializeCallback*)&Visuals_RenderBuffer_dispatchInitialize,
   .dispatchUninitialize = NULL,
 };
 
 Shizu_defineObjectType("Zeitgeist.Visuals.RenderBuffer", Visuals_RenderBuffer, Visuals_Object);
 
+static void
+Visuals_RenderBuffer_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_RenderBuffer_Dispatch* self
+  )
+{
+  self->resize = NULL;
+  self->requestReadback = NULL;
+}
+
 static void
 Visuals_RenderBuffer_constructImpl
   (
@@ -69,3 +87,41 @@ Visuals_RenderBuffer_constructImpl
   }
   ((Shizu_Object*)SELF)->type = TYPE;
 }
+
+Visuals_ReadbackTicket*
+Visuals_RenderBuffer_requestReadback
+  (
+    Shizu_State2* state,
+    Visuals_RenderBuffer* self,
+    Shizu_ByteArray* byteArray
+  )
+{
+  if (!byteArray) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  Visuals_ReadbackTicket* ticket = Visuals_ReadbackTicket_create(state);
+  ticket->byteArray = byteArray;
+  Shizu_VirtualCall(Visuals_RenderBuffer, requestReadback, self, ticket);
+  return ticket;
+}
+
+Visuals_ReadbackTicket*
+Visuals_RenderBuffer_requestReadbackToBytes
+  (
+    Shizu_State2* state,
+    Visuals_RenderBuffer* self,
+    void* bytes,
+    size_t numberOfBytes
+  )
+{
+  if (!bytes) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  Visuals_ReadbackTicket* ticket = Visuals_ReadbackTicket_create(state);
+  ticket->bytes = bytes;
+  ticket->numberOfBytes = numberOfBytes;
+  Shizu_VirtualCall(Visuals_RenderBuffer, requestReadback, self, ticket);
+  return ticket;
+}
@@ -23,6 +23,7 @@
 #define VISUALS_RENDERBUFFER_H_INCLUDED
 
 #include "Visuals/Object.h"
+#include "Visuals/ReadbackTicket.h"
 
 /// @since 1.0
 /// @brief A render buffer.
@@ -31,6 +32,7 @@ Shizu_declareObjectType(Visuals_RenderBuffer);
 struct Visuals_RenderBuffer_Dispatch {
   Visuals_Object_Dispatch _parent;
   void (*resize)(Shizu_State2* state, Visuals_RenderBuffer* self, Shizu_Integer32 width, Shizu_Integer32 height);
+  void (*requestReadback)(Shizu_State2* state, Visuals_RenderBuffer* self, Visuals_ReadbackTicket* ticket);
 };
 
 struct Visuals_RenderBuffer {
@@ -47,4 +49,41 @@ Visuals_RenderBuffer_resize
   )
 { Shizu_VirtualCall(Visuals_RenderBuffer, resize, self, width, height); }
 
+/// @since 1.0
+/// @brief Request the pixels of the color attachment of this render buffer.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this render buffer.
+/// @param byteArray A pointer to the byte array the pixels are written to.
+/// Its size, in Bytes, must be at least 4 * width * height.
+/// @return A pointer to the ticket.
+/// @remarks The pixels are copied asynchronously and the ticket is usually fulfilled one or two frames later.
+/// The pixels are the pixels of this render buffer at the time of the request.
+/// @error Shizu_Status_ArgumentValueInvalid the byte array is too small.
+/// @error Shizu_Status_OperationInvalid this render buffer is not materialized.
+Visuals_ReadbackTicket*
+Visuals_RenderBuffer_requestReadback
+  (
+    Shizu_State2* state,
+    Visuals_RenderBuffer* self,
+    Shizu_ByteArray* byteArray
+  );
+
+/// @since 1.0
+/// @brief Request the pixels of the color attachment of this render buffer.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this render buffer.
+/// @param bytes A pointer to the caller buffer the pixels are written to.
+/// The caller must keep the buffer alive while the ticket is pending.
+/// @param numberOfBytes The size, in Bytes, of the caller buffer. Must be at least 4 * width * height.
+/// @return A pointer to the ticket.
+/// @see Visuals_RenderBuffer_requestReadback
+Visuals_ReadbackTicket*
+Visuals_RenderBuffer_requestReadbackToBytes
+  (
+    Shizu_State2* state,
+    Visuals_RenderBuffer* self,
+    void* bytes,
+    size_t numberOfBytes
+  );
+
 #endif // VISUALS_RENDERBUFFER_H_INCLUDED
@@ -21,8 +21,6 @@
 
 #include "Visuals/Texture.h"
 
-Shizu_defineEnumerationType("Zeitgeist.Visuals.PixelFormat", Visuals_PixelFormat);
-
 static void
 Visuals_Texture_finalize
   (
@@ -37,6 +35,59 @@ Visuals_Texture_dispatchInitialize
     Visuals_Texture_Dispatch* self
   );
 
+static void
+Visuals_Texture_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Texture* self,
+    Visuals_PixelFormat pixelFormat,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    Shizu_ByteArray* pixels
+  );
+
+static void
+Visuals_Texture_setSubDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Texture* self,
+    Shizu_Integer32 x,
+    Shizu_Integer32 y,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    Shizu_ByteArray* pixels
+  );
+
+static void
+Visuals_Texture_setLevelDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Texture* self,
+    Shizu_Integer32 level,
+    Shizu_ByteArray* pixels
+  );
+
+static Visuals_PixelFormat
+Visuals_Texture_getPixelFormatImpl
+  (
+    Shizu_State2* state,
+    Visuals_Texture* self
+  );
+
+static Shizu_Integer32
+Visuals_Texture_getWidthImpl
+  (
+    Shizu_State2* state,
+    Visuals_Texture* self
+  );
+
+static Shizu_Integer32
+Visuals_Texture_getHeightImpl
+  (
+    Shizu_State2* state,
+    Visuals_Texture* self
+  );
+
 static void
 Visuals_Texture_constructImpl
   (
@@ -75,7 +126,112 @@ Visuals_Texture_dispatchInitialize
     Shizu_State1* state1,
     Visuals_Texture_Dispatch* self
   )
-{/*Intentionally empty.*/}
+{
+  self->setData = &Visuals_Texture_setDataImpl;
+  self->setSubData = &Visuals_Texture_setSubDataImpl;
+  self->setLevelData = &Visuals_Texture_setLevelDataImpl;
+  self->getPixelFormat = &Visuals_Texture_getPixelFormatImpl;
+  self->getWidth = &Visuals_Texture_getWidthImpl;
+  self->getHeight = &Visuals_Texture_getHeightImpl;
+}
+
+static void
+Visuals_Texture_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Texture* self,
+    Visuals_PixelFormat pixelFormat,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    Shizu_ByteArray* pixels
+  )
+{
+  if (width < 0 || height < 0) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  size_t numberOfBytesPerPixel = (size_t)Visuals_PixelFormat_getBytesPerPixel(state, pixelFormat);
+  if (Shizu_ByteArray_getNumberOfRawBytes(state, pixels) != (size_t)width * (size_t)height * numberOfBytesPerPixel) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  self->pixelFormat = pixelFormat;
+  self->width = width;
+  self->height = height;
+  self->numberOfLevels = 1;
+}
+
+static void
+Visuals_Texture_setSubDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Texture* self,
+    Shizu_Integer32 x,
+    Shizu_Integer32 y,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    Shizu_ByteArray* pixels
+  )
+{
+  if (x < 0 || y < 0 || width < 0 || height < 0 || x > self->width - width || y > self->height - height) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  size_t numberOfBytesPerPixel = (size_t)Visuals_PixelFormat_getBytesPerPixel(state, self->pixelFormat);
+  if (Shizu_ByteArray_getNumberOfRawBytes(state, pixels) != (size_t)width * (size_t)height * numberOfBytesPerPixel) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+}
+
+static void
+Visuals_Texture_setLevelDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_Texture* self,
+    Shizu_Integer32 level,
+    Shizu_ByteArray* pixels
+  )
+{
+  if (level < 1 || level > self->numberOfLevels || level >= Visuals_Mipmap_getNumberOfLevels(state, self->width, self->height)) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  size_t width = self->width >> level > 0 ? (size_t)(self->width >> level) : 1;
+  size_t height = self->height >> level > 0 ? (size_t)(self->height >> level) : 1;
+  size_t numberOfBytesPerPixel = (size_t)Visuals_PixelFormat_getBytesPerPixel(state, self->pixelFormat);
+  if (Shizu_ByteArray_getNumberOfRawBytes(state, pixels) != width * height * numberOfBytesPerPixel) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  if (level == self->numberOfLevels) {
+    self->numberOfLevels++;
+  }
+}
+
+static Visuals_PixelFormat
+Visuals_Texture_getPixelFormatImpl
+  (
+    Shizu_State2* state,
+    Visuals_Texture* self
+  )
+{ return self->pixelFormat; }
+
+static Shizu_Integer32
+Visuals_Texture_getWidthImpl
+  (
+    Shizu_State2* state,
+    Visuals_Texture* self
+  )
+{ return self->width; }
+
+static Shizu_Integer32
+Visuals_Texture_getHeightImpl
+  (
+    Shizu_State2* state,
+    Visuals_Texture* self
+  )
+{ return self->height; }
 
 static void
 Visuals_Texture_constructImpl
@@ -99,5 +255,35 @@ Visuals_Texture_constructImpl
     Shizu_Type_getObjectTypeDescriptor(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), PARENTTYPE)->construct
     (state, &returnValue, 1, &argumentValues[0]);
   }
+  SELF->pixelFormat = Visuals_PixelFormat_RGBA_U8;
+  SELF->width = 0;
+  SELF->height = 0;
+  SELF->numberOfLevels = 1;
+  SELF->mipmapFilter = Visuals_MipmapFilter_None;
+  SELF->sRGB = false;
   ((Shizu_Object*)SELF)->type = TYPE;
 }
+
+void
+Visuals_Texture_setMipmapFilter
+  (
+    Shizu_State2* state,
+    Visuals_Texture* self,
+    Visuals_MipmapFilter filter,
+    Shizu_Boolean sRGB
+  )
+{
+  switch (filter) {
+    case Visuals_MipmapFilter_None:
+    case Visuals_MipmapFilter_Box:
+    case Visuals_MipmapFilter_Kaiser:
+    case Visuals_MipmapFilter_Lanczos: {
+      self->mipmapFilter = filter;
+      self->sRGB = sRGB;
+    } break;
+    default: {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    } break;
+  };
+}
@@ -23,17 +23,8 @@
 #define VISUALS_TEXTURE_H_INCLUDED
 
 #include "Visuals/Object.h"
-
-Shizu_declareEnumerationType(Visuals_PixelFormat);
-
-enum Visuals_PixelFormat {
-  Visuals_PixelFormat_ABGR8,
-  Visuals_PixelFormat_ARGBU8,
-  Visuals_PixelFormat_BGRAU8,
-  Visuals_PixelFormat_BGRU8,
-  Visuals_PixelFormat_RGBAU8,
-  Visuals_PixelFormat_RGBU8,
-};
+#include "Visuals/Mipmap.h"
+#include "Visuals/PixelFormat.h"
 
 /// @brief
 /// A texture.
@@ -45,11 +36,19 @@ enum Visuals_PixelFormat {
 /// @code
 /// Visuals.Texture.construct()
 /// @endcode
+/// which initializes the texture with a width and a height of zero and the pixel format Visuals_PixelFormat_RGBA_U8.
+/// @details
+/// A texture has a chain of levels.
+/// Level 0 is set by Visuals_Texture_setData.
+/// If the mipmap filter of the texture is not Visuals_MipmapFilter_None, the other levels are generated from level 0.
+/// Otherwise, precomputed levels can be set by Visuals_Texture_setLevelData.
 Shizu_declareObjectType(Visuals_Texture);
 
 struct Visuals_Texture_Dispatch {
   Visuals_Object_Dispatch _parent;
   void (*setData)(Shizu_State2* state, Visuals_Texture* self, Visuals_PixelFormat pixelFormat, Shizu_Integer32 width, Shizu_Integer32 height, Shizu_ByteArray* pixels);
+  void (*setSubData)(Shizu_State2* state, Visuals_Texture* self, Shizu_Integer32 x, Shizu_Integer32 y, Shizu_Integer32 width, Shizu_Integer32 height, Shizu_ByteArray* pixels);
+  void (*setLevelData)(Shizu_State2* state, Visuals_Texture* self, Shizu_Integer32 level, Shizu_ByteArray* pixels);
   Visuals_PixelFormat (*getPixelFormat)(Shizu_State2* state, Visuals_Texture* self);
   Shizu_Integer32 (*getWidth)(Shizu_State2* state, Visuals_Texture* self);
   Shizu_Integer32 (*getHeight)(Shizu_State2* state, Visuals_Texture* self);
@@ -57,8 +56,34 @@ struct Visuals_Texture_Dispatch {
 
 struct Visuals_Texture {
   Visuals_Object parent;
+  /// @brief The pixel format.
+  Visuals_PixelFormat pixelFormat;
+  /// @brief The width, in pixels.
+  Shizu_Integer32 width;
+  /// @brief The height, in pixels.
+  Shizu_Integer32 height;
+  /// @brief The number of levels.
+  Shizu_Integer32 numberOfLevels;
+  /// @brief The filter generating the levels from level 0. Visuals_MipmapFilter_None by default.
+  Visuals_MipmapFilter mipmapFilter;
+  /// @brief If the color components are sRGB encoded. false by default.
+  Shizu_Boolean sRGB;
 };
 
+/// @brief Set the filter generating the levels of this texture.
+/// @param filter The filter. If Visuals_MipmapFilter_None, no levels are generated.
+/// @param sRGB If the color components are sRGB encoded.
+/// If true, the levels are filtered in linear space.
+/// @remarks The levels are generated by the next call to Visuals_Texture_setData.
+void
+Visuals_Texture_setMipmapFilter
+  (
+    Shizu_State2* state,
+    Visuals_Texture* self,
+    Visuals_MipmapFilter filter,
+    Shizu_Boolean sRGB
+  );
+
 static inline void
 Visuals_Texture_setData
   (
@@ -71,6 +96,44 @@ Visuals_Texture_setData
   )
 { Shizu_VirtualCall(Visuals_Texture, setData, self, pixelFormat, width, height, pixels); }
 
+/// @brief Set the pixels of a rectangular region of this texture.
+/// @param x, y The position of the left top corner of the region.
+/// @param width, height The size of the region.
+/// The region must be within the bounds of the texture.
+/// @param pixels The pixels of the region. The pixels are in the pixel format of this texture.
+/// The rows are tightly packed from top to bottom.
+/// @remarks Only level 0 is updated.
+static inline void
+Visuals_Texture_setSubData
+  (
+    Shizu_State2* state,
+    Visuals_Texture* self,
+    Shizu_Integer32 x,
+    Shizu_Integer32 y,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    Shizu_ByteArray* pixels
+  )
+{ Shizu_VirtualCall(Visuals_Texture, setSubData, self, x, y, width, height, pixels); }
+
+/// @brief Set the pixels of a precomputed level of this texture.
+/// @param level The level. Must be positive and must not exceed the number of levels of this texture.
+/// If the level is the number of levels of this texture, the level is appended.
+/// @param pixels The pixels of the level. The pixels are in the pixel format of this texture.
+/// The size of level @a i is max(1, width / 2^i) times max(1, height / 2^i). The rows are tightly packed from top to bottom.
+/// @remarks
+/// The levels must be appended in order until the level of size 1x1 is reached.
+/// A texture with some but not all of its levels is only sampled from the levels it has.
+static inline void
+Visuals_Texture_setLevelData
+  (
+    Shizu_State2* state,
+    Visuals_Texture* self,
+    Shizu_Integer32 level,
+    Shizu_ByteArray* pixels
+  )
+{ Shizu_VirtualCall(Visuals_Texture, setLevelData, self, level, pixels); }
+
 static inline Visuals_PixelFormat
 Visuals_Texture_gePixelFormat
   (
@@ -0,0 +1,179 @@
+/*
+  Zeitgeist
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "Visuals/UniformBuffer.h"
+
+// malloc, free
+#include <malloc.h>
+// memcpy
+#include <string.h>
+
+static void
+Visuals_UniformBuffer_finalize
+  (
+    Shizu_State2* state,
+    Visuals_UniformBuffer* self
+  );
+
+static void
+Visuals_UniformBuffer_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_UniformBuffer_Dispatch* self
+  );
+
+static void
+Visuals_UniformBuffer_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_UniformBuffer* self,
+    void const* bytes,
+    size_t numberOfBytes
+  );
+
+static void
+Visuals_UniformBuffer_setSubDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_UniformBuffer* self,
+    size_t offset,
+    void const* bytes,
+    size_t numberOfBytes
+  );
+
+static void
+Visuals_UniformBuffer_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  );
+
+static Shizu_ObjectTypeDescriptor const Visuals_UniformBuffer_Type = {
+  .postCreateType = NULL,
+  .preDestroyType = NULL,
+  .visitType = NULL,
+  .size = sizeof(Visuals_UniformBuffer),
+  .construct = &Visuals_UniformBuffer_constructImpl,
+  .finalize = (Shizu_OnFinalizeCallback*)&Visuals_UniformBuffer_finalize,
+  .visit = NULL,
+  .dispatchSize = sizeof(Visuals_UniformBuffer_Dispatch),
+  .dispatchInitialize = (Shizu_OnDispatchInitializeCallback*)&Visuals_UniformBuffer_dispatchInitialize,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Zeitgeist.Visuals.UniformBuffer", Visuals_UniformBuffer, Visuals_Object);
+
+static void
+Visuals_UniformBuffer_finalize
+  (
+    Shizu_State2* state,
+    Visuals_UniformBuffer* self
+  )
+{
+  if (self->bytes) {
+    free(self->bytes);
+    self->bytes = NULL;
+  }
+  self->numberOfBytes = 0;
+}
+
+static void
+Visuals_UniformBuffer_dispatchInitialize
+  (
+    Shizu_State1* state1,
+    Visuals_UniformBuffer_Dispatch* self
+  )
+{
+  self->setData = (void(*)(Shizu_State2*, Visuals_UniformBuffer*, void const*, size_t)) & Visuals_UniformBuffer_setDataImpl;
+  self->setSubData = (void(*)(Shizu_State2*, Visuals_UniformBuffer*, size_t, void const*, size_t)) & Visuals_UniformBuffer_setSubDataImpl;
+}
+
+static void
+Visuals_UniformBuffer_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_UniformBuffer* self,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{
+  // Allocate new Bytes.
+  void* newBytes = realloc(self->bytes, numberOfBytes > 0 ? numberOfBytes : 1);
+  if (!newBytes) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  memcpy(newBytes, bytes, numberOfBytes);
+  // Store the bytes and the number of Bytes.
+  self->bytes = newBytes;
+  self->numberOfBytes = numberOfBytes;
+}
+
+static void
+Visuals_UniformBuffer_setSubDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_UniformBuffer* self,
+    size_t offset,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{
+  if (offset > self->numberOfBytes || numberOfBytes > self->numberOfBytes - offset) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  memcpy((char*)self->bytes + offset, bytes, numberOfBytes);
+}
+
+static void
+Visuals_UniformBuffer_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{
+  if (1 != numberOfArgumentValues) {
+    Shizu_State2_setStatus(state, Shizu_Status_NumberOfArgumentsInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Type* TYPE = Visuals_UniformBuffer_getType(state);
+  Visuals_UniformBuffer* SELF = (Visuals_UniformBuffer*)Shizu_Value_getObject(&argumentValues[0]);
+  {
+    Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value argumentValues[] = { Shizu_Value_InitializerObject(SELF) };
+    Shizu_Type* PARENTTYPE = Shizu_Types_getParentType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), TYPE);
+    Shizu_Type_getObjectTypeDescriptor(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), PARENTTYPE)->construct
+    (state, &returnValue, 1, &argumentValues[0]);
+  }
+  SELF->bytes = malloc(sizeof(char));
+  if (!SELF->bytes) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  SELF->numberOfBytes = 0;
+  ((Shizu_Object*)SELF)->type = TYPE;
+}
@@ -0,0 +1,92 @@
+/*
+  Zeitgeist
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(VISUALS_UNIFORMBUFFER_H_INCLUDED)
+#define VISUALS_UNIFORMBUFFER_H_INCLUDED
+
+#include "Visuals/Object.h"
+
+/// @since 1.0
+/// @brief
+/// A uniform buffer.
+/// @details
+/// A uniform buffer provides the data of a uniform block of a program.
+/// Its data must adhere to the std140 layout of the uniform block.
+/// A uniform buffer is bound to a uniform buffer binding point by Visuals_Context_setUniformBuffer,
+/// a uniform block of a program is assigned to a uniform buffer binding point by Visuals_Program_bindUniformBlock.
+/// @details
+/// The type is
+/// @code
+/// class Visuals.UniformBuffer
+/// @endcode
+/// Its constructor is
+/// @code
+/// Visuals.UniformBuffer.construct()
+/// @endcode
+/// which initializes the uniform buffer with zero Bytes.
+Shizu_declareObjectType(Visuals_UniformBuffer);
+
+struct Visuals_UniformBuffer_Dispatch {
+  Visuals_Object_Dispatch _parent;
+  void (*setData)(Shizu_State2* state, Visuals_UniformBuffer* self, void const* bytes, size_t numberOfBytes);
+  void (*setSubData)(Shizu_State2* state, Visuals_UniformBuffer* self, size_t offset, void const* bytes, size_t numberOfBytes);
+};
+
+struct Visuals_UniformBuffer {
+  Visuals_Object parent;
+  /// @brief A pointer to an array of @a numberOfBytes Bytes.
+  void* bytes;
+  /// @brief The number of Bytes in the array pointed to by @a bytes.
+  size_t numberOfBytes;
+};
+
+static inline void
+Visuals_UniformBuffer_setData
+  (
+    Shizu_State2* state,
+    Visuals_UniformBuffer* self,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{ Shizu_VirtualCall(Visuals_UniformBuffer, setData, self, bytes, numberOfBytes); }
+
+/// @since 1.0
+/// @brief Overwrite a range of the data of this uniform buffer.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this uniform buffer.
+/// @param offset The offset, in Bytes, of the range.
+/// @param bytes A pointer to an array of @a numberOfBytes Bytes.
+/// @param numberOfBytes The size, in Bytes, of the range.
+/// @remarks Only the range is uploaded. The size of the data is not changed.
+/// @error Shizu_Status_ArgumentOutOfRange the range is not within the data of this uniform buffer.
+static inline void
+Visuals_UniformBuffer_setSubData
+  (
+    Shizu_State2* state,
+    Visuals_UniformBuffer* self,
+    size_t offset,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{ Shizu_VirtualCall(Visuals_UniformBuffer, setSubData, self, offset, bytes, numberOfBytes); }
+
+#endif // VISUALS_UNIFORMBUFFER_H_INCLUDED
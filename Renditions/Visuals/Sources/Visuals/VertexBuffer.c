@@ -47,11 +47,91 @@ Visuals_VertexBuffer_setDataImpl
   (
     Shizu_State2* state,
     Visuals_VertexBuffer* self,
-    uint8_t flags,
+    uint16_t flags,
     void const* bytes,
     size_t numberOfBytes
   );
 
+static void
+Visuals_VertexBuffer_adoptDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_VertexBuffer* self,
+    uint16_t flags,
+    void* bytes,
+    size_t numberOfBytes
+  );
+
+// The number of Bytes of the copies of vertex data alive.
+static size_t g_numberOfRetainedBytes = 0;
+
+// Release the copy of the vertex data (if any).
+static void
+Visuals_VertexBuffer_releaseBytes
+  (
+    Visuals_VertexBuffer* self
+  )
+{
+  if (self->bytes) {
+    g_numberOfRetainedBytes -= self->numberOfBytes;
+    free(self->bytes);
+    self->bytes = NULL;
+  }
+}
+
+void
+Visuals_VertexBuffer_setRetention
+  (
+    Shizu_State2* state,
+    Visuals_VertexBuffer* self,
+    uint8_t retention
+  )
+{
+  switch (retention) {
+    case Visuals_VertexBufferRetention_Keep:
+    case Visuals_VertexBufferRetention_Release:
+    case Visuals_VertexBufferRetention_Refetch: {
+      self->retention = retention;
+    } break;
+    default: {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    } break;
+  };
+}
+
+void
+Visuals_VertexBuffer_setFetchCallback
+  (
+    Shizu_State2* state,
+    Visuals_VertexBuffer* self,
+    Visuals_VertexBuffer_FetchCallback* callback,
+    void* context
+  )
+{
+  self->fetchCallback = callback;
+  self->fetchContext = context;
+}
+
+void
+Visuals_VertexBuffer_applyRetention
+  (
+    Shizu_State2* state,
+    Visuals_VertexBuffer* self
+  )
+{
+  if (Visuals_VertexBufferUsage_Static != self->usage || Visuals_VertexBufferRetention_Keep != self->retention) {
+    Visuals_VertexBuffer_releaseBytes(self);
+  }
+}
+
+size_t
+Visuals_VertexBuffer_getNumberOfRetainedBytes
+  (
+    Shizu_State2* state
+  )
+{ return g_numberOfRetainedBytes; }
+
 static void
 Visuals_VertexBuffer_constructImpl
   (
@@ -83,10 +163,7 @@ Visuals_VertexBuffer_finalize
     Visuals_VertexBuffer* self
   )
 {
-  if (self->bytes) {
-    free(self->bytes);
-    self->bytes = NULL;
-  }
+  Visuals_VertexBuffer_releaseBytes(self);
   self->numberOfBytes = 0;
 
   self->numberOfVertices = 0;
@@ -101,16 +178,17 @@ Visuals_VertexBuffer_dispatchInitialize
     Visuals_VertexBuffer_Dispatch* self
   )
 {
-  self->setData = (void(*)(Shizu_State2*, Visuals_VertexBuffer*, uint8_t, void const*, size_t)) & Visuals_VertexBuffer_setDataImpl;
+  self->setData = (void(*)(Shizu_State2*, Visuals_VertexBuffer*, uint16_t, void const*, size_t)) & Visuals_VertexBuffer_setDataImpl;
+  self->adoptData = (void(*)(Shizu_State2*, Visuals_VertexBuffer*, uint16_t, void*, size_t)) & Visuals_VertexBuffer_adoptDataImpl;
 }
 
-static void
-Visuals_VertexBuffer_setDataImpl
+// Compute the number of vertices of vertex data.
+// Raise an error if the vertex format is not supported or the number of Bytes is not a multiple of the vertex size.
+static size_t
+Visuals_VertexBuffer_getNumberOfVertices
   (
     Shizu_State2* state,
-    Visuals_VertexBuffer* self,
-    uint8_t flags,
-    void const* bytes,
+    uint16_t flags,
     size_t numberOfBytes
   )
 {
@@ -125,36 +203,109 @@ Visuals_VertexBuffer_setDataImpl
     case (Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess | Visuals_VertexSyntactics_Float3_Float3_Float3_Float3_Float3_Float): {
       newVertexSize = sizeof(float) * 3 + sizeof(float) * 3 + sizeof(float) * 3 + sizeof(float) * 3 + sizeof(float) * 3 + sizeof(float);
     } break;
+    case (Visuals_VertexSemantics_Transform3x4_MaterialIndex | Visuals_VertexSyntactics_Float4_Float4_Float4_UInt32): {
+      newVertexSize = sizeof(float) * 4 + sizeof(float) * 4 + sizeof(float) * 4 + sizeof(uint32_t);
+    } break;
+    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_MaterialIndex | Visuals_VertexSyntactics_Float3_Int2101010_UInt16): {
+      newVertexSize = sizeof(float) * 3 + sizeof(uint32_t) + sizeof(uint16_t) * 2;
+    } break;
+    case (Visuals_VertexSemantics_PositionXyz_NormalXyz_TextureUv_MaterialIndex | Visuals_VertexSyntactics_Float3_Int2101010_Half2_UInt16): {
+      newVertexSize = sizeof(float) * 3 + sizeof(uint32_t) + sizeof(uint16_t) * 2 + sizeof(uint16_t) * 2;
+    } break;
     default: {
       fprintf(stderr, "%s:%d: unreachable code reached\n", __FILE__, __LINE__);
       Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
       Shizu_State2_jump(state);
     } break;
   };
-  // Compute new number of Bytes.
-  size_t newNumberOfBytes = numberOfBytes;
-  // Compute new number of vertices.
-  size_t newNumberOfVertices = numberOfBytes / newVertexSize;
-  // Warn if this does not hold.
-  if (newNumberOfBytes % newVertexSize) {
-    fprintf(stderr, "%s:%d: warning: number of Bytes %zu is not a multiple of the vertex size %zu\n", __FILE__, __LINE__, newNumberOfBytes, newVertexSize);
+  if (numberOfBytes % newVertexSize) {
+    fprintf(stderr, "%s:%d: warning: number of Bytes %zu is not a multiple of the vertex size %zu\n", __FILE__, __LINE__, numberOfBytes, newVertexSize);
     Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
     Shizu_State2_jump(state);
   }
-  // Allocate new Bytes.
-  void *newBytes = realloc(self->bytes, newNumberOfVertices * newVertexSize > 0 ? newNumberOfVertices * newVertexSize : 1);
-  if (!newBytes) {
-    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
-    Shizu_State2_jump(state);
+  return numberOfBytes / newVertexSize;
+}
+
+static void
+Visuals_VertexBuffer_setDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_VertexBuffer* self,
+    uint16_t flags,
+    void const* bytes,
+    size_t numberOfBytes
+  )
+{
+  // Compute new number of vertices.
+  size_t newNumberOfVertices = Visuals_VertexBuffer_getNumberOfVertices(state, flags, numberOfBytes);
+  if (Visuals_VertexBufferUsage_Static == self->usage && Visuals_VertexBufferRetention_Keep == self->retention) {
+    // Allocate new Bytes.
+    void *newBytes = malloc(numberOfBytes > 0 ? numberOfBytes : 1);
+    if (!newBytes) {
+      Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State2_jump(state);
+    }
+    memcpy(newBytes, bytes, numberOfBytes);
+    Visuals_VertexBuffer_releaseBytes(self);
+    // Store the bytes.
+    self->bytes = newBytes;
+    g_numberOfRetainedBytes += numberOfBytes;
+  } else {
+    // Dynamic and stream vertex data is not retained.
+    // Static vertex data which is not kept is uploaded from the caller's Bytes.
+    Visuals_VertexBuffer_releaseBytes(self);
   }
-  memcpy(newBytes, bytes, newNumberOfVertices * newVertexSize);
+  // Store the flags.
+  self->flags = flags;
+  // Store the number of vertices.
+  self->numberOfVertices = newNumberOfVertices;
+  // Store the number of Bytes.
+  self->numberOfBytes = numberOfBytes;
+}
+
+static void
+Visuals_VertexBuffer_adoptDataImpl
+  (
+    Shizu_State2* state,
+    Visuals_VertexBuffer* self,
+    uint16_t flags,
+    void* bytes,
+    size_t numberOfBytes
+  )
+{
+  // Compute new number of vertices.
+  size_t newNumberOfVertices = Visuals_VertexBuffer_getNumberOfVertices(state, flags, numberOfBytes);
+  Visuals_VertexBuffer_releaseBytes(self);
   // Store the flags.
   self->flags = flags;
   // Store the number of vertices.
   self->numberOfVertices = newNumberOfVertices;
   // Store the bytes and the number of Bytes.
-  self->bytes = newBytes;
-  self->numberOfBytes = newNumberOfBytes;
+  // The bytes are released by Visuals_VertexBuffer_applyRetention if they are not retained.
+  self->bytes = bytes;
+  self->numberOfBytes = numberOfBytes;
+  g_numberOfRetainedBytes += numberOfBytes;
+}
+
+void
+Visuals_VertexBuffer_setUsage
+  (
+    Shizu_State2* state,
+    Visuals_VertexBuffer* self,
+    uint8_t usage
+  )
+{
+  switch (usage) {
+    case Visuals_VertexBufferUsage_Static:
+    case Visuals_VertexBufferUsage_Dynamic:
+    case Visuals_VertexBufferUsage_Stream: {
+      self->usage = usage;
+    } break;
+    default: {
+      Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+      Shizu_State2_jump(state);
+    } break;
+  };
 }
 
 static void
@@ -187,5 +338,9 @@ Visuals_VertexBuffer_constructImpl
   SELF->numberOfBytes = 0;
   SELF->numberOfVertices = 0;
   SELF->flags = Visuals_VertexSemantics_PositionXyz | Visuals_VertexSyntactics_Float3;
+  SELF->usage = Visuals_VertexBufferUsage_Static;
+  SELF->retention = Visuals_VertexBufferRetention_Keep;
+  SELF->fetchCallback = NULL;
+  SELF->fetchContext = NULL;
   ((Shizu_Object*)SELF)->type = TYPE;
 }
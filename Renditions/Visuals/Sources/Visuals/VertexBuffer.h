@@ -30,6 +30,15 @@
 #define Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb (2)
 /// @brief Vertices representing a position xyz, a normal xyz, an ambient rgb, a diffuse rgb, a specular rgb, and  shininess.
 #define Visuals_VertexSemantics_PositionXyz_NormalXyz_AmbientRgb_DiffuseRgb_SpecularRgb_Shininess (4)
+/// @brief Per-instance data representing the three rows of an affine 3x4 transform matrix and a material index (in that order).
+/// @remarks Vertex buffers of this format are passed as the instance buffer to Visuals_Context_renderInstanced.
+#define Visuals_VertexSemantics_Transform3x4_MaterialIndex (64)
+/// @brief Vertices representing a position xyz, a normal xyz, and a material index (in that order).
+/// @remarks The material index refers to an element of the materials uniform block of the program.
+#define Visuals_VertexSemantics_PositionXyz_NormalXyz_MaterialIndex (256)
+/// @brief Vertices representing a position xyz, a normal xyz, a texture coordinate uv, and a material index (in that order).
+/// @remarks The material index refers to an element of the materials uniform block of the program.
+#define Visuals_VertexSemantics_PositionXyz_NormalXyz_TextureUv_MaterialIndex (512)
 
 /// @brief A vertex is one vertex element consisting of three float values.
 #define Visuals_VertexSyntactics_Float3 (8)
@@ -37,6 +46,38 @@
 #define Visuals_VertexSyntactics_Float3_Float3_Float3 (16)
 /// @brief A vertex is 6 vertex elements. The first five vertex element each consist of three float values. The last vertex element consists of a single float value.
 #define Visuals_VertexSyntactics_Float3_Float3_Float3_Float3_Float3_Float (32)
+/// @brief A vertex is 4 vertex elements. The first three vertex elements each consist of four float values. The last vertex element consists of a single uint32_t value.
+#define Visuals_VertexSyntactics_Float4_Float4_Float4_UInt32 (128)
+/// @brief A vertex is 3 vertex elements. The first vertex element consists of three float values.
+/// The second vertex element consists of a signed normalized 10:10:10:2 value (see Visuals_packNormal).
+/// The third vertex element consists of a single uint16_t value followed by two Bytes of padding.
+/// A vertex is 20 Bytes.
+#define Visuals_VertexSyntactics_Float3_Int2101010_UInt16 (1024)
+/// @brief A vertex is 4 vertex elements. The first vertex element consists of three float values.
+/// The second vertex element consists of a signed normalized 10:10:10:2 value (see Visuals_packNormal).
+/// The third vertex element consists of two half float values (see Visuals_packHalf).
+/// The fourth vertex element consists of a single uint16_t value followed by two Bytes of padding.
+/// A vertex is 24 Bytes.
+#define Visuals_VertexSyntactics_Float3_Int2101010_Half2_UInt16 (2048)
+
+/// @brief The vertex data is specified once and rendered many times (e.g., walls).
+/// The vertex buffer retains a copy of the vertex data.
+#define Visuals_VertexBufferUsage_Static (1)
+/// @brief The vertex data is specified repeatedly and rendered many times.
+/// The vertex buffer does not retain a copy of the vertex data.
+#define Visuals_VertexBufferUsage_Dynamic (2)
+/// @brief The vertex data is specified about once per frame and rendered a few times (e.g., particles, debug lines, user interfaces).
+/// The vertex buffer does not retain a copy of the vertex data.
+#define Visuals_VertexBufferUsage_Stream (3)
+
+/// @brief The copy of the vertex data is kept for the lifetime of the vertex buffer.
+#define Visuals_VertexBufferRetention_Keep (1)
+/// @brief The copy of the vertex data is released after the vertex data was uploaded.
+/// The vertex data is lost if the vertex buffer is unmaterialized.
+#define Visuals_VertexBufferRetention_Release (2)
+/// @brief The copy of the vertex data is released after the vertex data was uploaded.
+/// If the vertex buffer is materialized again, the vertex data is re-fetched by the fetch callback (see Visuals_VertexBuffer_setFetchCallback).
+#define Visuals_VertexBufferRetention_Refetch (3)
 
 /// @since 1.0
 /// @brief
@@ -48,6 +89,9 @@
 /// Currently, the following formats are supported
 /// - Visuals_VertexSemantics_PositionXyz | Visuals_VertexSyntactics_Float3
 /// - Visuals_VertexSemantics_PositionXyz_NormalXyz_ColorRgb | Visuals_VertexSyntactics_Float3_Float3_Float3
+/// - Visuals_VertexSemantics_Transform3x4_MaterialIndex | Visuals_VertexSyntactics_Float4_Float4_Float4_UInt32 (instance data)
+/// - Visuals_VertexSemantics_PositionXyz_NormalXyz_MaterialIndex | Visuals_VertexSyntactics_Float3_Int2101010_UInt16
+/// - Visuals_VertexSemantics_PositionXyz_NormalXyz_TextureUv_MaterialIndex | Visuals_VertexSyntactics_Float3_Int2101010_Half2_UInt16
 /// @details
 /// The type is
 /// @code
@@ -60,11 +104,20 @@
 /// which initializes the vertex buffer with default values. The default values are
 /// - zero vertices
 /// - of the format Visuals_VertexSemantics_PositionXyz | Visuals_VertexSyntactics_Float3
+/// - of the usage Visuals_VertexBufferUsage_Static
+/// - of the retention Visuals_VertexBufferRetention_Keep
 Shizu_declareObjectType(Visuals_VertexBuffer);
 
+/// @brief The type of a callback re-fetching the vertex data of a vertex buffer.
+/// @param vertexBuffer A pointer to the vertex buffer.
+/// The callback is expected to invoke Visuals_VertexBuffer_setData or Visuals_VertexBuffer_adoptData on that vertex buffer.
+/// @param context The context pointer passed to Visuals_VertexBuffer_setFetchCallback.
+typedef void (Visuals_VertexBuffer_FetchCallback)(Shizu_State2* state, Visuals_VertexBuffer* vertexBuffer, void* context);
+
 struct Visuals_VertexBuffer_Dispatch {
   Visuals_Object_Dispatch _parent;
-  void (*setData)(Shizu_State2* state, Visuals_VertexBuffer* self, uint8_t flags, void const* bytes, size_t numberOfBytes);
+  void (*setData)(Shizu_State2* state, Visuals_VertexBuffer* self, uint16_t flags, void const* bytes, size_t numberOfBytes);
+  void (*adoptData)(Shizu_State2* state, Visuals_VertexBuffer* self, uint16_t flags, void* bytes, size_t numberOfBytes);
 };
 
 struct Visuals_VertexBuffer {
@@ -72,22 +125,168 @@ struct Visuals_VertexBuffer {
   /// @brief The number of vertices.
   size_t numberOfVertices;
   /// @brief The vertex format.
-  uint8_t flags;
+  uint16_t flags;
   /// @brief A pointer to an array of @a numberOfBytes Bytes.
+  /// The null pointer if the usage is not Visuals_VertexBufferUsage_Static
+  /// or if the retention is not Visuals_VertexBufferRetention_Keep and the vertex data was uploaded.
   void* bytes;
   /// @brief The number of Bytes in the array pointed to by @a bytes.
   size_t numberOfBytes;
+  /// @brief The usage hint.
+  /// One of Visuals_VertexBufferUsage_Static, Visuals_VertexBufferUsage_Dynamic, or Visuals_VertexBufferUsage_Stream.
+  uint8_t usage;
+  /// @brief The retention policy of the copy of the vertex data.
+  /// One of Visuals_VertexBufferRetention_Keep, Visuals_VertexBufferRetention_Release, or Visuals_VertexBufferRetention_Refetch.
+  uint8_t retention;
+  /// @brief A pointer to the fetch callback or the null pointer.
+  Visuals_VertexBuffer_FetchCallback* fetchCallback;
+  /// @brief The context pointer passed to the fetch callback.
+  void* fetchContext;
 };
 
+/// @brief Set the usage hint of this vertex buffer.
+/// @param usage One of Visuals_VertexBufferUsage_Static, Visuals_VertexBufferUsage_Dynamic, or Visuals_VertexBufferUsage_Stream.
+/// @remarks The usage hint takes effect when the vertex data is specified the next time.
+void
+Visuals_VertexBuffer_setUsage
+  (
+    Shizu_State2* state,
+    Visuals_VertexBuffer* self,
+    uint8_t usage
+  );
+
+/// @brief Set the retention policy of this vertex buffer.
+/// @param retention One of Visuals_VertexBufferRetention_Keep, Visuals_VertexBufferRetention_Release, or Visuals_VertexBufferRetention_Refetch.
+/// @remarks The retention policy takes effect when the vertex data is uploaded the next time.
+void
+Visuals_VertexBuffer_setRetention
+  (
+    Shizu_State2* state,
+    Visuals_VertexBuffer* self,
+    uint8_t retention
+  );
+
+/// @brief Set the fetch callback of this vertex buffer.
+/// @param callback A pointer to the fetch callback or the null pointer.
+/// @param context The context pointer passed to the fetch callback.
+/// @remarks The fetch callback is invoked if the retention is Visuals_VertexBufferRetention_Refetch and
+/// the vertex buffer is materialized again after its vertex data was released.
+void
+Visuals_VertexBuffer_setFetchCallback
+  (
+    Shizu_State2* state,
+    Visuals_VertexBuffer* self,
+    Visuals_VertexBuffer_FetchCallback* callback,
+    void* context
+  );
+
+/// @brief Release the copy of the vertex data if the retention policy or the usage hint requires so.
+/// @remarks Invoked by implementations after they uploaded the vertex data.
+void
+Visuals_VertexBuffer_applyRetention
+  (
+    Shizu_State2* state,
+    Visuals_VertexBuffer* self
+  );
+
+/// @brief Get the number of Bytes of the copies of vertex data alive.
+/// @return The number of Bytes.
+size_t
+Visuals_VertexBuffer_getNumberOfRetainedBytes
+  (
+    Shizu_State2* state
+  );
+
+/// @brief Pack a normal into a signed normalized 10:10:10:2 value.
+/// @param x, y, z The components of the normal. Clamped to [-1,+1].
+/// @return The packed value. x is stored in bits 0 to 9, y in bits 10 to 19, and z in bits 20 to 29. Bits 30 and 31 are zero.
+static inline uint32_t
+Visuals_packNormal
+  (
+    float x,
+    float y,
+    float z
+  )
+{
+  float const v[] = { x, y, z };
+  uint32_t packed = 0;
+  for (size_t i = 0; i < 3; ++i) {
+    float c = v[i] < -1.f ? -1.f : (v[i] > +1.f ? +1.f : v[i]);
+    int32_t s = (int32_t)(c >= 0.f ? c * 511.f + 0.5f : c * 511.f - 0.5f);
+    packed |= ((uint32_t)s & 0x3ff) << (10 * i);
+  }
+  return packed;
+}
+
+/// @brief Pack a float value into a half float value.
+/// @param value The float value.
+/// @return The half float value. The value is rounded to the nearest half float value (ties to even).
+static inline uint16_t
+Visuals_packHalf
+  (
+    float value
+  )
+{
+  union { float f; uint32_t u; } x = { .f = value };
+  uint32_t sign = (x.u >> 16) & 0x8000;
+  uint32_t mantissa = x.u & 0x7fffff;
+  if (0xff == ((x.u >> 23) & 0xff)) {
+    // infinity or not a number
+    return (uint16_t)(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+  }
+  int32_t exponent = (int32_t)((x.u >> 23) & 0xff) - 127 + 15;
+  if (exponent >= 31) {
+    // overflow
+    return (uint16_t)(sign | 0x7c00);
+  }
+  if (exponent <= 0) {
+    // underflow or subnormal
+    if (exponent < -10) {
+      return (uint16_t)sign;
+    }
+    mantissa |= 0x800000;
+    uint32_t shift = (uint32_t)(14 - exponent);
+    uint32_t h = mantissa >> shift;
+    uint32_t remainder = mantissa & ((UINT32_C(1) << shift) - 1);
+    uint32_t halfway = UINT32_C(1) << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (h & 1))) {
+      h++;
+    }
+    return (uint16_t)(sign | h);
+  }
+  uint32_t h = sign | ((uint32_t)exponent << 10) | (mantissa >> 13);
+  uint32_t remainder = mantissa & 0x1fff;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (h & 1))) {
+    // A carry into the exponent yields the correct result.
+    h++;
+  }
+  return (uint16_t)h;
+}
+
 static inline void
 Visuals_VertexBuffer_setData
   (
     Shizu_State2* state,
     Visuals_VertexBuffer* self,
-    uint8_t flags,
+    uint16_t flags,
     void const* bytes,
     size_t numberOfBytes
   )
 { Shizu_VirtualCall(Visuals_VertexBuffer, setData, self, flags, bytes, numberOfBytes); }
 
+/// @brief Set the vertex data without copying it.
+/// @param bytes A pointer to an array of @a numberOfBytes Bytes allocated by malloc.
+/// On success, the vertex buffer takes ownership of the array and releases it by free.
+/// @remarks The vertex buffer adopts the array as its copy of the vertex data, subject to its retention policy.
+static inline void
+Visuals_VertexBuffer_adoptData
+  (
+    Shizu_State2* state,
+    Visuals_VertexBuffer* self,
+    uint16_t flags,
+    void* bytes,
+    size_t numberOfBytes
+  )
+{ Shizu_VirtualCall(Visuals_VertexBuffer, adoptData, self, flags, bytes, numberOfBytes); }
+
 #endif // VISUALS_VERTEXBUFFER_H_INCLUDED
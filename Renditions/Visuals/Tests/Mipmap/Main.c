@@ -0,0 +1,221 @@
+/*
+  Zeitgeist
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Compare the mipmap chains generated by the calling thread alone to the mipmap chains generated by the thread pool
+// and measure the time to generate a mipmap chain.
+// Usage: <executable> [<width> <height>] where <width> and <height> are the size of the benchmark images (1024 by default).
+
+#include "Visuals/Mipmap.h"
+#include "Visuals/Parallel.h"
+
+// EXIT_SUCCESS, EXIT_FAILURE, malloc, free, atoi
+#include <stdlib.h>
+
+// fprintf, stdout, stderr
+#include <stdio.h>
+
+// memcmp
+#include <string.h>
+
+static Visuals_MipmapFilter const FILTERS[] = {
+  Visuals_MipmapFilter_Box,
+  Visuals_MipmapFilter_Kaiser,
+  Visuals_MipmapFilter_Lanczos,
+};
+
+static char const* const FILTERNAMES[] = {
+  "Box",
+  "Kaiser",
+  "Lanczos",
+};
+
+#define NumberOfFilters (sizeof(FILTERS) / sizeof(FILTERS[0]))
+
+static Visuals_PixelFormat const PIXELFORMATS[] = {
+  Visuals_PixelFormat_ARGB_U8,
+  Visuals_PixelFormat_BGR_U8,
+  Visuals_PixelFormat_RGBA_U8,
+};
+
+static char const* const PIXELFORMATNAMES[] = {
+  "ARGB_U8",
+  "BGR_U8",
+  "RGBA_U8",
+};
+
+#define NumberOfPixelFormats (sizeof(PIXELFORMATS) / sizeof(PIXELFORMATS[0]))
+
+// The sizes cover odd sizes, non-square sizes, and sizes large enough for the levels to be split into bands.
+static Shizu_Integer32 const SIZES[][2] = {
+  { 1, 1 }, { 2, 1 }, { 1, 7 }, { 5, 3 }, { 33, 17 }, { 640, 480 }, { 1023, 257 },
+};
+
+#define NumberOfSizes (sizeof(SIZES) / sizeof(SIZES[0]))
+
+// Generate the levels of an image one after another into a buffer.
+static void
+generate
+  (
+    Shizu_State2* state,
+    Visuals_MipmapFilter filter,
+    Shizu_Boolean sRGB,
+    Visuals_PixelFormat pixelFormat,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height,
+    uint8_t const* source,
+    uint8_t* target
+  )
+{
+  size_t bytesPerPixel = (size_t)Visuals_PixelFormat_getBytesPerPixel(state, pixelFormat);
+  Shizu_Integer32 w = width, h = height;
+  while (w > 1 || h > 1) {
+    Visuals_Mipmap_generateLevel(state, filter, sRGB, pixelFormat, w, h, source, target);
+    w = w > 1 ? w / 2 : 1;
+    h = h > 1 ? h / 2 : 1;
+    source = target;
+    target += (size_t)w * (size_t)h * bytesPerPixel;
+  }
+}
+
+// Generate the levels of an image by the calling thread alone and by the thread pool and compare the results.
+// Return true if the results are equal, false otherwise.
+// The thread pool is started when this function returns.
+static bool
+compare
+  (
+    Shizu_State2* state,
+    Visuals_MipmapFilter filter,
+    Shizu_Boolean sRGB,
+    Visuals_PixelFormat pixelFormat,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  )
+{
+  size_t bytesPerPixel = (size_t)Visuals_PixelFormat_getBytesPerPixel(state, pixelFormat);
+  size_t numberOfBytes = (size_t)width * (size_t)height * bytesPerPixel;
+  // The levels generated have fewer pixels than level 0 plus one pixel for each of the at most 32 levels.
+  uint8_t* source = malloc(numberOfBytes);
+  uint8_t* serialTarget = calloc(1, numberOfBytes + bytesPerPixel * 32);
+  uint8_t* parallelTarget = calloc(1, numberOfBytes + bytesPerPixel * 32);
+  if (!source || !serialTarget || !parallelTarget) {
+    free(parallelTarget);
+    free(serialTarget);
+    free(source);
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  for (size_t i = 0; i < numberOfBytes; ++i) {
+    source[i] = (uint8_t)(i * 31 + (i >> 9));
+  }
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    // If the thread pool is not started, the calling thread generates all bands.
+    Visuals_Parallel_shutdown();
+    generate(state, filter, sRGB, pixelFormat, width, height, source, serialTarget);
+    Visuals_Parallel_startup();
+    generate(state, filter, sRGB, pixelFormat, width, height, source, parallelTarget);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    free(parallelTarget);
+    free(serialTarget);
+    free(source);
+    Shizu_State2_jump(state);
+  }
+  bool equal = 0 == memcmp(serialTarget, parallelTarget, numberOfBytes + bytesPerPixel * 32);
+  free(parallelTarget);
+  free(serialTarget);
+  free(source);
+  return equal;
+}
+
+static void
+main1
+  (
+    Shizu_State2* state,
+    int argc,
+    char** argv
+  )
+{
+  Shizu_Integer32 width = 1024, height = 1024;
+  if (argc == 3) {
+    width = atoi(argv[1]);
+    height = atoi(argv[2]);
+  }
+  if ((argc != 1 && argc != 3) || width <= 0 || height <= 0) {
+    fprintf(stderr, "usage: %s [<width> <height>]\n", argv[0]);
+    Shizu_State2_jump(state);
+  }
+  size_t numberOfFailures = 0;
+  for (size_t i = 0; i < NumberOfFilters; ++i) {
+    for (size_t sRGB = 0; sRGB < 2; ++sRGB) {
+      for (size_t j = 0; j < NumberOfPixelFormats; ++j) {
+        for (size_t k = 0; k < NumberOfSizes; ++k) {
+          if (!compare(state, FILTERS[i], sRGB ? Shizu_Boolean_True : Shizu_Boolean_False, PIXELFORMATS[j], SIZES[k][0], SIZES[k][1])) {
+            fprintf(stderr, "error: %s%s: %s: %dx%d: levels differ\n", FILTERNAMES[i], sRGB ? " sRGB" : "", PIXELFORMATNAMES[j],
+                    SIZES[k][0], SIZES[k][1]);
+            numberOfFailures++;
+          }
+        }
+      }
+    }
+  }
+  if (numberOfFailures) {
+    Shizu_State2_jump(state);
+  }
+  fprintf(stdout, "benchmark: %dx%d pixels, %zu threads\n", width, height, Visuals_Parallel_getNumberOfThreads());
+  for (size_t i = 0; i < NumberOfFilters; ++i) {
+    for (size_t sRGB = 0; sRGB < 2; ++sRGB) {
+      double seconds, megabytesPerSecond;
+      Visuals_Mipmap_benchmark(state, FILTERS[i], sRGB ? Shizu_Boolean_True : Shizu_Boolean_False, width, height, &seconds, &megabytesPerSecond);
+      fprintf(stdout, "  %-7s %-4s: %8.4f s, %8.1f MB/s\n", FILTERNAMES[i], sRGB ? "sRGB" : "", seconds, megabytesPerSecond);
+    }
+  }
+}
+
+int
+main
+  (
+    int argc,
+    char** argv
+  )
+{
+  Shizu_State2* state = NULL;
+  if (Shizu_State2_acquire(&state)) {
+    return EXIT_FAILURE;
+  }
+  int exitCode = EXIT_SUCCESS;
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    main1(state, argc, argv);
+    exitCode = EXIT_SUCCESS;
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    exitCode = EXIT_FAILURE;
+    Shizu_State2_popJumpTarget(state);
+  }
+  Visuals_Parallel_shutdown();
+  Shizu_State2_relinquish(state);
+  state = NULL;
+  return exitCode;
+}
@@ -0,0 +1,179 @@
+/*
+  Zeitgeist
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Compare Visuals_PixelFormat_convert to Visuals_PixelFormat_convertNaive for all pairs of pixel formats
+// and measure the throughput of both.
+// Usage: <executable> [<width> <height>] where <width> and <height> are the size of the benchmark images (1024 by default).
+
+#include "Visuals/Parallel.h"
+#include "Visuals/PixelFormat.h"
+
+// EXIT_SUCCESS, EXIT_FAILURE, malloc, free, atoi
+#include <stdlib.h>
+
+// fprintf, stdout, stderr
+#include <stdio.h>
+
+// memcmp
+#include <string.h>
+
+static Visuals_PixelFormat const PIXELFORMATS[] = {
+  Visuals_PixelFormat_ABGR_U8,
+  Visuals_PixelFormat_ARGB_U8,
+  Visuals_PixelFormat_BGR_U8,
+  Visuals_PixelFormat_BGRA_U8,
+  Visuals_PixelFormat_RGB_U8,
+  Visuals_PixelFormat_RGBA_U8,
+};
+
+static char const* const PIXELFORMATNAMES[] = {
+  "ABGR_U8",
+  "ARGB_U8",
+  "BGR_U8",
+  "BGRA_U8",
+  "RGB_U8",
+  "RGBA_U8",
+};
+
+#define NumberOfPixelFormats (sizeof(PIXELFORMATS) / sizeof(PIXELFORMATS[0]))
+
+// The widths cover the tails of the 4 pixel (SSSE3) and the 8 pixel (AVX2) kernels.
+// The last size is large enough for the rows to be split among threads.
+static Shizu_Integer32 const SIZES[][2] = {
+  { 1, 1 }, { 2, 3 }, { 3, 2 }, { 4, 1 }, { 5, 3 }, { 7, 2 }, { 8, 1 }, { 9, 3 }, { 13, 2 }, { 16, 2 },
+  { 17, 3 }, { 31, 2 }, { 33, 3 }, { 63, 2 }, { 65, 1 }, { 127, 3 }, { 600, 333 },
+};
+
+#define NumberOfSizes (sizeof(SIZES) / sizeof(SIZES[0]))
+
+// The rows of the images are padded such that the strides differ from the widths.
+#define Padding (5)
+
+// Convert an image by Visuals_PixelFormat_convert and by Visuals_PixelFormat_convertNaive and compare the results.
+// Return true if the results are equal, false otherwise.
+static bool
+compare
+  (
+    Shizu_State2* state,
+    Visuals_PixelFormat targetPixelFormat,
+    Visuals_PixelFormat sourcePixelFormat,
+    Shizu_Integer32 width,
+    Shizu_Integer32 height
+  )
+{
+  size_t sourceBytesPerPixel = (size_t)Visuals_PixelFormat_getBytesPerPixel(state, sourcePixelFormat),
+         targetBytesPerPixel = (size_t)Visuals_PixelFormat_getBytesPerPixel(state, targetPixelFormat);
+  size_t sourceStride = (size_t)width * sourceBytesPerPixel + Padding,
+         targetStride = (size_t)width * targetBytesPerPixel + Padding;
+  uint8_t* source = malloc(sourceStride * (size_t)height);
+  uint8_t* target = malloc(targetStride * (size_t)height);
+  uint8_t* naiveTarget = malloc((size_t)width * targetBytesPerPixel);
+  if (!source || !target || !naiveTarget) {
+    free(naiveTarget);
+    free(target);
+    free(source);
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  for (size_t i = 0, n = sourceStride * (size_t)height; i < n; ++i) {
+    source[i] = (uint8_t)(i * 131 + (i >> 7));
+  }
+  Visuals_PixelFormat_convert(state, targetPixelFormat, target, targetStride, sourcePixelFormat, source, sourceStride, width, height);
+  bool equal = true;
+  for (size_t y = 0; y < (size_t)height && equal; ++y) {
+    Visuals_PixelFormat_convertNaive(targetPixelFormat, naiveTarget, sourcePixelFormat, source + y * sourceStride, (size_t)width);
+    equal = 0 == memcmp(naiveTarget, target + y * targetStride, (size_t)width * targetBytesPerPixel);
+  }
+  free(naiveTarget);
+  free(target);
+  free(source);
+  return equal;
+}
+
+static void
+main1
+  (
+    Shizu_State2* state,
+    int argc,
+    char** argv
+  )
+{
+  Shizu_Integer32 width = 1024, height = 1024;
+  if (argc == 3) {
+    width = atoi(argv[1]);
+    height = atoi(argv[2]);
+  }
+  if ((argc != 1 && argc != 3) || width <= 0 || height <= 0) {
+    fprintf(stderr, "usage: %s [<width> <height>]\n", argv[0]);
+    Shizu_State2_jump(state);
+  }
+  size_t numberOfFailures = 0;
+  for (size_t i = 0; i < NumberOfPixelFormats; ++i) {
+    for (size_t j = 0; j < NumberOfPixelFormats; ++j) {
+      for (size_t k = 0; k < NumberOfSizes; ++k) {
+        if (!compare(state, PIXELFORMATS[j], PIXELFORMATS[i], SIZES[k][0], SIZES[k][1])) {
+          fprintf(stderr, "error: %s to %s: %dx%d: results differ\n", PIXELFORMATNAMES[i], PIXELFORMATNAMES[j], SIZES[k][0], SIZES[k][1]);
+          numberOfFailures++;
+        }
+      }
+    }
+  }
+  if (numberOfFailures) {
+    Shizu_State2_jump(state);
+  }
+  fprintf(stdout, "benchmark: %dx%d pixels, %zu threads\n", width, height, Visuals_Parallel_getNumberOfThreads());
+  for (size_t i = 0; i < NumberOfPixelFormats; ++i) {
+    for (size_t j = 0; j < NumberOfPixelFormats; ++j) {
+      double naiveMegabytesPerSecond, megabytesPerSecond;
+      Visuals_PixelFormat_benchmarkConversion(state, PIXELFORMATS[j], PIXELFORMATS[i], width, height, &naiveMegabytesPerSecond, &megabytesPerSecond);
+      fprintf(stdout, "  %-7s to %-7s: naive %8.1f MB/s, convert %8.1f MB/s\n", PIXELFORMATNAMES[i], PIXELFORMATNAMES[j], naiveMegabytesPerSecond, megabytesPerSecond);
+    }
+  }
+}
+
+int
+main
+  (
+    int argc,
+    char** argv
+  )
+{
+  Shizu_State2* state = NULL;
+  if (Shizu_State2_acquire(&state)) {
+    return EXIT_FAILURE;
+  }
+  Visuals_Parallel_startup();
+  int exitCode = EXIT_SUCCESS;
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    main1(state, argc, argv);
+    exitCode = EXIT_SUCCESS;
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    exitCode = EXIT_FAILURE;
+    Shizu_State2_popJumpTarget(state);
+  }
+  Visuals_Parallel_shutdown();
+  Shizu_State2_relinquish(state);
+  state = NULL;
+  return exitCode;
+}